@@ -0,0 +1,58 @@
+// Measures the throughput of the copy routines of mapped_memory_copy.hpp for various sizes and destination alignments.
+// It does not depend on Vulkan, i.e. the destination is regular host memory. Since the benefit of non-temporal stores is
+// largest when writing into write-combined memory, the results are a lower bound for uploads into mapped device memory.
+//
+// Build it via the avk_BuildBenchmarks CMake option, or directly, e.g.:
+//   g++ -std=c++20 -O2 -march=native -pthread -I../include mapped_memory_copy_benchmark.cpp
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include "avk/mapped_memory_copy.hpp"
+
+namespace
+{
+	// Returns the throughput in GiB/s of the best out of aRepetitions runs:
+	double measure(const std::function<void()>& aCopy, size_t aSize, int aRepetitions)
+	{
+		auto best = std::chrono::duration<double>::max();
+		for (int i = 0; i < aRepetitions; ++i) {
+			const auto start = std::chrono::steady_clock::now();
+			aCopy();
+			best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start));
+		}
+		return static_cast<double>(aSize) / (1024.0 * 1024.0 * 1024.0) / best.count();
+	}
+}
+
+int main()
+{
+	constexpr size_t maxSize = size_t{ 256 } * 1024 * 1024;
+	// Destinations at unaligned offsets, in order to cover the head handling and the page-aligned splitting:
+	constexpr size_t offsets[] = { 0, 16, 4000 };
+	constexpr size_t padding = 4096;
+
+	std::vector<uint8_t> src(maxSize);
+	for (size_t i = 0; i < src.size(); ++i) {
+		src[i] = static_cast<uint8_t>(i * 2654435761u >> 24);
+	}
+	std::vector<uint8_t> dst(maxSize + padding);
+
+	std::printf("%12s %8s %12s %12s %12s\n", "size", "offset", "memcpy", "non-temp.", "mapped");
+	for (size_t size = 4 * 1024; size <= maxSize; size *= 4) {
+		const auto repetitions = static_cast<int>(std::max(size_t{ 5 }, (size_t{ 1 } << 30) / size));
+		for (const auto offset : offsets) {
+			auto* d = dst.data() + offset;
+			const auto memcpyRate = measure([&]() { memcpy(d, src.data(), size); }, size, repetitions);
+			const auto nonTemporalRate = measure([&]() { avk::copy_non_temporal(d, src.data(), size); }, size, repetitions);
+			const auto mappedRate = measure([&]() { avk::copy_to_mapped_memory(d, src.data(), size); }, size, repetitions);
+			if (!avk::memory_equal(d, src.data(), size)) {
+				std::printf("Copy of %zu bytes at offset %zu is INCORRECT\n", size, offset);
+				return EXIT_FAILURE;
+			}
+			std::printf("%12zu %8zu %9.2f GiB/s %6.2f GiB/s %6.2f GiB/s\n", size, offset, memcpyRate, nonTemporalRate, mappedRate);
+		}
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Lifetime of a resource within an aliasing heap, expressed in user-defined steps
+	 *	(e.g., the indices of the passes within a frame which use the resource).
+	 *	Both ends are inclusive. Resources whose lifetimes do not overlap may share memory.
+	 */
+	struct lifetime_interval
+	{
+		uint32_t mFirstUse;
+		uint32_t mLastUse;
+	};
+
+	/**	Identifies a resource which has been declared in an aliasing heap. */
+	using aliased_resource_id = uint32_t;
+
+	/**	A block of device memory shared by multiple images and buffers whose lifetimes do not overlap.
+	 *
+	 *	Usage:
+	 *	 1. Declare all resources with their lifetime intervals via declare_image and declare_buffer.
+	 *	 2. Invoke allocate(), which packs the resources into as little memory as possible,
+	 *	    allocates the memory, and binds all the resources to their memory ranges.
+	 *	 3. Access the resources via image_at and buffer_at.
+	 *	 4. Before the first use of a resource within each frame, record its aliasing_barrier,
+	 *	    which makes sure that the resource's memory is no longer in use by its predecessors.
+	 *	    This includes the last occupants of the memory from previous frames which might still
+	 *	    be in flight, i.e., the barrier is required even for the first resource of a memory range.
+	 *
+	 *	Contents of aliased resources are undefined at the beginning of their lifetimes.
+	 *	All resources are allocated in device-local memory and can not be mapped.
+	 *	The heap owns all the resources and must outlive all usages of them.
+	 */
+	class aliasing_heap_t
+	{
+		friend class root;
+
+		struct declared_resource
+		{
+			std::variant<image_t, buffer_t> mResource;
+			lifetime_interval mLifetime;
+			vk::MemoryRequirements mRequirements;
+			vk::DeviceSize mOffset;
+		};
+
+	public:
+		aliasing_heap_t() = default;
+		aliasing_heap_t(aliasing_heap_t&&) noexcept = default;
+		aliasing_heap_t(const aliasing_heap_t&) = delete;
+		aliasing_heap_t& operator=(aliasing_heap_t&&) noexcept = default;
+		aliasing_heap_t& operator=(const aliasing_heap_t&) = delete;
+		~aliasing_heap_t() = default;
+
+		/** Declare an image which shall live in this aliasing heap.
+		 *	@param	aWidth						The width of the image to be created
+		 *	@param	aHeight						The height of the image to be created
+		 *	@param	aFormatAndSamples			The image format and the number of samples of the image to be created
+		 *	@param	aLifetime					When the image is in use.
+		 *	@param	aNumLayers					How many layers the image to be created shall contain.
+		 *	@param	aImageUsage					How this image is intended to being used.
+		 *	@param	aAlterConfigBeforeCreation	A context-specific function which allows to modify the `vk::ImageCreateInfo` just before the image will be created.
+		 *	@return	The id which can be used to refer to the image after allocate() has been invoked.
+		 */
+		aliased_resource_id declare_image(uint32_t aWidth, uint32_t aHeight, std::tuple<vk::Format, vk::SampleCountFlagBits> aFormatAndSamples, lifetime_interval aLifetime, int aNumLayers = 1, avk::image_usage aImageUsage = avk::image_usage::general_image, std::function<void(image_t&)> aAlterConfigBeforeCreation = {});
+
+		/** Declare an image which shall live in this aliasing heap. See the other overload for a description of the parameters. */
+		aliased_resource_id declare_image(uint32_t aWidth, uint32_t aHeight, vk::Format aFormat, lifetime_interval aLifetime, int aNumLayers = 1, avk::image_usage aImageUsage = avk::image_usage::general_image, std::function<void(image_t&)> aAlterConfigBeforeCreation = {})
+		{
+			return declare_image(aWidth, aHeight, std::make_tuple(aFormat, vk::SampleCountFlagBits::e1), aLifetime, aNumLayers, aImageUsage, std::move(aAlterConfigBeforeCreation));
+		}
+
+		/** Declare a buffer which shall live in this aliasing heap.
+		 *	@param	aLifetime			When the buffer is in use.
+		 *	@param	aMetaData			Meta data describing the buffer. The first entry determines the buffer's size.
+		 *	@param	aBufferUsage		Usage flags of the buffer to be created.
+		 *	@return	The id which can be used to refer to the buffer after allocate() has been invoked.
+		 */
+		aliased_resource_id declare_buffer(
+			lifetime_interval aLifetime,
+#if VK_HEADER_VERSION >= 135
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#else
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#endif
+			vk::BufferUsageFlags aBufferUsage
+		);
+
+		/** Declare a buffer which shall live in this aliasing heap.
+		 *	@param	aLifetime				When the buffer is in use.
+		 *	@param	aAdditionalUsageFlags	Usage flags in addition to those which are inferred from the meta data.
+		 *	@param	aConfig, aConfigs		Meta data describing the buffer. The first one determines the buffer's size.
+		 *	@return	The id which can be used to refer to the buffer after allocate() has been invoked.
+		 */
+		template <typename Meta, typename... Metas>
+		aliased_resource_id declare_buffer(lifetime_interval aLifetime, vk::BufferUsageFlags aAdditionalUsageFlags, Meta aConfig, Metas... aConfigs)
+		{
+#if VK_HEADER_VERSION >= 135
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#else
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#endif
+			auto usage = aAdditionalUsageFlags | aConfig.buffer_usage_flags();
+			metas.push_back(aConfig);
+			if constexpr (sizeof...(aConfigs) > 0) {
+				usage |= (... | aConfigs.buffer_usage_flags());
+				(metas.push_back(aConfigs), ...);
+			}
+			return declare_buffer(aLifetime, std::move(metas), usage);
+		}
+
+		/**	Assign memory ranges to all the declared resources, allocate the memory, and bind the resources to it.
+		 *	Resources are packed by coloring their interval graph: Each color represents a memory range, and resources
+		 *	with overlapping lifetimes always get different colors assigned. No more resources can be declared afterwards.
+		 */
+		void allocate();
+
+		/** Returns true if allocate() has been invoked already. */
+		bool is_allocated() const { return static_cast<bool>(mMemory); }
+
+		/** Gets the image with the given id. */
+		image_t& image_at(aliased_resource_id aId) { return std::get<image_t>(mResources[aId].mResource); }
+		/** Gets the image with the given id. */
+		const image_t& image_at(aliased_resource_id aId) const { return std::get<image_t>(mResources[aId].mResource); }
+		/** Gets the buffer with the given id. */
+		buffer_t& buffer_at(aliased_resource_id aId) { return std::get<buffer_t>(mResources[aId].mResource); }
+		/** Gets the buffer with the given id. */
+		const buffer_t& buffer_at(aliased_resource_id aId) const { return std::get<buffer_t>(mResources[aId].mResource); }
+
+		/** Gets the offset into the heap's memory which the resource with the given id has been bound to. */
+		vk::DeviceSize offset_of(aliased_resource_id aId) const { return mResources[aId].mOffset; }
+		/** Gets the lifetime of the resource with the given id. */
+		lifetime_interval lifetime_of(aliased_resource_id aId) const { return mResources[aId].mLifetime; }
+
+		/** Gets the size of the memory which has been allocated for all the resources. */
+		vk::DeviceSize memory_size() const { return mMemorySize; }
+		/** Gets the size of the memory which would have been required without aliasing. */
+		vk::DeviceSize unaliased_memory_size() const;
+
+		/**	Gets the barrier which must be recorded before the first usage of an aliased image.
+		 *	It waits for all previous work on the memory (in all pipeline stages, including work of previous
+		 *	frames) and makes its writes available, and transitions the image from undefined
+		 *	layout into the given layout. The destination scopes are inferred automatically.
+		 *	@param	aId					The id of the image
+		 *	@param	aInitialLayout		The layout which the image shall be transitioned into for its first usage
+		 */
+		avk::sync::sync_type_command aliasing_barrier(aliased_resource_id aId, avk::layout::image_layout aInitialLayout) const;
+
+		/**	Gets the barrier which must be recorded before the first usage of an aliased buffer.
+		 *	It waits for all previous work on the memory (in all pipeline stages, including work of previous
+		 *	frames) and makes its writes available. The destination scopes are inferred automatically.
+		 *	@param	aId					The id of the buffer
+		 */
+		avk::sync::sync_type_command aliasing_barrier(aliased_resource_id aId) const;
+
+	private:
+		root* mRoot = nullptr;
+		vk::DeviceSize mMemorySize = 0;
+		// Declaration order determines destruction order (inverse!) => memory is freed after all the resources have been destroyed:
+		vk::UniqueHandle<vk::DeviceMemory, DISPATCH_LOADER_CORE_TYPE> mMemory;
+		std::vector<vk::UniqueHandle<vk::Image, DISPATCH_LOADER_CORE_TYPE>> mImageHandles;
+		std::vector<declared_resource> mResources;
+	};
+
+	/** Typedef representing any kind of OWNING aliasing heap representations. */
+	using aliasing_heap = owning_resource<aliasing_heap_t>;
+}
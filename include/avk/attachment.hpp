@@ -125,6 +125,17 @@ namespace avk
 		/** Returns the stencil store operation */
 		auto get_stencil_store_op() const { return mStencilStoreOperation.value_or(mStoreOperation); }
 
+		/** True if neither previous contents are loaded (contents are cleared or don't care) nor the contents are stored,
+		 *	for both, color/depth and stencil. Such an attachment can be backed by a transient, lazily allocated image.
+		 */
+		bool is_transient() const
+		{
+			return on_load_behavior::load   != mLoadOperation.mLoadBehavior
+				&& on_load_behavior::load   != get_stencil_load_op().mLoadBehavior
+				&& on_store_behavior::store != mStoreOperation.mStoreBehavior
+				&& on_store_behavior::store != get_stencil_store_op().mStoreBehavior;
+		}
+
 		auto clear_color() const { return mColorClearValue; }
 		auto depth_clear_value() const { return mDepthClearValue; }
 		auto stencil_clear_value() const { return mStencilClearValue; }
@@ -2,20 +2,28 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <exception>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <queue>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 #include <sstream>
 #include <string>
@@ -32,6 +40,8 @@
 #include "avk/avk_log.hpp"
 #include "avk/avk_error.hpp"
 #include "avk/cpp_utils.hpp"
+#include "avk/worker_pool.hpp"
+#include "avk/mapped_memory_copy.hpp"
 
 // TODO: #include <vulkan/vulkan_core.h> => #if VK_HEADER_VERSION >= 162
 #define VULKAN_HPP_ENABLE_DYNAMIC_LOADER_TOOL 0
@@ -71,6 +81,21 @@
 #define AVK_STAGING_BUFFER_READBACK_MEMORY_USAGE avk::memory_usage::host_visible
 #endif
 
+/** CONFIG SETTING: AVK_HOST_WRITABLE_DEVICE_HEAP_MIN_SIZE
+ *
+ *	Buffers created with avk::memory_usage::device_host_writable are only placed in
+ *	host-visible device-local memory if the heap of such a memory type has at least
+ *	this size (in bytes). Without resizable BAR, devices typically only expose a small
+ *	(256 MiB) window of device memory to the host, which shall not be exhausted.
+ *	In that case, such buffers fall back to device memory which is filled via staging.
+ *
+ *	By default, 1 GiB is required. Define AVK_HOST_WRITABLE_DEVICE_HEAP_MIN_SIZE
+ *	before the #include "avk/avk.hpp" in order to specify a different value.
+ */
+#if !defined(AVK_HOST_WRITABLE_DEVICE_HEAP_MIN_SIZE)
+#define AVK_HOST_WRITABLE_DEVICE_HEAP_MIN_SIZE (1024ull * 1024ull * 1024ull)
+#endif
+
 /** CONFIG SETTING: AVK_USE_CORE_INSTEAD_OF_SYNCHRONIZATION2
  *	If this is defined BEFORE including avk.hpp, the Vulkan API core functions are used 
  *	instead of the Synchronization2 extension functions (which were promoted to core with
@@ -85,6 +110,23 @@
 #define AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
 #endif
 
+/** CONFIG SETTING: AVK_DISABLE_BARRIER_BATCHING
+ *	By default, the barriers of consecutive sync_type_commands are recorded with one single
+ *	pipeline barrier command. Barriers which are fully covered by a preceding barrier of the
+ *	same batch are dropped, and barriers of adjacent image subresource ranges or buffer ranges
+ *	are merged. If this is defined BEFORE including avk.hpp, each sync_type_command is recorded
+ *	with its own pipeline barrier command instead, which can be helpful for debugging.
+ */
+
+/** CONFIG SETTING: AVK_BARRIER_PLAN_CACHE_MAX_ENTRIES
+ *	The maximum number of barrier plans, i.e. resolved stages and accesses of the barriers of a list
+ *	of recorded commands, which a root caches (see barrier_plan_cache). If the cache is full, the
+ *	least recently used plan is evicted. Define it as 0 BEFORE including avk.hpp in order to disable the cache.
+ */
+#if !defined(AVK_BARRIER_PLAN_CACHE_MAX_ENTRIES)
+#define AVK_BARRIER_PLAN_CACHE_MAX_ENTRIES 64
+#endif
+
 namespace avk
 {
 	class root;
@@ -161,6 +203,8 @@ static_assert(false, "Unable to find include <vma/vk_mem_alloc.h> or <vk_mem_all
  *	These can be used to plug-in custom memory allocation behavior into Auto-Vk.
  *	This is definitely an advanced usage scenario, where you'll have to provide a type
  *	similar to avk::mem_handle or avk::vma_handle which manages memory allocations.
+ *	Like theirs, the allocating constructors must accept a bit field of allowed memory
+ *	type indices as fourth, and a pointer to the cached memory properties as fifth parameter.
  *
  *	If you want to plug-in custom memory allocation behavior, define ALL THREE of these
  *	macros before the #include "avk/avk.hpp"
@@ -220,7 +264,9 @@ namespace avk
 	}
 }
 
+#include "avk/external_memory.hpp"
 #include "avk/buffer.hpp"
+#include "avk/buffer_slice.hpp"
 #include "avk/shader_info.hpp"
 
 #include "avk/shader_binding_table.hpp"
@@ -230,6 +276,7 @@ namespace avk
 #include "avk/semaphore.hpp"
 #include "avk/fence.hpp"
 
+#include "avk/image_layout_state.hpp"
 #include "avk/image.hpp"
 #include "avk/image_view.hpp"
 #include "avk/sampler.hpp"
@@ -268,8 +315,23 @@ namespace avk
 #include "avk/bindings.hpp"
 
 #include "avk/commands.hpp"
+#include "avk/command_stream.hpp"
+#include "avk/parallel_recording.hpp"
+#include "avk/resource_state_tracker.hpp"
 #include "avk/queue.hpp"
 
+#include "avk/deferred_destruction_queue.hpp"
+#include "avk/device_capabilities.hpp"
+#include "avk/barrier_plan_cache.hpp"
+#include "avk/defragmenter.hpp"
+#include "avk/aliasing_heap.hpp"
+#include "avk/frame_linear_allocator.hpp"
+#include "avk/command_pool_manager.hpp"
+#include "avk/resource_registry.hpp"
+#include "avk/gpu_vector.hpp"
+#include "avk/baked_commands.hpp"
+#include "avk/scatter_upload.hpp"
+
 // Provide the implementation of buffer_t::read (declared in buffer.hpp)
 namespace avk {
 	template<typename Ret>
@@ -293,6 +355,26 @@ namespace avk
 	{
 	public:
 		root()																	= default;
+		// The caches are moved along, and the moved-from root gets new, empty ones. The device capabilities are re-pointed to their new root:
+		root(root&& aOther)
+			: mDeferredDestructionQueue{ std::exchange(aOther.mDeferredDestructionQueue, nullptr) }
+			, mCapabilities{ std::exchange(aOther.mCapabilities, std::make_unique<device_capabilities>(&aOther)) }
+			, mBarrierPlanCache{ std::exchange(aOther.mBarrierPlanCache, std::make_unique<barrier_plan_cache>()) }
+		{
+			mCapabilities->mRoot = this;
+		}
+		root(const root&)														= delete;
+		root& operator=(root&& aOther)
+		{
+			if (this != &aOther) {
+				mDeferredDestructionQueue = std::exchange(aOther.mDeferredDestructionQueue, nullptr);
+				mCapabilities = std::exchange(aOther.mCapabilities, std::make_unique<device_capabilities>(&aOther));
+				mCapabilities->mRoot = this;
+				mBarrierPlanCache = std::exchange(aOther.mBarrierPlanCache, std::make_unique<barrier_plan_cache>());
+			}
+			return *this;
+		}
+		root& operator=(const root&)											= delete;
 		virtual vk::PhysicalDevice& physical_device()							= 0;
 		virtual vk::Device& device()											= 0;
 		virtual DISPATCH_LOADER_CORE_TYPE& dispatch_loader_core()				= 0;
@@ -305,6 +387,23 @@ namespace avk
 		virtual const AVK_MEM_ALLOCATOR_TYPE& memory_allocator() const			= 0;
 
 #pragma region root helper functions
+		/**	Gets the cached properties of the physical device. Prefer it over querying the physical device directly,
+		 *	which is comparatively expensive.
+		 */
+		const device_capabilities& capabilities() const { return *mCapabilities; }
+
+		/**	Gets the cache of resolved barrier stages and accesses, which is used whenever a list of recorded commands is
+		 *	recorded into a command buffer. See barrier_plan_cache::number_of_hits and barrier_plan_cache::number_of_misses.
+		 */
+		const barrier_plan_cache& barrier_plans() const { return *mBarrierPlanCache; }
+		/** Gets the cache of resolved barrier stages and accesses, e.g. in order to clear it. */
+		barrier_plan_cache& barrier_plans() { return *mBarrierPlanCache; }
+		/**	Gets the cache of resolved barrier stages and accesses for modification through a const root.
+		 *	This is what recording into command buffers (which only know a const root) uses in order to look up and
+		 *	insert plans. The cache is internally synchronized and does not affect the results of any other method.
+		 */
+		barrier_plan_cache& mutable_barrier_plans() const { return *mBarrierPlanCache; }
+
 		/** Prints all the different memory types that are available on the device along with its memory property flags. */
 		void print_available_memory_types();
 
@@ -317,20 +416,28 @@ namespace avk
 		 *			[1]: The actual memory property flags which are supported by the selected memory. The include at least aMemoryProperties,
 		 *				 but can also have additional memory property flags set.
 		 */
-		std::tuple<uint32_t, vk::MemoryPropertyFlags> find_memory_type_index(uint32_t aMemoryTypeBits, vk::MemoryPropertyFlags aMemoryProperties);
+		std::tuple<uint32_t, vk::MemoryPropertyFlags> find_memory_type_index(uint32_t aMemoryTypeBits, vk::MemoryPropertyFlags aMemoryProperties) const;
+
+		/** Returns true if the physical device offers at least one memory type which has (at least) all of the given memory property flags set.
+		 *	@param	aMemoryProperties	The memory property flags which a memory type must support.
+		 *	@param	aMinHeapSize		The minimum size of the memory heap which the memory type belongs to.
+		 */
+		bool is_memory_type_supported(vk::MemoryPropertyFlags aMemoryProperties, vk::DeviceSize aMinHeapSize = 0) const;
+
+		/** Gets a bit field with one bit set for each memory type index which is supported according to is_memory_type_supported.
+		 *	It can be used to restrict memory allocations to exactly the memory types which have been checked.
+		 *	@param	aMemoryProperties	The memory property flags which a memory type must support.
+		 *	@param	aMinHeapSize		The minimum size of the memory heap which the memory type belongs to.
+		 */
+		uint32_t supported_memory_type_bits(vk::MemoryPropertyFlags aMemoryProperties, vk::DeviceSize aMinHeapSize = 0) const;
 
-		bool is_format_supported(vk::Format pFormat, vk::ImageTiling pTiling, vk::FormatFeatureFlags aFormatFeatures);
+		bool is_format_supported(vk::Format pFormat, vk::ImageTiling pTiling, vk::FormatFeatureFlags aFormatFeatures) const;
 
 #if VK_HEADER_VERSION >= 135
 		// Helper function used for creating both, bottom level and top level acceleration structures
 		template <typename T>
 		void finish_acceleration_structure_creation(T& result, std::function<void(T&)> aAlterConfigBeforeMemoryAlloc)
 		{
-			vk::PhysicalDeviceAccelerationStructurePropertiesKHR asProps{};
-			vk::PhysicalDeviceProperties2 phProps2{};
-			phProps2.pNext = &asProps;
-			physical_device().getProperties2(&phProps2, dispatch_loader_core());
-
 			// ------------- Memory ------------
 			// 5. Query memory requirements
 #if VK_HEADER_VERSION >= 162
@@ -343,7 +450,7 @@ namespace avk
 				dispatch_loader_ext()
 			);
 			result.mMemoryRequirementsForAccelerationStructure = buildSizesInfo.accelerationStructureSize;
-			result.mMemoryAlignmentForScratchBuffer            = asProps.minAccelerationStructureScratchOffsetAlignment;
+			result.mMemoryAlignmentForScratchBuffer            = capabilities().acceleration_structure_properties().minAccelerationStructureScratchOffsetAlignment;
 			result.mMemoryRequirementsForBuildScratchBuffer    = buildSizesInfo.buildScratchSize + result.mMemoryAlignmentForScratchBuffer;
 			result.mMemoryRequirementsForScratchBufferUpdate   = buildSizesInfo.updateScratchSize + result.mMemoryAlignmentForScratchBuffer;
 
@@ -423,9 +530,9 @@ namespace avk
 		}
 
 #if VK_HEADER_VERSION >= 162
-		vk::PhysicalDeviceRayTracingPipelinePropertiesKHR get_ray_tracing_properties();
+		vk::PhysicalDeviceRayTracingPipelinePropertiesKHR get_ray_tracing_properties() const;
 #else
-		vk::PhysicalDeviceRayTracingPropertiesKHR get_ray_tracing_properties();
+		vk::PhysicalDeviceRayTracingPropertiesKHR get_ray_tracing_properties() const;
 #endif
 
 		static vk::DeviceAddress get_buffer_address(const vk::Device& aDevice, vk::Buffer aBufferHandle);
@@ -433,7 +540,7 @@ namespace avk
 		vk::DeviceAddress get_buffer_address(vk::Buffer aBufferHandle);
 #endif
 
-		void finish_configuration(buffer_view_t& aBufferViewToBeFinished, vk::Format aViewFormat, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation);
+		void finish_configuration(buffer_view_t& aBufferViewToBeFinished, vk::Format aViewFormat, vk::DeviceSize aOffset, vk::DeviceSize aRange, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation);
 #pragma endregion
 
 #pragma region acceleration structures
@@ -443,6 +550,36 @@ namespace avk
 #endif
 #pragma endregion
 
+#pragma region aliasing heap
+		/**	Create an aliasing heap, which places images and buffers with non-overlapping lifetimes in the same memory.
+		 *	@return	A new aliasing heap instance. Declare resources in it, then allocate() it.
+		 */
+		aliasing_heap create_aliasing_heap();
+#pragma endregion
+
+#pragma region baked commands
+		/**	Create commands which are recorded once into reusable command buffers and replayed until they are invalidated.
+		 *	@param	aQueueFamilyIndex			The queue family which the command buffers are submitted to.
+		 *	@param	aNumberOfFramesInFlight		The number of variants, each with its own command buffer and parameter region.
+		 *	@param	aBakeFunction				Returns the commands to be baked for a given variant.
+		 *	@param	aParametersSize				Size in bytes of each variant's region of per-frame parameters. 0 for none.
+		 *	@param	aParametersUsageFlags		Usage flags of the parameter buffer.
+		 *	@param	aLevel						The level of the command buffers.
+		 *	@param	aInheritance				What secondary command buffers inherit from the primary command buffer.
+		 *										If it is a render pass or dynamic rendering, the baked commands must not contain sync commands.
+		 *	@return	New baked commands. Variants are baked lazily upon their first use.
+		 */
+		baked_commands create_baked_commands(
+			uint32_t aQueueFamilyIndex,
+			size_t aNumberOfFramesInFlight,
+			baked_commands_t::bake_function aBakeFunction,
+			vk::DeviceSize aParametersSize = 0,
+			vk::BufferUsageFlags aParametersUsageFlags = vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eUniformBuffer,
+			vk::CommandBufferLevel aLevel = vk::CommandBufferLevel::ePrimary,
+			secondary_command_buffer_inheritance aInheritance = {}
+		);
+#pragma endregion
+
 #pragma region buffer
 		static buffer create_buffer(
 			const root& aRoot,
@@ -453,7 +590,8 @@ namespace avk
 #endif
 			vk::BufferUsageFlags aBufferUsage,
 			vk::MemoryPropertyFlags aMemoryProperties,
-			std::initializer_list<queue*> aConcurrentQueueOwnership = {}
+			std::initializer_list<queue*> aConcurrentQueueOwnership = {},
+			uint32_t aAllowedMemoryTypeBits = ~0u
 		);
 
 		buffer create_buffer(
@@ -480,6 +618,7 @@ namespace avk
 			vk::MemoryPropertyFlags memoryFlags;
 			vk::MemoryAllocateFlags memoryAllocateFlags;
 			vk::BufferUsageFlags aUsage = aAdditionalUsageFlags;
+			uint32_t allowedMemoryTypeBits = ~0u;
 
 			// We've got two major branches here:
 			// 1) Memory will stay on the host and there will be no dedicated memory on the device
@@ -507,6 +646,23 @@ namespace avk
 				memoryFlags = vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eProtected;
 				aUsage |= vk::BufferUsageFlagBits::eTransferDst;
 				break;
+			case avk::memory_usage::device_transient:
+				// Lazily allocated memory can only back images => buffers end up in ordinary device memory.
+				memoryFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+				break;
+			case avk::memory_usage::device_host_writable:
+				// Only use host-visible device memory if its heap is large (resizable BAR), not just the small BAR window
+				// of a few hundred MiB, which is easily exhausted. Otherwise, fall back to ordinary device memory + staging.
+				// The allocation is restricted to the memory types on such large heaps, because the small window's memory
+				// type (which is often listed first) has exactly the same property flags:
+				memoryFlags = vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+				allowedMemoryTypeBits = aRoot.supported_memory_type_bits(memoryFlags, AVK_HOST_WRITABLE_DEVICE_HEAP_MIN_SIZE);
+				if (0u == allowedMemoryTypeBits) {
+					allowedMemoryTypeBits = ~0u;
+					memoryFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+					aUsage |= vk::BufferUsageFlagBits::eTransferDst;
+				}
+				break;
 			}
 
 #if VK_HEADER_VERSION >= 135
@@ -523,7 +679,7 @@ namespace avk
 
 			// Create buffer here to make use of named return value optimization.
 			// How it will be filled depends on where the memory is located at.
-			return create_buffer(aRoot, metas, aUsage, memoryFlags);
+			return create_buffer(aRoot, metas, aUsage, memoryFlags, {}, allowedMemoryTypeBits);
 		}
 
 		template <typename Meta, typename... Metas>
@@ -535,6 +691,62 @@ namespace avk
 			return create_buffer(*this, avk::memory_usage{ aMemoryUsage }, vk::BufferUsageFlags{ aAdditionalUsageFlags }, std::move(aConfig), std::move(aConfigs)...);
 		}
 
+		/**	Create a buffer which uses existing host memory as its backing storage (VK_EXT_external_memory_host),
+		 *	i.e. neither device memory is allocated, nor is the data copied. Such a buffer can directly serve as
+		 *	the source of copy operations, or even be used as vertex or index buffer, if the device supports it.
+		 *	The memory which is imported is extended to multiples of minImportedHostPointerAlignment at both ends,
+		 *	which is not an issue for memory-mapped files, since they are mapped in whole pages.
+		 *	The host pointer itself only needs to be aligned to the alignment which the buffer requires (see vk::MemoryRequirements).
+		 *	Host-coherent memory types are preferred. If the memory can only be imported as non-coherent memory (which is common
+		 *	for eHostMappedForeignMemoryEXT), buffer_t::fill flushes its writes, but accesses through the host pointer must be
+		 *	accompanied by buffer_t::flush_imported_host_memory and buffer_t::invalidate_imported_host_memory.
+		 *	Requires the VK_EXT_external_memory_host device extension.
+		 *	@param	aRoot				The root to create the buffer with.
+		 *	@param	aHostMemory			The host memory to be imported, which must stay valid for the whole lifetime of the buffer.
+		 *	@param	aMetaData			Meta data of the buffer, whose first entry determines the size.
+		 *	@param	aBufferUsage		Usage flags of the buffer.
+		 */
+		static buffer create_buffer(
+			const root& aRoot,
+			host_memory_import aHostMemory,
+#if VK_HEADER_VERSION >= 135
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#else
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#endif
+			vk::BufferUsageFlags aBufferUsage
+		);
+
+		/**	Create a buffer which uses existing host memory as its backing storage (VK_EXT_external_memory_host).
+		 *	See the static overload for details.
+		 *	Example, using a memory-mapped file which contains vertex data:
+		 *		auto vertexBuffer = myRoot.create_buffer(avk::host_memory_import{ mappedFilePtr }, vk::BufferUsageFlagBits::eTransferSrc,
+		 *			avk::vertex_buffer_meta::create_from_data(vertices));
+		 */
+		template <typename Meta, typename... Metas>
+		buffer create_buffer(
+			host_memory_import aHostMemory,
+			vk::BufferUsageFlags aAdditionalUsageFlags,
+			Meta aConfig, Metas... aConfigs)
+		{
+#if VK_HEADER_VERSION >= 135
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#else
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#endif
+			vk::BufferUsageFlags usage = aAdditionalUsageFlags;
+			metas.push_back(aConfig);
+			usage |= aConfig.buffer_usage_flags();
+			if constexpr (sizeof...(aConfigs) > 0) {
+				usage |= (... | aConfigs.buffer_usage_flags());
+				(metas.push_back(aConfigs), ...);
+			}
+			return create_buffer(*this, aHostMemory, std::move(metas), usage);
+		}
+
+		/** Gets minImportedHostPointerAlignment of the physical device, which applies to host memory imports. Requires VK_EXT_external_memory_host. */
+		vk::DeviceSize imported_host_pointer_alignment() const;
+
 		//template <typename Meta, typename... Metas>
 		//buffer create_buffer(
 		//	avk::memory_usage aMemoryUsage,
@@ -554,6 +766,17 @@ namespace avk
 		 */
 		buffer_view create_buffer_view(buffer aBufferToOwn, vk::Format aViewFormat, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation = {});
 
+		/**	Create a buffer view over a range of the given buffer in the specified format.
+		 *
+		 *	@param	aBufferToOwn				The buffer to create a view for. Need to take (shared) ownership of it.
+		 *	@param	aViewFormat					The format to create the view in.
+		 *	@param	aOffset						Offset in bytes from the start of the buffer. Must be a multiple of minTexelBufferOffsetAlignment.
+		 *	@param	aRange						Size in bytes of the range which is covered by the view, or VK_WHOLE_SIZE.
+		 *	@param	aAlterConfigBeforeCreation	A callback that can be used to alter the config of vk::BufferViewCreateInfo{}
+		 *										before it is handed over to vkCmdCreateBufferViewUnique.
+		 */
+		buffer_view create_buffer_view(buffer aBufferToOwn, vk::Format aViewFormat, vk::DeviceSize aOffset, vk::DeviceSize aRange, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation = {});
+
 		/**	Create a buffer view over the given buffer in the specified format based on the specified meta data
 		 *
 		 *	@tparam M							The type of the buffer's meta data to use.
@@ -613,10 +836,27 @@ namespace avk
 		 *										before it is handed over to vkCmdCreateBufferViewUnique.
 		 */
 		buffer_view create_buffer_view(vk::Buffer aBufferToReference, vk::BufferCreateInfo aBufferInfo, vk::Format aViewFormat, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation = {});
+
+		/**	Create a buffer view over the range of a buffer which the given slice refers to, in the specified format.
+		 *
+		 *	@param	aSliceToReference			The slice to create a view for. Only a reference to its buffer is stored, i.e. the buffer must outlive the view.
+		 *										The slice's offset must be a multiple of minTexelBufferOffsetAlignment.
+		 *	@param	aViewFormat					The format to create the view in.
+		 *	@param	aAlterConfigBeforeCreation	A callback that can be used to alter the config of vk::BufferViewCreateInfo{}
+		 *										before it is handed over to vkCmdCreateBufferViewUnique.
+		 */
+		buffer_view create_buffer_view(const buffer_slice& aSliceToReference, vk::Format aViewFormat, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation = {});
 #pragma endregion
 
 #pragma region command pool and command buffer
 		command_pool create_command_pool(uint32_t aQueueFamilyIndex, vk::CommandPoolCreateFlags aCreateFlags = vk::CommandPoolCreateFlags());
+
+		/**	Create a manager which owns transient command pools per thread, queue family, and frame in flight,
+		 *	and which recycles their command buffers, s.t. steady-state frames do not allocate any command buffers.
+		 *	@param	aNumberOfFramesInFlight		The number of frames whose command buffers can be in use concurrently.
+		 *	@return	A new command pool manager. Its pools are created lazily upon the first requests.
+		 */
+		command_pool_manager create_command_pool_manager(size_t aNumberOfFramesInFlight);
 #pragma endregion
 
 #pragma region compute pipeline
@@ -649,6 +889,28 @@ namespace avk
 		}
 #pragma endregion
 
+#pragma region deferred destruction
+		/**	Attach a deferred destruction queue to this root, or detach it by passing nullptr.
+		 *	While a queue is attached, command buffers hand the resources whose lifetimes they handle (see
+		 *	command_buffer_t::handle_lifetime_of) over to it when they are reset or destroyed, keyed by the
+		 *	queue's current retire value, instead of destroying them right away.
+		 *	The queue is owned by the application. It must be drained via release_all() and detached before
+		 *	the device is destroyed.
+		 */
+		void set_deferred_destruction_queue(deferred_destruction_queue* aQueue) { mDeferredDestructionQueue = aQueue; }
+
+		/** Gets the attached deferred destruction queue, or nullptr if none is attached. */
+		deferred_destruction_queue* deferred_destruction() const { return mDeferredDestructionQueue; }
+#pragma endregion
+
+#pragma region defragmenter
+		/**	Create a defragmenter which can incrementally relocate registered buffers and images.
+		 *	@param	aConfig		Limits for the amount of work that is performed during each defragmentation pass.
+		 *	@return	A new defragmenter instance, which has no resources registered yet.
+		 */
+		defragmenter create_defragmenter(defragmentation_config aConfig = {});
+#pragma endregion
+
 #pragma region descriptor pool
 		static descriptor_pool create_descriptor_pool(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, const std::vector<vk::DescriptorPoolSize>& aSizeRequirements, int aNumSets);
 		descriptor_pool create_descriptor_pool(const std::vector<vk::DescriptorPoolSize>& aSizeRequirements, int aNumSets);
@@ -663,11 +925,115 @@ namespace avk
 		set_of_descriptor_set_layouts create_set_of_descriptor_set_layouts_from_template(const set_of_descriptor_set_layouts& aTemplate);
 #pragma endregion
 
+#pragma region external memory and semaphores
+		/**	Create a buffer in device memory which can be exported, or whose memory is imported from a file descriptor.
+		 *	Requires the VK_KHR_external_memory_fd device extension, and VK_EXT_external_memory_dma_buf for dma-bufs.
+		 *	@param	aRoot				The root to create the buffer with.
+		 *	@param	aExternalMemory		Handle types to be exported, or the file descriptor to be imported.
+		 *	@param	aMetaData			Meta data of the buffer, whose first entry determines the size.
+		 *	@param	aBufferUsage		Usage flags of the buffer.
+		 */
+		static buffer create_buffer(
+			const root& aRoot,
+			std::variant<external_memory_export, external_memory_import> aExternalMemory,
+#if VK_HEADER_VERSION >= 135
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#else
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#endif
+			vk::BufferUsageFlags aBufferUsage
+		);
+
+		/**	Create a buffer in device memory which can be exported, or whose memory is imported from a file descriptor.
+		 *	See the static overload for details.
+		 *	Example, sharing a buffer with another process:
+		 *		auto buf = myRoot.create_buffer(avk::external_memory_export{}, vk::BufferUsageFlagBits::eTransferDst, avk::generic_buffer_meta::create_from_size(size));
+		 *		int fd = myRoot.export_memory_fd(buf.get());
+		 *		// ... and in the other process:
+		 *		auto buf = myRoot.create_buffer(avk::external_memory_import{ fd }, vk::BufferUsageFlagBits::eTransferSrc, avk::generic_buffer_meta::create_from_size(size));
+		 */
+		template <typename Meta, typename... Metas>
+		buffer create_buffer(
+			std::variant<external_memory_export, external_memory_import> aExternalMemory,
+			vk::BufferUsageFlags aAdditionalUsageFlags,
+			Meta aConfig, Metas... aConfigs)
+		{
+#if VK_HEADER_VERSION >= 135
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#else
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#endif
+			vk::BufferUsageFlags usage = aAdditionalUsageFlags;
+			metas.push_back(aConfig);
+			usage |= aConfig.buffer_usage_flags();
+			if constexpr (sizeof...(aConfigs) > 0) {
+				usage |= (... | aConfigs.buffer_usage_flags());
+				(metas.push_back(aConfigs), ...);
+			}
+			return create_buffer(*this, std::move(aExternalMemory), std::move(metas), usage);
+		}
+
+		/**	Create an image in device memory which can be exported, or whose memory is imported from a file descriptor.
+		 *	Requires the VK_KHR_external_memory_fd device extension, and VK_EXT_external_memory_dma_buf for dma-bufs.
+		 *	Note that other APIs usually require a linear tiling for dma-bufs, which can be set via aAlterConfigBeforeCreation.
+		 *	The other parameters are the same as for create_image.
+		 *	@param	aExternalMemory		Handle types to be exported, or the file descriptor to be imported.
+		 */
+		image create_image(std::variant<external_memory_export, external_memory_import> aExternalMemory, uint32_t aWidth, uint32_t aHeight, vk::Format aFormat, int aNumLayers = 1, avk::image_usage aImageUsage = avk::image_usage::general_image, std::function<void(image_t&)> aAlterConfigBeforeCreation = {});
+
+		/**	Export the memory of a buffer which has been created with external_memory_export.
+		 *	@param	aBuffer			The buffer whose memory shall be exported.
+		 *	@param	aHandleType		One of the handle types that have been requested via external_memory_export.
+		 *	@return	A new file descriptor, owned by the caller.
+		 */
+		int export_memory_fd(const buffer_t& aBuffer, vk::ExternalMemoryHandleTypeFlagBits aHandleType = vk::ExternalMemoryHandleTypeFlagBits::eOpaqueFd) const;
+
+		/**	Export the memory of an image which has been created with external_memory_export.
+		 *	@param	aImage			The image whose memory shall be exported.
+		 *	@param	aHandleType		One of the handle types that have been requested via external_memory_export.
+		 *	@return	A new file descriptor, owned by the caller.
+		 */
+		int export_memory_fd(const image_t& aImage, vk::ExternalMemoryHandleTypeFlagBits aHandleType = vk::ExternalMemoryHandleTypeFlagBits::eOpaqueFd) const;
+
+		/**	Create a semaphore which can be exported as a file descriptor (VK_KHR_external_semaphore_fd).
+		 *	@param	aHandleTypes				All the handle types which the semaphore shall be exportable as.
+		 *	@param	aAlterConfigBeforeCreation	Use it to alter the semaphore_t configuration before it is actually being created, e.g., to make it a timeline semaphore.
+		 */
+		semaphore create_exportable_semaphore(vk::ExternalSemaphoreHandleTypeFlags aHandleTypes = vk::ExternalSemaphoreHandleTypeFlagBits::eOpaqueFd, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation = {});
+
+		/**	Export a semaphore which has been created via create_exportable_semaphore.
+		 *	Exporting as eSyncFd requires the semaphore to be signaled or to have a pending signal operation.
+		 *	@return	A new file descriptor, owned by the caller.
+		 */
+		int export_semaphore_fd(const semaphore_t& aSemaphore, vk::ExternalSemaphoreHandleTypeFlagBits aHandleType = vk::ExternalSemaphoreHandleTypeFlagBits::eOpaqueFd) const;
+
+		/**	Import a semaphore payload from a file descriptor into an existing semaphore.
+		 *	If the import succeeds, the implementation takes ownership of the file descriptor.
+		 *	@param	aSemaphore		The semaphore which the payload shall be imported into.
+		 *	@param	aFd				The file descriptor which has been exported by another device, process, or API.
+		 *	@param	aHandleType		The type of the file descriptor.
+		 *	@param	aTemporary		If true, the imported payload is only used until the next wait operation. Must be true for eSyncFd.
+		 */
+		void import_semaphore_fd(const semaphore_t& aSemaphore, int aFd, vk::ExternalSemaphoreHandleTypeFlagBits aHandleType = vk::ExternalSemaphoreHandleTypeFlagBits::eOpaqueFd, bool aTemporary = false) const;
+#pragma endregion
+
 #pragma region fence
 		static fence create_fence(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, bool aCreateInSignalledState = false, std::function<void(fence_t&)> aAlterConfigBeforeCreation = {});
 		fence create_fence(bool aCreateInSignalledState = false, std::function<void(fence_t&)> aAlterConfigBeforeCreation = {});
 #pragma endregion
 
+#pragma region frame linear allocator
+		/**	Create a linear allocator for transient per-frame data, which hands out slices of persistently mapped buffers.
+		 *	@param	aNumberOfFramesInFlight		The number of frames whose allocations can be in use concurrently.
+		 *	@param	aChunkSize					Size of each buffer in bytes. Additional buffers are created on demand if a frame requires more memory.
+		 *	@param	aBufferUsageFlags			Usage flags of the buffers, e.g., eVertexBuffer | eIndexBuffer | eUniformBuffer | eIndirectBuffer.
+		 *	@param	aMemoryProperties			Memory properties of the buffers. Must contain eHostVisible and eHostCoherent.
+		 *										Add eDeviceLocal if is_memory_type_supported reports support for it.
+		 *	@return	A new frame linear allocator. Its buffers are created lazily upon the first allocations.
+		 */
+		frame_linear_allocator create_frame_linear_allocator(size_t aNumberOfFramesInFlight, vk::DeviceSize aChunkSize, vk::BufferUsageFlags aBufferUsageFlags, vk::MemoryPropertyFlags aMemoryProperties = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+#pragma endregion
+
 #pragma region framebuffer
 		// Helper methods for the create methods that take attachments and image views
 		void check_and_config_attachments_based_on_views(std::vector<attachment>& aAttachments, std::vector<image_view>& aImageViews);
@@ -704,6 +1070,23 @@ namespace avk
 #endif
 #pragma endregion
 
+#pragma region gpu vector
+		/**	Create a growable array of elements in device-local memory.
+		 *	@tparam	T						The element type. Must be trivially copyable.
+		 *	@param	aInitialCapacity		The number of elements which the initial buffers have space for.
+		 *	@param	aBufferUsageFlags		Usage flags of the device buffer, e.g. eStorageBuffer. Transfer usages are added automatically.
+		 *	@param	aConfig					Configures growth via sparse binding instead of GPU-side copies.
+		 *	@return	A new, empty gpu_vector.
+		 */
+		template <typename T>
+		gpu_vector<T> create_gpu_vector(size_t aInitialCapacity, vk::BufferUsageFlags aBufferUsageFlags, gpu_vector_config aConfig = {})
+		{
+			gpu_vector<T> result;
+			static_cast<gpu_vector_base&>(result).initialize(*this, sizeof(T), aInitialCapacity, aBufferUsageFlags, aConfig);
+			return result;
+		}
+#pragma endregion
+
 #pragma region graphics pipeline
 		/** Helper function which internally rewires all the config that is necessary for graphics pipeline creation. */
 		void rewire_config_and_create_graphics_pipeline(graphics_pipeline_t& aPreparedPipeline);
@@ -834,6 +1217,14 @@ namespace avk
 #pragma endregion
 
 #pragma region image
+		/** Prepares the configuration of a new image, but neither creates the image nor allocates any memory for it.
+		 *	The parameters are the same as for create_image.
+		 *	@return	A tuple with the following elements:
+		 *			[0]: The configured image_t, whose create_info() is ready to be handed over to the API.
+		 *			[1]: The memory property flags which the image's memory shall be allocated with.
+		 */
+		std::tuple<image_t, vk::MemoryPropertyFlags> configure_image(uint32_t aWidth, uint32_t aHeight, std::tuple<vk::Format, vk::SampleCountFlagBits> aFormatAndSamples, int aNumLayers, memory_usage aMemoryUsage, avk::image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation);
+
 		image create_image_from_template(const image_t& aTemplate, std::function<void(image_t&)> aAlterConfigBeforeCreation = {});
 
 		/** Creates a new image
@@ -882,6 +1273,20 @@ namespace avk
 		*/
 		image create_depth_stencil_image(uint32_t aWidth, uint32_t aHeight, std::optional<vk::Format> aFormat = std::nullopt, int aNumLayers = 1,  memory_usage aMemoryUsage = memory_usage::device, avk::image_usage aImageUsage = avk::image_usage::general_depth_stencil_attachment, std::function<void(image_t&)> aAlterConfigBeforeCreation = {});
 
+		/** Creates a new image which is suitable to be used for the given attachment
+		*	If the attachment neither loads nor stores its contents (see attachment::is_transient), and no additional usages
+		*	besides attachment usages are requested, the image is created with memory_usage::device_transient, i.e. as
+		*	transient attachment in lazily allocated memory where supported, and in ordinary device memory otherwise.
+		*	@param	aAttachment					The attachment which the image is to be created for. Its format, sample count, and subpass usages are taken into account.
+		*	@param	aWidth						The width of the image to be created
+		*	@param	aHeight						The height of the image to be created
+		*	@param	aNumLayers					How many layers the image to be created shall contain.
+		*	@param	aAdditionalImageUsage		Image usages in addition to the attachment usages derived from aAttachment.
+		*	@param	aAlterConfigBeforeCreation	A context-specific function which allows to modify the `vk::ImageCreateInfo` just before the image will be created. Use `.create_info()` to access the configuration structure!
+		*	@return	Returns a newly created image.
+		*/
+		image create_image_for_attachment(const attachment& aAttachment, uint32_t aWidth, uint32_t aHeight, int aNumLayers = 1, avk::image_usage aAdditionalImageUsage = avk::image_usage::tiling_optimal, std::function<void(image_t&)> aAlterConfigBeforeCreation = {});
+
 		image_t wrap_image(vk::Image aImageToWrap, vk::ImageCreateInfo aImageCreateInfo, avk::image_usage aImageUsage, vk::ImageAspectFlags aImageAspectFlags);
 #pragma endregion
 
@@ -1007,6 +1412,13 @@ namespace avk
 		renderpass create_renderpass_from_template(const renderpass_t& aTemplate, std::function<void(renderpass_t&)> aAlterConfigBeforeCreation = {});
 #pragma endregion
 
+#pragma region scatter upload
+		/**	Create the built-in compute pipeline which is used by command::scatter_upload in order to apply many small patches at once.
+		 *	Requires the bufferDeviceAddress device feature.
+		 */
+		scatter_upload_pipeline create_scatter_upload_pipeline();
+#pragma endregion
+
 #pragma region semaphore
 		static semaphore create_semaphore(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation = {});
 		semaphore create_semaphore(std::function<void(semaphore_t&)> aAlterConfigBeforeCreation = {});
@@ -1058,5 +1470,24 @@ namespace avk
 		 *	@param	aRecordedCommands	Stuff to be put into a new instance of avk::recoded_commands
 		 */
 		avk::recorded_commands record(std::vector<recorded_commands_t> aRecordedCommands) const;
+
+	private:
+		/**	Allocate dedicated memory for a buffer or image whose memory is exported or imported via file descriptors.
+		 *	Internal helper of the external memory overloads of create_buffer and create_image, which validate the handle types beforehand.
+		 *	@param	aRequirements			Memory requirements of the resource.
+		 *	@param	aDedicatedResource		The resource which the memory is dedicated to.
+		 *	@param	aExternalMemory			Handle types to be exported, or the file descriptor to be imported.
+		 *	@param	aDeviceAddress			Whether the memory must support buffer device addresses.
+		 *	@return	A tuple with the following elements:
+		 *			[0]: The memory
+		 *			[1]: The index of the memory type which the memory has been allocated from
+		 *			[2]: The property flags of that memory type
+		 */
+		std::tuple<vk::UniqueHandle<vk::DeviceMemory, DISPATCH_LOADER_CORE_TYPE>, uint32_t, vk::MemoryPropertyFlags> allocate_external_memory(vk::MemoryRequirements aRequirements, std::variant<vk::Buffer, vk::Image> aDedicatedResource, std::variant<external_memory_export, external_memory_import> aExternalMemory, bool aDeviceAddress) const;
+
+		deferred_destruction_queue* mDeferredDestructionQueue = nullptr;
+		// Behind pointers, s.t. the root stays movable although the caches are not:
+		std::unique_ptr<device_capabilities> mCapabilities = std::make_unique<device_capabilities>(this);
+		std::unique_ptr<barrier_plan_cache> mBarrierPlanCache = std::make_unique<barrier_plan_cache>();
 	};
 }
@@ -0,0 +1,156 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	class baked_commands_t;
+
+	/**	Passed to the bake function of a baked_commands_t, once for each variant which is (re-)baked. */
+	struct bake_context
+	{
+		/** The index of the variant which is being baked, in [0, number_of_variants()). */
+		size_t mVariant;
+
+		/**	The region of the parameter buffer which belongs to this variant. Per-frame values must not be baked into the
+		 *	commands, but be read from here, e.g., via indirect draw/dispatch parameters, via a uniform or storage buffer
+		 *	descriptor, or via the buffer's device address passed as push constant. They can then be patched every frame
+		 *	through baked_commands_t::parameters without re-baking.
+		 *	Empty if the baked commands have been created without parameters.
+		 */
+		std::optional<buffer_slice> mParameters;
+
+		/** The baked commands. Use it to register further resources via depends_on. */
+		baked_commands_t* mBakedCommands;
+	};
+
+	/**	Commands which are recorded once into reusable command buffers, and replayed in every frame until they are invalidated.
+	 *
+	 *	There is one variant per frame in flight, each of which is an own command buffer with its own region of the
+	 *	parameter buffer. Variants are baked lazily by get() or execute() via the bake function, and they stay valid until
+	 *	invalidate() is invoked, or until notify_changed() is invoked with a resource which the commands refer to.
+	 *	The referenced resources are gathered from the resource-specific sync hints and from the sync commands of the
+	 *	baked commands. Further resources, e.g. those which are referenced through descriptor sets, must be registered
+	 *	with depends_on during baking.
+	 *
+	 *	Usage:
+	 *	 1. Create it via root::create_baked_commands with a function which returns the commands for a given bake_context.
+	 *	 2. Every frame, after waiting for the frame which has used the same variant before, write the per-frame values
+	 *	    via parameters(aFrameIndex), and submit get(aFrameIndex), or record execute(aFrameIndex) for secondary levels.
+	 *	 3. Invoke notify_changed when resources are recreated, e.g. after a gpu_vector has grown
+	 *	    (see gpu_vector_base::add_dependent_baked_commands).
+	 *
+	 *	ATTENTION: Image layout tracking is applied when the commands are baked, not when they are replayed.
+	 *	           Baked commands must therefore leave tracked images in the layouts in which they found them.
+	 */
+	class baked_commands_t
+	{
+		friend class root;
+
+		struct variant
+		{
+			command_buffer mCommandBuffer;
+			bool mIsBaked = false;
+		};
+
+	public:
+		using bake_function = std::function<std::vector<recorded_commands_t>(const bake_context&)>;
+
+		baked_commands_t() = default;
+		baked_commands_t(baked_commands_t&&) noexcept = default;
+		baked_commands_t(const baked_commands_t&) = delete;
+		baked_commands_t& operator=(baked_commands_t&&) noexcept = default;
+		baked_commands_t& operator=(const baked_commands_t&) = delete;
+		~baked_commands_t() = default;
+
+		/**	Gets the command buffer of the variant aFrameIndex % number_of_variants(), baking it first if it is not valid.
+		 *	The device must have finished the previous execution of that variant.
+		 *	@param	aFrameIndex		A monotonically increasing value identifying the frame, e.g., the frame index.
+		 */
+		command_buffer_t& get(uint64_t aFrameIndex);
+
+		/**	Gets a command which executes the variant aFrameIndex % number_of_variants() from within a primary command buffer.
+		 *	Only for baked commands of level vk::CommandBufferLevel::eSecondary.
+		 *	@param	aFrameIndex		A monotonically increasing value identifying the frame, e.g., the frame index.
+		 *	@param	aSyncHint		Describes the baked commands for the sync of previous and subsequent commands.
+		 */
+		command::action_type_command execute(uint64_t aFrameIndex, avk::sync::sync_hint aSyncHint = {});
+
+		/**	Gets a pointer to the persistently mapped parameter region of the variant aFrameIndex % number_of_variants().
+		 *	Writes are visible to the device in the next submission. Returns nullptr if there are no parameters.
+		 */
+		void* parameters(uint64_t aFrameIndex) const;
+
+		/**	Patch a value in the parameter region of the variant aFrameIndex % number_of_variants().
+		 *	@param	aFrameIndex		A monotonically increasing value identifying the frame, e.g., the frame index.
+		 *	@param	aOffset			Offset in bytes into the variant's parameter region.
+		 *	@param	aValue			The value to be written. aOffset + sizeof(T) must not exceed parameters_size().
+		 */
+		template <typename T>
+		void set_parameter(uint64_t aFrameIndex, vk::DeviceSize aOffset, const T& aValue)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Parameters must be trivially copyable.");
+			assert(aOffset + sizeof(T) <= mParametersSize);
+			memcpy(static_cast<uint8_t*>(parameters(aFrameIndex)) + aOffset, &aValue, sizeof(T));
+		}
+
+		/**	Register a resource which the baked commands refer to, s.t. they are invalidated when it changes.
+		 *	Intended to be invoked from within the bake function.
+		 */
+		void depends_on(vk::Buffer aBuffer) { mReferencedBuffers.insert(static_cast<VkBuffer>(aBuffer)); }
+		/**	Register a resource which the baked commands refer to, s.t. they are invalidated when it changes.
+		 *	Intended to be invoked from within the bake function.
+		 */
+		void depends_on(vk::Image aImage) { mReferencedImages.insert(static_cast<VkImage>(aImage)); }
+
+		/** Returns true if the baked commands refer to the given buffer. */
+		bool references(vk::Buffer aBuffer) const { return mReferencedBuffers.contains(static_cast<VkBuffer>(aBuffer)); }
+		/** Returns true if the baked commands refer to the given image. */
+		bool references(vk::Image aImage) const { return mReferencedImages.contains(static_cast<VkImage>(aImage)); }
+
+		/**	Tell the baked commands that a resource has changed, e.g., that it has been destroyed or recreated.
+		 *	@return	True if the baked commands refer to it, which invalidates all variants.
+		 */
+		bool notify_changed(vk::Buffer aBuffer);
+		/**	Tell the baked commands that a resource has changed, e.g., that it has been destroyed or recreated.
+		 *	@return	True if the baked commands refer to it, which invalidates all variants.
+		 */
+		bool notify_changed(vk::Image aImage);
+
+		/** Invalidate all variants, s.t. they are baked again when they are used next. */
+		void invalidate();
+
+		/** Returns true if the variant aFrameIndex % number_of_variants() is baked and can be replayed. */
+		bool is_baked(uint64_t aFrameIndex) const { return mVariants[aFrameIndex % mVariants.size()].mIsBaked; }
+
+		/** The number of variants, i.e. the number of frames in flight. */
+		size_t number_of_variants() const { return mVariants.size(); }
+		/** The size of each variant's parameter region in bytes. */
+		vk::DeviceSize parameters_size() const { return mParametersSize; }
+		/** The number of times that variants have been baked, in order to find out how often they are invalidated. */
+		size_t number_of_bakes() const { return mNumBakes; }
+
+	private:
+		void bake(size_t aVariant);
+		void gather_referenced_resources(const std::vector<recorded_commands_t>& aCommands);
+
+		root* mRoot = nullptr;
+		bake_function mBakeFunction;
+		vk::CommandBufferLevel mLevel = vk::CommandBufferLevel::ePrimary;
+		secondary_command_buffer_inheritance mInheritance;
+		command_pool mCommandPool;
+		std::vector<variant> mVariants;
+
+		vk::DeviceSize mParametersSize = 0;
+		vk::DeviceSize mParametersStride = 0;
+		buffer mParametersBuffer;
+		// Declared after mParametersBuffer => unmapped before the buffer is destroyed:
+		std::optional<scoped_mapping<AVK_MEM_BUFFER_HANDLE>> mParametersMapping;
+
+		std::unordered_set<VkBuffer> mReferencedBuffers;
+		std::unordered_set<VkImage> mReferencedImages;
+		size_t mNumBakes = 0;
+	};
+
+	/** Typedef representing any kind of OWNING baked commands representations. */
+	using baked_commands = owning_resource<baked_commands_t>;
+}
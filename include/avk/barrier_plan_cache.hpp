@@ -0,0 +1,91 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	The resolved stages and accesses of all the sync_type_commands of a list of recorded commands.
+	 *	A barrier plan can be reused for every list of recorded commands with the same structure, i.e. with equal
+	 *	sync hints of its action_type_commands, and equal stages, accesses, and resources of its sync_type_commands.
+	 */
+	struct barrier_plan
+	{
+		/** The stages and accesses of one barrier. */
+		struct sync_scope
+		{
+			vk::PipelineStageFlags2KHR mSrcStage;
+			vk::PipelineStageFlags2KHR mDstStage;
+			vk::AccessFlags2KHR mSrcAccess;
+			vk::AccessFlags2KHR mDstAccess;
+			/** True if the source scope is to be inferred automatically, but no command precedes the barrier, i.e., it is a full dependency. */
+			bool mSrcUndetermined = false;
+		};
+
+		/** Flat representation of everything which the inference of stages and accesses depends on. */
+		std::vector<uint64_t> mStructure;
+		/** One entry per sync_type_command, in the order of the list of recorded commands. */
+		std::vector<sync_scope> mSyncScopes;
+	};
+
+	/**	Caches barrier plans, s.t. recording a list of commands with the same structure as a previously
+	 *	recorded one does not have to infer the stages and accesses of its barriers (e.g. avk::stage::auto_stage)
+	 *	again. Typically, the commands which are recorded every frame have the same structure in every frame.
+	 *
+	 *	Plans are looked up by the hash of their structure, and their structures are compared on lookup,
+	 *	s.t. hash collisions can never lead to wrong barriers. Since a plan depends on nothing but its
+	 *	structure, cached plans never become outdated, not even if resources are destroyed.
+	 *	If the cache is full (see AVK_BARRIER_PLAN_CACHE_MAX_ENTRIES), the least recently used plan is evicted,
+	 *	s.t. one-off lists (e.g. uploads) do not displace the plans which are needed every frame.
+	 *	All methods are thread-safe.
+	 *
+	 *	Use root::barrier_plans() to get a root's cache.
+	 */
+	class barrier_plan_cache
+	{
+		struct entry
+		{
+			size_t mHash;
+			std::shared_ptr<const barrier_plan> mPlan;
+		};
+
+	public:
+		barrier_plan_cache() = default;
+		barrier_plan_cache(barrier_plan_cache&&) = delete;
+		barrier_plan_cache(const barrier_plan_cache&) = delete;
+		barrier_plan_cache& operator=(barrier_plan_cache&&) = delete;
+		barrier_plan_cache& operator=(const barrier_plan_cache&) = delete;
+		~barrier_plan_cache() = default;
+
+		/**	Gets the cached plan of the given structure, marks it as most recently used, and counts a hit,
+		 *	or returns nullptr and counts a miss.
+		 *	@param	aHash		Hash of aStructure
+		 *	@param	aStructure	Flat representation of the structure, see barrier_plan::mStructure
+		 */
+		std::shared_ptr<const barrier_plan> find(size_t aHash, const std::vector<uint64_t>& aStructure);
+
+		/**	Stores the given plan as the most recently used one, evicting the least recently used plan first if the cache is full.
+		 *	@param	aHash		Hash of aPlan->mStructure
+		 *	@param	aPlan		The plan to be stored
+		 */
+		void insert(size_t aHash, std::shared_ptr<const barrier_plan> aPlan);
+
+		/** Evicts all cached plans. */
+		void clear();
+		/** Resets the numbers of hits and misses to zero. */
+		void reset_statistics();
+
+		/** The number of cached plans. */
+		size_t size() const;
+		/** The number of lookups which have found a cached plan. */
+		size_t number_of_hits() const;
+		/** The number of lookups which have not found a cached plan. */
+		size_t number_of_misses() const;
+
+	private:
+		mutable std::mutex mMutex;
+		// Ordered from the most recently used to the least recently used plan:
+		std::list<entry> mEntries;
+		std::unordered_multimap<size_t, std::list<entry>::iterator> mEntriesByHash;
+		size_t mNumHits = 0;
+		size_t mNumMisses = 0;
+	};
+}
@@ -6,6 +6,7 @@ namespace avk
 	class command_buffer_t;
 	using command_buffer = avk::owning_resource<command_buffer_t>;
 	class old_sync;
+	class buffer_slice;
 	
 	/**	A helper-class representing a descriptor to a given buffer,
 	 *	containing the descriptor type and the descriptor info.
@@ -17,6 +18,7 @@ namespace avk
 	class buffer_descriptor
 	{
 		friend class buffer_t;
+		friend class buffer_slice;
 		
 	public:
 		auto descriptor_type() const { return mDescriptorType; }
@@ -27,12 +29,41 @@ namespace avk
 		vk::DescriptorBufferInfo mDescriptorInfo;
 	};
 	
+	/**	Statistics about the most recent fill operation of a buffer.
+	 *	Only if a shadow copy is enabled, bytes can be skipped.
+	 */
+	struct fill_statistics
+	{
+		/** Number of bytes which have been passed to fill */
+		size_t mBytesRequested = 0;
+		/** Number of bytes which have actually been written or transferred */
+		size_t mBytesUploaded = 0;
+		/** Number of bytes which have been skipped, because they have not changed since the previous fill */
+		size_t mBytesSkipped = 0;
+		/** Number of contiguous ranges which have been written or transferred */
+		size_t mNumRanges = 0;
+	};
+
+	/**	Host memory which shall be used as a buffer's backing storage, without copying it (VK_EXT_external_memory_host).
+	 *	See root::create_buffer. The memory must stay valid for the whole lifetime of the buffer.
+	 */
+	struct host_memory_import
+	{
+		/** Start of the buffer's data, e.g., memory returned by malloc or the address of a memory-mapped file (plus an offset). */
+		void* mHostPointer;
+		/** Use eHostMappedForeignMemoryEXT for memory which has been mapped from another device, e.g., a PCIe BAR. */
+		vk::ExternalMemoryHandleTypeFlagBits mHandleType = vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT;
+	};
+
 	/** Represents a Vulkan buffer along with its assigned memory, holds the 
 	*	native handle and takes care about lifetime management of the native handles.
 	*/
 	class buffer_t
 	{
 		friend class root;
+		friend class defragmenter_t;
+		friend class aliasing_heap_t;
+		friend class gpu_vector_base;
 
 		struct get_buffer_meta
 		{
@@ -95,8 +126,25 @@ namespace avk
 		 *	memory, its data pointer can be used to read or write to/from the mapped memory.
 		 *	A scoped_mapping is returned which will automatically unmap the memory upon destruction.
 		 *	Use its .get() method to get the data pointer, but do not unmap manually!
+		 *	Buffers which use imported host memory or external memory can not be mapped this way.
+		 *	Use imported_host_pointer for the former.
+		 */
+		scoped_mapping<AVK_MEM_BUFFER_HANDLE> map_memory(mapping_access aAcces) const { assert(!mExternalMemory); return {mBuffer, aAcces}; }
+
+		/** Returns true if this buffer uses host memory which has been imported via root::create_buffer(host_memory_import, ...). */
+		bool is_imported_host_memory() const { return nullptr != mImportedHostPointer; }
+		/** The host pointer which this buffer's data is located at, if it uses imported host memory, nullptr otherwise. */
+		void* imported_host_pointer() const { return mImportedHostPointer; }
+		/**	Flush writes through the imported host pointer, s.t. they become available to the device.
+		 *	Only has an effect if the imported memory is not host-coherent, see memory_properties().
+		 */
+		void flush_imported_host_memory() const { if (is_imported_host_memory()) { unmap_host_accessible_memory(mapping_access::write); } }
+		/**	Invalidate the imported host memory, s.t. device writes become visible through the imported host pointer.
+		 *	Only has an effect if the imported memory is not host-coherent, see memory_properties().
 		 */
-		scoped_mapping<AVK_MEM_BUFFER_HANDLE> map_memory(mapping_access aAcces) const { return {mBuffer, aAcces}; }
+		void invalidate_imported_host_memory() const { if (is_imported_host_memory()) { map_host_accessible_memory(mapping_access::read); } }
+		/** Returns true if this buffer's memory is exportable, or has been imported via root::create_buffer(external_memory_import, ...). */
+		bool has_external_memory() const { return static_cast<bool>(mExternalMemory) && !is_imported_host_memory(); }
 		
 		auto usage_flags() const	{ return mBufferUsageFlags; }
 		auto memory_properties() const          { return mBuffer.memory_properties(); }
@@ -217,6 +265,12 @@ namespace avk
 		/** Get a buffer_descriptor for binding this buffer as a uniform buffer. */
 		auto as_storage_buffer() const { return get_buffer_descriptor<storage_buffer_meta>(); }
 
+		/**	Get a non-owning reference to a range within this buffer.
+		 *	@param	aOffset		Offset of the range from the start of the buffer in bytes.
+		 *	@param	aSize		Size of the range in bytes. VK_WHOLE_SIZE means until the end of the buffer.
+		 */
+		buffer_slice slice(vk::DeviceSize aOffset = 0, vk::DeviceSize aSize = VK_WHOLE_SIZE) const;
+
 		/** Fill buffer with data.
 		 *  The buffer's size is determined from its metadata.
 		 *	Please note: The returned command will not contain any sort of lifetime handling measure for the given buffer.
@@ -235,6 +289,27 @@ namespace avk
 		*/
 		command::action_type_command fill(const void* aDataPtr, size_t aMetaDataIndex, size_t aOffsetInBytes, size_t aDataSizeInBytes) const;
 
+		/**	Keep a host-side copy of the contents which have been uploaded via fill, and only upload
+		 *	the blocks which differ from the previous contents during subsequent fill operations.
+		 *	Modified blocks are coalesced into contiguous ranges. Blocks which have never been filled are always uploaded.
+		 *	ATTENTION: Only use this mode for buffers which are exclusively written by fill, not by the device.
+		 *	ATTENTION: The shadow copy is updated when fill is invoked, not when the returned command is executed.
+		 *	           For buffers which are not host-visible, every command returned by fill must therefore be recorded
+		 *	           and executed, in the order in which fill has been invoked. If a returned command is discarded,
+		 *	           call disable_shadow_copy and enable_shadow_copy to have all the data uploaded again.
+		 *	@param	aBlockSize	Granularity of the comparison in bytes. The default corresponds to a cache line.
+		 */
+		void enable_shadow_copy(size_t aBlockSize = 64);
+
+		/** Release the host-side copy. Subsequent fill operations upload all the data again. */
+		void disable_shadow_copy() { std::scoped_lock lock(*mFillMutex); mShadowCopy.reset(); }
+
+		/** Returns true if fill operations only upload modified blocks. */
+		bool has_shadow_copy() const { std::scoped_lock lock(*mFillMutex); return mShadowCopy.has_value(); }
+
+		/** Statistics about the most recent fill operation. */
+		fill_statistics last_fill_statistics() const { std::scoped_lock lock(*mFillMutex); return mLastFillStatistics; }
+
 		/**	Reads values from a buffer back into some host-side memory.
 		 *	@param	aDataPtr		Where to store the read-back memory into.
 		 *	@param	aMetaDataIndex	Which meta data index shall be used to determine the data size to be read back.
@@ -253,6 +328,17 @@ namespace avk
 		 */
 		avk::command::action_type_command read_into(void* aDataPtr, size_t aMetaDataIndex) const;
 
+		/**	Reads a range of a buffer back into some host-side memory.
+		 *	@param	aDataPtr			Where to store the read-back memory into. MUST point to at least aDataSizeInBytes bytes.
+		 *	@param	aMetaDataIndex		Index of the buffer metadata to use (for size validation only)
+		 *	@param	aOffsetInBytes		Offset from the start of the buffer where reading starts
+		 *	@param	aDataSizeInBytes	Number of bytes to read back
+		 *	@return	An avk::command is returned which you, generally, must send to a queue to be executed.
+		 *			It could be that the returned command is empty. This will happen if the buffer's memory
+		 *			is stored in a host visible memory region.
+		 */
+		avk::command::action_type_command read_into(void* aDataPtr, size_t aMetaDataIndex, size_t aOffsetInBytes, size_t aDataSizeInBytes) const;
+
 		/**
 		 * Read back data from a buffer that is backed by host-visible memory.
 		 * This is a convenience overload to avk::read, and is mostly intended to be used for small amounts of data,
@@ -278,6 +364,10 @@ namespace avk
 		[[nodiscard]] const auto* root_ptr() const { return mRoot; }
 
 	private:
+		// Map the memory for host access. In contrast to map_memory, this also works for imported and external memory:
+		void* map_host_accessible_memory(mapping_access aAccess) const;
+		void unmap_host_accessible_memory(mapping_access aAccess) const;
+
 #if VK_HEADER_VERSION >= 135
 		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> mMetaData;
 #else
@@ -285,11 +375,28 @@ namespace avk
 #endif
 		vk::BufferCreateInfo mCreateInfo;
 		vk::BufferUsageFlags mBufferUsageFlags;
+		// Imported host memory or memory which is exported/imported via file descriptors, if any.
+		// Declared before mBuffer => freed after the buffer has been destroyed:
+		vk::UniqueHandle<vk::DeviceMemory, DISPATCH_LOADER_CORE_TYPE> mExternalMemory;
+		void* mImportedHostPointer = nullptr;
 		AVK_MEM_BUFFER_HANDLE mBuffer;
 		const root* mRoot;
 		std::optional<vk::DeviceAddress> mDeviceAddress;
 
 		mutable std::optional<vk::DescriptorBufferInfo> mDescriptorInfo;
+
+		struct shadow_copy
+		{
+			std::vector<uint8_t> mData;
+			// Blocks which have been filled at least once, i.e., whose contents in mData are valid:
+			std::vector<bool> mValidBlocks;
+			size_t mBlockSize;
+		};
+		// fill is const, but updates the shadow copy and the statistics => concurrent fills are serialized by mFillMutex.
+		// Behind a pointer, s.t. the buffer stays movable:
+		std::unique_ptr<std::mutex> mFillMutex = std::make_unique<std::mutex>();
+		mutable std::optional<shadow_copy> mShadowCopy;
+		mutable fill_statistics mLastFillStatistics;
 	};
 
 	/** Typedef representing any kind of OWNING buffer representation. */
@@ -0,0 +1,114 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	A non-owning reference to a range within a buffer, i.e. a buffer plus an offset plus a size.
+	 *	This allows to pack many meshes, uniform blocks, or storage arrays into few large buffers
+	 *	and to refer to their sub-ranges in descriptors, buffer views, fill/read operations,
+	 *	copies, and vertex/index buffer bindings.
+	 *
+	 *	The referenced buffer must outlive the slice and all commands which have been created from it.
+	 *	Offsets must respect the alignment requirements of the respective usage, e.g.
+	 *	minUniformBufferOffsetAlignment or minStorageBufferOffsetAlignment for descriptors.
+	 */
+	class buffer_slice
+	{
+	public:
+		/**	Create a slice of the given buffer.
+		 *	@param	aBuffer		The buffer which is referenced by the slice.
+		 *	@param	aOffset		Offset of the slice from the start of the buffer in bytes.
+		 *	@param	aSize		Size of the slice in bytes. VK_WHOLE_SIZE means until the end of the buffer.
+		 *	Throws an avk::logic_error if the range exceeds the buffer.
+		 */
+		explicit buffer_slice(const buffer_t& aBuffer, vk::DeviceSize aOffset = 0, vk::DeviceSize aSize = VK_WHOLE_SIZE)
+			: mBuffer{ &aBuffer }
+			, mOffset{ aOffset }
+		{
+			const auto bufferSize = aBuffer.create_info().size;
+			if (aOffset > bufferSize || (VK_WHOLE_SIZE != aSize && aSize > bufferSize - aOffset)) {
+				throw avk::logic_error("The slice [" + std::to_string(aOffset) + ", +" + (VK_WHOLE_SIZE == aSize ? std::string("VK_WHOLE_SIZE") : std::to_string(aSize)) + ") exceeds the buffer's size of " + std::to_string(bufferSize) + " bytes.");
+			}
+			mSize = VK_WHOLE_SIZE == aSize ? bufferSize - aOffset : aSize;
+		}
+
+		buffer_slice(const buffer_slice&) = default;
+		buffer_slice(buffer_slice&&) noexcept = default;
+		buffer_slice& operator=(const buffer_slice&) = default;
+		buffer_slice& operator=(buffer_slice&&) noexcept = default;
+		~buffer_slice() = default;
+
+		/** The buffer which this slice refers to. */
+		const buffer_t& get_buffer() const { return *mBuffer; }
+		/** The handle of the buffer which this slice refers to. */
+		vk::Buffer handle() const { return mBuffer->handle(); }
+		/** Offset of this slice from the start of the buffer in bytes. */
+		vk::DeviceSize offset() const { return mOffset; }
+		/** Size of this slice in bytes. */
+		vk::DeviceSize size() const { return mSize; }
+
+		/**	Create a slice within this slice.
+		 *	@param	aOffset		Offset relative to the start of this slice in bytes.
+		 *	@param	aSize		Size of the sub-slice in bytes. VK_WHOLE_SIZE means until the end of this slice.
+		 *	Throws an avk::logic_error if the range exceeds this slice.
+		 */
+		buffer_slice subslice(vk::DeviceSize aOffset, vk::DeviceSize aSize = VK_WHOLE_SIZE) const
+		{
+			if (aOffset > mSize || (VK_WHOLE_SIZE != aSize && aSize > mSize - aOffset)) {
+				throw avk::logic_error("The sub-slice [" + std::to_string(aOffset) + ", +" + (VK_WHOLE_SIZE == aSize ? std::string("VK_WHOLE_SIZE") : std::to_string(aSize)) + ") exceeds the slice's size of " + std::to_string(mSize) + " bytes.");
+			}
+			return buffer_slice{ *mBuffer, mOffset + aOffset, VK_WHOLE_SIZE == aSize ? mSize - aOffset : aSize };
+		}
+
+		/** Returns true if the underlying buffer has a device address. */
+		auto has_device_address() const { return mBuffer->has_device_address(); }
+		/** The device address of the start of this slice. */
+		vk::DeviceAddress device_address() const { return mBuffer->device_address() + mOffset; }
+
+		/** Gets a descriptor info which refers to exactly this slice. */
+		vk::DescriptorBufferInfo descriptor_info() const
+		{
+			return vk::DescriptorBufferInfo{}
+				.setBuffer(handle())
+				.setOffset(mOffset)
+				.setRange(mSize);
+		}
+
+		/**	Search for the given meta data of type Meta in the underlying buffer, and build a
+		 *	buffer_descriptor instance with descriptor type and this slice's descriptor info set.
+		 */
+		template <typename Meta>
+		auto get_buffer_descriptor() const
+		{
+			buffer_descriptor result;
+			result.mDescriptorInfo = descriptor_info();
+			result.mDescriptorType = mBuffer->meta<Meta>().descriptor_type().value();
+			return result;
+		}
+
+		/** Get a buffer_descriptor for binding this slice as a uniform buffer. */
+		auto as_uniform_buffer() const { return get_buffer_descriptor<uniform_buffer_meta>(); }
+		/** Get a buffer_descriptor for binding this slice as a storage buffer. */
+		auto as_storage_buffer() const { return get_buffer_descriptor<storage_buffer_meta>(); }
+
+		/**	Fill this slice with data.
+		 *	@param	aDataPtr	Pointer to the data to copy into the slice. MUST point to at least size() bytes.
+		 */
+		command::action_type_command fill(const void* aDataPtr) const;
+
+		/**	Read this slice's contents back into host memory.
+		 *	@param	aDataPtr	Where to store the read-back data. MUST point to at least size() bytes.
+		 */
+		command::action_type_command read_into(void* aDataPtr) const;
+
+	private:
+		const buffer_t* mBuffer;
+		vk::DeviceSize mOffset;
+		vk::DeviceSize mSize;
+	};
+
+	inline buffer_slice buffer_t::slice(vk::DeviceSize aOffset, vk::DeviceSize aSize) const
+	{
+		return buffer_slice{ *this, aOffset, aSize };
+	}
+}
@@ -29,6 +29,7 @@ namespace avk
 	class buffer_view_t
 	{
 		friend class root;
+		friend class defragmenter_t;
 		
 	public:
 		buffer_view_t() = default;
@@ -80,7 +81,10 @@ namespace avk
 		{
 			if (std::holds_alternative<buffer>(mBuffer)) {
 				buffer_view_descriptor_info result;
-				result.mDescriptorInfo = std::get<buffer>(mBuffer)->descriptor_info();
+				result.mDescriptorInfo = vk::DescriptorBufferInfo{}
+					.setBuffer(buffer_handle())
+					.setOffset(mCreateInfo.offset)
+					.setRange(mCreateInfo.range);
 				result.mDescriptorType = std::get<buffer>(mBuffer)->meta<Meta>().descriptor_type().value();
 				result.mBufferViewHandle = view_handle();
 				return result;
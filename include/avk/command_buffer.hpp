@@ -7,6 +7,7 @@ namespace avk
 {
 	class bottom_level_acceleration_structure_t;
 	//class buffer_t;
+	class command_stream;
 	class buffer_view_t;
 	//class command_buffer_t;
 	class command_pool_t;
@@ -121,6 +122,7 @@ namespace avk
 		friend class root;
 		friend class queue;
 		friend class command_pool_t;
+		friend class command_pool_manager_t;
 		
 	public:
 		command_buffer_t() = default;
@@ -183,6 +185,10 @@ namespace avk
 		void invoke_post_execution_handler() const;
 
 		void begin_recording();
+		/**	Begin recording a secondary command buffer with the given inheritance info,
+		 *	which only has to stay valid during this call.
+		 */
+		void begin_recording(const vk::CommandBufferInheritanceInfo& aInheritanceInfo);
 		void end_recording();
 
 		/**	Record a given state-type command directly into the given command buffer.
@@ -209,6 +215,11 @@ namespace avk
 		 */
 		void record(std::vector<avk::recorded_commands_t> aRecordedCommandsAndSyncInstructions);
 
+		/**	Record all the commands of a command_stream directly into the given command buffer.
+		 *	In contrast to the other overloads, this does not allocate any memory.
+		 */
+		void record(const avk::command_stream& aToBeRecorded);
+
 		/** Prepare a command buffer for re-recording.
 		 *   This essentially calls (and removes) any custom deleters, and removes any post-execution-handlers.
 		 *   Call this method before re-recording an existing command buffer.
@@ -225,14 +236,111 @@ namespace avk
 		const vk::CommandBuffer* handle_ptr() const { return &mCommandBuffer.get(); }
 		auto state() const { return mState; }
 
-		void bind_descriptors(vk::PipelineBindPoint aBindingPoint, vk::PipelineLayout aLayoutHandle, std::vector<descriptor_set> aDescriptorSets);
+		/**	Bind the given descriptor sets. Consecutively numbered sets are bound with one command each.
+		 *	Sets which are already bound (see bind_descriptor_sets) are not bound again.
+		 */
+		void bind_descriptors(vk::PipelineBindPoint aBindingPoint, vk::PipelineLayout aLayoutHandle, const std::vector<descriptor_set>& aDescriptorSets);
+
+		// ----------------------- State commands with redundancy elimination -----------------------
+		// The following methods keep track of the state which has been bound to this command buffer
+		// since begin_recording() in a shadow state. If enabled via enable_redundant_state_elimination,
+		// they skip commands which would not change it, e.g., when a sorted draw list binds the same
+		// pipeline and descriptor sets for every draw.
+		// ATTENTION: State which is bound directly via handle() bypasses the shadow state. Call
+		//            invalidate_bound_state() afterwards (avk::command::custom_commands does that).
+		//            This applies to any action_type_command or state_type_command with a custom
+		//            lambda, which is why the elimination is disabled by default.
+
+		/**	Enable or disable skipping state commands which would not change the bound state. Disabled by default.
+		 *	Only enable it for command buffers whose state is exclusively bound via the methods below, or which
+		 *	invoke invalidate_bound_state() after binding state directly via handle(). The setting is kept across recordings.
+		 */
+		void enable_redundant_state_elimination(bool aEnable = true) { mEliminateRedundantState = aEnable; }
+
+		/** Returns true if state commands which would not change the bound state are skipped. */
+		bool is_redundant_state_elimination_enabled() const { return mEliminateRedundantState; }
+
+		/** Bind a pipeline, unless it is already bound to the given bind point. */
+		void bind_pipeline(vk::PipelineBindPoint aBindPoint, vk::Pipeline aPipeline);
+
+		/**	Bind descriptor sets, unless all of them are already bound with the same layout and dynamic offsets.
+		 *	@param	aBindPoint				The pipeline bind point
+		 *	@param	aLayout					The pipeline layout which the sets are bound with
+		 *	@param	aFirstSet				The set number of the first descriptor set
+		 *	@param	aNumSets				The number of descriptor sets
+		 *	@param	aSets					Pointer to aNumSets descriptor set handles
+		 *	@param	aNumDynamicOffsets		The number of dynamic offsets
+		 *	@param	aDynamicOffsets			Pointer to aNumDynamicOffsets dynamic offsets
+		 */
+		void bind_descriptor_sets(vk::PipelineBindPoint aBindPoint, vk::PipelineLayout aLayout, uint32_t aFirstSet, uint32_t aNumSets, const vk::DescriptorSet* aSets, uint32_t aNumDynamicOffsets = 0u, const uint32_t* aDynamicOffsets = nullptr);
+
+		/** Bind vertex buffers, unless all of them are already bound at the same offsets. */
+		void bind_vertex_buffers(uint32_t aFirstBinding, uint32_t aNumBuffers, const vk::Buffer* aBuffers, const vk::DeviceSize* aOffsets);
+
+		/** Bind an index buffer, unless it is already bound at the same offset with the same index type. */
+		void bind_index_buffer(vk::Buffer aBuffer, vk::DeviceSize aOffset, vk::IndexType aIndexType);
+
+		/** Update push constants, unless the given range already contains exactly the given bytes. */
+		void push_constants(vk::PipelineLayout aLayout, vk::ShaderStageFlags aStages, uint32_t aOffset, uint32_t aSize, const void* aData);
+
+		/** Set dynamic viewports, unless they are already set to the same values. */
+		void set_viewport(uint32_t aFirstViewport, uint32_t aNumViewports, const vk::Viewport* aViewports);
+
+		/** Set dynamic scissors, unless they are already set to the same values. */
+		void set_scissor(uint32_t aFirstScissor, uint32_t aNumScissors, const vk::Rect2D* aScissors);
+
+		/**	Forget all state which has been bound to this command buffer, s.t. subsequent state commands are recorded again.
+		 *	Must be invoked after state has been bound directly via handle(), and after executing secondary command buffers.
+		 */
+		void invalidate_bound_state();
+
+		/** The number of state commands which have been skipped since begin_recording(), because they would not have changed the bound state. */
+		size_t number_of_elided_calls() const { return mNumElidedCalls; }
 
 		void save_subpass_contents_state(vk::SubpassContents x) { mSubpassContentsState = x; }
 		
 		[[nodiscard]] const auto* root_ptr() const { return mRoot; }
 
 	private:
-		const root* mRoot;
+		struct bound_descriptor_set
+		{
+			vk::DescriptorSet mHandle;
+			// The range of sets which have been bound together with this set, and the dynamic offsets of that command:
+			uint32_t mFirstSetOfCommand = 0;
+			uint32_t mNumSetsOfCommand = 0;
+			std::vector<uint32_t> mDynamicOffsets;
+		};
+
+		struct bound_pipeline_state
+		{
+			vk::Pipeline mPipeline;
+			vk::PipelineLayout mDescriptorSetLayout;
+			std::vector<bound_descriptor_set> mDescriptorSets;
+		};
+
+		struct bound_push_constants
+		{
+			vk::ShaderStageFlags mStages;
+			uint32_t mOffset;
+			std::vector<uint8_t> mData;
+		};
+
+		/** Shadow copy of the state which has been bound via the methods above. Empty handles denote unknown state. */
+		struct bound_state
+		{
+			std::array<bound_pipeline_state, 3> mBindPoints; // graphics, compute, ray tracing
+			vk::PipelineLayout mPushConstantsLayout;
+			std::vector<bound_push_constants> mPushConstants;
+			std::vector<std::tuple<vk::Buffer, vk::DeviceSize>> mVertexBuffers;
+			std::optional<std::tuple<vk::Buffer, vk::DeviceSize, vk::IndexType>> mIndexBuffer;
+			std::vector<std::optional<vk::Viewport>> mViewports;
+			std::vector<std::optional<vk::Rect2D>> mScissors;
+		};
+
+		static size_t bind_point_index(vk::PipelineBindPoint aBindPoint);
+		void invalidate_pipeline_dependent_state();
+
+		const root* mRoot = nullptr;
 		std::shared_ptr<vk::UniqueHandle<vk::CommandPool, DISPATCH_LOADER_CORE_TYPE>> mCommandPool;
 
 		command_buffer_state mState;
@@ -246,6 +354,10 @@ namespace avk
 		std::optional<avk::unique_function<void()>> mCustomDeleter;
 		
 		std::vector<any_owning_resource_t> mLifetimeHandledResources;
+
+		bound_state mBoundState;
+		size_t mNumElidedCalls = 0;
+		bool mEliminateRedundantState = false;
 	};
 
 	// Typedef for a variable representing an owner of a command_buffer
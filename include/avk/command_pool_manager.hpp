@@ -0,0 +1,97 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Manages transient command pools and recycles their command buffers across frames.
+	 *
+	 *	It owns one command_pool_t per (thread, queue family, frame in flight), which are created lazily.
+	 *	Command buffers are handed out from per-pool free lists and stay owned by the manager.
+	 *	When a frame slot is reused, all of its pools are reset at once via vkResetCommandPool, and all of
+	 *	their command buffers become available again, i.e. after warm-up, no more command buffers are allocated.
+	 *
+	 *	Usage:
+	 *	 1. Invoke begin_frame at the beginning of each frame, passing a monotonically increasing retire value
+	 *	    (e.g., the frame index). This resets the pools of the frame slot which has been used N frames ago.
+	 *	 2. Invoke get_command_buffer during the frame, from any thread, and record into and submit the
+	 *	    returned command buffers as usual. Each thread gets command buffers from its own pools.
+	 *
+	 *	The application must ensure that the device has finished executing all command buffers of a frame slot
+	 *	before that slot is reset, e.g., by waiting on the fence of the frame N frames ago.
+	 *	begin_frame must not be invoked concurrently with get_command_buffer.
+	 */
+	class command_pool_manager_t
+	{
+		friend class root;
+
+		struct pool_entry
+		{
+			std::thread::id mThreadId;
+			uint32_t mQueueFamilyIndex;
+			command_pool mPool;
+			// Command buffers per level (primary, secondary), and how many of them have been handed out in the current frame.
+			// deque => handed out references stay valid while the free list grows:
+			std::array<std::deque<command_buffer>, 2> mCommandBuffers;
+			std::array<size_t, 2> mNumInUse = { 0, 0 };
+		};
+
+		struct frame_slot
+		{
+			// unique_ptr => entries stay in place while other threads add pools:
+			std::vector<std::unique_ptr<pool_entry>> mPools;
+			std::optional<uint64_t> mRetireValue;
+		};
+
+	public:
+		command_pool_manager_t() = default;
+		command_pool_manager_t(command_pool_manager_t&&) noexcept = default;
+		command_pool_manager_t(const command_pool_manager_t&) = delete;
+		command_pool_manager_t& operator=(command_pool_manager_t&&) noexcept = default;
+		command_pool_manager_t& operator=(const command_pool_manager_t&) = delete;
+		~command_pool_manager_t() = default;
+
+		/**	Start a new frame. The pools of frame slot aRetireValue % number_of_frames_in_flight() are reset,
+		 *	and all command buffers which have been handed out from them are recycled.
+		 *	@param	aRetireValue		A monotonically increasing value identifying the frame, e.g., the frame index.
+		 *	@param	aCompletedValue		Optionally, the retire value which the device is known to have passed. If set,
+		 *								it is verified that the frame slot's command buffers are no longer in use.
+		 */
+		void begin_frame(uint64_t aRetireValue, std::optional<uint64_t> aCompletedValue = {});
+
+		/**	Get a command buffer for the current frame from the calling thread's pool for the given queue family.
+		 *	The command buffer is owned by the manager and remains valid until its frame slot is reset.
+		 *	@param	aQueueFamilyIndex	The queue family which the command buffer will be submitted to.
+		 *	@param	aUsageFlags			Usage flags which are passed to vkBeginCommandBuffer.
+		 *	@param	aLevel				Primary or secondary command buffer.
+		 *	@return	A command buffer in the initial state.
+		 */
+		command_buffer_t& get_command_buffer(uint32_t aQueueFamilyIndex, vk::CommandBufferUsageFlags aUsageFlags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit, vk::CommandBufferLevel aLevel = vk::CommandBufferLevel::ePrimary);
+
+		/**	Get a command buffer for the current frame from the calling thread's pool for the given queue's family.
+		 *	See get_command_buffer(uint32_t, vk::CommandBufferUsageFlags, vk::CommandBufferLevel).
+		 */
+		command_buffer_t& get_command_buffer(const queue& aQueue, vk::CommandBufferUsageFlags aUsageFlags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit, vk::CommandBufferLevel aLevel = vk::CommandBufferLevel::ePrimary)
+		{
+			return get_command_buffer(aQueue.family_index(), aUsageFlags, aLevel);
+		}
+
+		/** The number of frame slots, i.e. the number of frames in flight. */
+		size_t number_of_frames_in_flight() const { return mFrameSlots.size(); }
+		/** The number of command pools which have been created for all frame slots. */
+		size_t number_of_command_pools() const;
+		/** The number of command buffers which have been allocated for all frame slots, whether in use or not. */
+		size_t number_of_command_buffers() const;
+
+	private:
+		pool_entry& get_pool_entry_of_current_thread(uint32_t aQueueFamilyIndex);
+
+		root* mRoot = nullptr;
+		std::vector<frame_slot> mFrameSlots;
+		size_t mCurrentFrameSlot = 0;
+		// unique_ptr => the manager stays movable:
+		std::unique_ptr<std::mutex> mMutex = std::make_unique<std::mutex>();
+	};
+
+	/** Typedef representing any kind of OWNING command pool manager representations. */
+	using command_pool_manager = owning_resource<command_pool_manager_t>;
+}
@@ -0,0 +1,343 @@
+#pragma once
+#include "avk/avk.hpp"
+
+/** CONFIG SETTING: AVK_COMMAND_STREAM_BLOCK_SIZE
+ *
+ *	The size in bytes of the memory blocks which a command_stream allocates its records from.
+ *	Typical records (draw calls, bindings) take 32 to 64 bytes. A larger record gets a block of its own.
+ */
+#if !defined(AVK_COMMAND_STREAM_BLOCK_SIZE)
+#define AVK_COMMAND_STREAM_BLOCK_SIZE (size_t{ 64 } * 1024)
+#endif
+
+namespace avk
+{
+	/** The types of records which a command_stream can contain. */
+	enum struct command_stream_record_type : uint32_t
+	{
+		bind_pipeline,
+		bind_descriptor_sets,
+		bind_vertex_buffers,
+		bind_index_buffer,
+		push_constants,
+		set_viewport,
+		set_scissor,
+		draw,
+		draw_indexed,
+		draw_indirect,
+		draw_indexed_indirect,
+		dispatch,
+		dispatch_indirect,
+		copy_buffer,
+		pipeline_barrier,
+		custom
+	};
+
+	/**	A compact, arena-backed sequence of commands, intended for large amounts of commands per frame, e.g., thousands of draw calls.
+	 *
+	 *	In contrast to state_type_command and action_type_command, which hold std::function objects and vectors, every command
+	 *	is stored as a plain record (with its array arguments inline) in memory blocks owned by the stream. User-provided callables
+	 *	are stored inline as well. Appending commands does not allocate, except when the stream's blocks are exhausted, and clear()
+	 *	keeps the blocks, i.e. a stream which is cleared and refilled every frame stops allocating after the first frame.
+	 *
+	 *	Record a stream via command_buffer_t::record(const command_stream&), or pass it to avk::command::stream in order to use it
+	 *	among other commands. All handles are stored as they are; the referenced resources must outlive the recording.
+	 *	A command_stream performs no synchronization of its own. Use pipeline_barrier, or sync commands around command::stream.
+	 *
+	 *	A command_stream does not change how state_type_command and action_type_command are represented, i.e. lists of
+	 *	recorded_commands_t which are passed to root::record or command_buffer_t::record still hold one std::function per
+	 *	command. Put the high-volume parts of a frame into a command_stream, and add it to such a list via command::stream,
+	 *	which wraps the complete stream into one single action_type_command.
+	 *
+	 *	Example:
+	 *		myStream.clear();
+	 *		myStream.bind_pipeline(myPipeline.get());
+	 *		for (const auto& mesh : myMeshes) {
+	 *			myStream.bind_vertex_buffers(0, { mesh.mPositions }, { 0 });
+	 *			myStream.bind_index_buffer(mesh.mIndices, 0, vk::IndexType::eUint32);
+	 *			myStream.push_constants(myPipeline->layout_handle(), vk::ShaderStageFlagBits::eVertex, mesh.mTransform);
+	 *			myStream.draw_indexed(mesh.mNumIndices, 1, 0, 0, 0);
+	 *		}
+	 */
+	class command_stream
+	{
+		// Every record starts with a header, which links it to the next record:
+		struct alignas(16) record_header
+		{
+			command_stream_record_type mType;
+			record_header* mNext;
+		};
+
+		struct block
+		{
+			std::unique_ptr<std::byte[]> mData;
+			size_t mSize;
+		};
+
+	public:
+		// The records. Array arguments follow their records inline, aligned to 8 bytes each.
+		struct alignas(8) bind_pipeline_record { vk::PipelineBindPoint mBindPoint; vk::Pipeline mPipeline; };
+		struct alignas(8) bind_descriptor_sets_record { vk::PipelineBindPoint mBindPoint; vk::PipelineLayout mLayout; uint32_t mFirstSet; uint32_t mNumSets; uint32_t mNumDynamicOffsets; };
+		struct alignas(8) bind_vertex_buffers_record { uint32_t mFirstBinding; uint32_t mNumBuffers; };
+		struct alignas(8) bind_index_buffer_record { vk::Buffer mBuffer; vk::DeviceSize mOffset; vk::IndexType mIndexType; };
+		struct alignas(8) push_constants_record { vk::PipelineLayout mLayout; vk::ShaderStageFlags mStages; uint32_t mOffset; uint32_t mSize; };
+		struct alignas(8) set_viewport_record { uint32_t mFirst; uint32_t mCount; };
+		struct alignas(8) set_scissor_record { uint32_t mFirst; uint32_t mCount; };
+		struct alignas(8) draw_record { uint32_t mVertexCount; uint32_t mInstanceCount; uint32_t mFirstVertex; uint32_t mFirstInstance; };
+		struct alignas(8) draw_indexed_record { uint32_t mIndexCount; uint32_t mInstanceCount; uint32_t mFirstIndex; int32_t mVertexOffset; uint32_t mFirstInstance; };
+		struct alignas(8) draw_indirect_record { vk::Buffer mBuffer; vk::DeviceSize mOffset; uint32_t mDrawCount; uint32_t mStride; };
+		struct alignas(8) dispatch_record { uint32_t mGroupCountX; uint32_t mGroupCountY; uint32_t mGroupCountZ; };
+		struct alignas(8) dispatch_indirect_record { vk::Buffer mBuffer; vk::DeviceSize mOffset; };
+		struct alignas(8) copy_buffer_record { vk::Buffer mSrc; vk::Buffer mDst; uint32_t mNumRegions; };
+		struct alignas(8) pipeline_barrier_record { uint32_t mNumMemoryBarriers; uint32_t mNumBufferBarriers; uint32_t mNumImageBarriers; };
+		struct alignas(16) custom_record { void (*mInvoke)(void*, avk::command_buffer_t&); void (*mDestroy)(void*); };
+
+		command_stream() = default;
+		command_stream(command_stream&& aOther) noexcept
+			: mBlocks{ std::move(aOther.mBlocks) }
+			, mCurrentBlock{ std::exchange(aOther.mCurrentBlock, 0) }
+			, mCurrentOffset{ std::exchange(aOther.mCurrentOffset, 0) }
+			, mFirst{ std::exchange(aOther.mFirst, nullptr) }
+			, mLast{ std::exchange(aOther.mLast, nullptr) }
+			, mNumRecords{ std::exchange(aOther.mNumRecords, 0) }
+		{ }
+		command_stream(const command_stream&) = delete;
+		command_stream& operator=(command_stream&& aOther) noexcept
+		{
+			clear();
+			std::swap(mBlocks, aOther.mBlocks);
+			std::swap(mCurrentBlock, aOther.mCurrentBlock);
+			std::swap(mCurrentOffset, aOther.mCurrentOffset);
+			std::swap(mFirst, aOther.mFirst);
+			std::swap(mLast, aOther.mLast);
+			std::swap(mNumRecords, aOther.mNumRecords);
+			return *this;
+		}
+		command_stream& operator=(const command_stream&) = delete;
+		~command_stream() { clear(); }
+
+		/** Remove all records. The memory blocks are kept for subsequent records. */
+		void clear();
+
+		/** The number of records. */
+		size_t size() const { return mNumRecords; }
+		/** Returns true if there are no records. */
+		bool empty() const { return 0 == mNumRecords; }
+		/** The number of bytes which are allocated for records, summed over all memory blocks. */
+		size_t capacity() const;
+
+		command_stream& bind_pipeline(vk::PipelineBindPoint aBindPoint, vk::Pipeline aPipeline)
+		{
+			*append<bind_pipeline_record>(command_stream_record_type::bind_pipeline) = { aBindPoint, aPipeline };
+			return *this;
+		}
+		command_stream& bind_pipeline(const graphics_pipeline_t& aPipeline) { return bind_pipeline(vk::PipelineBindPoint::eGraphics, aPipeline.handle()); }
+		command_stream& bind_pipeline(const compute_pipeline_t& aPipeline) { return bind_pipeline(vk::PipelineBindPoint::eCompute, aPipeline.handle()); }
+
+		command_stream& bind_descriptor_sets(vk::PipelineBindPoint aBindPoint, vk::PipelineLayout aLayout, uint32_t aFirstSet, vk::ArrayProxy<const vk::DescriptorSet> aDescriptorSets, vk::ArrayProxy<const uint32_t> aDynamicOffsets = {})
+		{
+			auto* rec = append<bind_descriptor_sets_record>(command_stream_record_type::bind_descriptor_sets, array_bytes(aDescriptorSets) + array_bytes(aDynamicOffsets));
+			*rec = { aBindPoint, aLayout, aFirstSet, aDescriptorSets.size(), aDynamicOffsets.size() };
+			copy_trailing(aDynamicOffsets, copy_trailing(aDescriptorSets, rec + 1));
+			return *this;
+		}
+
+		command_stream& bind_vertex_buffers(uint32_t aFirstBinding, vk::ArrayProxy<const vk::Buffer> aBuffers, vk::ArrayProxy<const vk::DeviceSize> aOffsets)
+		{
+			assert(aBuffers.size() == aOffsets.size());
+			auto* rec = append<bind_vertex_buffers_record>(command_stream_record_type::bind_vertex_buffers, array_bytes(aBuffers) + array_bytes(aOffsets));
+			*rec = { aFirstBinding, aBuffers.size() };
+			copy_trailing(aOffsets, copy_trailing(aBuffers, rec + 1));
+			return *this;
+		}
+
+		command_stream& bind_index_buffer(vk::Buffer aBuffer, vk::DeviceSize aOffset, vk::IndexType aIndexType)
+		{
+			*append<bind_index_buffer_record>(command_stream_record_type::bind_index_buffer) = { aBuffer, aOffset, aIndexType };
+			return *this;
+		}
+
+		command_stream& push_constants(vk::PipelineLayout aLayout, vk::ShaderStageFlags aStages, uint32_t aOffset, uint32_t aSize, const void* aData)
+		{
+			auto* rec = append<push_constants_record>(command_stream_record_type::push_constants, aSize);
+			*rec = { aLayout, aStages, aOffset, aSize };
+			memcpy(rec + 1, aData, aSize);
+			return *this;
+		}
+		template <typename D>
+		command_stream& push_constants(vk::PipelineLayout aLayout, vk::ShaderStageFlags aStages, const D& aData, uint32_t aOffset = 0)
+		{
+			static_assert(std::is_trivially_copyable_v<D>);
+			return push_constants(aLayout, aStages, aOffset, static_cast<uint32_t>(sizeof(D)), &aData);
+		}
+
+		command_stream& set_viewport(uint32_t aFirstViewport, vk::ArrayProxy<const vk::Viewport> aViewports)
+		{
+			auto* rec = append<set_viewport_record>(command_stream_record_type::set_viewport, array_bytes(aViewports));
+			*rec = { aFirstViewport, aViewports.size() };
+			copy_trailing(aViewports, rec + 1);
+			return *this;
+		}
+
+		command_stream& set_scissor(uint32_t aFirstScissor, vk::ArrayProxy<const vk::Rect2D> aScissors)
+		{
+			auto* rec = append<set_scissor_record>(command_stream_record_type::set_scissor, array_bytes(aScissors));
+			*rec = { aFirstScissor, aScissors.size() };
+			copy_trailing(aScissors, rec + 1);
+			return *this;
+		}
+
+		command_stream& draw(uint32_t aVertexCount, uint32_t aInstanceCount, uint32_t aFirstVertex, uint32_t aFirstInstance)
+		{
+			*append<draw_record>(command_stream_record_type::draw) = { aVertexCount, aInstanceCount, aFirstVertex, aFirstInstance };
+			return *this;
+		}
+
+		command_stream& draw_indexed(uint32_t aIndexCount, uint32_t aInstanceCount, uint32_t aFirstIndex, int32_t aVertexOffset, uint32_t aFirstInstance)
+		{
+			*append<draw_indexed_record>(command_stream_record_type::draw_indexed) = { aIndexCount, aInstanceCount, aFirstIndex, aVertexOffset, aFirstInstance };
+			return *this;
+		}
+
+		command_stream& draw_indirect(vk::Buffer aBuffer, vk::DeviceSize aOffset, uint32_t aDrawCount, uint32_t aStride)
+		{
+			*append<draw_indirect_record>(command_stream_record_type::draw_indirect) = { aBuffer, aOffset, aDrawCount, aStride };
+			return *this;
+		}
+
+		command_stream& draw_indexed_indirect(vk::Buffer aBuffer, vk::DeviceSize aOffset, uint32_t aDrawCount, uint32_t aStride)
+		{
+			*append<draw_indirect_record>(command_stream_record_type::draw_indexed_indirect) = { aBuffer, aOffset, aDrawCount, aStride };
+			return *this;
+		}
+
+		command_stream& dispatch(uint32_t aGroupCountX, uint32_t aGroupCountY, uint32_t aGroupCountZ)
+		{
+			*append<dispatch_record>(command_stream_record_type::dispatch) = { aGroupCountX, aGroupCountY, aGroupCountZ };
+			return *this;
+		}
+
+		command_stream& dispatch_indirect(vk::Buffer aBuffer, vk::DeviceSize aOffset)
+		{
+			*append<dispatch_indirect_record>(command_stream_record_type::dispatch_indirect) = { aBuffer, aOffset };
+			return *this;
+		}
+
+		command_stream& copy_buffer(vk::Buffer aSrc, vk::Buffer aDst, vk::ArrayProxy<const vk::BufferCopy> aRegions)
+		{
+			auto* rec = append<copy_buffer_record>(command_stream_record_type::copy_buffer, array_bytes(aRegions));
+			*rec = { aSrc, aDst, aRegions.size() };
+			copy_trailing(aRegions, rec + 1);
+			return *this;
+		}
+
+		/**	Record one pipeline barrier with the given barriers.
+		 *	The barriers' pNext chains are not copied and must be empty.
+		 */
+		command_stream& pipeline_barrier(vk::ArrayProxy<const vk::MemoryBarrier2KHR> aMemoryBarriers, vk::ArrayProxy<const vk::BufferMemoryBarrier2KHR> aBufferBarriers = {}, vk::ArrayProxy<const vk::ImageMemoryBarrier2KHR> aImageBarriers = {})
+		{
+			auto* rec = append<pipeline_barrier_record>(command_stream_record_type::pipeline_barrier, array_bytes(aMemoryBarriers) + array_bytes(aBufferBarriers) + array_bytes(aImageBarriers));
+			*rec = { aMemoryBarriers.size(), aBufferBarriers.size(), aImageBarriers.size() };
+			copy_trailing(aImageBarriers, copy_trailing(aBufferBarriers, copy_trailing(aMemoryBarriers, rec + 1)));
+			return *this;
+		}
+
+		/**	Record a callable which is invoked with the command buffer when the stream is recorded.
+		 *	The callable is stored inline, and destroyed when the stream is cleared or destroyed.
+		 *	If constructing the callable throws, the stream remains unchanged.
+		 *	@param	aCallback	Callable which takes one parameter of type avk::command_buffer_t&.
+		 */
+		template <typename F>
+		command_stream& custom(F&& aCallback)
+		{
+			using callable = std::decay_t<F>;
+			static_assert(alignof(callable) <= alignof(custom_record), "The callable's alignment is not supported.");
+			auto [header, rec] = allocate_record<custom_record>(command_stream_record_type::custom, sizeof(callable));
+			// Construct the callable before the record becomes part of the stream, s.t. clear() never destroys an unconstructed one:
+			new (rec + 1) callable(std::forward<F>(aCallback));
+			rec->mInvoke = [](void* aStorage, avk::command_buffer_t& aCommandBuffer) { (*static_cast<callable*>(aStorage))(aCommandBuffer); };
+			rec->mDestroy = nullptr;
+			if constexpr (!std::is_trivially_destructible_v<callable>) {
+				rec->mDestroy = [](void* aStorage) { static_cast<callable*>(aStorage)->~callable(); };
+			}
+			link(header);
+			return *this;
+		}
+
+		/** Record all the commands of this stream into the given command buffer, which must be in recording state. */
+		void record_into(avk::command_buffer_t& aCommandBuffer) const;
+
+	private:
+		static constexpr size_t align_to_8(size_t aSize) { return (aSize + 7) & ~size_t{ 7 }; }
+
+		template <typename T>
+		static size_t array_bytes(const vk::ArrayProxy<const T>& aArray) { return align_to_8(sizeof(T) * aArray.size()); }
+
+		// Copies the array to the given location and returns the location after it:
+		template <typename T>
+		static void* copy_trailing(const vk::ArrayProxy<const T>& aArray, void* aTarget)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			if (!aArray.empty()) {
+				memcpy(aTarget, aArray.data(), sizeof(T) * aArray.size());
+			}
+			return static_cast<std::byte*>(aTarget) + array_bytes(aArray);
+		}
+
+		// Allocates a record, which does not become part of the stream before it is passed to link:
+		template <typename R>
+		std::tuple<record_header*, R*> allocate_record(command_stream_record_type aType, size_t aTrailingBytes)
+		{
+			static_assert(std::is_trivially_destructible_v<R>);
+			auto* header = new (allocate(sizeof(record_header) + sizeof(R) + aTrailingBytes)) record_header{ aType, nullptr };
+			return { header, new (header + 1) R{} };
+		}
+
+		void link(record_header* aHeader)
+		{
+			if (nullptr == mLast) {
+				mFirst = aHeader;
+			}
+			else {
+				mLast->mNext = aHeader;
+			}
+			mLast = aHeader;
+			++mNumRecords;
+		}
+
+		template <typename R>
+		R* append(command_stream_record_type aType, size_t aTrailingBytes = 0)
+		{
+			auto [header, rec] = allocate_record<R>(aType, aTrailingBytes);
+			link(header);
+			return rec;
+		}
+
+		void* allocate(size_t aSize);
+
+		std::vector<block> mBlocks;
+		size_t mCurrentBlock = 0;
+		size_t mCurrentOffset = 0;
+		record_header* mFirst = nullptr;
+		record_header* mLast = nullptr;
+		size_t mNumRecords = 0;
+	};
+
+	namespace command
+	{
+		/**	Record the commands of a command_stream. The stream is not copied, i.e. it must stay alive and unmodified
+		 *	until the commands have been recorded into a command buffer.
+		 *	@param	aStream		The stream to be recorded.
+		 *	@param	aSyncHint	Describes the stream's commands for the sync of previous and subsequent commands. Empty by default.
+		 */
+		inline static action_type_command stream(const command_stream& aStream, avk::sync::sync_hint aSyncHint = {})
+		{
+			return action_type_command{
+				aSyncHint, {},
+				[lStream = &aStream](avk::command_buffer_t& cb) {
+					lStream->record_into(cb);
+				}
+			};
+		}
+	}
+}
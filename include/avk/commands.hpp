@@ -53,6 +53,8 @@ namespace avk
 			vk::Image mImage;
 			vk::ImageSubresourceRange mSubresourceRange;
 			std::optional<avk::layout::image_layout_transition> mLayoutTransition;
+			// The image's tracked layout state, if layout tracking is enabled for it:
+			image_layout_state* mLayoutState = nullptr;
 		};
 
 		class sync_type_command final
@@ -69,7 +71,13 @@ namespace avk
 			// Constructs an image memory barrier:
 			sync_type_command(avk::stage::execution_dependency aStages, avk::access::memory_dependency aAccesses, const avk::image_t& aImage, vk::ImageSubresourceRange aSubresourceRange)
 				: mStages{ aStages }, mAccesses{ aAccesses }, mQueueFamilyOwnershipTransfer{}
-				, mSpecificData{ image_sync_info{ aImage.handle(), aSubresourceRange, std::optional<avk::layout::image_layout_transition>{} } } 
+				, mSpecificData{ image_sync_info{ aImage.handle(), aSubresourceRange, std::optional<avk::layout::image_layout_transition>{}, aImage.layout_state() } } 
+			{}
+
+			// Constructs an image memory barrier for an image handle, and optionally its tracked layout state:
+			sync_type_command(avk::stage::execution_dependency aStages, avk::access::memory_dependency aAccesses, vk::Image aImage, vk::ImageSubresourceRange aSubresourceRange, image_layout_state* aLayoutState = nullptr)
+				: mStages{ aStages }, mAccesses{ aAccesses }, mQueueFamilyOwnershipTransfer{}
+				, mSpecificData{ image_sync_info{ aImage, aSubresourceRange, std::optional<avk::layout::image_layout_transition>{}, aLayoutState } } 
 			{}
 
 			// Constructs a buffer memory barrier:
@@ -78,6 +86,12 @@ namespace avk
 				, mSpecificData{ buffer_sync_info{ aBuffer.handle(), aOffset, aSize } } 
 			{}
 
+			// Constructs a buffer memory barrier for a buffer handle:
+			sync_type_command(avk::stage::execution_dependency aStages, avk::access::memory_dependency aAccesses, vk::Buffer aBuffer, vk::DeviceSize aOffset, vk::DeviceSize aSize)
+				: mStages{ aStages }, mAccesses{ aAccesses }, mQueueFamilyOwnershipTransfer{}
+				, mSpecificData{ buffer_sync_info{ aBuffer, aOffset, aSize } } 
+			{}
+
 			// Adds memory access, potentially turning a execution barrier into a memory barrier.
 			sync_type_command& with_memory_access(avk::access::memory_dependency aMemoryAccess)
 			{
@@ -290,6 +304,34 @@ namespace avk
 		{
 			return buffer_memory_barrier(aBuffer, aDependency.mSrc.mStage >> aDependency.mDst.mStage, aDependency.mSrc.mAccess >> aDependency.mDst.mAccess);
 		}
+
+		/**	Establish a buffer memory barrier which only covers the range of the given buffer slice.
+		 *
+		 *	@param	aBufferSlice	The buffer range this buffer memory barrier refers to.
+		 *	@param	aStages			Source and destination stages of this buffer memory barrier.
+		 *							Create it by using operator>> with two avk::stage::pipeline_stage_flags operands!
+		 *	@param	aAccesses		Source and destination access flags of this buffer memory barrier.
+		 *							Create it by using operator>> with two avk::access::memory_access_flags operands!
+		 *
+		 *	@return	An avk::sync::sync_type_command instance which contains all the relevant data for recording a memory barrier into a command buffer
+		 */
+		inline static sync_type_command buffer_memory_barrier(const avk::buffer_slice& aBufferSlice, avk::stage::execution_dependency aStages, avk::access::memory_dependency aAccesses = avk::access::none >> avk::access::none)
+		{
+			return sync_type_command{ aStages, aAccesses, aBufferSlice.get_buffer(), aBufferSlice.offset(), aBufferSlice.size() };
+		}
+
+		/**	Syntactic-sugary alternative to sync::buffer_memory_barrier for buffer slices, where stages and accesses can be passed as follows:
+		 *	Example:    avk::stage::copy + avk::access::transfer_write >> avk::stage::fragment_shader + avk::access::shader_read
+		 *
+		 *	@param	aBufferSlice	The buffer range this buffer memory barrier refers to.
+		 *	@param	aDependency		Source and destination stages and memory accesses of this buffer memory barrier.
+		 *
+		 *	@return	An avk::sync::sync_type_command instance which contains all the relevant data for recording a memory barrier into a command buffer
+		 */
+		inline static sync_type_command buffer_memory_barrier(const avk::buffer_slice& aBufferSlice, avk::stage_and_access_dependency aDependency)
+		{
+			return buffer_memory_barrier(aBufferSlice, aDependency.mSrc.mStage >> aDependency.mDst.mStage, aDependency.mSrc.mAccess >> aDependency.mDst.mAccess);
+		}
 	}
 
 	// Define recorded* type:
@@ -339,7 +381,7 @@ namespace avk
 					lDataSize = dataSize,
 					aData
 				] (avk::command_buffer_t& cb) {
-					cb.handle().pushConstants(
+					cb.push_constants(
 						lLayoutHandle,
 						lStageFlags,
 						0, // TODO: How to deal with offset?
@@ -379,7 +421,7 @@ namespace avk
 					lDataSize = dataSize,
 					aDataPtr
 				] (avk::command_buffer_t& cb) {
-					cb.handle().pushConstants(
+					cb.push_constants(
 						lLayoutHandle,
 						lStageFlags,
 						0, // TODO: How to deal with offset?
@@ -487,6 +529,11 @@ namespace avk
 			}
 
 			std::vector<any_owning_resource_t> mLifetimeHandledResources;
+
+			/**	Set by commands whose recording functions update the tracked layouts of images (see image_t::enable_layout_tracking).
+			 *	Such commands must be recorded in execution order, which is why command::parallel does not accept them.
+			 */
+			bool mUpdatesTrackedLayouts = false;
 		};
 
 		/**	A utility function that creates an action_type_command which consists solely of custom commmands.
@@ -503,7 +550,11 @@ namespace avk
 		{
 			return avk::command::action_type_command{
 				{}, {}, // No sync hints by default
-				std::move(aCommandRecordingCallback)
+				[lCallback = std::move(aCommandRecordingCallback)](avk::command_buffer_t& cb) mutable {
+					lCallback(cb);
+					// The callback might have bound state directly via cb.handle():
+					cb.invalidate_bound_state();
+				}
 			};
 		}
 
@@ -513,8 +564,9 @@ namespace avk
 		 *  @param aRenderAreaOffset Render area offset (default is (0,0), i.e., no offset)
 		 *	@param aRenderAreaExtent Render area extent (default is full extent inferred from images passed in aImageViews)
 		 *  @param aLayerCount number of layers that will be used for rendering (default is 1)
+		 *  @param aContentsInline Whether the contents are recorded inline (default is true), or in secondary command buffers
 		 */
-		extern action_type_command begin_dynamic_rendering(std::vector<attachment> aAttachments, std::vector<image_view> aImageViews, vk::Offset2D aRenderAreaOffset = {0, 0}, std::optional<vk::Extent2D> aRenderAreaExtent = {}, uint32_t aLayerCount = 1, uint32_t aViewMask = 0);
+		extern action_type_command begin_dynamic_rendering(std::vector<attachment> aAttachments, std::vector<image_view> aImageViews, vk::Offset2D aRenderAreaOffset = {0, 0}, std::optional<vk::Extent2D> aRenderAreaExtent = {}, uint32_t aLayerCount = 1, uint32_t aViewMask = 0, bool aContentsInline = true);
 		
 		/** Ends dynamic rendering scope
 		*/
@@ -645,6 +697,9 @@ namespace avk
 	    template <typename... Rest>
 		void bind_vertex_buffer(vk::Buffer* aHandlePtr, vk::DeviceSize* aOffsetPtr, const std::tuple<const buffer_t&, size_t>& aVertexBufferAndOffset, const Rest&... aRest);
 
+		template <typename... Rest>
+		void bind_vertex_buffer(vk::Buffer* aHandlePtr, vk::DeviceSize* aOffsetPtr, const buffer_slice& aVertexBufferSlice, const Rest&... aRest);
+
 		template <typename... Rest>
 		void bind_vertex_buffer(vk::Buffer* aHandlePtr, vk::DeviceSize* aOffsetPtr, const buffer_t& aVertexBuffer, const Rest&... aRest)
 		{
@@ -661,6 +716,14 @@ namespace avk
 			bind_vertex_buffer(aHandlePtr + 1, aOffsetPtr + 1, aRest...);
 		}
 
+		template <typename... Rest>
+		void bind_vertex_buffer(vk::Buffer* aHandlePtr, vk::DeviceSize* aOffsetPtr, const buffer_slice& aVertexBufferSlice, const Rest&... aRest)
+		{
+			*aHandlePtr = aVertexBufferSlice.handle();
+			*aOffsetPtr = aVertexBufferSlice.offset();
+			bind_vertex_buffer(aHandlePtr + 1, aOffsetPtr + 1, aRest...);
+		}
+
 		/**	Draw vertices with vertex buffer bindings starting at BUFFER-BINDING #0 top to the number of total buffers passed -1.
 		 *	"BUFFER-BINDING" means that it corresponds to the binding specified in `input_binding_location_data::from_buffer_at_binding`.
 		 *	There can be no gaps between buffer bindings.
@@ -670,6 +733,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_vertices_indirect(const buffer_t& aParametersBuffer, vk::DeviceSize aParametersOffset, uint32_t aParametersStride, uint32_t aDrawCount, const Bfrs&... aFurtherBuffers)
@@ -718,7 +782,7 @@ namespace avk
 					    lParametersBufferHandle = aParametersBuffer.handle(), aParametersOffset, aParametersStride, aDrawCount,
 						handles, offsets
 					](avk::command_buffer_t& cb) {
-						cb.handle().bindVertexBuffers(
+						cb.bind_vertex_buffers(
 							0u, // TODO: Should the first binding really always be 0?
 							static_cast<uint32_t>(N), handles.data(), offsets.data()
 						);
@@ -737,6 +801,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_vertices_indirect_count(const buffer_t& aParametersBuffer, vk::DeviceSize aParametersOffset, uint32_t aParametersStride, const buffer_t& aDrawCountBuffer, vk::DeviceSize aDrawCountOffset, uint32_t aMaxNumberOfDraws, const Bfrs&... aFurtherBuffers)
@@ -787,7 +852,7 @@ namespace avk
 					    lDrawCountBufferHandle = aDrawCountBuffer.handle(),   aDrawCountOffset,  aMaxNumberOfDraws,
 						handles, offsets
 					](avk::command_buffer_t& cb) {
-						cb.handle().bindVertexBuffers(
+						cb.bind_vertex_buffers(
 							0u, // TODO: Should the first binding really always be 0?
 							static_cast<uint32_t>(N), handles.data(), offsets.data()
 						);
@@ -810,6 +875,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_vertices(uint32_t aNumberOfVertices, uint32_t aNumberOfInstances, uint32_t aFirstVertex, uint32_t aFirstInstance, const Bfrs&... aFurtherBuffers)
@@ -858,7 +924,7 @@ namespace avk
 						handles, offsets, 
 						aNumberOfVertices, aNumberOfInstances, aFirstVertex, aFirstInstance
 				    ](avk::command_buffer_t& cb) {
-						cb.handle().bindVertexBuffers(
+						cb.bind_vertex_buffers(
 							0u, // TODO: Should the first binding really always be 0?
 							static_cast<uint32_t>(N), handles.data(), offsets.data()
 						);
@@ -883,6 +949,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_vertices(uint32_t aNumberOfInstances, uint32_t aFirstVertex, uint32_t aFirstInstance, const buffer_t& aVertexBuffer, const Bfrs&... aFurtherBuffers)
@@ -906,6 +973,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_vertices(const buffer_t& aVertexBuffer, const Bfrs&... aFurtherBuffers)
@@ -931,6 +999,7 @@ namespace avk
 		 *												  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *												  Example: avk::buffer myVertexBuffer;
 		 *												           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *									Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_indexed(const std::tuple<const buffer_t&, size_t, uint32_t>& aIndexBufferAndOffsetAndNumElements, uint32_t aNumberOfInstances, uint32_t aFirstIndex, uint32_t aVertexOffset, uint32_t aFirstInstance, const Bfrs&... aVertexBuffers)
@@ -968,11 +1037,11 @@ namespace avk
 					lIndexBufferHandle = std::get<const buffer_t&>(aIndexBufferAndOffsetAndNumElements).handle(),
 					aNumberOfInstances, aFirstIndex, aVertexOffset, aFirstInstance
 				](avk::command_buffer_t& cb) {
-					cb.handle().bindVertexBuffers(
+					cb.bind_vertex_buffers(
 						0u, // TODO: Should the first binding really always be 0?
 						lBindingCount, handles.data(), offsets.data()
 					);
-					cb.handle().bindIndexBuffer(lIndexBufferHandle, indexBufferOffset, indexType);
+					cb.bind_index_buffer(lIndexBufferHandle, indexBufferOffset, indexType);
 					cb.handle().drawIndexed(lNumElemments, aNumberOfInstances, aFirstIndex, aVertexOffset, aFirstInstance);
 				}
 			};
@@ -993,6 +1062,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_indexed(const buffer_t& aIndexBuffer, uint32_t aNumberOfInstances, uint32_t aFirstIndex, uint32_t aVertexOffset, uint32_t aFirstInstance, const Bfrs&... aVertexBuffers)
@@ -1019,6 +1089,7 @@ namespace avk
 		 *												  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *												  Example: avk::buffer myVertexBuffer;
 		 *												           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *									Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_indexed(const std::tuple<const buffer_t&, size_t, uint32_t>& aIndexBufferAndOffsetAndNumElements, const Bfrs&... aVertexBuffers)
@@ -1040,6 +1111,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_indexed(const buffer_t& aIndexBuffer, const Bfrs&... aVertexBuffers)
@@ -1047,6 +1119,35 @@ namespace avk
 			return draw_indexed(aIndexBuffer, 1u, 0u, 0u, 0u, aVertexBuffers...);
 		}
 
+		/**	Perform an indexed draw call with the indices taken from a slice of an index buffer.
+		 *	The number of indices is derived from the slice's size and the index buffer's index_buffer_meta.
+		 *	There can be no gaps between buffer bindings.
+		 *	@param	aIndexBufferSlice	Slice of an index buffer. Its offset must be a multiple of the index size.
+		 *	@param	aNumberOfInstances	Number of instances to draw
+		 *	@param	aFirstIndex			Offset to the first index, relative to the start of the slice
+		 *	@param	aVertexOffset		Offset to the first vertex
+		 *	@param	aFirstInstance		The ID of the first instance
+		 *	@param	aVertexBuffers		Multiple const-references to buffers, tuples of const-references to buffers + offsets, or buffer slices.
+		 */
+		template <typename... Bfrs>
+		action_type_command draw_indexed(const buffer_slice& aIndexBufferSlice, uint32_t aNumberOfInstances, uint32_t aFirstIndex, uint32_t aVertexOffset, uint32_t aFirstInstance, const Bfrs&... aVertexBuffers)
+		{
+			const auto& indexMeta = aIndexBufferSlice.get_buffer().template meta<avk::index_buffer_meta>();
+			const auto numIndices = static_cast<uint32_t>(aIndexBufferSlice.size() / indexMeta.sizeof_one_element());
+			return draw_indexed(std::forward_as_tuple(aIndexBufferSlice.get_buffer(), static_cast<size_t>(aIndexBufferSlice.offset()), numIndices), aNumberOfInstances, aFirstIndex, aVertexOffset, aFirstInstance, aVertexBuffers...);
+		}
+
+		/**	Perform an indexed draw call with the indices taken from a slice of an index buffer.
+		 *	Number of instances is set to 1, and first index, vertex offset, and ID of the first instance are set to 0.
+		 *	@param	aIndexBufferSlice	Slice of an index buffer. Its offset must be a multiple of the index size.
+		 *	@param	aVertexBuffers		Multiple const-references to buffers, tuples of const-references to buffers + offsets, or buffer slices.
+		 */
+		template <typename... Bfrs>
+		action_type_command draw_indexed(const buffer_slice& aIndexBufferSlice, const Bfrs&... aVertexBuffers)
+		{
+			return draw_indexed(aIndexBufferSlice, 1u, 0u, 0u, 0u, aVertexBuffers...);
+		}
+
 		/**	Perform an indexed indirect draw call with vertex buffer bindings starting at BUFFER-BINDING #0 top to the number of total vertex buffers passed -1.
 		 *	"BUFFER-BINDING" means that it corresponds to the binding specified in `input_binding_location_data::from_buffer_at_binding`.
 		 *	There can be no gaps between buffer bindings.
@@ -1061,6 +1162,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 *
 		 *  NOTE: Make sure the _exact_ types are used for aParametersOffset (vk::DeviceSize) and aParametersStride (uint32_t) to avoid compile errors.
 		 */
@@ -1099,11 +1201,11 @@ namespace avk
 					lIndexBufferHandle = aIndexBuffer.handle(),
 					aNumberOfDraws, aParametersOffset, aParametersStride
 				](avk::command_buffer_t& cb) {
-					cb.handle().bindVertexBuffers(
+					cb.bind_vertex_buffers(
 						0u, // TODO: Should the first binding really always be 0?
 						lBindingCount, handles.data(), offsets.data()
 					);
-					cb.handle().bindIndexBuffer(lIndexBufferHandle, 0u, indexType);
+					cb.bind_index_buffer(lIndexBufferHandle, 0u, indexType);
 					cb.handle().drawIndexedIndirect(lParametersBufferHandle, aParametersOffset, aNumberOfDraws, aParametersStride);
 				}
 			};
@@ -1123,6 +1225,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 */
 		template <typename... Bfrs>
 		action_type_command draw_indexed_indirect(const buffer_t& aParametersBuffer, const buffer_t& aIndexBuffer, uint32_t aNumberOfDraws, const Bfrs&... aVertexBuffers)
@@ -1146,6 +1249,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 *
 		 *   See vkCmdDrawIndexedIndirectCount in the Vulkan specification for more details.
 		 */
@@ -1185,11 +1289,11 @@ namespace avk
 					lDrawCountBufferHandle = aDrawCountBuffer.handle(),
 					aParametersOffset, aDrawCountOffset, aMaxNumberOfDraws, aParametersStride
 				](avk::command_buffer_t& cb) {
-					cb.handle().bindVertexBuffers(
+					cb.bind_vertex_buffers(
 						0u, // TODO: Should the first binding really always be 0?
 						lBindingCount, handles.data(), offsets.data()
 					);
-					cb.handle().bindIndexBuffer(lIndexBufferHandle, 0u, indexType);
+					cb.bind_index_buffer(lIndexBufferHandle, 0u, indexType);
 					cb.handle().drawIndexedIndirectCount(lParametersBufferHandle, aParametersOffset, lDrawCountBufferHandle, aDrawCountOffset, aMaxNumberOfDraws, aParametersStride);
 				}
 			};
@@ -1211,6 +1315,7 @@ namespace avk
 		 *											  Hint:    std::forward_as_tuple might be useful to get that reference into a std::tuple.
 		 *											  Example: avk::buffer myVertexBuffer;
 		 *											           auto myTuple = std::forward_as_tuple(myVertexBuffer.get(), size_t{0});
+		 *								Third case:   Pass avk::buffer_slice instances, e.g. myVertexBuffer->slice(myOffset)!
 		 *
 		 *   See vkCmdDrawIndexedIndirectCount in the Vulkan specification for more details.
 		 */
@@ -0,0 +1,122 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Defers the destruction of resources until the device has passed a certain point of execution.
+	 *
+	 *	Each enqueued resource is keyed by a retire value, which is a monotonically increasing number
+	 *	that is supplied by the application. This can be a frame index (e.g., the number of the frame
+	 *	during which the resource was used for the last time) or the value which a timeline semaphore
+	 *	will be signalled with after the last usage of the resource.
+	 *	Once the application knows that the device has reached a certain value (e.g. after waiting on
+	 *	a frame's fence, or after querying a timeline semaphore's counter), it invokes release_up_to,
+	 *	which destroys all resources with a retire value less than or equal to the given value.
+	 *
+	 *	In contrast to handing resources over to command buffers, fences, or semaphores via
+	 *	handle_lifetime_of, resources are moved into the queue as they are, i.e. without converting
+	 *	them into any_owning_resource_t and without requiring shared ownership.
+	 *	Destruction can optionally be batched and performed on a background thread.
+	 *
+	 *	The queue is owned by the application and can be attached to a root (see root::set_deferred_destruction_queue),
+	 *	s.t. command buffers hand the resources whose lifetimes they handle over to it when they are reset or destroyed.
+	 *
+	 *	ATTENTION: All pending resources must be released (see release_all) before the device is destroyed.
+	 *	Resources which are still pending when the queue is destroyed are reported as an error and destroyed
+	 *	by the destructor, which is only valid if the device still exists at that point.
+	 */
+	class deferred_destruction_queue
+	{
+	public:
+		deferred_destruction_queue() = default;
+		deferred_destruction_queue(deferred_destruction_queue&&) = delete;
+		deferred_destruction_queue(const deferred_destruction_queue&) = delete;
+		deferred_destruction_queue& operator=(deferred_destruction_queue&&) = delete;
+		deferred_destruction_queue& operator=(const deferred_destruction_queue&) = delete;
+		~deferred_destruction_queue();
+
+		/**	Set the retire value which is used by the overloads of enqueue and enqueue_destroy_function
+		 *	that do not take one. Typically, this is set to the current frame index at the beginning of each frame.
+		 */
+		void set_current_retire_value(uint64_t aRetireValue) { mCurrentRetireValue.store(aRetireValue, std::memory_order_relaxed); }
+
+		/** Gets the retire value which is used by the overloads of enqueue that do not take one. */
+		uint64_t current_retire_value() const { return mCurrentRetireValue.load(std::memory_order_relaxed); }
+
+		/**	Take ownership of a resource and destroy it once release_up_to has been invoked with a value >= aRetireValue.
+		 *	@param	aRetireValue	The value which the device must have passed before the resource may be destroyed.
+		 *	@param	aResource		Any movable resource, e.g., an owning_resource<T>, a vk::UniqueHandle, or an AVK_MEM_BUFFER_HANDLE.
+		 */
+		template <typename R>
+		void enqueue(uint64_t aRetireValue, R&& aResource)
+		{
+			static_assert(!std::is_lvalue_reference_v<R>, "Resources must be moved into the deferred_destruction_queue.");
+			enqueue_destroy_function(aRetireValue, [lResource = std::move(aResource)]() mutable {
+				// Move into a local in order to destroy the resource right here:
+				[[maybe_unused]] auto toBeDestroyed = std::move(lResource);
+			});
+		}
+
+		/**	Take ownership of a resource and destroy it once release_up_to has been invoked with a value >= current_retire_value().
+		 *	@param	aResource		Any movable resource, e.g., an owning_resource<T>, a vk::UniqueHandle, or an AVK_MEM_BUFFER_HANDLE.
+		 */
+		template <typename R>
+		void enqueue(R&& aResource)
+		{
+			enqueue(current_retire_value(), std::forward<R>(aResource));
+		}
+
+		/**	Enqueue a function which destroys raw handles and/or frees memory once release_up_to has been invoked with a value >= aRetireValue.
+		 *	@param	aRetireValue		The value which the device must have passed before the function may be invoked.
+		 *	@param	aDestroyFunction	Function which performs the destruction, e.g., [d = device(), b = bufferHandle](){ d.destroyBuffer(b); }
+		 */
+		void enqueue_destroy_function(uint64_t aRetireValue, avk::unique_function<void()> aDestroyFunction);
+
+		/**	Destroy all the resources with a retire value less than or equal to the given value.
+		 *	@param	aCompletedValue		The value which the device is known to have passed.
+		 *	@param	aInBackground		If true, the resources are destroyed on a background thread, and this method returns immediately.
+		 *	@return	The number of resources which have been (or, in the background case, are going to be) destroyed.
+		 */
+		size_t release_up_to(uint64_t aCompletedValue, bool aInBackground = false);
+
+		/** Destroy all pending resources, regardless of their retire values, and wait for all background work to complete.
+		 *	Resources which are enqueued while others are destroyed (e.g. those of a destroyed command buffer) are destroyed as well.
+		 *	The device must be idle when this is invoked.
+		 *	@return	The number of resources which have been destroyed by this call.
+		 */
+		size_t release_all();
+
+		/** Wait until all destructions which have been handed over to the background thread have completed. */
+		void wait_for_background_releases();
+
+		/** The number of resources which are waiting for their retire values to be reached. */
+		size_t num_pending() const;
+
+	private:
+		struct entry
+		{
+			uint64_t mRetireValue;
+			avk::unique_function<void()> mDestroyFunction;
+		};
+
+		/** Removes all entries with retire values <= aCompletedValue from mEntries and returns them. */
+		std::vector<entry> take_up_to(uint64_t aCompletedValue);
+		static void destroy_batch(std::vector<entry>& aBatch);
+		void background_worker();
+
+		// Read by enqueue on arbitrary threads:
+		std::atomic<uint64_t> mCurrentRetireValue = 0;
+
+		mutable std::mutex mMutex;
+		// Sorted by retire value:
+		std::deque<entry> mEntries;
+
+		// Background destruction:
+		std::mutex mBackgroundMutex;
+		std::condition_variable mBackgroundCondition;
+		std::deque<std::vector<entry>> mBackgroundBatches;
+		bool mBackgroundBusy = false;
+		bool mStopBackgroundWorker = false;
+		std::thread mBackgroundWorker;
+	};
+}
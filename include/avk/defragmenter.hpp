@@ -0,0 +1,187 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/** Configuration parameters which limit the amount of work performed by one
+	 *	incremental defragmentation pass (see defragmenter_t::begin_pass).
+	 */
+	struct defragmentation_config
+	{
+		/** Maximum number of bytes that may be copied on the device during one pass. */
+		vk::DeviceSize mMaxBytesPerPass = 64ull * 1024ull * 1024ull;
+		/** Maximum number of resources that may be relocated during one pass. */
+		uint32_t mMaxMovesPerPass = 64u;
+	};
+
+	/** Statistics about what has been relocated during one defragmentation pass. */
+	struct defragmentation_stats
+	{
+		uint32_t mBuffersMoved = 0u;
+		uint32_t mImagesMoved = 0u;
+		vk::DeviceSize mBytesMoved = 0;
+		uint32_t mViewsRecreated = 0u;
+		int mDescriptorSetsInvalidated = 0;
+	};
+
+	/**	Incrementally relocates buffers and images which have been registered with it,
+	 *	in order to fight memory fragmentation in long-running applications.
+	 *
+	 *	If Auto-Vk is used with VMA (AVK_USE_VMA), VMA's defragmentation algorithm decides
+	 *	which allocations are to be moved, and compacts its memory blocks.
+	 *	ATTENTION: Without VMA, there is no sub-allocator whose memory blocks could be compacted.
+	 *	Every registered resource is merely re-created through AVK_MEM_BUFFER_HANDLE/AVK_MEM_IMAGE_HANDLE
+	 *	with a fresh dedicated allocation, and its old memory is released afterwards. This leaves the
+	 *	placement entirely to the driver and does NOT compact anything by itself.
+	 *
+	 *	Usage:
+	 *	 1. Register all resources that may be moved via add(...), and all image views,
+	 *	    buffer views, and descriptor caches which depend on them.
+	 *	 2. Once per frame, invoke begin_pass(), record and submit the returned command,
+	 *	 3. and invoke end_pass() after the submitted work has completed on the device.
+	 *	    This patches the handles of all moved resources, re-creates dependent views,
+	 *	    and removes stale entries from the registered descriptor caches. The old resources
+	 *	    and views are handed over to a deferred_destruction_queue, because frames which are
+	 *	    still in flight might use them.
+	 *	 4. Repeat until is_finished() returns true.
+	 *
+	 *	With VMA, the old memory of the moved resources is returned to VMA by end_pass(). Therefore,
+	 *	with VMA, invoke end_pass() only once no frame in flight uses the moved resources anymore.
+	 *
+	 *	Between begin_pass() and end_pass(), the registered resources must not be written to
+	 *	by the device, because the copies are made from their old memory.
+	 *	All registered objects must stay at the same address in memory while they are registered.
+	 */
+	class defragmenter_t
+	{
+		friend class root;
+
+	public:
+		defragmenter_t() = default;
+		defragmenter_t(defragmenter_t&& aOther) noexcept;
+		defragmenter_t(const defragmenter_t&) = delete;
+		defragmenter_t& operator=(defragmenter_t&& aOther) noexcept;
+		defragmenter_t& operator=(const defragmenter_t&) = delete;
+		~defragmenter_t();
+
+		/** Gets the config which limits the work of each pass. */
+		const auto& config() const { return mConfig; }
+		/** Gets the config which limits the work of each pass. */
+		auto& config() { return mConfig; }
+
+		/**	Register a buffer which may be relocated.
+		 *	The buffer must have been created with both, eTransferSrc and eTransferDst usage flags.
+		 */
+		defragmenter_t& add(buffer_t& aBuffer);
+
+		/**	Register an image which may be relocated.
+		 *	The image must have been created with both, eTransferSrc and eTransferDst usage flags.
+		 *	@param	aImage			The image which may be relocated.
+		 *	@param	aCurrentLayout	The layout which the image is in whenever a pass is executed. The relocated
+		 *							image will be transitioned into the same layout. If eUndefined is passed,
+		 *							the contents are not preserved.
+		 */
+		defragmenter_t& add(image_t& aImage, avk::layout::image_layout aCurrentLayout);
+
+		/**	Register an image view, and the image it refers to, s.t. both of them are kept valid when the image is moved.
+		 *	@param	aImageView		The image view which shall be re-created after its image has been moved.
+		 *	@param	aCurrentLayout	The layout which the image is in whenever a pass is executed.
+		 */
+		defragmenter_t& add(image_view_t& aImageView, avk::layout::image_layout aCurrentLayout);
+
+		/** Register an image view which shall be re-created whenever its image is moved. */
+		defragmenter_t& add_dependent_view(image_view_t& aImageView);
+
+		/** Register a buffer view which shall be re-created whenever its buffer is moved. */
+		defragmenter_t& add_dependent_view(buffer_view_t& aBufferView);
+
+		/** Register a descriptor cache whose descriptor sets shall be removed whenever they refer to a moved resource. */
+		defragmenter_t& add_dependent_descriptor_cache(descriptor_cache_t& aDescriptorCache);
+
+		/** Unregister a buffer, e.g. before it is destroyed. Must not be invoked while a pass is in flight. */
+		void remove(const buffer_t& aBuffer);
+		/** Unregister an image, e.g. before it is destroyed. Must not be invoked while a pass is in flight. */
+		void remove(const image_t& aImage);
+		/** Unregister an image view, e.g. before it is destroyed. Must not be invoked while a pass is in flight. */
+		void remove(const image_view_t& aImageView);
+		/** Unregister a buffer view, e.g. before it is destroyed. Must not be invoked while a pass is in flight. */
+		void remove(const buffer_view_t& aBufferView);
+
+		/**	Determine the next resources to be moved (within the limits of config()), create their new
+		 *	instances and return the copy commands which transfer the contents to the new locations.
+		 *	@return	A command which must be recorded and submitted. It might be empty if nothing
+		 *			has to be moved during this pass.
+		 */
+		avk::command::action_type_command begin_pass();
+
+		/**	Must be invoked after the command returned by begin_pass() has completed execution on the device.
+		 *	Swaps the moved resources' handles, re-creates dependent views, invalidates dependent
+		 *	descriptor sets, and hands the old resources and views over to deferred destruction.
+		 *	@param	aDeferredDestruction	The queue which destroys the old resources and views.
+		 *	@param	aRetireValue			The value which the device must have passed before the old resources may be
+		 *									destroyed. If not set, aDeferredDestruction's current retire value is used.
+		 */
+		defragmentation_stats end_pass(deferred_destruction_queue& aDeferredDestruction, std::optional<uint64_t> aRetireValue = {});
+
+		/** Returns true while a pass has been begun, but not ended yet. */
+		bool is_pass_in_flight() const { return mPassInFlight; }
+
+		/** Returns true if no more resources are to be moved. Registering further resources starts over. */
+		bool is_finished() const { return mFinished; }
+
+	private:
+		struct image_entry
+		{
+			image_t* mImage;
+			vk::ImageLayout mLayout;
+		};
+
+		struct pending_move
+		{
+			std::variant<buffer_t*, image_entry> mResource;
+#if defined(AVK_USES_VMA)
+			// The new resource, bound to the destination allocation of the VMA move:
+			std::variant<vk::Buffer, vk::Image> mNewResource;
+#else
+			// The new resource, backed by its own allocation:
+			std::variant<AVK_MEM_BUFFER_HANDLE, AVK_MEM_IMAGE_HANDLE> mNewResource;
+#endif
+			vk::DeviceSize mSize;
+		};
+
+		bool is_registered(const buffer_t* aBuffer) const;
+		bool is_registered(const image_t* aImage) const;
+		// aDeferredDestruction may only be nullptr if there are no pending moves:
+		defragmentation_stats conclude_pass(deferred_destruction_queue* aDeferredDestruction, uint64_t aRetireValue);
+		void patch_dependents(const buffer_t* aMovedBuffer, vk::Buffer aOldHandle, deferred_destruction_queue& aDeferredDestruction, uint64_t aRetireValue, defragmentation_stats& aStats);
+		void patch_dependents(const image_t* aMovedImage, deferred_destruction_queue& aDeferredDestruction, uint64_t aRetireValue, defragmentation_stats& aStats);
+#if defined(AVK_USES_VMA)
+		// Ignores all moves of the current VMA pass, destroys the new resources, and ends the pass:
+		void cancel_vma_pass();
+#endif
+
+		const root* mRoot = nullptr;
+		defragmentation_config mConfig;
+
+		std::vector<buffer_t*> mBuffers;
+		std::vector<image_entry> mImages;
+		std::vector<image_view_t*> mImageViews;
+		std::vector<buffer_view_t*> mBufferViews;
+		std::vector<descriptor_cache_t*> mDescriptorCaches;
+
+		std::vector<pending_move> mPendingMoves;
+		bool mPassInFlight = false;
+		bool mFinished = false;
+
+#if defined(AVK_USES_VMA)
+		VmaDefragmentationContext mVmaContext = nullptr;
+		VmaDefragmentationPassMoveInfo mVmaPass = {};
+#else
+		// Index of the next registered resource to be moved. Buffers come first, then images.
+		size_t mNextIndex = 0;
+#endif
+	};
+
+	/** Typedef representing any kind of OWNING defragmenter representations. */
+	using defragmenter = owning_resource<defragmenter_t>;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Caches the properties of a root's physical device, which are constant for the lifetime of the device.
+	 *
+	 *	Every category of properties is queried from the physical device the first time it is requested,
+	 *	and served from the cache afterwards. Querying the physical device is comparatively expensive,
+	 *	and many of the properties are needed whenever a buffer, image, descriptor pool, or acceleration
+	 *	structure is created. All accessors are thread-safe, and the returned references remain valid
+	 *	for the lifetime of the root.
+	 *
+	 *	Use root::capabilities() to get a root's cache.
+	 */
+	class device_capabilities
+	{
+	public:
+		explicit device_capabilities(const root* aRoot) : mRoot{ aRoot } {}
+		device_capabilities(device_capabilities&&) = delete;
+		device_capabilities(const device_capabilities&) = delete;
+		device_capabilities& operator=(device_capabilities&&) = delete;
+		device_capabilities& operator=(const device_capabilities&) = delete;
+		~device_capabilities() = default;
+
+		/** The general properties of the physical device, including its limits. */
+		const vk::PhysicalDeviceProperties& properties() const;
+		/** The limits of the physical device. */
+		const vk::PhysicalDeviceLimits& limits() const { return properties().limits; }
+		/** The memory types and memory heaps of the physical device. */
+		const vk::PhysicalDeviceMemoryProperties& memory_properties() const;
+		/** The features which the physical device supports for the given format. */
+		vk::FormatProperties format_properties(vk::Format aFormat) const;
+		/** Properties of VK_EXT_external_memory_host. The extension must be supported by the physical device. */
+		const vk::PhysicalDeviceExternalMemoryHostPropertiesEXT& external_memory_host_properties() const;
+
+#if VK_HEADER_VERSION >= 135
+#if VK_HEADER_VERSION >= 162
+		/** Properties of VK_KHR_ray_tracing_pipeline. The extension must be supported by the physical device. */
+		const vk::PhysicalDeviceRayTracingPipelinePropertiesKHR& ray_tracing_properties() const;
+		/** Properties of VK_KHR_acceleration_structure. The extension must be supported by the physical device. */
+		const vk::PhysicalDeviceAccelerationStructurePropertiesKHR& acceleration_structure_properties() const;
+#else
+		/** Properties of VK_KHR_ray_tracing. The extension must be supported by the physical device. */
+		const vk::PhysicalDeviceRayTracingPropertiesKHR& ray_tracing_properties() const;
+#endif
+#endif
+
+	private:
+		friend class root;
+		// Re-pointed by root when it is moved:
+		const root* mRoot;
+
+		mutable std::once_flag mPropertiesQueried;
+		mutable vk::PhysicalDeviceProperties mProperties;
+		mutable std::once_flag mMemoryPropertiesQueried;
+		mutable vk::PhysicalDeviceMemoryProperties mMemoryProperties;
+		mutable std::once_flag mExternalMemoryHostPropertiesQueried;
+		mutable vk::PhysicalDeviceExternalMemoryHostPropertiesEXT mExternalMemoryHostProperties;
+#if VK_HEADER_VERSION >= 135
+		mutable std::once_flag mRayTracingPropertiesQueried;
+#if VK_HEADER_VERSION >= 162
+		mutable vk::PhysicalDeviceRayTracingPipelinePropertiesKHR mRayTracingProperties;
+		mutable std::once_flag mAccelerationStructurePropertiesQueried;
+		mutable vk::PhysicalDeviceAccelerationStructurePropertiesKHR mAccelerationStructureProperties;
+#else
+		mutable vk::PhysicalDeviceRayTracingPropertiesKHR mRayTracingProperties;
+#endif
+#endif
+
+		// Formats are queried individually, because only a small fraction of them is ever used:
+		mutable std::mutex mFormatPropertiesMutex;
+		mutable std::unordered_map<vk::Format, vk::FormatProperties> mFormatProperties;
+	};
+}
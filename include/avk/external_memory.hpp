@@ -0,0 +1,26 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Requests that the memory of a buffer or image is allocated s.t. it can be exported as a file descriptor,
+	 *	either as opaque file descriptor (VK_KHR_external_memory_fd) or as dma-buf (VK_EXT_external_memory_dma_buf).
+	 *	See root::export_memory_fd.
+	 */
+	struct external_memory_export
+	{
+		/** All the handle types which the memory shall be exportable as. */
+		vk::ExternalMemoryHandleTypeFlags mHandleTypes = vk::ExternalMemoryHandleTypeFlagBits::eOpaqueFd;
+	};
+
+	/**	A file descriptor which refers to memory that has been exported by another device, process, or API.
+	 *	If the import succeeds, the implementation takes ownership of the file descriptor, i.e., do not close it afterwards.
+	 *	Opaque file descriptors can only be imported by a device with the same UUIDs as the exporting one,
+	 *	and the resource must be created with the same parameters as the exported resource.
+	 */
+	struct external_memory_import
+	{
+		int mFd;
+		vk::ExternalMemoryHandleTypeFlagBits mHandleType = vk::ExternalMemoryHandleTypeFlagBits::eOpaqueFd;
+	};
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	A range of a frame_linear_allocator's memory which has been handed out for the current frame.
+	 *	mMappedData points to the persistently mapped, host-coherent memory of mSlice, so that data can
+	 *	be written into it directly. Do not use mSlice.fill(), which would map the memory a second time.
+	 */
+	struct frame_linear_allocation
+	{
+		buffer_slice mSlice;
+		void* mMappedData;
+	};
+
+	/**	A linear (bump) allocator for transient per-frame data, such as vertex, index, uniform, and indirect data.
+	 *
+	 *	It manages one list of persistently mapped, host-coherent buffers ("chunks") per frame in flight.
+	 *	Allocations hand out aligned buffer_slices from the current frame's chunks by bumping an offset,
+	 *	without invoking any Vulkan function. If the current chunk is exhausted, the next one is used,
+	 *	and a new chunk is created only if there is none left, i.e. after warm-up, no more chunks are created.
+	 *
+	 *	Usage:
+	 *	 1. Invoke begin_frame at the beginning of each frame, passing a monotonically increasing retire value
+	 *	    (e.g., the frame index). This resets the frame slot which has been used N frames ago in O(1).
+	 *	 2. Invoke allocate or push during the frame, and use the resulting slices in descriptors,
+	 *	    vertex or index buffer bindings, or as indirect buffers.
+	 *
+	 *	The application must ensure that the device has finished all work which uses the allocations of a
+	 *	frame slot before that slot is reset, e.g., by waiting on the fence of the frame N frames ago.
+	 */
+	class frame_linear_allocator_t
+	{
+		friend class root;
+
+		struct chunk
+		{
+			buffer mBuffer;
+			// Declared after mBuffer => unmapped before the buffer is destroyed:
+			std::optional<scoped_mapping<AVK_MEM_BUFFER_HANDLE>> mMapping;
+		};
+
+		struct frame_slot
+		{
+			std::vector<chunk> mChunks;
+			size_t mCurrentChunk = 0;
+			vk::DeviceSize mCurrentOffset = 0;
+			std::optional<uint64_t> mRetireValue;
+		};
+
+	public:
+		frame_linear_allocator_t() = default;
+		frame_linear_allocator_t(frame_linear_allocator_t&&) noexcept = default;
+		frame_linear_allocator_t(const frame_linear_allocator_t&) = delete;
+		frame_linear_allocator_t& operator=(frame_linear_allocator_t&&) noexcept = default;
+		frame_linear_allocator_t& operator=(const frame_linear_allocator_t&) = delete;
+		~frame_linear_allocator_t() = default;
+
+		/**	Start allocating for a new frame. The frame slot aRetireValue % number_of_frames_in_flight() is reset.
+		 *	@param	aRetireValue		A monotonically increasing value identifying the frame, e.g., the frame index.
+		 *	@param	aCompletedValue		Optionally, the retire value which the device is known to have passed. If set,
+		 *								it is verified that the frame slot's previous allocations are no longer in use.
+		 */
+		void begin_frame(uint64_t aRetireValue, std::optional<uint64_t> aCompletedValue = {});
+
+		/**	Allocate a range of memory for the current frame.
+		 *	@param	aSize		Size of the allocation in bytes. Must not exceed chunk_size().
+		 *	@param	aAlignment	Alignment of the allocation's offset in bytes. If 0, the allocator's default alignment is used.
+		 *	@return	The allocated slice and a pointer to its mapped memory.
+		 */
+		frame_linear_allocation allocate(vk::DeviceSize aSize, vk::DeviceSize aAlignment = 0);
+
+		/**	Allocate a range of memory for the current frame and copy the given data into it.
+		 *	@param	aDataPtr	Pointer to the data to be copied. MUST point to at least aSize bytes.
+		 *	@param	aSize		Size of the data in bytes.
+		 *	@param	aAlignment	Alignment of the allocation's offset in bytes. If 0, the allocator's default alignment is used.
+		 *	@return	The slice which contains the data.
+		 */
+		buffer_slice push(const void* aDataPtr, vk::DeviceSize aSize, vk::DeviceSize aAlignment = 0)
+		{
+			auto allocation = allocate(aSize, aAlignment);
+			copy_to_mapped_memory(allocation.mMappedData, aDataPtr, static_cast<size_t>(aSize));
+			return allocation.mSlice;
+		}
+
+		/**	Allocate a range of memory for the current frame and copy the given elements into it.
+		 *	The allocation is aligned to the larger of alignof(T) and the allocator's default alignment.
+		 */
+		template <typename T>
+		buffer_slice push(const std::vector<T>& aData)
+		{
+			return push(aData.data(), static_cast<vk::DeviceSize>(sizeof(T) * aData.size()), std::max(static_cast<vk::DeviceSize>(alignof(T)), mDefaultAlignment));
+		}
+
+		/** The number of frame slots, i.e. the number of frames in flight. */
+		size_t number_of_frames_in_flight() const { return mFrameSlots.size(); }
+		/** The size of each chunk in bytes, which is also the maximum size of a single allocation. */
+		vk::DeviceSize chunk_size() const { return mChunkSize; }
+		/** The number of chunks which have been created for all frame slots. */
+		size_t number_of_chunks() const;
+		/** The number of bytes which have been handed out for the current frame, including alignment padding. */
+		vk::DeviceSize bytes_allocated_in_current_frame() const;
+
+	private:
+		chunk create_chunk() const;
+
+		root* mRoot = nullptr;
+		vk::DeviceSize mChunkSize = 0;
+		vk::DeviceSize mDefaultAlignment = 0;
+		vk::BufferUsageFlags mBufferUsageFlags;
+		vk::MemoryPropertyFlags mMemoryProperties;
+		std::vector<frame_slot> mFrameSlots;
+		size_t mCurrentFrameSlot = 0;
+	};
+
+	/** Typedef representing any kind of OWNING frame linear allocator representations. */
+	using frame_linear_allocator = owning_resource<frame_linear_allocator_t>;
+}
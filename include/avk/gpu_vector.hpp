@@ -0,0 +1,187 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	class baked_commands_t;
+
+	/** Configuration of a gpu_vector's growth behavior. */
+	struct gpu_vector_config
+	{
+		/**	If set, the device buffer is created as a sparse buffer of mMaxCapacity elements, and growing it
+		 *	only binds additional memory pages via this queue, which must support sparse binding operations.
+		 *	Neither the buffer handle changes nor does any data have to be copied.
+		 *	Requires the sparseBinding and sparseResidencyBuffer device features.
+		 *	If not set, growing creates a new buffer of twice the capacity and copies the contents on the GPU.
+		 */
+		queue* mSparseBindingQueue = nullptr;
+
+		/** The maximum number of elements, which determines the size of the sparse buffer. Only used with sparse binding. */
+		size_t mMaxCapacity = 0;
+	};
+
+	/**	Type-agnostic implementation of gpu_vector<T>. Use gpu_vector<T> instead of this class directly.
+	 *
+	 *	Elements are written into a persistently mapped, host-coherent staging buffer which shadows the contents
+	 *	of the device-local buffer. flush() returns the commands which transfer the modified range into the
+	 *	device buffer, and, after growth, the commands which copy the previous contents into the new buffer.
+	 *
+	 *	ATTENTION: The staging buffer is not multi-buffered. Do not modify elements while the commands of a previous
+	 *	flush() are still being executed, e.g. by flushing at most once per frame after waiting for the frame's fence.
+	 */
+	class gpu_vector_base
+	{
+		friend class root;
+
+	public:
+		gpu_vector_base() = default;
+		gpu_vector_base(gpu_vector_base&&) noexcept = default;
+		gpu_vector_base(const gpu_vector_base&) = delete;
+		gpu_vector_base& operator=(gpu_vector_base&&) noexcept = default;
+		gpu_vector_base& operator=(const gpu_vector_base&) = delete;
+		~gpu_vector_base() = default;
+
+		/** The number of elements. */
+		size_t size() const { return mSize; }
+		/** The number of elements which fit into the current buffers. */
+		size_t capacity() const { return mCapacity; }
+		/** Returns true if there are no elements. */
+		bool empty() const { return 0 == mSize; }
+
+		/** The device-local buffer. Its handle changes when the vector grows, unless sparse binding is used. */
+		const buffer_t& get_buffer() const { return mBuffer.get(); }
+		/** A slice which covers exactly the current elements. */
+		buffer_slice slice() const { return buffer_slice{ mBuffer.get(), 0, static_cast<vk::DeviceSize>(std::max(mSize, size_t{ 1 }) * mElementSize) }; }
+		/** Get a buffer_descriptor for binding the current elements as a storage buffer. */
+		auto as_storage_buffer() const { return slice().as_storage_buffer(); }
+
+		/** Make sure that at least aCapacity elements fit into the buffers, growing them if necessary. */
+		void reserve(size_t aCapacity);
+
+		/** Change the number of elements. New elements are left uninitialized. */
+		void resize(size_t aSize);
+
+		/** Remove all elements. Capacity is kept. */
+		void clear() { mSize = 0; reset_dirty_range(); }
+
+		/**	Gets the commands which transfer all pending modifications to the device buffer.
+		 *	Returns an empty command if there are no pending modifications.
+		 */
+		command::action_type_command flush();
+
+		/**	Register a descriptor cache whose descriptor sets shall be removed when the buffer handle changes.
+		 *	The descriptor cache must outlive this vector.
+		 */
+		void add_dependent_descriptor_cache(descriptor_cache_t& aDescriptorCache) { mDependentDescriptorCaches.push_back(&aDescriptorCache); }
+
+		/**	Register baked commands which shall be invalidated when the buffer handle changes, if they refer to the buffer.
+		 *	The baked commands must outlive this vector.
+		 */
+		void add_dependent_baked_commands(baked_commands_t& aBakedCommands) { mDependentBakedCommands.push_back(&aBakedCommands); }
+
+		/** Set a callback which is invoked with the new buffer after the buffer handle has changed, e.g. to update descriptors. */
+		void set_on_buffer_changed(std::function<void(const buffer_t&)> aCallback) { mOnBufferChanged = std::move(aCallback); }
+
+	protected:
+		/** Gets a pointer to the staging memory of the element at the given index and marks it as modified. */
+		void* write_access(size_t aIndex, size_t aCount);
+		/** Gets a pointer to the staging memory of the element at the given index. */
+		const void* read_access(size_t aIndex) const { return static_cast<const uint8_t*>(mStagingMapping->get()) + aIndex * mElementSize; }
+		/** Append aCount uninitialized elements and return the index of the first one. */
+		size_t grow_by(size_t aCount);
+
+	private:
+		void initialize(root& aRoot, size_t aElementSize, size_t aInitialCapacity, vk::BufferUsageFlags aBufferUsageFlags, gpu_vector_config aConfig);
+		buffer create_device_buffer(size_t aCapacity) const;
+		void commit_sparse_memory(size_t aCapacity);
+		void reset_dirty_range() { mDirtyBegin = std::numeric_limits<size_t>::max(); mDirtyEnd = 0; }
+
+		root* mRoot = nullptr;
+		size_t mElementSize = 0;
+		vk::BufferUsageFlags mBufferUsageFlags;
+		gpu_vector_config mConfig;
+		size_t mSize = 0;
+		size_t mCapacity = 0;
+
+		// Sparse binding: memory blocks bound to the sparse buffer, and the number of bytes which are bound.
+		std::vector<vk::UniqueHandle<vk::DeviceMemory, DISPATCH_LOADER_CORE_TYPE>> mSparseMemory;
+		vk::DeviceSize mCommittedBytes = 0;
+
+		buffer mBuffer;
+		// The previous device buffer whose contents have not been copied into mBuffer yet:
+		std::optional<buffer> mPendingGrowthSource;
+		size_t mPendingGrowthElements = 0;
+
+		// Declared after mStaging => unmapped before the staging buffer is released:
+		buffer mStaging;
+		std::optional<scoped_mapping<AVK_MEM_BUFFER_HANDLE>> mStagingMapping;
+		// Range of modified elements [mDirtyBegin, mDirtyEnd):
+		size_t mDirtyBegin = std::numeric_limits<size_t>::max();
+		size_t mDirtyEnd = 0;
+
+		std::vector<descriptor_cache_t*> mDependentDescriptorCaches;
+		std::vector<baked_commands_t*> mDependentBakedCommands;
+		std::function<void(const buffer_t&)> mOnBufferChanged;
+	};
+
+	/**	A growable array of trivially copyable elements in device-local memory.
+	 *
+	 *	Modifications are recorded in a host-side staging copy and transferred by the commands returned from flush().
+	 *	Growth is geometric (amortized constant time per element) and is performed via GPU-side copies,
+	 *	or, if configured, by binding additional memory to a sparse buffer.
+	 *
+	 *	Example:
+	 *		auto lights = myRoot.create_gpu_vector<light_data>(64, vk::BufferUsageFlagBits::eStorageBuffer);
+	 *		lights.push_back(someLight);
+	 *		myRoot.record({ lights.flush(), ... });
+	 */
+	template <typename T>
+	class gpu_vector : public gpu_vector_base
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "gpu_vector<T> requires a trivially copyable T.");
+
+	public:
+		using value_type = T;
+
+		/** Append an element. */
+		void push_back(const T& aElement)
+		{
+			const auto index = grow_by(1);
+			memcpy(write_access(index, 1), &aElement, sizeof(T));
+		}
+
+		/** Append multiple elements. */
+		void append(const T* aElements, size_t aCount)
+		{
+			if (0 == aCount) {
+				return;
+			}
+			const auto index = grow_by(aCount);
+			copy_to_mapped_memory(write_access(index, aCount), aElements, sizeof(T) * aCount);
+		}
+
+		/** Append multiple elements. */
+		void append(const std::vector<T>& aElements) { append(aElements.data(), aElements.size()); }
+
+		/** Overwrite the element at the given index. */
+		void set(size_t aIndex, const T& aElement)
+		{
+			assert(aIndex < size());
+			memcpy(write_access(aIndex, 1), &aElement, sizeof(T));
+		}
+
+		/** Gets the element at the given index from the host-side copy. Modifications performed on the device are not reflected. */
+		const T& operator[](size_t aIndex) const
+		{
+			assert(aIndex < size());
+			return *static_cast<const T*>(read_access(aIndex));
+		}
+
+		/** Remove the last element. */
+		void pop_back()
+		{
+			assert(!empty());
+			resize(size() - 1);
+		}
+	};
+}
@@ -8,6 +8,8 @@ namespace avk
 	class image_t
 	{
 		friend class root;
+		friend class defragmenter_t;
+		friend class aliasing_heap_t;
 
 	public:
 		image_t() = default;
@@ -62,19 +64,47 @@ namespace avk
 		 *	@param	aLayoutTransition		Layout of the image before the generate_mip_maps >> layout that the image shall be transitioned into afterwards
 		 */
 		avk::command::action_type_command generate_mip_maps(avk::layout::image_layout_transition aLayoutTransition);
+
+		/**	Start tracking the layout of each mip level and array layer of this image.
+		 *	Once enabled, layout transitions of image memory barriers which refer to this image use the exact
+		 *	old layouts of the affected subresources instead of the specified ones (unless the specified old layout
+		 *	is eUndefined, which discards the contents), and transitions into the current layout are skipped.
+		 *	The tracked state is updated when such barriers, generate_mip_maps, or the beginning of a render pass
+		 *	which uses this image as attachment (=> the attachment's final layout) are recorded, i.e., commands must be
+		 *	recorded in execution order, and not via command::parallel. Layout changes which happen in any other way are not tracked.
+		 *	The destination scopes of such barriers are tracked as the last accesses of the subresources. If a barrier's source
+		 *	scope is inferred automatically, but no command precedes it in the list of recorded commands, the tracked last access
+		 *	of each subresource serves as the exact source scope instead of a full dependency.
+		 *	If layout tracking is enabled already, the tracked state is reset to the given layout.
+		 *	@param	aCurrentLayout		The layout which all subresources are in at the moment.
+		 */
+		void enable_layout_tracking(vk::ImageLayout aCurrentLayout);
+		/** Returns true if enable_layout_tracking has been invoked for this image. */
+		bool is_layout_tracking_enabled() const { return static_cast<bool>(mLayoutState); }
+		/** Gets the tracked layout state, or nullptr if layout tracking is not enabled. */
+		image_layout_state* layout_state() const { return mLayoutState.get(); }
+		/** Gets the tracked layout of the given subresource. Requires layout tracking to be enabled. */
+		vk::ImageLayout current_layout(uint32_t aMipLevel = 0, uint32_t aArrayLayer = 0) const;
 		
+		/** Returns true if this image's memory is exportable, or has been imported via root::create_image(external_memory_import, ...). */
+		bool has_external_memory() const { return static_cast<bool>(mExternalMemory); }
+
 		[[nodiscard]] const auto* root_ptr() const { return mRoot; }
 
 	private:
 		const root* mRoot;
 		// The image create info which contains all the parameters for image creation
 		vk::ImageCreateInfo mCreateInfo;
+		// Memory which is exported/imported via file descriptors, if any. Declared before mImage => freed after the image has been destroyed:
+		vk::UniqueHandle<vk::DeviceMemory, DISPATCH_LOADER_CORE_TYPE> mExternalMemory;
 		// The image handle. This member will contain a valid handle only after successful image creation.
 		std::variant<std::monostate, AVK_MEM_IMAGE_HANDLE, vk::Image> mImage;
 		// The image_usage flags specified during creation
 		image_usage mImageUsage;
 		// Image aspect flags (set during creation)
 		vk::ImageAspectFlags mAspectFlags;
+		// Layout per subresource, if tracking has been enabled. unique_ptr => stays in place when this image is moved:
+		std::unique_ptr<image_layout_state> mLayoutState;
 	};
 
 	/** Typedef representing any kind of OWNING image representations. */
@@ -0,0 +1,138 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/** The tracked state of a subresource of an image, see image_layout_state. */
+	struct subresource_state
+	{
+		/** The layout which the subresource is in. */
+		vk::ImageLayout mLayout = vk::ImageLayout::eUndefined;
+		/** The stages and accesses of the last access, as announced by the destination scope of the last barrier. Empty if unknown. */
+		stage_and_access_precisely mLastAccess = {};
+
+		bool operator==(const subresource_state& aOther) const
+		{
+			return mLayout == aOther.mLayout && mLastAccess.mStage == aOther.mLastAccess.mStage && mLastAccess.mAccess == aOther.mLastAccess.mAccess;
+		}
+	};
+
+	/**	Tracks the layout and the last access of each mip level and array layer of an image.
+	 *
+	 *	Subresources are linearized as (mipLevel * arrayLayers + arrayLayer) and stored as a sorted list
+	 *	of intervals of equal state. I.e., an image whose subresources are all in the same state takes up
+	 *	one single interval, regardless of its number of mip levels and array layers.
+	 *	Aspects are not distinguished, i.e., all aspects of a subresource are assumed to be in the same state.
+	 */
+	class image_layout_state
+	{
+		struct interval
+		{
+			uint32_t mBegin;
+			subresource_state mState;
+		};
+
+	public:
+		image_layout_state(uint32_t aMipLevels, uint32_t aArrayLayers, vk::ImageLayout aInitialLayout)
+			: mMipLevels{ aMipLevels }
+			, mArrayLayers{ aArrayLayers }
+			, mIntervals{ interval{ 0u, subresource_state{ aInitialLayout } } }
+		{}
+
+		/** Gets the state of the given subresource. */
+		const subresource_state& get(uint32_t aMipLevel, uint32_t aArrayLayer) const
+		{
+			assert(aMipLevel < mMipLevels && aArrayLayer < mArrayLayers);
+			return interval_containing(aMipLevel * mArrayLayers + aArrayLayer)->mState;
+		}
+
+		/**	Invoke the given function for each run of consecutive array layers of equal state within the given subresource range.
+		 *	@param	aRange		The subresource range to visit. VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS are supported.
+		 *	@param	aFunction	Function with the signature void(uint32_t aMipLevel, uint32_t aBaseArrayLayer, uint32_t aLayerCount, const subresource_state& aState)
+		 */
+		template <typename F>
+		void for_each_in_range(const vk::ImageSubresourceRange& aRange, F&& aFunction) const
+		{
+			const auto [mipBegin, mipEnd, layerBegin, layerEnd] = resolve(aRange);
+			for (auto mip = mipBegin; mip < mipEnd; ++mip) {
+				const auto end = mip * mArrayLayers + layerEnd;
+				auto begin = mip * mArrayLayers + layerBegin;
+				auto it = interval_containing(begin);
+				while (begin < end) {
+					const auto next = std::next(it);
+					const auto runEnd = std::min(end, std::end(mIntervals) == next ? end : next->mBegin);
+					aFunction(mip, begin - mip * mArrayLayers, runEnd - begin, it->mState);
+					begin = runEnd;
+					it = next;
+				}
+			}
+		}
+
+		/** Set the state of all subresources within the given range. */
+		void set(const vk::ImageSubresourceRange& aRange, const subresource_state& aState)
+		{
+			const auto [mipBegin, mipEnd, layerBegin, layerEnd] = resolve(aRange);
+			if (0 == layerBegin && mArrayLayers == layerEnd) {
+				// All layers => the range is contiguous:
+				set_linear(mipBegin * mArrayLayers, mipEnd * mArrayLayers, aState);
+				return;
+			}
+			for (auto mip = mipBegin; mip < mipEnd; ++mip) {
+				set_linear(mip * mArrayLayers + layerBegin, mip * mArrayLayers + layerEnd, aState);
+			}
+		}
+
+		/** The number of intervals of equal state which are stored. */
+		size_t number_of_intervals() const { return mIntervals.size(); }
+
+	private:
+		std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> resolve(const vk::ImageSubresourceRange& aRange) const
+		{
+			const auto mipEnd = VK_REMAINING_MIP_LEVELS == aRange.levelCount ? mMipLevels : std::min(mMipLevels, aRange.baseMipLevel + aRange.levelCount);
+			const auto layerEnd = VK_REMAINING_ARRAY_LAYERS == aRange.layerCount ? mArrayLayers : std::min(mArrayLayers, aRange.baseArrayLayer + aRange.layerCount);
+			return { aRange.baseMipLevel, mipEnd, aRange.baseArrayLayer, layerEnd };
+		}
+
+		std::vector<interval>::const_iterator interval_containing(uint32_t aIndex) const
+		{
+			// The first interval always begins at 0 => there is always one which begins at or before aIndex:
+			return std::prev(std::upper_bound(std::begin(mIntervals), std::end(mIntervals), aIndex, [](uint32_t lIndex, const interval& lInterval) { return lIndex < lInterval.mBegin; }));
+		}
+
+		void set_linear(uint32_t aBegin, uint32_t aEnd, const subresource_state& aState)
+		{
+			if (aBegin >= aEnd) {
+				return;
+			}
+			// Remember the state which continues after the range:
+			std::optional<subresource_state> stateAfter;
+			if (aEnd < mMipLevels * mArrayLayers) {
+				stateAfter = interval_containing(aEnd)->mState;
+			}
+
+			// Replace all intervals which begin within [aBegin, aEnd]:
+			auto first = std::lower_bound(std::begin(mIntervals), std::end(mIntervals), aBegin, [](const interval& lInterval, uint32_t lIndex) { return lInterval.mBegin < lIndex; });
+			auto last = std::upper_bound(first, std::end(mIntervals), aEnd, [](uint32_t lIndex, const interval& lInterval) { return lIndex < lInterval.mBegin; });
+			auto it = mIntervals.erase(first, last);
+			it = mIntervals.insert(it, interval{ aBegin, aState });
+			if (stateAfter.has_value()) {
+				it = mIntervals.insert(std::next(it), interval{ aEnd, stateAfter.value() });
+				// Merge with the subsequent interval:
+				if (stateAfter.value() == aState) {
+					it = std::prev(mIntervals.erase(it));
+				}
+				else {
+					it = std::prev(it);
+				}
+			}
+			// Merge with the preceding interval:
+			if (std::begin(mIntervals) != it && std::prev(it)->mState == aState) {
+				mIntervals.erase(it);
+			}
+		}
+
+		uint32_t mMipLevels;
+		uint32_t mArrayLayers;
+		std::vector<interval> mIntervals;
+	};
+}
@@ -37,6 +37,7 @@ namespace avk
 	class image_view_t
 	{
 		friend class root;
+		friend class defragmenter_t;
 		
 		struct helper_t
 		{
@@ -0,0 +1,200 @@
+#pragma once
+// This header does not depend on Vulkan and can be included on its own, e.g., in order to benchmark the copy routines.
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "avk/worker_pool.hpp"
+
+#if defined(__AVX2__)
+#define AVK_MAPPED_MEMORY_COPY_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AVK_MAPPED_MEMORY_COPY_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/** CONFIG SETTING: AVK_NON_TEMPORAL_COPY_MIN_SIZE
+ *
+ *	Copies into mapped memory of at least this many bytes are performed with non-temporal
+ *	(streaming) SIMD stores, which bypass the CPU caches and are considerably faster when
+ *	writing into write-combined memory. Smaller copies are performed with memcpy.
+ */
+#if !defined(AVK_NON_TEMPORAL_COPY_MIN_SIZE)
+#define AVK_NON_TEMPORAL_COPY_MIN_SIZE (size_t{ 16 } * 1024)
+#endif
+
+/** CONFIG SETTING: AVK_PARALLEL_COPY_MIN_SIZE
+ *
+ *	Copies into mapped memory of at least this many bytes are split into chunks which are copied
+ *	by the calling thread and the workers of worker_pool::shared() concurrently.
+ *	Set it to SIZE_MAX in order to disable parallel copies.
+ */
+#if !defined(AVK_PARALLEL_COPY_MIN_SIZE)
+#define AVK_PARALLEL_COPY_MIN_SIZE (size_t{ 8 } * 1024 * 1024)
+#endif
+
+/** CONFIG SETTING: AVK_PARALLEL_COPY_MAX_THREADS
+ *
+ *	The maximum number of threads (including the calling thread) which perform a parallel copy.
+ *	A few threads are usually enough to saturate the bus bandwidth.
+ */
+#if !defined(AVK_PARALLEL_COPY_MAX_THREADS)
+#define AVK_PARALLEL_COPY_MAX_THREADS 4u
+#endif
+
+namespace avk
+{
+	/**	Copy memory with non-temporal stores on the calling thread.
+	 *	Uses AVX2 or SSE2 streaming stores if the code is compiled for an instruction set which supports them,
+	 *	and falls back to memcpy otherwise. Source and destination must not overlap.
+	 *	@param	aDst	Destination, typically mapped device memory
+	 *	@param	aSrc	Source in host memory
+	 *	@param	aSize	Number of bytes to copy
+	 */
+	inline void copy_non_temporal(void* aDst, const void* aSrc, size_t aSize)
+	{
+#if defined(AVK_MAPPED_MEMORY_COPY_AVX2) || defined(AVK_MAPPED_MEMORY_COPY_SSE2)
+#if defined(AVK_MAPPED_MEMORY_COPY_AVX2)
+		constexpr size_t vectorSize = sizeof(__m256i);
+#else
+		constexpr size_t vectorSize = sizeof(__m128i);
+#endif
+		auto* dst = static_cast<uint8_t*>(aDst);
+		const auto* src = static_cast<const uint8_t*>(aSrc);
+
+		// Streaming stores require an aligned destination => copy the unaligned head regularly:
+		const auto head = std::min(aSize, (vectorSize - reinterpret_cast<uintptr_t>(dst) % vectorSize) % vectorSize);
+		memcpy(dst, src, head);
+		dst += head;
+		src += head;
+		aSize -= head;
+
+		// Four vectors per iteration, in order to fill whole write-combining buffers (64 bytes) with SSE2:
+		constexpr size_t blockSize = 4 * vectorSize;
+		const auto numBlocks = aSize / blockSize;
+		for (size_t i = 0; i < numBlocks; ++i) {
+#if defined(AVK_MAPPED_MEMORY_COPY_AVX2)
+			const auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 0);
+			const auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 1);
+			const auto v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 2);
+			const auto v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 3);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(dst) + 0, v0);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(dst) + 1, v1);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(dst) + 2, v2);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(dst) + 3, v3);
+#else
+			const auto v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 0);
+			const auto v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 1);
+			const auto v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 2);
+			const auto v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 3);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 0, v0);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 1, v1);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 2, v2);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 3, v3);
+#endif
+			dst += blockSize;
+			src += blockSize;
+		}
+		// Make the streaming stores globally visible before anything else can happen (e.g. a queue submission):
+		_mm_sfence();
+
+		memcpy(dst, src, aSize - numBlocks * blockSize);
+#else
+		memcpy(aDst, aSrc, aSize);
+#endif
+	}
+
+	/**	Compare two memory ranges for equality using SIMD instructions if available.
+	 *	In contrast to memcmp, it does not determine an ordering, which allows to compare whole vectors at once.
+	 *	@param	aFirst		First memory range
+	 *	@param	aSecond		Second memory range
+	 *	@param	aSize		Number of bytes to compare
+	 *	@return	True if all bytes are equal
+	 */
+	inline bool memory_equal(const void* aFirst, const void* aSecond, size_t aSize)
+	{
+#if defined(AVK_MAPPED_MEMORY_COPY_AVX2) || defined(AVK_MAPPED_MEMORY_COPY_SSE2)
+		const auto* a = static_cast<const uint8_t*>(aFirst);
+		const auto* b = static_cast<const uint8_t*>(aSecond);
+#if defined(AVK_MAPPED_MEMORY_COPY_AVX2)
+		constexpr size_t vectorSize = sizeof(__m256i);
+#else
+		constexpr size_t vectorSize = sizeof(__m128i);
+#endif
+		// Two vectors per iteration, i.e. one cache line with AVX2:
+		constexpr size_t blockSize = 2 * vectorSize;
+		const auto numBlocks = aSize / blockSize;
+		for (size_t i = 0; i < numBlocks; ++i) {
+#if defined(AVK_MAPPED_MEMORY_COPY_AVX2)
+			const auto e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a) + 0), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b) + 0));
+			const auto e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a) + 1), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b) + 1));
+			if (-1 != _mm256_movemask_epi8(_mm256_and_si256(e0, e1))) {
+				return false;
+			}
+#else
+			const auto e0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a) + 0), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b) + 0));
+			const auto e1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a) + 1), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b) + 1));
+			if (0xFFFF != _mm_movemask_epi8(_mm_and_si128(e0, e1))) {
+				return false;
+			}
+#endif
+			a += blockSize;
+			b += blockSize;
+		}
+		return 0 == memcmp(a, b, aSize - numBlocks * blockSize);
+#else
+		return 0 == memcmp(aFirst, aSecond, aSize);
+#endif
+	}
+
+	/**	Copy host memory into mapped device memory, as fast as possible.
+	 *	Small copies are performed with memcpy, larger ones with non-temporal SIMD stores (see copy_non_temporal),
+	 *	and very large ones are additionally split into chunks which are copied by multiple threads concurrently.
+	 *	See AVK_NON_TEMPORAL_COPY_MIN_SIZE, AVK_PARALLEL_COPY_MIN_SIZE, and AVK_PARALLEL_COPY_MAX_THREADS.
+	 *	Source and destination must not overlap.
+	 *	@param	aDst		Destination, typically mapped device memory
+	 *	@param	aSrc		Source in host memory
+	 *	@param	aSize		Number of bytes to copy
+	 *	@param	aWorkerPool	The threads which help the calling thread with parallel copies
+	 */
+	inline void copy_to_mapped_memory(void* aDst, const void* aSrc, size_t aSize, worker_pool& aWorkerPool = worker_pool::shared())
+	{
+		if (aSize < AVK_NON_TEMPORAL_COPY_MIN_SIZE) {
+			memcpy(aDst, aSrc, aSize);
+			return;
+		}
+
+		const auto maxThreads = std::min(static_cast<size_t>(AVK_PARALLEL_COPY_MAX_THREADS), aWorkerPool.number_of_workers() + 1);
+		const auto numChunks = aSize < AVK_PARALLEL_COPY_MIN_SIZE ? size_t{ 1 } : std::min(maxThreads, aSize / (AVK_PARALLEL_COPY_MIN_SIZE / 2));
+		if (numChunks <= 1) {
+			copy_non_temporal(aDst, aSrc, aSize);
+			return;
+		}
+
+		// Chunk boundaries are aligned to the 4 KiB pages of the destination (i.e. relative to address 0, not to aDst),
+		// s.t. no two threads write into the same page, regardless of the destination's alignment:
+		constexpr uintptr_t pageSize = 4096;
+		const auto dstAddress = reinterpret_cast<uintptr_t>(aDst);
+		const auto chunkBegin = [dstAddress, aSize, numChunks](size_t lChunk) -> size_t {
+			if (0 == lChunk) {
+				return 0;
+			}
+			if (numChunks == lChunk) {
+				return aSize;
+			}
+			const auto pageBoundary = (dstAddress + lChunk * (aSize / numChunks) + pageSize - 1) / pageSize * pageSize;
+			return std::min(aSize, static_cast<size_t>(pageBoundary - dstAddress));
+		};
+		auto* dst = static_cast<uint8_t*>(aDst);
+		const auto* src = static_cast<const uint8_t*>(aSrc);
+
+		aWorkerPool.parallel_for(numChunks, [&](size_t lChunk) {
+			const auto begin = chunkBegin(lChunk);
+			const auto end = chunkBegin(lChunk + 1);
+			copy_non_temporal(dst + begin, src + begin, end - begin);
+		});
+	}
+}
@@ -23,9 +23,11 @@ namespace avk
 
 		/**	Create VmaAllocator, VmaAllocationCreateInfo, and VmaAllocation internally.
 		 *	This is only implemented for certain types via template specialization: vk::Buffer, vk::Image
+		 *	@param	aAllowedMemoryTypeBits	Restricts the memory types which may be selected, in addition to the resource's requirements.
+		 *	@param	aMemoryProperties		The physical device's memory properties, e.g. from root::capabilities(). They are queried if nullptr.
 		 */
 		template <typename C>
-		mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo);
+		mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo, uint32_t aAllowedMemoryTypeBits = ~0u, const vk::PhysicalDeviceMemoryProperties* aMemoryProperties = nullptr);
 		
 		/** Move-construct a mem_handle */
 		mem_handle(mem_handle&& aOther) noexcept : mAllocator{}, mMemoryPropertyFlags{}, mMemory{nullptr}, mResource{nullptr}
@@ -135,7 +137,7 @@ namespace avk
 	// Fail if not used with either vk::Buffer or vk::Image
 	template <typename T>
 	template <typename C>
-	mem_handle<T>::mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo)
+	mem_handle<T>::mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo, uint32_t aAllowedMemoryTypeBits, const vk::PhysicalDeviceMemoryProperties* aMemoryProperties)
 	{
 		throw avk::runtime_error(std::string("Memory allocation not implemented for type ") + typeid(T).name());
 	}
@@ -143,7 +145,7 @@ namespace avk
 	// Constructor's template specialization for vk::Buffer
 	template <>
 	template <>
-	inline mem_handle<vk::Buffer>::mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::BufferCreateInfo& aResourceCreateInfo)
+	inline mem_handle<vk::Buffer>::mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::BufferCreateInfo& aResourceCreateInfo, uint32_t aAllowedMemoryTypeBits, const vk::PhysicalDeviceMemoryProperties* aMemoryProperties)
 		: mAllocator{ aAllocator }
 	{
 		auto& physicalDevice = std::get<vk::PhysicalDevice>(mAllocator);
@@ -157,7 +159,9 @@ namespace avk
 		const auto memRequirements = device.getBufferMemoryRequirements(vkBuffer);
 
 		// Find suitable memory for this buffer:
-		auto tpl = find_memory_type_index_for_device(physicalDevice, memRequirements.memoryTypeBits, aMemPropFlags);
+		auto tpl = nullptr != aMemoryProperties
+			? find_memory_type_index_for_memory_properties(*aMemoryProperties, memRequirements.memoryTypeBits & aAllowedMemoryTypeBits, aMemPropFlags)
+			: find_memory_type_index_for_device(physicalDevice, memRequirements.memoryTypeBits & aAllowedMemoryTypeBits, aMemPropFlags);
 		// The actual memory property flags of the selected memory can be different from the minimum requested flags (which is aMemPropFlags)
 		//  => store the ACTUAL memory property flags of this buffer!
 		mMemoryPropertyFlags = std::get<vk::MemoryPropertyFlags>(tpl);
@@ -190,7 +194,7 @@ namespace avk
 	// Constructor's template specialization for vk::Image
 	template <>
 	template <>
-	inline mem_handle<vk::Image>::mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::ImageCreateInfo& aResourceCreateInfo)
+	inline mem_handle<vk::Image>::mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::ImageCreateInfo& aResourceCreateInfo, uint32_t aAllowedMemoryTypeBits, const vk::PhysicalDeviceMemoryProperties* aMemoryProperties)
 		: mAllocator{ aAllocator }
 	{
 		auto& physicalDevice = std::get<vk::PhysicalDevice>(mAllocator);
@@ -203,7 +207,9 @@ namespace avk
 		auto memRequirements = device.getImageMemoryRequirements(vkImage);
 		
 		// Find suitable memory for this image:
-		auto tpl = find_memory_type_index_for_device(physicalDevice, memRequirements.memoryTypeBits, aMemPropFlags);
+		auto tpl = nullptr != aMemoryProperties
+			? find_memory_type_index_for_memory_properties(*aMemoryProperties, memRequirements.memoryTypeBits & aAllowedMemoryTypeBits, aMemPropFlags)
+			: find_memory_type_index_for_device(physicalDevice, memRequirements.memoryTypeBits & aAllowedMemoryTypeBits, aMemPropFlags);
 		// The actual memory property flags of the selected memory can be different from the minimum requested flags (which is aMemPropFlags)
 		//  => store the ACTUAL memory property flags of this buffer!
 		mMemoryPropertyFlags = std::get<vk::MemoryPropertyFlags>(tpl);
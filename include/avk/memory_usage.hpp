@@ -22,6 +22,21 @@ namespace avk
 		device_readback,
 
 		/** Buffer's memory is accessible on the GPU only and allows protected queue operations to access the memory. */
-		device_protected
+		device_protected,
+
+		/** Image's memory is accessible on the GPU only and its contents need not outlive a renderpass instance.
+		 *	Intended for attachments which are neither loaded nor stored. Such images are created with the
+		 *	transient attachment usage flag and in lazily allocated memory, if the device supports it.
+		 *	Image usages other than color, depth/stencil, or input attachment are not allowed and cause an avk::logic_error.
+		 *	For buffers, this is equivalent to memory_usage::device.
+		 */
+		device_transient,
+
+		/** Buffer's memory is located on the GPU, but can be written to directly from the host, if the device
+		 *	offers a large host-visible device-local heap (resizable BAR). Filling such a buffer requires no
+		 *	staging buffer and no copy command. If no such heap exists, this falls back to memory_usage::device.
+		 *	For images, this is equivalent to memory_usage::device.
+		 */
+		device_host_writable
 	};
 }
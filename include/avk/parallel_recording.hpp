@@ -0,0 +1,84 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Inheritance for secondary command buffers which are executed within a subpass of a render pass.
+	 *	The primary command buffer must begin the render pass with aSubpassesInline == false.
+	 */
+	struct render_pass_inheritance
+	{
+		vk::RenderPass mRenderPass;
+		uint32_t mSubpass = 0;
+		/** Optional. If set, it must be the framebuffer which the render pass is begun with, which can improve performance. */
+		vk::Framebuffer mFramebuffer = nullptr;
+
+		static render_pass_inheritance for_framebuffer(const renderpass_t& aRenderpass, const framebuffer_t& aFramebuffer, uint32_t aSubpass = 0)
+		{
+			return render_pass_inheritance{ aRenderpass.handle(), aSubpass, aFramebuffer.handle() };
+		}
+	};
+
+	/**	Inheritance for secondary command buffers which are executed within dynamic rendering.
+	 *	The primary command buffer must begin dynamic rendering with aContentsInline == false,
+	 *	and the formats and sample count must match the attachments which dynamic rendering is begun with.
+	 */
+	struct dynamic_rendering_inheritance
+	{
+		std::vector<vk::Format> mColorAttachmentFormats;
+		vk::Format mDepthAttachmentFormat = vk::Format::eUndefined;
+		vk::Format mStencilAttachmentFormat = vk::Format::eUndefined;
+		vk::SampleCountFlagBits mRasterizationSamples = vk::SampleCountFlagBits::e1;
+		uint32_t mViewMask = 0;
+	};
+
+	/** What secondary command buffers inherit from the primary: nothing (std::monostate), a render pass, or dynamic rendering. */
+	using secondary_command_buffer_inheritance = std::variant<std::monostate, render_pass_inheritance, dynamic_rendering_inheritance>;
+
+	namespace command
+	{
+		/**	Record a list of commands into secondary command buffers on multiple threads, and execute them in order.
+		 *
+		 *	The commands are split into consecutive partitions, each of which is recorded into a secondary command buffer which
+		 *	is allocated from its own command pool. The partitions are recorded by the calling thread and the workers of the
+		 *	given worker pool concurrently, i.e. no threads are created per invocation.
+		 *	Recording happens immediately, i.e. the returned command only executes the recorded secondary command buffers.
+		 *
+		 *	Sync commands are resolved against the complete list of commands, i.e. they lead to the same barriers as if the
+		 *	list had been recorded into one command buffer, also at partition boundaries. The returned command's sync hint
+		 *	is inferred from the nested commands, like for other commands with nested commands.
+		 *
+		 *	If commands are executed within a render pass or dynamic rendering, begin and end it in the primary command buffer,
+		 *	and only pass the commands in between. The inheritance must describe the render pass or dynamic rendering.
+		 *	Pipeline barriers are not allowed within dynamic rendering, and only in special cases within render passes.
+		 *	Therefore, the commands must not contain any sync commands in that case; an avk::logic_error is thrown otherwise.
+		 *	Record the required barriers into the primary command buffer before the render pass or dynamic rendering begins.
+		 *
+		 *	Tracked image layouts (see image_t::enable_layout_tracking) must be updated in execution order. Therefore, the commands must
+		 *	neither contain barriers of images with layout tracking enabled, nor other commands which update their tracked layouts
+		 *	(see action_type_command::mUpdatesTrackedLayouts); an avk::logic_error is thrown otherwise.
+		 *
+		 *	@param	aCommandPools	One command pool per partition. Command pools must not be used concurrently, therefore every
+		 *							partition needs its own. They must belong to the queue family which the primary is submitted to.
+		 *	@param	aCommands		The commands to be recorded.
+		 *	@param	aInheritance	What the secondary command buffers inherit from the primary command buffer.
+		 *	@param	aRanges			Optional partitioning into [begin, end) ranges of aCommands, which must be consecutive and cover all of them.
+		 *							If empty, aCommands are split evenly into at most aCommandPools.size() partitions.
+		 *	@param	aWorkerPool		The threads which help the calling thread with recording.
+		 */
+		extern action_type_command parallel(
+			std::vector<std::reference_wrapper<command_pool_t>> aCommandPools,
+			std::vector<recorded_commands_t> aCommands,
+			secondary_command_buffer_inheritance aInheritance = {},
+			std::vector<std::tuple<size_t, size_t>> aRanges = {},
+			worker_pool& aWorkerPool = worker_pool::shared()
+		);
+
+		/**	Execute secondary command buffers which have been recorded before.
+		 *	The command takes care of the lifetimes of the command buffers.
+		 *	@param	aSecondaryCommandBuffers	Command buffers of level vk::CommandBufferLevel::eSecondary in finished recording state.
+		 *	@param	aSyncHint					Describes the contained commands for the sync of previous and subsequent commands.
+		 */
+		extern action_type_command execute_secondary_command_buffers(std::vector<command_buffer> aSecondaryCommandBuffers, avk::sync::sync_hint aSyncHint = {});
+	}
+}
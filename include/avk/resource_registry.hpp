@@ -0,0 +1,262 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	template <typename T>
+	class resource_registry;
+
+	/**	A 32-bit generational handle which refers to a resource stored in a resource_registry<T>.
+	 *	The lower bits store the index of the slot, the upper bits store the slot's generation.
+	 *	A handle becomes stale as soon as its resource has been released, even if the slot is reused afterwards.
+	 *	Handles are trivially copyable and can be passed around without any reference counting.
+	 */
+	template <typename T>
+	class resource_handle
+	{
+		friend class resource_registry<T>;
+
+	public:
+		static constexpr uint32_t index_bits = 20;
+		static constexpr uint32_t generation_bits = 32 - index_bits;
+		static constexpr uint32_t index_mask = (1u << index_bits) - 1u;
+		static constexpr uint32_t max_generation = (1u << generation_bits) - 1u;
+		static constexpr uint32_t invalid_value = 0xFFFFFFFFu;
+
+		/** Creates an invalid handle. */
+		resource_handle() = default;
+
+		uint32_t index() const { return mValue & index_mask; }
+		uint32_t generation() const { return mValue >> index_bits; }
+		/** The packed representation of this handle. */
+		uint32_t value() const { return mValue; }
+		/** False for default-constructed handles. Note that a valid handle may still be stale; use resource_registry::contains. */
+		bool is_valid() const { return invalid_value != mValue; }
+
+		bool operator==(const resource_handle&) const = default;
+
+	private:
+		resource_handle(uint32_t aIndex, uint32_t aGeneration)
+			: mValue{ (aGeneration << index_bits) | aIndex }
+		{}
+
+		uint32_t mValue = invalid_value;
+	};
+
+	/**	Slot-map storage for resources of type T which are referred to by resource_handle<T>.
+	 *
+	 *	Resources are stored by value in contiguous pages of slots, i.e. without a shared_ptr per resource.
+	 *	Pages are never moved, so the addresses of stored resources remain stable for their whole lifetime.
+	 *	This matters, because several Auto-Vk types keep pointers to the resources they have been created from.
+	 *	Released slots are reused; their generation is incremented, so that stale handles can be detected.
+	 *	A slot whose generation is exhausted is retired and never reused.
+	 *
+	 *	Resources can be passed wherever a resource_argument<T> is expected via operator[], which yields a reference:
+	 *		avk::copy_buffer_to_another(myBuffers[srcHandle], myBuffers[dstHandle]);
+	 *
+	 *	Insertion and release must be synchronized externally. Concurrent lookups are fine while no resources are inserted or released.
+	 */
+	template <typename T>
+	class resource_registry
+	{
+		static constexpr size_t slots_per_page = 256;
+
+		struct slot
+		{
+			std::optional<T> mResource;
+			uint32_t mGeneration = 0;
+		};
+
+	public:
+		using handle_type = resource_handle<T>;
+		static_assert(std::is_trivially_copyable_v<resource_handle<T>>);
+
+		resource_registry() = default;
+		resource_registry(resource_registry&&) noexcept = default;
+		resource_registry(const resource_registry&) = delete;
+		resource_registry& operator=(resource_registry&&) noexcept = default;
+		resource_registry& operator=(const resource_registry&) = delete;
+		~resource_registry() = default;
+
+		/**	Move a resource into the registry.
+		 *	@param	aResource	The resource to be stored.
+		 *	@return	A handle which refers to the stored resource.
+		 */
+		handle_type insert(T&& aResource)
+		{
+			uint32_t index;
+			if (!mFreeSlots.empty()) {
+				index = mFreeSlots.back();
+				mFreeSlots.pop_back();
+			}
+			else {
+				if (mNumSlots > handle_type::index_mask - 1u) { // index_mask itself would collide with invalid_value
+					throw avk::runtime_error("resource_registry<" + std::string(typeid(T).name()) + "> is out of slots.");
+				}
+				index = mNumSlots++;
+				if (index / slots_per_page == mPages.size()) {
+					mPages.push_back(std::make_unique<slot[]>(slots_per_page));
+				}
+			}
+			auto& s = slot_at(index);
+			s.mResource.emplace(std::move(aResource));
+			++mSize;
+			return handle_type{ index, s.mGeneration };
+		}
+
+		/**	Move a resource into the registry, taking it out of an owning_resource.
+		 *	If the owning_resource has shared ownership enabled, it must be its only owner.
+		 *	@param	aResource	The resource to be stored.
+		 *	@return	A handle which refers to the stored resource.
+		 */
+		handle_type insert(owning_resource<T> aResource)
+		{
+			if (!aResource.has_value()) {
+				throw avk::logic_error("Can not insert an empty owning_resource<" + std::string(typeid(T).name()) + "> into a resource_registry.");
+			}
+			if (aResource.is_shared_ownership_enabled() && std::get<std::shared_ptr<T>>(aResource).use_count() > 1) {
+				throw avk::logic_error("The owning_resource<" + std::string(typeid(T).name()) + "> is shared with other owners and can not be moved into a resource_registry.");
+			}
+			return insert(std::move(aResource.get()));
+		}
+
+		/** Returns true if the given handle refers to a resource which has not been released yet. */
+		bool contains(handle_type aHandle) const
+		{
+			if (!aHandle.is_valid() || aHandle.index() >= mNumSlots) {
+				return false;
+			}
+			const auto& s = slot_at(aHandle.index());
+			return s.mGeneration == aHandle.generation() && s.mResource.has_value();
+		}
+
+		/** Gets a pointer to the resource referred to by the given handle, or nullptr if the handle is stale. */
+		T* try_get(handle_type aHandle)
+		{
+			return contains(aHandle) ? &*slot_at(aHandle.index()).mResource : nullptr;
+		}
+
+		/** Gets a pointer to the resource referred to by the given handle, or nullptr if the handle is stale. */
+		const T* try_get(handle_type aHandle) const
+		{
+			return contains(aHandle) ? &*slot_at(aHandle.index()).mResource : nullptr;
+		}
+
+		/** Gets the resource referred to by the given handle. Throws if the handle is stale. */
+		T& get(handle_type aHandle)
+		{
+			auto* result = try_get(aHandle);
+			if (nullptr == result) {
+				throw avk::logic_error("Stale or invalid resource_handle<" + std::string(typeid(T).name()) + "> with value " + std::to_string(aHandle.value()) + ".");
+			}
+			return *result;
+		}
+
+		/** Gets the resource referred to by the given handle. Throws if the handle is stale. */
+		const T& get(handle_type aHandle) const
+		{
+			return const_cast<resource_registry*>(this)->get(aHandle);
+		}
+
+		/** Gets the resource referred to by the given handle. The handle must not be stale. */
+		T& operator[](handle_type aHandle)
+		{
+			assert(contains(aHandle));
+			return *slot_at(aHandle.index()).mResource;
+		}
+
+		/** Gets the resource referred to by the given handle. The handle must not be stale. */
+		const T& operator[](handle_type aHandle) const
+		{
+			assert(contains(aHandle));
+			return *slot_at(aHandle.index()).mResource;
+		}
+
+		/**	Remove the resource from the registry and return it. The handle becomes stale.
+		 *	@param	aHandle		Handle to a resource which has not been released yet.
+		 */
+		T take(handle_type aHandle)
+		{
+			T result = std::move(get(aHandle));
+			free_slot(aHandle.index());
+			return result;
+		}
+
+		/**	Destroy the resource immediately. The handle becomes stale.
+		 *	The device must not use the resource anymore.
+		 */
+		void release(handle_type aHandle)
+		{
+			get(aHandle); // Validates the handle
+			free_slot(aHandle.index());
+		}
+
+		/**	Hand the resource over to a deferred destruction queue. The handle becomes stale immediately,
+		 *	but the resource is only destroyed after the queue has passed the given retire value.
+		 *	@param	aHandle			Handle to a resource which has not been released yet.
+		 *	@param	aQueue			The queue which takes ownership of the resource.
+		 *	@param	aRetireValue	The value which the device must have passed before the resource may be destroyed.
+		 */
+		void release_deferred(handle_type aHandle, deferred_destruction_queue& aQueue, uint64_t aRetireValue)
+		{
+			aQueue.enqueue(aRetireValue, take(aHandle));
+		}
+
+		/**	Hand the resource over to a deferred destruction queue, using the queue's current retire value.
+		 *	@param	aHandle			Handle to a resource which has not been released yet.
+		 *	@param	aQueue			The queue which takes ownership of the resource.
+		 */
+		void release_deferred(handle_type aHandle, deferred_destruction_queue& aQueue)
+		{
+			release_deferred(aHandle, aQueue, aQueue.current_retire_value());
+		}
+
+		/** Invoke the given function for each stored resource, passing its handle and a reference to it. */
+		template <typename F>
+		void for_each(F&& aFunction)
+		{
+			for (uint32_t i = 0; i < mNumSlots; ++i) {
+				auto& s = slot_at(i);
+				if (s.mResource.has_value()) {
+					aFunction(handle_type{ i, s.mGeneration }, *s.mResource);
+				}
+			}
+		}
+
+		/** The number of stored resources. */
+		size_t size() const { return mSize; }
+		/** Returns true if no resources are stored. */
+		bool empty() const { return 0 == mSize; }
+
+		/** Destroy all stored resources. All handles become stale. */
+		void clear()
+		{
+			for (uint32_t i = 0; i < mNumSlots; ++i) {
+				if (slot_at(i).mResource.has_value()) {
+					free_slot(i);
+				}
+			}
+		}
+
+	private:
+		slot& slot_at(uint32_t aIndex) { return mPages[aIndex / slots_per_page][aIndex % slots_per_page]; }
+		const slot& slot_at(uint32_t aIndex) const { return mPages[aIndex / slots_per_page][aIndex % slots_per_page]; }
+
+		void free_slot(uint32_t aIndex)
+		{
+			auto& s = slot_at(aIndex);
+			s.mResource.reset();
+			--mSize;
+			if (s.mGeneration < handle_type::max_generation) {
+				++s.mGeneration;
+				mFreeSlots.push_back(aIndex);
+			}
+			// else: Retire the slot, s.t. stale handles can never refer to a new resource.
+		}
+
+		std::vector<std::unique_ptr<slot[]>> mPages;
+		std::vector<uint32_t> mFreeSlots;
+		uint32_t mNumSlots = 0;
+		size_t mSize = 0;
+	};
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Tracks the access state of buffers and images across recorded commands and submissions, and
+	 *	inserts the barriers which are required between these accesses automatically.
+	 *
+	 *	This is an opt-in alternative to placing sync::buffer_memory_barrier and sync::image_memory_barrier
+	 *	commands manually. Action commands declare the resources which they access via their
+	 *	mResourceSpecificSyncHints: mDstForPreviousCmds and mSrcForSubsequentCmds state the stages and
+	 *	accesses at which a command starts and ends accessing a resource, respectively. An access is a write
+	 *	if its access flags contain any write access. If one of them is not set, all stages and all accesses
+	 *	are assumed for it.
+	 *
+	 *	insert_barriers inserts exactly the barriers which are required to resolve read-after-write,
+	 *	write-after-write, and write-after-read hazards w.r.t. the tracked state:
+	 *	 - A read waits for the last write, unless the write has already been made visible to it.
+	 *	 - A write waits for the last write and for all reads since then, where an execution dependency
+	 *	   suffices for the latter.
+	 *
+	 *	Example:
+	 *		avk::resource_state_tracker tracker;
+	 *		myRoot.record(tracker.insert_barriers({
+	 *			avk::copy_buffer_to_another(avk::referenced(myStagingBuffer), avk::referenced(myStorageBuffer)),
+	 *			myComputeCommandWhichDeclaresReadingMyStorageBuffer
+	 *		}))...
+	 *
+	 *	Resources accessed by nested commands are attributed to the enclosing top-level action command,
+	 *	i.e. barriers are only inserted between top-level commands, never within, e.g., a renderpass.
+	 *	Top-level sync commands among the given commands are left as they are, but their effects are folded into the
+	 *	tracked state, s.t. no second barrier is inserted for a hazard which a manual barrier resolves already. Only
+	 *	sync commands with fixed stages and accesses are regarded (i.e., no avk::stage::auto_stage or avk::access::auto_access),
+	 *	and only if they cover complete buffers or images and do not transfer queue family ownership.
+	 *	The tracked state persists across invocations, assuming that the resulting commands are submitted
+	 *	to one single queue in the order of the invocations.
+	 *
+	 *	Accesses to images which have been passed to register_image are synchronized with image memory barriers. If layout
+	 *	tracking is enabled for such an image (see image_t::enable_layout_tracking), these barriers use and update its tracked
+	 *	state. Accesses to all other images are synchronized with global memory barriers. No layout transitions are inserted,
+	 *	because sync hints do not state which layouts the commands require; place them manually.
+	 */
+	class resource_state_tracker
+	{
+		struct access_state
+		{
+			// Stages and accesses of the last write, which subsequent accesses must wait for:
+			vk::PipelineStageFlags2KHR mWriteStages = vk::PipelineStageFlagBits2KHR::eNone;
+			vk::AccessFlags2KHR mWriteAccess = vk::AccessFlagBits2KHR::eNone;
+			// Stages and accesses to which the last write has been made visible already:
+			vk::PipelineStageFlags2KHR mVisibleStages = vk::PipelineStageFlagBits2KHR::eNone;
+			vk::AccessFlags2KHR mVisibleAccess = vk::AccessFlagBits2KHR::eNone;
+			// Stages of the reads since the last write, which a subsequent write must wait for:
+			vk::PipelineStageFlags2KHR mReadStages = vk::PipelineStageFlagBits2KHR::eNone;
+			// Stages of reads since the last write, which a barrier has ordered before mReadsOrderedBeforeStages already:
+			vk::PipelineStageFlags2KHR mOrderedReadStages = vk::PipelineStageFlagBits2KHR::eNone;
+			vk::PipelineStageFlags2KHR mReadsOrderedBeforeStages = vk::PipelineStageFlagBits2KHR::eNone;
+		};
+
+	public:
+		/**	Insert the barriers which are required by the resource accesses declared by the given commands,
+		 *	and update the tracked state accordingly.
+		 *	@param	aRecordedCommandsAndSyncInstructions	Commands, whose action commands declare resource accesses via mResourceSpecificSyncHints.
+		 *	@return	The given commands with a barrier inserted before each action command which requires one.
+		 */
+		std::vector<recorded_commands_t> insert_barriers(std::vector<recorded_commands_t> aRecordedCommandsAndSyncInstructions);
+
+		/**	Synchronize accesses to the given image with image memory barriers instead of global memory barriers.
+		 *	If layout tracking is enabled for the image, the inserted barriers use and update its tracked state.
+		 *	The image must stay alive until it is forgotten (see forget) or until the tracker is cleared.
+		 */
+		void register_image(const image_t& aImage);
+
+		/** Stop tracking the given buffer, e.g., when it is destroyed. */
+		void forget(vk::Buffer aBuffer) { mBufferStates.erase(static_cast<VkBuffer>(aBuffer)); }
+		/** Stop tracking the given image, e.g., when it is destroyed. This also revokes register_image. */
+		void forget(vk::Image aImage) { mImageStates.erase(static_cast<VkImage>(aImage)); mRegisteredImages.erase(static_cast<VkImage>(aImage)); }
+		/** Stop tracking all resources. Only do this if all tracked writes are known to be visible, e.g., after waiting for the device to become idle. */
+		void clear() { mBufferStates.clear(); mImageStates.clear(); mRegisteredImages.clear(); }
+
+		/** The number of buffers and images whose state is being tracked. */
+		size_t number_of_tracked_resources() const { return mBufferStates.size() + mImageStates.size(); }
+		/** The number of barriers which have been inserted since this tracker has been created. */
+		size_t number_of_inserted_barriers() const { return mNumInsertedBarriers; }
+
+	private:
+		/**	Determine the barrier which is required before an access to a resource in the given state, and update the state.
+		 *	@return	Source and destination stages and accesses of the required barrier, or no value if none is required.
+		 */
+		static std::optional<std::tuple<stage_and_access_precisely, stage_and_access_precisely>> register_access(access_state& aState, vk::PipelineStageFlags2KHR aStages, vk::AccessFlags2KHR aAccess);
+
+		/** Update the given state with the effects of a barrier with the given source and destination scopes, which has been placed manually. */
+		static void register_barrier(access_state& aState, const stage_and_access_precisely& aSrc, const stage_and_access_precisely& aDst, bool aHasLayoutTransition);
+
+		/** Fold the effects of the given sync command into the tracked state, see the class description for which ones are regarded. */
+		void register_sync_command(const sync::sync_type_command& aSyncCmd);
+
+		std::unordered_map<VkBuffer, access_state> mBufferStates;
+		std::unordered_map<VkImage, access_state> mImageStates;
+		std::unordered_map<VkImage, const image_t*> mRegisteredImages;
+		size_t mNumInsertedBarriers = 0;
+	};
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "avk/avk.hpp"
+
+/** CONFIG SETTING: AVK_SCATTER_UPLOAD_MIN_PATCHES_FOR_COMPUTE
+ *
+ *	command::scatter_upload only applies the patches with its compute shader if there are at
+ *	least this many patches. Fewer patches are transferred with one vk::BufferCopy region each.
+ */
+#if !defined(AVK_SCATTER_UPLOAD_MIN_PATCHES_FOR_COMPUTE)
+#define AVK_SCATTER_UPLOAD_MIN_PATCHES_FOR_COMPUTE 256
+#endif
+
+/** CONFIG SETTING: AVK_SCATTER_UPLOAD_MAX_AVERAGE_PATCH_SIZE_FOR_COMPUTE
+ *
+ *	command::scatter_upload only applies the patches with its compute shader if their average
+ *	size in bytes does not exceed this value. Larger patches are transferred faster by copy commands.
+ */
+#if !defined(AVK_SCATTER_UPLOAD_MAX_AVERAGE_PATCH_SIZE_FOR_COMPUTE)
+#define AVK_SCATTER_UPLOAD_MAX_AVERAGE_PATCH_SIZE_FOR_COMPUTE 1024
+#endif
+
+namespace avk
+{
+	/**	One patch of a scatter upload: mSize bytes, read from mData, are written to mOffset in the target buffer.
+	 *	The data is copied into staging memory when the command is created, i.e. mData must only be valid until then.
+	 */
+	struct scatter_patch
+	{
+		vk::DeviceSize mOffset;
+		vk::DeviceSize mSize;
+		const void* mData;
+	};
+
+	/**	The built-in compute pipeline which command::scatter_upload uses in order to apply many small patches at once.
+	 *	It accesses the staging memory and the target buffer via buffer device addresses and does not need any descriptors.
+	 *	Requires the bufferDeviceAddress device feature and a device which supports SPIR-V 1.5 (Vulkan 1.2).
+	 */
+	class scatter_upload_pipeline_t
+	{
+		friend class root;
+	public:
+		scatter_upload_pipeline_t() = default;
+		scatter_upload_pipeline_t(scatter_upload_pipeline_t&&) noexcept = default;
+		scatter_upload_pipeline_t(const scatter_upload_pipeline_t&) = delete;
+		scatter_upload_pipeline_t& operator=(scatter_upload_pipeline_t&&) noexcept = default;
+		scatter_upload_pipeline_t& operator=(const scatter_upload_pipeline_t&) = delete;
+		~scatter_upload_pipeline_t() = default;
+
+		const auto& layout_handle() const { return mPipelineLayout.get(); }
+		auto handle() const { return mPipeline.get(); }
+
+	private:
+		vk::UniqueHandle<vk::PipelineLayout, DISPATCH_LOADER_CORE_TYPE> mPipelineLayout;
+		vk::UniqueHandle<vk::Pipeline,       DISPATCH_LOADER_CORE_TYPE> mPipeline;
+	};
+
+	using scatter_upload_pipeline = avk::owning_resource<scatter_upload_pipeline_t>;
+
+	namespace command
+	{
+		/**	Write many (small) patches into a buffer, using one vk::BufferCopy region per patch.
+		 *	The patches' data is packed into a staging buffer, and patches which are adjacent in the target buffer are merged.
+		 *	@param	aTargetBuffer	The buffer to be patched. Its lifetime must be handled by the user.
+		 *	@param	aPatches		The patches to be applied, in order. Patches must not overlap.
+		 */
+		extern action_type_command scatter_upload(const buffer_t& aTargetBuffer, const std::vector<scatter_patch>& aPatches);
+
+		/**	Write many (small) patches into a buffer, choosing the cheaper method automatically:
+		 *	Many small patches are applied by a single dispatch of the built-in compute shader,
+		 *	other cases are handled via a multi-region copy like the overload without pipeline.
+		 *	The compute shader is only used if the target buffer has a device address, and if all offsets and sizes are multiples of 4.
+		 *	See AVK_SCATTER_UPLOAD_MIN_PATCHES_FOR_COMPUTE and AVK_SCATTER_UPLOAD_MAX_AVERAGE_PATCH_SIZE_FOR_COMPUTE.
+		 *	ATTENTION: The compute path binds the scatter upload pipeline. Bind your own compute pipeline again before dispatching afterwards.
+		 *	@param	aPipeline		A pipeline created via root::create_scatter_upload_pipeline. It must outlive the command's execution.
+		 *	@param	aTargetBuffer	The buffer to be patched. Its lifetime must be handled by the user.
+		 *	@param	aPatches		The patches to be applied, in order. Patches must not overlap.
+		 */
+		extern action_type_command scatter_upload(const scatter_upload_pipeline_t& aPipeline, const buffer_t& aTargetBuffer, const std::vector<scatter_patch>& aPatches);
+	}
+}
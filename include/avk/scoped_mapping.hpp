@@ -49,12 +49,16 @@ namespace avk
 		
 		scoped_mapping& operator=(scoped_mapping&& aOther) noexcept
 		{
+			if (nullptr != mMemHandle) {
+				mMemHandle->unmap_memory(mAccess);
+			}
 			mMemHandle = aOther.mMemHandle;
 			mAccess = aOther.mAccess;
 			mMappedMemory = aOther.mMappedMemory;
 			
 			aOther.mMemHandle = nullptr;
 			aOther.mMappedMemory = nullptr;
+			return *this;
 		}
 
 		/**	Get the memory address of the mapped memory.
@@ -16,6 +16,11 @@ namespace avk
 	 *				 but can also have additional memory property flags set.
 	 */
 	extern std::tuple<uint32_t, vk::MemoryPropertyFlags> find_memory_type_index_for_device(const vk::PhysicalDevice& aPhysicalDevice, uint32_t aMemoryTypeBits, vk::MemoryPropertyFlags aMemoryProperties);
+
+	/** Find (index of) memory with parameters among the given, already queried memory properties.
+	 *	Same as find_memory_type_index_for_device, but without querying the physical device. See root::capabilities().
+	 */
+	extern std::tuple<uint32_t, vk::MemoryPropertyFlags> find_memory_type_index_for_memory_properties(const vk::PhysicalDeviceMemoryProperties& aDeviceMemoryProperties, uint32_t aMemoryTypeBits, vk::MemoryPropertyFlags aMemoryProperties);
 	
 	
 	/** Returns true if the given image format is a sRGB format
@@ -25,9 +25,11 @@ namespace avk
 
 		/**	Create VmaAllocator, VmaAllocationCreateInfo, and VmaAllocation internally.
 		 *	This is only implemented for certain types via template specialization: vk::Buffer, vk::Image
+		 *	@param	aAllowedMemoryTypeBits	Restricts the memory types which may be selected, in addition to the resource's requirements.
+		 *	@param	aMemoryProperties		Not used, since the VmaAllocator keeps the memory properties itself.
 		 */
 		template <typename C>
-		vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo);
+		vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo, uint32_t aAllowedMemoryTypeBits = ~0u, const vk::PhysicalDeviceMemoryProperties* aMemoryProperties = nullptr);
 		
 		/** Move-construct a vma_handle */
 		vma_handle(vma_handle&& aOther) noexcept : mAllocator{nullptr}, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}, mResource{nullptr}
@@ -147,7 +149,7 @@ namespace avk
 	// Fail if not used with either vk::Buffer or vk::Image
 	template <typename T>
 	template <typename C>
-	vma_handle<T>::vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo)
+	vma_handle<T>::vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo, uint32_t aAllowedMemoryTypeBits, const vk::PhysicalDeviceMemoryProperties* aMemoryProperties)
 	{
 		throw avk::runtime_error(std::string("VMA allocation not implemented for type ") + typeid(T).name());
 	}
@@ -155,12 +157,13 @@ namespace avk
 	// Constructor's template specialization for vk::Buffer
 	template <>
 	template <>
-	inline vma_handle<vk::Buffer>::vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::BufferCreateInfo& aResourceCreateInfo)
+	inline vma_handle<vk::Buffer>::vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::BufferCreateInfo& aResourceCreateInfo, uint32_t aAllowedMemoryTypeBits, const vk::PhysicalDeviceMemoryProperties*)
 		: mAllocator{ aAllocator }
 		, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}
 	{
 		mCreateInfo.requiredFlags = static_cast<VkMemoryPropertyFlags>(aMemPropFlags);
 		mCreateInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
+		mCreateInfo.memoryTypeBits = aAllowedMemoryTypeBits;
 
 		VkBuffer buffer;
 		auto result = vmaCreateBuffer(aAllocator, &static_cast<const VkBufferCreateInfo&>(aResourceCreateInfo), &mCreateInfo, &buffer, &mAllocation, &mAllocationInfo);
@@ -171,12 +174,13 @@ namespace avk
 	// Constructor's template specialization for vk::Image
 	template <>
 	template <>
-	inline vma_handle<vk::Image>::vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::ImageCreateInfo& aResourceCreateInfo)
+	inline vma_handle<vk::Image>::vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::ImageCreateInfo& aResourceCreateInfo, uint32_t aAllowedMemoryTypeBits, const vk::PhysicalDeviceMemoryProperties*)
 		: mAllocator{ aAllocator }
 		, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}
 	{
 		mCreateInfo.requiredFlags = static_cast<VkMemoryPropertyFlags>(aMemPropFlags);
 		mCreateInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
+		mCreateInfo.memoryTypeBits = aAllowedMemoryTypeBits;
 
 		VkImage image;
 		auto result = vmaCreateImage(aAllocator, &static_cast<const VkImageCreateInfo&>(aResourceCreateInfo), &mCreateInfo, &image, &mAllocation, &mAllocationInfo);
@@ -0,0 +1,176 @@
+#pragma once
+// This header does not depend on Vulkan and can be included on its own.
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace avk
+{
+	/**	A fixed set of worker threads which execute the iterations of parallel loops.
+	 *
+	 *	The threads are created once, when the pool is constructed, and are reused by all parallel loops
+	 *	instead of spawning new threads for every loop. The thread which invokes parallel_for takes part
+	 *	in the loop, i.e. a pool without any workers executes all iterations on the calling thread.
+	 *	parallel_for may be invoked from multiple threads concurrently, and also from within an iteration
+	 *	of another parallel_for of the same pool.
+	 */
+	class worker_pool
+	{
+		// The state of one invocation of parallel_for, which is shared with the workers that help with it:
+		struct loop
+		{
+			const std::function<void(size_t)>* mBody;
+			size_t mCount;
+			std::atomic<size_t> mNext{ 0 };
+			std::vector<std::exception_ptr> mExceptions;
+			std::mutex mMutex;
+			std::condition_variable mCondition;
+			uint32_t mActiveHelpers = 0;
+			// Once closed, helpers which have not started yet must not touch mBody anymore:
+			bool mClosed = false;
+
+			void run()
+			{
+				for (auto i = mNext.fetch_add(1); i < mCount; i = mNext.fetch_add(1)) {
+					try {
+						(*mBody)(i);
+					}
+					catch (...) {
+						mExceptions[i] = std::current_exception();
+					}
+				}
+			}
+		};
+
+	public:
+		/**	Create a pool with the given number of worker threads.
+		 *	@param	aNumWorkers		Number of threads in addition to the threads which invoke parallel_for. Can be 0.
+		 */
+		explicit worker_pool(uint32_t aNumWorkers)
+		{
+			mWorkers.reserve(aNumWorkers);
+			for (uint32_t i = 0; i < aNumWorkers; ++i) {
+				mWorkers.emplace_back([this]() { work(); });
+			}
+		}
+
+		worker_pool(worker_pool&&) = delete;
+		worker_pool(const worker_pool&) = delete;
+		worker_pool& operator=(worker_pool&&) = delete;
+		worker_pool& operator=(const worker_pool&) = delete;
+
+		~worker_pool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				mStop = true;
+			}
+			mCondition.notify_all();
+			for (auto& w : mWorkers) {
+				w.join();
+			}
+		}
+
+		/** The number of worker threads, excluding the threads which invoke parallel_for. */
+		size_t number_of_workers() const { return mWorkers.size(); }
+
+		/**	Invoke aBody for every index in [0, aCount) on the calling thread and on up to aMaxHelpers idle workers,
+		 *	and return once all iterations have completed. The order in which the iterations run is unspecified.
+		 *	If iterations throw, the exception of the failed iteration with the lowest index is rethrown after all
+		 *	iterations have completed.
+		 *	@param	aCount			The number of iterations
+		 *	@param	aBody			Function with the signature void(size_t aIndex)
+		 *	@param	aMaxHelpers		The maximum number of workers which help the calling thread
+		 */
+		void parallel_for(size_t aCount, const std::function<void(size_t)>& aBody, size_t aMaxHelpers = SIZE_MAX)
+		{
+			if (0 == aCount) {
+				return;
+			}
+			auto l = std::make_shared<loop>();
+			l->mBody = &aBody;
+			l->mCount = aCount;
+			l->mExceptions.resize(aCount);
+
+			const auto numHelpers = std::min({ aCount - 1, mWorkers.size(), aMaxHelpers });
+			if (numHelpers > 0) {
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					for (size_t i = 0; i < numHelpers; ++i) {
+						mJobs.emplace_back([l]() {
+							{
+								std::lock_guard<std::mutex> lock(l->mMutex);
+								if (l->mClosed) {
+									return;
+								}
+								++l->mActiveHelpers;
+							}
+							l->run();
+							{
+								std::lock_guard<std::mutex> lock(l->mMutex);
+								--l->mActiveHelpers;
+							}
+							l->mCondition.notify_all();
+						});
+					}
+				}
+				mCondition.notify_all();
+			}
+
+			l->run();
+
+			// Only wait for helpers which have started already, s.t. nested loops can not deadlock
+			// while waiting for helpers which are queued behind them:
+			{
+				std::unique_lock<std::mutex> lock(l->mMutex);
+				l->mClosed = true;
+				l->mCondition.wait(lock, [&l]() { return 0 == l->mActiveHelpers; });
+			}
+			for (auto& e : l->mExceptions) {
+				if (e) {
+					std::rethrow_exception(e);
+				}
+			}
+		}
+
+		/** Gets a pool which is shared by the whole application, with one worker less than there are hardware threads. */
+		static worker_pool& shared()
+		{
+			static worker_pool sSharedPool{ std::max(1u, std::thread::hardware_concurrency()) - 1u };
+			return sSharedPool;
+		}
+
+	private:
+		void work()
+		{
+			for (;;) {
+				std::function<void()> job;
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+					mCondition.wait(lock, [this]() { return mStop || !mJobs.empty(); });
+					if (mJobs.empty()) {
+						return;
+					}
+					job = std::move(mJobs.front());
+					mJobs.pop_front();
+				}
+				job();
+			}
+		}
+
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::deque<std::function<void()>> mJobs;
+		bool mStop = false;
+		std::vector<std::thread> mWorkers;
+	};
+}
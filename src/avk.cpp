@@ -22,14 +22,32 @@ namespace avk
 		print_available_memory_types_for_device(physical_device());
 	}
 
-	std::tuple<uint32_t, vk::MemoryPropertyFlags> root::find_memory_type_index(uint32_t aMemoryTypeBits, vk::MemoryPropertyFlags aMemoryProperties)
+	std::tuple<uint32_t, vk::MemoryPropertyFlags> root::find_memory_type_index(uint32_t aMemoryTypeBits, vk::MemoryPropertyFlags aMemoryProperties) const
 	{
-		return find_memory_type_index_for_device(physical_device(), aMemoryTypeBits, aMemoryProperties);
+		return find_memory_type_index_for_memory_properties(capabilities().memory_properties(), aMemoryTypeBits, aMemoryProperties);
 	}
 
-	bool root::is_format_supported(vk::Format pFormat, vk::ImageTiling pTiling, vk::FormatFeatureFlags aFormatFeatures)
+	bool root::is_memory_type_supported(vk::MemoryPropertyFlags aMemoryProperties, vk::DeviceSize aMinHeapSize) const
 	{
-		auto formatProps = physical_device().getFormatProperties(pFormat);
+		return 0u != supported_memory_type_bits(aMemoryProperties, aMinHeapSize);
+	}
+
+	uint32_t root::supported_memory_type_bits(vk::MemoryPropertyFlags aMemoryProperties, vk::DeviceSize aMinHeapSize) const
+	{
+		const auto& memProperties = capabilities().memory_properties();
+		uint32_t result = 0u;
+		for (auto i = 0u; i < memProperties.memoryTypeCount; ++i) {
+			if ((memProperties.memoryTypes[i].propertyFlags & aMemoryProperties) == aMemoryProperties
+				&& memProperties.memoryHeaps[memProperties.memoryTypes[i].heapIndex].size >= aMinHeapSize) {
+				result |= 1u << i;
+			}
+		}
+		return result;
+	}
+
+	bool root::is_format_supported(vk::Format pFormat, vk::ImageTiling pTiling, vk::FormatFeatureFlags aFormatFeatures) const
+	{
+		const auto formatProps = capabilities().format_properties(pFormat);
 		if (pTiling == vk::ImageTiling::eLinear
 			&& (formatProps.linearTilingFeatures & aFormatFeatures) == aFormatFeatures) {
 			return true;
@@ -43,22 +61,14 @@ namespace avk
 
 #if VK_HEADER_VERSION >= 135
 #if VK_HEADER_VERSION >= 162
-	vk::PhysicalDeviceRayTracingPipelinePropertiesKHR root::get_ray_tracing_properties()
+	vk::PhysicalDeviceRayTracingPipelinePropertiesKHR root::get_ray_tracing_properties() const
 	{
-		vk::PhysicalDeviceRayTracingPipelinePropertiesKHR rtProps;
-		vk::PhysicalDeviceProperties2 props2;
-		props2.pNext = &rtProps;
-		physical_device().getProperties2(&props2);
-		return rtProps;
+		return capabilities().ray_tracing_properties();
 	}
 #else
-	vk::PhysicalDeviceRayTracingPropertiesKHR root::get_ray_tracing_properties()
+	vk::PhysicalDeviceRayTracingPropertiesKHR root::get_ray_tracing_properties() const
 	{
-		vk::PhysicalDeviceRayTracingPropertiesKHR rtProps;
-		vk::PhysicalDeviceProperties2 props2;
-		props2.pNext = &rtProps;
-		physical_device().getProperties2(&props2);
-		return rtProps;
+		return capabilities().ray_tracing_properties();
 	}
 #endif
 
@@ -80,13 +90,13 @@ namespace avk
 	}
 #endif
 
-	void root::finish_configuration(buffer_view_t& aBufferViewToBeFinished, vk::Format aViewFormat, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation)
+	void root::finish_configuration(buffer_view_t& aBufferViewToBeFinished, vk::Format aViewFormat, vk::DeviceSize aOffset, vk::DeviceSize aRange, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation)
 	{
 		aBufferViewToBeFinished.mCreateInfo = vk::BufferViewCreateInfo{}
 			.setBuffer(aBufferViewToBeFinished.buffer_handle())
 			.setFormat(aViewFormat)
-			.setOffset(0) // TODO: Support offsets
-			.setRange(VK_WHOLE_SIZE); // TODO: Support ranges
+			.setOffset(aOffset)
+			.setRange(aRange);
 
 		// Maybe alter the config?!
 		if (aAlterConfigBeforeCreation) {
@@ -176,11 +186,14 @@ namespace avk
 		// when VRAM runs out. The different types of memory exist within these heaps. Right now we'll
 		// only concern ourselves with the type of memory and not the heap it comes from, but you can
 		// imagine that this can affect performance. (Source: https://vulkan-tutorial.com/)
-		auto memProperties = aPhysicalDevice.getMemoryProperties();
+		return find_memory_type_index_for_memory_properties(aPhysicalDevice.getMemoryProperties(), aMemoryTypeBits, aMemoryProperties);
+	}
 
-		for (auto i = 0u; i < memProperties.memoryTypeCount; ++i) {
-			if ((aMemoryTypeBits & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & aMemoryProperties) == aMemoryProperties) {
-				return std::make_tuple(i, memProperties.memoryTypes[i].propertyFlags);
+	std::tuple<uint32_t, vk::MemoryPropertyFlags> find_memory_type_index_for_memory_properties(const vk::PhysicalDeviceMemoryProperties& aDeviceMemoryProperties, uint32_t aMemoryTypeBits, vk::MemoryPropertyFlags aMemoryProperties)
+	{
+		for (auto i = 0u; i < aDeviceMemoryProperties.memoryTypeCount; ++i) {
+			if ((aMemoryTypeBits & (1 << i)) && (aDeviceMemoryProperties.memoryTypes[i].propertyFlags & aMemoryProperties) == aMemoryProperties) {
+				return std::make_tuple(i, aDeviceMemoryProperties.memoryTypes[i].propertyFlags);
 			}
 		}
 		throw avk::runtime_error("failed to find suitable memory type!");
@@ -2218,6 +2231,534 @@ namespace avk
 #endif
 #pragma endregion
 
+#pragma region aliasing heap definitions
+	aliased_resource_id aliasing_heap_t::declare_image(uint32_t aWidth, uint32_t aHeight, std::tuple<vk::Format, vk::SampleCountFlagBits> aFormatAndSamples, lifetime_interval aLifetime, int aNumLayers, avk::image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+	{
+		if (is_allocated()) {
+			throw avk::logic_error("No more resources can be declared after an aliasing heap has been allocated.");
+		}
+		assert(aLifetime.mFirstUse <= aLifetime.mLastUse);
+
+		auto [result, memoryPropFlags] = mRoot->configure_image(aWidth, aHeight, aFormatAndSamples, aNumLayers, memory_usage::device, aImageUsage, std::move(aAlterConfigBeforeCreation));
+		// Images which share memory with other images must not assume any previous contents:
+		result.mCreateInfo.setInitialLayout(vk::ImageLayout::eUndefined);
+		mImageHandles.push_back(mRoot->device().createImageUnique(result.mCreateInfo, nullptr, mRoot->dispatch_loader_core()));
+		result.mImage = mImageHandles.back().get();
+
+		const auto requirements = mRoot->device().getImageMemoryRequirements(mImageHandles.back().get(), mRoot->dispatch_loader_core());
+		mResources.push_back(declared_resource{ std::move(result), aLifetime, requirements, 0, false });
+		return static_cast<aliased_resource_id>(mResources.size() - 1);
+	}
+
+	aliased_resource_id aliasing_heap_t::declare_buffer(
+		lifetime_interval aLifetime,
+#if VK_HEADER_VERSION >= 135
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#else
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#endif
+		vk::BufferUsageFlags aBufferUsage
+	)
+	{
+		if (is_allocated()) {
+			throw avk::logic_error("No more resources can be declared after an aliasing heap has been allocated.");
+		}
+		assert(aMetaData.size() > 0);
+		assert(aLifetime.mFirstUse <= aLifetime.mLastUse);
+
+		buffer_t result;
+		result.mMetaData = std::move(aMetaData);
+		result.mCreateInfo = vk::BufferCreateInfo{}
+			.setSize(static_cast<vk::DeviceSize>(result.meta_at_index<buffer_meta>(0).total_size()))
+			.setUsage(aBufferUsage)
+			.setSharingMode(vk::SharingMode::eExclusive);
+		result.mBufferUsageFlags = aBufferUsage;
+		result.mRoot = mRoot;
+
+		auto vkBuffer = mRoot->device().createBuffer(result.mCreateInfo, nullptr, mRoot->dispatch_loader_core());
+		// The buffer_t takes care of destroying the buffer handle, the memory is owned by the heap:
+#if defined(AVK_USES_VMA)
+		result.mBuffer.mAllocator = mRoot->memory_allocator();
+		result.mBuffer.mResource = vkBuffer;
+#else
+		result.mBuffer = AVK_MEM_BUFFER_HANDLE{ mRoot->memory_allocator(), vkBuffer };
+#endif
+
+		const auto requirements = mRoot->device().getBufferMemoryRequirements(vkBuffer, mRoot->dispatch_loader_core());
+		mResources.push_back(declared_resource{ std::move(result), aLifetime, requirements, 0, false });
+		return static_cast<aliased_resource_id>(mResources.size() - 1);
+	}
+
+	void aliasing_heap_t::allocate()
+	{
+		if (is_allocated()) {
+			throw avk::logic_error("The aliasing heap has already been allocated.");
+		}
+		if (mResources.empty()) {
+			return;
+		}
+
+		// All resources must be able to live in the same memory type:
+		uint32_t memoryTypeBits = ~0u;
+		bool hasImages = false, hasBuffers = false, needsDeviceAddress = false;
+		for (const auto& r : mResources) {
+			memoryTypeBits &= r.mRequirements.memoryTypeBits;
+			if (std::holds_alternative<image_t>(r.mResource)) {
+				hasImages = true;
+			}
+			else {
+				hasBuffers = true;
+				const auto usage = std::get<buffer_t>(r.mResource).usage_flags();
+				needsDeviceAddress = needsDeviceAddress || avk::has_flag(usage, vk::BufferUsageFlagBits::eShaderDeviceAddress);
+			}
+		}
+		if (0u == memoryTypeBits) {
+			throw avk::runtime_error("The resources declared in the aliasing heap can not share one memory type. Distribute them across multiple aliasing heaps.");
+		}
+
+		// Linear resources (buffers) and optimal-tiling images must be kept bufferImageGranularity apart:
+		vk::DeviceSize granularity = 1;
+		if (hasImages && hasBuffers) {
+			granularity = mRoot->capabilities().limits().bufferImageGranularity;
+		}
+
+		// Interval graph coloring: Process the resources in the order of their first use, and assign each one
+		// to a free memory range (color) whose previous occupants' lifetimes have already ended, preferring the
+		// smallest range which fits. If none fits, grow the largest free range. If none is free, add a new range.
+		struct memory_range
+		{
+			vk::DeviceSize mSize;
+			vk::DeviceSize mAlignment;
+			uint32_t mBusyUntil;
+			std::vector<size_t> mOccupants;
+		};
+		std::vector<memory_range> ranges;
+
+		std::vector<size_t> order(mResources.size());
+		std::iota(std::begin(order), std::end(order), size_t{ 0 });
+		std::sort(std::begin(order), std::end(order), [this](size_t a, size_t b) {
+			const auto& ra = mResources[a];
+			const auto& rb = mResources[b];
+			if (ra.mLifetime.mFirstUse != rb.mLifetime.mFirstUse) {
+				return ra.mLifetime.mFirstUse < rb.mLifetime.mFirstUse;
+			}
+			return ra.mRequirements.size > rb.mRequirements.size;
+		});
+
+		for (auto i : order) {
+			auto& r = mResources[i];
+			std::optional<size_t> bestFit;
+			std::optional<size_t> largestFree;
+			for (size_t c = 0; c < ranges.size(); ++c) {
+				if (ranges[c].mBusyUntil >= r.mLifetime.mFirstUse) {
+					continue; // Lifetimes overlap
+				}
+				if (ranges[c].mSize >= r.mRequirements.size && (!bestFit.has_value() || ranges[c].mSize < ranges[*bestFit].mSize)) {
+					bestFit = c;
+				}
+				if (!largestFree.has_value() || ranges[c].mSize > ranges[*largestFree].mSize) {
+					largestFree = c;
+				}
+			}
+
+			size_t c;
+			if (bestFit.has_value()) {
+				c = *bestFit;
+			}
+			else if (largestFree.has_value()) {
+				c = *largestFree;
+			}
+			else {
+				c = ranges.size();
+				ranges.push_back(memory_range{ 0, 1, 0, {} });
+			}
+
+			auto& range = ranges[c];
+			range.mSize = std::max(range.mSize, r.mRequirements.size);
+			range.mAlignment = std::max(range.mAlignment, r.mRequirements.alignment);
+			range.mBusyUntil = r.mLifetime.mLastUse;
+			range.mOccupants.push_back(i);
+		}
+
+		// Lay out the ranges one after the other:
+		vk::DeviceSize offset = 0;
+		for (const auto& range : ranges) {
+			offset = align_to(offset, std::max(range.mAlignment, granularity));
+			for (auto i : range.mOccupants) {
+				mResources[i].mOffset = offset;
+			}
+			offset += range.mSize;
+		}
+		mMemorySize = offset;
+
+		auto tpl = mRoot->find_memory_type_index(memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+		auto allocInfo = vk::MemoryAllocateInfo{}
+			.setAllocationSize(mMemorySize)
+			.setMemoryTypeIndex(std::get<uint32_t>(tpl));
+		auto memoryAllocateFlagsInfo = vk::MemoryAllocateFlagsInfo{};
+		if (needsDeviceAddress) {
+			memoryAllocateFlagsInfo.flags |= vk::MemoryAllocateFlagBits::eDeviceAddress;
+			allocInfo.setPNext(&memoryAllocateFlagsInfo);
+		}
+		mMemory = mRoot->device().allocateMemoryUnique(allocInfo, nullptr, mRoot->dispatch_loader_core());
+
+		// Bind all the resources to their memory ranges:
+		for (auto& r : mResources) {
+			if (std::holds_alternative<image_t>(r.mResource)) {
+				mRoot->device().bindImageMemory(std::get<image_t>(r.mResource).handle(), mMemory.get(), r.mOffset, mRoot->dispatch_loader_core());
+			}
+			else {
+				auto& buf = std::get<buffer_t>(r.mResource);
+				mRoot->device().bindBufferMemory(buf.handle(), mMemory.get(), r.mOffset, mRoot->dispatch_loader_core());
+#if defined(AVK_USES_VMA)
+				buf.mBuffer.mAllocationInfo.memoryType = std::get<uint32_t>(tpl);
+#else
+				buf.mBuffer.mMemoryPropertyFlags = std::get<vk::MemoryPropertyFlags>(tpl);
+#endif
+#if VK_HEADER_VERSION >= 135
+				if (avk::has_flag(buf.usage_flags(), vk::BufferUsageFlagBits::eShaderDeviceAddress)) {
+					buf.mDeviceAddress = root::get_buffer_address(mRoot->device(), buf.handle());
+				}
+#endif
+			}
+		}
+	}
+
+	vk::DeviceSize aliasing_heap_t::unaliased_memory_size() const
+	{
+		vk::DeviceSize sum = 0;
+		for (const auto& r : mResources) {
+			sum = align_to(sum, r.mRequirements.alignment) + r.mRequirements.size;
+		}
+		return sum;
+	}
+
+	avk::sync::sync_type_command aliasing_heap_t::aliasing_barrier(aliased_resource_id aId, avk::layout::image_layout aInitialLayout) const
+	{
+		// Even the first occupant of a memory range shares its memory with the last occupant of the previous
+		// frame (or with any other resource of a frame which might still be in flight) => always wait for all
+		// previous work and make its writes available before the memory is reused:
+		return sync::image_memory_barrier(image_at(aId), stage::all_commands >> stage::auto_stage, access::memory_write >> access::auto_access)
+			.with_layout_transition(layout::undefined >> aInitialLayout);
+	}
+
+	avk::sync::sync_type_command aliasing_heap_t::aliasing_barrier(aliased_resource_id aId) const
+	{
+		// Always wait for all previous work on the memory, see the image overload:
+		return sync::buffer_memory_barrier(buffer_at(aId), stage::all_commands >> stage::auto_stage, access::memory_write >> access::auto_access);
+	}
+
+	aliasing_heap root::create_aliasing_heap()
+	{
+		aliasing_heap_t result;
+		result.mRoot = this;
+		return result;
+	}
+#pragma endregion
+
+#pragma region baked commands definitions
+	// Assembles the inheritance info of secondary command buffers. aRenderingInfo is chained into aInfo if required:
+	static void assemble_inheritance_info(const secondary_command_buffer_inheritance& aInheritance, vk::CommandBufferInheritanceInfo& aInfo, vk::CommandBufferInheritanceRenderingInfoKHR& aRenderingInfo)
+	{
+		const auto* inheritedRenderPass = std::get_if<render_pass_inheritance>(&aInheritance);
+		const auto* inheritedDynamicRendering = std::get_if<dynamic_rendering_inheritance>(&aInheritance);
+		if (nullptr != inheritedRenderPass) {
+			aInfo
+				.setRenderPass(inheritedRenderPass->mRenderPass)
+				.setSubpass(inheritedRenderPass->mSubpass)
+				.setFramebuffer(inheritedRenderPass->mFramebuffer);
+		}
+		else if (nullptr != inheritedDynamicRendering) {
+			aRenderingInfo
+				.setViewMask(inheritedDynamicRendering->mViewMask)
+				.setColorAttachmentCount(static_cast<uint32_t>(inheritedDynamicRendering->mColorAttachmentFormats.size()))
+				.setPColorAttachmentFormats(inheritedDynamicRendering->mColorAttachmentFormats.data())
+				.setDepthAttachmentFormat(inheritedDynamicRendering->mDepthAttachmentFormat)
+				.setStencilAttachmentFormat(inheritedDynamicRendering->mStencilAttachmentFormat)
+				.setRasterizationSamples(inheritedDynamicRendering->mRasterizationSamples);
+			aInfo.setPNext(&aRenderingInfo);
+		}
+	}
+
+	static bool contains_sync_commands(const std::vector<recorded_commands_t>& aCommands)
+	{
+		return std::any_of(std::begin(aCommands), std::end(aCommands), [](const recorded_commands_t& lRecordee) {
+			if (std::holds_alternative<command::action_type_command>(lRecordee)) {
+				return contains_sync_commands(std::get<command::action_type_command>(lRecordee).mNestedCommandsAndSyncInstructions);
+			}
+			return std::holds_alternative<sync::sync_type_command>(lRecordee);
+		});
+	}
+
+	// Secondary command buffers which continue a render pass or dynamic rendering must not record pipeline barriers,
+	// because they are not allowed within dynamic rendering, and only with subpass self-dependencies within render passes:
+	static void validate_no_barriers_within_rendering(const secondary_command_buffer_inheritance& aInheritance, const std::vector<recorded_commands_t>& aCommands)
+	{
+		if (!std::holds_alternative<std::monostate>(aInheritance) && contains_sync_commands(aCommands)) {
+			throw avk::logic_error("Commands which are recorded into secondary command buffers within a render pass or dynamic rendering must not contain sync commands. Record the barriers into the primary command buffer before the render pass or dynamic rendering begins.");
+		}
+	}
+
+	// Returns true if any of the given commands updates tracked image layouts while it is being recorded,
+	// i.e., image memory barriers of images with layout tracking enabled, and commands which are flagged accordingly:
+	static bool contains_tracked_layout_updates(const std::vector<recorded_commands_t>& aCommands)
+	{
+		return std::any_of(std::begin(aCommands), std::end(aCommands), [](const recorded_commands_t& lRecordee) {
+			if (std::holds_alternative<command::action_type_command>(lRecordee)) {
+				const auto& actionCmd = std::get<command::action_type_command>(lRecordee);
+				return actionCmd.mUpdatesTrackedLayouts || contains_tracked_layout_updates(actionCmd.mNestedCommandsAndSyncInstructions);
+			}
+			if (std::holds_alternative<sync::sync_type_command>(lRecordee)) {
+				const auto& syncCmd = std::get<sync::sync_type_command>(lRecordee);
+				return syncCmd.is_image_memory_barrier() && nullptr != syncCmd.image_memory_barrier_data().mLayoutState;
+			}
+			return false;
+		});
+	}
+
+	void baked_commands_t::gather_referenced_resources(const std::vector<recorded_commands_t>& aCommands)
+	{
+		for (const auto& recordee : aCommands) {
+			if (std::holds_alternative<command::action_type_command>(recordee)) {
+				const auto& actionCmd = std::get<command::action_type_command>(recordee);
+				for (const auto& [res, syncHint] : actionCmd.mResourceSpecificSyncHints) {
+					std::visit([this](auto aHandle) { depends_on(aHandle); }, res);
+				}
+				gather_referenced_resources(actionCmd.mNestedCommandsAndSyncInstructions);
+			}
+			else if (std::holds_alternative<sync::sync_type_command>(recordee)) {
+				const auto& syncCmd = std::get<sync::sync_type_command>(recordee);
+				if (syncCmd.is_buffer_memory_barrier()) {
+					depends_on(syncCmd.buffer_memory_barrier_data().mBuffer);
+				}
+				else if (syncCmd.is_image_memory_barrier()) {
+					depends_on(syncCmd.image_memory_barrier_data().mImage);
+				}
+			}
+		}
+	}
+
+	void baked_commands_t::bake(size_t aVariant)
+	{
+		auto& v = mVariants[aVariant];
+		auto& cb = v.mCommandBuffer.get();
+		v.mIsBaked = false;
+		cb.prepare_for_reuse();
+
+		std::optional<buffer_slice> parameters;
+		if (mParametersSize > 0) {
+			parameters = buffer_slice{ mParametersBuffer.get(), static_cast<vk::DeviceSize>(aVariant) * mParametersStride, mParametersSize };
+		}
+		auto commands = mBakeFunction(bake_context{ aVariant, parameters, this });
+		gather_referenced_resources(commands);
+
+		if (vk::CommandBufferLevel::eSecondary == mLevel) {
+			validate_no_barriers_within_rendering(mInheritance, commands);
+			auto inheritanceInfo = vk::CommandBufferInheritanceInfo{};
+			auto inheritanceRenderingInfo = vk::CommandBufferInheritanceRenderingInfoKHR{};
+			assemble_inheritance_info(mInheritance, inheritanceInfo, inheritanceRenderingInfo);
+			cb.begin_recording(inheritanceInfo);
+		}
+		else {
+			cb.begin_recording();
+		}
+		cb.record(std::move(commands));
+		cb.end_recording();
+
+		v.mIsBaked = true;
+		++mNumBakes;
+	}
+
+	command_buffer_t& baked_commands_t::get(uint64_t aFrameIndex)
+	{
+		const auto variantIndex = static_cast<size_t>(aFrameIndex % mVariants.size());
+		if (!mVariants[variantIndex].mIsBaked) {
+			bake(variantIndex);
+		}
+		return mVariants[variantIndex].mCommandBuffer.get();
+	}
+
+	command::action_type_command baked_commands_t::execute(uint64_t aFrameIndex, avk::sync::sync_hint aSyncHint)
+	{
+		if (vk::CommandBufferLevel::eSecondary != mLevel) {
+			throw avk::logic_error("Only baked commands of level vk::CommandBufferLevel::eSecondary can be executed from within another command buffer.");
+		}
+		return command::action_type_command{
+			aSyncHint,
+			{},
+			[lHandle = get(aFrameIndex).handle()](avk::command_buffer_t& cb) {
+				cb.handle().executeCommands(1u, &lHandle);
+				// The state of the primary command buffer is undefined after executing secondary command buffers:
+				cb.invalidate_bound_state();
+			}
+		};
+	}
+
+	void* baked_commands_t::parameters(uint64_t aFrameIndex) const
+	{
+		if (!mParametersMapping.has_value()) {
+			return nullptr;
+		}
+		return static_cast<uint8_t*>(mParametersMapping->get()) + static_cast<size_t>(aFrameIndex % mVariants.size()) * mParametersStride;
+	}
+
+	bool baked_commands_t::notify_changed(vk::Buffer aBuffer)
+	{
+		if (!references(aBuffer)) {
+			return false;
+		}
+		invalidate();
+		return true;
+	}
+
+	bool baked_commands_t::notify_changed(vk::Image aImage)
+	{
+		if (!references(aImage)) {
+			return false;
+		}
+		invalidate();
+		return true;
+	}
+
+	void baked_commands_t::invalidate()
+	{
+		for (auto& v : mVariants) {
+			v.mIsBaked = false;
+		}
+		// The variants gather them again when they are baked:
+		mReferencedBuffers.clear();
+		mReferencedImages.clear();
+	}
+
+	baked_commands root::create_baked_commands(uint32_t aQueueFamilyIndex, size_t aNumberOfFramesInFlight, baked_commands_t::bake_function aBakeFunction, vk::DeviceSize aParametersSize, vk::BufferUsageFlags aParametersUsageFlags, vk::CommandBufferLevel aLevel, secondary_command_buffer_inheritance aInheritance)
+	{
+		if (0 == aNumberOfFramesInFlight) {
+			throw avk::logic_error("Baked commands require at least one frame in flight.");
+		}
+		if (!aBakeFunction) {
+			throw avk::logic_error("Baked commands require a bake function.");
+		}
+
+		baked_commands_t result;
+		result.mRoot = this;
+		result.mBakeFunction = std::move(aBakeFunction);
+		result.mLevel = aLevel;
+		result.mInheritance = std::move(aInheritance);
+		// Variants are re-recorded individually => their command buffers must be resettable:
+		result.mCommandPool = create_command_pool(aQueueFamilyIndex, vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
+		const auto usageFlags = vk::CommandBufferLevel::eSecondary == aLevel && !std::holds_alternative<std::monostate>(result.mInheritance)
+			? vk::CommandBufferUsageFlags{ vk::CommandBufferUsageFlagBits::eRenderPassContinue }
+			: vk::CommandBufferUsageFlags{};
+		auto commandBuffers = result.mCommandPool->alloc_command_buffers(static_cast<uint32_t>(aNumberOfFramesInFlight), usageFlags, aLevel);
+		result.mVariants.reserve(aNumberOfFramesInFlight);
+		for (auto& cb : commandBuffers) {
+			result.mVariants.push_back(baked_commands_t::variant{ std::move(cb) });
+		}
+
+		if (aParametersSize > 0) {
+			const auto& limits = capabilities().limits();
+			const auto alignment = std::max({
+				limits.minUniformBufferOffsetAlignment,
+				limits.minStorageBufferOffsetAlignment,
+				static_cast<vk::DeviceSize>(sizeof(uint32_t))
+			});
+			result.mParametersSize = aParametersSize;
+			result.mParametersStride = (aParametersSize + alignment - 1) / alignment * alignment;
+
+			const auto bufferSize = static_cast<size_t>(result.mParametersStride * aNumberOfFramesInFlight);
+#if VK_HEADER_VERSION >= 135
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#else
+			std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#endif
+			metas.push_back(generic_buffer_meta::create_from_size(bufferSize));
+			// Add meta data for the supported usages, s.t. slices can be bound as descriptors or used for indirect commands:
+			if (avk::has_flag(aParametersUsageFlags, vk::BufferUsageFlagBits::eUniformBuffer)) {
+				metas.push_back(uniform_buffer_meta::create_from_size(bufferSize));
+			}
+			if (avk::has_flag(aParametersUsageFlags, vk::BufferUsageFlagBits::eStorageBuffer)) {
+				metas.push_back(storage_buffer_meta::create_from_size(bufferSize));
+			}
+			if (avk::has_flag(aParametersUsageFlags, vk::BufferUsageFlagBits::eIndirectBuffer)) {
+				metas.push_back(indirect_buffer_meta::create_from_size(bufferSize));
+			}
+			result.mParametersBuffer = root::create_buffer(*this, std::move(metas), aParametersUsageFlags, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+			result.mParametersMapping.emplace(result.mParametersBuffer->map_memory(mapping_access::write));
+			memset(result.mParametersMapping->get(), 0, bufferSize);
+		}
+		return result;
+	}
+#pragma endregion
+
+#pragma region barrier plan cache definitions
+	std::shared_ptr<const barrier_plan> barrier_plan_cache::find(size_t aHash, const std::vector<uint64_t>& aStructure)
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		auto [it, end] = mEntriesByHash.equal_range(aHash);
+		for (; it != end; ++it) {
+			if (it->second->mPlan->mStructure == aStructure) {
+				++mNumHits;
+				// Mark as most recently used:
+				mEntries.splice(std::begin(mEntries), mEntries, it->second);
+				return it->second->mPlan;
+			}
+		}
+		++mNumMisses;
+		return {};
+	}
+
+	void barrier_plan_cache::insert(size_t aHash, std::shared_ptr<const barrier_plan> aPlan)
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		if (!mEntries.empty() && mEntries.size() >= AVK_BARRIER_PLAN_CACHE_MAX_ENTRIES) {
+			// Evict the least recently used plan:
+			const auto lru = std::prev(std::end(mEntries));
+			auto [it, end] = mEntriesByHash.equal_range(lru->mHash);
+			for (; it != end; ++it) {
+				if (it->second == lru) {
+					mEntriesByHash.erase(it);
+					break;
+				}
+			}
+			mEntries.erase(lru);
+		}
+		mEntries.push_front(entry{ aHash, std::move(aPlan) });
+		mEntriesByHash.emplace(aHash, std::begin(mEntries));
+	}
+
+	void barrier_plan_cache::clear()
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		mEntriesByHash.clear();
+		mEntries.clear();
+	}
+
+	void barrier_plan_cache::reset_statistics()
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		mNumHits = 0;
+		mNumMisses = 0;
+	}
+
+	size_t barrier_plan_cache::size() const
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		return mEntries.size();
+	}
+
+	size_t barrier_plan_cache::number_of_hits() const
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		return mNumHits;
+	}
+
+	size_t barrier_plan_cache::number_of_misses() const
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		return mNumMisses;
+	}
+#pragma endregion
+
 #pragma region binding_data definitions
 	uint32_t binding_data::descriptor_count() const
 	{
@@ -2537,7 +3078,8 @@ namespace avk
 #endif
 		vk::BufferUsageFlags aBufferUsage,
 		vk::MemoryPropertyFlags aMemoryProperties,
-		std::initializer_list<queue*> aConcurrentQueueOwnership
+		std::initializer_list<queue*> aConcurrentQueueOwnership,
+		uint32_t aAllowedMemoryTypeBits
 	)
 	{
 		assert (aMetaData.size() > 0);
@@ -2573,7 +3115,7 @@ namespace avk
 
 		result.mCreateInfo = bufferCreateInfo;
 		result.mBufferUsageFlags = aBufferUsage;
-		result.mBuffer = AVK_MEM_BUFFER_HANDLE{ aRoot.memory_allocator(), aMemoryProperties, result.mCreateInfo };
+		result.mBuffer = AVK_MEM_BUFFER_HANDLE{ aRoot.memory_allocator(), aMemoryProperties, result.mCreateInfo, aAllowedMemoryTypeBits, &aRoot.capabilities().memory_properties() };
 		result.mRoot = &aRoot;
 
 #if VK_HEADER_VERSION >= 135
@@ -2591,48 +3133,254 @@ namespace avk
 		return result;
 	}
 
-	avk::command::action_type_command buffer_t::fill(const void* aDataPtr, size_t aMetaDataIndex) const
+	vk::DeviceSize root::imported_host_pointer_alignment() const
 	{
-		const auto metaData = meta_at_index<buffer_meta>(aMetaDataIndex);
-		const auto bufferSize = static_cast<vk::DeviceSize>(metaData.total_size());
-		return fill(aDataPtr, aMetaDataIndex, 0u, bufferSize);
+		return capabilities().external_memory_host_properties().minImportedHostPointerAlignment;
 	}
 
-	command::action_type_command buffer_t::fill(const void* aDataPtr, size_t aMetaDataIndex, size_t aOffsetInBytes, size_t aDataSizeInBytes) const
+	buffer root::create_buffer(
+		const root& aRoot,
+		host_memory_import aHostMemory,
+#if VK_HEADER_VERSION >= 135
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#else
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#endif
+		vk::BufferUsageFlags aBufferUsage
+	)
 	{
-		auto dstOffset = static_cast<vk::DeviceSize>(aOffsetInBytes);
-		auto dataSize = static_cast<vk::DeviceSize>(aDataSizeInBytes);
-		const auto memProps = memory_properties();
+		assert (aMetaData.size() > 0);
+		if (nullptr == aHostMemory.mHostPointer) {
+			throw avk::logic_error("Can not create a buffer from host memory without a host pointer.");
+		}
+		buffer_t result;
+		result.mMetaData = std::move(aMetaData);
+		result.mCreateInfo = vk::BufferCreateInfo{}
+			.setSize(static_cast<vk::DeviceSize>(result.meta_at_index<buffer_meta>(0).total_size()))
+			.setUsage(aBufferUsage)
+			.setSharingMode(vk::SharingMode::eExclusive);
+		result.mBufferUsageFlags = aBufferUsage;
+		result.mRoot = &aRoot;
 
-#ifdef _DEBUG
-		const auto& metaData = meta_at_index<buffer_meta>(aMetaDataIndex);
-		assert(dstOffset + dataSize <= metaData.total_size()); // The fill operation would write beyond the buffer's size.
+		// Buffers which are bound to external memory must be created with the handle type. (Not stored in mCreateInfo, because it's a pointer to a local.)
+		auto externalMemoryBufferCreateInfo = vk::ExternalMemoryBufferCreateInfo{}
+			.setHandleTypes(aHostMemory.mHandleType);
+		auto bufferCreateInfo = result.mCreateInfo;
+		bufferCreateInfo.setPNext(&externalMemoryBufferCreateInfo);
+		auto vkBuffer = aRoot.device().createBuffer(bufferCreateInfo, nullptr, aRoot.dispatch_loader_core());
+		// The buffer_t takes care of destroying the buffer handle, the memory is owned by mExternalMemory:
+#if defined(AVK_USES_VMA)
+		result.mBuffer.mAllocator = aRoot.memory_allocator();
+		result.mBuffer.mResource = vkBuffer;
+#else
+		result.mBuffer = AVK_MEM_BUFFER_HANDLE{ aRoot.memory_allocator(), vkBuffer };
 #endif
 
-		// Prepare a result which defines no sync hints and no instructions to be executed for some cases:
-		auto actionTypeCommand = command::action_type_command{
-			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
-			{
-				std::make_tuple(handle(), avk::sync::sync_hint{
-					stage::none + access::none, // No need to wait on anything nor to make anything available
-					// Set defaults for the host-visible-only case, overwrite them for device buffers further down:
-					stage::none + access::none, // <-- This is okay for host-visible buffers, because the queue submit transfers the memory
-				})
-			}
-		};
-		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
-
-		// #0: Sanity check
-		if (dataSize == 0) {
+		// The imported range must start and end at multiples of minImportedHostPointerAlignment. Import the enclosing range,
+		// and bind the buffer at the offset of the host pointer within it:
+		const auto requirements = aRoot.device().getBufferMemoryRequirements(vkBuffer, aRoot.dispatch_loader_core());
+		const auto importAlignment = aRoot.imported_host_pointer_alignment();
+		const auto bindOffset = static_cast<vk::DeviceSize>(reinterpret_cast<uintptr_t>(aHostMemory.mHostPointer) % importAlignment);
+		if (0 != bindOffset % requirements.alignment) {
+			throw avk::runtime_error("The host pointer must be aligned to " + std::to_string(requirements.alignment) + " bytes in order to be imported as a buffer with the given usage flags.");
+		}
+		auto* importPointer = static_cast<uint8_t*>(aHostMemory.mHostPointer) - bindOffset;
+		const auto importSize = align_to(bindOffset + requirements.size, importAlignment);
+
+		const auto hostPointerProperties = aRoot.device().getMemoryHostPointerPropertiesEXT(aHostMemory.mHandleType, importPointer, aRoot.dispatch_loader_ext());
+		const auto memoryTypeBits = requirements.memoryTypeBits & hostPointerProperties.memoryTypeBits;
+		if (0u == memoryTypeBits) {
+			throw avk::runtime_error("The host memory can not be imported for a buffer with the given usage flags, because there is no suitable memory type.");
+		}
+		// Prefer coherent memory, which does not need to be flushed after writing into it. Foreign memory (e.g., a PCIe BAR)
+		// is often only importable as non-coherent memory, though, which is flushed and invalidated when it is (un)mapped:
+		const auto& memoryProperties = aRoot.capabilities().memory_properties();
+		auto requiredProperties = vk::MemoryPropertyFlags{ vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent };
+		bool hasCoherentType = false;
+		for (uint32_t i = 0u; i < memoryProperties.memoryTypeCount; ++i) {
+			hasCoherentType = hasCoherentType || (0u != (memoryTypeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & requiredProperties) == requiredProperties);
+		}
+		if (!hasCoherentType) {
+			requiredProperties = vk::MemoryPropertyFlagBits::eHostVisible;
+		}
+		auto tpl = aRoot.find_memory_type_index(memoryTypeBits, requiredProperties);
+
+		auto importInfo = vk::ImportMemoryHostPointerInfoEXT{}
+			.setHandleType(aHostMemory.mHandleType)
+			.setPHostPointer(importPointer);
+		auto allocInfo = vk::MemoryAllocateInfo{}
+			.setAllocationSize(importSize)
+			.setMemoryTypeIndex(std::get<uint32_t>(tpl))
+			.setPNext(&importInfo);
+#if VK_HEADER_VERSION >= 135
+		auto memoryAllocateFlagsInfo = vk::MemoryAllocateFlagsInfo{};
+		if (avk::has_flag(aBufferUsage, vk::BufferUsageFlagBits::eShaderDeviceAddress)) {
+			memoryAllocateFlagsInfo.flags |= vk::MemoryAllocateFlagBits::eDeviceAddress;
+			importInfo.setPNext(&memoryAllocateFlagsInfo);
+		}
+#endif
+		result.mExternalMemory = aRoot.device().allocateMemoryUnique(allocInfo, nullptr, aRoot.dispatch_loader_core());
+		aRoot.device().bindBufferMemory(vkBuffer, result.mExternalMemory.get(), bindOffset, aRoot.dispatch_loader_core());
+		result.mImportedHostPointer = aHostMemory.mHostPointer;
+		if (!hasCoherentType) {
+			// Memory ranges can only be flushed and invalidated while the memory is mapped. It stays mapped until it is freed,
+			// but it is still accessed through the imported host pointer:
+			static_cast<void>(aRoot.device().mapMemory(result.mExternalMemory.get(), 0, VK_WHOLE_SIZE, {}, aRoot.dispatch_loader_core()));
+		}
+#if defined(AVK_USES_VMA)
+		result.mBuffer.mAllocationInfo.memoryType = std::get<uint32_t>(tpl);
+#else
+		result.mBuffer.mMemoryPropertyFlags = std::get<vk::MemoryPropertyFlags>(tpl);
+#endif
+
+#if VK_HEADER_VERSION >= 135
+		if (avk::has_flag(result.usage_flags(), vk::BufferUsageFlagBits::eShaderDeviceAddress)) {
+			result.mDeviceAddress = get_buffer_address(aRoot.device(), result.handle());
+		}
+#endif
+
+		return result;
+	}
+
+	void* buffer_t::map_host_accessible_memory(mapping_access aAccess) const
+	{
+		if (is_imported_host_memory()) {
+			// Non-coherent imported memory is mapped permanently, see root::create_buffer(..., host_memory_import, ...):
+			if (has_flag(aAccess, mapping_access::read) && !has_flag(memory_properties(), vk::MemoryPropertyFlagBits::eHostCoherent)) {
+				mRoot->device().invalidateMappedMemoryRanges(vk::MappedMemoryRange{ mExternalMemory.get(), 0, VK_WHOLE_SIZE }, mRoot->dispatch_loader_core());
+			}
+			return mImportedHostPointer;
+		}
+		if (!mExternalMemory) {
+			return mBuffer.map_memory(aAccess);
+		}
+		// External memory is not managed by mBuffer => map it directly:
+		void* mappedData = mRoot->device().mapMemory(mExternalMemory.get(), 0, VK_WHOLE_SIZE, {}, mRoot->dispatch_loader_core());
+		if (has_flag(aAccess, mapping_access::read) && !has_flag(memory_properties(), vk::MemoryPropertyFlagBits::eHostCoherent)) {
+			mRoot->device().invalidateMappedMemoryRanges(vk::MappedMemoryRange{ mExternalMemory.get(), 0, VK_WHOLE_SIZE }, mRoot->dispatch_loader_core());
+		}
+		return mappedData;
+	}
+
+	void buffer_t::unmap_host_accessible_memory(mapping_access aAccess) const
+	{
+		if (is_imported_host_memory()) {
+			if (has_flag(aAccess, mapping_access::write) && !has_flag(memory_properties(), vk::MemoryPropertyFlagBits::eHostCoherent)) {
+				mRoot->device().flushMappedMemoryRanges(vk::MappedMemoryRange{ mExternalMemory.get(), 0, VK_WHOLE_SIZE }, mRoot->dispatch_loader_core());
+			}
+			return;
+		}
+		if (!mExternalMemory) {
+			mBuffer.unmap_memory(aAccess);
+			return;
+		}
+		if (has_flag(aAccess, mapping_access::write) && !has_flag(memory_properties(), vk::MemoryPropertyFlagBits::eHostCoherent)) {
+			mRoot->device().flushMappedMemoryRanges(vk::MappedMemoryRange{ mExternalMemory.get(), 0, VK_WHOLE_SIZE }, mRoot->dispatch_loader_core());
+		}
+		mRoot->device().unmapMemory(mExternalMemory.get(), mRoot->dispatch_loader_core());
+	}
+
+	avk::command::action_type_command buffer_t::fill(const void* aDataPtr, size_t aMetaDataIndex) const
+	{
+		const auto metaData = meta_at_index<buffer_meta>(aMetaDataIndex);
+		const auto bufferSize = static_cast<vk::DeviceSize>(metaData.total_size());
+		return fill(aDataPtr, aMetaDataIndex, 0u, bufferSize);
+	}
+
+	command::action_type_command buffer_t::fill(const void* aDataPtr, size_t aMetaDataIndex, size_t aOffsetInBytes, size_t aDataSizeInBytes) const
+	{
+		auto dstOffset = static_cast<vk::DeviceSize>(aOffsetInBytes);
+		auto dataSize = static_cast<vk::DeviceSize>(aDataSizeInBytes);
+		const auto memProps = memory_properties();
+
+#ifdef _DEBUG
+		const auto& metaData = meta_at_index<buffer_meta>(aMetaDataIndex);
+		assert(dstOffset + dataSize <= metaData.total_size()); // The fill operation would write beyond the buffer's size.
+#endif
+
+		// Prepare a result which defines no sync hints and no instructions to be executed for some cases:
+		auto actionTypeCommand = command::action_type_command{
+			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+			{
+				std::make_tuple(handle(), avk::sync::sync_hint{
+					stage::none + access::none, // No need to wait on anything nor to make anything available
+					// Set defaults for the host-visible-only case, overwrite them for device buffers further down:
+					stage::none + access::none, // <-- This is okay for host-visible buffers, because the queue submit transfers the memory
+				})
+			}
+		};
+		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+		// Concurrent fills of this buffer must not interleave their updates of the shadow copy and the statistics:
+		std::scoped_lock fillLock(*mFillMutex);
+
+		// #0: Sanity check
+		mLastFillStatistics = fill_statistics{ static_cast<size_t>(dataSize), 0, 0, 0 };
+		if (dataSize == 0) {
 			// Nothing to do here
 			return actionTypeCommand;
 		}
 
-		// #1: Is our memory accessible from the CPU-SIDE?
+		// Determine the ranges which have to be uploaded, relative to dstOffset. Without shadow copy, that's everything.
+		// The shadow copy is updated right away (and not when the returned command is recorded), s.t. subsequent fills
+		// compare against these contents even if they are invoked before this fill's command has been recorded:
+		std::vector<std::tuple<vk::DeviceSize, vk::DeviceSize>> ranges;
+		if (mShadowCopy.has_value()) {
+			auto& shadow = mShadowCopy.value();
+			const auto* src = static_cast<const uint8_t*>(aDataPtr);
+			const auto blockSize = static_cast<vk::DeviceSize>(shadow.mBlockSize);
+			const auto end = dstOffset + dataSize;
+			// Blocks are aligned to the start of the buffer:
+			for (auto blockStart = dstOffset - dstOffset % blockSize; blockStart < end; blockStart += blockSize) {
+				const auto from = std::max(blockStart, dstOffset);
+				const auto to = std::min(blockStart + blockSize, end);
+				const auto blockIndex = static_cast<size_t>(blockStart / blockSize);
+				const bool isModified = !shadow.mValidBlocks[blockIndex] || !memory_equal(shadow.mData.data() + from, src + (from - dstOffset), static_cast<size_t>(to - from));
+				if (!isModified) {
+					continue;
+				}
+				if (!ranges.empty() && std::get<0>(ranges.back()) + std::get<1>(ranges.back()) == from - dstOffset) {
+					// Coalesce with the previous range:
+					std::get<1>(ranges.back()) += to - from;
+				}
+				else {
+					ranges.emplace_back(from - dstOffset, to - from);
+				}
+				memcpy(shadow.mData.data() + from, src + (from - dstOffset), static_cast<size_t>(to - from));
+				// Partially filled blocks do not become valid, unless they have been valid before:
+				shadow.mValidBlocks[blockIndex] = shadow.mValidBlocks[blockIndex] || (from == blockStart && (to == blockStart + blockSize || to == shadow.mData.size()));
+			}
+		}
+		else {
+			ranges.emplace_back(0, dataSize);
+		}
+
+		for (const auto& [rangeOffset, rangeSize] : ranges) {
+			mLastFillStatistics.mBytesUploaded += static_cast<size_t>(rangeSize);
+		}
+		mLastFillStatistics.mBytesSkipped = mLastFillStatistics.mBytesRequested - mLastFillStatistics.mBytesUploaded;
+		mLastFillStatistics.mNumRanges = ranges.size();
+		if (ranges.empty()) {
+			// Nothing has changed
+			return actionTypeCommand;
+		}
+
+		// #1: Is our memory accessible from the CPU-SIDE? (This includes device-local memory which is host-visible, e.g. memory_usage::device_host_writable)
 		if (avk::has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)) {
-			auto mapped = scoped_mapping{mBuffer, mapping_access::write};
-			// Memcpy doesn't have to wait on anything, no sync required.
-			memcpy(static_cast<uint8_t *>(mapped.get()) + dstOffset, aDataPtr, dataSize);
+			auto* mappedData = static_cast<uint8_t *>(map_host_accessible_memory(mapping_access::write));
+			// The copy doesn't have to wait on anything, no sync required.
+			for (const auto& [rangeOffset, rangeSize] : ranges) {
+				auto* dst = mappedData + dstOffset + rangeOffset;
+				const auto* src = static_cast<const uint8_t *>(aDataPtr) + rangeOffset;
+				if (avk::has_flag(memProps, vk::MemoryPropertyFlagBits::eHostCached)) {
+					memcpy(dst, src, rangeSize);
+				}
+				else {
+					// Uncached memory is typically write-combined => use non-temporal stores, and multiple threads for huge uploads:
+					copy_to_mapped_memory(dst, src, rangeSize);
+				}
+			}
+			unmap_host_accessible_memory(mapping_access::write);
 			// Since this is a host-write, no need for any barrier, because of implicit host write guarantee.
 			return actionTypeCommand;
 		}
@@ -2647,15 +3395,25 @@ namespace avk
 			// We need to take care though, to not try to allocate buffer of size zero here.
 			// If dataSize is zero, skip staging buffer creation and the copy command, but still
 			// process the synchronization calls, as user code may rely on those.
+			// The ranges are packed tightly into the staging buffer, and transferred with one copy region each.
+
+			std::vector<vk::BufferCopy> copyRegions;
+			vk::DeviceSize stagingSize = 0;
+			for (const auto& [rangeOffset, rangeSize] : ranges) {
+				copyRegions.emplace_back(stagingSize, dstOffset + rangeOffset, rangeSize);
+				stagingSize += rangeSize;
+			}
 
 			auto stagingBuffer = root::create_buffer(
 				*mRoot,
 				AVK_STAGING_BUFFER_MEMORY_USAGE,
 				vk::BufferUsageFlagBits::eTransferSrc,
-				generic_buffer_meta::create_from_size(dataSize)
+				generic_buffer_meta::create_from_size(stagingSize)
 			);
 			stagingBuffer.enable_shared_ownership(); // TODO: Why does it not work WITHOUT shared_ownership? (Fails when assigning it to mBeginFun)
-			stagingBuffer->fill(aDataPtr, 0); // Recurse into the other if-branch
+			for (size_t i = 0; i < ranges.size(); ++i) {
+				stagingBuffer->fill(static_cast<const uint8_t*>(aDataPtr) + std::get<0>(ranges[i]), 0, copyRegions[i].srcOffset, copyRegions[i].size); // Recurse into the other if-branch
+			}
 
 			// Whatever comes before/after must synchronize with the device-local copy:
 			std::get<avk::sync::sync_hint>(actionTypeCommand.mResourceSpecificSyncHints.front()).mDstForPreviousCmds = stage::copy + (access::transfer_read | access::transfer_write);
@@ -2666,15 +3424,14 @@ namespace avk
 				lRoot = mRoot,
 				lOwnedStagingBuffer = std::move(stagingBuffer),
 				lDstBufferHandle = handle(),
-				dstOffset, dataSize
+				lCopyRegions = std::move(copyRegions)
 			](avk::command_buffer_t& cb) mutable {
 				//const auto copyRegion = vk::BufferCopy2KHR{ 0u, 0u, dataSize };
 				//const auto copyBufferInfo = vk::CopyBufferInfo2KHR{ lOwnedStagingBuffer->handle(), lDstBufferHandle, 1u, &copyRegion };
 				//cb.handle().copyBuffer2KHR(&copyBufferInfo);
 				// TODO: No idea why copyBuffer2KHR fails with an access violation
 
-				const auto copyRegion = vk::BufferCopy{ 0u, dstOffset, dataSize };
-				cb.handle().copyBuffer(lOwnedStagingBuffer->handle(), lDstBufferHandle, 1u, &copyRegion, lRoot->dispatch_loader_core());
+				cb.handle().copyBuffer(lOwnedStagingBuffer->handle(), lDstBufferHandle, static_cast<uint32_t>(lCopyRegions.size()), lCopyRegions.data(), lRoot->dispatch_loader_core());
 
 				// Take care of the lifetime handling of the stagingBuffer, it might still be in use when this method returns:
 				cb.handle_lifetime_of(std::move(lOwnedStagingBuffer));
@@ -2684,6 +3441,18 @@ namespace avk
 		}
 	}
 
+	void buffer_t::enable_shadow_copy(size_t aBlockSize)
+	{
+		assert(aBlockSize > 0);
+		const auto bufferSize = static_cast<size_t>(mCreateInfo.size);
+		std::scoped_lock lock(*mFillMutex);
+		mShadowCopy = shadow_copy{
+			std::vector<uint8_t>(bufferSize),
+			std::vector<bool>((bufferSize + aBlockSize - 1) / aBlockSize, false),
+			aBlockSize
+		};
+	}
+
 	/*	Reads values from a buffer back into some host-side memory.
 	 *	@param	aDataPtr		Where to store the read-back memory into.
 	 *	@param	aMetaDataIndex	Which meta data index shall be used to determine the data size to be read back.
@@ -2704,12 +3473,23 @@ namespace avk
 	{
 		auto metaData = meta_at_index<buffer_meta>(aMetaDataIndex);
 		auto bufferSize = static_cast<vk::DeviceSize>(metaData.total_size());
+		return read_into(aDataPtr, aMetaDataIndex, 0u, bufferSize);
+	}
+
+	avk::command::action_type_command buffer_t::read_into(void* aDataPtr, size_t aMetaDataIndex, size_t aOffsetInBytes, size_t aDataSizeInBytes) const
+	{
+#ifdef _DEBUG
+		const auto& metaData = meta_at_index<buffer_meta>(aMetaDataIndex);
+		assert(aOffsetInBytes + aDataSizeInBytes <= static_cast<size_t>(metaData.total_size()));
+#endif
+		auto dataSize = static_cast<vk::DeviceSize>(aDataSizeInBytes);
 		auto memProps = memory_properties();
 
 		// #1: Is our memory accessible on the CPU-SIDE?
 		if (avk::has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)) {
-			auto mapped = scoped_mapping{mBuffer, mapping_access::read};
-			memcpy(aDataPtr, mapped.get(), bufferSize);
+			const auto* mappedData = static_cast<const uint8_t*>(map_host_accessible_memory(mapping_access::read));
+			memcpy(aDataPtr, mappedData + aOffsetInBytes, dataSize);
+			unmap_host_accessible_memory(mapping_access::read);
 			return {};
 		}
 
@@ -2724,7 +3504,7 @@ namespace avk
 				*mRoot,
 				AVK_STAGING_BUFFER_READBACK_MEMORY_USAGE,
 				vk::BufferUsageFlagBits::eTransferDst,
-				generic_buffer_meta::create_from_size(bufferSize)
+				generic_buffer_meta::create_from_size(dataSize)
 			);
 
 			// TODO: Creating a staging buffer in every read()-call is probably not optimal. => Think about alternative ways!
@@ -2739,25 +3519,25 @@ namespace avk
 					// No need for any dependencies for the staging buffer
 				},
 				[
-					lBufferSize = bufferSize,
+					lOffset = static_cast<vk::DeviceSize>(aOffsetInBytes),
+					lDataSize = dataSize,
 					lBufferHandle = handle(),
 					lStagingBuffer = std::move(stagingBuffer),
-					aMetaDataIndex, aDataPtr
+					aDataPtr
 				] (avk::command_buffer_t& cb) {
 					auto copyRegion = vk::BufferCopy{}
-						.setSrcOffset(0u)
+						.setSrcOffset(lOffset)
 						.setDstOffset(0u)
-						.setSize(lBufferSize);
+						.setSize(lDataSize);
 					cb.handle().copyBuffer(lBufferHandle, lStagingBuffer->handle(), { copyRegion });
 
 					// Don't need to handle ownership here, because we're storing it in the post execution handler
 
 					cb.set_post_execution_handler([
 						lStagingBuffer, // enabled shared ownership anyways, so just pass by value
-						aMetaDataIndex,
 						aDataPtr
 					]() {
-						lStagingBuffer->read_into(aDataPtr, aMetaDataIndex); // This one will return an empty action_type_command{}
+						lStagingBuffer->read_into(aDataPtr, 0); // This one will return an empty action_type_command{}
 					});
 				}
 			};
@@ -2767,6 +3547,16 @@ namespace avk
 			return actionTypeCommand;
 		}
 	}
+
+	command::action_type_command buffer_slice::fill(const void* aDataPtr) const
+	{
+		return mBuffer->fill(aDataPtr, 0, static_cast<size_t>(mOffset), static_cast<size_t>(mSize));
+	}
+
+	command::action_type_command buffer_slice::read_into(void* aDataPtr) const
+	{
+		return mBuffer->read_into(aDataPtr, 0, static_cast<size_t>(mOffset), static_cast<size_t>(mSize));
+	}
 #pragma endregion
 
 #pragma region buffer view definitions
@@ -2798,7 +3588,15 @@ namespace avk
 	{
 		buffer_view_t result;
 		result.mBuffer = std::move(aBufferToOwn);
-		finish_configuration(result, aViewFormat, std::move(aAlterConfigBeforeCreation));
+		finish_configuration(result, aViewFormat, 0, VK_WHOLE_SIZE, std::move(aAlterConfigBeforeCreation));
+		return result;
+	}
+
+	buffer_view root::create_buffer_view(buffer aBufferToOwn, vk::Format aViewFormat, vk::DeviceSize aOffset, vk::DeviceSize aRange, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation)
+	{
+		buffer_view_t result;
+		result.mBuffer = std::move(aBufferToOwn);
+		finish_configuration(result, aViewFormat, aOffset, aRange, std::move(aAlterConfigBeforeCreation));
 		return result;
 	}
 
@@ -2807,7 +3605,16 @@ namespace avk
 		buffer_view_t result;
 		// Store handles:
 		result.mBuffer = std::make_tuple(aBufferToReference, aBufferInfo);
-		finish_configuration(result, aViewFormat, std::move(aAlterConfigBeforeCreation));
+		finish_configuration(result, aViewFormat, 0, VK_WHOLE_SIZE, std::move(aAlterConfigBeforeCreation));
+		return result;
+	}
+
+	buffer_view root::create_buffer_view(const buffer_slice& aSliceToReference, vk::Format aViewFormat, std::function<void(buffer_view_t&)> aAlterConfigBeforeCreation)
+	{
+		buffer_view_t result;
+		// Store handles:
+		result.mBuffer = std::make_tuple(aSliceToReference.handle(), aSliceToReference.get_buffer().create_info());
+		finish_configuration(result, aViewFormat, aSliceToReference.offset(), aSliceToReference.size(), std::move(aAlterConfigBeforeCreation));
 		return result;
 	}
 #pragma endregion
@@ -2876,6 +3683,11 @@ namespace avk
 			// Clear custom deleter:
 			mCustomDeleter.reset();
 		}
+		auto* deferredDestruction = nullptr != mRoot ? mRoot->deferred_destruction() : nullptr;
+		if (nullptr != deferredDestruction && !mLifetimeHandledResources.empty()) {
+			// The resources might still be used by work which has been submitted during the current retire value:
+			deferredDestruction->enqueue(std::exchange(mLifetimeHandledResources, {}));
+		}
 		mLifetimeHandledResources.clear();
 	}
 
@@ -2914,6 +3726,19 @@ namespace avk
 	{
 		mCommandBuffer->begin(mBeginInfo);
 		mState = command_buffer_state::recording;
+		invalidate_bound_state();
+		mNumElidedCalls = 0;
+	}
+
+	void command_buffer_t::begin_recording(const vk::CommandBufferInheritanceInfo& aInheritanceInfo)
+	{
+		auto beginInfo = mBeginInfo;
+		beginInfo.setPInheritanceInfo(&aInheritanceInfo);
+		mCommandBuffer->begin(beginInfo);
+		mState = command_buffer_state::recording;
+		// Secondary command buffers do not inherit any bound state from the primary command buffer:
+		invalidate_bound_state();
+		mNumElidedCalls = 0;
 	}
 
 	void command_buffer_t::end_recording()
@@ -2922,3371 +3747,3643 @@ namespace avk
 		mState = command_buffer_state::finished_recording;
 	}
 
-	void command_buffer_t::bind_descriptors(vk::PipelineBindPoint aBindingPoint, vk::PipelineLayout aLayoutHandle, std::vector<descriptor_set> aDescriptorSets)
+	void command_buffer_t::bind_descriptors(vk::PipelineBindPoint aBindingPoint, vk::PipelineLayout aLayoutHandle, const std::vector<descriptor_set>& aDescriptorSets)
 	{
 		if (aDescriptorSets.size() == 0) {
 			AVK_LOG_WARNING("command_buffer_t::bind_descriptors has been called, but there are no descriptor sets to be bound.");
 			return;
 		}
 
-		std::vector<vk::DescriptorSet> handles;
-		handles.reserve(aDescriptorSets.size());
-		for (const auto& dset : aDescriptorSets)
-		{
-			handles.push_back(dset.handle());
-		}
-
-		if (aDescriptorSets.empty()) {
-			return;
-		}
-
 		// Issue one or multiple bindDescriptorSets commands. We can only bind CONSECUTIVELY NUMBERED sets.
+		// The handles of one command are gathered on the stack, s.t. no memory has to be allocated:
+		std::array<vk::DescriptorSet, 32> handles;
 		size_t descIdx = 0;
 		while (descIdx < aDescriptorSets.size()) {
 			const uint32_t setId = aDescriptorSets[descIdx].set_id();
 			uint32_t count = 1u;
-			while ((descIdx + count) < aDescriptorSets.size() && aDescriptorSets[descIdx + count].set_id() == (setId + count)) {
+			handles[0] = aDescriptorSets[descIdx].handle();
+			while ((descIdx + count) < aDescriptorSets.size() && count < handles.size() && aDescriptorSets[descIdx + count].set_id() == (setId + count)) {
+				handles[count] = aDescriptorSets[descIdx + count].handle();
 				++count;
 			}
 
-			handle().bindDescriptorSets(
+			bind_descriptor_sets(
 				aBindingPoint,
 				aLayoutHandle,
 				setId, count,
-				&handles[descIdx],
+				handles.data(),
 				0, // TODO: Dynamic offset count
 				nullptr); // TODO: Dynamic offset
 
 			descIdx += count;
 		}
 	}
-#pragma endregion
 
-#pragma region compute pipeline definitions
-	void root::rewire_config_and_create_compute_pipeline(compute_pipeline_t& aPreparedPipeline)
+	size_t command_buffer_t::bind_point_index(vk::PipelineBindPoint aBindPoint)
 	{
-		aPreparedPipeline.mShaderStageCreateInfo
-			.setModule(aPreparedPipeline.mShader.handle())
-			.setPName(aPreparedPipeline.mShader.info().mEntryPoint.c_str());
-
-		if (aPreparedPipeline.mSpecializationInfo.has_value()) {
-			assert(aPreparedPipeline.mShader.info().mSpecializationConstants.has_value());
-			aPreparedPipeline.mSpecializationInfo.value().pMapEntries = aPreparedPipeline.mShader.info().mSpecializationConstants.value().mMapEntries.data();
-			aPreparedPipeline.mSpecializationInfo.value().pData = aPreparedPipeline.mShader.info().mSpecializationConstants.value().mData.data();
-			aPreparedPipeline.mShaderStageCreateInfo.setPSpecializationInfo(&aPreparedPipeline.mSpecializationInfo.value());
+		switch (aBindPoint) {
+		case vk::PipelineBindPoint::eGraphics:
+			return 0;
+		case vk::PipelineBindPoint::eCompute:
+			return 1;
+#if VK_HEADER_VERSION >= 135
+		case vk::PipelineBindPoint::eRayTracingKHR:
+			return 2;
+#endif
+		default:
+			// Not tracked => commands for this bind point are always recorded
+			return std::tuple_size_v<decltype(bound_state::mBindPoints)>;
 		}
+	}
 
-		// Layout must already be configured and created properly!
+	void command_buffer_t::invalidate_pipeline_dependent_state()
+	{
+		// Binding a different pipeline overwrites all of its non-dynamic state, and push constants become
+		// undefined if its layout is not compatible with the previous one. We know neither, therefore:
+		mBoundState.mPushConstantsLayout = vk::PipelineLayout{};
+		mBoundState.mPushConstants.clear();
+		mBoundState.mViewports.clear();
+		mBoundState.mScissors.clear();
+	}
 
-		// Create the PIPELINE LAYOUT
-		aPreparedPipeline.mPipelineLayout = device().createPipelineLayoutUnique(aPreparedPipeline.mPipelineLayoutCreateInfo, nullptr, dispatch_loader_core());
-		assert(static_cast<bool>(aPreparedPipeline.layout_handle()));
+	void command_buffer_t::invalidate_bound_state()
+	{
+		for (auto& bp : mBoundState.mBindPoints) {
+			bp.mPipeline = vk::Pipeline{};
+			bp.mDescriptorSetLayout = vk::PipelineLayout{};
+			bp.mDescriptorSets.clear();
+		}
+		invalidate_pipeline_dependent_state();
+		mBoundState.mVertexBuffers.clear();
+		mBoundState.mIndexBuffer.reset();
+	}
 
-		// Create the PIPELINE, a.k.a. putting it all together:
-		auto pipelineInfo = vk::ComputePipelineCreateInfo{}
-			.setFlags(aPreparedPipeline.mPipelineCreateFlags)
-			.setStage(aPreparedPipeline.mShaderStageCreateInfo)
-			.setLayout(aPreparedPipeline.layout_handle())
-			.setBasePipelineHandle(nullptr) // Optional
-			.setBasePipelineIndex(-1); // Optional
-#if VK_HEADER_VERSION >= 141
-		auto result = device().createComputePipelineUnique(nullptr, pipelineInfo, nullptr, dispatch_loader_core());
-		aPreparedPipeline.mPipeline = std::move(result.value);
-#else
-		aPreparedPipeline.mPipeline = device().createComputePipelineUnique(nullptr, pipelineInfo);
-#endif
+	void command_buffer_t::bind_pipeline(vk::PipelineBindPoint aBindPoint, vk::Pipeline aPipeline)
+	{
+		const auto bpIdx = bind_point_index(aBindPoint);
+		if (bpIdx < mBoundState.mBindPoints.size()) {
+			auto& bp = mBoundState.mBindPoints[bpIdx];
+			if (mEliminateRedundantState && bp.mPipeline == aPipeline) {
+				++mNumElidedCalls;
+				return;
+			}
+			bp.mPipeline = aPipeline;
+			invalidate_pipeline_dependent_state();
+		}
+		handle().bindPipeline(aBindPoint, aPipeline);
 	}
 
-	compute_pipeline root::create_compute_pipeline(compute_pipeline_config aConfig, std::function<void(compute_pipeline_t&)> aAlterConfigBeforeCreation)
+	void command_buffer_t::bind_descriptor_sets(vk::PipelineBindPoint aBindPoint, vk::PipelineLayout aLayout, uint32_t aFirstSet, uint32_t aNumSets, const vk::DescriptorSet* aSets, uint32_t aNumDynamicOffsets, const uint32_t* aDynamicOffsets)
 	{
-		compute_pipeline_t result;
+		const auto bpIdx = bind_point_index(aBindPoint);
+		if (bpIdx < mBoundState.mBindPoints.size()) {
+			auto& bp = mBoundState.mBindPoints[bpIdx];
+			if (bp.mDescriptorSetLayout != aLayout) {
+				// Sets which have been bound with a different layout might have been disturbed => forget all of them:
+				bp.mDescriptorSetLayout = aLayout;
+				bp.mDescriptorSets.clear();
+			}
+			else if (mEliminateRedundantState && aFirstSet + aNumSets <= bp.mDescriptorSets.size()) {
+				bool allBound = true;
+				for (uint32_t i = 0; allBound && i < aNumSets; ++i) {
+					const auto& bound = bp.mDescriptorSets[aFirstSet + i];
+					allBound = bound.mHandle && bound.mHandle == aSets[i]
+						&& bound.mDynamicOffsets.size() == aNumDynamicOffsets
+						// Dynamic offsets can only be compared if the sets have been bound by an equal command:
+						&& (0u == aNumDynamicOffsets || (bound.mFirstSetOfCommand == aFirstSet && bound.mNumSetsOfCommand == aNumSets && std::equal(bound.mDynamicOffsets.begin(), bound.mDynamicOffsets.end(), aDynamicOffsets)));
+				}
+				if (allBound) {
+					++mNumElidedCalls;
+					return;
+				}
+			}
+			if (bp.mDescriptorSets.size() < aFirstSet + aNumSets) {
+				bp.mDescriptorSets.resize(aFirstSet + aNumSets);
+			}
+			for (uint32_t i = 0; i < aNumSets; ++i) {
+				auto& bound = bp.mDescriptorSets[aFirstSet + i];
+				bound.mHandle = aSets[i];
+				bound.mFirstSetOfCommand = aFirstSet;
+				bound.mNumSetsOfCommand = aNumSets;
+				bound.mDynamicOffsets.assign(aDynamicOffsets, aDynamicOffsets + aNumDynamicOffsets);
+			}
+		}
+		handle().bindDescriptorSets(aBindPoint, aLayout, aFirstSet, aNumSets, aSets, aNumDynamicOffsets, aDynamicOffsets);
+	}
 
-		// 1. Compile and store the one and only shader:
-		if (!aConfig.mShaderInfo.has_value()) {
-			throw avk::logic_error("Shader missing in compute_pipeline_config! A compute pipeline can not be constructed without a shader.");
+	void command_buffer_t::bind_vertex_buffers(uint32_t aFirstBinding, uint32_t aNumBuffers, const vk::Buffer* aBuffers, const vk::DeviceSize* aOffsets)
+	{
+		if (0u == aNumBuffers) {
+			return;
 		}
-		//    Compile the shader
-		result.mShader = create_shader(aConfig.mShaderInfo.value());
-		assert(result.mShader.has_been_built());
-		//    Just fill in the create struct
-		result.mShaderStageCreateInfo = vk::PipelineShaderStageCreateInfo{}
-			.setStage(to_vk_shader_stage(result.mShader.info().mShaderType))
-			.setModule(result.mShader.handle())
-			.setPName(result.mShader.info().mEntryPoint.c_str());
-		if (result.mShader.info().mSpecializationConstants.has_value()) {
-			result.mSpecializationInfo = vk::SpecializationInfo{
-				result.mShader.info().mSpecializationConstants.value().num_entries(),
-				result.mShader.info().mSpecializationConstants.value().mMapEntries.data(),
-				result.mShader.info().mSpecializationConstants.value().data_size(),
-				result.mShader.info().mSpecializationConstants.value().mData.data()
-			};
-			// Add it to the stageCreateInfo:
-			result.mShaderStageCreateInfo.setPSpecializationInfo(&result.mSpecializationInfo.value());
+		auto& bound = mBoundState.mVertexBuffers;
+		if (mEliminateRedundantState && aFirstBinding + aNumBuffers <= bound.size()) {
+			bool allBound = true;
+			for (uint32_t i = 0; allBound && i < aNumBuffers; ++i) {
+				// A null handle denotes an unknown binding (binding null buffers is never skipped):
+				allBound = std::get<vk::Buffer>(bound[aFirstBinding + i]) && bound[aFirstBinding + i] == std::make_tuple(aBuffers[i], aOffsets[i]);
+			}
+			if (allBound) {
+				++mNumElidedCalls;
+				return;
+			}
+		}
+		if (bound.size() < aFirstBinding + aNumBuffers) {
+			bound.resize(aFirstBinding + aNumBuffers);
+		}
+		for (uint32_t i = 0; i < aNumBuffers; ++i) {
+			bound[aFirstBinding + i] = std::make_tuple(aBuffers[i], aOffsets[i]);
 		}
+		handle().bindVertexBuffers(aFirstBinding, aNumBuffers, aBuffers, aOffsets);
+	}
 
-		// 2. Flags
-		// TODO: Support all flags (only one of the flags is handled at the moment)
-		result.mPipelineCreateFlags = {};
-		if ((aConfig.mPipelineSettings & cfg::pipeline_settings::disable_optimization) == cfg::pipeline_settings::disable_optimization) {
-			result.mPipelineCreateFlags |= vk::PipelineCreateFlagBits::eDisableOptimization;
+	void command_buffer_t::bind_index_buffer(vk::Buffer aBuffer, vk::DeviceSize aOffset, vk::IndexType aIndexType)
+	{
+		auto indexBuffer = std::make_tuple(aBuffer, aOffset, aIndexType);
+		if (mEliminateRedundantState && mBoundState.mIndexBuffer == indexBuffer) {
+			++mNumElidedCalls;
+			return;
 		}
+		mBoundState.mIndexBuffer = indexBuffer;
+		handle().bindIndexBuffer(aBuffer, aOffset, aIndexType);
+	}
 
-		// 3. Compile the PIPELINE LAYOUT data and create-info
-		// Get the descriptor set layouts
-		result.mAllDescriptorSetLayouts = set_of_descriptor_set_layouts::prepare(std::move(aConfig.mResourceBindings));
-		allocate_set_of_descriptor_set_layouts(result.mAllDescriptorSetLayouts);
+	void command_buffer_t::push_constants(vk::PipelineLayout aLayout, vk::ShaderStageFlags aStages, uint32_t aOffset, uint32_t aSize, const void* aData)
+	{
+		auto& bound = mBoundState.mPushConstants;
+		if (mBoundState.mPushConstantsLayout != aLayout) {
+			mBoundState.mPushConstantsLayout = aLayout;
+			bound.clear();
+		}
 
-		// Gather the push constant data
-		result.mPushConstantRanges.reserve(aConfig.mPushConstantsBindings.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
-		for (const auto& pcBinding : aConfig.mPushConstantsBindings) {
-			result.mPushConstantRanges.push_back(vk::PushConstantRange{}
-				.setStageFlags(to_vk_shader_stages(pcBinding.mShaderStages))
-				.setOffset(static_cast<uint32_t>(pcBinding.mOffset))
-				.setSize(static_cast<uint32_t>(pcBinding.mSize))
-			);
-			// TODO: Push Constants need a prettier interface
+		const auto* bytes = static_cast<const uint8_t*>(aData);
+		auto exactRange = std::find_if(bound.begin(), bound.end(), [aStages, aOffset, aSize](const bound_push_constants& r) {
+			return r.mStages == aStages && r.mOffset == aOffset && r.mData.size() == aSize;
+		});
+		if (mEliminateRedundantState && exactRange != bound.end() && memory_equal(exactRange->mData.data(), bytes, aSize)) {
+			++mNumElidedCalls;
+			return;
 		}
 
-		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
-		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
-			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
-			.setPSetLayouts(descriptorSetLayoutHandles.data())
-			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
-			.setPPushConstantRanges(result.mPushConstantRanges.data());
+		const bool hasExactRange = exactRange != bound.end();
+		if (hasExactRange) {
+			std::copy(bytes, bytes + aSize, exactRange->mData.begin());
+		}
+		// Other ranges which overlap the updated bytes of one of the stages are not up to date anymore:
+		bound.erase(std::remove_if(bound.begin(), bound.end(), [aStages, aOffset, aSize, lExact = hasExactRange ? &*exactRange : nullptr](const bound_push_constants& r) {
+			return &r != lExact && (r.mStages & aStages) && r.mOffset < aOffset + aSize && aOffset < r.mOffset + static_cast<uint32_t>(r.mData.size());
+		}), bound.end());
+		if (!hasExactRange) {
+			bound.push_back(bound_push_constants{ aStages, aOffset, std::vector<uint8_t>(bytes, bytes + aSize) });
+		}
+		handle().pushConstants(aLayout, aStages, aOffset, aSize, aData);
+	}
 
-		// 4. Maybe alter the config?!
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(result);
+	void command_buffer_t::set_viewport(uint32_t aFirstViewport, uint32_t aNumViewports, const vk::Viewport* aViewports)
+	{
+		auto& bound = mBoundState.mViewports;
+		if (mEliminateRedundantState && aFirstViewport + aNumViewports <= bound.size() && std::equal(aViewports, aViewports + aNumViewports, bound.begin() + aFirstViewport)) {
+			++mNumElidedCalls;
+			return;
+		}
+		if (bound.size() < aFirstViewport + aNumViewports) {
+			bound.resize(aFirstViewport + aNumViewports);
 		}
+		std::copy(aViewports, aViewports + aNumViewports, bound.begin() + aFirstViewport);
+		handle().setViewport(aFirstViewport, aNumViewports, aViewports);
+	}
 
-		rewire_config_and_create_compute_pipeline(result);
-		return result;
+	void command_buffer_t::set_scissor(uint32_t aFirstScissor, uint32_t aNumScissors, const vk::Rect2D* aScissors)
+	{
+		auto& bound = mBoundState.mScissors;
+		if (mEliminateRedundantState && aFirstScissor + aNumScissors <= bound.size() && std::equal(aScissors, aScissors + aNumScissors, bound.begin() + aFirstScissor)) {
+			++mNumElidedCalls;
+			return;
+		}
+		if (bound.size() < aFirstScissor + aNumScissors) {
+			bound.resize(aFirstScissor + aNumScissors);
+		}
+		std::copy(aScissors, aScissors + aNumScissors, bound.begin() + aFirstScissor);
+		handle().setScissor(aFirstScissor, aNumScissors, aScissors);
 	}
+#pragma endregion
 
-	compute_pipeline root::create_compute_pipeline_from_template(const compute_pipeline_t& aTemplate, std::function<void(compute_pipeline_t&)> aAlterConfigBeforeCreation)
+#pragma region command pool manager definitions
+	void command_pool_manager_t::begin_frame(uint64_t aRetireValue, std::optional<uint64_t> aCompletedValue)
 	{
-		compute_pipeline_t result;
-		result.mPipelineCreateFlags			= aTemplate.mPipelineCreateFlags;
-		result.mShader						= create_shader_from_template(aTemplate.mShader);
-		result.mShaderStageCreateInfo		= aTemplate.mShaderStageCreateInfo;
-		result.mSpecializationInfo			= aTemplate.mSpecializationInfo;
-		result.mBasePipelineIndex			= aTemplate.mBasePipelineIndex;
-		result.mAllDescriptorSetLayouts		= create_set_of_descriptor_set_layouts_from_template(aTemplate.mAllDescriptorSetLayouts);
-		result.mPushConstantRanges			= aTemplate.mPushConstantRanges;
-		result.mPipelineLayoutCreateInfo	= aTemplate.mPipelineLayoutCreateInfo;
+		mCurrentFrameSlot = static_cast<size_t>(aRetireValue % mFrameSlots.size());
+		auto& slot = mFrameSlots[mCurrentFrameSlot];
+		if (aCompletedValue.has_value() && slot.mRetireValue.has_value() && slot.mRetireValue.value() > aCompletedValue.value()) {
+			throw avk::logic_error("Frame slot " + std::to_string(mCurrentFrameSlot) + " of the command_pool_manager is still in use (retire value " + std::to_string(slot.mRetireValue.value()) + ", but only " + std::to_string(aCompletedValue.value()) + " has been completed).");
+		}
 
-		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
-		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
-			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
-			.setPSetLayouts(descriptorSetLayoutHandles.data())
-			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
-			.setPPushConstantRanges(result.mPushConstantRanges.data());
+		for (auto& entry : slot.mPools) {
+			if (0 == entry->mNumInUse[0] && 0 == entry->mNumInUse[1]) {
+				continue;
+			}
+			for (size_t level = 0; level < entry->mCommandBuffers.size(); ++level) {
+				for (size_t i = 0; i < entry->mNumInUse[level]; ++i) {
+					entry->mCommandBuffers[level][i]->prepare_for_reuse();
+				}
+				entry->mNumInUse[level] = 0;
+			}
+			// Resets all command buffers of the pool at once, but keeps their memory for the next frames:
+			mRoot->device().resetCommandPool(entry->mPool->handle(), vk::CommandPoolResetFlags{}, mRoot->dispatch_loader_core());
+		}
+		slot.mRetireValue = aRetireValue;
+	}
 
-		// 4. Maybe alter the config?!
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(result);
+	command_pool_manager_t::pool_entry& command_pool_manager_t::get_pool_entry_of_current_thread(uint32_t aQueueFamilyIndex)
+	{
+		const auto threadId = std::this_thread::get_id();
+		std::scoped_lock<std::mutex> guard(*mMutex);
+		auto& slot = mFrameSlots[mCurrentFrameSlot];
+		for (auto& entry : slot.mPools) {
+			if (entry->mThreadId == threadId && entry->mQueueFamilyIndex == aQueueFamilyIndex) {
+				return *entry;
+			}
 		}
 
-		rewire_config_and_create_compute_pipeline(result);
-		return result;
+		auto entry = std::make_unique<pool_entry>();
+		entry->mThreadId = threadId;
+		entry->mQueueFamilyIndex = aQueueFamilyIndex;
+		entry->mPool = mRoot->create_command_pool(aQueueFamilyIndex, vk::CommandPoolCreateFlagBits::eTransient);
+		return *slot.mPools.emplace_back(std::move(entry));
 	}
-#pragma endregion
-
-#pragma region descriptor alloc request
-	descriptor_alloc_request::descriptor_alloc_request()
-		: mNumSets{ 0u }
-	{}
 
-	descriptor_alloc_request::descriptor_alloc_request(const std::vector<std::reference_wrapper<const descriptor_set_layout>>& aLayouts)
+	command_buffer_t& command_pool_manager_t::get_command_buffer(uint32_t aQueueFamilyIndex, vk::CommandBufferUsageFlags aUsageFlags, vk::CommandBufferLevel aLevel)
 	{
-		mNumSets = static_cast<uint32_t>(aLayouts.size());
+		// Only the calling thread accesses its own pool entries => no need to keep the lock:
+		auto& entry = get_pool_entry_of_current_thread(aQueueFamilyIndex);
+		const size_t level = vk::CommandBufferLevel::ePrimary == aLevel ? 0 : 1;
+		auto& buffers = entry.mCommandBuffers[level];
+		auto& numInUse = entry.mNumInUse[level];
 
-		for (const auto& layout : aLayouts) {
-			// Accumulate all the memory requirements of all the sets
-			for (const auto& entry : layout.get().required_pool_sizes()) {
-				auto it = std::lower_bound(std::begin(mAccumulatedSizes), std::end(mAccumulatedSizes),
-					entry,
-					[](const vk::DescriptorPoolSize& first, const vk::DescriptorPoolSize& second) -> bool {
-						using EnumType = std::underlying_type<vk::DescriptorType>::type;
-						return static_cast<EnumType>(first.type) < static_cast<EnumType>(second.type);
-					});
-				if (it != std::end(mAccumulatedSizes) && it->type == entry.type) {
-					it->descriptorCount += entry.descriptorCount;
-				}
-				else {
-					mAccumulatedSizes.insert(it, entry);
-				}
+		if (numInUse == buffers.size()) {
+			// Free list is exhausted => grow geometrically, s.t. only a few allocations happen during warm-up:
+			const auto count = static_cast<uint32_t>(std::max(buffers.size(), size_t{ 1 }));
+			for (auto& cb : entry.mPool->alloc_command_buffers(count, aUsageFlags, aLevel)) {
+				buffers.push_back(std::move(cb));
 			}
 		}
+
+		auto& result = buffers[numInUse++].get();
+		result.mBeginInfo = vk::CommandBufferBeginInfo()
+			.setFlags(aUsageFlags)
+			.setPInheritanceInfo(nullptr);
+		result.mState = command_buffer_state::none;
+		return result;
 	}
 
-	void descriptor_alloc_request::add_size_requirements(vk::DescriptorPoolSize aToAdd)
+	size_t command_pool_manager_t::number_of_command_pools() const
 	{
-		auto it = std::lower_bound(std::begin(mAccumulatedSizes), std::end(mAccumulatedSizes),
-			aToAdd,
-			[](const vk::DescriptorPoolSize& first, const vk::DescriptorPoolSize& second) -> bool {
-				using EnumType = std::underlying_type<vk::DescriptorType>::type;
-				return static_cast<EnumType>(first.type) < static_cast<EnumType>(second.type);
-			});
-		if (it != std::end(mAccumulatedSizes) && it->type == aToAdd.type) {
-			it->descriptorCount += aToAdd.descriptorCount;
-		}
-		else {
-			mAccumulatedSizes.insert(it, aToAdd);
+		std::scoped_lock<std::mutex> guard(*mMutex);
+		size_t n = 0;
+		for (const auto& slot : mFrameSlots) {
+			n += slot.mPools.size();
 		}
+		return n;
 	}
 
-	descriptor_alloc_request descriptor_alloc_request::multiply_size_requirements(uint32_t mFactor) const
+	size_t command_pool_manager_t::number_of_command_buffers() const
 	{
-		auto copy = descriptor_alloc_request{*this};
-		for (auto& sr : copy.mAccumulatedSizes) {
-			sr.descriptorCount *= mFactor;
+		std::scoped_lock<std::mutex> guard(*mMutex);
+		size_t n = 0;
+		for (const auto& slot : mFrameSlots) {
+			for (const auto& entry : slot.mPools) {
+				n += entry->mCommandBuffers[0].size() + entry->mCommandBuffers[1].size();
+			}
 		}
-		return copy;
+		return n;
 	}
-#pragma endregion
 
-#pragma region descriptor pool definitions
-	descriptor_pool root::create_descriptor_pool(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, const std::vector<vk::DescriptorPoolSize>& aSizeRequirements, int aNumSets)
+	command_pool_manager root::create_command_pool_manager(size_t aNumberOfFramesInFlight)
 	{
-		descriptor_pool result;
-		result.mInitialCapacities = aSizeRequirements;
-		result.mRemainingCapacities = aSizeRequirements;
-		result.mNumInitialSets = aNumSets;
-		result.mNumRemainingSets = aNumSets;
-
-		// Create it:
-		auto createInfo = vk::DescriptorPoolCreateInfo()
-			.setPoolSizeCount(static_cast<uint32_t>(result.mInitialCapacities.size()))
-			.setPPoolSizes(result.mInitialCapacities.data())
-			.setMaxSets(aNumSets)
-			.setFlags(vk::DescriptorPoolCreateFlags()); // The structure has an optional flag similar to command pools that determines if individual descriptor sets can be freed or not: VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT. We're not going to touch the descriptor set after creating it, so we don't need this flag. [10]
-		result.mDescriptorPool = aDevice.createDescriptorPoolUnique(createInfo, nullptr, aDispatchLoader);
-
-		AVK_LOG_DEBUG("Allocated pool with flags[" + vk::to_string(createInfo.flags) + "], maxSets[" + std::to_string(createInfo.maxSets) + "], remaining-sets[" + std::to_string(result.mNumRemainingSets) + "], size-entries[" + std::to_string(createInfo.poolSizeCount) + "]");
-#if defined(_DEBUG)
-		for (size_t i=0; i < aSizeRequirements.size(); ++i) {
-			AVK_LOG_DEBUG_VERBOSE("          [" + std::to_string(i) + "]: descriptorCount[" + std::to_string(aSizeRequirements[i].descriptorCount) + "], descriptorType[" + vk::to_string(aSizeRequirements[i].type) + "]");
+		if (0 == aNumberOfFramesInFlight) {
+			throw avk::logic_error("A command_pool_manager requires at least one frame in flight.");
 		}
-#endif
 
+		command_pool_manager_t result;
+		result.mRoot = this;
+		result.mFrameSlots.resize(aNumberOfFramesInFlight);
 		return result;
 	}
+#pragma endregion
 
-	descriptor_pool root::create_descriptor_pool(const std::vector<vk::DescriptorPoolSize>& aSizeRequirements, int aNumSets)
+#pragma region command stream definitions
+	void command_stream::clear()
 	{
-		return create_descriptor_pool(device(), dispatch_loader_core(), aSizeRequirements, aNumSets);
+		for (auto* header = mFirst; nullptr != header; header = header->mNext) {
+			if (command_stream_record_type::custom == header->mType) {
+				const auto* rec = reinterpret_cast<const custom_record*>(header + 1);
+				if (nullptr != rec->mDestroy) {
+					rec->mDestroy(const_cast<custom_record*>(rec) + 1);
+				}
+			}
+		}
+		mFirst = nullptr;
+		mLast = nullptr;
+		mNumRecords = 0;
+		mCurrentBlock = 0;
+		mCurrentOffset = 0;
 	}
 
-	bool descriptor_pool::has_capacity_for(const descriptor_alloc_request& pRequest) const
+	size_t command_stream::capacity() const
 	{
-		if (mNumRemainingSets < static_cast<int>(pRequest.num_sets())) {
-			return false;
-		}
-
-		const auto& weNeed = pRequest.accumulated_pool_sizes();
-		const auto& weHave = mRemainingCapacities;
-
-#ifdef _DEBUG
-		for (size_t i = 0; i < weNeed.size() - 1; ++i) {
-			assert(weNeed[i].type < weNeed[i + 1].type);
-		}
-		for (size_t i = 0; i < weHave.size() - 1; ++i) {
-			assert(weHave[i].type < weHave[i + 1].type);
+		size_t result = 0;
+		for (const auto& b : mBlocks) {
+			result += b.mSize;
 		}
-#endif
+		return result;
+	}
 
-		// Accumulate all the requirements of all the sets
-		using EnumType = std::underlying_type<vk::DescriptorType>::type;
-		size_t n = 0, h = 0, N = weNeed.size(), H = weHave.size();
-		while (n < N && h < H) {
-			auto needType = static_cast<EnumType>(weNeed[n].type);
-			auto haveType = static_cast<EnumType>(weHave[h].type);
-			if (haveType < needType) {
-				h++;
-				continue;
-			}
-			if (needType == haveType && weNeed[n].descriptorCount <= weHave[n].descriptorCount) {
-				n++;
-				h++;
-				continue;
+	void* command_stream::allocate(size_t aSize)
+	{
+		// Keep all records aligned to record_header's alignment:
+		aSize = (aSize + alignof(record_header) - 1) / alignof(record_header) * alignof(record_header);
+		while (mCurrentBlock < mBlocks.size()) {
+			if (mCurrentOffset + aSize <= mBlocks[mCurrentBlock].mSize) {
+				auto* result = mBlocks[mCurrentBlock].mData.get() + mCurrentOffset;
+				mCurrentOffset += aSize;
+				return result;
 			}
-			return false;
+			++mCurrentBlock;
+			mCurrentOffset = 0;
 		}
-		return n == N; // if true => all checks have passed, if false => checks failed
+		const auto blockSize = std::max(static_cast<size_t>(AVK_COMMAND_STREAM_BLOCK_SIZE), aSize);
+		mBlocks.push_back(block{ std::make_unique<std::byte[]>(blockSize), blockSize });
+		mCurrentBlock = mBlocks.size() - 1;
+		mCurrentOffset = aSize;
+		return mBlocks.back().mData.get();
 	}
 
-	std::vector<vk::DescriptorSet> descriptor_pool::allocate(const std::vector<std::reference_wrapper<const descriptor_set_layout>>& aLayouts)
+	void command_stream::record_into(avk::command_buffer_t& aCommandBuffer) const
 	{
-		std::vector<vk::DescriptorSetLayout> setLayouts;
-		setLayouts.reserve(aLayouts.size());
-		for (auto& in : aLayouts) {
-			setLayouts.emplace_back(in.get().handle());
-		}
-
-		auto allocInfo = vk::DescriptorSetAllocateInfo()
-			.setDescriptorPool(mDescriptorPool.get())
-			.setDescriptorSetCount(static_cast<uint32_t>(setLayouts.size()))
-			.setPSetLayouts(setLayouts.data());
-
-		AVK_LOG_DEBUG_VERBOSE("Allocating from pool with remaining-sets[" + std::to_string(mNumRemainingSets) + "] and remaining-capacities:");
-#if defined(_DEBUG)
-		for (size_t i=0; i < mRemainingCapacities.size(); ++i) {
-			AVK_LOG_DEBUG_VERBOSE("          [" + std::to_string(i) + "]: descriptorCount[" + std::to_string(mRemainingCapacities[i].descriptorCount) + "], descriptorType[" + vk::to_string(mRemainingCapacities[i].type) + "]");
-		}
+		const auto& cb = aCommandBuffer.handle();
+		// State commands go through aCommandBuffer, s.t. redundant ones are skipped:
+		for (const auto* header = mFirst; nullptr != header; header = header->mNext) {
+			const auto* payload = header + 1;
+			switch (header->mType) {
+			case command_stream_record_type::bind_pipeline: {
+				const auto* rec = reinterpret_cast<const bind_pipeline_record*>(payload);
+				aCommandBuffer.bind_pipeline(rec->mBindPoint, rec->mPipeline);
+				break;
+			}
+			case command_stream_record_type::bind_descriptor_sets: {
+				const auto* rec = reinterpret_cast<const bind_descriptor_sets_record*>(payload);
+				const auto* sets = reinterpret_cast<const vk::DescriptorSet*>(rec + 1);
+				const auto* dynamicOffsets = reinterpret_cast<const uint32_t*>(reinterpret_cast<const std::byte*>(sets) + align_to_8(sizeof(vk::DescriptorSet) * rec->mNumSets));
+				aCommandBuffer.bind_descriptor_sets(rec->mBindPoint, rec->mLayout, rec->mFirstSet, rec->mNumSets, sets, rec->mNumDynamicOffsets, dynamicOffsets);
+				break;
+			}
+			case command_stream_record_type::bind_vertex_buffers: {
+				const auto* rec = reinterpret_cast<const bind_vertex_buffers_record*>(payload);
+				const auto* buffers = reinterpret_cast<const vk::Buffer*>(rec + 1);
+				const auto* offsets = reinterpret_cast<const vk::DeviceSize*>(buffers + rec->mNumBuffers);
+				aCommandBuffer.bind_vertex_buffers(rec->mFirstBinding, rec->mNumBuffers, buffers, offsets);
+				break;
+			}
+			case command_stream_record_type::bind_index_buffer: {
+				const auto* rec = reinterpret_cast<const bind_index_buffer_record*>(payload);
+				aCommandBuffer.bind_index_buffer(rec->mBuffer, rec->mOffset, rec->mIndexType);
+				break;
+			}
+			case command_stream_record_type::push_constants: {
+				const auto* rec = reinterpret_cast<const push_constants_record*>(payload);
+				aCommandBuffer.push_constants(rec->mLayout, rec->mStages, rec->mOffset, rec->mSize, rec + 1);
+				break;
+			}
+			case command_stream_record_type::set_viewport: {
+				const auto* rec = reinterpret_cast<const set_viewport_record*>(payload);
+				aCommandBuffer.set_viewport(rec->mFirst, rec->mCount, reinterpret_cast<const vk::Viewport*>(rec + 1));
+				break;
+			}
+			case command_stream_record_type::set_scissor: {
+				const auto* rec = reinterpret_cast<const set_scissor_record*>(payload);
+				aCommandBuffer.set_scissor(rec->mFirst, rec->mCount, reinterpret_cast<const vk::Rect2D*>(rec + 1));
+				break;
+			}
+			case command_stream_record_type::draw: {
+				const auto* rec = reinterpret_cast<const draw_record*>(payload);
+				cb.draw(rec->mVertexCount, rec->mInstanceCount, rec->mFirstVertex, rec->mFirstInstance);
+				break;
+			}
+			case command_stream_record_type::draw_indexed: {
+				const auto* rec = reinterpret_cast<const draw_indexed_record*>(payload);
+				cb.drawIndexed(rec->mIndexCount, rec->mInstanceCount, rec->mFirstIndex, rec->mVertexOffset, rec->mFirstInstance);
+				break;
+			}
+			case command_stream_record_type::draw_indirect: {
+				const auto* rec = reinterpret_cast<const draw_indirect_record*>(payload);
+				cb.drawIndirect(rec->mBuffer, rec->mOffset, rec->mDrawCount, rec->mStride);
+				break;
+			}
+			case command_stream_record_type::draw_indexed_indirect: {
+				const auto* rec = reinterpret_cast<const draw_indirect_record*>(payload);
+				cb.drawIndexedIndirect(rec->mBuffer, rec->mOffset, rec->mDrawCount, rec->mStride);
+				break;
+			}
+			case command_stream_record_type::dispatch: {
+				const auto* rec = reinterpret_cast<const dispatch_record*>(payload);
+				cb.dispatch(rec->mGroupCountX, rec->mGroupCountY, rec->mGroupCountZ);
+				break;
+			}
+			case command_stream_record_type::dispatch_indirect: {
+				const auto* rec = reinterpret_cast<const dispatch_indirect_record*>(payload);
+				cb.dispatchIndirect(rec->mBuffer, rec->mOffset);
+				break;
+			}
+			case command_stream_record_type::copy_buffer: {
+				const auto* rec = reinterpret_cast<const copy_buffer_record*>(payload);
+				cb.copyBuffer(rec->mSrc, rec->mDst, rec->mNumRegions, reinterpret_cast<const vk::BufferCopy*>(rec + 1));
+				break;
+			}
+			case command_stream_record_type::pipeline_barrier: {
+				const auto* rec = reinterpret_cast<const pipeline_barrier_record*>(payload);
+				const auto* memoryBarriers = reinterpret_cast<const vk::MemoryBarrier2KHR*>(rec + 1);
+				const auto* bufferBarriers = reinterpret_cast<const vk::BufferMemoryBarrier2KHR*>(memoryBarriers + rec->mNumMemoryBarriers);
+				const auto* imageBarriers = reinterpret_cast<const vk::ImageMemoryBarrier2KHR*>(bufferBarriers + rec->mNumBufferBarriers);
+				auto dependencyInfo = vk::DependencyInfoKHR{}
+					.setMemoryBarrierCount(rec->mNumMemoryBarriers)
+					.setPMemoryBarriers(memoryBarriers)
+					.setBufferMemoryBarrierCount(rec->mNumBufferBarriers)
+					.setPBufferMemoryBarriers(bufferBarriers)
+					.setImageMemoryBarrierCount(rec->mNumImageBarriers)
+					.setPImageMemoryBarriers(imageBarriers);
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				cb.pipelineBarrier2KHR(dependencyInfo, aCommandBuffer.root_ptr()->dispatch_loader_ext());
+#else
+				cb.pipelineBarrier2(dependencyInfo, aCommandBuffer.root_ptr()->dispatch_loader_core());
 #endif
-		AVK_LOG_DEBUG_VERBOSE("...going to allocate " + std::to_string(aLayouts.size()) + " set(s) of the following:");
-#if defined(_DEBUG)
-		for (size_t i=0; i < aLayouts.size(); ++i) {
-			AVK_LOG_DEBUG_VERBOSE("          [" + std::to_string(i) + "]: number_of_bindings[" + std::to_string(aLayouts[i].get().number_of_bindings()) + "]");
-			for (size_t j=0; j < aLayouts[i].get().number_of_bindings(); j++) {
-				AVK_LOG_DEBUG_VERBOSE("               [" + std::to_string(j) + "]: descriptorCount[" + std::to_string(aLayouts[i].get().binding_at(j).descriptorCount) + "], descriptorType[" + vk::to_string(aLayouts[i].get().binding_at(j).descriptorType) + "]");
+				break;
+			}
+			case command_stream_record_type::custom: {
+				const auto* rec = reinterpret_cast<const custom_record*>(payload);
+				rec->mInvoke(const_cast<custom_record*>(rec) + 1, aCommandBuffer);
+				aCommandBuffer.invalidate_bound_state();
+				break;
 			}
-			AVK_LOG_DEBUG_VERBOSE("          [" + std::to_string(i) + "]: required pool sizes (whatever the difference to 'bindings' is)");
-			auto& rps = aLayouts[i].get().required_pool_sizes();
-			for (size_t j=0; j < rps.size(); j++) {
-				AVK_LOG_DEBUG_VERBOSE("               [" + std::to_string(j) + "]: descriptorCount[" + std::to_string(rps[j].descriptorCount) + "], descriptorType[" + vk::to_string(rps[j].type) + "]");
 			}
 		}
-#endif
+	}
+#pragma endregion
 
-		assert(mDescriptorPool);
-		auto result = mDescriptorPool.getOwner().allocateDescriptorSets(allocInfo);
+#pragma region compute pipeline definitions
+	void root::rewire_config_and_create_compute_pipeline(compute_pipeline_t& aPreparedPipeline)
+	{
+		aPreparedPipeline.mShaderStageCreateInfo
+			.setModule(aPreparedPipeline.mShader.handle())
+			.setPName(aPreparedPipeline.mShader.info().mEntryPoint.c_str());
 
-		// Update the pool's stats:
-		for (const descriptor_set_layout& dsl : aLayouts) {
-			for (const auto& dps : dsl.required_pool_sizes()) {
-				auto it = std::find_if(std::begin(mRemainingCapacities), std::end(mRemainingCapacities), [&dps](vk::DescriptorPoolSize& el){
-					return el.type == dps.type;
-				});
-				if (std::end(mRemainingCapacities) == it) {
-					AVK_LOG_WARNING("Couldn't find the descriptor type that we have just allocated in mRemainingCapacities. How could this have happened?");
-				}
-				else {
-					it->descriptorCount -= std::min(dps.descriptorCount, it->descriptorCount);
-				}
-			}
+		if (aPreparedPipeline.mSpecializationInfo.has_value()) {
+			assert(aPreparedPipeline.mShader.info().mSpecializationConstants.has_value());
+			aPreparedPipeline.mSpecializationInfo.value().pMapEntries = aPreparedPipeline.mShader.info().mSpecializationConstants.value().mMapEntries.data();
+			aPreparedPipeline.mSpecializationInfo.value().pData = aPreparedPipeline.mShader.info().mSpecializationConstants.value().mData.data();
+			aPreparedPipeline.mShaderStageCreateInfo.setPSpecializationInfo(&aPreparedPipeline.mSpecializationInfo.value());
 		}
 
-		mNumRemainingSets -= static_cast<int>(aLayouts.size());
+		// Layout must already be configured and created properly!
 
-		return result;
-	}
+		// Create the PIPELINE LAYOUT
+		aPreparedPipeline.mPipelineLayout = device().createPipelineLayoutUnique(aPreparedPipeline.mPipelineLayoutCreateInfo, nullptr, dispatch_loader_core());
+		assert(static_cast<bool>(aPreparedPipeline.layout_handle()));
 
-	void descriptor_pool::reset()
-	{
-		mDescriptorPool.getOwner().resetDescriptorPool(mDescriptorPool.get());
-		mRemainingCapacities = mInitialCapacities;
-		mNumRemainingSets = mNumInitialSets;
+		// Create the PIPELINE, a.k.a. putting it all together:
+		auto pipelineInfo = vk::ComputePipelineCreateInfo{}
+			.setFlags(aPreparedPipeline.mPipelineCreateFlags)
+			.setStage(aPreparedPipeline.mShaderStageCreateInfo)
+			.setLayout(aPreparedPipeline.layout_handle())
+			.setBasePipelineHandle(nullptr) // Optional
+			.setBasePipelineIndex(-1); // Optional
+#if VK_HEADER_VERSION >= 141
+		auto result = device().createComputePipelineUnique(nullptr, pipelineInfo, nullptr, dispatch_loader_core());
+		aPreparedPipeline.mPipeline = std::move(result.value);
+#else
+		aPreparedPipeline.mPipeline = device().createComputePipelineUnique(nullptr, pipelineInfo);
+#endif
 	}
 
-	descriptor_cache root::create_descriptor_cache(std::string aName)
+	compute_pipeline root::create_compute_pipeline(compute_pipeline_config aConfig, std::function<void(compute_pipeline_t&)> aAlterConfigBeforeCreation)
 	{
-		if (aName.empty()) {
-			static int sDescCacheId = 1;
-			aName = "Descriptor Cache #" + std::to_string(sDescCacheId++);
-		}
+		compute_pipeline_t result;
 
-		descriptor_cache_t result;
-		result.mName = std::move(aName);
-		result.mRoot = this;
+		// 1. Compile and store the one and only shader:
+		if (!aConfig.mShaderInfo.has_value()) {
+			throw avk::logic_error("Shader missing in compute_pipeline_config! A compute pipeline can not be constructed without a shader.");
+		}
+		//    Compile the shader
+		result.mShader = create_shader(aConfig.mShaderInfo.value());
+		assert(result.mShader.has_been_built());
+		//    Just fill in the create struct
+		result.mShaderStageCreateInfo = vk::PipelineShaderStageCreateInfo{}
+			.setStage(to_vk_shader_stage(result.mShader.info().mShaderType))
+			.setModule(result.mShader.handle())
+			.setPName(result.mShader.info().mEntryPoint.c_str());
+		if (result.mShader.info().mSpecializationConstants.has_value()) {
+			result.mSpecializationInfo = vk::SpecializationInfo{
+				result.mShader.info().mSpecializationConstants.value().num_entries(),
+				result.mShader.info().mSpecializationConstants.value().mMapEntries.data(),
+				result.mShader.info().mSpecializationConstants.value().data_size(),
+				result.mShader.info().mSpecializationConstants.value().mData.data()
+			};
+			// Add it to the stageCreateInfo:
+			result.mShaderStageCreateInfo.setPSpecializationInfo(&result.mSpecializationInfo.value());
+		}
+
+		// 2. Flags
+		// TODO: Support all flags (only one of the flags is handled at the moment)
+		result.mPipelineCreateFlags = {};
+		if ((aConfig.mPipelineSettings & cfg::pipeline_settings::disable_optimization) == cfg::pipeline_settings::disable_optimization) {
+			result.mPipelineCreateFlags |= vk::PipelineCreateFlagBits::eDisableOptimization;
+		}
+
+		// 3. Compile the PIPELINE LAYOUT data and create-info
+		// Get the descriptor set layouts
+		result.mAllDescriptorSetLayouts = set_of_descriptor_set_layouts::prepare(std::move(aConfig.mResourceBindings));
+		allocate_set_of_descriptor_set_layouts(result.mAllDescriptorSetLayouts);
+
+		// Gather the push constant data
+		result.mPushConstantRanges.reserve(aConfig.mPushConstantsBindings.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
+		for (const auto& pcBinding : aConfig.mPushConstantsBindings) {
+			result.mPushConstantRanges.push_back(vk::PushConstantRange{}
+				.setStageFlags(to_vk_shader_stages(pcBinding.mShaderStages))
+				.setOffset(static_cast<uint32_t>(pcBinding.mOffset))
+				.setSize(static_cast<uint32_t>(pcBinding.mSize))
+			);
+			// TODO: Push Constants need a prettier interface
+		}
+
+		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
+		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
+			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
+			.setPSetLayouts(descriptorSetLayoutHandles.data())
+			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
+			.setPPushConstantRanges(result.mPushConstantRanges.data());
+
+		// 4. Maybe alter the config?!
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		rewire_config_and_create_compute_pipeline(result);
 		return result;
 	}
-#pragma endregion
 
-#pragma region descriptor set layout definitions
+	compute_pipeline root::create_compute_pipeline_from_template(const compute_pipeline_t& aTemplate, std::function<void(compute_pipeline_t&)> aAlterConfigBeforeCreation)
+	{
+		compute_pipeline_t result;
+		result.mPipelineCreateFlags			= aTemplate.mPipelineCreateFlags;
+		result.mShader						= create_shader_from_template(aTemplate.mShader);
+		result.mShaderStageCreateInfo		= aTemplate.mShaderStageCreateInfo;
+		result.mSpecializationInfo			= aTemplate.mSpecializationInfo;
+		result.mBasePipelineIndex			= aTemplate.mBasePipelineIndex;
+		result.mAllDescriptorSetLayouts		= create_set_of_descriptor_set_layouts_from_template(aTemplate.mAllDescriptorSetLayouts);
+		result.mPushConstantRanges			= aTemplate.mPushConstantRanges;
+		result.mPipelineLayoutCreateInfo	= aTemplate.mPipelineLayoutCreateInfo;
 
-	bool operator ==(const descriptor_set_layout& left, const descriptor_set_layout& right) {
-		const auto n = left.mOrderedBindings.size();
-		if (n != right.mOrderedBindings.size()) {
-			return false;
-		}
-		for (size_t i = 0; i < n; ++i) {
-			if (left.mOrderedBindings[i] != right.mOrderedBindings[i]) {
-				return false;
-			}
+		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
+		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
+			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
+			.setPSetLayouts(descriptorSetLayoutHandles.data())
+			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
+			.setPPushConstantRanges(result.mPushConstantRanges.data());
+
+		// 4. Maybe alter the config?!
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
 		}
-		return true;
+
+		rewire_config_and_create_compute_pipeline(result);
+		return result;
 	}
+#pragma endregion
 
-	bool operator !=(const descriptor_set_layout& left, const descriptor_set_layout& right) {
-		return !(left == right);
+#pragma region deferred destruction queue definitions
+	deferred_destruction_queue::~deferred_destruction_queue()
+	{
+		const auto numPending = num_pending();
+		assert(0 == numPending);
+		if (0 != numPending) {
+			AVK_LOG_ERROR("The deferred_destruction_queue still contains " + std::to_string(numPending) + " resources upon destruction. They are destroyed now, which requires the device to still exist. Invoke release_all() before the device is destroyed.");
+		}
+		// Also waits for the background thread to finish all the batches which have been handed over to it:
+		release_all();
+		if (mBackgroundWorker.joinable()) {
+			{
+				std::scoped_lock lock(mBackgroundMutex);
+				mStopBackgroundWorker = true;
+			}
+			mBackgroundCondition.notify_all();
+			mBackgroundWorker.join();
+		}
 	}
 
-	void root::allocate_descriptor_set_layout(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, descriptor_set_layout& aLayoutToBeAllocated)
+	void deferred_destruction_queue::enqueue_destroy_function(uint64_t aRetireValue, avk::unique_function<void()> aDestroyFunction)
 	{
-		if (!aLayoutToBeAllocated.mLayout) {
-			// Allocate the layout and return the result:
-			auto createInfo = vk::DescriptorSetLayoutCreateInfo()
-				.setBindingCount(static_cast<uint32_t>(aLayoutToBeAllocated.mOrderedBindings.size()))
-				.setPBindings(aLayoutToBeAllocated.mOrderedBindings.data());
-			aLayoutToBeAllocated.mLayout = aDevice.createDescriptorSetLayoutUnique(createInfo, nullptr, aDispatchLoader);
+		std::scoped_lock lock(mMutex);
+		// Retire values are usually increasing => the common case is an append at the end:
+		if (mEntries.empty() || mEntries.back().mRetireValue <= aRetireValue) {
+			mEntries.push_back(entry{ aRetireValue, std::move(aDestroyFunction) });
 		}
 		else {
-			AVK_LOG_ERROR("descriptor_set_layout's handle already has a value => it most likely has already been allocated. Won't do it again.");
+			auto it = std::upper_bound(std::begin(mEntries), std::end(mEntries), aRetireValue, [](uint64_t aValue, const entry& aEntry) {
+				return aValue < aEntry.mRetireValue;
+			});
+			mEntries.insert(it, entry{ aRetireValue, std::move(aDestroyFunction) });
 		}
 	}
 
-	void root::allocate_descriptor_set_layout(descriptor_set_layout& aLayoutToBeAllocated)
+	std::vector<deferred_destruction_queue::entry> deferred_destruction_queue::take_up_to(uint64_t aCompletedValue)
 	{
-		return allocate_descriptor_set_layout(device(), dispatch_loader_core(), aLayoutToBeAllocated);
+		std::vector<entry> batch;
+		std::scoped_lock lock(mMutex);
+		while (!mEntries.empty() && mEntries.front().mRetireValue <= aCompletedValue) {
+			batch.push_back(std::move(mEntries.front()));
+			mEntries.pop_front();
+		}
+		return batch;
 	}
 
-	descriptor_set_layout root::create_descriptor_set_layout_from_template(const descriptor_set_layout& aTemplate)
+	void deferred_destruction_queue::destroy_batch(std::vector<entry>& aBatch)
 	{
-		descriptor_set_layout result;
-		result.mBindingRequirements = aTemplate.mBindingRequirements;
-		result.mOrderedBindings = aTemplate.mOrderedBindings;
-		allocate_descriptor_set_layout(result);
-		return result;
+		for (auto& e : aBatch) {
+			if (e.mDestroyFunction) {
+				e.mDestroyFunction();
+			}
+		}
+		aBatch.clear();
 	}
 
-	set_of_descriptor_set_layouts set_of_descriptor_set_layouts::prepare(std::vector<binding_data> pBindings)
+	size_t deferred_destruction_queue::release_up_to(uint64_t aCompletedValue, bool aInBackground)
 	{
-		set_of_descriptor_set_layouts result;
-		std::vector<binding_data> orderedBindings;
-		uint32_t minSetId = std::numeric_limits<uint32_t>::max();
-		uint32_t maxSetId = std::numeric_limits<uint32_t>::min();
-
-		// Step 1: order the bindings
-		for (auto& b : pBindings) {
-			minSetId = std::min(minSetId, b.mSetId);
-			maxSetId = std::max(maxSetId, b.mSetId);
-			auto it = std::lower_bound(std::begin(orderedBindings), std::end(orderedBindings), b); // use operator<
-			orderedBindings.insert(it, b);
+		auto batch = take_up_to(aCompletedValue);
+		const auto n = batch.size();
+		if (0 == n) {
+			return 0;
 		}
 
-		// Step 2: assemble the separate sets
-		result.mFirstSetId = minSetId;
-		result.mLayouts.reserve(maxSetId); // Also create layouts for sets that have no bindings, i.e. ALWAYS prepare ALL sets for EACH set-id from 0 to maxSetId
-		for (uint32_t setId = 0u; setId <= maxSetId; ++setId) {
-			auto lb = std::lower_bound(std::begin(orderedBindings), std::end(orderedBindings), binding_data{ setId },
-				[](const binding_data& first, const binding_data& second) -> bool {
-					return first.mSetId < second.mSetId;
-				});
-			auto ub = std::upper_bound(std::begin(orderedBindings), std::end(orderedBindings), binding_data{ setId },
-				[](const binding_data& first, const binding_data& second) -> bool {
-					return first.mSetId < second.mSetId;
-				});
-			// For empty sets, lb==ub, which means no descriptors will be regarded. This should be fine.
-			result.mLayouts.push_back(descriptor_set_layout::prepare(lb, ub));
+		if (!aInBackground) {
+			destroy_batch(batch);
+			return n;
 		}
 
-		// Step 3: Accumulate the binding requirements a.k.a. vk::DescriptorPoolSize entries
-		for (auto& dsl : result.mLayouts) {
-			for (auto& dps : dsl.required_pool_sizes()) {
-				// find position where to insert in vector
-				auto it = std::lower_bound(std::begin(result.mBindingRequirements), std::end(result.mBindingRequirements),
-					dps,
-					[](const vk::DescriptorPoolSize& first, const vk::DescriptorPoolSize& second) -> bool {
-						using EnumType = std::underlying_type<vk::DescriptorType>::type;
-						return static_cast<EnumType>(first.type) < static_cast<EnumType>(second.type);
-					});
-				// Maybe accumulate
-				if (it != std::end(result.mBindingRequirements) && it->type == dps.type) {
-					it->descriptorCount += dps.descriptorCount;
-				}
-				else {
-					result.mBindingRequirements.insert(it, dps);
-				}
+		{
+			std::scoped_lock lock(mBackgroundMutex);
+			mBackgroundBatches.push_back(std::move(batch));
+			if (!mBackgroundWorker.joinable()) {
+				mBackgroundWorker = std::thread(&deferred_destruction_queue::background_worker, this);
 			}
 		}
-
-		// Done with the preparation. (None of the descriptor_set_layout members have been allocated at this point.)
-		return result;
+		mBackgroundCondition.notify_all();
+		return n;
 	}
 
-	void root::allocate_set_of_descriptor_set_layouts(set_of_descriptor_set_layouts& aLayoutsToBeAllocated)
+	void deferred_destruction_queue::background_worker()
 	{
-		for (auto& dsl : aLayoutsToBeAllocated.mLayouts) {
-			allocate_descriptor_set_layout(dsl);
+		std::unique_lock lock(mBackgroundMutex);
+		while (true) {
+			mBackgroundCondition.wait(lock, [this] { return mStopBackgroundWorker || !mBackgroundBatches.empty(); });
+			if (mStopBackgroundWorker) {
+				// The destructor has waited for all batches before stopping the worker:
+				return;
+			}
+			auto batch = std::move(mBackgroundBatches.front());
+			mBackgroundBatches.pop_front();
+			mBackgroundBusy = true;
+			lock.unlock();
+			destroy_batch(batch);
+			lock.lock();
+			mBackgroundBusy = false;
+			mBackgroundCondition.notify_all();
 		}
 	}
 
-	set_of_descriptor_set_layouts root::create_set_of_descriptor_set_layouts_from_template(const set_of_descriptor_set_layouts& aTemplate)
+	void deferred_destruction_queue::wait_for_background_releases()
 	{
-		set_of_descriptor_set_layouts result;
-		result.mBindingRequirements = aTemplate.mBindingRequirements;
-		result.mFirstSetId = aTemplate.mFirstSetId;
-		for (const auto& lay : aTemplate.mLayouts) {
-			result.mLayouts.push_back(create_descriptor_set_layout_from_template(lay));
-		}
-		return result;
+		std::unique_lock lock(mBackgroundMutex);
+		mBackgroundCondition.wait(lock, [this] { return mBackgroundBatches.empty() && !mBackgroundBusy; });
 	}
 
-	std::vector<vk::DescriptorSetLayout> set_of_descriptor_set_layouts::layout_handles() const
+	size_t deferred_destruction_queue::release_all()
 	{
-		std::vector<vk::DescriptorSetLayout> allHandles;
-		allHandles.reserve(mLayouts.size());
-		for (const auto& dsl : mLayouts) {
-			allHandles.push_back(dsl.handle());
-		}
-		return allHandles;
+		// Destroying a resource can enqueue further resources (e.g., a command buffer hands over the resources whose
+		// lifetimes it handles) => repeat until nothing is pending anymore:
+		size_t numReleased = 0;
+		do {
+			wait_for_background_releases();
+			numReleased += release_up_to(std::numeric_limits<uint64_t>::max());
+		} while (0 != num_pending());
+		wait_for_background_releases();
+		return numReleased;
+	}
+
+	size_t deferred_destruction_queue::num_pending() const
+	{
+		std::scoped_lock lock(mMutex);
+		return mEntries.size();
 	}
 #pragma endregion
 
-#pragma region standard descriptor set
+#pragma region defragmenter definitions
+	defragmenter_t::defragmenter_t(defragmenter_t&& aOther) noexcept
+		: mRoot{ std::exchange(aOther.mRoot, nullptr) }
+		, mConfig{ aOther.mConfig }
+		, mBuffers{ std::move(aOther.mBuffers) }
+		, mImages{ std::move(aOther.mImages) }
+		, mImageViews{ std::move(aOther.mImageViews) }
+		, mBufferViews{ std::move(aOther.mBufferViews) }
+		, mDescriptorCaches{ std::move(aOther.mDescriptorCaches) }
+		, mPendingMoves{ std::move(aOther.mPendingMoves) }
+		, mPassInFlight{ std::exchange(aOther.mPassInFlight, false) }
+		, mFinished{ aOther.mFinished }
+#if defined(AVK_USES_VMA)
+		, mVmaContext{ std::exchange(aOther.mVmaContext, nullptr) }
+		, mVmaPass{ std::exchange(aOther.mVmaPass, VmaDefragmentationPassMoveInfo{}) }
+#else
+		, mNextIndex{ std::exchange(aOther.mNextIndex, 0) }
+#endif
+	{ }
+
+	defragmenter_t& defragmenter_t::operator=(defragmenter_t&& aOther) noexcept
+	{
+		std::swap(mRoot,             aOther.mRoot);
+		std::swap(mConfig,           aOther.mConfig);
+		std::swap(mBuffers,          aOther.mBuffers);
+		std::swap(mImages,           aOther.mImages);
+		std::swap(mImageViews,       aOther.mImageViews);
+		std::swap(mBufferViews,      aOther.mBufferViews);
+		std::swap(mDescriptorCaches, aOther.mDescriptorCaches);
+		std::swap(mPendingMoves,     aOther.mPendingMoves);
+		std::swap(mPassInFlight,     aOther.mPassInFlight);
+		std::swap(mFinished,         aOther.mFinished);
+#if defined(AVK_USES_VMA)
+		std::swap(mVmaContext,       aOther.mVmaContext);
+		std::swap(mVmaPass,          aOther.mVmaPass);
+#else
+		std::swap(mNextIndex,        aOther.mNextIndex);
+#endif
+		return *this;
+	}
 
-	const descriptor_set_layout& descriptor_cache_t::get_or_alloc_layout(descriptor_set_layout aPreparedLayout)
+	defragmenter_t::~defragmenter_t()
 	{
-		const auto it = mLayouts.find(aPreparedLayout);
-		if (mLayouts.end() != it) {
-			assert(it->handle());
-			return *it;
+#if defined(AVK_USES_VMA)
+		if (nullptr == mVmaContext) {
+			return;
+		}
+		if (mPassInFlight) {
+			// We can not know whether the copies have completed => cancel all moves of the current pass:
+			cancel_vma_pass();
 		}
+		vmaEndDefragmentation(mRoot->memory_allocator(), mVmaContext, nullptr);
+		mVmaContext = nullptr;
+#endif
+		// On the non-VMA path, pending moves own their (unused) new resources, which are released with them.
+	}
 
-		root::allocate_descriptor_set_layout(mRoot->device(), mRoot->dispatch_loader_core(), aPreparedLayout);
+#if defined(AVK_USES_VMA)
+	void defragmenter_t::cancel_vma_pass()
+	{
+		for (uint32_t i = 0; i < mVmaPass.moveCount; ++i) {
+			mVmaPass.pMoves[i].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+		}
+		for (auto& move : mPendingMoves) {
+			if (std::holds_alternative<vk::Buffer>(move.mNewResource)) {
+				mRoot->device().destroyBuffer(std::get<vk::Buffer>(move.mNewResource), nullptr, mRoot->dispatch_loader_core());
+			}
+			else {
+				mRoot->device().destroyImage(std::get<vk::Image>(move.mNewResource), nullptr, mRoot->dispatch_loader_core());
+			}
+		}
+		mPendingMoves.clear();
+		vmaEndDefragmentationPass(mRoot->memory_allocator(), mVmaContext, &mVmaPass);
+		mVmaPass = {};
+		mPassInFlight = false;
+	}
+#endif
 
-		const auto result = mLayouts.insert(std::move(aPreparedLayout));
-		assert(result.second);
-		return *result.first;
+	bool defragmenter_t::is_registered(const buffer_t* aBuffer) const
+	{
+		return std::end(mBuffers) != std::find(std::begin(mBuffers), std::end(mBuffers), aBuffer);
 	}
 
-	std::optional<descriptor_set> descriptor_cache_t::get_descriptor_set_from_cache(const descriptor_set& aPreparedSet)
+	bool defragmenter_t::is_registered(const image_t* aImage) const
 	{
-		const auto it = mSets.find(aPreparedSet);
-		if (mSets.end() != it) {
-			auto found = *it;
-			// This might not be the veeeery best place to alter the set-id, but let's go for it:
-			found.set_set_id(aPreparedSet.set_id());
-			return found;
+		return std::end(mImages) != std::find_if(std::begin(mImages), std::end(mImages), [aImage](const image_entry& e) { return e.mImage == aImage; });
+	}
+
+	defragmenter_t& defragmenter_t::add(buffer_t& aBuffer)
+	{
+		if (mPassInFlight) {
+			throw avk::logic_error("Resources can not be registered while a defragmentation pass is in flight.");
 		}
-		return {};
+		if (!avk::has_flag(aBuffer.usage_flags(), vk::BufferUsageFlagBits::eTransferSrc) || !avk::has_flag(aBuffer.usage_flags(), vk::BufferUsageFlagBits::eTransferDst)) {
+			AVK_LOG_WARNING("Buffer can not be registered for defragmentation, because it has not been created with both, eTransferSrc and eTransferDst usage flags.");
+			return *this;
+		}
+		if (aBuffer.mExternalMemory) {
+			AVK_LOG_WARNING("Buffer can not be registered for defragmentation, because it uses imported host memory or external memory.");
+			return *this;
+		}
+		if (!is_registered(&aBuffer)) {
+			mBuffers.push_back(&aBuffer);
+			mFinished = false;
+		}
+		return *this;
 	}
 
-	std::vector<descriptor_set> descriptor_cache_t::alloc_new_descriptor_sets(const std::vector<std::reference_wrapper<const descriptor_set_layout>>& aLayouts, std::vector<descriptor_set> aPreparedSets)
+	defragmenter_t& defragmenter_t::add(image_t& aImage, avk::layout::image_layout aCurrentLayout)
 	{
-		assert(aLayouts.size() == aPreparedSets.size());
+		if (mPassInFlight) {
+			throw avk::logic_error("Resources can not be registered while a defragmentation pass is in flight.");
+		}
+		if (!std::holds_alternative<AVK_MEM_IMAGE_HANDLE>(aImage.mImage)) {
+			AVK_LOG_WARNING("Image can not be registered for defragmentation, because it is not an allocated, but a wrapped image.");
+			return *this;
+		}
+		if (aImage.mExternalMemory) {
+			AVK_LOG_WARNING("Image can not be registered for defragmentation, because it uses external memory.");
+			return *this;
+		}
+		if (!avk::has_flag(aImage.create_info().usage, vk::ImageUsageFlagBits::eTransferSrc) || !avk::has_flag(aImage.create_info().usage, vk::ImageUsageFlagBits::eTransferDst)) {
+			AVK_LOG_WARNING("Image can not be registered for defragmentation, because it has not been created with both, eTransferSrc and eTransferDst usage flags.");
+			return *this;
+		}
+		if (!is_registered(&aImage)) {
+			mImages.push_back(image_entry{ &aImage, aCurrentLayout.mLayout });
+			mFinished = false;
+		}
+		return *this;
+	}
 
-		std::vector<descriptor_set> result;
-		if (aLayouts.empty()) {
-			return result;
+	defragmenter_t& defragmenter_t::add(image_view_t& aImageView, avk::layout::image_layout aCurrentLayout)
+	{
+		add(aImageView.get_image(), aCurrentLayout);
+		return add_dependent_view(aImageView);
+	}
+
+	defragmenter_t& defragmenter_t::add_dependent_view(image_view_t& aImageView)
+	{
+		if (std::end(mImageViews) == std::find(std::begin(mImageViews), std::end(mImageViews), &aImageView)) {
+			mImageViews.push_back(&aImageView);
 		}
+		return *this;
+	}
 
-		const int n = static_cast<int>(aLayouts.size());
-#ifdef _DEBUG // Perform an extensive sanity check:
-		for (int i = 0; i < n; ++i) {
-			const auto dbgB = aLayouts[i].get().number_of_bindings();
-			assert(dbgB == aPreparedSets[i].number_of_writes());
-			for (size_t j = 0; j < dbgB; ++j) {
-				assert(aLayouts[i].get().binding_at(j).binding			== aPreparedSets[i].write_at(j).dstBinding);
-				assert(aLayouts[i].get().binding_at(j).descriptorCount	== aPreparedSets[i].write_at(j).descriptorCount);
-				assert(aLayouts[i].get().binding_at(j).descriptorType	== aPreparedSets[i].write_at(j).descriptorType);
-			}
+	defragmenter_t& defragmenter_t::add_dependent_view(buffer_view_t& aBufferView)
+	{
+		if (std::end(mBufferViews) == std::find(std::begin(mBufferViews), std::end(mBufferViews), &aBufferView)) {
+			mBufferViews.push_back(&aBufferView);
 		}
-#endif
+		return *this;
+	}
 
-		// Find possible duplicates within the descriptor sets, and store the unique layouts so that we do not over-allocate:
-		std::vector<std::reference_wrapper<const descriptor_set_layout>> layoutsOfUniqueSets;
-		std::vector<int> duplicateSetIndices; // -1 ... no duplicate, [0..n) ... duplicate at the given index
-		layoutsOfUniqueSets.push_back(aLayouts[0]);
-		duplicateSetIndices.emplace_back(-1);
-		for (int i = 1; i < n; ++i) {
-			for (int j = 0; j < i; ++j) {
-				if (aPreparedSets[i] == aPreparedSets[j]) {
-					duplicateSetIndices.emplace_back(j);
-				}
-			}
-			if (static_cast<int>(duplicateSetIndices.size()) == i) { // No duplicate found => nothing inserted
-				layoutsOfUniqueSets.push_back(aLayouts[i]);
-				duplicateSetIndices.emplace_back(-1);
-			}
+	defragmenter_t& defragmenter_t::add_dependent_descriptor_cache(descriptor_cache_t& aDescriptorCache)
+	{
+		if (std::end(mDescriptorCaches) == std::find(std::begin(mDescriptorCaches), std::end(mDescriptorCaches), &aDescriptorCache)) {
+			mDescriptorCaches.push_back(&aDescriptorCache);
 		}
-		assert(layoutsOfUniqueSets.size() <= aLayouts.size());
-		assert(duplicateSetIndices.size() == aPreparedSets.size());
-
-		// Find a pool with enough space left for the layouts (only those required => layoutsOfUniqueSets),
-		// or alloc a new pool:
-		auto allocRequest = descriptor_alloc_request{ layoutsOfUniqueSets };
-
-		std::shared_ptr<descriptor_pool> pool = nullptr;
-		std::vector<vk::DescriptorSet> setHandles;
-
-		auto poolToTry = get_descriptor_pool_for_layouts(allocRequest);
+		return *this;
+	}
 
-		int maxTries = 3;
-		while (!pool && maxTries-- > 0) {
-			try {
-				assert(poolToTry->has_capacity_for(allocRequest));
-				// Alloc the whole thing:
-				setHandles = poolToTry->allocate(aLayouts);
-				assert(setHandles.size() == aPreparedSets.size());
-				// Success
-				pool = poolToTry;
-			}
-			catch (vk::OutOfPoolMemoryError& fail) {
-				AVK_LOG_ERROR(std::string("Failed to allocate descriptor sets from pool: ") + fail.what());
-				switch (maxTries) {
-				case 1:
-					AVK_LOG_INFO("Trying again with doubled size requirements...");
-					allocRequest = allocRequest.multiply_size_requirements(2u);
-					poolToTry = get_descriptor_pool_for_layouts(allocRequest);
-					break;
-				default:
-					AVK_LOG_INFO("Trying again with new pool..."); // and possibly doubled size requirements, depending on whether maxTries is 2 or 0
-					poolToTry = get_descriptor_pool_for_layouts(allocRequest, true);
-					break;
-				}
+	void defragmenter_t::remove(const buffer_t& aBuffer)
+	{
+		if (mPassInFlight) {
+			throw avk::logic_error("Resources can not be unregistered while a defragmentation pass is in flight.");
+		}
+		auto it = std::find(std::begin(mBuffers), std::end(mBuffers), &aBuffer);
+		if (std::end(mBuffers) != it) {
+#if !defined(AVK_USES_VMA)
+			const auto index = static_cast<size_t>(std::distance(std::begin(mBuffers), it));
+			if (index < mNextIndex) {
+				--mNextIndex;
 			}
+#endif
+			mBuffers.erase(it);
 		}
+	}
 
-		assert(pool);
-		assert(setHandles.size() > 0);
-
-		// Finish configuration (most importantly: write descriptors), and just make copies for the duplicates:
-		for (int i = 0; i < n; ++i) {
-			const bool isDuplicate = -1 != duplicateSetIndices[i];
-			const int setIndex = isDuplicate ? duplicateSetIndices[i] : i;
-
-			if (!isDuplicate) {
-				assert(setIndex == i);
-				auto& setToBeCompleted = aPreparedSets[setIndex];
-				setToBeCompleted.link_to_handle_and_pool(std::move(setHandles[setIndex]), pool);
-				setToBeCompleted.update_data_pointers();
-				setToBeCompleted.write_descriptors();
-
-				// Your soul... is mine:
-				const auto cachedSet = mSets.insert(std::move(setToBeCompleted));
-				assert(cachedSet.second); // This must not happen. Duplicate handling should have caught such cases.
-				// Done. Store for result:
-				result.push_back(*cachedSet.first); // Make a copy!
-			}
-			else {
-				assert(setIndex < i);
-				result.emplace_back(result[setIndex]).set_set_id(aPreparedSets[i].set_id()); // Copy the duplicate set
+	void defragmenter_t::remove(const image_t& aImage)
+	{
+		if (mPassInFlight) {
+			throw avk::logic_error("Resources can not be unregistered while a defragmentation pass is in flight.");
+		}
+		auto it = std::find_if(std::begin(mImages), std::end(mImages), [&aImage](const image_entry& e) { return e.mImage == &aImage; });
+		if (std::end(mImages) != it) {
+#if !defined(AVK_USES_VMA)
+			const auto index = mBuffers.size() + static_cast<size_t>(std::distance(std::begin(mImages), it));
+			if (index < mNextIndex) {
+				--mNextIndex;
 			}
+#endif
+			mImages.erase(it);
 		}
+	}
 
-		return result;
+	void defragmenter_t::remove(const image_view_t& aImageView)
+	{
+		std::erase(mImageViews, &aImageView);
 	}
 
-	void descriptor_cache_t::cleanup()
+	void defragmenter_t::remove(const buffer_view_t& aBufferView)
 	{
-		mSets.clear();
-		mLayouts.clear();
+		std::erase(mBufferViews, &aBufferView);
 	}
 
-	std::shared_ptr<descriptor_pool> descriptor_cache_t::get_descriptor_pool_for_layouts(const descriptor_alloc_request& aAllocRequest, bool aRequestNewPool)
+	avk::command::action_type_command defragmenter_t::begin_pass()
 	{
-		// We'll allocate the pools per (thread and name)
-		auto tId = std::this_thread::get_id();
-		auto& pools = mDescriptorPools[tId];
+		if (mPassInFlight) {
+			throw avk::logic_error("end_pass() must be invoked before the next defragmentation pass can begin.");
+		}
+		assert(mPendingMoves.empty());
 
-		// First of all, do some cleanup => remove all pools which no longer exist:
-		pools.erase(std::remove_if(std::begin(pools), std::end(pools), [](const std::weak_ptr<descriptor_pool>& ptr) {
-			return ptr.expired();
-		}), std::end(pools));
+		auto& device = mRoot->device();
 
-		// Find a pool which is capable of allocating this:
-		if (!aRequestNewPool) {
-			for (auto& pool : pools) {
-				if (auto sptr = pool.lock()) {
-					if (sptr->has_capacity_for(aAllocRequest)) {
-						return sptr;
-					}
-				}
+#if defined(AVK_USES_VMA)
+		auto allocator = mRoot->memory_allocator();
+		if (nullptr == mVmaContext) {
+			VmaDefragmentationInfo defragInfo = {};
+			defragInfo.flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+			defragInfo.maxBytesPerPass = mConfig.mMaxBytesPerPass;
+			defragInfo.maxAllocationsPerPass = mConfig.mMaxMovesPerPass;
+			auto result = vmaBeginDefragmentation(allocator, &defragInfo, &mVmaContext);
+			if (VK_SUCCESS != result) {
+				throw avk::runtime_error("vmaBeginDefragmentation failed with result " + std::to_string(static_cast<int>(result)));
 			}
 		}
 
-		// We weren't lucky (or new pool has been requested) => create a new pool:
-		AVK_LOG_INFO("Allocating new descriptor pool for thread[" + [tId]() { std::stringstream ss; ss << tId; return ss.str(); }() + "] and name['" + mName + "]");
-
-		// TODO: On AMD, it seems that all the entries have to be multiplied as well, while on NVIDIA, only multiplying the number of sets seems to be sufficient
-		//       => How to handle this? Overallocation is as bad as underallocation. Shall we make use of exceptions? Shall we 'if' on the vendor?
-
-		const bool isNvidia = 0x12d2 == mRoot->physical_device().getProperties().vendorID;
-		auto amplifiedAllocRequest = aAllocRequest.multiply_size_requirements(prealloc_factor());
-		//if (!isNvidia) { // Let's 'if' on the vendor and see what happens...
-		//}
-
-		auto newPool = root::create_descriptor_pool(mRoot->device(), mRoot->dispatch_loader_core(),
-			isNvidia
-			  ? aAllocRequest.accumulated_pool_sizes()
-			  : amplifiedAllocRequest.accumulated_pool_sizes(),
-			isNvidia
-			  ? aAllocRequest.num_sets() * prealloc_factor()
-			  : aAllocRequest.num_sets() * prealloc_factor() * 2 // the last factor is a "magic number"/"educated guess"/"preemtive strike"
-		);
+		mVmaPass = {};
+		if (VK_SUCCESS == vmaBeginDefragmentationPass(allocator, mVmaContext, &mVmaPass)) {
+			// VMA has nothing left to move:
+			vmaEndDefragmentation(allocator, mVmaContext, nullptr);
+			mVmaContext = nullptr;
+			mFinished = true;
+			return {};
+		}
 
-		auto newPoolPtr = std::make_shared<descriptor_pool>(std::move(newPool));
+		// VMA proposes moves for ALL allocations, but we can only move those which we know the owners of:
+		for (uint32_t i = 0; i < mVmaPass.moveCount; ++i) {
+			auto& move = mVmaPass.pMoves[i];
 
-		//  However, set the stored capacities to the amplified version, to not mess up our internal "has_capacity_for-logic":
-		newPoolPtr->set_remaining_capacities(amplifiedAllocRequest.accumulated_pool_sizes());
-		//if (!isNvidia) {
-		//}
+			auto bufIt = std::find_if(std::begin(mBuffers), std::end(mBuffers), [&move](const buffer_t* b) { return b->mBuffer.allocation() == move.srcAllocation; });
+			if (std::end(mBuffers) != bufIt) {
+				auto newBuffer = device.createBuffer((*bufIt)->mCreateInfo, nullptr, mRoot->dispatch_loader_core());
+				mPendingMoves.push_back(pending_move{ *bufIt, newBuffer, (*bufIt)->mCreateInfo.size });
+				auto result = vmaBindBufferMemory(allocator, move.dstTmpAllocation, static_cast<VkBuffer>(newBuffer));
+				if (VK_SUCCESS != result) {
+					cancel_vma_pass();
+					throw avk::runtime_error("vmaBindBufferMemory failed during defragmentation with result " + std::to_string(static_cast<int>(result)));
+				}
+				continue;
+			}
 
-		pools.emplace_back(newPoolPtr); // Store as a weak_ptr
-		return newPoolPtr;
-	}
-#pragma endregion
+			auto imgIt = std::find_if(std::begin(mImages), std::end(mImages), [&move](const image_entry& e) { return std::get<AVK_MEM_IMAGE_HANDLE>(e.mImage->mImage).allocation() == move.srcAllocation; });
+			if (std::end(mImages) != imgIt) {
+				auto newImage = device.createImage(imgIt->mImage->mCreateInfo, nullptr, mRoot->dispatch_loader_core());
+				mPendingMoves.push_back(pending_move{ *imgIt, newImage, std::get<AVK_MEM_IMAGE_HANDLE>(imgIt->mImage->mImage).mAllocationInfo.size });
+				auto result = vmaBindImageMemory(allocator, move.dstTmpAllocation, static_cast<VkImage>(newImage));
+				if (VK_SUCCESS != result) {
+					cancel_vma_pass();
+					throw avk::runtime_error("vmaBindImageMemory failed during defragmentation with result " + std::to_string(static_cast<int>(result)));
+				}
+				continue;
+			}
 
-#pragma region descriptor set definitions
+			move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+		}
 
-	bool operator ==(const descriptor_set& left, const descriptor_set& right)
-	{
-		const auto n = left.mOrderedDescriptorDataWrites.size();
-		if (n != right.mOrderedDescriptorDataWrites.size()) {
-			return false;
+		mPassInFlight = true;
+		if (mPendingMoves.empty()) {
+			// None of the proposed moves concerned registered resources => nothing to copy, conclude right away:
+			conclude_pass(nullptr, 0);
+			return {};
 		}
-		for (size_t i = 0; i < n; ++i) {
-			if (left.mOrderedDescriptorDataWrites[i].dstBinding			!= right.mOrderedDescriptorDataWrites[i].dstBinding			)			{ return false; }
-			if (left.mOrderedDescriptorDataWrites[i].dstArrayElement	!= right.mOrderedDescriptorDataWrites[i].dstArrayElement	)			{ return false; }
-			if (left.mOrderedDescriptorDataWrites[i].descriptorCount	!= right.mOrderedDescriptorDataWrites[i].descriptorCount	)			{ return false; }
-			if (left.mOrderedDescriptorDataWrites[i].descriptorType		!= right.mOrderedDescriptorDataWrites[i].descriptorType		)			{ return false; }
-			if (nullptr != left.mOrderedDescriptorDataWrites[i].pImageInfo) {
-				if (nullptr == right.mOrderedDescriptorDataWrites[i].pImageInfo)																{ return false; }
-				for (size_t j = 0; j < left.mOrderedDescriptorDataWrites[i].descriptorCount; ++j) {
-					if (left.mOrderedDescriptorDataWrites[i].pImageInfo[j] != right.mOrderedDescriptorDataWrites[i].pImageInfo[j])				{ return false; }
+#else
+		// Without a sub-allocator, every resource has its own allocation. Moving a resource means giving
+		// it a new allocation, which allows the driver to place it anew and to release the old memory.
+		auto allocator = mRoot->memory_allocator();
+		vk::DeviceSize bytesThisPass = 0;
+		const auto numCandidates = mBuffers.size() + mImages.size();
+		while (mNextIndex < numCandidates && mPendingMoves.size() < static_cast<size_t>(mConfig.mMaxMovesPerPass)) {
+			if (mNextIndex < mBuffers.size()) {
+				auto* buf = mBuffers[mNextIndex];
+				const auto size = buf->mCreateInfo.size;
+				if (!mPendingMoves.empty() && bytesThisPass + size > mConfig.mMaxBytesPerPass) {
+					break; // Budget exceeded, but always move at least one resource per pass to make progress
 				}
+				mPendingMoves.push_back(pending_move{ buf, AVK_MEM_BUFFER_HANDLE{ allocator, buf->memory_properties(), buf->mCreateInfo, ~0u, &mRoot->capabilities().memory_properties() }, size });
+				bytesThisPass += size;
 			}
-			if (nullptr != left.mOrderedDescriptorDataWrites[i].pBufferInfo) {
-				if (nullptr == right.mOrderedDescriptorDataWrites[i].pBufferInfo)																{ return false; }
-				for (size_t j = 0; j < left.mOrderedDescriptorDataWrites[i].descriptorCount; ++j) {
-					if (left.mOrderedDescriptorDataWrites[i].pBufferInfo[j] != right.mOrderedDescriptorDataWrites[i].pBufferInfo[j])			{ return false; }
+			else {
+				auto& entry = mImages[mNextIndex - mBuffers.size()];
+				const auto size = device.getImageMemoryRequirements(entry.mImage->handle(), mRoot->dispatch_loader_core()).size;
+				if (!mPendingMoves.empty() && bytesThisPass + size > mConfig.mMaxBytesPerPass) {
+					break; // Budget exceeded, but always move at least one resource per pass to make progress
 				}
+				mPendingMoves.push_back(pending_move{ entry, AVK_MEM_IMAGE_HANDLE{ allocator, entry.mImage->memory_properties(), entry.mImage->mCreateInfo, ~0u, &mRoot->capabilities().memory_properties() }, size });
+				bytesThisPass += size;
 			}
-			if (nullptr != left.mOrderedDescriptorDataWrites[i].pTexelBufferView) {
-				if (nullptr == right.mOrderedDescriptorDataWrites[i].pTexelBufferView)															{ return false; }
-				for (size_t j = 0; j < left.mOrderedDescriptorDataWrites[i].descriptorCount; ++j) {
-					if (left.mOrderedDescriptorDataWrites[i].pTexelBufferView[j] != right.mOrderedDescriptorDataWrites[i].pTexelBufferView[j])	{ return false; }
+			++mNextIndex;
+		}
+
+		if (mPendingMoves.empty()) {
+			mFinished = true;
+			return {};
+		}
+		mPassInFlight = true;
+#endif
+
+		// Gather plain copy instructions, s.t. the recorded commands do not depend on the state of this defragmenter:
+		struct image_copy_data
+		{
+			vk::Image mSrc;
+			vk::Image mDst;
+			vk::ImageLayout mLayout;
+			vk::ImageAspectFlags mAspectFlags;
+			vk::Extent3D mExtent;
+			uint32_t mMipLevels;
+			uint32_t mArrayLayers;
+		};
+		std::vector<std::tuple<vk::Buffer, vk::Buffer, vk::DeviceSize>> bufferCopies;
+		std::vector<image_copy_data> imageCopies;
+		for (const auto& move : mPendingMoves) {
+			if (std::holds_alternative<buffer_t*>(move.mResource)) {
+				const auto* buf = std::get<buffer_t*>(move.mResource);
+#if defined(AVK_USES_VMA)
+				bufferCopies.emplace_back(buf->handle(), std::get<vk::Buffer>(move.mNewResource), buf->mCreateInfo.size);
+#else
+				bufferCopies.emplace_back(buf->handle(), std::get<AVK_MEM_BUFFER_HANDLE>(move.mNewResource).resource(), buf->mCreateInfo.size);
+#endif
+			}
+			else {
+				const auto& entry = std::get<image_entry>(move.mResource);
+				if (vk::ImageLayout::eUndefined == entry.mLayout) {
+					continue; // Contents need not be preserved
 				}
+				const auto& ci = entry.mImage->create_info();
+				imageCopies.push_back(image_copy_data{
+					entry.mImage->handle(),
+#if defined(AVK_USES_VMA)
+					std::get<vk::Image>(move.mNewResource),
+#else
+					std::get<AVK_MEM_IMAGE_HANDLE>(move.mNewResource).resource(),
+#endif
+					entry.mLayout, entry.mImage->aspect_flags(), ci.extent, ci.mipLevels, ci.arrayLayers
+				});
 			}
+		}
 
-#if VK_HEADER_VERSION >= 135
-			if (nullptr != left.mOrderedDescriptorDataWrites[i].pNext) {
-				if (nullptr == right.mOrderedDescriptorDataWrites[i].pNext)																		{ return false; }
-				if (left.mOrderedDescriptorDataWrites[i].descriptorType == vk::DescriptorType::eAccelerationStructureKHR) {
-					const auto* asInfoLeft = reinterpret_cast<const VkWriteDescriptorSetAccelerationStructureKHR*>(left.mOrderedDescriptorDataWrites[i].pNext);
-					const auto* asInfoRight = reinterpret_cast<const VkWriteDescriptorSetAccelerationStructureKHR*>(right.mOrderedDescriptorDataWrites[i].pNext);
-					if (asInfoLeft->accelerationStructureCount != asInfoRight->accelerationStructureCount)										{ return false; }
-					for (size_t j = 0; j < asInfoLeft->accelerationStructureCount; ++j) {
-						if (asInfoLeft->pAccelerationStructures[j] != asInfoRight->pAccelerationStructures[j])									{ return false; }
+		return avk::command::action_type_command{
+			avk::sync::sync_hint{
+				stage::copy + access::transfer_read,
+				stage::copy + access::transfer_write
+			},
+			{},
+			[
+				lRoot = mRoot,
+				lBufferCopies = std::move(bufferCopies),
+				lImageCopies = std::move(imageCopies)
+			](avk::command_buffer_t& cb) {
+				for (const auto& [src, dst, size] : lBufferCopies) {
+					const auto copyRegion = vk::BufferCopy{ 0u, 0u, size };
+					cb.handle().copyBuffer(src, dst, 1u, &copyRegion, lRoot->dispatch_loader_core());
+				}
+
+				for (const auto& ic : lImageCopies) {
+					const auto range = vk::ImageSubresourceRange{ ic.mAspectFlags, 0u, ic.mMipLevels, 0u, ic.mArrayLayers };
+					std::array layoutTransitions = {
+						vk::ImageMemoryBarrier{
+							{}, vk::AccessFlagBits::eTransferRead,
+							ic.mLayout, vk::ImageLayout::eTransferSrcOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, ic.mSrc, range },
+						vk::ImageMemoryBarrier{
+							{}, vk::AccessFlagBits::eTransferWrite,
+							vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, ic.mDst, range }
+					};
+					cb.handle().pipelineBarrier(
+						vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags{},
+						0u, nullptr, 0u, nullptr,
+						static_cast<uint32_t>(layoutTransitions.size()), layoutTransitions.data(),
+						lRoot->dispatch_loader_core()
+					);
+
+					std::vector<vk::ImageCopy> regions;
+					for (uint32_t mip = 0u; mip < ic.mMipLevels; ++mip) {
+						const auto subresource = vk::ImageSubresourceLayers{ ic.mAspectFlags, mip, 0u, ic.mArrayLayers };
+						regions.push_back(vk::ImageCopy{
+							subresource, vk::Offset3D{ 0, 0, 0 },
+							subresource, vk::Offset3D{ 0, 0, 0 },
+							vk::Extent3D{ std::max(1u, ic.mExtent.width >> mip), std::max(1u, ic.mExtent.height >> mip), std::max(1u, ic.mExtent.depth >> mip) }
+						});
 					}
+					cb.handle().copyImage(ic.mSrc, vk::ImageLayout::eTransferSrcOptimal, ic.mDst, vk::ImageLayout::eTransferDstOptimal, static_cast<uint32_t>(regions.size()), regions.data(), lRoot->dispatch_loader_core());
+
+					// Bring the new image into the layout the old one was in. (The old one is going to be destroyed anyways.)
+					auto toOriginalLayout = vk::ImageMemoryBarrier{
+						vk::AccessFlagBits::eTransferWrite, {},
+						vk::ImageLayout::eTransferDstOptimal, ic.mLayout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, ic.mDst, range };
+					cb.handle().pipelineBarrier(
+						vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags{},
+						0u, nullptr, 0u, nullptr,
+						1u, &toOriginalLayout,
+						lRoot->dispatch_loader_core()
+					);
 				}
 			}
-#endif
-		}
-		return true;
+		};
 	}
 
-	bool operator !=(const descriptor_set& left, const descriptor_set& right)
+	defragmentation_stats defragmenter_t::end_pass(deferred_destruction_queue& aDeferredDestruction, std::optional<uint64_t> aRetireValue)
 	{
-		return !(left == right);
+		if (!mPassInFlight) {
+			throw avk::logic_error("end_pass() can only be invoked after begin_pass().");
+		}
+		return conclude_pass(&aDeferredDestruction, aRetireValue.value_or(aDeferredDestruction.current_retire_value()));
 	}
 
-	void descriptor_set::update_data_pointers()
+	defragmentation_stats defragmenter_t::conclude_pass(deferred_destruction_queue* aDeferredDestruction, uint64_t aRetireValue)
 	{
-		for (auto& w : mOrderedDescriptorDataWrites) {
-			assert(w.dstSet == mOrderedDescriptorDataWrites[0].dstSet);
-			{
-				auto it = std::find_if(std::begin(mStoredImageInfos), std::end(mStoredImageInfos), [binding = w.dstBinding](const auto& element) { return std::get<uint32_t>(element) == binding; });
-				if (it != std::end(mStoredImageInfos)) {
-					w.pImageInfo = std::get<std::vector<vk::DescriptorImageInfo>>(*it).data();
-				}
-				else {
-					w.pImageInfo = nullptr;
-				}
-			}
-			{
-				auto it = std::find_if(std::begin(mStoredBufferInfos), std::end(mStoredBufferInfos), [binding = w.dstBinding](const auto& element) { return std::get<uint32_t>(element) == binding; });
-				if (it != std::end(mStoredBufferInfos)) {
-					w.pBufferInfo = std::get<std::vector<vk::DescriptorBufferInfo>>(*it).data();
-				}
-				else {
-					w.pBufferInfo = nullptr;
-				}
-			}
-#if VK_HEADER_VERSION >= 135
-			{
-				auto it = std::find_if(std::begin(mStoredAccelerationStructureWrites), std::end(mStoredAccelerationStructureWrites), [binding = w.dstBinding](const auto& element) { return std::get<uint32_t>(element) == binding; });
-				if (it != std::end(mStoredAccelerationStructureWrites)) {
-					auto& tpl = std::get<1>(*it);
-					w.pNext = &std::get<vk::WriteDescriptorSetAccelerationStructureKHR>(tpl);
-					// Also update the pointer WITHIN the vk::WriteDescriptorSetAccelerationStructureKHR... OMG!
-					std::get<vk::WriteDescriptorSetAccelerationStructureKHR>(tpl).pAccelerationStructures = std::get<1>(tpl).data();
-				}
-				else {
-					w.pNext = nullptr;
+		assert(nullptr != aDeferredDestruction || mPendingMoves.empty());
+		defragmentation_stats stats;
+		auto& device = mRoot->device();
+
+		for (auto& move : mPendingMoves) {
+			if (std::holds_alternative<buffer_t*>(move.mResource)) {
+				auto* buf = std::get<buffer_t*>(move.mResource);
+				const auto oldHandle = buf->handle();
+#if defined(AVK_USES_VMA)
+				// VMA swaps the allocations internally in vmaEndDefragmentationPass, we only have to swap the resource handle.
+				// Frames in flight might still use the old one:
+				aDeferredDestruction->enqueue_destroy_function(aRetireValue, [lRoot = mRoot, oldHandle]() {
+					lRoot->device().destroyBuffer(oldHandle, nullptr, lRoot->dispatch_loader_core());
+				});
+				buf->mBuffer.mResource = std::get<vk::Buffer>(move.mNewResource);
+#else
+				// Frames in flight might still use the old buffer and its memory:
+				std::swap(buf->mBuffer, std::get<AVK_MEM_BUFFER_HANDLE>(move.mNewResource));
+				aDeferredDestruction->enqueue(aRetireValue, std::move(std::get<AVK_MEM_BUFFER_HANDLE>(move.mNewResource)));
+#endif
+				buf->mDescriptorInfo.reset();
+#if VK_HEADER_VERSION >= 135
+				if (buf->mDeviceAddress.has_value()) {
+					buf->mDeviceAddress = root::get_buffer_address(device, buf->handle());
 				}
+#endif
+				patch_dependents(buf, oldHandle, *aDeferredDestruction, aRetireValue, stats);
+				++stats.mBuffersMoved;
 			}
+			else {
+				auto& entry = std::get<image_entry>(move.mResource);
+				auto& memHandle = std::get<AVK_MEM_IMAGE_HANDLE>(entry.mImage->mImage);
+#if defined(AVK_USES_VMA)
+				aDeferredDestruction->enqueue_destroy_function(aRetireValue, [lRoot = mRoot, oldHandle = memHandle.mResource]() {
+					lRoot->device().destroyImage(oldHandle, nullptr, lRoot->dispatch_loader_core());
+				});
+				memHandle.mResource = std::get<vk::Image>(move.mNewResource);
+#else
+				std::swap(memHandle, std::get<AVK_MEM_IMAGE_HANDLE>(move.mNewResource));
+				aDeferredDestruction->enqueue(aRetireValue, std::move(std::get<AVK_MEM_IMAGE_HANDLE>(move.mNewResource)));
 #endif
-			{
-				auto it = std::find_if(std::begin(mStoredBufferViews), std::end(mStoredBufferViews), [binding = w.dstBinding](const auto& element) { return std::get<uint32_t>(element) == binding; });
-				if (it != std::end(mStoredBufferViews)) {
-					w.pTexelBufferView = std::get<std::vector<vk::BufferView>>(*it).data();
-				}
-				else {
-					w.pTexelBufferView = nullptr;
-				}
+				patch_dependents(entry.mImage, *aDeferredDestruction, aRetireValue, stats);
+				++stats.mImagesMoved;
 			}
+			stats.mBytesMoved += move.mSize;
 		}
-	}
 
-	void descriptor_set::link_to_handle_and_pool(vk::DescriptorSet aHandle, std::shared_ptr<descriptor_pool> aPool)
-	{
-		mDescriptorSet = aHandle;
-		for (auto& w : mOrderedDescriptorDataWrites) {
-			w.setDstSet(handle());
+#if defined(AVK_USES_VMA)
+		auto allocator = mRoot->memory_allocator();
+		vmaEndDefragmentationPass(allocator, mVmaContext, &mVmaPass);
+		mVmaPass = {};
+		// The allocations now refer to their new locations => update the cached allocation infos:
+		for (auto& move : mPendingMoves) {
+			if (std::holds_alternative<buffer_t*>(move.mResource)) {
+				auto& memHandle = std::get<buffer_t*>(move.mResource)->mBuffer;
+				vmaGetAllocationInfo(allocator, memHandle.mAllocation, &memHandle.mAllocationInfo);
+			}
+			else {
+				auto& memHandle = std::get<AVK_MEM_IMAGE_HANDLE>(std::get<image_entry>(move.mResource).mImage->mImage);
+				vmaGetAllocationInfo(allocator, memHandle.mAllocation, &memHandle.mAllocationInfo);
+			}
 		}
-		mPool = std::move(aPool);
-	}
+#endif
 
-	void descriptor_set::write_descriptors()
-	{
-		assert(mDescriptorSet);
-		update_data_pointers();
-		mPool.get()->mDescriptorPool.getOwner().updateDescriptorSets(static_cast<uint32_t>(mOrderedDescriptorDataWrites.size()), mOrderedDescriptorDataWrites.data(), 0u, nullptr);
+		mPendingMoves.clear();
+		mPassInFlight = false;
+		return stats;
 	}
 
-	std::vector<descriptor_set> descriptor_cache_t::get_or_create_descriptor_sets(std::initializer_list<binding_data> aBindings)
+	void defragmenter_t::patch_dependents(const buffer_t* aMovedBuffer, vk::Buffer aOldHandle, deferred_destruction_queue& aDeferredDestruction, uint64_t aRetireValue, defragmentation_stats& aStats)
 	{
-		std::vector<binding_data> orderedBindings;
-		uint32_t minSetId = std::numeric_limits<uint32_t>::max();
-		uint32_t maxSetId = std::numeric_limits<uint32_t>::min();
-
-		// Step 1: order the bindings
-		for (auto& b : aBindings) {
-			minSetId = std::min(minSetId, b.mSetId);
-			maxSetId = std::max(maxSetId, b.mSetId);
-			auto it = std::lower_bound(std::begin(orderedBindings), std::end(orderedBindings), b); // use operator<
-			orderedBindings.insert(it, b);
+		for (auto* cache : mDescriptorCaches) {
+			aStats.mDescriptorSetsInvalidated += cache->remove_sets_with_handle(aOldHandle);
 		}
 
-		std::vector<std::reference_wrapper<const descriptor_set_layout>> layouts;
-		std::vector<descriptor_set> preparedSets;
-		std::vector<descriptor_set> cachedSets;
-		std::vector<bool>           validSets;
+		for (auto* view : mBufferViews) {
+			if (std::holds_alternative<buffer>(view->mBuffer)) {
+				if (&std::get<buffer>(view->mBuffer).get() != aMovedBuffer) {
+					continue;
+				}
+			}
+			else {
+				auto& [handle, createInfo] = std::get<std::tuple<vk::Buffer, vk::BufferCreateInfo>>(view->mBuffer);
+				if (handle != aOldHandle) {
+					continue;
+				}
+				handle = aMovedBuffer->handle();
+			}
 
-		// Step 2: go through all the sets, get or alloc layouts, and see if the descriptor sets are already in cache, by chance.
-		for (uint32_t setId = minSetId; setId <= maxSetId; ++setId) {
-			auto lb = std::lower_bound(std::begin(orderedBindings), std::end(orderedBindings), binding_data{ setId },
-				[](const binding_data& first, const binding_data& second) -> bool {
-					return first.mSetId < second.mSetId;
-				});
-			auto ub = std::upper_bound(std::begin(orderedBindings), std::end(orderedBindings), binding_data{ setId },
-				[](const binding_data& first, const binding_data& second) -> bool {
-					return first.mSetId < second.mSetId;
-				});
+			for (auto* cache : mDescriptorCaches) {
+				aStats.mDescriptorSetsInvalidated += cache->remove_sets_with_handle(view->view_handle());
+			}
+			view->mCreateInfo.setBuffer(aMovedBuffer->handle());
+			aDeferredDestruction.enqueue(aRetireValue, std::move(view->mBufferView));
+			view->mBufferView = mRoot->device().createBufferViewUnique(view->mCreateInfo, nullptr, mRoot->dispatch_loader_core());
+			++aStats.mViewsRecreated;
+		}
+	}
 
-			// Handle empty sets:
-			if (lb == ub) {
+	void defragmenter_t::patch_dependents(const image_t* aMovedImage, deferred_destruction_queue& aDeferredDestruction, uint64_t aRetireValue, defragmentation_stats& aStats)
+	{
+		for (auto* view : mImageViews) {
+			if (&view->get_image() != aMovedImage) {
 				continue;
 			}
 
-			const auto& layout = get_or_alloc_layout(descriptor_set_layout::prepare(lb, ub));
-			layouts.emplace_back(layout);
-			auto preparedSet = descriptor_set::prepare(lb, ub);
-			auto cachedSet = get_descriptor_set_from_cache(preparedSet);
-			if (cachedSet.has_value()) {
-				auto& back = cachedSets.emplace_back(std::move(cachedSet.value()));
-				validSets.push_back(true);
+			for (auto* cache : mDescriptorCaches) {
+				aStats.mDescriptorSetsInvalidated += cache->remove_sets_with_handle(view->handle());
 			}
-			else {
-				cachedSets.emplace_back();
-				validSets.push_back(false);
+			view->mCreateInfo.setImage(aMovedImage->handle());
+			if (view->mUsageInfo.usage) {
+				// The view might have been moved since its creation => rewire:
+				view->mCreateInfo.setPNext(&view->mUsageInfo);
 			}
-			preparedSets.emplace_back(std::move(preparedSet));
+			aDeferredDestruction.enqueue(aRetireValue, std::move(view->mImageView));
+			view->mImageView = mRoot->device().createImageViewUnique(view->mCreateInfo, nullptr, mRoot->dispatch_loader_core());
+			++aStats.mViewsRecreated;
 		}
+	}
 
-		if (static_cast<int>(cachedSets.size()) == std::count(std::begin(validSets), std::end(validSets), true)) {
-			// Everything is cached; we're done.
-			return cachedSets;
-		}
+	defragmenter root::create_defragmenter(defragmentation_config aConfig)
+	{
+		defragmenter_t result;
+		result.mRoot = this;
+		result.mConfig = aConfig;
+		return result;
+	}
+#pragma endregion
 
-		// HOWEVER, if not...
-		std::vector<std::reference_wrapper<const descriptor_set_layout>> layoutsForAlloc;
-		std::vector<descriptor_set> toBeAlloced;
-		std::vector<size_t> indexMapping;
-		for (size_t i = 0; i < cachedSets.size(); ++i) {
-			if (!validSets[i]) {
-				layoutsForAlloc.push_back(layouts[i]);
-				toBeAlloced.push_back(std::move(preparedSets[i]));
-				indexMapping.push_back(i);
+#pragma region descriptor alloc request
+	descriptor_alloc_request::descriptor_alloc_request()
+		: mNumSets{ 0u }
+	{}
+
+	descriptor_alloc_request::descriptor_alloc_request(const std::vector<std::reference_wrapper<const descriptor_set_layout>>& aLayouts)
+	{
+		mNumSets = static_cast<uint32_t>(aLayouts.size());
+
+		for (const auto& layout : aLayouts) {
+			// Accumulate all the memory requirements of all the sets
+			for (const auto& entry : layout.get().required_pool_sizes()) {
+				auto it = std::lower_bound(std::begin(mAccumulatedSizes), std::end(mAccumulatedSizes),
+					entry,
+					[](const vk::DescriptorPoolSize& first, const vk::DescriptorPoolSize& second) -> bool {
+						using EnumType = std::underlying_type<vk::DescriptorType>::type;
+						return static_cast<EnumType>(first.type) < static_cast<EnumType>(second.type);
+					});
+				if (it != std::end(mAccumulatedSizes) && it->type == entry.type) {
+					it->descriptorCount += entry.descriptorCount;
+				}
+				else {
+					mAccumulatedSizes.insert(it, entry);
+				}
 			}
 		}
-		auto nowAlsoInCache = alloc_new_descriptor_sets(layoutsForAlloc, std::move(toBeAlloced));
-		for (size_t i = 0; i < indexMapping.size(); ++i) {
-			cachedSets[indexMapping[i]] = nowAlsoInCache[i];
-		}
-		return cachedSets;
 	}
 
-	int descriptor_cache_t::remove_sets_with_handle(vk::ImageView aHandle)
+	void descriptor_alloc_request::add_size_requirements(vk::DescriptorPoolSize aToAdd)
 	{
-		int numDeleted = 0;
-		auto it = std::begin(mSets);
-		do {
-			it = std::find_if(std::begin(mSets), std::end(mSets), [aHandle](const descriptor_set& aSet) {
-				auto n = aSet.number_of_writes();
-				for (decltype(n) i = 0; i < n; ++i) {
-					const auto& w = aSet.write_at(i);
-					auto dn = w.descriptorCount;
-					if (0u == dn || nullptr == w.pImageInfo) {
-						continue;
-					}
-					for (decltype(dn) di = 0; di < dn; ++di) {
-						if (w.pImageInfo[di].imageView == aHandle) {
-							return true;
-						}
-					}
-				}
-				return false;
+		auto it = std::lower_bound(std::begin(mAccumulatedSizes), std::end(mAccumulatedSizes),
+			aToAdd,
+			[](const vk::DescriptorPoolSize& first, const vk::DescriptorPoolSize& second) -> bool {
+				using EnumType = std::underlying_type<vk::DescriptorType>::type;
+				return static_cast<EnumType>(first.type) < static_cast<EnumType>(second.type);
 			});
+		if (it != std::end(mAccumulatedSizes) && it->type == aToAdd.type) {
+			it->descriptorCount += aToAdd.descriptorCount;
+		}
+		else {
+			mAccumulatedSizes.insert(it, aToAdd);
+		}
+	}
 
-			if (std::end(mSets) != it) {
-				mSets.erase(it);
-				++numDeleted;
-				// Iterator could (will) have been invalidated => reinitialize:
-				it = std::begin(mSets);
-			}
-		} while (std::end(mSets) != it);
-		return numDeleted;
+	descriptor_alloc_request descriptor_alloc_request::multiply_size_requirements(uint32_t mFactor) const
+	{
+		auto copy = descriptor_alloc_request{*this};
+		for (auto& sr : copy.mAccumulatedSizes) {
+			sr.descriptorCount *= mFactor;
+		}
+		return copy;
 	}
+#pragma endregion
 
-	int descriptor_cache_t::remove_sets_with_handle(vk::Buffer aHandle)
+#pragma region descriptor pool definitions
+	descriptor_pool root::create_descriptor_pool(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, const std::vector<vk::DescriptorPoolSize>& aSizeRequirements, int aNumSets)
 	{
-		int numDeleted = 0;
-		auto it = std::begin(mSets);
-		do {
-			it = std::find_if(std::begin(mSets), std::end(mSets), [aHandle](const descriptor_set& aSet) {
-				auto n = aSet.number_of_writes();
-				for (decltype(n) i = 0; i < n; ++i) {
-					const auto& w = aSet.write_at(i);
-					auto dn = w.descriptorCount;
-					if (0u == dn || nullptr == w.pBufferInfo) {
-						continue;
-					}
-					for (decltype(dn) di = 0; di < dn; ++di) {
-						if (w.pBufferInfo[di].buffer == aHandle) {
-							return true;
-						}
-					}
-				}
-				return false;
-				});
+		descriptor_pool result;
+		result.mInitialCapacities = aSizeRequirements;
+		result.mRemainingCapacities = aSizeRequirements;
+		result.mNumInitialSets = aNumSets;
+		result.mNumRemainingSets = aNumSets;
 
-			if (std::end(mSets) != it) {
-				mSets.erase(it);
-				++numDeleted;
-				// Iterator could (will) have been invalidated => reinitialize:
-				it = std::begin(mSets);
-			}
-		} while (std::end(mSets) != it);
-		return numDeleted;
+		// Create it:
+		auto createInfo = vk::DescriptorPoolCreateInfo()
+			.setPoolSizeCount(static_cast<uint32_t>(result.mInitialCapacities.size()))
+			.setPPoolSizes(result.mInitialCapacities.data())
+			.setMaxSets(aNumSets)
+			.setFlags(vk::DescriptorPoolCreateFlags()); // The structure has an optional flag similar to command pools that determines if individual descriptor sets can be freed or not: VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT. We're not going to touch the descriptor set after creating it, so we don't need this flag. [10]
+		result.mDescriptorPool = aDevice.createDescriptorPoolUnique(createInfo, nullptr, aDispatchLoader);
+
+		AVK_LOG_DEBUG("Allocated pool with flags[" + vk::to_string(createInfo.flags) + "], maxSets[" + std::to_string(createInfo.maxSets) + "], remaining-sets[" + std::to_string(result.mNumRemainingSets) + "], size-entries[" + std::to_string(createInfo.poolSizeCount) + "]");
+#if defined(_DEBUG)
+		for (size_t i=0; i < aSizeRequirements.size(); ++i) {
+			AVK_LOG_DEBUG_VERBOSE("          [" + std::to_string(i) + "]: descriptorCount[" + std::to_string(aSizeRequirements[i].descriptorCount) + "], descriptorType[" + vk::to_string(aSizeRequirements[i].type) + "]");
+		}
+#endif
+
+		return result;
 	}
 
-	int descriptor_cache_t::remove_sets_with_handle(vk::Sampler aHandle)
+	descriptor_pool root::create_descriptor_pool(const std::vector<vk::DescriptorPoolSize>& aSizeRequirements, int aNumSets)
 	{
-		int numDeleted = 0;
-		auto it = std::begin(mSets);
-		do {
-			it = std::find_if(std::begin(mSets), std::end(mSets), [aHandle](const descriptor_set& aSet) {
-				auto n = aSet.number_of_writes();
-				for (decltype(n) i = 0; i < n; ++i) {
-					const auto& w = aSet.write_at(i);
-					auto dn = w.descriptorCount;
-					if (0u == dn || nullptr == w.pImageInfo) {
-						continue;
-					}
-					for (decltype(dn) di = 0; di < dn; ++di) {
-						if (w.pImageInfo[di].sampler == aHandle) {
-							return true;
-						}
-					}
-				}
-				return false;
-				});
-
-			if (std::end(mSets) != it) {
-				mSets.erase(it);
-				++numDeleted;
-				// Iterator could (will) have been invalidated => reinitialize:
-				it = std::begin(mSets);
-			}
-		} while (std::end(mSets) != it);
-		return numDeleted;
+		return create_descriptor_pool(device(), dispatch_loader_core(), aSizeRequirements, aNumSets);
 	}
 
-	int descriptor_cache_t::remove_sets_with_handle(vk::BufferView aHandle)
+	bool descriptor_pool::has_capacity_for(const descriptor_alloc_request& pRequest) const
 	{
-		int numDeleted = 0;
-		auto it = std::begin(mSets);
-		do {
-			it = std::find_if(std::begin(mSets), std::end(mSets), [aHandle](const descriptor_set& aSet) {
-				auto n = aSet.number_of_writes();
-				for (decltype(n) i = 0; i < n; ++i) {
-					const auto& w = aSet.write_at(i);
-					auto dn = w.descriptorCount;
-					if (0u == dn || nullptr == w.pTexelBufferView) {
-						continue;
-					}
-					for (decltype(dn) di = 0; di < dn; ++di) {
-						if (w.pTexelBufferView[di] == aHandle) {
-							return true;
-						}
-					}
-				}
-				return false;
-				});
+		if (mNumRemainingSets < static_cast<int>(pRequest.num_sets())) {
+			return false;
+		}
 
-			if (std::end(mSets) != it) {
-				mSets.erase(it);
-				++numDeleted;
-				// Iterator could (will) have been invalidated => reinitialize:
-				it = std::begin(mSets);
-			}
-		} while (std::end(mSets) != it);
-		return numDeleted;
-	}
+		const auto& weNeed = pRequest.accumulated_pool_sizes();
+		const auto& weHave = mRemainingCapacities;
 
-#pragma endregion
+#ifdef _DEBUG
+		for (size_t i = 0; i < weNeed.size() - 1; ++i) {
+			assert(weNeed[i].type < weNeed[i + 1].type);
+		}
+		for (size_t i = 0; i < weHave.size() - 1; ++i) {
+			assert(weHave[i].type < weHave[i + 1].type);
+		}
+#endif
 
-#pragma region fence definitions
-	fence_t::~fence_t()
-	{
-		if (mCustomDeleter.has_value() && *mCustomDeleter) {
-			// If there is a custom deleter => call it now
-			(*mCustomDeleter)();
-			mCustomDeleter.reset();
+		// Accumulate all the requirements of all the sets
+		using EnumType = std::underlying_type<vk::DescriptorType>::type;
+		size_t n = 0, h = 0, N = weNeed.size(), H = weHave.size();
+		while (n < N && h < H) {
+			auto needType = static_cast<EnumType>(weNeed[n].type);
+			auto haveType = static_cast<EnumType>(weHave[h].type);
+			if (haveType < needType) {
+				h++;
+				continue;
+			}
+			if (needType == haveType && weNeed[n].descriptorCount <= weHave[n].descriptorCount) {
+				n++;
+				h++;
+				continue;
+			}
+			return false;
 		}
-		// Destroy the dependant instance before destroying myself
-		// ^ This is ensured by the order of the members
-		//   See: https://isocpp.org/wiki/faq/dtors#calling-member-dtors
+		return n == N; // if true => all checks have passed, if false => checks failed
 	}
 
-	fence_t& fence_t::handle_lifetime_of(any_owning_resource_t aResource)
+	std::vector<vk::DescriptorSet> descriptor_pool::allocate(const std::vector<std::reference_wrapper<const descriptor_set_layout>>& aLayouts)
 	{
-		mLifetimeHandledResources.push_back(std::move(aResource));
-		return *this;
-	}
+		std::vector<vk::DescriptorSetLayout> setLayouts;
+		setLayouts.reserve(aLayouts.size());
+		for (auto& in : aLayouts) {
+			setLayouts.emplace_back(in.get().handle());
+		}
 
-	void fence_t::wait_until_signalled(std::optional<uint64_t> aTimeout) const
-	{
-		// ReSharper disable once CppExpressionWithoutSideEffects
-		auto result = mFence.getOwner().waitForFences(1u, handle_ptr(), VK_TRUE, aTimeout.value_or(UINT64_MAX));
-		assert(static_cast<VkResult>(result) >= 0);
-	}
+		auto allocInfo = vk::DescriptorSetAllocateInfo()
+			.setDescriptorPool(mDescriptorPool.get())
+			.setDescriptorSetCount(static_cast<uint32_t>(setLayouts.size()))
+			.setPSetLayouts(setLayouts.data());
 
-	void fence_t::reset()
-	{
-		// ReSharper disable once CppExpressionWithoutSideEffects
-		auto result = mFence.getOwner().resetFences(1u, handle_ptr());
-		if (mCustomDeleter.has_value() && *mCustomDeleter) {
-			// If there is a custom deleter => call it now
-			(*mCustomDeleter)();
-			mCustomDeleter.reset();
+		AVK_LOG_DEBUG_VERBOSE("Allocating from pool with remaining-sets[" + std::to_string(mNumRemainingSets) + "] and remaining-capacities:");
+#if defined(_DEBUG)
+		for (size_t i=0; i < mRemainingCapacities.size(); ++i) {
+			AVK_LOG_DEBUG_VERBOSE("          [" + std::to_string(i) + "]: descriptorCount[" + std::to_string(mRemainingCapacities[i].descriptorCount) + "], descriptorType[" + vk::to_string(mRemainingCapacities[i].type) + "]");
 		}
-	}
+#endif
+		AVK_LOG_DEBUG_VERBOSE("...going to allocate " + std::to_string(aLayouts.size()) + " set(s) of the following:");
+#if defined(_DEBUG)
+		for (size_t i=0; i < aLayouts.size(); ++i) {
+			AVK_LOG_DEBUG_VERBOSE("          [" + std::to_string(i) + "]: number_of_bindings[" + std::to_string(aLayouts[i].get().number_of_bindings()) + "]");
+			for (size_t j=0; j < aLayouts[i].get().number_of_bindings(); j++) {
+				AVK_LOG_DEBUG_VERBOSE("               [" + std::to_string(j) + "]: descriptorCount[" + std::to_string(aLayouts[i].get().binding_at(j).descriptorCount) + "], descriptorType[" + vk::to_string(aLayouts[i].get().binding_at(j).descriptorType) + "]");
+			}
+			AVK_LOG_DEBUG_VERBOSE("          [" + std::to_string(i) + "]: required pool sizes (whatever the difference to 'bindings' is)");
+			auto& rps = aLayouts[i].get().required_pool_sizes();
+			for (size_t j=0; j < rps.size(); j++) {
+				AVK_LOG_DEBUG_VERBOSE("               [" + std::to_string(j) + "]: descriptorCount[" + std::to_string(rps[j].descriptorCount) + "], descriptorType[" + vk::to_string(rps[j].type) + "]");
+			}
+		}
+#endif
 
-	fence root::create_fence(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, bool aCreateInSignalledState, std::function<void(fence_t&)> aAlterConfigBeforeCreation)
-	{
-		fence_t result;
-		result.mCreateInfo = vk::FenceCreateInfo()
-			.setFlags(aCreateInSignalledState
-						? vk::FenceCreateFlagBits::eSignaled
-						: vk::FenceCreateFlags()
-			);
+		assert(mDescriptorPool);
+		auto result = mDescriptorPool.getOwner().allocateDescriptorSets(allocInfo);
 
-		// Maybe alter the config?
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(result);
+		// Update the pool's stats:
+		for (const descriptor_set_layout& dsl : aLayouts) {
+			for (const auto& dps : dsl.required_pool_sizes()) {
+				auto it = std::find_if(std::begin(mRemainingCapacities), std::end(mRemainingCapacities), [&dps](vk::DescriptorPoolSize& el){
+					return el.type == dps.type;
+				});
+				if (std::end(mRemainingCapacities) == it) {
+					AVK_LOG_WARNING("Couldn't find the descriptor type that we have just allocated in mRemainingCapacities. How could this have happened?");
+				}
+				else {
+					it->descriptorCount -= std::min(dps.descriptorCount, it->descriptorCount);
+				}
+			}
 		}
 
-		result.mFence = aDevice.createFenceUnique(result.mCreateInfo, nullptr, aDispatchLoader);
+		mNumRemainingSets -= static_cast<int>(aLayouts.size());
+
 		return result;
 	}
 
-	fence root::create_fence(bool aCreateInSignalledState, std::function<void(fence_t&)> aAlterConfigBeforeCreation)
+	void descriptor_pool::reset()
 	{
-		return create_fence(device(), dispatch_loader_core(), aCreateInSignalledState, std::move(aAlterConfigBeforeCreation));
+		mDescriptorPool.getOwner().resetDescriptorPool(mDescriptorPool.get());
+		mRemainingCapacities = mInitialCapacities;
+		mNumRemainingSets = mNumInitialSets;
 	}
-#pragma endregion
 
-#pragma region framebuffer definitions
-	void root::check_and_config_attachments_based_on_views(std::vector<attachment>& aAttachments, std::vector<image_view>& aImageViews)
+	descriptor_cache root::create_descriptor_cache(std::string aName)
 	{
-		if (aAttachments.size() != aImageViews.size()) {
-			throw avk::runtime_error("Incomplete config for framebuffer creation: number of attachments (" + std::to_string(aAttachments.size()) + ") does not equal the number of image views (" + std::to_string(aImageViews.size()) + ")");
-		}
-		auto n = aAttachments.size();
-		for (size_t i = 0; i < n; ++i) {
-			auto& a = aAttachments[i];
-			auto& v = aImageViews[i];
-			if ((is_depth_format(v->get_image().format()) || has_stencil_component(v->get_image().format())) && !a.is_used_as_depth_stencil_attachment()) {
-				AVK_LOG_WARNING("Possibly misconfigured framebuffer: image[" + std::to_string(i) + "] is a depth/stencil format, but it is never indicated to be used as such in the attachment-description[" + std::to_string(i) + "].");
-			}
+		if (aName.empty()) {
+			static int sDescCacheId = 1;
+			aName = "Descriptor Cache #" + std::to_string(sDescCacheId++);
 		}
+
+		descriptor_cache_t result;
+		result.mName = std::move(aName);
+		result.mRoot = this;
+		return result;
 	}
+#pragma endregion
 
-	framebuffer root::create_framebuffer(renderpass aRenderpass, std::vector<image_view> aImageViews, uint32_t aWidth, uint32_t aHeight, std::function<void(framebuffer_t&)> aAlterConfigBeforeCreation)
-	{
-		framebuffer_t result;
-		result.mRenderpass = std::move(aRenderpass);
-		result.mImageViews = std::move(aImageViews);
+#pragma region descriptor set layout definitions
 
-		std::vector<vk::ImageView> imageViewHandles;
-		for (const auto& iv : result.mImageViews) {
-			imageViewHandles.push_back(iv->handle());
+	bool operator ==(const descriptor_set_layout& left, const descriptor_set_layout& right) {
+		const auto n = left.mOrderedBindings.size();
+		if (n != right.mOrderedBindings.size()) {
+			return false;
 		}
-
-		result.mCreateInfo = vk::FramebufferCreateInfo{}
-			.setRenderPass(result.mRenderpass->handle())
-			.setAttachmentCount(static_cast<uint32_t>(imageViewHandles.size()))
-			.setPAttachments(imageViewHandles.data())
-			.setWidth(aWidth)
-			.setHeight(aHeight)
-			// TODO: Support multiple layers of image arrays!
-			.setLayers(1u); // number of layers in image arrays [6]
-
-		// Maybe alter the config?!
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(result);
+		for (size_t i = 0; i < n; ++i) {
+			if (left.mOrderedBindings[i] != right.mOrderedBindings[i]) {
+				return false;
+			}
 		}
+		return true;
+	}
 
-		result.mFramebuffer = device().createFramebufferUnique(result.mCreateInfo, nullptr, dispatch_loader_core());
-		return result;
+	bool operator !=(const descriptor_set_layout& left, const descriptor_set_layout& right) {
+		return !(left == right);
 	}
 
-	framebuffer root::create_framebuffer(std::vector<attachment> aAttachments, std::vector<image_view> aImageViews, uint32_t aWidth, uint32_t aHeight, std::function<void(framebuffer_t&)> aAlterConfigBeforeCreation)
+	void root::allocate_descriptor_set_layout(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, descriptor_set_layout& aLayoutToBeAllocated)
 	{
-		check_and_config_attachments_based_on_views(aAttachments, aImageViews);
-		return create_framebuffer(
-			create_renderpass(std::move(aAttachments)),
-			std::move(aImageViews),
-			aWidth, aHeight,
-			std::move(aAlterConfigBeforeCreation)
-		);
+		if (!aLayoutToBeAllocated.mLayout) {
+			// Allocate the layout and return the result:
+			auto createInfo = vk::DescriptorSetLayoutCreateInfo()
+				.setBindingCount(static_cast<uint32_t>(aLayoutToBeAllocated.mOrderedBindings.size()))
+				.setPBindings(aLayoutToBeAllocated.mOrderedBindings.data());
+			aLayoutToBeAllocated.mLayout = aDevice.createDescriptorSetLayoutUnique(createInfo, nullptr, aDispatchLoader);
+		}
+		else {
+			AVK_LOG_ERROR("descriptor_set_layout's handle already has a value => it most likely has already been allocated. Won't do it again.");
+		}
 	}
 
-	framebuffer root::create_framebuffer(renderpass aRenderpass, std::vector<image_view> aImageViews, std::function<void(framebuffer_t&)> aAlterConfigBeforeCreation)
+	void root::allocate_descriptor_set_layout(descriptor_set_layout& aLayoutToBeAllocated)
 	{
-		assert(!aImageViews.empty());
-		auto extent = aImageViews.front()->get_image().create_info().extent;
-		return create_framebuffer(std::move(aRenderpass), std::move(aImageViews), extent.width, extent.height, std::move(aAlterConfigBeforeCreation));
+		return allocate_descriptor_set_layout(device(), dispatch_loader_core(), aLayoutToBeAllocated);
 	}
 
-	framebuffer root::create_framebuffer(std::vector<avk::attachment> aAttachments, std::vector<image_view> aImageViews, std::function<void(framebuffer_t&)> aAlterConfigBeforeCreation)
+	descriptor_set_layout root::create_descriptor_set_layout_from_template(const descriptor_set_layout& aTemplate)
 	{
-		check_and_config_attachments_based_on_views(aAttachments, aImageViews);
-		return create_framebuffer(
-			create_renderpass(std::move(aAttachments)),
-			std::move(aImageViews),
-			std::move(aAlterConfigBeforeCreation)
-		);
+		descriptor_set_layout result;
+		result.mBindingRequirements = aTemplate.mBindingRequirements;
+		result.mOrderedBindings = aTemplate.mOrderedBindings;
+		allocate_descriptor_set_layout(result);
+		return result;
 	}
 
-	framebuffer root::create_framebuffer_from_template(const framebuffer_t& aTemplate, std::function<void(image_t&)> aAlterImageConfigBeforeCreation,
-		std::function<void(image_view_t&)> aAlterImageViewConfigBeforeCreation, std::function<void(framebuffer_t&)> aAlterFramebufferConfigBeforeCreation)
+	set_of_descriptor_set_layouts set_of_descriptor_set_layouts::prepare(std::vector<binding_data> pBindings)
 	{
-		const auto& templateImageViews = aTemplate.image_views();
-		std::vector<image_view> imageViews;
+		set_of_descriptor_set_layouts result;
+		std::vector<binding_data> orderedBindings;
+		uint32_t minSetId = std::numeric_limits<uint32_t>::max();
+		uint32_t maxSetId = std::numeric_limits<uint32_t>::min();
 
-		for (auto& imView : templateImageViews)	{
-			auto imageView = create_image_view_from_template(*imView, aAlterImageConfigBeforeCreation, aAlterImageViewConfigBeforeCreation);
-			imageViews.emplace_back(std::move(imageView));
+		// Step 1: order the bindings
+		for (auto& b : pBindings) {
+			minSetId = std::min(minSetId, b.mSetId);
+			maxSetId = std::max(maxSetId, b.mSetId);
+			auto it = std::lower_bound(std::begin(orderedBindings), std::end(orderedBindings), b); // use operator<
+			orderedBindings.insert(it, b);
 		}
 
-		return create_framebuffer(
-			create_renderpass_from_template(aTemplate.renderpass_reference()),
-			std::move(imageViews),
-			aTemplate.mCreateInfo.width,
-			aTemplate.mCreateInfo.height,
-			aAlterFramebufferConfigBeforeCreation
-		);
-	}
-#pragma endregion
-
-#pragma region geometry instance definitions
-#if VK_HEADER_VERSION >= 135
-	geometry_instance root::create_geometry_instance(const bottom_level_acceleration_structure_t& aBlas)
-	{
-		// glm::mat4 mTransform;
-		// uint32_t mInstanceCustomIndex;
-		// uint32_t mMask;
-		// size_t mInstanceOffset;
-		// vk::GeometryInstanceFlagsKHR mFlags;
-		// uint64_t mAccelerationStructureDeviceHandle;
-		return geometry_instance
-		{
-			{ 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f },
-			0,
-			0xff,
-			0,
-			vk::GeometryInstanceFlagsKHR(),
-			aBlas.device_address()
-		};
-	}
-
-	geometry_instance& geometry_instance::set_transform(VkTransformMatrixKHR aTransformationMatrix)
-	{
-		mTransform.matrix[0][0] = aTransformationMatrix.matrix[0][0];
-		mTransform.matrix[0][1] = aTransformationMatrix.matrix[0][1];
-		mTransform.matrix[0][2] = aTransformationMatrix.matrix[0][2];
-		mTransform.matrix[0][3] = aTransformationMatrix.matrix[0][3];
-		mTransform.matrix[1][0] = aTransformationMatrix.matrix[1][0];
-		mTransform.matrix[1][1] = aTransformationMatrix.matrix[1][1];
-		mTransform.matrix[1][2] = aTransformationMatrix.matrix[1][2];
-		mTransform.matrix[1][3] = aTransformationMatrix.matrix[1][3];
-		mTransform.matrix[2][0] = aTransformationMatrix.matrix[2][0];
-		mTransform.matrix[2][1] = aTransformationMatrix.matrix[2][1];
-		mTransform.matrix[2][2] = aTransformationMatrix.matrix[2][2];
-		mTransform.matrix[2][3] = aTransformationMatrix.matrix[2][3];
-		return *this;
-	}
+		// Step 2: assemble the separate sets
+		result.mFirstSetId = minSetId;
+		result.mLayouts.reserve(maxSetId); // Also create layouts for sets that have no bindings, i.e. ALWAYS prepare ALL sets for EACH set-id from 0 to maxSetId
+		for (uint32_t setId = 0u; setId <= maxSetId; ++setId) {
+			auto lb = std::lower_bound(std::begin(orderedBindings), std::end(orderedBindings), binding_data{ setId },
+				[](const binding_data& first, const binding_data& second) -> bool {
+					return first.mSetId < second.mSetId;
+				});
+			auto ub = std::upper_bound(std::begin(orderedBindings), std::end(orderedBindings), binding_data{ setId },
+				[](const binding_data& first, const binding_data& second) -> bool {
+					return first.mSetId < second.mSetId;
+				});
+			// For empty sets, lb==ub, which means no descriptors will be regarded. This should be fine.
+			result.mLayouts.push_back(descriptor_set_layout::prepare(lb, ub));
+		}
 
-	geometry_instance& geometry_instance::set_transform_row_major(float aTransformationMatrix[3][4])
-	{
-		mTransform.matrix[0][0] = aTransformationMatrix[0][0];
-		mTransform.matrix[0][1] = aTransformationMatrix[0][1];
-		mTransform.matrix[0][2] = aTransformationMatrix[0][2];
-		mTransform.matrix[0][3] = aTransformationMatrix[0][3];
-		mTransform.matrix[1][0] = aTransformationMatrix[1][0];
-		mTransform.matrix[1][1] = aTransformationMatrix[1][1];
-		mTransform.matrix[1][2] = aTransformationMatrix[1][2];
-		mTransform.matrix[1][3] = aTransformationMatrix[1][3];
-		mTransform.matrix[2][0] = aTransformationMatrix[2][0];
-		mTransform.matrix[2][1] = aTransformationMatrix[2][1];
-		mTransform.matrix[2][2] = aTransformationMatrix[2][2];
-		mTransform.matrix[2][3] = aTransformationMatrix[2][3];
-		return *this;
-	}
+		// Step 3: Accumulate the binding requirements a.k.a. vk::DescriptorPoolSize entries
+		for (auto& dsl : result.mLayouts) {
+			for (auto& dps : dsl.required_pool_sizes()) {
+				// find position where to insert in vector
+				auto it = std::lower_bound(std::begin(result.mBindingRequirements), std::end(result.mBindingRequirements),
+					dps,
+					[](const vk::DescriptorPoolSize& first, const vk::DescriptorPoolSize& second) -> bool {
+						using EnumType = std::underlying_type<vk::DescriptorType>::type;
+						return static_cast<EnumType>(first.type) < static_cast<EnumType>(second.type);
+					});
+				// Maybe accumulate
+				if (it != std::end(result.mBindingRequirements) && it->type == dps.type) {
+					it->descriptorCount += dps.descriptorCount;
+				}
+				else {
+					result.mBindingRequirements.insert(it, dps);
+				}
+			}
+		}
 
-	geometry_instance& geometry_instance::set_transform_row_major(std::array<float, 16> aTransformationMatrix)
-	{
-		mTransform.matrix[0][0] = aTransformationMatrix[0];
-		mTransform.matrix[0][1] = aTransformationMatrix[1];
-		mTransform.matrix[0][2] = aTransformationMatrix[2];
-		mTransform.matrix[0][3] = aTransformationMatrix[3];
-		mTransform.matrix[1][0] = aTransformationMatrix[4];
-		mTransform.matrix[1][1] = aTransformationMatrix[5];
-		mTransform.matrix[1][2] = aTransformationMatrix[6];
-		mTransform.matrix[1][3] = aTransformationMatrix[7];
-		mTransform.matrix[2][0] = aTransformationMatrix[8];
-		mTransform.matrix[2][1] = aTransformationMatrix[9];
-		mTransform.matrix[2][2] = aTransformationMatrix[10];
-		mTransform.matrix[2][3] = aTransformationMatrix[11];
-		return *this;
+		// Done with the preparation. (None of the descriptor_set_layout members have been allocated at this point.)
+		return result;
 	}
 
-	geometry_instance& geometry_instance::set_transform_column_major(std::array<float, 16> aTransformationMatrix)
+	void root::allocate_set_of_descriptor_set_layouts(set_of_descriptor_set_layouts& aLayoutsToBeAllocated)
 	{
-		mTransform.matrix[0][0] = aTransformationMatrix[0];
-		mTransform.matrix[0][1] = aTransformationMatrix[4];
-		mTransform.matrix[0][2] = aTransformationMatrix[8];
-		mTransform.matrix[0][3] = aTransformationMatrix[12];
-		mTransform.matrix[1][0] = aTransformationMatrix[1];
-		mTransform.matrix[1][1] = aTransformationMatrix[5];
-		mTransform.matrix[1][2] = aTransformationMatrix[9];
-		mTransform.matrix[1][3] = aTransformationMatrix[13];
-		mTransform.matrix[2][0] = aTransformationMatrix[2];
-		mTransform.matrix[2][1] = aTransformationMatrix[6];
-		mTransform.matrix[2][2] = aTransformationMatrix[10];
-		mTransform.matrix[2][3] = aTransformationMatrix[14];
-		return *this;
+		for (auto& dsl : aLayoutsToBeAllocated.mLayouts) {
+			allocate_descriptor_set_layout(dsl);
+		}
 	}
 
-	geometry_instance& geometry_instance::set_custom_index(uint32_t aCustomIndex)
+	set_of_descriptor_set_layouts root::create_set_of_descriptor_set_layouts_from_template(const set_of_descriptor_set_layouts& aTemplate)
 	{
-		mInstanceCustomIndex = aCustomIndex;
-		return *this;
+		set_of_descriptor_set_layouts result;
+		result.mBindingRequirements = aTemplate.mBindingRequirements;
+		result.mFirstSetId = aTemplate.mFirstSetId;
+		for (const auto& lay : aTemplate.mLayouts) {
+			result.mLayouts.push_back(create_descriptor_set_layout_from_template(lay));
+		}
+		return result;
 	}
 
-	geometry_instance& geometry_instance::set_mask(uint32_t aMask)
+	std::vector<vk::DescriptorSetLayout> set_of_descriptor_set_layouts::layout_handles() const
 	{
-		mMask = aMask;
-		return *this;
+		std::vector<vk::DescriptorSetLayout> allHandles;
+		allHandles.reserve(mLayouts.size());
+		for (const auto& dsl : mLayouts) {
+			allHandles.push_back(dsl.handle());
+		}
+		return allHandles;
 	}
+#pragma endregion
 
-	geometry_instance& geometry_instance::set_instance_offset(size_t aOffset)
-	{
-		mInstanceOffset = aOffset;
-		return *this;
-	}
+#pragma region standard descriptor set
 
-	geometry_instance& geometry_instance::set_flags(vk::GeometryInstanceFlagsKHR aFlags)
+	const descriptor_set_layout& descriptor_cache_t::get_or_alloc_layout(descriptor_set_layout aPreparedLayout)
 	{
-		mFlags = aFlags;
-		return *this;
-	}
+		const auto it = mLayouts.find(aPreparedLayout);
+		if (mLayouts.end() != it) {
+			assert(it->handle());
+			return *it;
+		}
 
-	geometry_instance& geometry_instance::add_flags(vk::GeometryInstanceFlagsKHR aFlags)
-	{
-		mFlags |= aFlags;
-		return *this;
-	}
+		root::allocate_descriptor_set_layout(mRoot->device(), mRoot->dispatch_loader_core(), aPreparedLayout);
 
-	geometry_instance& geometry_instance::disable_culling()
-	{
-		mFlags |= vk::GeometryInstanceFlagBitsKHR::eTriangleCullDisable;
-		return *this;
+		const auto result = mLayouts.insert(std::move(aPreparedLayout));
+		assert(result.second);
+		return *result.first;
 	}
 
-	geometry_instance& geometry_instance::define_front_faces_to_be_counter_clockwise()
+	std::optional<descriptor_set> descriptor_cache_t::get_descriptor_set_from_cache(const descriptor_set& aPreparedSet)
 	{
-		mFlags |= vk::GeometryInstanceFlagBitsKHR::eTriangleFrontCounterclockwise;
-		return *this;
+		const auto it = mSets.find(aPreparedSet);
+		if (mSets.end() != it) {
+			auto found = *it;
+			// This might not be the veeeery best place to alter the set-id, but let's go for it:
+			found.set_set_id(aPreparedSet.set_id());
+			return found;
+		}
+		return {};
 	}
 
-	geometry_instance& geometry_instance::force_opaque()
+	std::vector<descriptor_set> descriptor_cache_t::alloc_new_descriptor_sets(const std::vector<std::reference_wrapper<const descriptor_set_layout>>& aLayouts, std::vector<descriptor_set> aPreparedSets)
 	{
-		mFlags |= vk::GeometryInstanceFlagBitsKHR::eForceOpaque;
-		return *this;
-	}
+		assert(aLayouts.size() == aPreparedSets.size());
 
-	geometry_instance& geometry_instance::force_non_opaque()
-	{
-		mFlags |= vk::GeometryInstanceFlagBitsKHR::eForceNoOpaque;
-		return *this;
-	}
+		std::vector<descriptor_set> result;
+		if (aLayouts.empty()) {
+			return result;
+		}
 
-	geometry_instance& geometry_instance::reset_flags()
-	{
-		mFlags = vk::GeometryInstanceFlagsKHR();
-		return *this;
-	}
+		const int n = static_cast<int>(aLayouts.size());
+#ifdef _DEBUG // Perform an extensive sanity check:
+		for (int i = 0; i < n; ++i) {
+			const auto dbgB = aLayouts[i].get().number_of_bindings();
+			assert(dbgB == aPreparedSets[i].number_of_writes());
+			for (size_t j = 0; j < dbgB; ++j) {
+				assert(aLayouts[i].get().binding_at(j).binding			== aPreparedSets[i].write_at(j).dstBinding);
+				assert(aLayouts[i].get().binding_at(j).descriptorCount	== aPreparedSets[i].write_at(j).descriptorCount);
+				assert(aLayouts[i].get().binding_at(j).descriptorType	== aPreparedSets[i].write_at(j).descriptorType);
+			}
+		}
+#endif
 
-	VkAccelerationStructureInstanceKHR convert_for_gpu_usage(const geometry_instance& aGeomInst)
-	{
-		VkAccelerationStructureInstanceKHR element;
-		element.transform = aGeomInst.mTransform;
-		element.instanceCustomIndex = aGeomInst.mInstanceCustomIndex;
-		element.mask = aGeomInst.mMask;
-		element.instanceShaderBindingTableRecordOffset = aGeomInst.mInstanceOffset;
-		element.flags = static_cast<uint32_t>(aGeomInst.mFlags);
-		element.accelerationStructureReference = aGeomInst.mAccelerationStructureDeviceHandle;
-		return element;
-	}
-
-	std::vector<VkAccelerationStructureInstanceKHR> convert_for_gpu_usage(const std::vector<geometry_instance>& aGeomInstances)
-	{
-		if (aGeomInstances.empty()) {
-			AVK_LOG_WARNING("Empty vector of geometry instances passed to convert_for_gpu_usage");
+		// Find possible duplicates within the descriptor sets, and store the unique layouts so that we do not over-allocate:
+		std::vector<std::reference_wrapper<const descriptor_set_layout>> layoutsOfUniqueSets;
+		std::vector<int> duplicateSetIndices; // -1 ... no duplicate, [0..n) ... duplicate at the given index
+		layoutsOfUniqueSets.push_back(aLayouts[0]);
+		duplicateSetIndices.emplace_back(-1);
+		for (int i = 1; i < n; ++i) {
+			for (int j = 0; j < i; ++j) {
+				if (aPreparedSets[i] == aPreparedSets[j]) {
+					duplicateSetIndices.emplace_back(j);
+				}
+			}
+			if (static_cast<int>(duplicateSetIndices.size()) == i) { // No duplicate found => nothing inserted
+				layoutsOfUniqueSets.push_back(aLayouts[i]);
+				duplicateSetIndices.emplace_back(-1);
+			}
 		}
+		assert(layoutsOfUniqueSets.size() <= aLayouts.size());
+		assert(duplicateSetIndices.size() == aPreparedSets.size());
 
-		std::vector<VkAccelerationStructureInstanceKHR> instancesGpu;
-		instancesGpu.reserve(aGeomInstances.size());
-		for (auto& data : aGeomInstances) {
-			instancesGpu.emplace_back(convert_for_gpu_usage(data));
+		// Find a pool with enough space left for the layouts (only those required => layoutsOfUniqueSets),
+		// or alloc a new pool:
+		auto allocRequest = descriptor_alloc_request{ layoutsOfUniqueSets };
+
+		std::shared_ptr<descriptor_pool> pool = nullptr;
+		std::vector<vk::DescriptorSet> setHandles;
+
+		auto poolToTry = get_descriptor_pool_for_layouts(allocRequest);
+
+		int maxTries = 3;
+		while (!pool && maxTries-- > 0) {
+			try {
+				assert(poolToTry->has_capacity_for(allocRequest));
+				// Alloc the whole thing:
+				setHandles = poolToTry->allocate(aLayouts);
+				assert(setHandles.size() == aPreparedSets.size());
+				// Success
+				pool = poolToTry;
+			}
+			catch (vk::OutOfPoolMemoryError& fail) {
+				AVK_LOG_ERROR(std::string("Failed to allocate descriptor sets from pool: ") + fail.what());
+				switch (maxTries) {
+				case 1:
+					AVK_LOG_INFO("Trying again with doubled size requirements...");
+					allocRequest = allocRequest.multiply_size_requirements(2u);
+					poolToTry = get_descriptor_pool_for_layouts(allocRequest);
+					break;
+				default:
+					AVK_LOG_INFO("Trying again with new pool..."); // and possibly doubled size requirements, depending on whether maxTries is 2 or 0
+					poolToTry = get_descriptor_pool_for_layouts(allocRequest, true);
+					break;
+				}
+			}
 		}
-		return instancesGpu;
-	}
-#endif
-#pragma endregion
 
-#pragma region graphics pipeline config definitions
+		assert(pool);
+		assert(setHandles.size() > 0);
 
-	// Set sensible defaults:
-	graphics_pipeline_config::graphics_pipeline_config()
-		: mPipelineSettings{ cfg::pipeline_settings::nothing }
-		, mDynamicRenderingAttachments {}
-		, mRenderPassSubpass {} // not set by default
-		, mPrimitiveTopology{ cfg::primitive_topology::triangles } // triangles after one another
-		, mRasterizerGeometryMode{ cfg::rasterizer_geometry_mode::rasterize_geometry } // don't discard, but rasterize!
-		, mPolygonDrawingModeAndConfig{ cfg::polygon_drawing::config_for_filling() } // Fill triangles
-		, mCullingMode{ cfg::culling_mode::cull_back_faces } // Cull back faces
-		, mDynamicRendering {cfg::dynamic_rendering::disabled }
-		, mFrontFaceWindingOrder{ cfg::front_face::define_front_faces_to_be_counter_clockwise() } // CCW == front face
-		, mDepthClampBiasConfig{ cfg::depth_clamp_bias::config_nothing_special() } // no clamp, no bias, no factors
-		, mDepthTestConfig{ cfg::depth_test::enabled() } // enable depth testing
-		, mDepthWriteConfig{ cfg::depth_write::enabled() } // enable depth writing
-		, mDepthBoundsConfig{ cfg::depth_bounds::disable() }
-		, mColorBlendingSettings{ cfg::color_blending_settings::disable_logic_operation() }
-		, mTessellationPatchControlPoints {}
-	{
+		// Finish configuration (most importantly: write descriptors), and just make copies for the duplicates:
+		for (int i = 0; i < n; ++i) {
+			const bool isDuplicate = -1 != duplicateSetIndices[i];
+			const int setIndex = isDuplicate ? duplicateSetIndices[i] : i;
+
+			if (!isDuplicate) {
+				assert(setIndex == i);
+				auto& setToBeCompleted = aPreparedSets[setIndex];
+				setToBeCompleted.link_to_handle_and_pool(std::move(setHandles[setIndex]), pool);
+				setToBeCompleted.update_data_pointers();
+				setToBeCompleted.write_descriptors();
+
+				// Your soul... is mine:
+				const auto cachedSet = mSets.insert(std::move(setToBeCompleted));
+				assert(cachedSet.second); // This must not happen. Duplicate handling should have caught such cases.
+				// Done. Store for result:
+				result.push_back(*cachedSet.first); // Make a copy!
+			}
+			else {
+				assert(setIndex < i);
+				result.emplace_back(result[setIndex]).set_set_id(aPreparedSets[i].set_id()); // Copy the duplicate set
+			}
+		}
+
+		return result;
 	}
 
-	namespace cfg
+	void descriptor_cache_t::cleanup()
 	{
-		viewport_depth_scissors_config viewport_depth_scissors_config::from_framebuffer(const framebuffer_t& aFramebuffer)
-		{
-			const auto width = aFramebuffer.create_info().width;
-			const auto height = aFramebuffer.create_info().height;
-			return viewport_depth_scissors_config{
-				std::array<float, 2>{{ 0.0f, 0.0f }},
-				std::array<float, 2>{{ static_cast<float>(width), static_cast<float>(height)  }},
-				0.0f, 1.0f,		// TODO: make min/max depth configurable?!
-				vk::Offset2D{ 0, 0 },			// TODO: support different settings for scissor?!
-				vk::Extent2D{{ width, height }},
-				false,
-				false
-			};
-		}
+		mSets.clear();
+		mLayouts.clear();
 	}
-#pragma endregion
 
-#pragma region graphics pipeline definitions
-	void root::rewire_config_and_create_graphics_pipeline(graphics_pipeline_t& aPreparedPipeline)
+	std::shared_ptr<descriptor_pool> descriptor_cache_t::get_descriptor_pool_for_layouts(const descriptor_alloc_request& aAllocRequest, bool aRequestNewPool)
 	{
-		aPreparedPipeline.mPipelineVertexInputStateCreateInfo
-			.setPVertexBindingDescriptions(aPreparedPipeline.mOrderedVertexInputBindingDescriptions.data())
-			.setPVertexAttributeDescriptions(aPreparedPipeline.mVertexInputAttributeDescriptions.data());
+		// We'll allocate the pools per (thread and name)
+		auto tId = std::this_thread::get_id();
+		auto& pools = mDescriptorPools[tId];
 
-		assert(aPreparedPipeline.mShaders.size() == aPreparedPipeline.mShaderStageCreateInfos.size());
-		assert(aPreparedPipeline.mShaders.size() == aPreparedPipeline.mSpecializationInfos.size());
-		for (size_t i = 0; i < aPreparedPipeline.mShaders.size(); ++i) {
-			aPreparedPipeline.mShaderStageCreateInfos[i]
-				.setModule(aPreparedPipeline.mShaders[i].handle())
-				.setPName(aPreparedPipeline.mShaders[i].info().mEntryPoint.c_str());
+		// First of all, do some cleanup => remove all pools which no longer exist:
+		pools.erase(std::remove_if(std::begin(pools), std::end(pools), [](const std::weak_ptr<descriptor_pool>& ptr) {
+			return ptr.expired();
+		}), std::end(pools));
 
-			if (aPreparedPipeline.mSpecializationInfos[i] != vk::SpecializationInfo{}) {
-				assert(aPreparedPipeline.mShaders[i].info().mSpecializationConstants.has_value());
-				aPreparedPipeline.mSpecializationInfos[i].pMapEntries = aPreparedPipeline.mShaders[i].info().mSpecializationConstants.value().mMapEntries.data();
-				aPreparedPipeline.mSpecializationInfos[i].pData = aPreparedPipeline.mShaders[i].info().mSpecializationConstants.value().mData.data();
-				aPreparedPipeline.mShaderStageCreateInfos[i].setPSpecializationInfo(&aPreparedPipeline.mSpecializationInfos[i]);
+		// Find a pool which is capable of allocating this:
+		if (!aRequestNewPool) {
+			for (auto& pool : pools) {
+				if (auto sptr = pool.lock()) {
+					if (sptr->has_capacity_for(aAllocRequest)) {
+						return sptr;
+					}
+				}
 			}
 		}
 
-		aPreparedPipeline.mViewportStateCreateInfo
-			.setViewportCount(static_cast<uint32_t>(aPreparedPipeline.mViewports.size()))
-			.setPViewports(aPreparedPipeline.mViewports.data())
-			.setScissorCount(static_cast<uint32_t>(aPreparedPipeline.mScissors.size()))
-			.setPScissors(aPreparedPipeline.mScissors.data());
+		// We weren't lucky (or new pool has been requested) => create a new pool:
+		AVK_LOG_INFO("Allocating new descriptor pool for thread[" + [tId]() { std::stringstream ss; ss << tId; return ss.str(); }() + "] and name['" + mName + "]");
 
-		aPreparedPipeline.mColorBlendStateCreateInfo
-			.setAttachmentCount(static_cast<uint32_t>(aPreparedPipeline.mBlendingConfigsForColorAttachments.size()))
-			.setPAttachments(aPreparedPipeline.mBlendingConfigsForColorAttachments.data());
+		// TODO: On AMD, it seems that all the entries have to be multiplied as well, while on NVIDIA, only multiplying the number of sets seems to be sufficient
+		//       => How to handle this? Overallocation is as bad as underallocation. Shall we make use of exceptions? Shall we 'if' on the vendor?
 
-		
-		// NOTE(msakmary) Not really sure why we set the samples again when they were previously set in root::create_graphics_pipeline
-		//                (ask for clarification) - but if dynamic rendering is enabled there is no renderpass...
-		const bool dynamicRenderingEnabled = aPreparedPipeline.mRenderingCreateInfo.has_value();
-		if(!dynamicRenderingEnabled)
-		{
-			aPreparedPipeline.mMultisampleStateCreateInfo
-				.setRasterizationSamples(
-					aPreparedPipeline.renderpass_reference().value().get().num_samples_for_subpass(aPreparedPipeline.subpass_id().value()))
-				.setPSampleMask(nullptr);
-		}
+		const bool isNvidia = 0x12d2 == mRoot->capabilities().properties().vendorID;
+		auto amplifiedAllocRequest = aAllocRequest.multiply_size_requirements(prealloc_factor());
+		//if (!isNvidia) { // Let's 'if' on the vendor and see what happens...
+		//}
 
-		aPreparedPipeline.mDynamicStateCreateInfo
-			.setDynamicStateCount(static_cast<uint32_t>(aPreparedPipeline.mDynamicStateEntries.size()))
-			.setPDynamicStates(aPreparedPipeline.mDynamicStateEntries.data());
+		auto newPool = root::create_descriptor_pool(mRoot->device(), mRoot->dispatch_loader_core(),
+			isNvidia
+			  ? aAllocRequest.accumulated_pool_sizes()
+			  : amplifiedAllocRequest.accumulated_pool_sizes(),
+			isNvidia
+			  ? aAllocRequest.num_sets() * prealloc_factor()
+			  : aAllocRequest.num_sets() * prealloc_factor() * 2 // the last factor is a "magic number"/"educated guess"/"preemtive strike"
+		);
 
-		// Pipeline Layout must be rewired already before calling this function
+		auto newPoolPtr = std::make_shared<descriptor_pool>(std::move(newPool));
 
-		// Create the PIPELINE LAYOUT
-		aPreparedPipeline.mPipelineLayout = device().createPipelineLayoutUnique(aPreparedPipeline.mPipelineLayoutCreateInfo, nullptr, dispatch_loader_core());
-		assert(static_cast<bool>(aPreparedPipeline.layout_handle()));
+		//  However, set the stored capacities to the amplified version, to not mess up our internal "has_capacity_for-logic":
+		newPoolPtr->set_remaining_capacities(amplifiedAllocRequest.accumulated_pool_sizes());
+		//if (!isNvidia) {
+		//}
 
-		const void * pNext = dynamicRenderingEnabled ? &(aPreparedPipeline.mRenderingCreateInfo.value()) : nullptr;
-		VkRenderPass render_pass = VK_NULL_HANDLE;
-		if(!dynamicRenderingEnabled)
-		{
-			render_pass = (aPreparedPipeline.mRenderPass.value())->handle();
+		pools.emplace_back(newPoolPtr); // Store as a weak_ptr
+		return newPoolPtr;
+	}
+#pragma endregion
+
+#pragma region descriptor set definitions
+
+	bool operator ==(const descriptor_set& left, const descriptor_set& right)
+	{
+		const auto n = left.mOrderedDescriptorDataWrites.size();
+		if (n != right.mOrderedDescriptorDataWrites.size()) {
+			return false;
 		}
-		// Create the PIPELINE, a.k.a. putting it all together:
-		auto pipelineInfo = vk::GraphicsPipelineCreateInfo{}
-			// 0. Render Pass
-			.setPNext(pNext)
-			.setRenderPass(render_pass)
-			.setSubpass(aPreparedPipeline.mSubpassIndex)
-			// 1., 2., and 3.
-			.setPVertexInputState(&aPreparedPipeline.mPipelineVertexInputStateCreateInfo)
-			// 4.
-			.setPInputAssemblyState(&aPreparedPipeline.mInputAssemblyStateCreateInfo)
-			// 5.
-			.setStageCount(static_cast<uint32_t>(aPreparedPipeline.mShaderStageCreateInfos.size()))
-			.setPStages(aPreparedPipeline.mShaderStageCreateInfos.data())
-			// 6.
-			.setPViewportState(&aPreparedPipeline.mViewportStateCreateInfo)
-			// 7.
-			.setPRasterizationState(&aPreparedPipeline.mRasterizationStateCreateInfo)
-			// 8.
-			.setPDepthStencilState(&aPreparedPipeline.mDepthStencilConfig)
-			// 9.
-			.setPColorBlendState(&aPreparedPipeline.mColorBlendStateCreateInfo)
-			// 10.
-			.setPMultisampleState(&aPreparedPipeline.mMultisampleStateCreateInfo)
-			// 11.
-			.setPDynamicState(aPreparedPipeline.mDynamicStateEntries.size() == 0 ? nullptr : &aPreparedPipeline.mDynamicStateCreateInfo) // Optional
-			// 12.
-			.setFlags(aPreparedPipeline.mPipelineCreateFlags)
-			// LAYOUT:
-			.setLayout(aPreparedPipeline.layout_handle())
-			// Base pipeline:
-			.setBasePipelineHandle(nullptr) // Optional
-			.setBasePipelineIndex(-1); // Optional
-
-		// 13.
-		if (aPreparedPipeline.mPipelineTessellationStateCreateInfo.has_value()) {
-			pipelineInfo.setPTessellationState(&aPreparedPipeline.mPipelineTessellationStateCreateInfo.value());
-		}
-
-		// TODO: Shouldn't the config be altered HERE, after the pipelineInfo has been compiled?!
+		for (size_t i = 0; i < n; ++i) {
+			if (left.mOrderedDescriptorDataWrites[i].dstBinding			!= right.mOrderedDescriptorDataWrites[i].dstBinding			)			{ return false; }
+			if (left.mOrderedDescriptorDataWrites[i].dstArrayElement	!= right.mOrderedDescriptorDataWrites[i].dstArrayElement	)			{ return false; }
+			if (left.mOrderedDescriptorDataWrites[i].descriptorCount	!= right.mOrderedDescriptorDataWrites[i].descriptorCount	)			{ return false; }
+			if (left.mOrderedDescriptorDataWrites[i].descriptorType		!= right.mOrderedDescriptorDataWrites[i].descriptorType		)			{ return false; }
+			if (nullptr != left.mOrderedDescriptorDataWrites[i].pImageInfo) {
+				if (nullptr == right.mOrderedDescriptorDataWrites[i].pImageInfo)																{ return false; }
+				for (size_t j = 0; j < left.mOrderedDescriptorDataWrites[i].descriptorCount; ++j) {
+					if (left.mOrderedDescriptorDataWrites[i].pImageInfo[j] != right.mOrderedDescriptorDataWrites[i].pImageInfo[j])				{ return false; }
+				}
+			}
+			if (nullptr != left.mOrderedDescriptorDataWrites[i].pBufferInfo) {
+				if (nullptr == right.mOrderedDescriptorDataWrites[i].pBufferInfo)																{ return false; }
+				for (size_t j = 0; j < left.mOrderedDescriptorDataWrites[i].descriptorCount; ++j) {
+					if (left.mOrderedDescriptorDataWrites[i].pBufferInfo[j] != right.mOrderedDescriptorDataWrites[i].pBufferInfo[j])			{ return false; }
+				}
+			}
+			if (nullptr != left.mOrderedDescriptorDataWrites[i].pTexelBufferView) {
+				if (nullptr == right.mOrderedDescriptorDataWrites[i].pTexelBufferView)															{ return false; }
+				for (size_t j = 0; j < left.mOrderedDescriptorDataWrites[i].descriptorCount; ++j) {
+					if (left.mOrderedDescriptorDataWrites[i].pTexelBufferView[j] != right.mOrderedDescriptorDataWrites[i].pTexelBufferView[j])	{ return false; }
+				}
+			}
 
-#if VK_HEADER_VERSION >= 141
-		auto result = device().createGraphicsPipelineUnique(nullptr, pipelineInfo, nullptr, dispatch_loader_core());
-		aPreparedPipeline.mPipeline = std::move(result.value);
-#else
-		aPreparedPipeline.mPipeline = device().createGraphicsPipelineUnique(nullptr, pipelineInfo);
+#if VK_HEADER_VERSION >= 135
+			if (nullptr != left.mOrderedDescriptorDataWrites[i].pNext) {
+				if (nullptr == right.mOrderedDescriptorDataWrites[i].pNext)																		{ return false; }
+				if (left.mOrderedDescriptorDataWrites[i].descriptorType == vk::DescriptorType::eAccelerationStructureKHR) {
+					const auto* asInfoLeft = reinterpret_cast<const VkWriteDescriptorSetAccelerationStructureKHR*>(left.mOrderedDescriptorDataWrites[i].pNext);
+					const auto* asInfoRight = reinterpret_cast<const VkWriteDescriptorSetAccelerationStructureKHR*>(right.mOrderedDescriptorDataWrites[i].pNext);
+					if (asInfoLeft->accelerationStructureCount != asInfoRight->accelerationStructureCount)										{ return false; }
+					for (size_t j = 0; j < asInfoLeft->accelerationStructureCount; ++j) {
+						if (asInfoLeft->pAccelerationStructures[j] != asInfoRight->pAccelerationStructures[j])									{ return false; }
+					}
+				}
+			}
 #endif
+		}
+		return true;
 	}
 
-	// Unfortunately C++20 does not have support to easily convert a range into a vector through chaining, so we have to
-	// either pass the ranges begin and end members to the vector constructor every time or implement a helper ourself
-	// until something similar is standardized (There is a to<Container> proposal for C++23).
-	// Using a helper struct to invoke operator| for ranges was inspired by https://stackoverflow.com/a/65635762
-	// This helper implementation converts a range into a vector by piping the range into to_vector():
-	//
-	// auto nums = std::vector{1, 2, 3, 4};
-	// auto num_strings = nums | std::ranges::transform([](auto num) { return std::to_string(num); }) | to_vector();
-	// 
-	namespace to_vector_impl
+	bool operator !=(const descriptor_set& left, const descriptor_set& right)
 	{
-		// Helper type to find the operator| overload below
-		struct to_vector_helper {};
+		return !(left == right);
+	}
 
-		// Operator| overload to convert a range into a vector
-		template <std::ranges::range R>
-		auto operator|(R&& r, to_vector_helper)
-		{
-			std::vector<std::ranges::range_value_t<decltype(r)>> v;
-			if constexpr (std::ranges::sized_range<decltype(r)>) {
-				v.reserve(std::ranges::size(r));
+	void descriptor_set::update_data_pointers()
+	{
+		for (auto& w : mOrderedDescriptorDataWrites) {
+			assert(w.dstSet == mOrderedDescriptorDataWrites[0].dstSet);
+			{
+				auto it = std::find_if(std::begin(mStoredImageInfos), std::end(mStoredImageInfos), [binding = w.dstBinding](const auto& element) { return std::get<uint32_t>(element) == binding; });
+				if (it != std::end(mStoredImageInfos)) {
+					w.pImageInfo = std::get<std::vector<vk::DescriptorImageInfo>>(*it).data();
+				}
+				else {
+					w.pImageInfo = nullptr;
+				}
+			}
+			{
+				auto it = std::find_if(std::begin(mStoredBufferInfos), std::end(mStoredBufferInfos), [binding = w.dstBinding](const auto& element) { return std::get<uint32_t>(element) == binding; });
+				if (it != std::end(mStoredBufferInfos)) {
+					w.pBufferInfo = std::get<std::vector<vk::DescriptorBufferInfo>>(*it).data();
+				}
+				else {
+					w.pBufferInfo = nullptr;
+				}
+			}
+#if VK_HEADER_VERSION >= 135
+			{
+				auto it = std::find_if(std::begin(mStoredAccelerationStructureWrites), std::end(mStoredAccelerationStructureWrites), [binding = w.dstBinding](const auto& element) { return std::get<uint32_t>(element) == binding; });
+				if (it != std::end(mStoredAccelerationStructureWrites)) {
+					auto& tpl = std::get<1>(*it);
+					w.pNext = &std::get<vk::WriteDescriptorSetAccelerationStructureKHR>(tpl);
+					// Also update the pointer WITHIN the vk::WriteDescriptorSetAccelerationStructureKHR... OMG!
+					std::get<vk::WriteDescriptorSetAccelerationStructureKHR>(tpl).pAccelerationStructures = std::get<1>(tpl).data();
+				}
+				else {
+					w.pNext = nullptr;
+				}
+			}
+#endif
+			{
+				auto it = std::find_if(std::begin(mStoredBufferViews), std::end(mStoredBufferViews), [binding = w.dstBinding](const auto& element) { return std::get<uint32_t>(element) == binding; });
+				if (it != std::end(mStoredBufferViews)) {
+					w.pTexelBufferView = std::get<std::vector<vk::BufferView>>(*it).data();
+				}
+				else {
+					w.pTexelBufferView = nullptr;
+				}
 			}
-			std::ranges::copy(r, std::back_inserter(v));
-			return v;
 		}
 	}
 
-	auto to_vector()
+	void descriptor_set::link_to_handle_and_pool(vk::DescriptorSet aHandle, std::shared_ptr<descriptor_pool> aPool)
 	{
-		return to_vector_impl::to_vector_helper{};
+		mDescriptorSet = aHandle;
+		for (auto& w : mOrderedDescriptorDataWrites) {
+			w.setDstSet(handle());
+		}
+		mPool = std::move(aPool);
 	}
 
-	graphics_pipeline root::create_graphics_pipeline(graphics_pipeline_config aConfig, std::function<void(graphics_pipeline_t&)> aAlterConfigBeforeCreation)
+	void descriptor_set::write_descriptors()
 	{
-		using namespace cfg;
-
-		graphics_pipeline_t result;
+		assert(mDescriptorSet);
+		update_data_pointers();
+		mPool.get()->mDescriptorPool.getOwner().updateDescriptorSets(static_cast<uint32_t>(mOrderedDescriptorDataWrites.size()), mOrderedDescriptorDataWrites.data(), 0u, nullptr);
+	}
 
-		// 0. Own the renderpass - if one is required
-		const bool dynamicRenderingEnabled = aConfig.mDynamicRendering == avk::cfg::dynamic_rendering::enabled;
+	std::vector<descriptor_set> descriptor_cache_t::get_or_create_descriptor_sets(std::initializer_list<binding_data> aBindings)
+	{
+		std::vector<binding_data> orderedBindings;
+		uint32_t minSetId = std::numeric_limits<uint32_t>::max();
+		uint32_t maxSetId = std::numeric_limits<uint32_t>::min();
 
-		{
-			if(!dynamicRenderingEnabled)
-			{
-				assert(aConfig.mRenderPassSubpass.has_value());
-				auto [rp, sp] = std::move(aConfig.mRenderPassSubpass.value());
-				result.mRenderPass = std::move(rp);
-				result.mSubpassIndex = sp;
-			}
+		// Step 1: order the bindings
+		for (auto& b : aBindings) {
+			minSetId = std::min(minSetId, b.mSetId);
+			maxSetId = std::max(maxSetId, b.mSetId);
+			auto it = std::lower_bound(std::begin(orderedBindings), std::end(orderedBindings), b); // use operator<
+			orderedBindings.insert(it, b);
 		}
 
-		// 1. Compile the array of vertex input binding descriptions
-		{
-			// Select bindings as vector:
-#if defined(_MSC_VER) && _MSC_VER < 1930
-			auto bindings = aConfig.mInputBindingLocations
-				| std::views::transform([](const auto& bindingData) { return bindingData.mGeneralData; })
-				| to_vector();
-#else 
-			std::vector<avk::vertex_input_buffer_binding> bindings;
-			for (const auto& bindingData : aConfig.mInputBindingLocations){
-				bindings.push_back(bindingData.mGeneralData);
-			}
-#endif
-
-			// Sort bindings:
-			std::ranges::sort(bindings);
-			// Remove duplicates of both vertex and instance inputs (this will invoke operator ==(const vertex_input_buffer_binding& left, const vertex_input_buffer_binding& right):
-			auto [ret, last] = std::ranges::unique(bindings);
-			bindings.erase(ret, last);
-			result.mOrderedVertexInputBindingDescriptions.reserve(bindings.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
+		std::vector<std::reference_wrapper<const descriptor_set_layout>> layouts;
+		std::vector<descriptor_set> preparedSets;
+		std::vector<descriptor_set> cachedSets;
+		std::vector<bool>           validSets;
 
-			for (auto& bindingData : bindings) {
+		// Step 2: go through all the sets, get or alloc layouts, and see if the descriptor sets are already in cache, by chance.
+		for (uint32_t setId = minSetId; setId <= maxSetId; ++setId) {
+			auto lb = std::lower_bound(std::begin(orderedBindings), std::end(orderedBindings), binding_data{ setId },
+				[](const binding_data& first, const binding_data& second) -> bool {
+					return first.mSetId < second.mSetId;
+				});
+			auto ub = std::upper_bound(std::begin(orderedBindings), std::end(orderedBindings), binding_data{ setId },
+				[](const binding_data& first, const binding_data& second) -> bool {
+					return first.mSetId < second.mSetId;
+				});
 
-				const auto numRecordsWithSameBinding = std::count_if(std::begin(bindings), std::end(bindings),
-					[bindingId = bindingData.mBinding](const vertex_input_buffer_binding& generalData) {
-						return generalData.mBinding == bindingId;
-					});
-				if (1 != numRecordsWithSameBinding) {
-					throw avk::runtime_error("The input binding #" + std::to_string(bindingData.mBinding) + " is defined in multiple times in different ways. Make sure to define it uniformly across different bindings/attribute descriptions!");
-				}
+			// Handle empty sets:
+			if (lb == ub) {
+				continue;
+			}
 
-				result.mOrderedVertexInputBindingDescriptions.push_back(vk::VertexInputBindingDescription{}
-					// The following parameters are guaranteed to be the same. We have checked this.
-					.setBinding(bindingData.mBinding)
-					.setStride(static_cast<uint32_t>(bindingData.mStride))
-					.setInputRate(to_vk_vertex_input_rate(bindingData.mKind))
-					// We don't need the location here
-				);
+			const auto& layout = get_or_alloc_layout(descriptor_set_layout::prepare(lb, ub));
+			layouts.emplace_back(layout);
+			auto preparedSet = descriptor_set::prepare(lb, ub);
+			auto cachedSet = get_descriptor_set_from_cache(preparedSet);
+			if (cachedSet.has_value()) {
+				auto& back = cachedSets.emplace_back(std::move(cachedSet.value()));
+				validSets.push_back(true);
+			}
+			else {
+				cachedSets.emplace_back();
+				validSets.push_back(false);
 			}
+			preparedSets.emplace_back(std::move(preparedSet));
 		}
 
-		// 2. Compile the array of vertex input attribute descriptions
-		//  They will reference the bindings created in step 1.
-		result.mVertexInputAttributeDescriptions.reserve(aConfig.mInputBindingLocations.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
-		for (auto& attribData : aConfig.mInputBindingLocations) {
-			result.mVertexInputAttributeDescriptions.push_back(vk::VertexInputAttributeDescription{}
-				.setBinding(attribData.mGeneralData.mBinding)
-				.setLocation(attribData.mLocation)
-				.setFormat(attribData.mMemberMetaData.mFormat)
-				.setOffset(static_cast<uint32_t>(attribData.mMemberMetaData.mOffset))
-			);
+		if (static_cast<int>(cachedSets.size()) == std::count(std::begin(validSets), std::end(validSets), true)) {
+			// Everything is cached; we're done.
+			return cachedSets;
 		}
 
-		// 3. With the data from 1. and 2., create the complete vertex input info struct, passed to the pipeline creation
-		result.mPipelineVertexInputStateCreateInfo = vk::PipelineVertexInputStateCreateInfo()
-			.setVertexBindingDescriptionCount(static_cast<uint32_t>(result.mOrderedVertexInputBindingDescriptions.size()))
-			.setPVertexBindingDescriptions(result.mOrderedVertexInputBindingDescriptions.data())
-			.setVertexAttributeDescriptionCount(static_cast<uint32_t>(result.mVertexInputAttributeDescriptions.size()))
-			.setPVertexAttributeDescriptions(result.mVertexInputAttributeDescriptions.data());
-
-		// 4. Set how the data (from steps 1.-3.) is to be interpreted (e.g. triangles, points, lists, patches, etc.)
-		result.mInputAssemblyStateCreateInfo = vk::PipelineInputAssemblyStateCreateInfo()
-			.setTopology(to_vk_primitive_topology(aConfig.mPrimitiveTopology))
-			.setPrimitiveRestartEnable(VK_FALSE);
-
-		// 5. Compile and store the shaders:
-		result.mShaders.reserve(aConfig.mShaderInfos.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
-		result.mShaderStageCreateInfos.reserve(aConfig.mShaderInfos.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
-		result.mSpecializationInfos.reserve(aConfig.mShaderInfos.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
-		for (auto& shaderInfo : aConfig.mShaderInfos) {
-			// 5.0 Sanity check
-			if (result.mShaders.end() != std::find_if(std::begin(result.mShaders), std::end(result.mShaders), [&shaderInfo](const shader& existing) { return existing.info().mShaderType == shaderInfo.mShaderType; })) {
-				throw avk::runtime_error("There's already a " + vk::to_string(to_vk_shader_stages(shaderInfo.mShaderType)) + "-type shader contained in this graphics pipeline. Can not add another one of the same type.");
-			}
-			// 5.1 Compile the shader
-			result.mShaders.push_back(create_shader(shaderInfo));
-			assert(result.mShaders.back().has_been_built());
-			// 5.2 Combine
-			auto& stageCreateInfo = result.mShaderStageCreateInfos.emplace_back()
-				.setStage(to_vk_shader_stage(result.mShaders.back().info().mShaderType))
-				.setModule(result.mShaders.back().handle())
-				.setPName(result.mShaders.back().info().mEntryPoint.c_str());
-			if (shaderInfo.mSpecializationConstants.has_value()) {
-				auto& specInfo = result.mSpecializationInfos.emplace_back(
-					shaderInfo.mSpecializationConstants.value().num_entries(),
-					shaderInfo.mSpecializationConstants.value().mMapEntries.data(),
-					shaderInfo.mSpecializationConstants.value().data_size(),
-					shaderInfo.mSpecializationConstants.value().mData.data()
-				);
-				// Add it to the stageCreateInfo:
-				stageCreateInfo.setPSpecializationInfo(&specInfo);
-			}
-			else {
-				result.mSpecializationInfos.emplace_back(); // Just to keep the indices into the vectors in sync!
+		// HOWEVER, if not...
+		std::vector<std::reference_wrapper<const descriptor_set_layout>> layoutsForAlloc;
+		std::vector<descriptor_set> toBeAlloced;
+		std::vector<size_t> indexMapping;
+		for (size_t i = 0; i < cachedSets.size(); ++i) {
+			if (!validSets[i]) {
+				layoutsForAlloc.push_back(layouts[i]);
+				toBeAlloced.push_back(std::move(preparedSets[i]));
+				indexMapping.push_back(i);
 			}
 		}
-
-		// 6. Viewport configuration
-		{
-			// 6.1 Viewport and depth configuration(s):
-			result.mViewports.reserve(aConfig.mViewportDepthConfig.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
-			result.mScissors.reserve(aConfig.mViewportDepthConfig.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
-			for (auto& vp : aConfig.mViewportDepthConfig) {
-				result.mViewports.push_back(vk::Viewport{}
-					.setX(vp.x())
-					.setY(vp.y())
-					.setWidth(vp.width())
-					.setHeight(vp.height())
-					.setMinDepth(vp.min_depth())
-					.setMaxDepth(vp.max_depth())
-				);
-				// 6.2 Skip scissors for now
-				// TODO: Implement scissors support properly
-				result.mScissors.push_back(vk::Rect2D{}
-					.setOffset({static_cast<int32_t>(vp.x()), static_cast<int32_t>(vp.y())})
-					.setExtent({static_cast<uint32_t>(vp.width()), static_cast<uint32_t>(vp.height())})
-				);
-			}
-			// 6.3 Add everything together
-			result.mViewportStateCreateInfo = vk::PipelineViewportStateCreateInfo{}
-				.setViewportCount(static_cast<uint32_t>(result.mViewports.size()))
-				.setPViewports(result.mViewports.data())
-				.setScissorCount(static_cast<uint32_t>(result.mScissors.size()))
-				.setPScissors(result.mScissors.data());
+		auto nowAlsoInCache = alloc_new_descriptor_sets(layoutsForAlloc, std::move(toBeAlloced));
+		for (size_t i = 0; i < indexMapping.size(); ++i) {
+			cachedSets[indexMapping[i]] = nowAlsoInCache[i];
 		}
+		return cachedSets;
+	}
 
-		// 7. Rasterization state
-		result.mRasterizationStateCreateInfo =  vk::PipelineRasterizationStateCreateInfo{}
-			// Various, but important settings:
-			.setRasterizerDiscardEnable(to_vk_bool(aConfig.mRasterizerGeometryMode == rasterizer_geometry_mode::discard_geometry))
-			.setPolygonMode(to_vk_polygon_mode(aConfig.mPolygonDrawingModeAndConfig.drawing_mode()))
-			.setLineWidth(aConfig.mPolygonDrawingModeAndConfig.line_width())
-			.setCullMode(to_vk_cull_mode(aConfig.mCullingMode))
-			.setFrontFace(to_vk_front_face(aConfig.mFrontFaceWindingOrder.winding_order_of_front_faces()))
-			// Depth-related settings:
-			.setDepthClampEnable(to_vk_bool(aConfig.mDepthClampBiasConfig.is_clamp_to_frustum_enabled()))
-			.setDepthBiasEnable(to_vk_bool(aConfig.mDepthClampBiasConfig.is_depth_bias_enabled()))
-			.setDepthBiasConstantFactor(aConfig.mDepthClampBiasConfig.bias_constant_factor())
-			.setDepthBiasClamp(aConfig.mDepthClampBiasConfig.bias_clamp_value())
-			.setDepthBiasSlopeFactor(aConfig.mDepthClampBiasConfig.bias_slope_factor());
-
-		// 8. Depth-stencil config
-		result.mDepthStencilConfig = vk::PipelineDepthStencilStateCreateInfo{}
-			.setDepthTestEnable(to_vk_bool(aConfig.mDepthTestConfig.is_enabled()))
-			.setDepthCompareOp(to_vk_compare_op(aConfig.mDepthTestConfig.depth_compare_operation()))
-			.setDepthWriteEnable(to_vk_bool(aConfig.mDepthWriteConfig.is_enabled()))
-			.setDepthBoundsTestEnable(to_vk_bool(aConfig.mDepthBoundsConfig.is_enabled()))
-			.setMinDepthBounds(aConfig.mDepthBoundsConfig.min_bounds())
-			.setMaxDepthBounds(aConfig.mDepthBoundsConfig.max_bounds())
-			.setStencilTestEnable(VK_FALSE);
+	int descriptor_cache_t::remove_sets_with_handle(vk::ImageView aHandle)
+	{
+		int numDeleted = 0;
+		auto it = std::begin(mSets);
+		do {
+			it = std::find_if(std::begin(mSets), std::end(mSets), [aHandle](const descriptor_set& aSet) {
+				auto n = aSet.number_of_writes();
+				for (decltype(n) i = 0; i < n; ++i) {
+					const auto& w = aSet.write_at(i);
+					auto dn = w.descriptorCount;
+					if (0u == dn || nullptr == w.pImageInfo) {
+						continue;
+					}
+					for (decltype(dn) di = 0; di < dn; ++di) {
+						if (w.pImageInfo[di].imageView == aHandle) {
+							return true;
+						}
+					}
+				}
+				return false;
+			});
 
-		// TODO: Add better support for stencil testing (better abstraction!)
-		if (aConfig.mStencilTest.has_value() && aConfig.mStencilTest.value().mEnabled) {
-			result.mDepthStencilConfig
-				.setStencilTestEnable(VK_TRUE)
-				.setFront(aConfig.mStencilTest.value().mFrontStencilTestActions)
-				.setBack(aConfig.mStencilTest.value().mBackStencilTestActions);
-		}
+			if (std::end(mSets) != it) {
+				mSets.erase(it);
+				++numDeleted;
+				// Iterator could (will) have been invalidated => reinitialize:
+				it = std::begin(mSets);
+			}
+		} while (std::end(mSets) != it);
+		return numDeleted;
+	}
 
-		// 9. Color Blending
-		{
-			// Do we have an "universal" color blending config? That means, one that is not assigned to a specific color target attachment id.
-#if defined(_MSC_VER) && _MSC_VER < 1930
-			auto universalConfig = aConfig.mColorBlendingPerAttachment
-				| std::views::filter([](const color_blending_config& config) { return !config.mTargetAttachment.has_value(); })
-				| to_vector();
-#else 
-			std::vector<cfg::color_blending_config> universalConfig;
-			for (const color_blending_config& config : aConfig.mColorBlendingPerAttachment) {
-				if (!config.mTargetAttachment.has_value()) {
-					universalConfig.push_back(config);
+	int descriptor_cache_t::remove_sets_with_handle(vk::Buffer aHandle)
+	{
+		int numDeleted = 0;
+		auto it = std::begin(mSets);
+		do {
+			it = std::find_if(std::begin(mSets), std::end(mSets), [aHandle](const descriptor_set& aSet) {
+				auto n = aSet.number_of_writes();
+				for (decltype(n) i = 0; i < n; ++i) {
+					const auto& w = aSet.write_at(i);
+					auto dn = w.descriptorCount;
+					if (0u == dn || nullptr == w.pBufferInfo) {
+						continue;
+					}
+					for (decltype(dn) di = 0; di < dn; ++di) {
+						if (w.pBufferInfo[di].buffer == aHandle) {
+							return true;
+						}
+					}
 				}
-			}
-#endif
+				return false;
+				});
 
-			if (universalConfig.size() > 1) {
-				throw avk::runtime_error("Ambiguous 'universal' color blending configurations. Either provide only one 'universal' "
-					"config (which is not attached to a specific color target) or assign them to specific color target attachment ids.");
+			if (std::end(mSets) != it) {
+				mSets.erase(it);
+				++numDeleted;
+				// Iterator could (will) have been invalidated => reinitialize:
+				it = std::begin(mSets);
 			}
+		} while (std::end(mSets) != it);
+		return numDeleted;
+	}
 
-			// Iterate over all color target attachments and set a color blending config 
-			size_t blendingConfigNum;
-			if (!dynamicRenderingEnabled)
-			{
-				const auto & renderPassVal = result.mRenderPass.value();
-				if (result.subpass_id() >= renderPassVal->attachment_descriptions().size()) {
-					throw avk::runtime_error(
-						"There are fewer subpasses in the renderpass ("
-						+ std::to_string(renderPassVal->attachment_descriptions().size()) +
-						") than the subpass index ("
-						+ std::to_string(result.subpass_id().value()) +
-						") indicates. I.e. the subpass index is out of bounds.");
+	int descriptor_cache_t::remove_sets_with_handle(vk::Sampler aHandle)
+	{
+		int numDeleted = 0;
+		auto it = std::begin(mSets);
+		do {
+			it = std::find_if(std::begin(mSets), std::end(mSets), [aHandle](const descriptor_set& aSet) {
+				auto n = aSet.number_of_writes();
+				for (decltype(n) i = 0; i < n; ++i) {
+					const auto& w = aSet.write_at(i);
+					auto dn = w.descriptorCount;
+					if (0u == dn || nullptr == w.pImageInfo) {
+						continue;
+					}
+					for (decltype(dn) di = 0; di < dn; ++di) {
+						if (w.pImageInfo[di].sampler == aHandle) {
+							return true;
+						}
+					}
 				}
-				blendingConfigNum = renderPassVal->color_attachments_for_subpass(result.subpass_id().value()).size(); /////////////////// TODO: (doublecheck or) FIX this section (after renderpass refactoring)
-			} 
-			// Renderpasses and Subpasses are not supported when dynamic rendering is enabled
-			// Instead we read size of the dynamic_rendering_attachments provided
-			else 
-			{
-				blendingConfigNum = 0;
+				return false;
+				});
 
-				for(const auto & dynRenderingAttachment : aConfig.mDynamicRenderingAttachments.value())
-				{
-					if(dynRenderingAttachment.mSubpassUsages.contains_color())
-					{
-						blendingConfigNum++;
+			if (std::end(mSets) != it) {
+				mSets.erase(it);
+				++numDeleted;
+				// Iterator could (will) have been invalidated => reinitialize:
+				it = std::begin(mSets);
+			}
+		} while (std::end(mSets) != it);
+		return numDeleted;
+	}
+
+	int descriptor_cache_t::remove_sets_with_handle(vk::BufferView aHandle)
+	{
+		int numDeleted = 0;
+		auto it = std::begin(mSets);
+		do {
+			it = std::find_if(std::begin(mSets), std::end(mSets), [aHandle](const descriptor_set& aSet) {
+				auto n = aSet.number_of_writes();
+				for (decltype(n) i = 0; i < n; ++i) {
+					const auto& w = aSet.write_at(i);
+					auto dn = w.descriptorCount;
+					if (0u == dn || nullptr == w.pTexelBufferView) {
+						continue;
+					}
+					for (decltype(dn) di = 0; di < dn; ++di) {
+						if (w.pTexelBufferView[di] == aHandle) {
+							return true;
+						}
 					}
 				}
+				return false;
+				});
+
+			if (std::end(mSets) != it) {
+				mSets.erase(it);
+				++numDeleted;
+				// Iterator could (will) have been invalidated => reinitialize:
+				it = std::begin(mSets);
 			}
-			result.mBlendingConfigsForColorAttachments.reserve(blendingConfigNum); // Important! Otherwise the vector might realloc and .data() will become invalid!
-			for (size_t i = 0; i < blendingConfigNum; ++i) {
-				// Do we have a specific blending config for color attachment i?
-#if defined(_MSC_VER) && _MSC_VER < 1930
-				auto configForI = aConfig.mColorBlendingPerAttachment
-					| std::views::filter([i](const color_blending_config& config) { return config.mTargetAttachment.has_value() && config.mTargetAttachment.value() == i; })
-					| to_vector();
-#else 
-				std::vector<cfg::color_blending_config> configForI;
-				for (const color_blending_config& config : aConfig.mColorBlendingPerAttachment) {
-					if (config.mTargetAttachment.has_value() && config.mTargetAttachment.value() == i) {
-						configForI.push_back(config);
-					}
-				}
-#endif
-				if (configForI.size() > 1) {
-					throw avk::runtime_error("Ambiguous color blending configuration for color attachment at index #" + std::to_string(i) + ". Provide only one config per color attachment!");
-				}
-				// Determine which color blending to use for this attachment:
-				color_blending_config toUse = configForI.size() == 1
-												? configForI[0]
-												: universalConfig.size() == 1
-													? universalConfig[0]
-													: color_blending_config::disable();
-				result.mBlendingConfigsForColorAttachments.push_back(vk::PipelineColorBlendAttachmentState()
-					.setColorWriteMask(to_vk_color_components(toUse.affected_color_channels()))
-					.setBlendEnable(to_vk_bool(toUse.is_blending_enabled())) // If blendEnable is set to VK_FALSE, then the new color from the fragment shader is passed through unmodified. [4]
-					.setSrcColorBlendFactor(to_vk_blend_factor(toUse.color_source_factor()))
-					.setDstColorBlendFactor(to_vk_blend_factor(toUse.color_destination_factor()))
-					.setColorBlendOp(to_vk_blend_operation(toUse.color_operation()))
-					.setSrcAlphaBlendFactor(to_vk_blend_factor(toUse.alpha_source_factor()))
-					.setDstAlphaBlendFactor(to_vk_blend_factor(toUse.alpha_destination_factor()))
-					.setAlphaBlendOp(to_vk_blend_operation(toUse.alpha_operation()))
-				);
-			}
+		} while (std::end(mSets) != it);
+		return numDeleted;
+	}
 
-			// General blending settings and reference to the array of color attachment blending configs
-			result.mColorBlendStateCreateInfo = vk::PipelineColorBlendStateCreateInfo()
-				.setLogicOpEnable(to_vk_bool(aConfig.mColorBlendingSettings.is_logic_operation_enabled())) // If you want to use the second method of blending (bitwise combination), then you should set logicOpEnable to VK_TRUE. The bitwise operation can then be specified in the logicOp field. [4]
-				.setLogicOp(to_vk_logic_operation(aConfig.mColorBlendingSettings.logic_operation()))
-				.setAttachmentCount(static_cast<uint32_t>(result.mBlendingConfigsForColorAttachments.size()))
-				.setPAttachments(result.mBlendingConfigsForColorAttachments.data())
-				.setBlendConstants(aConfig.mColorBlendingSettings.blend_constants());
-		}
+#pragma endregion
 
-		// 10. Multisample state
-		// TODO: Can the settings be inferred from the renderpass' color attachments (as they are right now)? If they can't, how to handle this situation?
-		{ /////////////////// TODO: FIX this section (after renderpass refactoring)
-			vk::SampleCountFlagBits numSamples = vk::SampleCountFlagBits::e1;
-			if(!dynamicRenderingEnabled)
-			{
-				numSamples = result.mRenderPass.value()->num_samples_for_subpass(result.subpass_id().value());
-			} else {
-				for(const auto & attachment : aConfig.mDynamicRenderingAttachments.value())
-				{
-					if(attachment.is_multisampled())
-					{
-						if(numSamples != vk::SampleCountFlagBits::e1 && numSamples != attachment.sample_count())
-						{
-							//NOTE(msakmary) This may be possible with some extension I'm not 100% sure...
-							throw avk::runtime_error("Cannot have different sample counts for attachments in the same renderpass");
-						}
-						numSamples = attachment.sample_count();
-					}
-				}
-			}
-			
-			// Evaluate and set the PER SAMPLE shading configuration:
-			auto perSample = aConfig.mPerSampleShading.value_or(per_sample_shading_config{ false, 1.0f });
+#pragma region device capabilities definitions
+	const vk::PhysicalDeviceProperties& device_capabilities::properties() const
+	{
+		std::call_once(mPropertiesQueried, [this]() {
+			mProperties = mRoot->physical_device().getProperties();
+		});
+		return mProperties;
+	}
 
-			result.mMultisampleStateCreateInfo = vk::PipelineMultisampleStateCreateInfo()
-				.setRasterizationSamples(numSamples)
-				.setSampleShadingEnable(perSample.mPerSampleShadingEnabled ? VK_TRUE : VK_FALSE) // enable/disable Sample Shading
-				.setMinSampleShading(perSample.mMinFractionOfSamplesShaded) // specifies a minimum fraction of sample shading if sampleShadingEnable is set to VK_TRUE.
-				.setPSampleMask(nullptr) // If pSampleMask is NULL, it is treated as if the mask has all bits enabled, i.e. no coverage is removed from fragments. See https://www.khronos.org/registry/vulkan/specs/1.2-extensions/html/vkspec.html#fragops-samplemask
-				.setAlphaToCoverageEnable(VK_FALSE) // controls whether a temporary coverage value is generated based on the alpha component of the fragment's first color output as specified in the Multisample Coverage section.
-				.setAlphaToOneEnable(VK_FALSE); // controls whether the alpha component of the fragment's first color output is replaced with one as described in Multisample Coverage.
-			// TODO: That is probably not enough for every case. Further customization options should be added!
+	const vk::PhysicalDeviceMemoryProperties& device_capabilities::memory_properties() const
+	{
+		std::call_once(mMemoryPropertiesQueried, [this]() {
+			mMemoryProperties = mRoot->physical_device().getMemoryProperties();
+		});
+		return mMemoryProperties;
+	}
+
+	vk::FormatProperties device_capabilities::format_properties(vk::Format aFormat) const
+	{
+		std::scoped_lock<std::mutex> guard(mFormatPropertiesMutex);
+		auto it = mFormatProperties.find(aFormat);
+		if (std::end(mFormatProperties) == it) {
+			it = mFormatProperties.emplace(aFormat, mRoot->physical_device().getFormatProperties(aFormat)).first;
 		}
+		return it->second;
+	}
 
-		// 11. Dynamic state
-		{
-			// Don't need to pre-alloc the storage for this one
+	const vk::PhysicalDeviceExternalMemoryHostPropertiesEXT& device_capabilities::external_memory_host_properties() const
+	{
+		std::call_once(mExternalMemoryHostPropertiesQueried, [this]() {
+			vk::PhysicalDeviceProperties2 props2;
+			props2.pNext = &mExternalMemoryHostProperties;
+			mRoot->physical_device().getProperties2(&props2, mRoot->dispatch_loader_core());
+			mExternalMemoryHostProperties.pNext = nullptr;
+		});
+		return mExternalMemoryHostProperties;
+	}
 
-			// Check for viewport dynamic state
-			for (const auto& vpdc : aConfig.mViewportDepthConfig) {
-				if (vpdc.is_dynamic_viewport_enabled())	{
-					result.mDynamicStateEntries.push_back(vk::DynamicState::eViewport);
-				}
-			}
-			// Check for scissor dynamic state
-			for (const auto& vpdc : aConfig.mViewportDepthConfig) {
-				if (vpdc.is_dynamic_scissor_enabled())	{
-					result.mDynamicStateEntries.push_back(vk::DynamicState::eScissor);
-				}
+#if VK_HEADER_VERSION >= 135
+#if VK_HEADER_VERSION >= 162
+	const vk::PhysicalDeviceRayTracingPipelinePropertiesKHR& device_capabilities::ray_tracing_properties() const
+#else
+	const vk::PhysicalDeviceRayTracingPropertiesKHR& device_capabilities::ray_tracing_properties() const
+#endif
+	{
+		std::call_once(mRayTracingPropertiesQueried, [this]() {
+			vk::PhysicalDeviceProperties2 props2;
+			props2.pNext = &mRayTracingProperties;
+			mRoot->physical_device().getProperties2(&props2, mRoot->dispatch_loader_core());
+			mRayTracingProperties.pNext = nullptr;
+		});
+		return mRayTracingProperties;
+	}
+
+#if VK_HEADER_VERSION >= 162
+	const vk::PhysicalDeviceAccelerationStructurePropertiesKHR& device_capabilities::acceleration_structure_properties() const
+	{
+		std::call_once(mAccelerationStructurePropertiesQueried, [this]() {
+			vk::PhysicalDeviceProperties2 props2;
+			props2.pNext = &mAccelerationStructureProperties;
+			mRoot->physical_device().getProperties2(&props2, mRoot->dispatch_loader_core());
+			mAccelerationStructureProperties.pNext = nullptr;
+		});
+		return mAccelerationStructureProperties;
+	}
+#endif
+#endif
+#pragma endregion
+
+#pragma region external memory and semaphores definitions
+	std::tuple<vk::UniqueHandle<vk::DeviceMemory, DISPATCH_LOADER_CORE_TYPE>, uint32_t, vk::MemoryPropertyFlags> root::allocate_external_memory(vk::MemoryRequirements aRequirements, std::variant<vk::Buffer, vk::Image> aDedicatedResource, std::variant<external_memory_export, external_memory_import> aExternalMemory, bool aDeviceAddress) const
+	{
+		auto memoryTypeBits = aRequirements.memoryTypeBits;
+		const auto* toImport = std::get_if<external_memory_import>(&aExternalMemory);
+		if (nullptr != toImport) {
+			if (toImport->mFd < 0) {
+				throw avk::logic_error("Can not import external memory from an invalid file descriptor.");
 			}
-			// Check for dynamic line width
-			if (aConfig.mPolygonDrawingModeAndConfig.dynamic_line_width()) {
-				result.mDynamicStateEntries.push_back(vk::DynamicState::eLineWidth);
+			// Opaque file descriptors must be imported with the same memory type as they have been exported with, which is
+			// guaranteed by identical create parameters. For all other handle types, the file descriptor restricts the memory types:
+			if (vk::ExternalMemoryHandleTypeFlagBits::eOpaqueFd != toImport->mHandleType) {
+				const auto fdProperties = device().getMemoryFdPropertiesKHR(toImport->mHandleType, toImport->mFd, dispatch_loader_ext());
+				memoryTypeBits &= fdProperties.memoryTypeBits;
 			}
-			// Check for dynamic depth bias
-			if (aConfig.mDepthClampBiasConfig.is_dynamic_depth_bias_enabled()) {
-				result.mDynamicStateEntries.push_back(vk::DynamicState::eDepthBias);
+		}
+		if (0u == memoryTypeBits) {
+			throw avk::runtime_error("There is no memory type which supports the requested external memory.");
+		}
+
+		// Prefer device-local memory, but accept whatever the external memory supports otherwise (e.g., for dma-bufs from other devices):
+		const auto& memProperties = capabilities().memory_properties();
+		std::optional<uint32_t> memoryTypeIndex;
+		for (auto i = 0u; i < memProperties.memoryTypeCount; ++i) {
+			if (0u == (memoryTypeBits & (1u << i))) {
+				continue;
 			}
-			// Check for dynamic depth bounds
-			if (aConfig.mDepthBoundsConfig.is_dynamic_depth_bounds_enabled()) {
-				result.mDynamicStateEntries.push_back(vk::DynamicState::eDepthBounds);
+			if (!memoryTypeIndex.has_value() || avk::has_flag(memProperties.memoryTypes[i].propertyFlags, vk::MemoryPropertyFlagBits::eDeviceLocal)) {
+				memoryTypeIndex = i;
 			}
-			// Check for dynamic stencil values // TODO: make them configurable separately
-			if (aConfig.mStencilTest.has_value() && aConfig.mStencilTest.value().is_dynamic_enabled()) {
-				result.mDynamicStateEntries.push_back(vk::DynamicState::eStencilCompareMask);
-				result.mDynamicStateEntries.push_back(vk::DynamicState::eStencilReference);
-				result.mDynamicStateEntries.push_back(vk::DynamicState::eStencilWriteMask);
+			if (avk::has_flag(memProperties.memoryTypes[i].propertyFlags, vk::MemoryPropertyFlagBits::eDeviceLocal)) {
+				break;
 			}
-			// TODO: Support further dynamic states
-
-			result.mDynamicStateCreateInfo = vk::PipelineDynamicStateCreateInfo{}
-				.setDynamicStateCount(static_cast<uint32_t>(result.mDynamicStateEntries.size()))
-				.setPDynamicStates(result.mDynamicStateEntries.data());
 		}
 
-		// 12. Flags
-		// TODO: Support all flags (only one of the flags is handled at the moment)
-		result.mPipelineCreateFlags = {};
-		if ((aConfig.mPipelineSettings & pipeline_settings::disable_optimization) == pipeline_settings::disable_optimization) {
-			result.mPipelineCreateFlags |= vk::PipelineCreateFlagBits::eDisableOptimization;
+		// External memory is always a dedicated allocation, which is required by many implementations and handle types anyways:
+		auto dedicatedInfo = vk::MemoryDedicatedAllocateInfo{};
+		if (std::holds_alternative<vk::Buffer>(aDedicatedResource)) {
+			dedicatedInfo.setBuffer(std::get<vk::Buffer>(aDedicatedResource));
+		}
+		else {
+			dedicatedInfo.setImage(std::get<vk::Image>(aDedicatedResource));
+		}
+#if VK_HEADER_VERSION >= 135
+		auto memoryAllocateFlagsInfo = vk::MemoryAllocateFlagsInfo{};
+		if (aDeviceAddress) {
+			memoryAllocateFlagsInfo.flags |= vk::MemoryAllocateFlagBits::eDeviceAddress;
+			dedicatedInfo.setPNext(&memoryAllocateFlagsInfo);
 		}
+#endif
 
-		// 13. Patch Control Points for Tessellation
-		if (aConfig.mTessellationPatchControlPoints.has_value()) {
-			result.mPipelineTessellationStateCreateInfo = vk::PipelineTessellationStateCreateInfo{}
-				.setPatchControlPoints(aConfig.mTessellationPatchControlPoints.value().mPatchControlPoints);
+		auto exportInfo = vk::ExportMemoryAllocateInfo{};
+		auto importInfo = vk::ImportMemoryFdInfoKHR{};
+		auto allocInfo = vk::MemoryAllocateInfo{}
+			.setAllocationSize(aRequirements.size)
+			.setMemoryTypeIndex(memoryTypeIndex.value());
+		if (nullptr != toImport) {
+			importInfo
+				.setHandleType(toImport->mHandleType)
+				.setFd(toImport->mFd)
+				.setPNext(&dedicatedInfo);
+			allocInfo.setPNext(&importInfo);
+		}
+		else {
+			exportInfo
+				.setHandleTypes(std::get<external_memory_export>(aExternalMemory).mHandleTypes)
+				.setPNext(&dedicatedInfo);
+			allocInfo.setPNext(&exportInfo);
 		}
 
-		// 14. Compile the PIPELINE LAYOUT data and create-info
-		// Get the descriptor set layouts
-		result.mAllDescriptorSetLayouts = set_of_descriptor_set_layouts::prepare(std::move(aConfig.mResourceBindings));
-		allocate_set_of_descriptor_set_layouts(result.mAllDescriptorSetLayouts);
+		auto memory = device().allocateMemoryUnique(allocInfo, nullptr, dispatch_loader_core());
+		return std::make_tuple(std::move(memory), memoryTypeIndex.value(), memProperties.memoryTypes[memoryTypeIndex.value()].propertyFlags);
+	}
 
-		// Gather the push constant data
-		result.mPushConstantRanges.reserve(aConfig.mPushConstantsBindings.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
-		for (const auto& pcBinding : aConfig.mPushConstantsBindings) {
-			result.mPushConstantRanges.push_back(vk::PushConstantRange{}
-				.setStageFlags(to_vk_shader_stages(pcBinding.mShaderStages))
-				.setOffset(static_cast<uint32_t>(pcBinding.mOffset))
-				.setSize(static_cast<uint32_t>(pcBinding.mSize))
-			);
-			// TODO: Push Constants need a prettier interface
+	buffer root::create_buffer(
+		const root& aRoot,
+		std::variant<external_memory_export, external_memory_import> aExternalMemory,
+#if VK_HEADER_VERSION >= 135
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#else
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> aMetaData,
+#endif
+		vk::BufferUsageFlags aBufferUsage
+	)
+	{
+		assert (aMetaData.size() > 0);
+		buffer_t result;
+		result.mMetaData = std::move(aMetaData);
+		result.mCreateInfo = vk::BufferCreateInfo{}
+			.setSize(static_cast<vk::DeviceSize>(result.meta_at_index<buffer_meta>(0).total_size()))
+			.setUsage(aBufferUsage)
+			.setSharingMode(vk::SharingMode::eExclusive);
+		result.mBufferUsageFlags = aBufferUsage;
+		result.mRoot = &aRoot;
+
+		// Buffers which are bound to external memory must be created with the handle type(s). (Not stored in mCreateInfo, because it's a pointer to a local.)
+		auto externalMemoryBufferCreateInfo = vk::ExternalMemoryBufferCreateInfo{}
+			.setHandleTypes(std::holds_alternative<external_memory_import>(aExternalMemory)
+				? vk::ExternalMemoryHandleTypeFlags{ std::get<external_memory_import>(aExternalMemory).mHandleType }
+				: std::get<external_memory_export>(aExternalMemory).mHandleTypes);
+		auto bufferCreateInfo = result.mCreateInfo;
+		bufferCreateInfo.setPNext(&externalMemoryBufferCreateInfo);
+		auto vkBuffer = aRoot.device().createBuffer(bufferCreateInfo, nullptr, aRoot.dispatch_loader_core());
+		// The buffer_t takes care of destroying the buffer handle, the memory is owned by mExternalMemory:
+#if defined(AVK_USES_VMA)
+		result.mBuffer.mAllocator = aRoot.memory_allocator();
+		result.mBuffer.mResource = vkBuffer;
+#else
+		result.mBuffer = AVK_MEM_BUFFER_HANDLE{ aRoot.memory_allocator(), vkBuffer };
+#endif
+
+		const auto requirements = aRoot.device().getBufferMemoryRequirements(vkBuffer, aRoot.dispatch_loader_core());
+		auto [memory, memoryTypeIndex, memoryPropFlags] = aRoot.allocate_external_memory(requirements, vkBuffer, std::move(aExternalMemory), avk::has_flag(aBufferUsage, vk::BufferUsageFlagBits::eShaderDeviceAddress));
+		result.mExternalMemory = std::move(memory);
+		aRoot.device().bindBufferMemory(vkBuffer, result.mExternalMemory.get(), 0, aRoot.dispatch_loader_core());
+#if defined(AVK_USES_VMA)
+		result.mBuffer.mAllocationInfo.memoryType = memoryTypeIndex;
+#else
+		result.mBuffer.mMemoryPropertyFlags = memoryPropFlags;
+#endif
+
+#if VK_HEADER_VERSION >= 135
+		if (avk::has_flag(result.usage_flags(), vk::BufferUsageFlagBits::eShaderDeviceAddress)) {
+			result.mDeviceAddress = get_buffer_address(aRoot.device(), result.handle());
 		}
+#endif
 
-		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
-		// These uniform values (Anm.: passed to shaders) need to be specified during pipeline creation by creating a VkPipelineLayout object. [4]
-		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
-			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
-			.setPSetLayouts(descriptorSetLayoutHandles.data())
-			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
-			.setPPushConstantRanges(result.mPushConstantRanges.data());
+		return result;
+	}
 
-		// 15. Set Rendering info if dynamic rendering is enabled
-		if(dynamicRenderingEnabled)
-		{
-			std::vector<vk::Format> depth_attachments;
-			std::vector<vk::Format> stencil_attachments;
-			for(const auto & dynamicRenderingAttachment : aConfig.mDynamicRenderingAttachments.value())
-			{
-				if(is_depth_format(dynamicRenderingAttachment.format())) {
-					depth_attachments.push_back(dynamicRenderingAttachment.format());
-				} else if (is_stencil_format(dynamicRenderingAttachment.format())) {
-					stencil_attachments.push_back(dynamicRenderingAttachment.format());
-				} else if (!dynamicRenderingAttachment.mSubpassUsages.get_subpass_usage(0).as_color()) {
-					result.mDynamicRenderingColorFormats.push_back(dynamicRenderingAttachment.format());
-				}
-			}
-			if(depth_attachments.size() > 1)   { throw avk::runtime_error("Provided multiple depth attachments! Only one is supported!"); }
-			if(stencil_attachments.size() > 1) { throw avk::runtime_error("Provided multiple stencil attachments! Only one is supported!"); }
+	image root::create_image(std::variant<external_memory_export, external_memory_import> aExternalMemory, uint32_t aWidth, uint32_t aHeight, vk::Format aFormat, int aNumLayers, avk::image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+	{
+		auto [result, memoryPropFlags] = configure_image(aWidth, aHeight, std::make_tuple(aFormat, vk::SampleCountFlagBits::e1), aNumLayers, memory_usage::device, aImageUsage, std::move(aAlterConfigBeforeCreation));
+
+		// Images which are bound to external memory must be created with the handle type(s). (Not stored in mCreateInfo, because it's a pointer to a local.)
+		auto externalMemoryImageCreateInfo = vk::ExternalMemoryImageCreateInfo{}
+			.setHandleTypes(std::holds_alternative<external_memory_import>(aExternalMemory)
+				? vk::ExternalMemoryHandleTypeFlags{ std::get<external_memory_import>(aExternalMemory).mHandleType }
+				: std::get<external_memory_export>(aExternalMemory).mHandleTypes)
+			.setPNext(result.mCreateInfo.pNext);
+		auto imageCreateInfo = result.mCreateInfo;
+		imageCreateInfo.setPNext(&externalMemoryImageCreateInfo);
+		auto vkImage = device().createImage(imageCreateInfo, nullptr, dispatch_loader_core());
+		// The image_t takes care of destroying the image handle, the memory is owned by mExternalMemory:
+#if defined(AVK_USES_VMA)
+		AVK_MEM_IMAGE_HANDLE imageHandle;
+		imageHandle.mAllocator = memory_allocator();
+		imageHandle.mResource = vkImage;
+#else
+		auto imageHandle = AVK_MEM_IMAGE_HANDLE{ memory_allocator(), vkImage };
+#endif
 
-			result.mRenderingCreateInfo = vk::PipelineRenderingCreateInfoKHR{}
-				.setColorAttachmentCount(static_cast<uint32_t>(result.mDynamicRenderingColorFormats.size()))
-				.setPColorAttachmentFormats(result.mDynamicRenderingColorFormats.data())
-				.setDepthAttachmentFormat(depth_attachments.size() == 1 ? depth_attachments.at(0) : vk::Format{})
-				.setStencilAttachmentFormat(stencil_attachments.size() == 1 ? stencil_attachments.at(0) : vk::Format{});
+		const auto requirements = device().getImageMemoryRequirements(vkImage, dispatch_loader_core());
+		auto [memory, memoryTypeIndex, actualMemoryPropFlags] = allocate_external_memory(requirements, vkImage, std::move(aExternalMemory), false);
+		result.mExternalMemory = std::move(memory);
+		device().bindImageMemory(vkImage, result.mExternalMemory.get(), 0, dispatch_loader_core());
+#if defined(AVK_USES_VMA)
+		imageHandle.mAllocationInfo.memoryType = memoryTypeIndex;
+#else
+		imageHandle.mMemoryPropertyFlags = actualMemoryPropFlags;
+#endif
+		result.mImage = std::move(imageHandle);
+		return std::move(result);
+	}
+
+	int root::export_memory_fd(const buffer_t& aBuffer, vk::ExternalMemoryHandleTypeFlagBits aHandleType) const
+	{
+		if (!aBuffer.has_external_memory()) {
+			throw avk::logic_error("Only the memory of buffers which have been created with external_memory_export can be exported.");
 		}
+		auto getFdInfo = vk::MemoryGetFdInfoKHR{}
+			.setMemory(aBuffer.mExternalMemory.get())
+			.setHandleType(aHandleType);
+		return device().getMemoryFdKHR(getFdInfo, dispatch_loader_ext());
+	}
 
-		// 16. Maybe alter the config?!
+	int root::export_memory_fd(const image_t& aImage, vk::ExternalMemoryHandleTypeFlagBits aHandleType) const
+	{
+		if (!aImage.has_external_memory()) {
+			throw avk::logic_error("Only the memory of images which have been created with external_memory_export can be exported.");
+		}
+		auto getFdInfo = vk::MemoryGetFdInfoKHR{}
+			.setMemory(aImage.mExternalMemory.get())
+			.setHandleType(aHandleType);
+		return device().getMemoryFdKHR(getFdInfo, dispatch_loader_ext());
+	}
+
+	semaphore root::create_exportable_semaphore(vk::ExternalSemaphoreHandleTypeFlags aHandleTypes, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation)
+	{
+		semaphore_t result;
+		result.mCreateInfo = vk::SemaphoreCreateInfo{};
+
+		// Maybe alter the config?
 		if (aAlterConfigBeforeCreation) {
 			aAlterConfigBeforeCreation(result);
 		}
 
-		assert (aConfig.mRenderPassSubpass.has_value() || dynamicRenderingEnabled);
-		rewire_config_and_create_graphics_pipeline(result);
+		// Put the export info in front of whatever has been configured, e.g., a vk::SemaphoreTypeCreateInfo:
+		auto exportInfo = vk::ExportSemaphoreCreateInfo{}
+			.setHandleTypes(aHandleTypes)
+			.setPNext(result.mCreateInfo.pNext);
+		auto createInfo = result.mCreateInfo;
+		createInfo.setPNext(&exportInfo);
+		result.mSemaphore = device().createSemaphoreUnique(createInfo, nullptr, dispatch_loader_core());
 		return result;
 	}
 
-	graphics_pipeline root::create_graphics_pipeline_from_template(const graphics_pipeline_t& aTemplate, std::optional<renderpass> aNewRenderpass, std::optional<cfg::subpass_index> aSubpassIndex, std::function<void(graphics_pipeline_t&)> aAlterConfigBeforeCreation)
+	int root::export_semaphore_fd(const semaphore_t& aSemaphore, vk::ExternalSemaphoreHandleTypeFlagBits aHandleType) const
 	{
-		graphics_pipeline_t result;
-		if(aTemplate.mRenderingCreateInfo.has_value() && aNewRenderpass.has_value())
-		{
-			throw avk::runtime_error("Attempting to create pipeline using renderpass from a template pipeline using dynamic rendering (which has no renderpasses) is not valid!");
+		auto getFdInfo = vk::SemaphoreGetFdInfoKHR{}
+			.setSemaphore(aSemaphore.handle())
+			.setHandleType(aHandleType);
+		return device().getSemaphoreFdKHR(getFdInfo, dispatch_loader_ext());
+	}
+
+	void root::import_semaphore_fd(const semaphore_t& aSemaphore, int aFd, vk::ExternalSemaphoreHandleTypeFlagBits aHandleType, bool aTemporary) const
+	{
+		if (vk::ExternalSemaphoreHandleTypeFlagBits::eSyncFd == aHandleType && !aTemporary) {
+			throw avk::logic_error("Sync file descriptors can only be imported temporarily.");
 		}
-		result.mRenderPass = std::move(aNewRenderpass);
-		result.mSubpassIndex = aSubpassIndex.value_or(cfg::subpass_index{ aTemplate.mSubpassIndex }).mSubpassIndex;
-
-		result.mOrderedVertexInputBindingDescriptions	= aTemplate.mOrderedVertexInputBindingDescriptions;
-		result.mVertexInputAttributeDescriptions		= aTemplate.mVertexInputAttributeDescriptions	   ;
-		result.mPipelineVertexInputStateCreateInfo		= aTemplate.mPipelineVertexInputStateCreateInfo   ;
-		result.mInputAssemblyStateCreateInfo			= aTemplate.mInputAssemblyStateCreateInfo		   ;
+		auto importInfo = vk::ImportSemaphoreFdInfoKHR{}
+			.setSemaphore(aSemaphore.handle())
+			.setFlags(aTemporary ? vk::SemaphoreImportFlagBits::eTemporary : vk::SemaphoreImportFlags{})
+			.setHandleType(aHandleType)
+			.setFd(aFd);
+		device().importSemaphoreFdKHR(importInfo, dispatch_loader_ext());
+	}
+#pragma endregion
 
-		for (const auto& shdr : aTemplate.mShaders) {
-			result.mShaders.push_back(create_shader_from_template(shdr));
+#pragma region fence definitions
+	fence_t::~fence_t()
+	{
+		if (mCustomDeleter.has_value() && *mCustomDeleter) {
+			// If there is a custom deleter => call it now
+			(*mCustomDeleter)();
+			mCustomDeleter.reset();
 		}
+		// Destroy the dependant instance before destroying myself
+		// ^ This is ensured by the order of the members
+		//   See: https://isocpp.org/wiki/faq/dtors#calling-member-dtors
+	}
 
-		result.mShaderStageCreateInfos					= aTemplate.mShaderStageCreateInfos					;
-		result.mSpecializationInfos						= aTemplate.mSpecializationInfos				   ;
-		result.mViewports								= aTemplate.mViewports							   ;
-		result.mScissors								= aTemplate.mScissors							   ;
-		result.mViewportStateCreateInfo					= aTemplate.mViewportStateCreateInfo			   ;
-		result.mRasterizationStateCreateInfo			= aTemplate.mRasterizationStateCreateInfo		   ;
-		result.mDepthStencilConfig						= aTemplate.mDepthStencilConfig						;
-		result.mBlendingConfigsForColorAttachments		= aTemplate.mBlendingConfigsForColorAttachments   ;
-		result.mColorBlendStateCreateInfo				= aTemplate.mColorBlendStateCreateInfo			   ;
-		result.mMultisampleStateCreateInfo				= aTemplate.mMultisampleStateCreateInfo				;
-		result.mDynamicStateEntries						= aTemplate.mDynamicStateEntries				   ;
-		result.mDynamicStateCreateInfo					= aTemplate.mDynamicStateCreateInfo					;
+	fence_t& fence_t::handle_lifetime_of(any_owning_resource_t aResource)
+	{
+		mLifetimeHandledResources.push_back(std::move(aResource));
+		return *this;
+	}
 
-		result.mAllDescriptorSetLayouts = create_set_of_descriptor_set_layouts_from_template(aTemplate.mAllDescriptorSetLayouts);
+	void fence_t::wait_until_signalled(std::optional<uint64_t> aTimeout) const
+	{
+		// ReSharper disable once CppExpressionWithoutSideEffects
+		auto result = mFence.getOwner().waitForFences(1u, handle_ptr(), VK_TRUE, aTimeout.value_or(UINT64_MAX));
+		assert(static_cast<VkResult>(result) >= 0);
+	}
 
-		result.mPushConstantRanges						= aTemplate.mPushConstantRanges						;
-		result.mPipelineTessellationStateCreateInfo		= aTemplate.mPipelineTessellationStateCreateInfo  ;
+	void fence_t::reset()
+	{
+		// ReSharper disable once CppExpressionWithoutSideEffects
+		auto result = mFence.getOwner().resetFences(1u, handle_ptr());
+		if (mCustomDeleter.has_value() && *mCustomDeleter) {
+			// If there is a custom deleter => call it now
+			(*mCustomDeleter)();
+			mCustomDeleter.reset();
+		}
+	}
 
-		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
-		// These uniform values (Anm.: passed to shaders) need to be specified during pipeline creation by creating a VkPipelineLayout object. [4]
-		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
-			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
-			.setPSetLayouts(descriptorSetLayoutHandles.data())
-			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
-			.setPPushConstantRanges(result.mPushConstantRanges.data());
+	fence root::create_fence(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, bool aCreateInSignalledState, std::function<void(fence_t&)> aAlterConfigBeforeCreation)
+	{
+		fence_t result;
+		result.mCreateInfo = vk::FenceCreateInfo()
+			.setFlags(aCreateInSignalledState
+						? vk::FenceCreateFlagBits::eSignaled
+						: vk::FenceCreateFlags()
+			);
 
-		// 15. Maybe alter the config?!
+		// Maybe alter the config?
 		if (aAlterConfigBeforeCreation) {
 			aAlterConfigBeforeCreation(result);
 		}
 
-		rewire_config_and_create_graphics_pipeline(result);
+		result.mFence = aDevice.createFenceUnique(result.mCreateInfo, nullptr, aDispatchLoader);
 		return result;
 	}
 
-	graphics_pipeline root::create_graphics_pipeline_from_template(const graphics_pipeline_t& aTemplate, std::function<void(graphics_pipeline_t&)> aAlterConfigBeforeCreation)
+	fence root::create_fence(bool aCreateInSignalledState, std::function<void(fence_t&)> aAlterConfigBeforeCreation)
 	{
-		// If dynamic rendering is enabled we don't want to create new renderpass
-		if(aTemplate.mRenderingCreateInfo.has_value())
-		{
-			return create_graphics_pipeline_from_template(aTemplate, std::nullopt, std::nullopt, std::move(aAlterConfigBeforeCreation));
+		return create_fence(device(), dispatch_loader_core(), aCreateInSignalledState, std::move(aAlterConfigBeforeCreation));
+	}
+#pragma endregion
+
+#pragma region frame linear allocator definitions
+	frame_linear_allocator_t::chunk frame_linear_allocator_t::create_chunk() const
+	{
+#if VK_HEADER_VERSION >= 135
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#else
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#endif
+		const auto chunkSize = static_cast<size_t>(mChunkSize);
+		metas.push_back(generic_buffer_meta::create_from_size(chunkSize));
+		// Add meta data for all the supported usages, s.t. slices can be bound as descriptors or index buffers:
+		if (avk::has_flag(mBufferUsageFlags, vk::BufferUsageFlagBits::eUniformBuffer)) {
+			metas.push_back(uniform_buffer_meta::create_from_size(chunkSize));
 		}
-		std::optional<avk::renderpass> renderpassForPipeline;
-		if (aTemplate.mRenderPass.value().is_shared_ownership_enabled()) {
-			renderpassForPipeline = aTemplate.mRenderPass;
+		if (avk::has_flag(mBufferUsageFlags, vk::BufferUsageFlagBits::eStorageBuffer)) {
+			metas.push_back(storage_buffer_meta::create_from_size(chunkSize));
 		}
-		else {
-			renderpassForPipeline = create_renderpass_from_template(*(aTemplate.mRenderPass.value()), {});
+		if (avk::has_flag(mBufferUsageFlags, vk::BufferUsageFlagBits::eIndexBuffer)) {
+			// Indices handed out by the allocator are assumed to be 32-bit indices:
+			metas.push_back(index_buffer_meta::create_from_element_size(sizeof(uint32_t), chunkSize / sizeof(uint32_t)));
 		}
-		return create_graphics_pipeline_from_template(aTemplate, std::move(renderpassForPipeline), std::nullopt, std::move(aAlterConfigBeforeCreation));
+		if (avk::has_flag(mBufferUsageFlags, vk::BufferUsageFlagBits::eIndirectBuffer)) {
+			metas.push_back(indirect_buffer_meta::create_from_size(chunkSize));
+		}
+
+		chunk result;
+		result.mBuffer = root::create_buffer(*mRoot, std::move(metas), mBufferUsageFlags, mMemoryProperties);
+		if (!avk::has_flag(result.mBuffer->memory_properties(), vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)) {
+			throw avk::runtime_error("The memory of a frame_linear_allocator's chunk must be host visible and host coherent.");
+		}
+		result.mMapping.emplace(result.mBuffer->map_memory(mapping_access::write));
+		return result;
 	}
 
-	renderpass root::replace_render_pass_for_pipeline(graphics_pipeline& aPipeline, renderpass aNewRenderPass)
+	void frame_linear_allocator_t::begin_frame(uint64_t aRetireValue, std::optional<uint64_t> aCompletedValue)
 	{
-		if(aPipeline.get().mRenderingCreateInfo.has_value())
-		{
-			throw avk::runtime_error("Attempting to replace renderpass of pipeline using dynamic rendering (which has no renderpasses) is not valid!");
+		mCurrentFrameSlot = static_cast<size_t>(aRetireValue % mFrameSlots.size());
+		auto& slot = mFrameSlots[mCurrentFrameSlot];
+		if (aCompletedValue.has_value() && slot.mRetireValue.has_value() && slot.mRetireValue.value() > aCompletedValue.value()) {
+			throw avk::logic_error("Frame slot " + std::to_string(mCurrentFrameSlot) + " of the frame_linear_allocator is still in use (retire value " + std::to_string(slot.mRetireValue.value()) + ", but only " + std::to_string(aCompletedValue.value()) + " has been completed).");
 		}
+		slot.mCurrentChunk = 0;
+		slot.mCurrentOffset = 0;
+		slot.mRetireValue = aRetireValue;
+	}
 
-		if (aPipeline->mRenderPass.value().is_shared_ownership_enabled()) {
-			aNewRenderPass.enable_shared_ownership();
+	frame_linear_allocation frame_linear_allocator_t::allocate(vk::DeviceSize aSize, vk::DeviceSize aAlignment)
+	{
+		if (aSize > mChunkSize) {
+			throw avk::logic_error("Allocation of " + std::to_string(aSize) + " bytes exceeds the frame_linear_allocator's chunk size of " + std::to_string(mChunkSize) + " bytes.");
 		}
+		const auto alignment = 0 == aAlignment ? mDefaultAlignment : aAlignment;
+		auto& slot = mFrameSlots[mCurrentFrameSlot];
 
-		auto oldRenderPass = std::move(aPipeline->mRenderPass);
-		aPipeline->mRenderPass = std::move(aNewRenderPass);
+		auto offset = (slot.mCurrentOffset + alignment - 1) / alignment * alignment;
+		if (slot.mCurrentChunk < slot.mChunks.size() && offset + aSize > mChunkSize) {
+			// Current chunk is exhausted => continue with the next one:
+			++slot.mCurrentChunk;
+			offset = 0;
+		}
+		if (slot.mCurrentChunk == slot.mChunks.size()) {
+			slot.mChunks.push_back(create_chunk());
+			offset = 0;
+		}
+		slot.mCurrentOffset = offset + aSize;
 
-		return oldRenderPass.value();
+		const auto& currentChunk = slot.mChunks[slot.mCurrentChunk];
+		return frame_linear_allocation{
+			buffer_slice{ currentChunk.mBuffer.get(), offset, aSize },
+			static_cast<uint8_t*>(currentChunk.mMapping->get()) + offset
+		};
 	}
-#pragma endregion
 
-#pragma region image definitions
-	image_t::image_t(const image_t& aOther)
+	size_t frame_linear_allocator_t::number_of_chunks() const
 	{
-		if (std::holds_alternative<vk::Image>(aOther.mImage)) {
-			mCreateInfo = aOther.mCreateInfo;
-			mImage = std::get<vk::Image>(aOther.mImage);
-			mImageUsage = aOther.mImageUsage;
-			mAspectFlags = aOther.mAspectFlags;
-		}
-		else {
-			throw avk::runtime_error("Can not copy this image instance!");
+		size_t n = 0;
+		for (const auto& slot : mFrameSlots) {
+			n += slot.mChunks.size();
 		}
+		return n;
 	}
 
-	image root::create_image_from_template(const image_t& aTemplate, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+	vk::DeviceSize frame_linear_allocator_t::bytes_allocated_in_current_frame() const
 	{
-		image_t result;
-		result.mRoot = aTemplate.mRoot;
-		result.mCreateInfo = aTemplate.mCreateInfo;
-		result.mImageUsage = aTemplate.mImageUsage;
-		result.mAspectFlags = aTemplate.mAspectFlags;
-
-		if (std::holds_alternative<vk::Image>(aTemplate.mImage)) {
-			// If the template is a wrapped image, there's not a lot we can do.
-			//result.mImage = std::get<vk::Image>(aTemplate.mImage);
-			return result;
-		}
-
-		assert(!std::holds_alternative<std::monostate>(aTemplate.mImage));
+		const auto& slot = mFrameSlots[mCurrentFrameSlot];
+		return static_cast<vk::DeviceSize>(slot.mCurrentChunk) * mChunkSize + slot.mCurrentOffset;
+	}
 
-		// Maybe alter the config?!
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(result);
+	frame_linear_allocator root::create_frame_linear_allocator(size_t aNumberOfFramesInFlight, vk::DeviceSize aChunkSize, vk::BufferUsageFlags aBufferUsageFlags, vk::MemoryPropertyFlags aMemoryProperties)
+	{
+		if (0 == aNumberOfFramesInFlight || 0 == aChunkSize) {
+			throw avk::logic_error("A frame_linear_allocator requires at least one frame in flight and a chunk size greater than 0.");
 		}
 
-		result.mImage = AVK_MEM_IMAGE_HANDLE{ memory_allocator(), aTemplate.memory_properties(), result.mCreateInfo };
-
+		const auto& limits = capabilities().limits();
+		frame_linear_allocator_t result;
+		result.mRoot = this;
+		result.mChunkSize = aChunkSize;
+		result.mDefaultAlignment = std::max({
+			limits.minUniformBufferOffsetAlignment,
+			limits.minStorageBufferOffsetAlignment,
+			limits.minTexelBufferOffsetAlignment,
+			static_cast<vk::DeviceSize>(sizeof(uint32_t))
+		});
+		result.mBufferUsageFlags = aBufferUsageFlags;
+		result.mMemoryProperties = aMemoryProperties;
+		result.mFrameSlots.resize(aNumberOfFramesInFlight);
 		return result;
 	}
+#pragma endregion
 
-	image root::create_image(uint32_t aWidth, uint32_t aHeight, std::tuple<vk::Format, vk::SampleCountFlagBits> aFormatAndSamples, int aNumLayers, memory_usage aMemoryUsage, image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+#pragma region framebuffer definitions
+	void root::check_and_config_attachments_based_on_views(std::vector<attachment>& aAttachments, std::vector<image_view>& aImageViews)
 	{
-		// Determine image usage flags, image layout, and memory usage flags:
-		auto [imageUsage, targetLayout, imageTiling, imageCreateFlags] = determine_usage_layout_tiling_flags_based_on_image_usage(aImageUsage);
-
-		vk::MemoryPropertyFlags memoryPropFlags{};
-		switch (aMemoryUsage) {
-		case avk::memory_usage::host_visible:
-			memoryPropFlags = vk::MemoryPropertyFlagBits::eHostVisible;
-			break;
-		case avk::memory_usage::host_coherent:
-			memoryPropFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
-			break;
-		case avk::memory_usage::host_cached:
-			memoryPropFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCached;
-			break;
-		case avk::memory_usage::device:
-			memoryPropFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
-			imageUsage |= vk::ImageUsageFlagBits::eTransferDst;
-			break;
-		case avk::memory_usage::device_readback:
-			memoryPropFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
-			imageUsage |= vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc;
-			break;
-		case avk::memory_usage::device_protected:
-			memoryPropFlags = vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eProtected;
-			imageUsage |= vk::ImageUsageFlagBits::eTransferDst;
-			break;
+		if (aAttachments.size() != aImageViews.size()) {
+			throw avk::runtime_error("Incomplete config for framebuffer creation: number of attachments (" + std::to_string(aAttachments.size()) + ") does not equal the number of image views (" + std::to_string(aImageViews.size()) + ")");
 		}
-
-		// How many MIP-map levels are we going to use?
-		auto mipLevels = avk::has_flag(aImageUsage, avk::image_usage::mip_mapped)
-			? static_cast<uint32_t>(1 + std::floor(std::log2(std::max(aWidth, aHeight))))
-			: 1u;
-
-		const auto format = std::get<vk::Format>(aFormatAndSamples);
-		const auto samples = std::get<vk::SampleCountFlagBits>(aFormatAndSamples);
-
-		if (avk::has_flag(imageUsage, vk::ImageUsageFlagBits::eDepthStencilAttachment) && vk::ImageTiling::eOptimal == imageTiling) { // only for AMD |-(
-			auto formatProps = physical_device().getFormatProperties(format);
-			if (!has_flag(formatProps.optimalTilingFeatures, vk::FormatFeatureFlagBits::eDepthStencilAttachment)) {
-				imageTiling = vk::ImageTiling::eLinear;
+		auto n = aAttachments.size();
+		for (size_t i = 0; i < n; ++i) {
+			auto& a = aAttachments[i];
+			auto& v = aImageViews[i];
+			if ((is_depth_format(v->get_image().format()) || has_stencil_component(v->get_image().format())) && !a.is_used_as_depth_stencil_attachment()) {
+				AVK_LOG_WARNING("Possibly misconfigured framebuffer: image[" + std::to_string(i) + "] is a depth/stencil format, but it is never indicated to be used as such in the attachment-description[" + std::to_string(i) + "].");
+			}
+			if (avk::has_flag(v->get_image().create_info().usage, vk::ImageUsageFlagBits::eTransientAttachment) && !a.is_transient()) {
+				AVK_LOG_WARNING("Possibly misconfigured framebuffer: image[" + std::to_string(i) + "] is a transient attachment, but its contents are loaded or stored according to attachment-description[" + std::to_string(i) + "].");
 			}
 		}
+	}
 
-		vk::ImageAspectFlags aspectFlags = {};
-		if (is_depth_format(format)) {
-			aspectFlags |= vk::ImageAspectFlagBits::eDepth;
-		}
-		if (has_stencil_component(format)) {
-			aspectFlags |= vk::ImageAspectFlagBits::eStencil;
-		}
-		if (!aspectFlags) {
-			aspectFlags = vk::ImageAspectFlagBits::eColor;
-			// TODO: maybe support further aspect flags?!
+	framebuffer root::create_framebuffer(renderpass aRenderpass, std::vector<image_view> aImageViews, uint32_t aWidth, uint32_t aHeight, std::function<void(framebuffer_t&)> aAlterConfigBeforeCreation)
+	{
+		framebuffer_t result;
+		result.mRenderpass = std::move(aRenderpass);
+		result.mImageViews = std::move(aImageViews);
+
+		std::vector<vk::ImageView> imageViewHandles;
+		for (const auto& iv : result.mImageViews) {
+			imageViewHandles.push_back(iv->handle());
 		}
 
-		image_t result;
-		result.mRoot = this;
-		result.mCreateInfo = vk::ImageCreateInfo()
-			.setImageType(vk::ImageType::e2D) // TODO: Support 3D textures
-			.setExtent(vk::Extent3D(static_cast<uint32_t>(aWidth), static_cast<uint32_t>(aHeight), 1u))
-			.setMipLevels(mipLevels)
-			.setArrayLayers(aNumLayers)
-			.setFormat(format)
-			.setTiling(imageTiling)
-			.setInitialLayout(vk::ImageLayout::eUndefined)
-			.setUsage(imageUsage)
-			.setSharingMode(vk::SharingMode::eExclusive) // TODO: Not sure yet how to handle this one, Exclusive should be the default, though.
-			.setSamples(samples)
-			.setFlags(imageCreateFlags);
-		result.mImageUsage = aImageUsage;
-		result.mAspectFlags = aspectFlags;
+		result.mCreateInfo = vk::FramebufferCreateInfo{}
+			.setRenderPass(result.mRenderpass->handle())
+			.setAttachmentCount(static_cast<uint32_t>(imageViewHandles.size()))
+			.setPAttachments(imageViewHandles.data())
+			.setWidth(aWidth)
+			.setHeight(aHeight)
+			// TODO: Support multiple layers of image arrays!
+			.setLayers(1u); // number of layers in image arrays [6]
 
 		// Maybe alter the config?!
 		if (aAlterConfigBeforeCreation) {
 			aAlterConfigBeforeCreation(result);
 		}
 
-		result.mImage = AVK_MEM_IMAGE_HANDLE{ memory_allocator(), memoryPropFlags, result.mCreateInfo };
-
+		result.mFramebuffer = device().createFramebufferUnique(result.mCreateInfo, nullptr, dispatch_loader_core());
 		return result;
 	}
 
-	image root::create_image(uint32_t aWidth, uint32_t aHeight, vk::Format aFormat, int aNumLayers, memory_usage aMemoryUsage, avk::image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+	framebuffer root::create_framebuffer(std::vector<attachment> aAttachments, std::vector<image_view> aImageViews, uint32_t aWidth, uint32_t aHeight, std::function<void(framebuffer_t&)> aAlterConfigBeforeCreation)
 	{
-		return create_image(aWidth, aHeight, std::make_tuple(aFormat, vk::SampleCountFlagBits::e1), aNumLayers, aMemoryUsage, aImageUsage, std::move(aAlterConfigBeforeCreation));
+		check_and_config_attachments_based_on_views(aAttachments, aImageViews);
+		return create_framebuffer(
+			create_renderpass(std::move(aAttachments)),
+			std::move(aImageViews),
+			aWidth, aHeight,
+			std::move(aAlterConfigBeforeCreation)
+		);
 	}
 
-
-	image root::create_depth_image(uint32_t aWidth, uint32_t aHeight, std::optional<vk::Format> aFormat, int aNumLayers,  memory_usage aMemoryUsage, avk::image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+	framebuffer root::create_framebuffer(renderpass aRenderpass, std::vector<image_view> aImageViews, std::function<void(framebuffer_t&)> aAlterConfigBeforeCreation)
 	{
-		// Select a suitable depth format
-		if (!aFormat) {
-			std::array depthFormats = { vk::Format::eD32Sfloat, vk::Format::eD24UnormS8Uint, vk::Format::eD16Unorm };
-			for (auto format : depthFormats) {
-				if (is_format_supported(format, vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eDepthStencilAttachment)) {
-					aFormat = format;
-					break;
-				}
-			}
-		}
-		if (!aFormat) {
-			throw avk::runtime_error("No suitable depth format could be found.");
-		}
-
-		aImageUsage |= avk::image_usage::depth_stencil_attachment;
+		assert(!aImageViews.empty());
+		auto extent = aImageViews.front()->get_image().create_info().extent;
+		return create_framebuffer(std::move(aRenderpass), std::move(aImageViews), extent.width, extent.height, std::move(aAlterConfigBeforeCreation));
+	}
 
-		// Create the image (by default only on the device which should be sufficient for a depth buffer => see pMemoryUsage's default value):
-		auto result = create_image(aWidth, aHeight, *aFormat, aNumLayers, aMemoryUsage, aImageUsage, std::move(aAlterConfigBeforeCreation));
-		result->mAspectFlags |= vk::ImageAspectFlagBits::eDepth;
-		return result;
+	framebuffer root::create_framebuffer(std::vector<avk::attachment> aAttachments, std::vector<image_view> aImageViews, std::function<void(framebuffer_t&)> aAlterConfigBeforeCreation)
+	{
+		check_and_config_attachments_based_on_views(aAttachments, aImageViews);
+		return create_framebuffer(
+			create_renderpass(std::move(aAttachments)),
+			std::move(aImageViews),
+			std::move(aAlterConfigBeforeCreation)
+		);
 	}
 
-	image root::create_depth_stencil_image(uint32_t aWidth, uint32_t aHeight, std::optional<vk::Format> aFormat, int aNumLayers,  memory_usage aMemoryUsage, avk::image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+	framebuffer root::create_framebuffer_from_template(const framebuffer_t& aTemplate, std::function<void(image_t&)> aAlterImageConfigBeforeCreation,
+		std::function<void(image_view_t&)> aAlterImageViewConfigBeforeCreation, std::function<void(framebuffer_t&)> aAlterFramebufferConfigBeforeCreation)
 	{
-		// Select a suitable depth+stencil format
-		if (!aFormat) {
-			std::array depthFormats = { vk::Format::eD32SfloatS8Uint, vk::Format::eD24UnormS8Uint, vk::Format::eD16UnormS8Uint };
-			for (auto format : depthFormats) {
-				if (is_format_supported(format, vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eDepthStencilAttachment)) {
-					aFormat = format;
-					break;
-				}
-			}
-		}
-		if (!aFormat) {
-			throw avk::runtime_error("No suitable depth+stencil format could be found.");
+		const auto& templateImageViews = aTemplate.image_views();
+		std::vector<image_view> imageViews;
+
+		for (auto& imView : templateImageViews)	{
+			auto imageView = create_image_view_from_template(*imView, aAlterImageConfigBeforeCreation, aAlterImageViewConfigBeforeCreation);
+			imageViews.emplace_back(std::move(imageView));
 		}
 
-		// Create the image (by default only on the device which should be sufficient for a depth+stencil buffer => see pMemoryUsage's default value):
-		auto result = create_depth_image(aWidth, aHeight, *aFormat, aNumLayers, aMemoryUsage, aImageUsage, std::move(aAlterConfigBeforeCreation));
-		result->mAspectFlags |= vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
-		return result;
+		return create_framebuffer(
+			create_renderpass_from_template(aTemplate.renderpass_reference()),
+			std::move(imageViews),
+			aTemplate.mCreateInfo.width,
+			aTemplate.mCreateInfo.height,
+			aAlterFramebufferConfigBeforeCreation
+		);
 	}
+#pragma endregion
 
-	image_t root::wrap_image(vk::Image aImageToWrap, vk::ImageCreateInfo aImageCreateInfo, avk::image_usage aImageUsage, vk::ImageAspectFlags aImageAspectFlags)
+#pragma region geometry instance definitions
+#if VK_HEADER_VERSION >= 135
+	geometry_instance root::create_geometry_instance(const bottom_level_acceleration_structure_t& aBlas)
 	{
-		auto [imageUsage, targetLayout, imageTiling, imageCreateFlags] = determine_usage_layout_tiling_flags_based_on_image_usage(aImageUsage);
-
-		image_t result;
-		result.mRoot = this;
-		result.mCreateInfo = aImageCreateInfo;
-		result.mImage = aImageToWrap;
-		result.mImageUsage = aImageUsage;
-		result.mAspectFlags = aImageAspectFlags;
-		return result;
+		// glm::mat4 mTransform;
+		// uint32_t mInstanceCustomIndex;
+		// uint32_t mMask;
+		// size_t mInstanceOffset;
+		// vk::GeometryInstanceFlagsKHR mFlags;
+		// uint64_t mAccelerationStructureDeviceHandle;
+		return geometry_instance
+		{
+			{ 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f },
+			0,
+			0xff,
+			0,
+			vk::GeometryInstanceFlagsKHR(),
+			aBlas.device_address()
+		};
 	}
 
-	vk::ImageSubresourceRange image_t::entire_subresource_range() const
+	geometry_instance& geometry_instance::set_transform(VkTransformMatrixKHR aTransformationMatrix)
 	{
-		return vk::ImageSubresourceRange{
-			mAspectFlags,
-			0u, VK_REMAINING_MIP_LEVELS,	// MIP info
-			0u, VK_REMAINING_ARRAY_LAYERS	// Layers info
-		};
+		mTransform.matrix[0][0] = aTransformationMatrix.matrix[0][0];
+		mTransform.matrix[0][1] = aTransformationMatrix.matrix[0][1];
+		mTransform.matrix[0][2] = aTransformationMatrix.matrix[0][2];
+		mTransform.matrix[0][3] = aTransformationMatrix.matrix[0][3];
+		mTransform.matrix[1][0] = aTransformationMatrix.matrix[1][0];
+		mTransform.matrix[1][1] = aTransformationMatrix.matrix[1][1];
+		mTransform.matrix[1][2] = aTransformationMatrix.matrix[1][2];
+		mTransform.matrix[1][3] = aTransformationMatrix.matrix[1][3];
+		mTransform.matrix[2][0] = aTransformationMatrix.matrix[2][0];
+		mTransform.matrix[2][1] = aTransformationMatrix.matrix[2][1];
+		mTransform.matrix[2][2] = aTransformationMatrix.matrix[2][2];
+		mTransform.matrix[2][3] = aTransformationMatrix.matrix[2][3];
+		return *this;
 	}
 
-	avk::command::action_type_command image_t::generate_mip_maps(avk::layout::image_layout_transition aLayoutTransition)
+	geometry_instance& geometry_instance::set_transform_row_major(float aTransformationMatrix[3][4])
 	{
-		if (create_info().mipLevels <= 1u) {
-			return {};
-		}
-		
-		auto actionTypeCommand = avk::command::action_type_command{
-			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
-			{
-				std::make_tuple(handle(), avk::sync::sync_hint{
-					stage::transfer + (access::transfer_read | access::transfer_write), // This one is actually only here to establish a dependency chain to the first image layout transition
-					stage::transfer +                          access::transfer_write   // This one as well
-				})
-			},
-			[
-				lRoot = root_ptr(),
-				lImageHandle = handle(),
-				lArrayLayers = create_info().arrayLayers,
-				lWidth = static_cast<int32_t>(width()),
-				lHeight = static_cast<int32_t>(height()),
-				lAspectFlags = mAspectFlags,
-				lMipLevels = create_info().mipLevels,
-				aLayoutTransition
-			](avk::command_buffer_t& cb) {
+		mTransform.matrix[0][0] = aTransformationMatrix[0][0];
+		mTransform.matrix[0][1] = aTransformationMatrix[0][1];
+		mTransform.matrix[0][2] = aTransformationMatrix[0][2];
+		mTransform.matrix[0][3] = aTransformationMatrix[0][3];
+		mTransform.matrix[1][0] = aTransformationMatrix[1][0];
+		mTransform.matrix[1][1] = aTransformationMatrix[1][1];
+		mTransform.matrix[1][2] = aTransformationMatrix[1][2];
+		mTransform.matrix[1][3] = aTransformationMatrix[1][3];
+		mTransform.matrix[2][0] = aTransformationMatrix[2][0];
+		mTransform.matrix[2][1] = aTransformationMatrix[2][1];
+		mTransform.matrix[2][2] = aTransformationMatrix[2][2];
+		mTransform.matrix[2][3] = aTransformationMatrix[2][3];
+		return *this;
+	}
 
-				auto w = lWidth;
-				auto h = lHeight;
+	geometry_instance& geometry_instance::set_transform_row_major(std::array<float, 16> aTransformationMatrix)
+	{
+		mTransform.matrix[0][0] = aTransformationMatrix[0];
+		mTransform.matrix[0][1] = aTransformationMatrix[1];
+		mTransform.matrix[0][2] = aTransformationMatrix[2];
+		mTransform.matrix[0][3] = aTransformationMatrix[3];
+		mTransform.matrix[1][0] = aTransformationMatrix[4];
+		mTransform.matrix[1][1] = aTransformationMatrix[5];
+		mTransform.matrix[1][2] = aTransformationMatrix[6];
+		mTransform.matrix[1][3] = aTransformationMatrix[7];
+		mTransform.matrix[2][0] = aTransformationMatrix[8];
+		mTransform.matrix[2][1] = aTransformationMatrix[9];
+		mTransform.matrix[2][2] = aTransformationMatrix[10];
+		mTransform.matrix[2][3] = aTransformationMatrix[11];
+		return *this;
+	}
 
-				for (uint32_t l = 0u; l < lArrayLayers; ++l) {
-					
-					std::array layoutTransitions = { // during the loop, we'll use 1 or 2 of these
-						vk::ImageMemoryBarrier{
-							vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eTransferRead, // Memory is available AND already visible for transfer read because that has been established in establish_barrier_before_the_operation above.
-							aLayoutTransition.mOld.mLayout, vk::ImageLayout::eTransferSrcOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, 0u, 1u, l, 1u }},
-						vk::ImageMemoryBarrier{
-							vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eTransferRead, // This is the first mip-level we're going to write to
-							aLayoutTransition.mOld.mLayout, vk::ImageLayout::eTransferDstOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, 1u, 1u, l, 1u }},
-						vk::ImageMemoryBarrier{} // To be used in loop
-					};
+	geometry_instance& geometry_instance::set_transform_column_major(std::array<float, 16> aTransformationMatrix)
+	{
+		mTransform.matrix[0][0] = aTransformationMatrix[0];
+		mTransform.matrix[0][1] = aTransformationMatrix[4];
+		mTransform.matrix[0][2] = aTransformationMatrix[8];
+		mTransform.matrix[0][3] = aTransformationMatrix[12];
+		mTransform.matrix[1][0] = aTransformationMatrix[1];
+		mTransform.matrix[1][1] = aTransformationMatrix[5];
+		mTransform.matrix[1][2] = aTransformationMatrix[9];
+		mTransform.matrix[1][3] = aTransformationMatrix[13];
+		mTransform.matrix[2][0] = aTransformationMatrix[2];
+		mTransform.matrix[2][1] = aTransformationMatrix[6];
+		mTransform.matrix[2][2] = aTransformationMatrix[10];
+		mTransform.matrix[2][3] = aTransformationMatrix[14];
+		return *this;
+	}
 
-					cb.handle().pipelineBarrier(
-						vk::PipelineStageFlagBits::eTransfer,
-						vk::PipelineStageFlagBits::eTransfer,
-						vk::DependencyFlags{},
-						0u, nullptr,
-						0u, nullptr,
-						2u /* initially, only 2 required */, layoutTransitions.data()
-					);
+	geometry_instance& geometry_instance::set_custom_index(uint32_t aCustomIndex)
+	{
+		mInstanceCustomIndex = aCustomIndex;
+		return *this;
+	}
 
-					for (uint32_t i = 1u; i < lMipLevels; ++i) {
+	geometry_instance& geometry_instance::set_mask(uint32_t aMask)
+	{
+		mMask = aMask;
+		return *this;
+	}
 
-						cb.handle().blitImage(
-							lImageHandle, vk::ImageLayout::eTransferSrcOptimal,
-							lImageHandle, vk::ImageLayout::eTransferDstOptimal,
-							{ vk::ImageBlit{
-								vk::ImageSubresourceLayers{ lAspectFlags, i - 1, l, 1u }, { vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ w                , h                , 1 } },
-								vk::ImageSubresourceLayers{ lAspectFlags, i    , l, 1u }, { vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ w > 1 ? w / 2 : 1, h > 1 ? h / 2 : 1, 1 } }
-							  }
-							},
-							vk::Filter::eLinear
-						);
+	geometry_instance& geometry_instance::set_instance_offset(size_t aOffset)
+	{
+		mInstanceOffset = aOffset;
+		return *this;
+	}
 
-						// mip-level  i-1  is done:
-						layoutTransitions[0] = vk::ImageMemoryBarrier{
-							{}, {}, // Blit Read -> Done
-							vk::ImageLayout::eTransferSrcOptimal, aLayoutTransition.mNew.mLayout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, i - 1, 1u, l, 1u } };
-						// mip-level   i   has been transfer destination, but is going to be transfer source:
-						layoutTransitions[1] = vk::ImageMemoryBarrier{
-							vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferRead, // Blit Write -> Blit Read
-							vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, i, 1u, l, 1u } };
-						// mip-level  i+1  is entering the game:
-						layoutTransitions[2] = vk::ImageMemoryBarrier{
-							{}, vk::AccessFlagBits::eTransferWrite, // make visible to Blit Write
-							aLayoutTransition.mOld.mLayout, vk::ImageLayout::eTransferDstOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, i + 1, 1u, l, 1u } };
+	geometry_instance& geometry_instance::set_flags(vk::GeometryInstanceFlagsKHR aFlags)
+	{
+		mFlags = aFlags;
+		return *this;
+	}
 
-						uint32_t numBarriersRequired = std::min(3u, lMipLevels - i + 1);
-						if (lMipLevels - 1 == i) {
-							layoutTransitions[1].newLayout = aLayoutTransition.mNew.mLayout; // Last one => done
-						}
+	geometry_instance& geometry_instance::add_flags(vk::GeometryInstanceFlagsKHR aFlags)
+	{
+		mFlags |= aFlags;
+		return *this;
+	}
 
-						cb.handle().pipelineBarrier(
-							vk::PipelineStageFlagBits::eTransfer,
-							vk::PipelineStageFlagBits::eTransfer, // Dependency from previous BLIT to subsequent BLIT
-							vk::DependencyFlags{},
-							0u, nullptr,
-							0u, nullptr,
-							numBarriersRequired, layoutTransitions.data()
-						);
+	geometry_instance& geometry_instance::disable_culling()
+	{
+		mFlags |= vk::GeometryInstanceFlagBitsKHR::eTriangleCullDisable;
+		return *this;
+	}
 
-						w = w > 1 ? w / 2 : 1;
-						h = h > 1 ? h / 2 : 1;
-					}
-				}
-			}
-		};
+	geometry_instance& geometry_instance::define_front_faces_to_be_counter_clockwise()
+	{
+		mFlags |= vk::GeometryInstanceFlagBitsKHR::eTriangleFrontCounterclockwise;
+		return *this;
+	}
 
-		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+	geometry_instance& geometry_instance::force_opaque()
+	{
+		mFlags |= vk::GeometryInstanceFlagBitsKHR::eForceOpaque;
+		return *this;
+	}
 
-		return actionTypeCommand;
+	geometry_instance& geometry_instance::force_non_opaque()
+	{
+		mFlags |= vk::GeometryInstanceFlagBitsKHR::eForceNoOpaque;
+		return *this;
+	}
+
+	geometry_instance& geometry_instance::reset_flags()
+	{
+		mFlags = vk::GeometryInstanceFlagsKHR();
+		return *this;
+	}
+
+	VkAccelerationStructureInstanceKHR convert_for_gpu_usage(const geometry_instance& aGeomInst)
+	{
+		VkAccelerationStructureInstanceKHR element;
+		element.transform = aGeomInst.mTransform;
+		element.instanceCustomIndex = aGeomInst.mInstanceCustomIndex;
+		element.mask = aGeomInst.mMask;
+		element.instanceShaderBindingTableRecordOffset = aGeomInst.mInstanceOffset;
+		element.flags = static_cast<uint32_t>(aGeomInst.mFlags);
+		element.accelerationStructureReference = aGeomInst.mAccelerationStructureDeviceHandle;
+		return element;
+	}
+
+	std::vector<VkAccelerationStructureInstanceKHR> convert_for_gpu_usage(const std::vector<geometry_instance>& aGeomInstances)
+	{
+		if (aGeomInstances.empty()) {
+			AVK_LOG_WARNING("Empty vector of geometry instances passed to convert_for_gpu_usage");
+		}
+
+		std::vector<VkAccelerationStructureInstanceKHR> instancesGpu;
+		instancesGpu.reserve(aGeomInstances.size());
+		for (auto& data : aGeomInstances) {
+			instancesGpu.emplace_back(convert_for_gpu_usage(data));
+		}
+		return instancesGpu;
 	}
+#endif
 #pragma endregion
 
-#pragma region image view definitions
-	image_view root::create_image_view_from_template(const image_view_t& aTemplate, std::function<void(image_t&)> aAlterImageConfigBeforeCreation, std::function<void(image_view_t&)> aAlterImageViewConfigBeforeCreation)
+#pragma region gpu vector definitions
+	void gpu_vector_base::initialize(root& aRoot, size_t aElementSize, size_t aInitialCapacity, vk::BufferUsageFlags aBufferUsageFlags, gpu_vector_config aConfig)
 	{
-		image_view_t result;
+		mRoot = &aRoot;
+		mElementSize = aElementSize;
+		// Transfer usages are required for uploads and for GPU-side copies during growth:
+		mBufferUsageFlags = aBufferUsageFlags | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst;
+		mConfig = aConfig;
+		mCapacity = std::max(aInitialCapacity, size_t{ 1 });
 
-		// Transfer ownership:
-		if (std::holds_alternative<image>(aTemplate.mImage)) {
-			auto& im = std::get<image>(aTemplate.mImage);
-			result.mImage = create_image_from_template(*im, std::move(aAlterImageConfigBeforeCreation));
-			if (im.is_shared_ownership_enabled()) {
-				std::get<image>(result.mImage).enable_shared_ownership();
+		if (nullptr != mConfig.mSparseBindingQueue) {
+			if (mConfig.mMaxCapacity < mCapacity) {
+				throw avk::logic_error("gpu_vector_config::mMaxCapacity must be at least the initial capacity when using sparse binding.");
 			}
+			mBuffer = create_device_buffer(mConfig.mMaxCapacity);
+			commit_sparse_memory(mCapacity);
 		}
 		else {
-			AVK_LOG_ERROR("Can not create an image_view from a template which wraps an image_t.");
+			mBuffer = create_device_buffer(mCapacity);
 		}
 
-		result.mCreateInfo = aTemplate.mCreateInfo;
-		result.mCreateInfo.setImage(result.get_image().handle());
-		result.mCreateInfo.subresourceRange
-			.setLevelCount(result.get_image().create_info().mipLevels)
-			.setLayerCount(result.get_image().create_info().arrayLayers);
-
-		result.mUsageInfo = aTemplate.mUsageInfo;
+		mStaging = root::create_buffer(aRoot, memory_usage::host_coherent, vk::BufferUsageFlagBits::eTransferSrc, generic_buffer_meta::create_from_size(mCapacity * mElementSize));
+		mStagingMapping.emplace(mStaging->map_memory(mapping_access::write));
+	}
 
-		// Maybe alter the config?!
-		if (aAlterImageViewConfigBeforeCreation) {
-			aAlterImageViewConfigBeforeCreation(result);
+	buffer gpu_vector_base::create_device_buffer(size_t aCapacity) const
+	{
+#if VK_HEADER_VERSION >= 135
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, aabb_buffer_meta, geometry_instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#else
+		std::vector<std::variant<buffer_meta, generic_buffer_meta, uniform_buffer_meta, uniform_texel_buffer_meta, storage_buffer_meta, storage_texel_buffer_meta, vertex_buffer_meta, index_buffer_meta, instance_buffer_meta, query_results_buffer_meta, indirect_buffer_meta>> metas;
+#endif
+		const auto sizeInBytes = aCapacity * mElementSize;
+		metas.push_back(generic_buffer_meta::create_from_size(sizeInBytes));
+		if (avk::has_flag(mBufferUsageFlags, vk::BufferUsageFlagBits::eStorageBuffer)) {
+			metas.push_back(storage_buffer_meta::create_from_size(sizeInBytes));
+		}
+		if (avk::has_flag(mBufferUsageFlags, vk::BufferUsageFlagBits::eIndexBuffer)) {
+			metas.push_back(index_buffer_meta::create_from_element_size(mElementSize, aCapacity));
+		}
+		if (avk::has_flag(mBufferUsageFlags, vk::BufferUsageFlagBits::eIndirectBuffer)) {
+			metas.push_back(indirect_buffer_meta::create_from_size(sizeInBytes));
 		}
 
-		result.mImageView = device().createImageViewUnique(result.mCreateInfo, nullptr, dispatch_loader_core());
+		if (nullptr == mConfig.mSparseBindingQueue) {
+			return root::create_buffer(*mRoot, std::move(metas), mBufferUsageFlags, vk::MemoryPropertyFlagBits::eDeviceLocal);
+		}
 
+		// Sparse buffer: Memory is bound block by block in commit_sparse_memory
+		buffer_t result;
+		result.mMetaData = std::move(metas);
+		result.mCreateInfo = vk::BufferCreateInfo{}
+			.setFlags(vk::BufferCreateFlagBits::eSparseBinding | vk::BufferCreateFlagBits::eSparseResidency)
+			.setSize(static_cast<vk::DeviceSize>(sizeInBytes))
+			.setUsage(mBufferUsageFlags)
+			.setSharingMode(vk::SharingMode::eExclusive);
+		result.mBufferUsageFlags = mBufferUsageFlags;
+		result.mRoot = mRoot;
+
+		auto vkBuffer = mRoot->device().createBuffer(result.mCreateInfo, nullptr, mRoot->dispatch_loader_core());
+		// The buffer_t takes care of destroying the buffer handle, the memory is owned by the gpu_vector:
+#if defined(AVK_USES_VMA)
+		result.mBuffer.mAllocator = mRoot->memory_allocator();
+		result.mBuffer.mResource = vkBuffer;
+#else
+		result.mBuffer = AVK_MEM_BUFFER_HANDLE{ mRoot->memory_allocator(), vkBuffer };
+		result.mBuffer.mMemoryPropertyFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+#endif
 		return result;
 	}
 
-
-	image_view root::create_image_view(avk::image aImage, std::optional<vk::Format> aViewFormat, std::optional<avk::image_usage> aImageViewUsage, std::function<void(image_view_t&)> aAlterConfigBeforeCreation)
+	void gpu_vector_base::commit_sparse_memory(size_t aCapacity)
 	{
-		image_view_t result;
+		const auto requirements = mRoot->device().getBufferMemoryRequirements(mBuffer->handle(), mRoot->dispatch_loader_core());
+		const auto requiredBytes = std::min(
+			(static_cast<vk::DeviceSize>(aCapacity * mElementSize) + requirements.alignment - 1) / requirements.alignment * requirements.alignment,
+			requirements.size
+		);
+		if (requiredBytes <= mCommittedBytes) {
+			return;
+		}
 
-		// Transfer ownership:
-		result.mImage = std::move(aImage);
+		const auto blockSize = requiredBytes - mCommittedBytes;
+		auto tpl = mRoot->find_memory_type_index(requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+		auto memory = mRoot->device().allocateMemoryUnique(
+			vk::MemoryAllocateInfo{}
+				.setAllocationSize(blockSize)
+				.setMemoryTypeIndex(std::get<uint32_t>(tpl)),
+			nullptr, mRoot->dispatch_loader_core()
+		);
 
-		// What's the format of the image view?
-		if (!aViewFormat.has_value()) {
-			aViewFormat = result.get_image().format();
-		}
+		auto memoryBind = vk::SparseMemoryBind{}
+			.setResourceOffset(mCommittedBytes)
+			.setSize(blockSize)
+			.setMemory(memory.get())
+			.setMemoryOffset(0);
+		auto bufferBind = vk::SparseBufferMemoryBindInfo{}
+			.setBuffer(mBuffer->handle())
+			.setBindCount(1u)
+			.setPBinds(&memoryBind);
+		auto bindInfo = vk::BindSparseInfo{}
+			.setBufferBindCount(1u)
+			.setPBufferBinds(&bufferBind);
 
-		finish_configuration(result, aViewFormat.value(), {}, aImageViewUsage, std::move(aAlterConfigBeforeCreation));
+		// Growth is rare => simply wait until the memory has been bound:
+		auto bindFence = mRoot->create_fence();
+		mConfig.mSparseBindingQueue->handle().bindSparse(bindInfo, bindFence->handle(), mRoot->dispatch_loader_core());
+		bindFence->wait_until_signalled();
 
-		return result;
+		mSparseMemory.push_back(std::move(memory));
+		mCommittedBytes = requiredBytes;
 	}
 
-	image_view root::create_depth_image_view(avk::image aImage, std::optional<vk::Format> aViewFormat, std::optional<avk::image_usage> aImageViewUsage, std::function<void(image_view_t&)> aAlterConfigBeforeCreation)
+	void gpu_vector_base::reserve(size_t aCapacity)
 	{
-		image_view_t result;
+		if (aCapacity <= mCapacity) {
+			return;
+		}
+		// Grow geometrically for amortized constant costs per element:
+		auto newCapacity = std::max(aCapacity, 2 * mCapacity);
 
-		// Transfer ownership:
-		result.mImage = std::move(aImage);
+		if (nullptr != mConfig.mSparseBindingQueue) {
+			if (aCapacity > mConfig.mMaxCapacity) {
+				throw avk::runtime_error("gpu_vector can not grow beyond its maximum capacity of " + std::to_string(mConfig.mMaxCapacity) + " elements when using sparse binding.");
+			}
+			newCapacity = std::min(newCapacity, mConfig.mMaxCapacity);
+			commit_sparse_memory(newCapacity);
+		}
+		else {
+			const auto oldHandle = mBuffer->handle();
+			auto newBuffer = create_device_buffer(newCapacity);
+			// If the previous growth has not been flushed yet, the intermediate buffer does not contain any data
+			// and the contents are still to be copied from the original one:
+			if (!mPendingGrowthSource.has_value()) {
+				mPendingGrowthSource = std::move(mBuffer);
+				mPendingGrowthElements = mSize;
+			}
+			mBuffer = std::move(newBuffer);
 
-		// What's the format of the image view?
-		if (!aViewFormat.has_value()) {
-			aViewFormat = result.get_image().format();
+			for (auto* descriptorCache : mDependentDescriptorCaches) {
+				descriptorCache->remove_sets_with_handle(oldHandle);
+			}
+			for (auto* bakedCommands : mDependentBakedCommands) {
+				bakedCommands->notify_changed(oldHandle);
+			}
+			if (mOnBufferChanged) {
+				mOnBufferChanged(mBuffer.get());
+			}
 		}
 
-		finish_configuration(result, aViewFormat.value(), vk::ImageAspectFlagBits::eDepth, aImageViewUsage, std::move(aAlterConfigBeforeCreation));
+		// The staging buffer always grows by creating a new one. Pending flushes keep the old one alive:
+		auto newStaging = root::create_buffer(*mRoot, memory_usage::host_coherent, vk::BufferUsageFlagBits::eTransferSrc, generic_buffer_meta::create_from_size(newCapacity * mElementSize));
+		auto newMapping = newStaging->map_memory(mapping_access::write);
+		copy_to_mapped_memory(newMapping.get(), mStagingMapping->get(), mSize * mElementSize);
+		mStagingMapping.reset();
+		mStaging = std::move(newStaging);
+		mStagingMapping.emplace(std::move(newMapping));
 
-		return result;
+		mCapacity = newCapacity;
 	}
 
-	image_view root::create_stencil_image_view(avk::image aImage, std::optional<vk::Format> aViewFormat, std::optional<avk::image_usage> aImageViewUsage, std::function<void(image_view_t&)> aAlterConfigBeforeCreation)
+	void gpu_vector_base::resize(size_t aSize)
 	{
-		image_view_t result;
-
-		// Transfer ownership:
-		result.mImage = std::move(aImage);
+		reserve(aSize);
+		mSize = aSize;
+	}
 
-		// What's the format of the image view?
-		if (!aViewFormat.has_value()) {
-			aViewFormat = result.get_image().format();
+	size_t gpu_vector_base::grow_by(size_t aCount)
+	{
+		const auto index = mSize;
+		if (mSize + aCount > mCapacity) {
+			reserve(mSize + aCount);
 		}
-
-		finish_configuration(result, aViewFormat.value(), vk::ImageAspectFlagBits::eStencil, aImageViewUsage, std::move(aAlterConfigBeforeCreation));
-
-		return result;
+		mSize += aCount;
+		return index;
 	}
 
-	image_view root::create_image_view(image_t aImageToWrap, std::optional<vk::Format> aViewFormat, std::optional<avk::image_usage> aImageViewUsage)
+	void* gpu_vector_base::write_access(size_t aIndex, size_t aCount)
 	{
-		image_view_t result;
+		assert(aIndex + aCount <= mSize);
+		mDirtyBegin = std::min(mDirtyBegin, aIndex);
+		mDirtyEnd = std::max(mDirtyEnd, aIndex + aCount);
+		return static_cast<uint8_t*>(mStagingMapping->get()) + aIndex * mElementSize;
+	}
 
-		// Transfer ownership:
-		result.mImage = image_view_t::helper_t( std::move(aImageToWrap) );
+	command::action_type_command gpu_vector_base::flush()
+	{
+		auto result = command::action_type_command{};
 
-		// What's the format of the image view?
-		if (!aViewFormat.has_value()) {
-			aViewFormat = result.get_image().format();
+		// #1: Copy the contents of the previous buffer into the grown one:
+		if (mPendingGrowthSource.has_value()) {
+			const auto numElements = std::min(mPendingGrowthElements, mSize);
+			if (numElements > 0) {
+				result.mNestedCommandsAndSyncInstructions.push_back(copy_buffer_to_another(std::move(mPendingGrowthSource.value()), mBuffer.as_reference(), 0, 0, static_cast<vk::DeviceSize>(numElements * mElementSize)));
+				result.mNestedCommandsAndSyncInstructions.push_back(sync::buffer_memory_barrier(mBuffer.as_reference(), stage::auto_stage >> stage::auto_stage, access::auto_access >> access::auto_access));
+			}
+			mPendingGrowthSource.reset();
+			mPendingGrowthElements = 0;
 		}
 
-		finish_configuration(result, aViewFormat.value(), {}, aImageViewUsage, nullptr);
+		// #2: Upload the modified range from the staging buffer:
+		mDirtyEnd = std::min(mDirtyEnd, mSize);
+		if (mDirtyBegin < mDirtyEnd) {
+			const auto offset = static_cast<vk::DeviceSize>(mDirtyBegin * mElementSize);
+			const auto dataSize = static_cast<vk::DeviceSize>((mDirtyEnd - mDirtyBegin) * mElementSize);
+			// Share ownership of the staging buffer with the command, in case it is replaced before execution:
+			result.mNestedCommandsAndSyncInstructions.push_back(copy_buffer_to_another(buffer{ mStaging }, mBuffer.as_reference(), offset, offset, dataSize));
+		}
+		reset_dirty_range();
 
+		result.infer_sync_hint_from_nested_commands();
 		return result;
 	}
+#pragma endregion
 
-	void root::finish_configuration(image_view_t& aImageView, vk::Format aViewFormat, std::optional<vk::ImageAspectFlags> aImageAspectFlags, std::optional<avk::image_usage> aImageViewUsage, std::function<void(image_view_t&)> aAlterConfigBeforeCreation)
+#pragma region graphics pipeline config definitions
+
+	// Set sensible defaults:
+	graphics_pipeline_config::graphics_pipeline_config()
+		: mPipelineSettings{ cfg::pipeline_settings::nothing }
+		, mDynamicRenderingAttachments {}
+		, mRenderPassSubpass {} // not set by default
+		, mPrimitiveTopology{ cfg::primitive_topology::triangles } // triangles after one another
+		, mRasterizerGeometryMode{ cfg::rasterizer_geometry_mode::rasterize_geometry } // don't discard, but rasterize!
+		, mPolygonDrawingModeAndConfig{ cfg::polygon_drawing::config_for_filling() } // Fill triangles
+		, mCullingMode{ cfg::culling_mode::cull_back_faces } // Cull back faces
+		, mDynamicRendering {cfg::dynamic_rendering::disabled }
+		, mFrontFaceWindingOrder{ cfg::front_face::define_front_faces_to_be_counter_clockwise() } // CCW == front face
+		, mDepthClampBiasConfig{ cfg::depth_clamp_bias::config_nothing_special() } // no clamp, no bias, no factors
+		, mDepthTestConfig{ cfg::depth_test::enabled() } // enable depth testing
+		, mDepthWriteConfig{ cfg::depth_write::enabled() } // enable depth writing
+		, mDepthBoundsConfig{ cfg::depth_bounds::disable() }
+		, mColorBlendingSettings{ cfg::color_blending_settings::disable_logic_operation() }
+		, mTessellationPatchControlPoints {}
 	{
-		if (!aImageAspectFlags.has_value()) {
-			const auto imageFormat = aImageView.get_image().create_info().format;
-			aImageAspectFlags = aImageView.get_image().aspect_flags();
+	}
 
-			if (is_depth_format(imageFormat)) {
-				if (has_stencil_component(imageFormat)) {
-					AVK_LOG_ERROR("Can infer whether the image view shall refer to the depth component or to the stencil component => State it explicitly by using image_view_t::create_depth or image_view_t::create_stencil");
-				}
-				aImageAspectFlags = vk::ImageAspectFlagBits::eDepth;
-				// TODO: use vk::ImageAspectFlagBits' underlying type and exclude eStencil rather than only setting eDepth!
-			}
-			else if(has_stencil_component(imageFormat)) {
-				aImageAspectFlags = vk::ImageAspectFlagBits::eStencil;
-				// TODO: use vk::ImageAspectFlagBits' underlying type and exclude eDepth rather than only setting eStencil!
-			}
+	namespace cfg
+	{
+		viewport_depth_scissors_config viewport_depth_scissors_config::from_framebuffer(const framebuffer_t& aFramebuffer)
+		{
+			const auto width = aFramebuffer.create_info().width;
+			const auto height = aFramebuffer.create_info().height;
+			return viewport_depth_scissors_config{
+				std::array<float, 2>{{ 0.0f, 0.0f }},
+				std::array<float, 2>{{ static_cast<float>(width), static_cast<float>(height)  }},
+				0.0f, 1.0f,		// TODO: make min/max depth configurable?!
+				vk::Offset2D{ 0, 0 },			// TODO: support different settings for scissor?!
+				vk::Extent2D{{ width, height }},
+				false,
+				false
+			};
 		}
+	}
+#pragma endregion
 
-		// Proceed with config creation (and use the imageAspectFlags there):
-		aImageView.mCreateInfo = vk::ImageViewCreateInfo{}
-			.setImage(aImageView.get_image().handle())
-			.setViewType(to_image_view_type(aImageView.get_image().create_info()))
-			.setFormat(aViewFormat)
-			.setComponents(vk::ComponentMapping() // The components field allows you to swizzle the color channels around. In our case we'll stick to the default mapping. [3]
-							  .setR(vk::ComponentSwizzle::eIdentity)
-							  .setG(vk::ComponentSwizzle::eIdentity)
-							  .setB(vk::ComponentSwizzle::eIdentity)
-							  .setA(vk::ComponentSwizzle::eIdentity))
-			.setSubresourceRange(vk::ImageSubresourceRange() // The subresourceRange field describes what the image's purpose is and which part of the image should be accessed. Our images will be used as color targets without any mipmapping levels or multiple layers. [3]
-				.setAspectMask(aImageAspectFlags.value())
-				.setBaseMipLevel(0u)
-				.setLevelCount(aImageView.get_image().create_info().mipLevels)
-				.setBaseArrayLayer(0u)
-				.setLayerCount(aImageView.get_image().create_info().arrayLayers));
+#pragma region graphics pipeline definitions
+	void root::rewire_config_and_create_graphics_pipeline(graphics_pipeline_t& aPreparedPipeline)
+	{
+		aPreparedPipeline.mPipelineVertexInputStateCreateInfo
+			.setPVertexBindingDescriptions(aPreparedPipeline.mOrderedVertexInputBindingDescriptions.data())
+			.setPVertexAttributeDescriptions(aPreparedPipeline.mVertexInputAttributeDescriptions.data());
 
-		if (aImageViewUsage.has_value()) {
-			auto [imageUsage, imageLayout, imageTiling, imageCreateFlags] = determine_usage_layout_tiling_flags_based_on_image_usage(aImageViewUsage.value());
-			aImageView.mUsageInfo = vk::ImageViewUsageCreateInfo()
-				.setUsage(imageUsage);
-			aImageView.mCreateInfo.setPNext(&aImageView.mUsageInfo);
-		}
+		assert(aPreparedPipeline.mShaders.size() == aPreparedPipeline.mShaderStageCreateInfos.size());
+		assert(aPreparedPipeline.mShaders.size() == aPreparedPipeline.mSpecializationInfos.size());
+		for (size_t i = 0; i < aPreparedPipeline.mShaders.size(); ++i) {
+			aPreparedPipeline.mShaderStageCreateInfos[i]
+				.setModule(aPreparedPipeline.mShaders[i].handle())
+				.setPName(aPreparedPipeline.mShaders[i].info().mEntryPoint.c_str());
 
-		// Maybe alter the config?!
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(aImageView);
+			if (aPreparedPipeline.mSpecializationInfos[i] != vk::SpecializationInfo{}) {
+				assert(aPreparedPipeline.mShaders[i].info().mSpecializationConstants.has_value());
+				aPreparedPipeline.mSpecializationInfos[i].pMapEntries = aPreparedPipeline.mShaders[i].info().mSpecializationConstants.value().mMapEntries.data();
+				aPreparedPipeline.mSpecializationInfos[i].pData = aPreparedPipeline.mShaders[i].info().mSpecializationConstants.value().mData.data();
+				aPreparedPipeline.mShaderStageCreateInfos[i].setPSpecializationInfo(&aPreparedPipeline.mSpecializationInfos[i]);
+			}
 		}
 
-		aImageView.mImageView = device().createImageViewUnique(aImageView.mCreateInfo, nullptr, dispatch_loader_core());
-	}
-#pragma endregion
+		aPreparedPipeline.mViewportStateCreateInfo
+			.setViewportCount(static_cast<uint32_t>(aPreparedPipeline.mViewports.size()))
+			.setPViewports(aPreparedPipeline.mViewports.data())
+			.setScissorCount(static_cast<uint32_t>(aPreparedPipeline.mScissors.size()))
+			.setPScissors(aPreparedPipeline.mScissors.data());
 
-#pragma region sampler and image sampler definitions
-	sampler root::create_sampler(filter_mode aFilterMode, std::array<border_handling_mode, 3> aBorderHandlingModes, float aMipMapMaxLod, std::function<void(sampler_t&)> aAlterConfigBeforeCreation)
-	{
-		vk::Filter magFilter;
-		vk::Filter minFilter;
-		vk::SamplerMipmapMode mipmapMode;
-		vk::Bool32 enableAnisotropy = VK_FALSE;
-		float maxAnisotropy = 1.0f;
-		switch (aFilterMode)
+		aPreparedPipeline.mColorBlendStateCreateInfo
+			.setAttachmentCount(static_cast<uint32_t>(aPreparedPipeline.mBlendingConfigsForColorAttachments.size()))
+			.setPAttachments(aPreparedPipeline.mBlendingConfigsForColorAttachments.data());
+
+		
+		// NOTE(msakmary) Not really sure why we set the samples again when they were previously set in root::create_graphics_pipeline
+		//                (ask for clarification) - but if dynamic rendering is enabled there is no renderpass...
+		const bool dynamicRenderingEnabled = aPreparedPipeline.mRenderingCreateInfo.has_value();
+		if(!dynamicRenderingEnabled)
 		{
-		case filter_mode::nearest_neighbor:
-			magFilter = vk::Filter::eNearest;
-			minFilter = vk::Filter::eNearest;
-			mipmapMode = vk::SamplerMipmapMode::eNearest;
-			break;
-		case filter_mode::bilinear:
-			magFilter = vk::Filter::eLinear;
-			minFilter = vk::Filter::eLinear;
-			mipmapMode = vk::SamplerMipmapMode::eNearest;
-			break;
-		case filter_mode::trilinear:
-			magFilter = vk::Filter::eLinear;
-			minFilter = vk::Filter::eLinear;
-			mipmapMode = vk::SamplerMipmapMode::eLinear;
-			break;
-		case filter_mode::cubic: // I have no idea what I'm doing.
-			magFilter = vk::Filter::eCubicIMG;
-			minFilter = vk::Filter::eCubicIMG;
-			mipmapMode = vk::SamplerMipmapMode::eLinear;
-			break;
-		case filter_mode::anisotropic_2x:
-			magFilter = vk::Filter::eLinear;
-			minFilter = vk::Filter::eLinear;
-			mipmapMode = vk::SamplerMipmapMode::eLinear;
-			enableAnisotropy = VK_TRUE;
-			maxAnisotropy = 2.0f;
-			break;
-		case filter_mode::anisotropic_4x:
-			magFilter = vk::Filter::eLinear;
-			minFilter = vk::Filter::eLinear;
-			mipmapMode = vk::SamplerMipmapMode::eLinear;
-			enableAnisotropy = VK_TRUE;
-			maxAnisotropy = 4.0f;
-			break;
-		case filter_mode::anisotropic_8x:
-			magFilter = vk::Filter::eLinear;
-			minFilter = vk::Filter::eLinear;
-			mipmapMode = vk::SamplerMipmapMode::eLinear;
-			enableAnisotropy = VK_TRUE;
-			maxAnisotropy = 8.0f;
-			break;
-		case filter_mode::anisotropic_16x:
-			magFilter = vk::Filter::eLinear;
-			minFilter = vk::Filter::eLinear;
-			mipmapMode = vk::SamplerMipmapMode::eLinear;
-			enableAnisotropy = VK_TRUE;
-			maxAnisotropy = 16.0f;
-			break;
-		case filter_mode::anisotropic_32x:
-			magFilter = vk::Filter::eLinear;
-			minFilter = vk::Filter::eLinear;
-			mipmapMode = vk::SamplerMipmapMode::eLinear;
-			enableAnisotropy = VK_TRUE;
-			maxAnisotropy = 32.0f;
-			break;
-		case filter_mode::anisotropic_64x:
-			magFilter = vk::Filter::eLinear;
-			minFilter = vk::Filter::eLinear;
-			mipmapMode = vk::SamplerMipmapMode::eLinear;
-			enableAnisotropy = VK_TRUE;
-			maxAnisotropy = 64.0f;
-			break;
-		default:
-			throw avk::runtime_error("invalid filter_mode");
+			aPreparedPipeline.mMultisampleStateCreateInfo
+				.setRasterizationSamples(
+					aPreparedPipeline.renderpass_reference().value().get().num_samples_for_subpass(aPreparedPipeline.subpass_id().value()))
+				.setPSampleMask(nullptr);
 		}
 
-		// Determine how to handle the borders:
-		std::array<vk::SamplerAddressMode, 3> addressModes{};
-		for (int i = 0; i < 3; ++i) {
-			switch (aBorderHandlingModes[i])
-			{
-			case border_handling_mode::clamp_to_edge:
-				addressModes[i] = vk::SamplerAddressMode::eClampToEdge;
-				break;
-			case border_handling_mode::mirror_clamp_to_edge:
-				addressModes[i] = vk::SamplerAddressMode::eMirrorClampToEdge;
-				break;
-			case border_handling_mode::clamp_to_border:
-				addressModes[i] = vk::SamplerAddressMode::eClampToBorder;
-				break;
-			case border_handling_mode::repeat:
-				addressModes[i] = vk::SamplerAddressMode::eRepeat;
-				break;
-			case border_handling_mode::mirrored_repeat:
-				addressModes[i] = vk::SamplerAddressMode::eMirroredRepeat;
-				break;
-			default:
-				throw avk::runtime_error("invalid border_handling_mode at index " + std::to_string(i) + (0 == i ? " (address mode u)" : 1 == i ? " (address mode v)" : " (address mode w)"));
-			}
-		}
+		aPreparedPipeline.mDynamicStateCreateInfo
+			.setDynamicStateCount(static_cast<uint32_t>(aPreparedPipeline.mDynamicStateEntries.size()))
+			.setPDynamicStates(aPreparedPipeline.mDynamicStateEntries.data());
 
-		// Compile the config for this sampler:
-		sampler_t result;
-		result.mCreateInfo = vk::SamplerCreateInfo()
-			.setMagFilter(magFilter)
-			.setMinFilter(minFilter)
-			.setAddressModeU(addressModes[0])
-			.setAddressModeV(addressModes[1])
-			.setAddressModeW(addressModes[2])
-			.setAnisotropyEnable(enableAnisotropy)
-			.setMaxAnisotropy(maxAnisotropy)
-			.setBorderColor(vk::BorderColor::eFloatOpaqueBlack)
-			// The unnormalizedCoordinates field specifies which coordinate system you want to use to address texels in an image.
-			// If this field is VK_TRUE, then you can simply use coordinates within the [0, texWidth) and [0, texHeight) range.
-			// If it is VK_FALSE, then the texels are addressed using the [0, 1) range on all axes. Real-world applications almost
-			// always use normalized coordinates, because then it's possible to use textures of varying resolutions with the exact
-			// same coordinates. [4]
-			.setUnnormalizedCoordinates(VK_FALSE)
-			// If a comparison function is enabled, then texels will first be compared to a value, and the result of that comparison
-			// is used in filtering operations. This is mainly used for percentage-closer filtering on shadow maps. [4]
-			.setCompareEnable(VK_FALSE)
-			.setCompareOp(vk::CompareOp::eAlways)
-			.setMipmapMode(mipmapMode)
-			.setMipLodBias(0.0f)
-			.setMinLod(0.0f)
-			.setMaxLod(aMipMapMaxLod);
+		// Pipeline Layout must be rewired already before calling this function
 
-		// Call custom config function
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(result);
+		// Create the PIPELINE LAYOUT
+		aPreparedPipeline.mPipelineLayout = device().createPipelineLayoutUnique(aPreparedPipeline.mPipelineLayoutCreateInfo, nullptr, dispatch_loader_core());
+		assert(static_cast<bool>(aPreparedPipeline.layout_handle()));
+
+		const void * pNext = dynamicRenderingEnabled ? &(aPreparedPipeline.mRenderingCreateInfo.value()) : nullptr;
+		VkRenderPass render_pass = VK_NULL_HANDLE;
+		if(!dynamicRenderingEnabled)
+		{
+			render_pass = (aPreparedPipeline.mRenderPass.value())->handle();
 		}
+		// Create the PIPELINE, a.k.a. putting it all together:
+		auto pipelineInfo = vk::GraphicsPipelineCreateInfo{}
+			// 0. Render Pass
+			.setPNext(pNext)
+			.setRenderPass(render_pass)
+			.setSubpass(aPreparedPipeline.mSubpassIndex)
+			// 1., 2., and 3.
+			.setPVertexInputState(&aPreparedPipeline.mPipelineVertexInputStateCreateInfo)
+			// 4.
+			.setPInputAssemblyState(&aPreparedPipeline.mInputAssemblyStateCreateInfo)
+			// 5.
+			.setStageCount(static_cast<uint32_t>(aPreparedPipeline.mShaderStageCreateInfos.size()))
+			.setPStages(aPreparedPipeline.mShaderStageCreateInfos.data())
+			// 6.
+			.setPViewportState(&aPreparedPipeline.mViewportStateCreateInfo)
+			// 7.
+			.setPRasterizationState(&aPreparedPipeline.mRasterizationStateCreateInfo)
+			// 8.
+			.setPDepthStencilState(&aPreparedPipeline.mDepthStencilConfig)
+			// 9.
+			.setPColorBlendState(&aPreparedPipeline.mColorBlendStateCreateInfo)
+			// 10.
+			.setPMultisampleState(&aPreparedPipeline.mMultisampleStateCreateInfo)
+			// 11.
+			.setPDynamicState(aPreparedPipeline.mDynamicStateEntries.size() == 0 ? nullptr : &aPreparedPipeline.mDynamicStateCreateInfo) // Optional
+			// 12.
+			.setFlags(aPreparedPipeline.mPipelineCreateFlags)
+			// LAYOUT:
+			.setLayout(aPreparedPipeline.layout_handle())
+			// Base pipeline:
+			.setBasePipelineHandle(nullptr) // Optional
+			.setBasePipelineIndex(-1); // Optional
 
-		result.mSampler = device().createSamplerUnique(result.create_info(), nullptr, dispatch_loader_core());
-		result.mDescriptorInfo = vk::DescriptorImageInfo{}
-			.setSampler(result.handle());
-		result.mDescriptorType = vk::DescriptorType::eSampler;
-		return result;
-	}
+		// 13.
+		if (aPreparedPipeline.mPipelineTessellationStateCreateInfo.has_value()) {
+			pipelineInfo.setPTessellationState(&aPreparedPipeline.mPipelineTessellationStateCreateInfo.value());
+		}
 
-	image_sampler root::create_image_sampler(image_view aImageView, sampler aSampler)
-	{
-		image_sampler_t result;
-		result.mImageView = std::move(aImageView);
-		result.mSampler = std::move(aSampler);
-		return result;
+		// TODO: Shouldn't the config be altered HERE, after the pipelineInfo has been compiled?!
+
+#if VK_HEADER_VERSION >= 141
+		auto result = device().createGraphicsPipelineUnique(nullptr, pipelineInfo, nullptr, dispatch_loader_core());
+		aPreparedPipeline.mPipeline = std::move(result.value);
+#else
+		aPreparedPipeline.mPipeline = device().createGraphicsPipelineUnique(nullptr, pipelineInfo);
+#endif
 	}
-#pragma endregion
 
-#pragma region input description definitions
-	input_description input_description::declare(std::initializer_list<input_binding_to_location_mapping> aBindings)
+	// Unfortunately C++20 does not have support to easily convert a range into a vector through chaining, so we have to
+	// either pass the ranges begin and end members to the vector constructor every time or implement a helper ourself
+	// until something similar is standardized (There is a to<Container> proposal for C++23).
+	// Using a helper struct to invoke operator| for ranges was inspired by https://stackoverflow.com/a/65635762
+	// This helper implementation converts a range into a vector by piping the range into to_vector():
+	//
+	// auto nums = std::vector{1, 2, 3, 4};
+	// auto num_strings = nums | std::ranges::transform([](auto num) { return std::to_string(num); }) | to_vector();
+	// 
+	namespace to_vector_impl
 	{
-		input_description result;
+		// Helper type to find the operator| overload below
+		struct to_vector_helper {};
 
-		for (const auto& bindingLoc : aBindings) {
-			auto& bfr = result.mInputBuffers[bindingLoc.mGeneralData.mBinding];
-			// Create if it doesn't exist
-			if (std::holds_alternative<std::monostate>(bfr)) {
-				switch (bindingLoc.mGeneralData.mKind)
-				{
-				case vertex_input_buffer_binding::kind::vertex:
-					bfr = vertex_buffer_meta::create_from_element_size(bindingLoc.mGeneralData.mStride);
-					break;
-				case vertex_input_buffer_binding::kind::instance:
-					bfr = instance_buffer_meta::create_from_element_size(bindingLoc.mGeneralData.mStride);
-					break;
-				default:
-					throw avk::runtime_error("Invalid input_binding_location_data::kind value");
-				}
+		// Operator| overload to convert a range into a vector
+		template <std::ranges::range R>
+		auto operator|(R&& r, to_vector_helper)
+		{
+			std::vector<std::ranges::range_value_t<decltype(r)>> v;
+			if constexpr (std::ranges::sized_range<decltype(r)>) {
+				v.reserve(std::ranges::size(r));
 			}
+			std::ranges::copy(r, std::back_inserter(v));
+			return v;
+		}
+	}
 
-#if defined(_DEBUG)
-			// It exists => perform some sanity checks:
-			if (std::holds_alternative<std::monostate>(bfr)
-				|| (vertex_input_buffer_binding::kind::vertex == bindingLoc.mGeneralData.mKind && std::holds_alternative<instance_buffer_meta>(bfr))
-				|| (vertex_input_buffer_binding::kind::instance == bindingLoc.mGeneralData.mKind && std::holds_alternative<vertex_buffer_meta>(bfr))
-				) {
-				throw avk::logic_error("All locations of the same binding must come from the same buffer type (vertex buffer or instance buffer).");
-			}
-#endif
-
-			if (std::holds_alternative<vertex_buffer_meta>(bfr)) {
-				std::get<vertex_buffer_meta>(bfr).describe_member(
-					bindingLoc.mMemberMetaData.mOffset,
-					bindingLoc.mMemberMetaData.mFormat);
-			}
-			else { // must be instance_buffer_meta
-				std::get<instance_buffer_meta>(bfr).describe_member(
-					bindingLoc.mMemberMetaData.mOffset,
-					bindingLoc.mMemberMetaData.mFormat);
-			}
-		}
-
-		return result;
-	}
-#pragma endregion
-
-#pragma region queue definitions
-	std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> queue::find_queue_families_for_criteria(
-		vk::PhysicalDevice aPhysicalDevice,
-		vk::QueueFlags aRequiredFlags,
-		vk::QueueFlags aForbiddenFlags,
-		std::optional<vk::SurfaceKHR> aSurface)
+	auto to_vector()
 	{
-		assert(aPhysicalDevice);
-		// All queue families:
-		auto queueFamilies = aPhysicalDevice.getQueueFamilyProperties();
-		std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> indexedQueueFamilies;
-		std::transform(std::begin(queueFamilies), std::end(queueFamilies),
-					   std::back_inserter(indexedQueueFamilies),
-					   [index = uint32_t(0)](const decltype(queueFamilies)::value_type& input) mutable {
-						   auto tpl = std::make_tuple(index, input);
-						   index += 1;
-						   return tpl;
-					   });
-		// Subset to which the criteria applies:
-		std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> selection;
-		// Select the subset
-		std::copy_if(std::begin(indexedQueueFamilies), std::end(indexedQueueFamilies),
-					 std::back_inserter(selection),
-					 [aPhysicalDevice, aRequiredFlags, aForbiddenFlags, aSurface](const std::tuple<uint32_t, decltype(queueFamilies)::value_type>& tpl) {
-						 bool requirementsMet = true;
-						 if (aRequiredFlags) {
-							 requirementsMet = requirementsMet && ((std::get<1>(tpl).queueFlags & aRequiredFlags) == aRequiredFlags);
-						 }
-						 if (aForbiddenFlags) {
-							 requirementsMet = requirementsMet && ((std::get<1>(tpl).queueFlags & aForbiddenFlags) != aForbiddenFlags);
-						 }
-						 if (aSurface) {
-							 requirementsMet = requirementsMet && (aPhysicalDevice.getSurfaceSupportKHR(std::get<0>(tpl), *aSurface));
-						 }
-						 return requirementsMet;
-					 });
-		return selection;
+		return to_vector_impl::to_vector_helper{};
 	}
 
-	std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> queue::find_best_queue_family_for(
-		vk::PhysicalDevice aPhysicalDevice,
-		vk::QueueFlags aRequiredFlags,
-		queue_selection_preference aQueueSelectionPreference,
-		std::optional<vk::SurfaceKHR> aSurface
-	)
+	graphics_pipeline root::create_graphics_pipeline(graphics_pipeline_config aConfig, std::function<void(graphics_pipeline_t&)> aAlterConfigBeforeCreation)
 	{
-		static std::array queueTypes = {
-			vk::QueueFlagBits::eGraphics,
-			vk::QueueFlagBits::eCompute,
-			vk::QueueFlagBits::eTransfer,
-		};
-		// sparse binding and protected bits are ignored, for now
-
-		std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> selection;
+		using namespace cfg;
 
-		switch (aQueueSelectionPreference) {
-		case queue_selection_preference::specialized_queue:
-			{
-				vk::QueueFlags forbiddenFlags = {};
-				for (auto f : queueTypes) { // TODO: Maybe a different loosening order would be better?
-					forbiddenFlags |= f;
-				}
-				forbiddenFlags &= ~aRequiredFlags;
+		graphics_pipeline_t result;
 
-				int32_t loosenIndex = 0;
+		// 0. Own the renderpass - if one is required
+		const bool dynamicRenderingEnabled = aConfig.mDynamicRendering == avk::cfg::dynamic_rendering::enabled;
 
-				while (loosenIndex <= queueTypes.size()) { // might result in returning an empty selection
-					selection = queue::find_queue_families_for_criteria(aPhysicalDevice, aRequiredFlags, forbiddenFlags, aSurface);
-					if (selection.size() > 0 || loosenIndex == queueTypes.size()) {
-						break;
-					}
-					forbiddenFlags = forbiddenFlags & ~queueTypes[loosenIndex++]; // gradually loosen restrictions
-				}
-			}
-			break;
-		case queue_selection_preference::versatile_queue:
+		{
+			if(!dynamicRenderingEnabled)
 			{
-				vk::QueueFlags additionalVersatileFlags = {};
-				for (auto f : queueTypes) { // TODO: Maybe a different addition order would be better?
-					additionalVersatileFlags |= f;
-				}
-
-				int32_t loosenIndex = 0;
-
-				while (loosenIndex <= queueTypes.size()) {
-					selection = queue::find_queue_families_for_criteria(aPhysicalDevice, aRequiredFlags | additionalVersatileFlags, vk::QueueFlags{}, aSurface);
-					if (selection.size() > 0 || loosenIndex == queueTypes.size()) {
-						break;
-					}
-					additionalVersatileFlags = additionalVersatileFlags & ~queueTypes[loosenIndex++]; // gradually loosen versatile-additions
-				}
+				assert(aConfig.mRenderPassSubpass.has_value());
+				auto [rp, sp] = std::move(aConfig.mRenderPassSubpass.value());
+				result.mRenderPass = std::move(rp);
+				result.mSubpassIndex = sp;
 			}
-			break;
-		}
-
-		return selection;
-	}
-
-	uint32_t queue::select_queue_family_index(
-		vk::PhysicalDevice aPhysicalDevice,
-		vk::QueueFlags aRequiredFlags,
-		queue_selection_preference aQueueSelectionPreference,
-		std::optional<vk::SurfaceKHR> aSupportForSurface
-	)
-	{
-		auto families = find_best_queue_family_for(aPhysicalDevice, aRequiredFlags, aQueueSelectionPreference, aSupportForSurface);
-		if (families.size() == 0) {
-			throw avk::runtime_error("Couldn't find queue families satisfying the given criteria.");
-		}
-
-		uint32_t familyIndex = std::get<0>(families[0]);
-		return familyIndex;
-	}
-
-	queue queue::prepare(
-		avk::root* aRoot,
-		uint32_t aQueueFamilyIndex,
-		uint32_t aQueueIndex,
-		float aQueuePriority
-	)
-	{
-		auto queueFamilies = aRoot->physical_device().getQueueFamilyProperties();
-		if (queueFamilies.size() <= aQueueFamilyIndex) {
-			throw avk::runtime_error("Invalid queue family index in queue::prepare");
-		}
-		if (queueFamilies[aQueueFamilyIndex].queueCount <= aQueueIndex) {
-			throw avk::runtime_error("Queue family #" + std::to_string(aQueueFamilyIndex) + " does not provide enough queues (requested index: " + std::to_string(aQueueIndex) + ")");
 		}
 
-		queue result;
-		result.mRoot = aRoot;
-		result.mQueueFamilyIndex = aQueueFamilyIndex;
-		result.mQueueIndex = aQueueIndex;
-		result.mPriority = aQueuePriority;
-		result.mQueue = nullptr;
-		return result;
-	}
+		// 1. Compile the array of vertex input binding descriptions
+		{
+			// Select bindings as vector:
+#if defined(_MSC_VER) && _MSC_VER < 1930
+			auto bindings = aConfig.mInputBindingLocations
+				| std::views::transform([](const auto& bindingData) { return bindingData.mGeneralData; })
+				| to_vector();
+#else 
+			std::vector<avk::vertex_input_buffer_binding> bindings;
+			for (const auto& bindingData : aConfig.mInputBindingLocations){
+				bindings.push_back(bindingData.mGeneralData);
+			}
+#endif
 
-	void queue::assign_handle()
-	{
-		mQueue = mRoot->device().getQueue(mQueueFamilyIndex, mQueueIndex);
-	}
+			// Sort bindings:
+			std::ranges::sort(bindings);
+			// Remove duplicates of both vertex and instance inputs (this will invoke operator ==(const vertex_input_buffer_binding& left, const vertex_input_buffer_binding& right):
+			auto [ret, last] = std::ranges::unique(bindings);
+			bindings.erase(ret, last);
+			result.mOrderedVertexInputBindingDescriptions.reserve(bindings.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
 
-	avk::submission_data queue::submit(avk::command_buffer_t& aCommandBuffer) const
-	{
-		return avk::submission_data(mRoot, aCommandBuffer, *this);
-	}
+			for (auto& bindingData : bindings) {
 
-	bool queue::is_prepared() const
-	{
-		return nullptr != mRoot && static_cast<bool>(mRoot->physical_device());
-	}
-#pragma endregion
+				const auto numRecordsWithSameBinding = std::count_if(std::begin(bindings), std::end(bindings),
+					[bindingId = bindingData.mBinding](const vertex_input_buffer_binding& generalData) {
+						return generalData.mBinding == bindingId;
+					});
+				if (1 != numRecordsWithSameBinding) {
+					throw avk::runtime_error("The input binding #" + std::to_string(bindingData.mBinding) + " is defined in multiple times in different ways. Make sure to define it uniformly across different bindings/attribute descriptions!");
+				}
 
-#pragma region ray tracing pipeline definitions
-#if VK_HEADER_VERSION >= 135
-	triangles_hit_group triangles_hit_group::create_with_rahit_only(shader_info aAnyHitShader)
-	{
-		if (aAnyHitShader.mShaderType != shader_type::any_hit) {
-			throw avk::runtime_error("Shader is not of type shader_type::any_hit");
+				result.mOrderedVertexInputBindingDescriptions.push_back(vk::VertexInputBindingDescription{}
+					// The following parameters are guaranteed to be the same. We have checked this.
+					.setBinding(bindingData.mBinding)
+					.setStride(static_cast<uint32_t>(bindingData.mStride))
+					.setInputRate(to_vk_vertex_input_rate(bindingData.mKind))
+					// We don't need the location here
+				);
+			}
 		}
-		return triangles_hit_group { std::move(aAnyHitShader), std::nullopt };
-	}
 
-	triangles_hit_group triangles_hit_group::create_with_rchit_only(shader_info aClosestHitShader)
-	{
-		if (aClosestHitShader.mShaderType != shader_type::closest_hit) {
-			throw avk::runtime_error("Shader is not of type shader_type::closest_hit");
+		// 2. Compile the array of vertex input attribute descriptions
+		//  They will reference the bindings created in step 1.
+		result.mVertexInputAttributeDescriptions.reserve(aConfig.mInputBindingLocations.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
+		for (auto& attribData : aConfig.mInputBindingLocations) {
+			result.mVertexInputAttributeDescriptions.push_back(vk::VertexInputAttributeDescription{}
+				.setBinding(attribData.mGeneralData.mBinding)
+				.setLocation(attribData.mLocation)
+				.setFormat(attribData.mMemberMetaData.mFormat)
+				.setOffset(static_cast<uint32_t>(attribData.mMemberMetaData.mOffset))
+			);
 		}
-		return triangles_hit_group { std::nullopt, std::move(aClosestHitShader) };
-	}
 
-	triangles_hit_group triangles_hit_group::create_with_rahit_and_rchit(shader_info aAnyHitShader, shader_info aClosestHitShader)
-	{
-		if (aAnyHitShader.mShaderType != shader_type::any_hit) {
-			throw avk::runtime_error("Shader is not of type shader_type::any_hit");
-		}
-		if (aClosestHitShader.mShaderType != shader_type::closest_hit) {
-			throw avk::runtime_error("Shader is not of type shader_type::closest_hit");
-		}
-		return triangles_hit_group { std::move(aAnyHitShader), std::move(aClosestHitShader) };
-	}
+		// 3. With the data from 1. and 2., create the complete vertex input info struct, passed to the pipeline creation
+		result.mPipelineVertexInputStateCreateInfo = vk::PipelineVertexInputStateCreateInfo()
+			.setVertexBindingDescriptionCount(static_cast<uint32_t>(result.mOrderedVertexInputBindingDescriptions.size()))
+			.setPVertexBindingDescriptions(result.mOrderedVertexInputBindingDescriptions.data())
+			.setVertexAttributeDescriptionCount(static_cast<uint32_t>(result.mVertexInputAttributeDescriptions.size()))
+			.setPVertexAttributeDescriptions(result.mVertexInputAttributeDescriptions.data());
 
-	triangles_hit_group triangles_hit_group::create_with_rahit_only(std::string aAnyHitShaderPath)
-	{
-		return create_with_rahit_only(
-			shader_info::describe(std::move(aAnyHitShaderPath), "main", false, shader_type::any_hit)
-		);
-	}
-
-	triangles_hit_group triangles_hit_group::create_with_rchit_only(std::string aClosestHitShaderPath)
-	{
-		return create_with_rchit_only(
-			shader_info::describe(std::move(aClosestHitShaderPath), "main", false, shader_type::closest_hit)
-		);
-	}
-
-	triangles_hit_group triangles_hit_group::create_with_rahit_and_rchit(std::string aAnyHitShaderPath, std::string aClosestHitShaderPath)
-	{
-		return create_with_rahit_and_rchit(
-			shader_info::describe(std::move(aAnyHitShaderPath), "main", false, shader_type::any_hit),
-			shader_info::describe(std::move(aClosestHitShaderPath), "main", false, shader_type::closest_hit)
-		);
-	}
-
-
-	procedural_hit_group procedural_hit_group::create_with_rint_only(shader_info aIntersectionShader)
-	{
-		if (aIntersectionShader.mShaderType != shader_type::intersection) {
-			throw avk::runtime_error("Shader is not of type shader_type::intersection");
-		}
-		return procedural_hit_group { std::move(aIntersectionShader), std::nullopt, std::nullopt };
-	}
-
-	procedural_hit_group procedural_hit_group::create_with_rint_and_rahit(shader_info aIntersectionShader, shader_info aAnyHitShader)
-	{
-		if (aIntersectionShader.mShaderType != shader_type::intersection) {
-			throw avk::runtime_error("Shader is not of type shader_type::intersection");
-		}
-		if (aAnyHitShader.mShaderType != shader_type::any_hit) {
-			throw avk::runtime_error("Shader is not of type shader_type::any_hit");
-		}
-		return procedural_hit_group { std::move(aIntersectionShader), std::move(aAnyHitShader), std::nullopt };
-	}
+		// 4. Set how the data (from steps 1.-3.) is to be interpreted (e.g. triangles, points, lists, patches, etc.)
+		result.mInputAssemblyStateCreateInfo = vk::PipelineInputAssemblyStateCreateInfo()
+			.setTopology(to_vk_primitive_topology(aConfig.mPrimitiveTopology))
+			.setPrimitiveRestartEnable(VK_FALSE);
 
-	procedural_hit_group procedural_hit_group::create_with_rint_and_rchit(shader_info aIntersectionShader, shader_info aClosestHitShader)
-	{
-		if (aIntersectionShader.mShaderType != shader_type::intersection) {
-			throw avk::runtime_error("Shader is not of type shader_type::intersection");
-		}
-		if (aClosestHitShader.mShaderType != shader_type::closest_hit) {
-			throw avk::runtime_error("Shader is not of type shader_type::closest_hit");
+		// 5. Compile and store the shaders:
+		result.mShaders.reserve(aConfig.mShaderInfos.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
+		result.mShaderStageCreateInfos.reserve(aConfig.mShaderInfos.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
+		result.mSpecializationInfos.reserve(aConfig.mShaderInfos.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
+		for (auto& shaderInfo : aConfig.mShaderInfos) {
+			// 5.0 Sanity check
+			if (result.mShaders.end() != std::find_if(std::begin(result.mShaders), std::end(result.mShaders), [&shaderInfo](const shader& existing) { return existing.info().mShaderType == shaderInfo.mShaderType; })) {
+				throw avk::runtime_error("There's already a " + vk::to_string(to_vk_shader_stages(shaderInfo.mShaderType)) + "-type shader contained in this graphics pipeline. Can not add another one of the same type.");
+			}
+			// 5.1 Compile the shader
+			result.mShaders.push_back(create_shader(shaderInfo));
+			assert(result.mShaders.back().has_been_built());
+			// 5.2 Combine
+			auto& stageCreateInfo = result.mShaderStageCreateInfos.emplace_back()
+				.setStage(to_vk_shader_stage(result.mShaders.back().info().mShaderType))
+				.setModule(result.mShaders.back().handle())
+				.setPName(result.mShaders.back().info().mEntryPoint.c_str());
+			if (shaderInfo.mSpecializationConstants.has_value()) {
+				auto& specInfo = result.mSpecializationInfos.emplace_back(
+					shaderInfo.mSpecializationConstants.value().num_entries(),
+					shaderInfo.mSpecializationConstants.value().mMapEntries.data(),
+					shaderInfo.mSpecializationConstants.value().data_size(),
+					shaderInfo.mSpecializationConstants.value().mData.data()
+				);
+				// Add it to the stageCreateInfo:
+				stageCreateInfo.setPSpecializationInfo(&specInfo);
+			}
+			else {
+				result.mSpecializationInfos.emplace_back(); // Just to keep the indices into the vectors in sync!
+			}
 		}
-		return procedural_hit_group { std::move(aIntersectionShader), std::nullopt, std::move(aClosestHitShader) };
-	}
 
-	procedural_hit_group procedural_hit_group::create_with_rint_and_rahit_and_rchit(shader_info aIntersectionShader, shader_info aAnyHitShader, shader_info aClosestHitShader)
-	{
-		if (aIntersectionShader.mShaderType != shader_type::intersection) {
-			throw avk::runtime_error("Shader is not of type shader_type::intersection");
-		}
-		if (aAnyHitShader.mShaderType != shader_type::any_hit) {
-			throw avk::runtime_error("Shader is not of type shader_type::any_hit");
-		}
-		if (aClosestHitShader.mShaderType != shader_type::closest_hit) {
-			throw avk::runtime_error("Shader is not of type shader_type::closest_hit");
+		// 6. Viewport configuration
+		{
+			// 6.1 Viewport and depth configuration(s):
+			result.mViewports.reserve(aConfig.mViewportDepthConfig.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
+			result.mScissors.reserve(aConfig.mViewportDepthConfig.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
+			for (auto& vp : aConfig.mViewportDepthConfig) {
+				result.mViewports.push_back(vk::Viewport{}
+					.setX(vp.x())
+					.setY(vp.y())
+					.setWidth(vp.width())
+					.setHeight(vp.height())
+					.setMinDepth(vp.min_depth())
+					.setMaxDepth(vp.max_depth())
+				);
+				// 6.2 Skip scissors for now
+				// TODO: Implement scissors support properly
+				result.mScissors.push_back(vk::Rect2D{}
+					.setOffset({static_cast<int32_t>(vp.x()), static_cast<int32_t>(vp.y())})
+					.setExtent({static_cast<uint32_t>(vp.width()), static_cast<uint32_t>(vp.height())})
+				);
+			}
+			// 6.3 Add everything together
+			result.mViewportStateCreateInfo = vk::PipelineViewportStateCreateInfo{}
+				.setViewportCount(static_cast<uint32_t>(result.mViewports.size()))
+				.setPViewports(result.mViewports.data())
+				.setScissorCount(static_cast<uint32_t>(result.mScissors.size()))
+				.setPScissors(result.mScissors.data());
 		}
-		return procedural_hit_group { std::move(aIntersectionShader), std::move(aAnyHitShader), std::move(aClosestHitShader) };
-	}
-
-	procedural_hit_group procedural_hit_group::create_with_rint_only(std::string aIntersectionShader)
-	{
-		return create_with_rint_only(
-			shader_info::describe(std::move(aIntersectionShader), "main", false, shader_type::intersection)
-		);
-	}
-
-	procedural_hit_group procedural_hit_group::create_with_rint_and_rahit(std::string aIntersectionShader, std::string aAnyHitShader)
-	{
-		return create_with_rint_and_rahit(
-			shader_info::describe(std::move(aIntersectionShader), "main", false, shader_type::intersection),
-			shader_info::describe(std::move(aAnyHitShader), "main", false, shader_type::any_hit)
-		);
-	}
-
-	procedural_hit_group procedural_hit_group::create_with_rint_and_rchit(std::string aIntersectionShader, std::string aClosestHitShader)
-	{
-		return create_with_rint_and_rchit(
-			shader_info::describe(std::move(aIntersectionShader), "main", false, shader_type::intersection),
-			shader_info::describe(std::move(aClosestHitShader), "main", false, shader_type::closest_hit)
-		);
-	}
-
-	procedural_hit_group procedural_hit_group::create_with_rint_and_rahit_and_rchit(std::string aIntersectionShader, std::string aAnyHitShader, std::string aClosestHitShader)
-	{
-		return create_with_rint_and_rahit_and_rchit(
-			shader_info::describe(std::move(aIntersectionShader), "main", false, shader_type::intersection),
-			shader_info::describe(std::move(aAnyHitShader), "main", false, shader_type::any_hit),
-			shader_info::describe(std::move(aClosestHitShader), "main", false, shader_type::closest_hit)
-		);
-	}
-
-
-	max_recursion_depth max_recursion_depth::disable_recursion()
-	{
-		return max_recursion_depth { 0u };
-	}
 
-	max_recursion_depth max_recursion_depth::set_to(uint32_t aValue)
-	{
-		return max_recursion_depth { aValue };
-	}
+		// 7. Rasterization state
+		result.mRasterizationStateCreateInfo =  vk::PipelineRasterizationStateCreateInfo{}
+			// Various, but important settings:
+			.setRasterizerDiscardEnable(to_vk_bool(aConfig.mRasterizerGeometryMode == rasterizer_geometry_mode::discard_geometry))
+			.setPolygonMode(to_vk_polygon_mode(aConfig.mPolygonDrawingModeAndConfig.drawing_mode()))
+			.setLineWidth(aConfig.mPolygonDrawingModeAndConfig.line_width())
+			.setCullMode(to_vk_cull_mode(aConfig.mCullingMode))
+			.setFrontFace(to_vk_front_face(aConfig.mFrontFaceWindingOrder.winding_order_of_front_faces()))
+			// Depth-related settings:
+			.setDepthClampEnable(to_vk_bool(aConfig.mDepthClampBiasConfig.is_clamp_to_frustum_enabled()))
+			.setDepthBiasEnable(to_vk_bool(aConfig.mDepthClampBiasConfig.is_depth_bias_enabled()))
+			.setDepthBiasConstantFactor(aConfig.mDepthClampBiasConfig.bias_constant_factor())
+			.setDepthBiasClamp(aConfig.mDepthClampBiasConfig.bias_clamp_value())
+			.setDepthBiasSlopeFactor(aConfig.mDepthClampBiasConfig.bias_slope_factor());
 
+		// 8. Depth-stencil config
+		result.mDepthStencilConfig = vk::PipelineDepthStencilStateCreateInfo{}
+			.setDepthTestEnable(to_vk_bool(aConfig.mDepthTestConfig.is_enabled()))
+			.setDepthCompareOp(to_vk_compare_op(aConfig.mDepthTestConfig.depth_compare_operation()))
+			.setDepthWriteEnable(to_vk_bool(aConfig.mDepthWriteConfig.is_enabled()))
+			.setDepthBoundsTestEnable(to_vk_bool(aConfig.mDepthBoundsConfig.is_enabled()))
+			.setMinDepthBounds(aConfig.mDepthBoundsConfig.min_bounds())
+			.setMaxDepthBounds(aConfig.mDepthBoundsConfig.max_bounds())
+			.setStencilTestEnable(VK_FALSE);
 
-	ray_tracing_pipeline_config::ray_tracing_pipeline_config()
-		: mPipelineSettings{ cfg::pipeline_settings::nothing }
-		, mShaderTableConfig{ }
-		, mMaxRecursionDepth{ 16u } // 16 ... why not?!
-	{
-	}
+		// TODO: Add better support for stencil testing (better abstraction!)
+		if (aConfig.mStencilTest.has_value() && aConfig.mStencilTest.value().mEnabled) {
+			result.mDepthStencilConfig
+				.setStencilTestEnable(VK_TRUE)
+				.setFront(aConfig.mStencilTest.value().mFrontStencilTestActions)
+				.setBack(aConfig.mStencilTest.value().mBackStencilTestActions);
+		}
 
-	max_recursion_depth root::get_max_ray_tracing_recursion_depth()
-	{
-#if VK_HEADER_VERSION >= 162
-		vk::PhysicalDeviceRayTracingPipelinePropertiesKHR rtProps;
-#else
-		vk::PhysicalDeviceRayTracingPropertiesKHR rtProps;
-#endif
-		vk::PhysicalDeviceProperties2 props2;
-		props2.pNext = &rtProps;
-		physical_device().getProperties2(&props2);
-		return max_recursion_depth{
-#if VK_HEADER_VERSION >= 162
-			rtProps.maxRayRecursionDepth
-#else
-			rtProps.maxRecursionDepth
+		// 9. Color Blending
+		{
+			// Do we have an "universal" color blending config? That means, one that is not assigned to a specific color target attachment id.
+#if defined(_MSC_VER) && _MSC_VER < 1930
+			auto universalConfig = aConfig.mColorBlendingPerAttachment
+				| std::views::filter([](const color_blending_config& config) { return !config.mTargetAttachment.has_value(); })
+				| to_vector();
+#else 
+			std::vector<cfg::color_blending_config> universalConfig;
+			for (const color_blending_config& config : aConfig.mColorBlendingPerAttachment) {
+				if (!config.mTargetAttachment.has_value()) {
+					universalConfig.push_back(config);
+				}
+			}
 #endif
-		};
-	}
-
-	void root::rewire_config_and_create_ray_tracing_pipeline(ray_tracing_pipeline_t& aPreparedPipeline)
-	{
-		assert(aPreparedPipeline.mShaders.size() == aPreparedPipeline.mShaderStageCreateInfos.size());
-		assert(aPreparedPipeline.mShaders.size() == aPreparedPipeline.mSpecializationInfos.size());
-		for (size_t i = 0; i < aPreparedPipeline.mShaders.size(); ++i) {
-			aPreparedPipeline.mShaderStageCreateInfos[i]
-				.setModule(aPreparedPipeline.mShaders[i].handle())
-				.setPName(aPreparedPipeline.mShaders[i].info().mEntryPoint.c_str());
 
-			if (aPreparedPipeline.mSpecializationInfos[i] != vk::SpecializationInfo{}) {
-				assert(aPreparedPipeline.mShaders[i].info().mSpecializationConstants.has_value());
-				aPreparedPipeline.mSpecializationInfos[i].pMapEntries = aPreparedPipeline.mShaders[i].info().mSpecializationConstants.value().mMapEntries.data();
-				aPreparedPipeline.mSpecializationInfos[i].pData = aPreparedPipeline.mShaders[i].info().mSpecializationConstants.value().mData.data();
-				aPreparedPipeline.mShaderStageCreateInfos[i].setPSpecializationInfo(&aPreparedPipeline.mSpecializationInfos[i]);
+			if (universalConfig.size() > 1) {
+				throw avk::runtime_error("Ambiguous 'universal' color blending configurations. Either provide only one 'universal' "
+					"config (which is not attached to a specific color target) or assign them to specific color target attachment ids.");
 			}
-		}
 
-		// Pipeline Layout must be rewired already before calling this function
-
-		aPreparedPipeline.mPipelineLayout = device().createPipelineLayoutUnique(aPreparedPipeline.mPipelineLayoutCreateInfo, nullptr, dispatch_loader_core());
-		assert(aPreparedPipeline.layout_handle());
-
-
-		// Create the PIPELINE LAYOUT
-		aPreparedPipeline.mPipelineLayout = device().createPipelineLayoutUnique(aPreparedPipeline.mPipelineLayoutCreateInfo, nullptr, dispatch_loader_core());
-		assert(static_cast<bool>(aPreparedPipeline.layout_handle()));
-
-		auto pipelineCreateInfo = vk::RayTracingPipelineCreateInfoKHR{}
-			.setFlags(vk::PipelineCreateFlagBits{}) // TODO: Support flags
-			.setStageCount(static_cast<uint32_t>(aPreparedPipeline.mShaderStageCreateInfos.size()))
-			.setPStages(aPreparedPipeline.mShaderStageCreateInfos.data())
-			.setGroupCount(static_cast<uint32_t>(aPreparedPipeline.mShaderGroupCreateInfos.size()))
-			.setPGroups(aPreparedPipeline.mShaderGroupCreateInfos.data())
-			.setPLibraryInterface(nullptr)
-#if VK_HEADER_VERSION >= 162
-			.setMaxPipelineRayRecursionDepth(aPreparedPipeline.mMaxRecursionDepth)
-#else
-			.setMaxRecursionDepth(aPreparedPipeline.mMaxRecursionDepth)
-#endif
-			.setLayout(aPreparedPipeline.layout_handle());
-		
-#if VK_HEADER_VERSION >= 162
-		auto pipeCreationResult = device().createRayTracingPipelineKHRUnique(
-			{}, {},
-			pipelineCreateInfo,
-			nullptr,
-			dispatch_loader_ext());
-#else
-		auto pipeCreationResult = device().createRayTracingPipelineKHRUnique(
-			nullptr,
-			pipelineCreateInfo,
-			nullptr,
-			dispatch_loader_ext());
-#endif
-
-		aPreparedPipeline.mPipeline = std::move(pipeCreationResult.value);
-	}
-
-	void root::build_shader_binding_table(ray_tracing_pipeline_t& aPipeline)
-	{
-		// According to https://nvpro-samples.github.io/vk_raytracing_tutorial_KHR/#shaderbindingtable this is the way:
-		const uint32_t groupCount = static_cast<uint32_t>(aPipeline.mShaderGroupCreateInfos.size());
-		const size_t shaderBindingTableSize = aPipeline.mShaderBindingTableGroupsInfo.mTotalSize;
+			// Iterate over all color target attachments and set a color blending config 
+			size_t blendingConfigNum;
+			if (!dynamicRenderingEnabled)
+			{
+				const auto & renderPassVal = result.mRenderPass.value();
+				if (result.subpass_id() >= renderPassVal->attachment_descriptions().size()) {
+					throw avk::runtime_error(
+						"There are fewer subpasses in the renderpass ("
+						+ std::to_string(renderPassVal->attachment_descriptions().size()) +
+						") than the subpass index ("
+						+ std::to_string(result.subpass_id().value()) +
+						") indicates. I.e. the subpass index is out of bounds.");
+				}
+				blendingConfigNum = renderPassVal->color_attachments_for_subpass(result.subpass_id().value()).size(); /////////////////// TODO: (doublecheck or) FIX this section (after renderpass refactoring)
+			} 
+			// Renderpasses and Subpasses are not supported when dynamic rendering is enabled
+			// Instead we read size of the dynamic_rendering_attachments provided
+			else 
+			{
+				blendingConfigNum = 0;
 
-		// TODO: All of this SBT-stuff probably needs some refactoring
-		aPipeline.mShaderBindingTable = create_buffer(
-			AVK_STAGING_BUFFER_MEMORY_USAGE, // TODO: This should be a device buffer, right?!
-#if VK_HEADER_VERSION >= 162
-			vk::BufferUsageFlagBits::eShaderBindingTableKHR | vk::BufferUsageFlagBits::eShaderDeviceAddressKHR, // TODO: eShaderDeviceAddressKHR or eShaderDeviceAddress?
-																												// TODO: Make meta data for it!
-#else
-			vk::BufferUsageFlagBits::eRayTracingKHR,
+				for(const auto & dynRenderingAttachment : aConfig.mDynamicRenderingAttachments.value())
+				{
+					if(dynRenderingAttachment.mSubpassUsages.contains_color())
+					{
+						blendingConfigNum++;
+					}
+				}
+			}
+			result.mBlendingConfigsForColorAttachments.reserve(blendingConfigNum); // Important! Otherwise the vector might realloc and .data() will become invalid!
+			for (size_t i = 0; i < blendingConfigNum; ++i) {
+				// Do we have a specific blending config for color attachment i?
+#if defined(_MSC_VER) && _MSC_VER < 1930
+				auto configForI = aConfig.mColorBlendingPerAttachment
+					| std::views::filter([i](const color_blending_config& config) { return config.mTargetAttachment.has_value() && config.mTargetAttachment.value() == i; })
+					| to_vector();
+#else 
+				std::vector<cfg::color_blending_config> configForI;
+				for (const color_blending_config& config : aConfig.mColorBlendingPerAttachment) {
+					if (config.mTargetAttachment.has_value() && config.mTargetAttachment.value() == i) {
+						configForI.push_back(config);
+					}
+				}
 #endif
-			generic_buffer_meta::create_from_size(shaderBindingTableSize)
-		);
+				if (configForI.size() > 1) {
+					throw avk::runtime_error("Ambiguous color blending configuration for color attachment at index #" + std::to_string(i) + ". Provide only one config per color attachment!");
+				}
+				// Determine which color blending to use for this attachment:
+				color_blending_config toUse = configForI.size() == 1
+												? configForI[0]
+												: universalConfig.size() == 1
+													? universalConfig[0]
+													: color_blending_config::disable();
+				result.mBlendingConfigsForColorAttachments.push_back(vk::PipelineColorBlendAttachmentState()
+					.setColorWriteMask(to_vk_color_components(toUse.affected_color_channels()))
+					.setBlendEnable(to_vk_bool(toUse.is_blending_enabled())) // If blendEnable is set to VK_FALSE, then the new color from the fragment shader is passed through unmodified. [4]
+					.setSrcColorBlendFactor(to_vk_blend_factor(toUse.color_source_factor()))
+					.setDstColorBlendFactor(to_vk_blend_factor(toUse.color_destination_factor()))
+					.setColorBlendOp(to_vk_blend_operation(toUse.color_operation()))
+					.setSrcAlphaBlendFactor(to_vk_blend_factor(toUse.alpha_source_factor()))
+					.setDstAlphaBlendFactor(to_vk_blend_factor(toUse.alpha_destination_factor()))
+					.setAlphaBlendOp(to_vk_blend_operation(toUse.alpha_operation()))
+				);
+			}
 
-		assert(aPipeline.mShaderBindingTable->meta_at_index<buffer_meta>(0).total_size() == shaderBindingTableSize);
+			// General blending settings and reference to the array of color attachment blending configs
+			result.mColorBlendStateCreateInfo = vk::PipelineColorBlendStateCreateInfo()
+				.setLogicOpEnable(to_vk_bool(aConfig.mColorBlendingSettings.is_logic_operation_enabled())) // If you want to use the second method of blending (bitwise combination), then you should set logicOpEnable to VK_TRUE. The bitwise operation can then be specified in the logicOp field. [4]
+				.setLogicOp(to_vk_logic_operation(aConfig.mColorBlendingSettings.logic_operation()))
+				.setAttachmentCount(static_cast<uint32_t>(result.mBlendingConfigsForColorAttachments.size()))
+				.setPAttachments(result.mBlendingConfigsForColorAttachments.data())
+				.setBlendConstants(aConfig.mColorBlendingSettings.blend_constants());
+		}
 
-		// Copy to temporary buffer:
-		std::vector<uint8_t> shaderHandleStorage(shaderBindingTableSize); // The order MUST be the same as during step 3, we just need to ensure to align the TARGET offsets properly (see below)
-		auto result = device().getRayTracingShaderGroupHandlesKHR(aPipeline.handle(), 0, groupCount, shaderBindingTableSize, shaderHandleStorage.data(), dispatch_loader_ext());
-		assert(static_cast<VkResult>(result) >= 0);
+		// 10. Multisample state
+		// TODO: Can the settings be inferred from the renderpass' color attachments (as they are right now)? If they can't, how to handle this situation?
+		{ /////////////////// TODO: FIX this section (after renderpass refactoring)
+			vk::SampleCountFlagBits numSamples = vk::SampleCountFlagBits::e1;
+			if(!dynamicRenderingEnabled)
+			{
+				numSamples = result.mRenderPass.value()->num_samples_for_subpass(result.subpass_id().value());
+			} else {
+				for(const auto & attachment : aConfig.mDynamicRenderingAttachments.value())
+				{
+					if(attachment.is_multisampled())
+					{
+						if(numSamples != vk::SampleCountFlagBits::e1 && numSamples != attachment.sample_count())
+						{
+							//NOTE(msakmary) This may be possible with some extension I'm not 100% sure...
+							throw avk::runtime_error("Cannot have different sample counts for attachments in the same renderpass");
+						}
+						numSamples = attachment.sample_count();
+					}
+				}
+			}
+			
+			// Evaluate and set the PER SAMPLE shading configuration:
+			auto perSample = aConfig.mPerSampleShading.value_or(per_sample_shading_config{ false, 1.0f });
 
-		auto mapped = scoped_mapping{aPipeline.mShaderBindingTable->mBuffer, mapping_access::write};
-		// Transfer all the groups into the buffer's memory, taking all the offsets determined in step 3 into account:
-		vk::DeviceSize off = 0;
-		size_t iRaygen = 0;
-		size_t iMiss = 0;
-		size_t iHit = 0;
-		size_t iCallable = 0;
-		auto* pData  = reinterpret_cast<uint8_t*>(mapped.get());
-		size_t srcByteOffset = 0;
-		while (off < aPipeline.mShaderBindingTableGroupsInfo.mEndOffset) {
-			size_t dstOffset = 0;
-			size_t copySize = 0;
+			result.mMultisampleStateCreateInfo = vk::PipelineMultisampleStateCreateInfo()
+				.setRasterizationSamples(numSamples)
+				.setSampleShadingEnable(perSample.mPerSampleShadingEnabled ? VK_TRUE : VK_FALSE) // enable/disable Sample Shading
+				.setMinSampleShading(perSample.mMinFractionOfSamplesShaded) // specifies a minimum fraction of sample shading if sampleShadingEnable is set to VK_TRUE.
+				.setPSampleMask(nullptr) // If pSampleMask is NULL, it is treated as if the mask has all bits enabled, i.e. no coverage is removed from fragments. See https://www.khronos.org/registry/vulkan/specs/1.2-extensions/html/vkspec.html#fragops-samplemask
+				.setAlphaToCoverageEnable(VK_FALSE) // controls whether a temporary coverage value is generated based on the alpha component of the fragment's first color output as specified in the Multisample Coverage section.
+				.setAlphaToOneEnable(VK_FALSE); // controls whether the alpha component of the fragment's first color output is replaced with one as described in Multisample Coverage.
+			// TODO: That is probably not enough for every case. Further customization options should be added!
+		}
 
-			if (iRaygen   < aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo.size() && aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mOffset == off) {
-				dstOffset = aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mByteOffset;
-				off      += aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mNumEntries;
-				copySize  = aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mNumEntries * aPipeline.mShaderGroupHandleSize;
-				++iRaygen;
+		// 11. Dynamic state
+		{
+			// Don't need to pre-alloc the storage for this one
+
+			// Check for viewport dynamic state
+			for (const auto& vpdc : aConfig.mViewportDepthConfig) {
+				if (vpdc.is_dynamic_viewport_enabled())	{
+					result.mDynamicStateEntries.push_back(vk::DynamicState::eViewport);
+				}
 			}
-			else if (iMiss < aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo.size() && aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mOffset == off) {
-				dstOffset  = aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mByteOffset;
-				off       += aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mNumEntries;
-				copySize   = aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mNumEntries * aPipeline.mShaderGroupHandleSize;
-				++iMiss;
+			// Check for scissor dynamic state
+			for (const auto& vpdc : aConfig.mViewportDepthConfig) {
+				if (vpdc.is_dynamic_scissor_enabled())	{
+					result.mDynamicStateEntries.push_back(vk::DynamicState::eScissor);
+				}
 			}
-			else if (iHit < aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo.size() && aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mOffset == off) {
-				dstOffset = aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mByteOffset;
-				off      += aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mNumEntries;
-				copySize  = aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mNumEntries * aPipeline.mShaderGroupHandleSize;
-				++iHit;
+			// Check for dynamic line width
+			if (aConfig.mPolygonDrawingModeAndConfig.dynamic_line_width()) {
+				result.mDynamicStateEntries.push_back(vk::DynamicState::eLineWidth);
 			}
-			else if (iCallable < aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo.size() && aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mOffset == off) {
-				dstOffset = aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mByteOffset;
-				off      += aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mNumEntries;
-				copySize  = aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mNumEntries * aPipeline.mShaderGroupHandleSize;
-				++iCallable;
+			// Check for dynamic depth bias
+			if (aConfig.mDepthClampBiasConfig.is_dynamic_depth_bias_enabled()) {
+				result.mDynamicStateEntries.push_back(vk::DynamicState::eDepthBias);
 			}
-			else {
-				throw avk::runtime_error("Can't be");
+			// Check for dynamic depth bounds
+			if (aConfig.mDepthBoundsConfig.is_dynamic_depth_bounds_enabled()) {
+				result.mDynamicStateEntries.push_back(vk::DynamicState::eDepthBounds);
+			}
+			// Check for dynamic stencil values // TODO: make them configurable separately
+			if (aConfig.mStencilTest.has_value() && aConfig.mStencilTest.value().is_dynamic_enabled()) {
+				result.mDynamicStateEntries.push_back(vk::DynamicState::eStencilCompareMask);
+				result.mDynamicStateEntries.push_back(vk::DynamicState::eStencilReference);
+				result.mDynamicStateEntries.push_back(vk::DynamicState::eStencilWriteMask);
 			}
+			// TODO: Support further dynamic states
 
-			memcpy(pData + dstOffset, shaderHandleStorage.data() + srcByteOffset, copySize);
-			srcByteOffset += copySize;
+			result.mDynamicStateCreateInfo = vk::PipelineDynamicStateCreateInfo{}
+				.setDynamicStateCount(static_cast<uint32_t>(result.mDynamicStateEntries.size()))
+				.setPDynamicStates(result.mDynamicStateEntries.data());
 		}
-		//for(uint32_t g = 0; g < groupCount; g++)
-		//{
-		//}
-	}
-
-	ray_tracing_pipeline root::create_ray_tracing_pipeline(ray_tracing_pipeline_config aConfig, std::function<void(ray_tracing_pipeline_t&)> aAlterConfigBeforeCreation)
-	{
-		using namespace cfg;
-
-		ray_tracing_pipeline_t result;
-		result.mRoot = this;
 
-		// 1. Set pipeline flags
-		result.mPipelineCreateFlags = {};
+		// 12. Flags
 		// TODO: Support all flags (only one of the flags is handled at the moment)
+		result.mPipelineCreateFlags = {};
 		if ((aConfig.mPipelineSettings & pipeline_settings::disable_optimization) == pipeline_settings::disable_optimization) {
 			result.mPipelineCreateFlags |= vk::PipelineCreateFlagBits::eDisableOptimization;
 		}
 
-		// Get the offsets. We'll really need them in step 10. but already in step 3., we are gathering the correct byte offsets:
-		{
-#if VK_HEADER_VERSION >= 162
-			vk::PhysicalDeviceRayTracingPipelinePropertiesKHR rtProps;
-#else
-			vk::PhysicalDeviceRayTracingPropertiesKHR rtProps;
-#endif
-			vk::PhysicalDeviceProperties2 props2;
-			props2.pNext = &rtProps;
-			physical_device().getProperties2(&props2);
-
-			result.mShaderGroupBaseAlignment = static_cast<uint32_t>(rtProps.shaderGroupBaseAlignment);
-			result.mShaderGroupHandleAlignment = static_cast<uint32_t>(rtProps.shaderGroupHandleAlignment);
-			result.mShaderGroupHandleSize = static_cast<uint32_t>(rtProps.shaderGroupHandleSize);
+		// 13. Patch Control Points for Tessellation
+		if (aConfig.mTessellationPatchControlPoints.has_value()) {
+			result.mPipelineTessellationStateCreateInfo = vk::PipelineTessellationStateCreateInfo{}
+				.setPatchControlPoints(aConfig.mTessellationPatchControlPoints.value().mPatchControlPoints);
 		}
 
-		// 2. Gather and build shaders
-		// First of all, gather unique shaders and build them
-		std::vector<shader_info> orderedUniqueShaderInfos;
-		for (auto& tableEntry : aConfig.mShaderTableConfig.mShaderTableEntries) {
-			if (std::holds_alternative<shader_info>(tableEntry)) {
-				add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, std::get<shader_info>(tableEntry));
-			}
-			else if (std::holds_alternative<triangles_hit_group>(tableEntry)) {
-				const auto& hitGroup = std::get<triangles_hit_group>(tableEntry);
-				if (hitGroup.mAnyHitShader.has_value()) {
-					add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mAnyHitShader.value());
-				}
-				if (hitGroup.mClosestHitShader.has_value()) {
-					add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mClosestHitShader.value());
-				}
-			}
-			else if (std::holds_alternative<procedural_hit_group>(tableEntry)) {
-				const auto& hitGroup = std::get<procedural_hit_group>(tableEntry);
-				add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mIntersectionShader);
-				if (hitGroup.mAnyHitShader.has_value()) {
-					add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mAnyHitShader.value());
-				}
-				if (hitGroup.mClosestHitShader.has_value()) {
-					add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mClosestHitShader.value());
-				}
-			}
-			else {
-				throw avk::runtime_error("tableEntry holds an unknown alternative. That's mysterious.");
-			}
-		}
-		result.mShaders.reserve(orderedUniqueShaderInfos.size());
-		result.mShaderStageCreateInfos.reserve(orderedUniqueShaderInfos.size());
-		result.mSpecializationInfos.reserve(orderedUniqueShaderInfos.size());
-		for (auto& shaderInfo : orderedUniqueShaderInfos) {
-			// 2.2 Compile the shader
-			result.mShaders.push_back(create_shader(shaderInfo));
-			assert(result.mShaders.back().has_been_built());
-			// 2.3 Create shader info
-			auto& stageCreateInfo = result.mShaderStageCreateInfos.emplace_back()
-				.setStage(to_vk_shader_stage(result.mShaders.back().info().mShaderType))
-				.setModule(result.mShaders.back().handle())
-				.setPName(result.mShaders.back().info().mEntryPoint.c_str());
-			if (shaderInfo.mSpecializationConstants.has_value()) {
-				auto& specInfo = result.mSpecializationInfos.emplace_back(
-					shaderInfo.mSpecializationConstants.value().num_entries(),
-					shaderInfo.mSpecializationConstants.value().mMapEntries.data(),
-					shaderInfo.mSpecializationConstants.value().data_size(),
-					shaderInfo.mSpecializationConstants.value().mData.data()
-				);
-				// Add it to the stageCreateInfo:
-				stageCreateInfo.setPSpecializationInfo(&specInfo);
-			}
-			else {
-				result.mSpecializationInfos.emplace_back(); // Just to keep the indices into the vectors in sync
-			}
-		}
-		assert(orderedUniqueShaderInfos.size() == result.mShaders.size());
-		assert(result.mShaders.size() == result.mShaderStageCreateInfos.size());
-#if defined(_DEBUG)
-		// Perform a sanity check:
-		for (size_t i = 0; i < orderedUniqueShaderInfos.size(); ++i) {
-			assert(orderedUniqueShaderInfos[i] == result.mShaders[i].info());
-		}
-#endif
-
-		// 3. Create the shader table (with references to the shaders from step 2.)
-		// Iterate over the shader table... AGAIN! ...But this time, build the shader groups for Vulkan's Ray Tracing Pipeline:
-		result.mShaderGroupCreateInfos.reserve(aConfig.mShaderTableConfig.mShaderTableEntries.size());
-
-		// During iterating, also compile the data for the shader binding table groups information:
-		result.mShaderBindingTableGroupsInfo = {};
-		enum struct group_type { none, raygen, miss, hit, callable };
-		group_type prevType = group_type::none;
-		vk::DeviceSize groupOffset = 0;
-		vk::DeviceSize byteOffset = 0;
-		shader_group_info* curEdited = nullptr;
-
-		for (auto& tableEntry : aConfig.mShaderTableConfig.mShaderTableEntries) {
-			group_type curType = group_type::none;
-
-			if (std::holds_alternative<shader_info>(tableEntry)) {
-				const auto& shaderInfo = std::get<shader_info>(tableEntry);
-				switch (shaderInfo.mShaderType) {
-					case shader_type::ray_generation: curType = group_type::raygen;   break;
-					case shader_type::miss:           curType = group_type::miss;     break;
-					case shader_type::callable:       curType = group_type::callable; break;
-					default: throw avk::runtime_error("Invalid shader type passed to create_ray_tracing_pipeline, recognized during gathering of SBT infos");
-				}
-
-				// The shader indices are actually indices into `result.mShaders` not into
-				// `orderedUniqueShaderInfos`. However, both vectors are aligned perfectly,
-				// so we are just using `orderedUniqueShaderInfos` for convenience.
-				const uint32_t generalShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, shaderInfo));
-				result.mShaderGroupCreateInfos.emplace_back()
-					.setType(vk::RayTracingShaderGroupTypeKHR::eGeneral)
-					.setGeneralShader(generalShaderIndex)
-					.setIntersectionShader(VK_SHADER_UNUSED_KHR)
-					.setAnyHitShader(VK_SHADER_UNUSED_KHR)
-					.setClosestHitShader(VK_SHADER_UNUSED_KHR);
-			}
-			else if (std::holds_alternative<triangles_hit_group>(tableEntry)) {
-				curType = group_type::hit;
-
-				const auto& hitGroup = std::get<triangles_hit_group>(tableEntry);
-				uint32_t rahitShaderIndex = VK_SHADER_UNUSED_KHR;
-				if (hitGroup.mAnyHitShader.has_value()) {
-					rahitShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mAnyHitShader.value()));
-				}
-				uint32_t rchitShaderIndex = VK_SHADER_UNUSED_KHR;
-				if (hitGroup.mClosestHitShader.has_value()) {
-					rchitShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mClosestHitShader.value()));
-				}
-				result.mShaderGroupCreateInfos.emplace_back()
-					.setType(vk::RayTracingShaderGroupTypeKHR::eTrianglesHitGroup)
-					.setGeneralShader(VK_SHADER_UNUSED_KHR)
-					.setIntersectionShader(VK_SHADER_UNUSED_KHR)
-					.setAnyHitShader(rahitShaderIndex)
-					.setClosestHitShader(rchitShaderIndex);
-			}
-			else if (std::holds_alternative<procedural_hit_group>(tableEntry)) {
-				curType = group_type::hit;
-
-				const auto& hitGroup = std::get<procedural_hit_group>(tableEntry);
-				uint32_t rintShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mIntersectionShader));
-				uint32_t rahitShaderIndex = VK_SHADER_UNUSED_KHR;
-				if (hitGroup.mAnyHitShader.has_value()) {
-					rahitShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mAnyHitShader.value()));
-				}
-				uint32_t rchitShaderIndex = VK_SHADER_UNUSED_KHR;
-				if (hitGroup.mClosestHitShader.has_value()) {
-					rchitShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mClosestHitShader.value()));
-				}
-				result.mShaderGroupCreateInfos.emplace_back()
-					.setType(vk::RayTracingShaderGroupTypeKHR::eProceduralHitGroup)
-					.setGeneralShader(VK_SHADER_UNUSED_KHR)
-					.setIntersectionShader(rintShaderIndex)
-					.setAnyHitShader(rahitShaderIndex)
-					.setClosestHitShader(rchitShaderIndex);
-			}
-			else {
-				throw avk::runtime_error("tableEntry holds an unknown alternative. That's mysterious.");
-			}
-
-			// Set that shader binding table groups information:
-			assert (group_type::none != curType);
-			if (curType == prevType) {
-				// same same is easy
-				assert (nullptr != curEdited);
-				curEdited->mNumEntries += 1;
-
-				// A new handle group must start at a multiple of result.mShaderGroupHandleAlignment
-				byteOffset += result.mShaderGroupHandleSize;
-			}
-			else {
-				// different => create new entry
-				switch (curType) {
-				case group_type::raygen:
-					curEdited = &result.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo.emplace_back();
-					break;
-				case group_type::miss:
-					curEdited = &result.mShaderBindingTableGroupsInfo.mMissGroupsInfo.emplace_back();
-					break;
-				case group_type::hit:
-					curEdited = &result.mShaderBindingTableGroupsInfo.mHitGroupsInfo.emplace_back();
-					break;
-				case group_type::callable:
-					curEdited = &result.mShaderBindingTableGroupsInfo.mCallableGroupsInfo.emplace_back();
-					break;
-				default: throw avk::runtime_error("Can't be!");
-				}
-				assert (nullptr != curEdited);
-				curEdited->mOffset = groupOffset;
-				curEdited->mNumEntries = 1;
-
-				// A new shader group must start at a multiple of result.mShaderGroupBaseAlignment
-				byteOffset = align_to(byteOffset, static_cast<vk::DeviceAddress>(result.mShaderGroupBaseAlignment));
-				curEdited->mByteOffset = byteOffset;
-				byteOffset += result.mShaderGroupHandleSize;
-			}
-			prevType = curType;
-			++groupOffset;
-		}
-		result.mShaderBindingTableGroupsInfo.mEndOffset = groupOffset;
-		result.mShaderBindingTableGroupsInfo.mTotalSize = byteOffset;
-
-		// 4. Maximum recursion depth:
-		result.mMaxRecursionDepth = aConfig.mMaxRecursionDepth.mMaxRecursionDepth;
-
-		// 5. Pipeline layout
+		// 14. Compile the PIPELINE LAYOUT data and create-info
+		// Get the descriptor set layouts
 		result.mAllDescriptorSetLayouts = set_of_descriptor_set_layouts::prepare(std::move(aConfig.mResourceBindings));
 		allocate_set_of_descriptor_set_layouts(result.mAllDescriptorSetLayouts);
 
@@ -6302,1740 +7399,4525 @@ namespace avk
 		}
 
 		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
+		// These uniform values (Anm.: passed to shaders) need to be specified during pipeline creation by creating a VkPipelineLayout object. [4]
 		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
 			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
 			.setPSetLayouts(descriptorSetLayoutHandles.data())
 			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
 			.setPPushConstantRanges(result.mPushConstantRanges.data());
 
-		// 6. Maybe alter the config?
+		// 15. Set Rendering info if dynamic rendering is enabled
+		if(dynamicRenderingEnabled)
+		{
+			std::vector<vk::Format> depth_attachments;
+			std::vector<vk::Format> stencil_attachments;
+			for(const auto & dynamicRenderingAttachment : aConfig.mDynamicRenderingAttachments.value())
+			{
+				if(is_depth_format(dynamicRenderingAttachment.format())) {
+					depth_attachments.push_back(dynamicRenderingAttachment.format());
+				} else if (is_stencil_format(dynamicRenderingAttachment.format())) {
+					stencil_attachments.push_back(dynamicRenderingAttachment.format());
+				} else if (!dynamicRenderingAttachment.mSubpassUsages.get_subpass_usage(0).as_color()) {
+					result.mDynamicRenderingColorFormats.push_back(dynamicRenderingAttachment.format());
+				}
+			}
+			if(depth_attachments.size() > 1)   { throw avk::runtime_error("Provided multiple depth attachments! Only one is supported!"); }
+			if(stencil_attachments.size() > 1) { throw avk::runtime_error("Provided multiple stencil attachments! Only one is supported!"); }
+
+			result.mRenderingCreateInfo = vk::PipelineRenderingCreateInfoKHR{}
+				.setColorAttachmentCount(static_cast<uint32_t>(result.mDynamicRenderingColorFormats.size()))
+				.setPColorAttachmentFormats(result.mDynamicRenderingColorFormats.data())
+				.setDepthAttachmentFormat(depth_attachments.size() == 1 ? depth_attachments.at(0) : vk::Format{})
+				.setStencilAttachmentFormat(stencil_attachments.size() == 1 ? stencil_attachments.at(0) : vk::Format{});
+		}
+
+		// 16. Maybe alter the config?!
 		if (aAlterConfigBeforeCreation) {
 			aAlterConfigBeforeCreation(result);
 		}
 
-		// 8. Create the pipeline's layout
-		// 9. Build the Ray Tracing Pipeline
-		rewire_config_and_create_ray_tracing_pipeline(result);
-
-		// 10. Build the shader binding table
-		build_shader_binding_table(result);
+		assert (aConfig.mRenderPassSubpass.has_value() || dynamicRenderingEnabled);
+		rewire_config_and_create_graphics_pipeline(result);
 		return result;
 	}
 
-	ray_tracing_pipeline root::create_ray_tracing_pipeline_from_template(const ray_tracing_pipeline_t& aTemplate, std::function<void(ray_tracing_pipeline_t&)> aAlterConfigBeforeCreation)
+	graphics_pipeline root::create_graphics_pipeline_from_template(const graphics_pipeline_t& aTemplate, std::optional<renderpass> aNewRenderpass, std::optional<cfg::subpass_index> aSubpassIndex, std::function<void(graphics_pipeline_t&)> aAlterConfigBeforeCreation)
 	{
-		ray_tracing_pipeline_t result;
+		graphics_pipeline_t result;
+		if(aTemplate.mRenderingCreateInfo.has_value() && aNewRenderpass.has_value())
+		{
+			throw avk::runtime_error("Attempting to create pipeline using renderpass from a template pipeline using dynamic rendering (which has no renderpasses) is not valid!");
+		}
+		result.mRenderPass = std::move(aNewRenderpass);
+		result.mSubpassIndex = aSubpassIndex.value_or(cfg::subpass_index{ aTemplate.mSubpassIndex }).mSubpassIndex;
+
+		result.mOrderedVertexInputBindingDescriptions	= aTemplate.mOrderedVertexInputBindingDescriptions;
+		result.mVertexInputAttributeDescriptions		= aTemplate.mVertexInputAttributeDescriptions	   ;
+		result.mPipelineVertexInputStateCreateInfo		= aTemplate.mPipelineVertexInputStateCreateInfo   ;
+		result.mInputAssemblyStateCreateInfo			= aTemplate.mInputAssemblyStateCreateInfo		   ;
 
-		result.mPipelineCreateFlags						= aTemplate.mPipelineCreateFlags;
 		for (const auto& shdr : aTemplate.mShaders) {
 			result.mShaders.push_back(create_shader_from_template(shdr));
 		}
-		result.mShaderStageCreateInfos					= aTemplate.mShaderStageCreateInfos;
-		result.mSpecializationInfos						= aTemplate.mSpecializationInfos;
-		result.mShaderGroupCreateInfos					= aTemplate.mShaderGroupCreateInfos;
-		result.mShaderBindingTableGroupsInfo			= aTemplate.mShaderBindingTableGroupsInfo;
-		result.mMaxRecursionDepth						= aTemplate.mMaxRecursionDepth;
-		result.mBasePipelineIndex						= aTemplate.mBasePipelineIndex;
+
+		result.mShaderStageCreateInfos					= aTemplate.mShaderStageCreateInfos					;
+		result.mSpecializationInfos						= aTemplate.mSpecializationInfos				   ;
+		result.mViewports								= aTemplate.mViewports							   ;
+		result.mScissors								= aTemplate.mScissors							   ;
+		result.mViewportStateCreateInfo					= aTemplate.mViewportStateCreateInfo			   ;
+		result.mRasterizationStateCreateInfo			= aTemplate.mRasterizationStateCreateInfo		   ;
+		result.mDepthStencilConfig						= aTemplate.mDepthStencilConfig						;
+		result.mBlendingConfigsForColorAttachments		= aTemplate.mBlendingConfigsForColorAttachments   ;
+		result.mColorBlendStateCreateInfo				= aTemplate.mColorBlendStateCreateInfo			   ;
+		result.mMultisampleStateCreateInfo				= aTemplate.mMultisampleStateCreateInfo				;
+		result.mDynamicStateEntries						= aTemplate.mDynamicStateEntries				   ;
+		result.mDynamicStateCreateInfo					= aTemplate.mDynamicStateCreateInfo					;
+
 		result.mAllDescriptorSetLayouts = create_set_of_descriptor_set_layouts_from_template(aTemplate.mAllDescriptorSetLayouts);
-		result.mPushConstantRanges						= aTemplate.mPushConstantRanges;
 
-		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
-		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
+		result.mPushConstantRanges						= aTemplate.mPushConstantRanges						;
+		result.mPipelineTessellationStateCreateInfo		= aTemplate.mPipelineTessellationStateCreateInfo  ;
+
+		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
+		// These uniform values (Anm.: passed to shaders) need to be specified during pipeline creation by creating a VkPipelineLayout object. [4]
+		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
 			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
 			.setPSetLayouts(descriptorSetLayoutHandles.data())
 			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
 			.setPPushConstantRanges(result.mPushConstantRanges.data());
 
-		result.mShaderGroupBaseAlignment				= aTemplate.mShaderGroupBaseAlignment;
-		result.mShaderGroupHandleSize					= aTemplate.mShaderGroupHandleSize;
-
-		result.mRoot = this;
-
 		// 15. Maybe alter the config?!
 		if (aAlterConfigBeforeCreation) {
 			aAlterConfigBeforeCreation(result);
 		}
 
-		rewire_config_and_create_ray_tracing_pipeline(result);
-		build_shader_binding_table(result);
+		rewire_config_and_create_graphics_pipeline(result);
 		return result;
 	}
 
-	size_t ray_tracing_pipeline_t::num_raygen_groups_in_shader_binding_table() const
+	graphics_pipeline root::create_graphics_pipeline_from_template(const graphics_pipeline_t& aTemplate, std::function<void(graphics_pipeline_t&)> aAlterConfigBeforeCreation)
 	{
-		return shader_binding_table_groups().mRaygenGroupsInfo.size();
+		// If dynamic rendering is enabled we don't want to create new renderpass
+		if(aTemplate.mRenderingCreateInfo.has_value())
+		{
+			return create_graphics_pipeline_from_template(aTemplate, std::nullopt, std::nullopt, std::move(aAlterConfigBeforeCreation));
+		}
+		std::optional<avk::renderpass> renderpassForPipeline;
+		if (aTemplate.mRenderPass.value().is_shared_ownership_enabled()) {
+			renderpassForPipeline = aTemplate.mRenderPass;
+		}
+		else {
+			renderpassForPipeline = create_renderpass_from_template(*(aTemplate.mRenderPass.value()), {});
+		}
+		return create_graphics_pipeline_from_template(aTemplate, std::move(renderpassForPipeline), std::nullopt, std::move(aAlterConfigBeforeCreation));
 	}
 
-	size_t ray_tracing_pipeline_t::num_miss_groups_in_shader_binding_table() const
+	renderpass root::replace_render_pass_for_pipeline(graphics_pipeline& aPipeline, renderpass aNewRenderPass)
 	{
-		return shader_binding_table_groups().mMissGroupsInfo.size();
-	}
+		if(aPipeline.get().mRenderingCreateInfo.has_value())
+		{
+			throw avk::runtime_error("Attempting to replace renderpass of pipeline using dynamic rendering (which has no renderpasses) is not valid!");
+		}
 
-	size_t ray_tracing_pipeline_t::num_hit_groups_in_shader_binding_table() const
-	{
-		return shader_binding_table_groups().mHitGroupsInfo.size();
-	}
+		if (aPipeline->mRenderPass.value().is_shared_ownership_enabled()) {
+			aNewRenderPass.enable_shared_ownership();
+		}
 
-	size_t ray_tracing_pipeline_t::num_callable_groups_in_shader_binding_table() const
-	{
-		return shader_binding_table_groups().mCallableGroupsInfo.size();
+		auto oldRenderPass = std::move(aPipeline->mRenderPass);
+		aPipeline->mRenderPass = std::move(aNewRenderPass);
+
+		return oldRenderPass.value();
 	}
+#pragma endregion
 
-	void ray_tracing_pipeline_t::print_shader_binding_table_groups() const
+#pragma region image definitions
+	image_t::image_t(const image_t& aOther)
 	{
-		vk::DeviceSize off = 0;
-		size_t iRaygen = 0;
-		size_t iMiss = 0;
-		size_t iHit = 0;
-		size_t iCallable = 0;
-		auto printRow = [](std::string aOffset, std::string aShaders, std::string aRaygen, std::string aMiss, std::string aHit, std::string aCallable){
-			static const std::string offsetStr	 = "      ";
-			static const std::string shadersStr	 = "                                               ";
-			static const std::string raygenStr	 = "          ";
-			static const std::string missStr	 = "          ";
-			static const std::string hitStr		 = "         ";
-			static const std::string callableStr = "          ";
-			if (aOffset.empty())	{ aOffset = offsetStr; }
-			if (aShaders.empty())	{ aShaders = shadersStr; }
-			if (aRaygen.empty())	{ aRaygen = raygenStr; }
-			if (aMiss.empty())		{ aMiss = missStr; }
-			if (aHit.empty())		{ aHit = hitStr; }
-			if (aCallable.empty())	{ aCallable = callableStr; }
-			if (aOffset.length() < offsetStr.length())		{ aOffset = offsetStr		+ aOffset; }
-			if (aShaders.length() < shadersStr.length())	{ aShaders = shadersStr		+ aShaders; }
-			if (aRaygen.length() < raygenStr.length())		{ aRaygen = raygenStr		+ aRaygen; }
-			if (aMiss.length() < missStr.length())			{ aMiss = missStr			+ aMiss; }
-			if (aHit.length() < hitStr.length())			{ aHit = hitStr				+ aHit; }
-			if (aCallable.length() < callableStr.length())	{ aCallable = callableStr	+ aCallable; }
-			if (aOffset.length() > offsetStr.length())		{ aOffset = aOffset.substr(aOffset.length() - offsetStr.length()); }
-			if (aShaders.length() > shadersStr.length())	{ aShaders = aShaders.substr(aShaders.length() - shadersStr.length()); }
-			if (aRaygen.length() > raygenStr.length())		{ aRaygen = aRaygen.substr(aRaygen.length() - raygenStr.length()); }
-			if (aMiss.length() > missStr.length())			{ aMiss =   aMiss.substr(aMiss.length()   - missStr.length()); }
-			if (aHit.length() > hitStr.length())			{ aHit =    aHit.substr(aHit.length()    - hitStr.length()); }
-			if (aCallable.length() > callableStr.length())	{ aCallable = aCallable.substr(aCallable.length() - callableStr.length()); }
-			AVK_LOG_INFO("| " + aOffset + " | " + aShaders + " | " + aRaygen + " | " + aMiss + " | " + aHit + " | " + aCallable + " |");
-		};
-		auto getShaderName = [this](uint32_t aIndex, bool aPrintFileExt = true){
-			auto filename = avk::extract_file_name(mShaders[aIndex].info().mPath);
-			const auto spvPos = filename.find(".spv");
-			if (spvPos != std::string::npos) {
-				filename = filename.substr(0, spvPos);
-			}
-			if (!aPrintFileExt) {
-				const auto dotPos = filename.find_first_of('.');
-				if (dotPos != std::string::npos) {
-					return filename.substr(0, dotPos);
-				}
-			}
-			return filename;
-		};
-		AVK_LOG_INFO("+=============================================================================================================+");
-		AVK_LOG_INFO("|                          +++++++++++++ SHADER BINDING TABLE +++++++++++++                                   |");
-		AVK_LOG_INFO("|                          BYTE-OFFSETS, SHADERS, and GROUP-INDICES (G.IDX)                                   |");
-		AVK_LOG_INFO("+=============================================================================================================+");
-		AVK_LOG_INFO("| OFFSET | SHADERS: GENERAL or INTERS.|ANY-HIT|CLOSEST-HIT | RGEN G.IDX | MISS G.IDX | HIT G.IDX | CALL G.IDX |");
-		while (off < mShaderBindingTableGroupsInfo.mEndOffset) {
-			AVK_LOG_INFO("+-------------------------------------------------------------------------------------------------------------+");
-			if (iRaygen   < mShaderBindingTableGroupsInfo.mRaygenGroupsInfo.size() && mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mOffset == off) {
-				std::string byteOff = std::to_string(mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mByteOffset);
-				std::string grpIdx = "[" + std::to_string(iRaygen) + "]";
-				for (size_t i = 0; i < mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mNumEntries; ++i) {
-					printRow(byteOff, getShaderName(mShaderGroupCreateInfos[off + i].generalShader) + ": " + std::to_string(i), grpIdx, "", "", "");
-					byteOff = ""; grpIdx = "";
-				}
-				off      += mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mNumEntries;
-				++iRaygen;
-			}
-			else if (iMiss < mShaderBindingTableGroupsInfo.mMissGroupsInfo.size() && mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mOffset == off) {
-				std::string byteOff = std::to_string(mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mByteOffset);
-				std::string grpIdx = "[" + std::to_string(iMiss) + "]";
-				for (size_t i = 0; i < mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mNumEntries; ++i) {
-					printRow(byteOff, getShaderName(mShaderGroupCreateInfos[off + i].generalShader) + ": " + std::to_string(i), "", grpIdx, "", "");
-					byteOff = ""; grpIdx = "";
-				}
-				off       += mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mNumEntries;
-				++iMiss;
-			}
-			else if (iHit < mShaderBindingTableGroupsInfo.mHitGroupsInfo.size() && mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mOffset == off) {
-				std::string byteOff = std::to_string(mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mByteOffset);
-				std::string grpIdx = "[" + std::to_string(iHit) + "]";
-				for (size_t i = 0; i < mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mNumEntries; ++i) {
-					assert(vk::RayTracingShaderGroupTypeKHR::eGeneral != mShaderGroupCreateInfos[off + iHit].type);
-					std::string hitInfo;
-					hitInfo += mShaderGroupCreateInfos[off + i].intersectionShader != VK_SHADER_UNUSED_KHR ? getShaderName(mShaderGroupCreateInfos[off + i].intersectionShader, false) : "--";
-					hitInfo += "|";
-					hitInfo += mShaderGroupCreateInfos[off + i].anyHitShader != VK_SHADER_UNUSED_KHR ? getShaderName(mShaderGroupCreateInfos[off + i].anyHitShader, false) : "--";
-					hitInfo += "|";
-					hitInfo += mShaderGroupCreateInfos[off + i].closestHitShader != VK_SHADER_UNUSED_KHR ? getShaderName(mShaderGroupCreateInfos[off + i].closestHitShader, false) : "--";
-					printRow(byteOff, hitInfo + ": " + std::to_string(i), "", "", grpIdx, "");
-					byteOff = ""; grpIdx = "";
-				}
-				off      += mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mNumEntries;
-				++iHit;
-			}
-			else if (iCallable < mShaderBindingTableGroupsInfo.mCallableGroupsInfo.size() && mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mOffset == off) {
-				std::string byteOff = std::to_string(mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mByteOffset);
-				std::string grpIdx = "[" + std::to_string(iCallable) + "]";
-				for (size_t i = 0; i < mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mNumEntries; ++i) {
-					printRow(byteOff, getShaderName(mShaderGroupCreateInfos[off + i].generalShader) + ": " + std::to_string(i), "", "", "", grpIdx);
-					byteOff = ""; grpIdx = "";
-				}
-				off      += mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mNumEntries;
-				++iCallable;
-			}
-			else {
-				throw avk::runtime_error("Can't be");
-			}
+		if (std::holds_alternative<vk::Image>(aOther.mImage)) {
+			mCreateInfo = aOther.mCreateInfo;
+			mImage = std::get<vk::Image>(aOther.mImage);
+			mImageUsage = aOther.mImageUsage;
+			mAspectFlags = aOther.mAspectFlags;
+		}
+		else {
+			throw avk::runtime_error("Can not copy this image instance!");
 		}
-		AVK_LOG_INFO("+-------------------------------------------------------------------------------------------------------------+");
 	}
-#endif
-#pragma endregion
-
-#pragma region renderpass definitions
 
-	struct subpass_desc_helper
+	image root::create_image_from_template(const image_t& aTemplate, std::function<void(image_t&)> aAlterConfigBeforeCreation)
 	{
-		size_t mSubpassId;
-		std::map<uint32_t, vk::AttachmentReference2KHR> mSpecificInputLocations;
-		std::queue<vk::AttachmentReference2KHR> mUnspecifiedInputLocations;
-		int mInputMaxLoc;
-		std::map<uint32_t, vk::AttachmentReference2KHR> mSpecificColorLocations;
-		std::queue<vk::AttachmentReference2KHR> mUnspecifiedColorLocations;
-		int mColorMaxLoc;
-		std::queue<vk::AttachmentReference2KHR> mUnspecifiedDepthStencilLocations;
-		int mDepthStencilMaxLoc;
-		std::map<uint32_t, vk::AttachmentReference2KHR> mSpecificColorResolveLocations;
-		std::queue<vk::AttachmentReference2KHR> mUnspecifiedColorResolveLocations;
-		std::queue<vk::SubpassDescriptionDepthStencilResolve> mUnspecifiedDepthStencilResolveData;
-		std::queue<vk::AttachmentReference2KHR> mUnspecifiedDepthStencilResolveRefs;
-		std::vector<uint32_t> mPreserveAttachments;
-	};
+		image_t result;
+		result.mRoot = aTemplate.mRoot;
+		result.mCreateInfo = aTemplate.mCreateInfo;
+		result.mImageUsage = aTemplate.mImageUsage;
+		result.mAspectFlags = aTemplate.mAspectFlags;
 
-	void root::rewire_subpass_descriptions(renderpass_t& aRenderpass)
-	{
-		const auto nSubpasses = aRenderpass.mSubpassData.size();
+		if (std::holds_alternative<vk::Image>(aTemplate.mImage)) {
+			// If the template is a wrapped image, there's not a lot we can do.
+			//result.mImage = std::get<vk::Image>(aTemplate.mImage);
+			return result;
+		}
 
-		aRenderpass.mSubpasses.clear(); // Start with a clean state
-		aRenderpass.mSubpasses.reserve(nSubpasses);
+		assert(!std::holds_alternative<std::monostate>(aTemplate.mImage));
 
-		for (size_t i = 0; i < nSubpasses; ++i) {
-			auto& b = aRenderpass.mSubpassData[i];
+		// Maybe alter the config?!
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
 
-			assert(b.mOrderedDepthStencilResolveAttachmentRefs.size() == b.mOrderedDepthStencilResolveAttachmentData.size());
-			const auto nDepthStencilResolve = b.mOrderedDepthStencilResolveAttachmentRefs.size();
-			for (size_t ids = 0; ids < nDepthStencilResolve; ++ids) {
-				b.mOrderedDepthStencilResolveAttachmentData[ids].setPDepthStencilResolveAttachment(
-					&b.mOrderedDepthStencilResolveAttachmentRefs[ids]
-				);
-			}
+		result.mImage = AVK_MEM_IMAGE_HANDLE{ memory_allocator(), aTemplate.memory_properties(), result.mCreateInfo, ~0u, &capabilities().memory_properties() };
 
-			aRenderpass.mSubpasses.push_back(vk::SubpassDescription2KHR{}
-				// pipelineBindPoint must be VK_PIPELINE_BIND_POINT_GRAPHICS [1] because subpasses are only relevant for graphics at the moment
-				.setPipelineBindPoint(vk::PipelineBindPoint::eGraphics)
-				.setColorAttachmentCount(static_cast<uint32_t>(b.mOrderedColorAttachmentRefs.size()))
-				.setPColorAttachments(b.mOrderedColorAttachmentRefs.data())
-				// If pResolveAttachments is not NULL, each of its elements corresponds to a color attachment
-				//  (the element in pColorAttachments at the same index), and a multisample resolve operation
-				//  is defined for each attachment. [1]
-				.setPResolveAttachments(b.mOrderedColorResolveAttachmentRefs.empty() ? nullptr : b.mOrderedColorResolveAttachmentRefs.data())
-				// If pDepthStencilAttachment is NULL, or if its attachment index is VK_ATTACHMENT_UNUSED, it
-				//  indicates that no depth/stencil attachment will be used in the subpass. [1]
-				.setPDepthStencilAttachment(b.mOrderedDepthStencilAttachmentRefs.empty() ? nullptr : &b.mOrderedDepthStencilAttachmentRefs[0])
-				// The following two attachment types are probably totally irrelevant if we only have one subpass
-				.setInputAttachmentCount(static_cast<uint32_t>(b.mOrderedInputAttachmentRefs.size()))
-				.setPInputAttachments(b.mOrderedInputAttachmentRefs.data())
-				.setPreserveAttachmentCount(static_cast<uint32_t>(b.mPreserveAttachments.size()))
-				.setPPreserveAttachments(b.mPreserveAttachments.data())
-				// Add depth/stencil resolve attachment:
-				.setPNext(b.mOrderedDepthStencilResolveAttachmentData.empty() ? nullptr : b.mOrderedDepthStencilResolveAttachmentData.data())
-			);				
-		}
+		return result;
 	}
 
-
-	/**	Creates memory barrier data which is appropriate for the given subpass dependency.
-	 *	@param	aSubpassDependency	Subpass dependency to create memory barrier data for.
-	 *	@return	Memory barrier data including stage and access masks.
-	 */
-	static inline vk::MemoryBarrier2KHR get_memory_barrier_for_subpass_dependency(const subpass_dependency& aSubpassDependency)
+	std::tuple<image_t, vk::MemoryPropertyFlags> root::configure_image(uint32_t aWidth, uint32_t aHeight, std::tuple<vk::Format, vk::SampleCountFlagBits> aFormatAndSamples, int aNumLayers, memory_usage aMemoryUsage, image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
 	{
-		const bool srcStageIsAuto = std::holds_alternative<avk::stage::auto_stage_t>(aSubpassDependency.mStages.mSrc);
-		const bool dstStageIsAuto = std::holds_alternative<avk::stage::auto_stage_t>(aSubpassDependency.mStages.mDst);
-		const bool srcAccessIsAuto = std::holds_alternative<avk::access::auto_access_t>(aSubpassDependency.mAccesses.mSrc);
-		const bool dstAccessIsAuto = std::holds_alternative<avk::access::auto_access_t>(aSubpassDependency.mAccesses.mDst);
+		// Determine image usage flags, image layout, and memory usage flags:
+		auto [imageUsage, targetLayout, imageTiling, imageCreateFlags] = determine_usage_layout_tiling_flags_based_on_image_usage(aImageUsage);
 
-		return vk::MemoryBarrier2KHR{}
-			.setSrcStageMask(srcStageIsAuto
-				? vk::PipelineStageFlags2KHR{
-					VK_SUBPASS_EXTERNAL == aSubpassDependency.mIndices.mSrc
-					? vk::PipelineStageFlagBits2KHR::eAllCommands // TODO: Try to determine tighter stage mask; needs more information about external commands, though
-					: vk::PipelineStageFlagBits2KHR::eAllGraphics
+		vk::MemoryPropertyFlags memoryPropFlags{};
+		switch (aMemoryUsage) {
+		case avk::memory_usage::host_visible:
+			memoryPropFlags = vk::MemoryPropertyFlagBits::eHostVisible;
+			break;
+		case avk::memory_usage::host_coherent:
+			memoryPropFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+			break;
+		case avk::memory_usage::host_cached:
+			memoryPropFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCached;
+			break;
+		case avk::memory_usage::device:
+			memoryPropFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+			imageUsage |= vk::ImageUsageFlagBits::eTransferDst;
+			break;
+		case avk::memory_usage::device_readback:
+			memoryPropFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+			imageUsage |= vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc;
+			break;
+		case avk::memory_usage::device_protected:
+			memoryPropFlags = vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eProtected;
+			imageUsage |= vk::ImageUsageFlagBits::eTransferDst;
+			break;
+		case avk::memory_usage::device_transient:
+			{
+				// Transient attachments may only be used as color, depth/stencil, or input attachments:
+				const vk::ImageUsageFlags attachmentUsages = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eInputAttachment;
+				if (!(imageUsage & attachmentUsages)) {
+					throw avk::logic_error("An image with memory_usage::device_transient must be used as color, depth/stencil, or input attachment.");
 				}
-				: std::get<vk::PipelineStageFlags2KHR>(aSubpassDependency.mStages.mSrc)
-			)
-			.setDstStageMask(dstStageIsAuto
-				? vk::PipelineStageFlags2KHR{
-					VK_SUBPASS_EXTERNAL == aSubpassDependency.mIndices.mDst
-					? vk::PipelineStageFlagBits2KHR::eAllCommands // TODO: Try to determine tighter stage mask; needs more information about external commands, though
-					: vk::PipelineStageFlagBits2KHR::eAllGraphics
+				if (imageUsage & ~attachmentUsages) {
+					throw avk::logic_error("An image with memory_usage::device_transient may only be used as color, depth/stencil, or input attachment, but the image usage also includes " + vk::to_string(imageUsage & ~attachmentUsages) + ".");
 				}
-				: std::get<vk::PipelineStageFlags2KHR>(aSubpassDependency.mStages.mDst)
-			)
-			.setSrcAccessMask(srcAccessIsAuto
-				? vk::AccessFlags2KHR{ vk::AccessFlagBits2KHR::eMemoryWrite }  // TODO: Try to determine tighter access mask; needs more information about external commands, though
-				: std::get<vk::AccessFlags2KHR>(aSubpassDependency.mAccesses.mSrc)
-			)
-			.setDstAccessMask(dstAccessIsAuto
-				? vk::AccessFlags2KHR{ vk::AccessFlagBits2KHR::eMemoryWrite }  // TODO: Try to determine tighter access mask; needs more information about external commands, though
-				: std::get<vk::AccessFlags2KHR>(aSubpassDependency.mAccesses.mDst)
-			);
-	}
+			}
+			imageUsage |= vk::ImageUsageFlagBits::eTransientAttachment;
+			memoryPropFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+			// Not all devices offer lazily allocated memory (typically, only tile-based GPUs do) => fall back to ordinary device memory:
+			if (is_memory_type_supported(vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eLazilyAllocated)) {
+				memoryPropFlags |= vk::MemoryPropertyFlagBits::eLazilyAllocated;
+			}
+			break;
+		case avk::memory_usage::device_host_writable:
+			// Images are generally in optimal tiling => host writes would not be of much use:
+			memoryPropFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+			imageUsage |= vk::ImageUsageFlagBits::eTransferDst;
+			break;
+		}
 
-	std::tuple<std::vector<vk::SubpassDependency2KHR>, std::vector<vk::MemoryBarrier2KHR>> root::compile_subpass_dependencies(const renderpass_t& aRenderpass)
-	{
-		const auto numSubpassesFirst = aRenderpass.mSubpassData.size();
-		assert(numSubpassesFirst > 0);
+		// How many MIP-map levels are we going to use?
+		auto mipLevels = avk::has_flag(aImageUsage, avk::image_usage::mip_mapped)
+			? static_cast<uint32_t>(1 + std::floor(std::log2(std::max(aWidth, aHeight))))
+			: 1u;
 
-		// And construct the actual dependency-info from it:
-		std::vector<vk::SubpassDependency2KHR> subpassDependencies2;
-		std::vector<vk::MemoryBarrier2KHR> memoryBarriers2;
+		const auto format = std::get<vk::Format>(aFormatAndSamples);
+		const auto samples = std::get<vk::SampleCountFlagBits>(aFormatAndSamples);
 
-		// Just turn them all into subpass dependencies:
-		for (auto& subDep : aRenderpass.mSubpassDependencies) {
-			subpassDependencies2.push_back(vk::SubpassDependency2KHR{}
-				.setSrcSubpass(subDep.mIndices.mSrc).setDstSubpass(subDep.mIndices.mDst) // If a VkMemoryBarrier2 is included in the pNext chain, srcStageMask, dstStageMask, srcAccessMask, and dstAccessMask parameters are ignored.
-				.setPNext(nullptr) // !!! ATTENTION: This will have to be set by the user of this function to point to the appropriate vk::MemoryBarrier2KHR{} !!!
-			);
-			memoryBarriers2.push_back(get_memory_barrier_for_subpass_dependency(subDep));
+		if (avk::has_flag(imageUsage, vk::ImageUsageFlagBits::eDepthStencilAttachment) && vk::ImageTiling::eOptimal == imageTiling) { // only for AMD |-(
+			const auto formatProps = capabilities().format_properties(format);
+			if (!has_flag(formatProps.optimalTilingFeatures, vk::FormatFeatureFlagBits::eDepthStencilAttachment)) {
+				imageTiling = vk::ImageTiling::eLinear;
+			}
 		}
 
-		assert(subpassDependencies2.size() == memoryBarriers2.size());
+		vk::ImageAspectFlags aspectFlags = {};
+		if (is_depth_format(format)) {
+			aspectFlags |= vk::ImageAspectFlagBits::eDepth;
+		}
+		if (has_stencil_component(format)) {
+			aspectFlags |= vk::ImageAspectFlagBits::eStencil;
+		}
+		if (!aspectFlags) {
+			aspectFlags = vk::ImageAspectFlagBits::eColor;
+			// TODO: maybe support further aspect flags?!
+		}
 
-		return std::make_tuple(std::move(subpassDependencies2), std::move(memoryBarriers2));
+		image_t result;
+		result.mRoot = this;
+		result.mCreateInfo = vk::ImageCreateInfo()
+			.setImageType(vk::ImageType::e2D) // TODO: Support 3D textures
+			.setExtent(vk::Extent3D(static_cast<uint32_t>(aWidth), static_cast<uint32_t>(aHeight), 1u))
+			.setMipLevels(mipLevels)
+			.setArrayLayers(aNumLayers)
+			.setFormat(format)
+			.setTiling(imageTiling)
+			.setInitialLayout(vk::ImageLayout::eUndefined)
+			.setUsage(imageUsage)
+			.setSharingMode(vk::SharingMode::eExclusive) // TODO: Not sure yet how to handle this one, Exclusive should be the default, though.
+			.setSamples(samples)
+			.setFlags(imageCreateFlags);
+		result.mImageUsage = aImageUsage;
+		result.mAspectFlags = aspectFlags;
+
+		// Maybe alter the config?!
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		return std::make_tuple(std::move(result), memoryPropFlags);
 	}
 
-	void root::rewire_subpass_dependencies(std::vector<vk::SubpassDependency2KHR>& aAlignedSubpassDependencies, std::vector<vk::MemoryBarrier2KHR>& aAlignedMemoryBarriers)
+	image root::create_image(uint32_t aWidth, uint32_t aHeight, std::tuple<vk::Format, vk::SampleCountFlagBits> aFormatAndSamples, int aNumLayers, memory_usage aMemoryUsage, image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
 	{
-		// Set pNext pointers in every vk::SubpassDependency2KHR
-		for (size_t i = 0; i < aAlignedSubpassDependencies.size(); ++i) {
-			aAlignedSubpassDependencies[i].setPNext(&aAlignedMemoryBarriers[i]);
-			//aAlignedSubpassDependencies[i]
-			//	.setPNext(nullptr)
-			//	.setSrcStageMask(aAlignedMemoryBarriers[i].srcStageMask == vk::PipelineStageFlagBits2KHR::eNone ? (vk::PipelineStageFlags)vk::PipelineStageFlagBits::eTopOfPipe : (vk::PipelineStageFlags)(VkPipelineStageFlags)(VkPipelineStageFlags2KHR)aAlignedMemoryBarriers[i].srcStageMask)
-			//	.setSrcAccessMask((vk::AccessFlags)(VkAccessFlags)(VkAccessFlags2KHR)aAlignedMemoryBarriers[i].srcAccessMask)
-			//	.setDstStageMask(aAlignedMemoryBarriers[i].dstStageMask == vk::PipelineStageFlagBits2KHR::eNone ? (vk::PipelineStageFlags)vk::PipelineStageFlagBits::eBottomOfPipe : (vk::PipelineStageFlags)(VkPipelineStageFlags)(VkPipelineStageFlags2KHR)aAlignedMemoryBarriers[i].dstStageMask)
-			//	.setDstAccessMask((vk::AccessFlags)(VkAccessFlags)(VkAccessFlags2KHR)aAlignedMemoryBarriers[i].dstAccessMask);
-		}
+		auto [result, memoryPropFlags] = configure_image(aWidth, aHeight, aFormatAndSamples, aNumLayers, aMemoryUsage, aImageUsage, std::move(aAlterConfigBeforeCreation));
+		result.mImage = AVK_MEM_IMAGE_HANDLE{ memory_allocator(), memoryPropFlags, result.mCreateInfo, ~0u, &capabilities().memory_properties() };
+		return std::move(result);
 	}
 
-	renderpass root::create_renderpass(std::vector<avk::attachment> aAttachments, subpass_dependencies aSubpassDependencies, std::function<void(renderpass_t&)> aAlterConfigBeforeCreation)
+	image root::create_image(uint32_t aWidth, uint32_t aHeight, vk::Format aFormat, int aNumLayers, memory_usage aMemoryUsage, avk::image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
 	{
-		renderpass_t result;
-		result.mRoot = this;
+		return create_image(aWidth, aHeight, std::make_tuple(aFormat, vk::SampleCountFlagBits::e1), aNumLayers, aMemoryUsage, aImageUsage, std::move(aAlterConfigBeforeCreation));
+	}
 
-		std::vector<subpass_desc_helper> subpasses;
 
-		if (aAttachments.empty()) {
-			throw avk::runtime_error("No attachments have been passed to the creation of a renderpass.");
+	image root::create_depth_image(uint32_t aWidth, uint32_t aHeight, std::optional<vk::Format> aFormat, int aNumLayers,  memory_usage aMemoryUsage, avk::image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+	{
+		// Select a suitable depth format
+		if (!aFormat) {
+			std::array depthFormats = { vk::Format::eD32Sfloat, vk::Format::eD24UnormS8Uint, vk::Format::eD16Unorm };
+			for (auto format : depthFormats) {
+				if (is_format_supported(format, vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eDepthStencilAttachment)) {
+					aFormat = format;
+					break;
+				}
+			}
 		}
-		const auto numSubpassesFirst = aAttachments.front().mSubpassUsages.num_subpasses();
-		if (0 == numSubpassesFirst) {
-			throw avk::runtime_error("The first subpass has no usages specified. Subpass usages are not optional.");
+		if (!aFormat) {
+			throw avk::runtime_error("No suitable depth format could be found.");
 		}
-		// All further attachments must have the same number of subpasses! It will be checked.
-		subpasses.reserve(numSubpassesFirst);
-		for (size_t i = 0; i < numSubpassesFirst; ++i) {
-			auto& a = subpasses.emplace_back();
-			a.mSubpassId = i;
-			a.mInputMaxLoc = -1;
-			a.mColorMaxLoc = -1;
-			a.mDepthStencilMaxLoc = -1;
+
+		aImageUsage |= avk::image_usage::depth_stencil_attachment;
+
+		// Create the image (by default only on the device which should be sufficient for a depth buffer => see pMemoryUsage's default value):
+		auto result = create_image(aWidth, aHeight, *aFormat, aNumLayers, aMemoryUsage, aImageUsage, std::move(aAlterConfigBeforeCreation));
+		result->mAspectFlags |= vk::ImageAspectFlagBits::eDepth;
+		return result;
+	}
+
+	image root::create_depth_stencil_image(uint32_t aWidth, uint32_t aHeight, std::optional<vk::Format> aFormat, int aNumLayers,  memory_usage aMemoryUsage, avk::image_usage aImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+	{
+		// Select a suitable depth+stencil format
+		if (!aFormat) {
+			std::array depthFormats = { vk::Format::eD32SfloatS8Uint, vk::Format::eD24UnormS8Uint, vk::Format::eD16UnormS8Uint };
+			for (auto format : depthFormats) {
+				if (is_format_supported(format, vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eDepthStencilAttachment)) {
+					aFormat = format;
+					break;
+				}
+			}
+		}
+		if (!aFormat) {
+			throw avk::runtime_error("No suitable depth+stencil format could be found.");
 		}
 
-		result.mAttachmentDescriptions.reserve(aAttachments.size());
-		for (const auto& a : aAttachments) {
-			//// Try to infer initial and final image layouts (If this isn't cool => user must use aAlterConfigBeforeCreation)
-			//vk::ImageLayout initialLayout = vk::ImageLayout::eUndefined;
-			//vk::ImageLayout finalLayout = vk::ImageLayout::eUndefined;
+		// Create the image (by default only on the device which should be sufficient for a depth+stencil buffer => see pMemoryUsage's default value):
+		auto result = create_depth_image(aWidth, aHeight, *aFormat, aNumLayers, aMemoryUsage, aImageUsage, std::move(aAlterConfigBeforeCreation));
+		result->mAspectFlags |= vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+		return result;
+	}
 
-			const auto isLoad = avk::on_load_behavior::load == a.mLoadOperation.mLoadBehavior;
-			const auto isClear = avk::on_load_behavior::clear == a.mLoadOperation.mLoadBehavior;
-			const auto isStore  = avk::on_store_behavior::store == a.mStoreOperation.mStoreBehavior;
+	image root::create_image_for_attachment(const attachment& aAttachment, uint32_t aWidth, uint32_t aHeight, int aNumLayers, avk::image_usage aAdditionalImageUsage, std::function<void(image_t&)> aAlterConfigBeforeCreation)
+	{
+		const auto attachmentUsages = avk::image_usage::color_attachment | avk::image_usage::depth_stencil_attachment | avk::image_usage::input_attachment;
+		auto imageUsage = aAdditionalImageUsage;
+		if (aAttachment.is_used_as_color_attachment()) {
+			imageUsage |= avk::image_usage::color_attachment;
+		}
+		if (aAttachment.is_used_as_depth_stencil_attachment()) {
+			imageUsage |= avk::image_usage::depth_stencil_attachment;
+		}
+		if (aAttachment.is_used_as_input_attachment()) {
+			imageUsage |= avk::image_usage::input_attachment;
+		}
 
-			const auto hasSeparateStencilLoad = a.mStencilLoadOperation.has_value();
-			const auto hasSeparateStencilStore = a.mStencilStoreOperation.has_value();
-			const auto isStencilLoad = avk::on_load_behavior::load == a.get_stencil_load_op().mLoadBehavior;
-			const auto isStencilClear = avk::on_load_behavior::clear == a.get_stencil_load_op().mLoadBehavior;
-			const auto isStencilStore  = avk::on_store_behavior::store == a.get_stencil_store_op().mStoreBehavior;
-			const auto hasStencilComponent = has_stencil_component(a.format());
+		// Contents which are neither loaded nor stored need not be backed by actual memory:
+		const bool canBeTransient = aAttachment.is_transient()
+			&& avk::image_usage{} != (imageUsage & attachmentUsages)
+			&& avk::image_usage{} == exclude(imageUsage, attachmentUsages | avk::image_usage::tiling_optimal);
 
-			const auto attachmentAspect = is_depth_format(a.format())
-				? vk::ImageAspectFlagBits::eDepth
-				: vk::ImageAspectFlagBits::eColor;
+		return create_image(aWidth, aHeight, std::make_tuple(aAttachment.format(), aAttachment.sample_count()), aNumLayers,
+			canBeTransient ? memory_usage::device_transient : memory_usage::device,
+			imageUsage, std::move(aAlterConfigBeforeCreation));
+	}
 
-			//bool initialLayoutFixed = false;
-			//auto firstUsage = a.get_first_color_depth_input();
-			//if (firstUsage.as_input()) {
-			//	if (isLoad) {
-			//		initialLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-			//		initialLayoutFixed = true;
-			//	}
-			//	if (isClear) {
-			//		initialLayoutFixed = true;
-			//	}
-			//}
-			//if (firstUsage.as_color()) { // this potentially overwrites the above
-			//	if (isLoad) {
-			//		initialLayout = vk::ImageLayout::eColorAttachmentOptimal;
-			//		initialLayoutFixed = true;
-			//	}
-			//	if (isClear) {
-			//		initialLayoutFixed = true;
-			//	}
-			//}
-			//if (firstUsage.as_depth_stencil()) {
-			//	if (isLoad) {
-			//		initialLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
-			//		{
-			//			// TODO: Set other depth/stencil-specific formats
-			//			//       - vk::ImageLayout::eDepthReadOnlyStencilAttachmentOptimal
-			//			//       - vk::ImageLayout::eDepthStencilReadOnlyOptimal
-			//			//       - vk::ImageLayout::eDepthReadOnlyOptimal
-			//			//       - vk::ImageLayout::eStencilAttachmentOptimal
-			//			//       - vk::ImageLayout::eStencilReadOnlyOptimal
-			//		}
-			//		initialLayoutFixed = true;
-			//	}
-			//	if (isClear) {
-			//		initialLayoutFixed = true;
-			//	}
-			//}
+	image_t root::wrap_image(vk::Image aImageToWrap, vk::ImageCreateInfo aImageCreateInfo, avk::image_usage aImageUsage, vk::ImageAspectFlags aImageAspectFlags)
+	{
+		auto [imageUsage, targetLayout, imageTiling, imageCreateFlags] = determine_usage_layout_tiling_flags_based_on_image_usage(aImageUsage);
 
-			//auto lastUsage = a.get_last_color_depth_input();
-			//if (lastUsage.as_input()) {
-			//	finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-			//}
-			//if (lastUsage.as_color()) { // This potentially overwrites the above
-			//	finalLayout = vk::ImageLayout::eColorAttachmentOptimal;
-			//}
-			//if (lastUsage.as_depth_stencil()) {
-			//	finalLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
-			//	{
-			//		// TODO: Set other depth/stencil-specific formats
-			//		//       - vk::ImageLayout::eDepthReadOnlyStencilAttachmentOptimal
-			//		//       - vk::ImageLayout::eDepthStencilReadOnlyOptimal
-			//		//       - vk::ImageLayout::eDepthReadOnlyOptimal
-			//		//       - vk::ImageLayout::eStencilAttachmentOptimal
-			//		//       - vk::ImageLayout::eStencilReadOnlyOptimal
-			//	}
-			//}
-			//if (isStore && vk::ImageLayout::eUndefined == finalLayout) {
-			//	if (a.is_used_as_color_attachment()) {
-			//		finalLayout = vk::ImageLayout::eColorAttachmentOptimal;
-			//	}
-			//	else if (a.is_used_as_depth_stencil_attachment()) {
-			//		finalLayout = vk::ImageLayout::eDepthReadOnlyStencilAttachmentOptimal;
-			//	}
-			//	else if (a.is_used_as_input_attachment()) {
-			//		finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-			//	}
-			//}
-			//if (vk::ImageLayout::eUndefined == finalLayout) {
-			//	// We can just guess:
-			//	finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-			//}
+		image_t result;
+		result.mRoot = this;
+		result.mCreateInfo = aImageCreateInfo;
+		result.mImage = aImageToWrap;
+		result.mImageUsage = aImageUsage;
+		result.mAspectFlags = aImageAspectFlags;
+		return result;
+	}
 
-			//if (a.shall_be_presentable()) {
-			//	finalLayout = vk::ImageLayout::ePresentSrcKHR;
-			//}
+	vk::ImageSubresourceRange image_t::entire_subresource_range() const
+	{
+		return vk::ImageSubresourceRange{
+			mAspectFlags,
+			0u, VK_REMAINING_MIP_LEVELS,	// MIP info
+			0u, VK_REMAINING_ARRAY_LAYERS	// Layers info
+		};
+	}
 
-			//if (!initialLayoutFixed && isLoad) {
-			//	initialLayout = finalLayout;
-			//}
-			//// ^^^ I have no idea what I'm assuming ^^^
+	avk::command::action_type_command image_t::generate_mip_maps(avk::layout::image_layout_transition aLayoutTransition)
+	{
+		if (create_info().mipLevels <= 1u) {
+			return {};
+		}
+		
+		auto actionTypeCommand = avk::command::action_type_command{
+			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+			{
+				std::make_tuple(handle(), avk::sync::sync_hint{
+					stage::transfer + (access::transfer_read | access::transfer_write), // This one is actually only here to establish a dependency chain to the first image layout transition
+					stage::transfer +                          access::transfer_write   // This one as well
+				})
+			},
+			[
+				lRoot = root_ptr(),
+				lImageHandle = handle(),
+				lArrayLayers = create_info().arrayLayers,
+				lWidth = static_cast<int32_t>(width()),
+				lHeight = static_cast<int32_t>(height()),
+				lAspectFlags = mAspectFlags,
+				lMipLevels = create_info().mipLevels,
+				lLayoutState = mLayoutState.get(),
+				aLayoutTransition
+			](avk::command_buffer_t& cb) {
 
-			// 1. Create the attachment descriptions
-			auto& newAttachmentDesc = result.mAttachmentDescriptions.emplace_back(vk::AttachmentDescription2KHR{}
-				.setFormat(a.format())
-				.setSamples(a.sample_count())
-				.setLoadOp(to_vk_load_op(a.mLoadOperation.mLoadBehavior))
-				.setStoreOp(to_vk_store_op(a.mStoreOperation.mStoreBehavior))
-				.setStencilLoadOp(to_vk_load_op(a.get_stencil_load_op().mLoadBehavior))
-				.setStencilStoreOp(to_vk_store_op(a.get_stencil_store_op().mStoreBehavior))
-			);
+				auto w = lWidth;
+				auto h = lHeight;
 
-			const auto attachmentIndex = static_cast<uint32_t>(result.mAttachmentDescriptions.size() - 1); // Index of this attachment as used in the further subpasses
+				// If the layouts are tracked, use the exact old layout of each subresource:
+				auto oldLayout = [lLayoutState, &aLayoutTransition](uint32_t aMipLevel, uint32_t aArrayLayer) {
+					return nullptr == lLayoutState ? aLayoutTransition.mOld.mLayout : lLayoutState->get(aMipLevel, aArrayLayer).mLayout;
+				};
 
-			// 2. Go throught the subpasses and gather data for subpass config
-			const auto nSubpasses = a.mSubpassUsages.num_subpasses();
-			if (nSubpasses != numSubpassesFirst) {
-				throw avk::runtime_error("All attachments must have the exact same number of subpasses!");
-			}
+				for (uint32_t l = 0u; l < lArrayLayers; ++l) {
+					
+					std::array layoutTransitions = { // during the loop, we'll use 1 or 2 of these
+						vk::ImageMemoryBarrier{
+							vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eTransferRead, // Memory is available AND already visible for transfer read because that has been established in establish_barrier_before_the_operation above.
+							oldLayout(0u, l), vk::ImageLayout::eTransferSrcOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, 0u, 1u, l, 1u }},
+						vk::ImageMemoryBarrier{
+							vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eTransferRead, // This is the first mip-level we're going to write to
+							oldLayout(1u, l), vk::ImageLayout::eTransferDstOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, 1u, 1u, l, 1u }},
+						vk::ImageMemoryBarrier{} // To be used in loop
+					};
 
-			// Determine and fill clear values:
-			assert(result.mAttachmentDescriptions.size() == result.mClearValues.size() + 1);
-			size_t spId = 0;
-			while (result.mAttachmentDescriptions.size() != result.mClearValues.size() && spId < nSubpasses) {
-				auto subpassUsage = a.mSubpassUsages.get_subpass_usage(spId);
-				if (subpassUsage.as_color()) {
-					result.mClearValues.emplace_back(vk::ClearColorValue{ a.clear_color() });
-				}
-				if (subpassUsage.as_depth_stencil()) {
-					result.mClearValues.emplace_back(vk::ClearDepthStencilValue{ a.depth_clear_value(), a.stencil_clear_value() });
-				}
-				++spId;
-			}
-			if (result.mAttachmentDescriptions.size() != result.mClearValues.size() ) {
-				result.mClearValues.emplace_back(); // just an empty clear value
-			}
-			assert(result.mAttachmentDescriptions.size() == result.mClearValues.size());
+					cb.handle().pipelineBarrier(
+						vk::PipelineStageFlagBits::eTransfer,
+						vk::PipelineStageFlagBits::eTransfer,
+						vk::DependencyFlags{},
+						0u, nullptr,
+						0u, nullptr,
+						2u /* initially, only 2 required */, layoutTransitions.data()
+					);
 
-			// Now go over all the sub passes and remember initial and final layouts along the way
-			std::optional<vk::ImageLayout> initialLayout{};
-			std::optional<vk::ImageLayout> finalLayout{};
-			auto useLayout = [&initialLayout, &finalLayout](vk::ImageLayout aLayout) {
-				if (!initialLayout.has_value()) {
-					initialLayout = aLayout;
-				}
-				finalLayout = aLayout;
-				return aLayout;
-			};
+					for (uint32_t i = 1u; i < lMipLevels; ++i) {
 
-			for (size_t i = 0; i < nSubpasses; ++i) {
-				auto& sp = subpasses[i];
-				auto subpassUsage = a.mSubpassUsages.get_subpass_usage(i);
-				auto subpassAspect = static_cast<bool>(subpassUsage.mAspectToBeUsed) ? subpassUsage.mAspectToBeUsed : vk::ImageAspectFlags{ attachmentAspect };
-				if (subpassUsage.as_input()) {
-					assert(!subpassUsage.has_resolve() || subpassUsage.as_color()); // Can not resolve input attachments, it's fine if it's also used as color attachment
-					if (subpassUsage.has_input_location()) {
-						auto loc = subpassUsage.input_location();
-						if (sp.mSpecificInputLocations.count(loc) != 0) {
-							throw avk::runtime_error("Layout location " + std::to_string(loc) + " is used multiple times for an input attachments in subpass " + std::to_string(i) + ". This is not allowed.");
-						}
-						sp.mSpecificInputLocations[loc] = vk::AttachmentReference2KHR{}
-							.setAttachment(attachmentIndex)
-							.setLayout(useLayout(vk::ImageLayout::eShaderReadOnlyOptimal))
-							.setAspectMask(subpassAspect);
-						sp.mInputMaxLoc = std::max(sp.mInputMaxLoc, loc);
-					}
-					else {
-						AVK_LOG_WARNING("No layout location is specified for an input attachment in subpass " + std::to_string(i) + ". This might be problematic. Consider declaring it 'unused'.");
-						sp.mUnspecifiedInputLocations.push(vk::AttachmentReference2KHR{}
-							.setAttachment(attachmentIndex)
-							.setLayout(useLayout(vk::ImageLayout::eShaderReadOnlyOptimal))
-							.setAspectMask(subpassAspect)
+						cb.handle().blitImage(
+							lImageHandle, vk::ImageLayout::eTransferSrcOptimal,
+							lImageHandle, vk::ImageLayout::eTransferDstOptimal,
+							{ vk::ImageBlit{
+								vk::ImageSubresourceLayers{ lAspectFlags, i - 1, l, 1u }, { vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ w                , h                , 1 } },
+								vk::ImageSubresourceLayers{ lAspectFlags, i    , l, 1u }, { vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ w > 1 ? w / 2 : 1, h > 1 ? h / 2 : 1, 1 } }
+							  }
+							},
+							vk::Filter::eLinear
 						);
-					}
-				}
-				if (subpassUsage.as_color()) {
-					auto resolve = subpassUsage.has_resolve();
-					if (subpassUsage.has_color_location()) {
-						auto loc = subpassUsage.color_location();
-						if (sp.mSpecificColorLocations.count(loc) != 0) {
-							throw avk::runtime_error("Layout location " + std::to_string(loc) + " is used multiple times for a color attachments in subpass " + std::to_string(i) + ". This is not allowed.");
+
+						// mip-level  i-1  is done:
+						layoutTransitions[0] = vk::ImageMemoryBarrier{
+							{}, {}, // Blit Read -> Done
+							vk::ImageLayout::eTransferSrcOptimal, aLayoutTransition.mNew.mLayout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, i - 1, 1u, l, 1u } };
+						// mip-level   i   has been transfer destination, but is going to be transfer source:
+						layoutTransitions[1] = vk::ImageMemoryBarrier{
+							vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferRead, // Blit Write -> Blit Read
+							vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, i, 1u, l, 1u } };
+						// mip-level  i+1  is entering the game:
+						layoutTransitions[2] = vk::ImageMemoryBarrier{
+							{}, vk::AccessFlagBits::eTransferWrite, // make visible to Blit Write
+							i + 1 < lMipLevels ? oldLayout(i + 1, l) : aLayoutTransition.mOld.mLayout, vk::ImageLayout::eTransferDstOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, lImageHandle, vk::ImageSubresourceRange{ lAspectFlags, i + 1, 1u, l, 1u } };
+
+						uint32_t numBarriersRequired = std::min(3u, lMipLevels - i + 1);
+						if (lMipLevels - 1 == i) {
+							layoutTransitions[1].newLayout = aLayoutTransition.mNew.mLayout; // Last one => done
 						}
-						sp.mSpecificColorLocations[loc] =	vk::AttachmentReference2KHR{}
-							.setAttachment(attachmentIndex)
-							.setLayout(useLayout(vk::ImageLayout::eColorAttachmentOptimal))
-							.setAspectMask(subpassAspect);
-						sp.mSpecificColorResolveLocations[loc] =	vk::AttachmentReference2KHR{}
-							.setAttachment(resolve ? subpassUsage.resolve_target_index() : VK_ATTACHMENT_UNUSED)
-							.setLayout(useLayout(vk::ImageLayout::eColorAttachmentOptimal))
-							.setAspectMask(subpassAspect);
-						sp.mColorMaxLoc = std::max(sp.mColorMaxLoc, loc);
-					}
-					else {
-						AVK_LOG_WARNING("No layout location is specified for a color attachment in subpass " + std::to_string(i) + ". This might be problematic. Consider declaring it 'unused'.");
-						sp.mUnspecifiedColorLocations.push(vk::AttachmentReference2KHR{}
-							.setAttachment(attachmentIndex)
-							.setLayout(useLayout(vk::ImageLayout::eColorAttachmentOptimal))
-							.setAspectMask(subpassAspect)
-						);
-						sp.mUnspecifiedColorResolveLocations.push(vk::AttachmentReference2KHR{}
-							.setAttachment(resolve ? subpassUsage.resolve_target_index() : VK_ATTACHMENT_UNUSED)
-							.setLayout(useLayout(vk::ImageLayout::eColorAttachmentOptimal))
-							.setAspectMask(subpassAspect)
-						);
-					}
-				}
-				if (subpassUsage.as_depth_stencil()) {
-					auto resolve = subpassUsage.has_resolve();
-					sp.mUnspecifiedDepthStencilLocations.push(vk::AttachmentReference2KHR{}
-						.setAttachment(attachmentIndex)
-						.setLayout(useLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal))
-						.setAspectMask(subpassAspect)
-					);
-					if (resolve) {
-						sp.mUnspecifiedDepthStencilResolveData.push(vk::SubpassDescriptionDepthStencilResolve{}
-							.setDepthResolveMode(  static_cast<bool>(subpassUsage.mResolveModeDepth)   ? static_cast<vk::ResolveModeFlagBits>(static_cast<vk::ResolveModeFlags::MaskType>(subpassUsage.mResolveModeDepth)  ) : vk::ResolveModeFlagBits::eSampleZero)
-							.setStencilResolveMode(static_cast<bool>(subpassUsage.mResolveModeStencil) ? static_cast<vk::ResolveModeFlagBits>(static_cast<vk::ResolveModeFlags::MaskType>(subpassUsage.mResolveModeStencil)) : vk::ResolveModeFlagBits::eSampleZero)
-							// pDepthStencilResolveAttachment to be set later to aligned vector   vvv   never forgetti!
-						);
-						sp.mUnspecifiedDepthStencilResolveRefs.push(vk::AttachmentReference2KHR{}
-							.setAttachment(resolve ? subpassUsage.resolve_target_index() : VK_ATTACHMENT_UNUSED)
-							.setLayout(useLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal))
-							.setAspectMask(subpassAspect)
+
+						cb.handle().pipelineBarrier(
+							vk::PipelineStageFlagBits::eTransfer,
+							vk::PipelineStageFlagBits::eTransfer, // Dependency from previous BLIT to subsequent BLIT
+							vk::DependencyFlags{},
+							0u, nullptr,
+							0u, nullptr,
+							numBarriersRequired, layoutTransitions.data()
 						);
+
+						w = w > 1 ? w / 2 : 1;
+						h = h > 1 ? h / 2 : 1;
 					}
 				}
-				if (subpassUsage.as_preserve()) {
-					assert(!subpassUsage.has_resolve() || subpassUsage.as_color()); // Can not resolve input attachments, it's fine if it's also used as color attachment
-					assert(!subpassUsage.as_input() && !subpassUsage.as_color() && !subpassUsage.as_depth_stencil()); // Makes no sense to preserve and use as something else
-					sp.mPreserveAttachments.push_back(attachmentIndex);
-				}
-				if (subpassUsage.as_unused()) {
-					for (const auto& aaaarr : aAttachments) {
-						if (aaaarr.mSubpassUsages.get_subpass_usage(i).resolve_target_index() == attachmentIndex) { // Talkin 'bout me, bro?
-							if (aaaarr.mSubpassUsages.get_subpass_usage(i).as_color()) {
-								useLayout(vk::ImageLayout::eColorAttachmentOptimal);
-							}
-							else if (aaaarr.mSubpassUsages.get_subpass_usage(i).as_depth_stencil()) {
-								useLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
-							}
-						}
-					}
+
+				if (nullptr != lLayoutState) {
+					lLayoutState->set(vk::ImageSubresourceRange{ lAspectFlags, 0u, lMipLevels, 0u, lArrayLayers }, subresource_state{ aLayoutTransition.mNew.mLayout });
 				}
 			}
+		};
+		actionTypeCommand.mUpdatesTrackedLayouts = static_cast<bool>(mLayoutState);
 
-			// Now that we have found all the subpass data => set initial and final layouts
-			newAttachmentDesc
-				.setInitialLayout(a.mLoadOperation.mPreviousLayout.has_value() ? a.mLoadOperation.mPreviousLayout.value().mLayout : initialLayout.value_or(vk::ImageLayout::eUndefined))
-				.setFinalLayout(  a.mStoreOperation.mTargetLayout.has_value()  ? a.mStoreOperation.mTargetLayout.value().mLayout  : finalLayout.value_or(  vk::ImageLayout::eUndefined));
+		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+		return actionTypeCommand;
+	}
+
+	void image_t::enable_layout_tracking(vk::ImageLayout aCurrentLayout)
+	{
+		if (mLayoutState) {
+			// Reset in place, because pointers to the state might have been handed out already (e.g., to recorded commands):
+			*mLayoutState = image_layout_state{ create_info().mipLevels, create_info().arrayLayers, aCurrentLayout };
+			return;
 		}
+		mLayoutState = std::make_unique<image_layout_state>(create_info().mipLevels, create_info().arrayLayers, aCurrentLayout);
+	}
 
-		// 3. Fill all the vectors in the right order:
-		const auto unusedAttachmentRef = vk::AttachmentReference2KHR{}.setAttachment(VK_ATTACHMENT_UNUSED);
-		result.mSubpassData.reserve(numSubpassesFirst);
-		for (size_t i = 0; i < numSubpassesFirst; ++i) {
-			auto& a = subpasses[i];
-			auto& b = result.mSubpassData.emplace_back();
-			assert(result.mSubpassData.size() == i + 1);
-			// INPUT ATTACHMENTS
-			for (int loc = 0; loc <= a.mInputMaxLoc || !a.mUnspecifiedInputLocations.empty(); ++loc) {
-				if (a.mSpecificInputLocations.count(loc) > 0) {
-					assert (a.mSpecificInputLocations.count(loc) == 1);
-					b.mOrderedInputAttachmentRefs.push_back(a.mSpecificInputLocations[loc]);
-				}
-				else {
-					if (!a.mUnspecifiedInputLocations.empty()) {
-						b.mOrderedInputAttachmentRefs.push_back(a.mUnspecifiedInputLocations.front());
-						a.mUnspecifiedInputLocations.pop();
-					}
-					else {
-						b.mOrderedInputAttachmentRefs.push_back(unusedAttachmentRef);
-					}
-				}
+	vk::ImageLayout image_t::current_layout(uint32_t aMipLevel, uint32_t aArrayLayer) const
+	{
+		if (!mLayoutState) {
+			throw avk::logic_error("Layout tracking has not been enabled for this image. Invoke enable_layout_tracking first.");
+		}
+		return mLayoutState->get(aMipLevel, aArrayLayer).mLayout;
+	}
+#pragma endregion
+
+#pragma region image view definitions
+	image_view root::create_image_view_from_template(const image_view_t& aTemplate, std::function<void(image_t&)> aAlterImageConfigBeforeCreation, std::function<void(image_view_t&)> aAlterImageViewConfigBeforeCreation)
+	{
+		image_view_t result;
+
+		// Transfer ownership:
+		if (std::holds_alternative<image>(aTemplate.mImage)) {
+			auto& im = std::get<image>(aTemplate.mImage);
+			result.mImage = create_image_from_template(*im, std::move(aAlterImageConfigBeforeCreation));
+			if (im.is_shared_ownership_enabled()) {
+				std::get<image>(result.mImage).enable_shared_ownership();
 			}
-			// COLOR ATTACHMENTS
-			for (int loc = 0; loc <= a.mColorMaxLoc || !a.mUnspecifiedColorLocations.empty(); ++loc) {
-				if (a.mSpecificColorLocations.count(loc) > 0) {
-					assert (a.mSpecificColorLocations.count(loc) == 1);
-					assert (a.mSpecificColorResolveLocations.count(loc) == 1);
-					b.mOrderedColorAttachmentRefs.push_back(a.mSpecificColorLocations[loc]);
-					b.mOrderedColorResolveAttachmentRefs.push_back(a.mSpecificColorResolveLocations[loc]);
-				}
-				else {
-					if (!a.mUnspecifiedColorLocations.empty()) {
-						assert(a.mUnspecifiedColorLocations.size() == a.mUnspecifiedColorResolveLocations.size());
-						b.mOrderedColorAttachmentRefs.push_back(a.mUnspecifiedColorLocations.front());
-						a.mUnspecifiedColorLocations.pop();
-						b.mOrderedColorResolveAttachmentRefs.push_back(a.mUnspecifiedColorResolveLocations.front());
-						a.mUnspecifiedColorResolveLocations.pop();
-					}
-					else {
-						b.mOrderedColorAttachmentRefs.push_back(unusedAttachmentRef);
-						b.mOrderedColorResolveAttachmentRefs.push_back(unusedAttachmentRef);
-					}
+		}
+		else {
+			AVK_LOG_ERROR("Can not create an image_view from a template which wraps an image_t.");
+		}
+
+		result.mCreateInfo = aTemplate.mCreateInfo;
+		result.mCreateInfo.setImage(result.get_image().handle());
+		result.mCreateInfo.subresourceRange
+			.setLevelCount(result.get_image().create_info().mipLevels)
+			.setLayerCount(result.get_image().create_info().arrayLayers);
+
+		result.mUsageInfo = aTemplate.mUsageInfo;
+
+		// Maybe alter the config?!
+		if (aAlterImageViewConfigBeforeCreation) {
+			aAlterImageViewConfigBeforeCreation(result);
+		}
+
+		result.mImageView = device().createImageViewUnique(result.mCreateInfo, nullptr, dispatch_loader_core());
+
+		return result;
+	}
+
+
+	image_view root::create_image_view(avk::image aImage, std::optional<vk::Format> aViewFormat, std::optional<avk::image_usage> aImageViewUsage, std::function<void(image_view_t&)> aAlterConfigBeforeCreation)
+	{
+		image_view_t result;
+
+		// Transfer ownership:
+		result.mImage = std::move(aImage);
+
+		// What's the format of the image view?
+		if (!aViewFormat.has_value()) {
+			aViewFormat = result.get_image().format();
+		}
+
+		finish_configuration(result, aViewFormat.value(), {}, aImageViewUsage, std::move(aAlterConfigBeforeCreation));
+
+		return result;
+	}
+
+	image_view root::create_depth_image_view(avk::image aImage, std::optional<vk::Format> aViewFormat, std::optional<avk::image_usage> aImageViewUsage, std::function<void(image_view_t&)> aAlterConfigBeforeCreation)
+	{
+		image_view_t result;
+
+		// Transfer ownership:
+		result.mImage = std::move(aImage);
+
+		// What's the format of the image view?
+		if (!aViewFormat.has_value()) {
+			aViewFormat = result.get_image().format();
+		}
+
+		finish_configuration(result, aViewFormat.value(), vk::ImageAspectFlagBits::eDepth, aImageViewUsage, std::move(aAlterConfigBeforeCreation));
+
+		return result;
+	}
+
+	image_view root::create_stencil_image_view(avk::image aImage, std::optional<vk::Format> aViewFormat, std::optional<avk::image_usage> aImageViewUsage, std::function<void(image_view_t&)> aAlterConfigBeforeCreation)
+	{
+		image_view_t result;
+
+		// Transfer ownership:
+		result.mImage = std::move(aImage);
+
+		// What's the format of the image view?
+		if (!aViewFormat.has_value()) {
+			aViewFormat = result.get_image().format();
+		}
+
+		finish_configuration(result, aViewFormat.value(), vk::ImageAspectFlagBits::eStencil, aImageViewUsage, std::move(aAlterConfigBeforeCreation));
+
+		return result;
+	}
+
+	image_view root::create_image_view(image_t aImageToWrap, std::optional<vk::Format> aViewFormat, std::optional<avk::image_usage> aImageViewUsage)
+	{
+		image_view_t result;
+
+		// Transfer ownership:
+		result.mImage = image_view_t::helper_t( std::move(aImageToWrap) );
+
+		// What's the format of the image view?
+		if (!aViewFormat.has_value()) {
+			aViewFormat = result.get_image().format();
+		}
+
+		finish_configuration(result, aViewFormat.value(), {}, aImageViewUsage, nullptr);
+
+		return result;
+	}
+
+	void root::finish_configuration(image_view_t& aImageView, vk::Format aViewFormat, std::optional<vk::ImageAspectFlags> aImageAspectFlags, std::optional<avk::image_usage> aImageViewUsage, std::function<void(image_view_t&)> aAlterConfigBeforeCreation)
+	{
+		if (!aImageAspectFlags.has_value()) {
+			const auto imageFormat = aImageView.get_image().create_info().format;
+			aImageAspectFlags = aImageView.get_image().aspect_flags();
+
+			if (is_depth_format(imageFormat)) {
+				if (has_stencil_component(imageFormat)) {
+					AVK_LOG_ERROR("Can infer whether the image view shall refer to the depth component or to the stencil component => State it explicitly by using image_view_t::create_depth or image_view_t::create_stencil");
 				}
+				aImageAspectFlags = vk::ImageAspectFlagBits::eDepth;
+				// TODO: use vk::ImageAspectFlagBits' underlying type and exclude eStencil rather than only setting eDepth!
 			}
-			// DEPTH/STENCIL ATTACHMENTS
-			for (int loc = 0; loc <= a.mDepthStencilMaxLoc || !a.mUnspecifiedDepthStencilLocations.empty(); ++loc) {
-				if (!a.mUnspecifiedDepthStencilLocations.empty()) {
-					b.mOrderedDepthStencilAttachmentRefs.push_back(a.mUnspecifiedDepthStencilLocations.front());
-					a.mUnspecifiedDepthStencilLocations.pop();
-					if (!a.mUnspecifiedDepthStencilResolveRefs.empty()) {
-						assert(a.mUnspecifiedDepthStencilResolveRefs.size() == a.mUnspecifiedDepthStencilResolveData.size());
-						b.mOrderedDepthStencilResolveAttachmentRefs.push_back(a.mUnspecifiedDepthStencilResolveRefs.front());
-						a.mUnspecifiedDepthStencilResolveRefs.pop();
-						b.mOrderedDepthStencilResolveAttachmentData.push_back(a.mUnspecifiedDepthStencilResolveData.front());
-						a.mUnspecifiedDepthStencilResolveData.pop();
-					}
-				}
-				else {
-					b.mOrderedDepthStencilAttachmentRefs.push_back(unusedAttachmentRef);
-				}
+			else if(has_stencil_component(imageFormat)) {
+				aImageAspectFlags = vk::ImageAspectFlagBits::eStencil;
+				// TODO: use vk::ImageAspectFlagBits' underlying type and exclude eDepth rather than only setting eStencil!
 			}
-			b.mPreserveAttachments = std::move(a.mPreserveAttachments);
+		}
 
-			// SOME SANITY CHECKS:
-			// - The color resolve attachments must either be empty or there must be a entry for each color attachment
-			assert(b.mOrderedColorResolveAttachmentRefs.empty() || b.mOrderedColorResolveAttachmentRefs.size() == b.mOrderedColorAttachmentRefs.size());
-			// - The depth/stencil resolve attachments must either be empty or there must be a entry for each depth/stencil attachment
-			assert(b.mOrderedDepthStencilResolveAttachmentRefs.empty() || b.mOrderedDepthStencilResolveAttachmentRefs.size() == b.mOrderedDepthStencilAttachmentRefs.size());
-			// - There must not be more than 1 depth/stencil attachements
-			assert(b.mOrderedDepthStencilAttachmentRefs.size() <= 1);
+		// Proceed with config creation (and use the imageAspectFlags there):
+		aImageView.mCreateInfo = vk::ImageViewCreateInfo{}
+			.setImage(aImageView.get_image().handle())
+			.setViewType(to_image_view_type(aImageView.get_image().create_info()))
+			.setFormat(aViewFormat)
+			.setComponents(vk::ComponentMapping() // The components field allows you to swizzle the color channels around. In our case we'll stick to the default mapping. [3]
+							  .setR(vk::ComponentSwizzle::eIdentity)
+							  .setG(vk::ComponentSwizzle::eIdentity)
+							  .setB(vk::ComponentSwizzle::eIdentity)
+							  .setA(vk::ComponentSwizzle::eIdentity))
+			.setSubresourceRange(vk::ImageSubresourceRange() // The subresourceRange field describes what the image's purpose is and which part of the image should be accessed. Our images will be used as color targets without any mipmapping levels or multiple layers. [3]
+				.setAspectMask(aImageAspectFlags.value())
+				.setBaseMipLevel(0u)
+				.setLevelCount(aImageView.get_image().create_info().mipLevels)
+				.setBaseArrayLayer(0u)
+				.setLayerCount(aImageView.get_image().create_info().arrayLayers));
+
+		if (aImageViewUsage.has_value()) {
+			auto [imageUsage, imageLayout, imageTiling, imageCreateFlags] = determine_usage_layout_tiling_flags_based_on_image_usage(aImageViewUsage.value());
+			aImageView.mUsageInfo = vk::ImageViewUsageCreateInfo()
+				.setUsage(imageUsage);
+			aImageView.mCreateInfo.setPNext(&aImageView.mUsageInfo);
+		}
+
+		// Maybe alter the config?!
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(aImageView);
 		}
 
-		// Done with the helper structure:
-		subpasses.clear();
+		aImageView.mImageView = device().createImageViewUnique(aImageView.mCreateInfo, nullptr, dispatch_loader_core());
+	}
+#pragma endregion
+
+#pragma region sampler and image sampler definitions
+	sampler root::create_sampler(filter_mode aFilterMode, std::array<border_handling_mode, 3> aBorderHandlingModes, float aMipMapMaxLod, std::function<void(sampler_t&)> aAlterConfigBeforeCreation)
+	{
+		vk::Filter magFilter;
+		vk::Filter minFilter;
+		vk::SamplerMipmapMode mipmapMode;
+		vk::Bool32 enableAnisotropy = VK_FALSE;
+		float maxAnisotropy = 1.0f;
+		switch (aFilterMode)
+		{
+		case filter_mode::nearest_neighbor:
+			magFilter = vk::Filter::eNearest;
+			minFilter = vk::Filter::eNearest;
+			mipmapMode = vk::SamplerMipmapMode::eNearest;
+			break;
+		case filter_mode::bilinear:
+			magFilter = vk::Filter::eLinear;
+			minFilter = vk::Filter::eLinear;
+			mipmapMode = vk::SamplerMipmapMode::eNearest;
+			break;
+		case filter_mode::trilinear:
+			magFilter = vk::Filter::eLinear;
+			minFilter = vk::Filter::eLinear;
+			mipmapMode = vk::SamplerMipmapMode::eLinear;
+			break;
+		case filter_mode::cubic: // I have no idea what I'm doing.
+			magFilter = vk::Filter::eCubicIMG;
+			minFilter = vk::Filter::eCubicIMG;
+			mipmapMode = vk::SamplerMipmapMode::eLinear;
+			break;
+		case filter_mode::anisotropic_2x:
+			magFilter = vk::Filter::eLinear;
+			minFilter = vk::Filter::eLinear;
+			mipmapMode = vk::SamplerMipmapMode::eLinear;
+			enableAnisotropy = VK_TRUE;
+			maxAnisotropy = 2.0f;
+			break;
+		case filter_mode::anisotropic_4x:
+			magFilter = vk::Filter::eLinear;
+			minFilter = vk::Filter::eLinear;
+			mipmapMode = vk::SamplerMipmapMode::eLinear;
+			enableAnisotropy = VK_TRUE;
+			maxAnisotropy = 4.0f;
+			break;
+		case filter_mode::anisotropic_8x:
+			magFilter = vk::Filter::eLinear;
+			minFilter = vk::Filter::eLinear;
+			mipmapMode = vk::SamplerMipmapMode::eLinear;
+			enableAnisotropy = VK_TRUE;
+			maxAnisotropy = 8.0f;
+			break;
+		case filter_mode::anisotropic_16x:
+			magFilter = vk::Filter::eLinear;
+			minFilter = vk::Filter::eLinear;
+			mipmapMode = vk::SamplerMipmapMode::eLinear;
+			enableAnisotropy = VK_TRUE;
+			maxAnisotropy = 16.0f;
+			break;
+		case filter_mode::anisotropic_32x:
+			magFilter = vk::Filter::eLinear;
+			minFilter = vk::Filter::eLinear;
+			mipmapMode = vk::SamplerMipmapMode::eLinear;
+			enableAnisotropy = VK_TRUE;
+			maxAnisotropy = 32.0f;
+			break;
+		case filter_mode::anisotropic_64x:
+			magFilter = vk::Filter::eLinear;
+			minFilter = vk::Filter::eLinear;
+			mipmapMode = vk::SamplerMipmapMode::eLinear;
+			enableAnisotropy = VK_TRUE;
+			maxAnisotropy = 64.0f;
+			break;
+		default:
+			throw avk::runtime_error("invalid filter_mode");
+		}
+
+		// Determine how to handle the borders:
+		std::array<vk::SamplerAddressMode, 3> addressModes{};
+		for (int i = 0; i < 3; ++i) {
+			switch (aBorderHandlingModes[i])
+			{
+			case border_handling_mode::clamp_to_edge:
+				addressModes[i] = vk::SamplerAddressMode::eClampToEdge;
+				break;
+			case border_handling_mode::mirror_clamp_to_edge:
+				addressModes[i] = vk::SamplerAddressMode::eMirrorClampToEdge;
+				break;
+			case border_handling_mode::clamp_to_border:
+				addressModes[i] = vk::SamplerAddressMode::eClampToBorder;
+				break;
+			case border_handling_mode::repeat:
+				addressModes[i] = vk::SamplerAddressMode::eRepeat;
+				break;
+			case border_handling_mode::mirrored_repeat:
+				addressModes[i] = vk::SamplerAddressMode::eMirroredRepeat;
+				break;
+			default:
+				throw avk::runtime_error("invalid border_handling_mode at index " + std::to_string(i) + (0 == i ? " (address mode u)" : 1 == i ? " (address mode v)" : " (address mode w)"));
+			}
+		}
+
+		// Compile the config for this sampler:
+		sampler_t result;
+		result.mCreateInfo = vk::SamplerCreateInfo()
+			.setMagFilter(magFilter)
+			.setMinFilter(minFilter)
+			.setAddressModeU(addressModes[0])
+			.setAddressModeV(addressModes[1])
+			.setAddressModeW(addressModes[2])
+			.setAnisotropyEnable(enableAnisotropy)
+			.setMaxAnisotropy(maxAnisotropy)
+			.setBorderColor(vk::BorderColor::eFloatOpaqueBlack)
+			// The unnormalizedCoordinates field specifies which coordinate system you want to use to address texels in an image.
+			// If this field is VK_TRUE, then you can simply use coordinates within the [0, texWidth) and [0, texHeight) range.
+			// If it is VK_FALSE, then the texels are addressed using the [0, 1) range on all axes. Real-world applications almost
+			// always use normalized coordinates, because then it's possible to use textures of varying resolutions with the exact
+			// same coordinates. [4]
+			.setUnnormalizedCoordinates(VK_FALSE)
+			// If a comparison function is enabled, then texels will first be compared to a value, and the result of that comparison
+			// is used in filtering operations. This is mainly used for percentage-closer filtering on shadow maps. [4]
+			.setCompareEnable(VK_FALSE)
+			.setCompareOp(vk::CompareOp::eAlways)
+			.setMipmapMode(mipmapMode)
+			.setMipLodBias(0.0f)
+			.setMinLod(0.0f)
+			.setMaxLod(aMipMapMaxLod);
+
+		// Call custom config function
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		result.mSampler = device().createSamplerUnique(result.create_info(), nullptr, dispatch_loader_core());
+		result.mDescriptorInfo = vk::DescriptorImageInfo{}
+			.setSampler(result.handle());
+		result.mDescriptorType = vk::DescriptorType::eSampler;
+		return result;
+	}
+
+	image_sampler root::create_image_sampler(image_view aImageView, sampler aSampler)
+	{
+		image_sampler_t result;
+		result.mImageView = std::move(aImageView);
+		result.mSampler = std::move(aSampler);
+		return result;
+	}
+#pragma endregion
+
+#pragma region input description definitions
+	input_description input_description::declare(std::initializer_list<input_binding_to_location_mapping> aBindings)
+	{
+		input_description result;
+
+		for (const auto& bindingLoc : aBindings) {
+			auto& bfr = result.mInputBuffers[bindingLoc.mGeneralData.mBinding];
+			// Create if it doesn't exist
+			if (std::holds_alternative<std::monostate>(bfr)) {
+				switch (bindingLoc.mGeneralData.mKind)
+				{
+				case vertex_input_buffer_binding::kind::vertex:
+					bfr = vertex_buffer_meta::create_from_element_size(bindingLoc.mGeneralData.mStride);
+					break;
+				case vertex_input_buffer_binding::kind::instance:
+					bfr = instance_buffer_meta::create_from_element_size(bindingLoc.mGeneralData.mStride);
+					break;
+				default:
+					throw avk::runtime_error("Invalid input_binding_location_data::kind value");
+				}
+			}
+
+#if defined(_DEBUG)
+			// It exists => perform some sanity checks:
+			if (std::holds_alternative<std::monostate>(bfr)
+				|| (vertex_input_buffer_binding::kind::vertex == bindingLoc.mGeneralData.mKind && std::holds_alternative<instance_buffer_meta>(bfr))
+				|| (vertex_input_buffer_binding::kind::instance == bindingLoc.mGeneralData.mKind && std::holds_alternative<vertex_buffer_meta>(bfr))
+				) {
+				throw avk::logic_error("All locations of the same binding must come from the same buffer type (vertex buffer or instance buffer).");
+			}
+#endif
+
+			if (std::holds_alternative<vertex_buffer_meta>(bfr)) {
+				std::get<vertex_buffer_meta>(bfr).describe_member(
+					bindingLoc.mMemberMetaData.mOffset,
+					bindingLoc.mMemberMetaData.mFormat);
+			}
+			else { // must be instance_buffer_meta
+				std::get<instance_buffer_meta>(bfr).describe_member(
+					bindingLoc.mMemberMetaData.mOffset,
+					bindingLoc.mMemberMetaData.mFormat);
+			}
+		}
+
+		return result;
+	}
+#pragma endregion
+
+#pragma region queue definitions
+	std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> queue::find_queue_families_for_criteria(
+		vk::PhysicalDevice aPhysicalDevice,
+		vk::QueueFlags aRequiredFlags,
+		vk::QueueFlags aForbiddenFlags,
+		std::optional<vk::SurfaceKHR> aSurface)
+	{
+		assert(aPhysicalDevice);
+		// All queue families:
+		auto queueFamilies = aPhysicalDevice.getQueueFamilyProperties();
+		std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> indexedQueueFamilies;
+		std::transform(std::begin(queueFamilies), std::end(queueFamilies),
+					   std::back_inserter(indexedQueueFamilies),
+					   [index = uint32_t(0)](const decltype(queueFamilies)::value_type& input) mutable {
+						   auto tpl = std::make_tuple(index, input);
+						   index += 1;
+						   return tpl;
+					   });
+		// Subset to which the criteria applies:
+		std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> selection;
+		// Select the subset
+		std::copy_if(std::begin(indexedQueueFamilies), std::end(indexedQueueFamilies),
+					 std::back_inserter(selection),
+					 [aPhysicalDevice, aRequiredFlags, aForbiddenFlags, aSurface](const std::tuple<uint32_t, decltype(queueFamilies)::value_type>& tpl) {
+						 bool requirementsMet = true;
+						 if (aRequiredFlags) {
+							 requirementsMet = requirementsMet && ((std::get<1>(tpl).queueFlags & aRequiredFlags) == aRequiredFlags);
+						 }
+						 if (aForbiddenFlags) {
+							 requirementsMet = requirementsMet && ((std::get<1>(tpl).queueFlags & aForbiddenFlags) != aForbiddenFlags);
+						 }
+						 if (aSurface) {
+							 requirementsMet = requirementsMet && (aPhysicalDevice.getSurfaceSupportKHR(std::get<0>(tpl), *aSurface));
+						 }
+						 return requirementsMet;
+					 });
+		return selection;
+	}
+
+	std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> queue::find_best_queue_family_for(
+		vk::PhysicalDevice aPhysicalDevice,
+		vk::QueueFlags aRequiredFlags,
+		queue_selection_preference aQueueSelectionPreference,
+		std::optional<vk::SurfaceKHR> aSurface
+	)
+	{
+		static std::array queueTypes = {
+			vk::QueueFlagBits::eGraphics,
+			vk::QueueFlagBits::eCompute,
+			vk::QueueFlagBits::eTransfer,
+		};
+		// sparse binding and protected bits are ignored, for now
+
+		std::vector<std::tuple<uint32_t, vk::QueueFamilyProperties>> selection;
+
+		switch (aQueueSelectionPreference) {
+		case queue_selection_preference::specialized_queue:
+			{
+				vk::QueueFlags forbiddenFlags = {};
+				for (auto f : queueTypes) { // TODO: Maybe a different loosening order would be better?
+					forbiddenFlags |= f;
+				}
+				forbiddenFlags &= ~aRequiredFlags;
+
+				int32_t loosenIndex = 0;
+
+				while (loosenIndex <= queueTypes.size()) { // might result in returning an empty selection
+					selection = queue::find_queue_families_for_criteria(aPhysicalDevice, aRequiredFlags, forbiddenFlags, aSurface);
+					if (selection.size() > 0 || loosenIndex == queueTypes.size()) {
+						break;
+					}
+					forbiddenFlags = forbiddenFlags & ~queueTypes[loosenIndex++]; // gradually loosen restrictions
+				}
+			}
+			break;
+		case queue_selection_preference::versatile_queue:
+			{
+				vk::QueueFlags additionalVersatileFlags = {};
+				for (auto f : queueTypes) { // TODO: Maybe a different addition order would be better?
+					additionalVersatileFlags |= f;
+				}
+
+				int32_t loosenIndex = 0;
+
+				while (loosenIndex <= queueTypes.size()) {
+					selection = queue::find_queue_families_for_criteria(aPhysicalDevice, aRequiredFlags | additionalVersatileFlags, vk::QueueFlags{}, aSurface);
+					if (selection.size() > 0 || loosenIndex == queueTypes.size()) {
+						break;
+					}
+					additionalVersatileFlags = additionalVersatileFlags & ~queueTypes[loosenIndex++]; // gradually loosen versatile-additions
+				}
+			}
+			break;
+		}
+
+		return selection;
+	}
+
+	uint32_t queue::select_queue_family_index(
+		vk::PhysicalDevice aPhysicalDevice,
+		vk::QueueFlags aRequiredFlags,
+		queue_selection_preference aQueueSelectionPreference,
+		std::optional<vk::SurfaceKHR> aSupportForSurface
+	)
+	{
+		auto families = find_best_queue_family_for(aPhysicalDevice, aRequiredFlags, aQueueSelectionPreference, aSupportForSurface);
+		if (families.size() == 0) {
+			throw avk::runtime_error("Couldn't find queue families satisfying the given criteria.");
+		}
+
+		uint32_t familyIndex = std::get<0>(families[0]);
+		return familyIndex;
+	}
+
+	queue queue::prepare(
+		avk::root* aRoot,
+		uint32_t aQueueFamilyIndex,
+		uint32_t aQueueIndex,
+		float aQueuePriority
+	)
+	{
+		auto queueFamilies = aRoot->physical_device().getQueueFamilyProperties();
+		if (queueFamilies.size() <= aQueueFamilyIndex) {
+			throw avk::runtime_error("Invalid queue family index in queue::prepare");
+		}
+		if (queueFamilies[aQueueFamilyIndex].queueCount <= aQueueIndex) {
+			throw avk::runtime_error("Queue family #" + std::to_string(aQueueFamilyIndex) + " does not provide enough queues (requested index: " + std::to_string(aQueueIndex) + ")");
+		}
+
+		queue result;
+		result.mRoot = aRoot;
+		result.mQueueFamilyIndex = aQueueFamilyIndex;
+		result.mQueueIndex = aQueueIndex;
+		result.mPriority = aQueuePriority;
+		result.mQueue = nullptr;
+		return result;
+	}
+
+	void queue::assign_handle()
+	{
+		mQueue = mRoot->device().getQueue(mQueueFamilyIndex, mQueueIndex);
+	}
+
+	avk::submission_data queue::submit(avk::command_buffer_t& aCommandBuffer) const
+	{
+		return avk::submission_data(mRoot, aCommandBuffer, *this);
+	}
+
+	bool queue::is_prepared() const
+	{
+		return nullptr != mRoot && static_cast<bool>(mRoot->physical_device());
+	}
+#pragma endregion
+
+#pragma region ray tracing pipeline definitions
+#if VK_HEADER_VERSION >= 135
+	triangles_hit_group triangles_hit_group::create_with_rahit_only(shader_info aAnyHitShader)
+	{
+		if (aAnyHitShader.mShaderType != shader_type::any_hit) {
+			throw avk::runtime_error("Shader is not of type shader_type::any_hit");
+		}
+		return triangles_hit_group { std::move(aAnyHitShader), std::nullopt };
+	}
+
+	triangles_hit_group triangles_hit_group::create_with_rchit_only(shader_info aClosestHitShader)
+	{
+		if (aClosestHitShader.mShaderType != shader_type::closest_hit) {
+			throw avk::runtime_error("Shader is not of type shader_type::closest_hit");
+		}
+		return triangles_hit_group { std::nullopt, std::move(aClosestHitShader) };
+	}
+
+	triangles_hit_group triangles_hit_group::create_with_rahit_and_rchit(shader_info aAnyHitShader, shader_info aClosestHitShader)
+	{
+		if (aAnyHitShader.mShaderType != shader_type::any_hit) {
+			throw avk::runtime_error("Shader is not of type shader_type::any_hit");
+		}
+		if (aClosestHitShader.mShaderType != shader_type::closest_hit) {
+			throw avk::runtime_error("Shader is not of type shader_type::closest_hit");
+		}
+		return triangles_hit_group { std::move(aAnyHitShader), std::move(aClosestHitShader) };
+	}
+
+	triangles_hit_group triangles_hit_group::create_with_rahit_only(std::string aAnyHitShaderPath)
+	{
+		return create_with_rahit_only(
+			shader_info::describe(std::move(aAnyHitShaderPath), "main", false, shader_type::any_hit)
+		);
+	}
+
+	triangles_hit_group triangles_hit_group::create_with_rchit_only(std::string aClosestHitShaderPath)
+	{
+		return create_with_rchit_only(
+			shader_info::describe(std::move(aClosestHitShaderPath), "main", false, shader_type::closest_hit)
+		);
+	}
+
+	triangles_hit_group triangles_hit_group::create_with_rahit_and_rchit(std::string aAnyHitShaderPath, std::string aClosestHitShaderPath)
+	{
+		return create_with_rahit_and_rchit(
+			shader_info::describe(std::move(aAnyHitShaderPath), "main", false, shader_type::any_hit),
+			shader_info::describe(std::move(aClosestHitShaderPath), "main", false, shader_type::closest_hit)
+		);
+	}
+
+
+	procedural_hit_group procedural_hit_group::create_with_rint_only(shader_info aIntersectionShader)
+	{
+		if (aIntersectionShader.mShaderType != shader_type::intersection) {
+			throw avk::runtime_error("Shader is not of type shader_type::intersection");
+		}
+		return procedural_hit_group { std::move(aIntersectionShader), std::nullopt, std::nullopt };
+	}
+
+	procedural_hit_group procedural_hit_group::create_with_rint_and_rahit(shader_info aIntersectionShader, shader_info aAnyHitShader)
+	{
+		if (aIntersectionShader.mShaderType != shader_type::intersection) {
+			throw avk::runtime_error("Shader is not of type shader_type::intersection");
+		}
+		if (aAnyHitShader.mShaderType != shader_type::any_hit) {
+			throw avk::runtime_error("Shader is not of type shader_type::any_hit");
+		}
+		return procedural_hit_group { std::move(aIntersectionShader), std::move(aAnyHitShader), std::nullopt };
+	}
+
+	procedural_hit_group procedural_hit_group::create_with_rint_and_rchit(shader_info aIntersectionShader, shader_info aClosestHitShader)
+	{
+		if (aIntersectionShader.mShaderType != shader_type::intersection) {
+			throw avk::runtime_error("Shader is not of type shader_type::intersection");
+		}
+		if (aClosestHitShader.mShaderType != shader_type::closest_hit) {
+			throw avk::runtime_error("Shader is not of type shader_type::closest_hit");
+		}
+		return procedural_hit_group { std::move(aIntersectionShader), std::nullopt, std::move(aClosestHitShader) };
+	}
+
+	procedural_hit_group procedural_hit_group::create_with_rint_and_rahit_and_rchit(shader_info aIntersectionShader, shader_info aAnyHitShader, shader_info aClosestHitShader)
+	{
+		if (aIntersectionShader.mShaderType != shader_type::intersection) {
+			throw avk::runtime_error("Shader is not of type shader_type::intersection");
+		}
+		if (aAnyHitShader.mShaderType != shader_type::any_hit) {
+			throw avk::runtime_error("Shader is not of type shader_type::any_hit");
+		}
+		if (aClosestHitShader.mShaderType != shader_type::closest_hit) {
+			throw avk::runtime_error("Shader is not of type shader_type::closest_hit");
+		}
+		return procedural_hit_group { std::move(aIntersectionShader), std::move(aAnyHitShader), std::move(aClosestHitShader) };
+	}
+
+	procedural_hit_group procedural_hit_group::create_with_rint_only(std::string aIntersectionShader)
+	{
+		return create_with_rint_only(
+			shader_info::describe(std::move(aIntersectionShader), "main", false, shader_type::intersection)
+		);
+	}
+
+	procedural_hit_group procedural_hit_group::create_with_rint_and_rahit(std::string aIntersectionShader, std::string aAnyHitShader)
+	{
+		return create_with_rint_and_rahit(
+			shader_info::describe(std::move(aIntersectionShader), "main", false, shader_type::intersection),
+			shader_info::describe(std::move(aAnyHitShader), "main", false, shader_type::any_hit)
+		);
+	}
+
+	procedural_hit_group procedural_hit_group::create_with_rint_and_rchit(std::string aIntersectionShader, std::string aClosestHitShader)
+	{
+		return create_with_rint_and_rchit(
+			shader_info::describe(std::move(aIntersectionShader), "main", false, shader_type::intersection),
+			shader_info::describe(std::move(aClosestHitShader), "main", false, shader_type::closest_hit)
+		);
+	}
+
+	procedural_hit_group procedural_hit_group::create_with_rint_and_rahit_and_rchit(std::string aIntersectionShader, std::string aAnyHitShader, std::string aClosestHitShader)
+	{
+		return create_with_rint_and_rahit_and_rchit(
+			shader_info::describe(std::move(aIntersectionShader), "main", false, shader_type::intersection),
+			shader_info::describe(std::move(aAnyHitShader), "main", false, shader_type::any_hit),
+			shader_info::describe(std::move(aClosestHitShader), "main", false, shader_type::closest_hit)
+		);
+	}
+
+
+	max_recursion_depth max_recursion_depth::disable_recursion()
+	{
+		return max_recursion_depth { 0u };
+	}
+
+	max_recursion_depth max_recursion_depth::set_to(uint32_t aValue)
+	{
+		return max_recursion_depth { aValue };
+	}
+
+
+	ray_tracing_pipeline_config::ray_tracing_pipeline_config()
+		: mPipelineSettings{ cfg::pipeline_settings::nothing }
+		, mShaderTableConfig{ }
+		, mMaxRecursionDepth{ 16u } // 16 ... why not?!
+	{
+	}
+
+	max_recursion_depth root::get_max_ray_tracing_recursion_depth()
+	{
+		const auto& rtProps = capabilities().ray_tracing_properties();
+		return max_recursion_depth{
+#if VK_HEADER_VERSION >= 162
+			rtProps.maxRayRecursionDepth
+#else
+			rtProps.maxRecursionDepth
+#endif
+		};
+	}
+
+	void root::rewire_config_and_create_ray_tracing_pipeline(ray_tracing_pipeline_t& aPreparedPipeline)
+	{
+		assert(aPreparedPipeline.mShaders.size() == aPreparedPipeline.mShaderStageCreateInfos.size());
+		assert(aPreparedPipeline.mShaders.size() == aPreparedPipeline.mSpecializationInfos.size());
+		for (size_t i = 0; i < aPreparedPipeline.mShaders.size(); ++i) {
+			aPreparedPipeline.mShaderStageCreateInfos[i]
+				.setModule(aPreparedPipeline.mShaders[i].handle())
+				.setPName(aPreparedPipeline.mShaders[i].info().mEntryPoint.c_str());
+
+			if (aPreparedPipeline.mSpecializationInfos[i] != vk::SpecializationInfo{}) {
+				assert(aPreparedPipeline.mShaders[i].info().mSpecializationConstants.has_value());
+				aPreparedPipeline.mSpecializationInfos[i].pMapEntries = aPreparedPipeline.mShaders[i].info().mSpecializationConstants.value().mMapEntries.data();
+				aPreparedPipeline.mSpecializationInfos[i].pData = aPreparedPipeline.mShaders[i].info().mSpecializationConstants.value().mData.data();
+				aPreparedPipeline.mShaderStageCreateInfos[i].setPSpecializationInfo(&aPreparedPipeline.mSpecializationInfos[i]);
+			}
+		}
+
+		// Pipeline Layout must be rewired already before calling this function
+
+		aPreparedPipeline.mPipelineLayout = device().createPipelineLayoutUnique(aPreparedPipeline.mPipelineLayoutCreateInfo, nullptr, dispatch_loader_core());
+		assert(aPreparedPipeline.layout_handle());
+
+
+		// Create the PIPELINE LAYOUT
+		aPreparedPipeline.mPipelineLayout = device().createPipelineLayoutUnique(aPreparedPipeline.mPipelineLayoutCreateInfo, nullptr, dispatch_loader_core());
+		assert(static_cast<bool>(aPreparedPipeline.layout_handle()));
+
+		auto pipelineCreateInfo = vk::RayTracingPipelineCreateInfoKHR{}
+			.setFlags(vk::PipelineCreateFlagBits{}) // TODO: Support flags
+			.setStageCount(static_cast<uint32_t>(aPreparedPipeline.mShaderStageCreateInfos.size()))
+			.setPStages(aPreparedPipeline.mShaderStageCreateInfos.data())
+			.setGroupCount(static_cast<uint32_t>(aPreparedPipeline.mShaderGroupCreateInfos.size()))
+			.setPGroups(aPreparedPipeline.mShaderGroupCreateInfos.data())
+			.setPLibraryInterface(nullptr)
+#if VK_HEADER_VERSION >= 162
+			.setMaxPipelineRayRecursionDepth(aPreparedPipeline.mMaxRecursionDepth)
+#else
+			.setMaxRecursionDepth(aPreparedPipeline.mMaxRecursionDepth)
+#endif
+			.setLayout(aPreparedPipeline.layout_handle());
+		
+#if VK_HEADER_VERSION >= 162
+		auto pipeCreationResult = device().createRayTracingPipelineKHRUnique(
+			{}, {},
+			pipelineCreateInfo,
+			nullptr,
+			dispatch_loader_ext());
+#else
+		auto pipeCreationResult = device().createRayTracingPipelineKHRUnique(
+			nullptr,
+			pipelineCreateInfo,
+			nullptr,
+			dispatch_loader_ext());
+#endif
+
+		aPreparedPipeline.mPipeline = std::move(pipeCreationResult.value);
+	}
+
+	void root::build_shader_binding_table(ray_tracing_pipeline_t& aPipeline)
+	{
+		// According to https://nvpro-samples.github.io/vk_raytracing_tutorial_KHR/#shaderbindingtable this is the way:
+		const uint32_t groupCount = static_cast<uint32_t>(aPipeline.mShaderGroupCreateInfos.size());
+		const size_t shaderBindingTableSize = aPipeline.mShaderBindingTableGroupsInfo.mTotalSize;
+
+		// TODO: All of this SBT-stuff probably needs some refactoring
+		aPipeline.mShaderBindingTable = create_buffer(
+			AVK_STAGING_BUFFER_MEMORY_USAGE, // TODO: This should be a device buffer, right?!
+#if VK_HEADER_VERSION >= 162
+			vk::BufferUsageFlagBits::eShaderBindingTableKHR | vk::BufferUsageFlagBits::eShaderDeviceAddressKHR, // TODO: eShaderDeviceAddressKHR or eShaderDeviceAddress?
+																												// TODO: Make meta data for it!
+#else
+			vk::BufferUsageFlagBits::eRayTracingKHR,
+#endif
+			generic_buffer_meta::create_from_size(shaderBindingTableSize)
+		);
+
+		assert(aPipeline.mShaderBindingTable->meta_at_index<buffer_meta>(0).total_size() == shaderBindingTableSize);
+
+		// Copy to temporary buffer:
+		std::vector<uint8_t> shaderHandleStorage(shaderBindingTableSize); // The order MUST be the same as during step 3, we just need to ensure to align the TARGET offsets properly (see below)
+		auto result = device().getRayTracingShaderGroupHandlesKHR(aPipeline.handle(), 0, groupCount, shaderBindingTableSize, shaderHandleStorage.data(), dispatch_loader_ext());
+		assert(static_cast<VkResult>(result) >= 0);
+
+		auto mapped = scoped_mapping{aPipeline.mShaderBindingTable->mBuffer, mapping_access::write};
+		// Transfer all the groups into the buffer's memory, taking all the offsets determined in step 3 into account:
+		vk::DeviceSize off = 0;
+		size_t iRaygen = 0;
+		size_t iMiss = 0;
+		size_t iHit = 0;
+		size_t iCallable = 0;
+		auto* pData  = reinterpret_cast<uint8_t*>(mapped.get());
+		size_t srcByteOffset = 0;
+		while (off < aPipeline.mShaderBindingTableGroupsInfo.mEndOffset) {
+			size_t dstOffset = 0;
+			size_t copySize = 0;
+
+			if (iRaygen   < aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo.size() && aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mOffset == off) {
+				dstOffset = aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mByteOffset;
+				off      += aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mNumEntries;
+				copySize  = aPipeline.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mNumEntries * aPipeline.mShaderGroupHandleSize;
+				++iRaygen;
+			}
+			else if (iMiss < aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo.size() && aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mOffset == off) {
+				dstOffset  = aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mByteOffset;
+				off       += aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mNumEntries;
+				copySize   = aPipeline.mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mNumEntries * aPipeline.mShaderGroupHandleSize;
+				++iMiss;
+			}
+			else if (iHit < aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo.size() && aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mOffset == off) {
+				dstOffset = aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mByteOffset;
+				off      += aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mNumEntries;
+				copySize  = aPipeline.mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mNumEntries * aPipeline.mShaderGroupHandleSize;
+				++iHit;
+			}
+			else if (iCallable < aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo.size() && aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mOffset == off) {
+				dstOffset = aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mByteOffset;
+				off      += aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mNumEntries;
+				copySize  = aPipeline.mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mNumEntries * aPipeline.mShaderGroupHandleSize;
+				++iCallable;
+			}
+			else {
+				throw avk::runtime_error("Can't be");
+			}
+
+			memcpy(pData + dstOffset, shaderHandleStorage.data() + srcByteOffset, copySize);
+			srcByteOffset += copySize;
+		}
+		//for(uint32_t g = 0; g < groupCount; g++)
+		//{
+		//}
+	}
+
+	ray_tracing_pipeline root::create_ray_tracing_pipeline(ray_tracing_pipeline_config aConfig, std::function<void(ray_tracing_pipeline_t&)> aAlterConfigBeforeCreation)
+	{
+		using namespace cfg;
+
+		ray_tracing_pipeline_t result;
+		result.mRoot = this;
+
+		// 1. Set pipeline flags
+		result.mPipelineCreateFlags = {};
+		// TODO: Support all flags (only one of the flags is handled at the moment)
+		if ((aConfig.mPipelineSettings & pipeline_settings::disable_optimization) == pipeline_settings::disable_optimization) {
+			result.mPipelineCreateFlags |= vk::PipelineCreateFlagBits::eDisableOptimization;
+		}
+
+		// Get the offsets. We'll really need them in step 10. but already in step 3., we are gathering the correct byte offsets:
+		{
+			const auto& rtProps = capabilities().ray_tracing_properties();
+
+			result.mShaderGroupBaseAlignment = static_cast<uint32_t>(rtProps.shaderGroupBaseAlignment);
+			result.mShaderGroupHandleAlignment = static_cast<uint32_t>(rtProps.shaderGroupHandleAlignment);
+			result.mShaderGroupHandleSize = static_cast<uint32_t>(rtProps.shaderGroupHandleSize);
+		}
+
+		// 2. Gather and build shaders
+		// First of all, gather unique shaders and build them
+		std::vector<shader_info> orderedUniqueShaderInfos;
+		for (auto& tableEntry : aConfig.mShaderTableConfig.mShaderTableEntries) {
+			if (std::holds_alternative<shader_info>(tableEntry)) {
+				add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, std::get<shader_info>(tableEntry));
+			}
+			else if (std::holds_alternative<triangles_hit_group>(tableEntry)) {
+				const auto& hitGroup = std::get<triangles_hit_group>(tableEntry);
+				if (hitGroup.mAnyHitShader.has_value()) {
+					add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mAnyHitShader.value());
+				}
+				if (hitGroup.mClosestHitShader.has_value()) {
+					add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mClosestHitShader.value());
+				}
+			}
+			else if (std::holds_alternative<procedural_hit_group>(tableEntry)) {
+				const auto& hitGroup = std::get<procedural_hit_group>(tableEntry);
+				add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mIntersectionShader);
+				if (hitGroup.mAnyHitShader.has_value()) {
+					add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mAnyHitShader.value());
+				}
+				if (hitGroup.mClosestHitShader.has_value()) {
+					add_to_vector_if_not_already_contained(orderedUniqueShaderInfos, hitGroup.mClosestHitShader.value());
+				}
+			}
+			else {
+				throw avk::runtime_error("tableEntry holds an unknown alternative. That's mysterious.");
+			}
+		}
+		result.mShaders.reserve(orderedUniqueShaderInfos.size());
+		result.mShaderStageCreateInfos.reserve(orderedUniqueShaderInfos.size());
+		result.mSpecializationInfos.reserve(orderedUniqueShaderInfos.size());
+		for (auto& shaderInfo : orderedUniqueShaderInfos) {
+			// 2.2 Compile the shader
+			result.mShaders.push_back(create_shader(shaderInfo));
+			assert(result.mShaders.back().has_been_built());
+			// 2.3 Create shader info
+			auto& stageCreateInfo = result.mShaderStageCreateInfos.emplace_back()
+				.setStage(to_vk_shader_stage(result.mShaders.back().info().mShaderType))
+				.setModule(result.mShaders.back().handle())
+				.setPName(result.mShaders.back().info().mEntryPoint.c_str());
+			if (shaderInfo.mSpecializationConstants.has_value()) {
+				auto& specInfo = result.mSpecializationInfos.emplace_back(
+					shaderInfo.mSpecializationConstants.value().num_entries(),
+					shaderInfo.mSpecializationConstants.value().mMapEntries.data(),
+					shaderInfo.mSpecializationConstants.value().data_size(),
+					shaderInfo.mSpecializationConstants.value().mData.data()
+				);
+				// Add it to the stageCreateInfo:
+				stageCreateInfo.setPSpecializationInfo(&specInfo);
+			}
+			else {
+				result.mSpecializationInfos.emplace_back(); // Just to keep the indices into the vectors in sync
+			}
+		}
+		assert(orderedUniqueShaderInfos.size() == result.mShaders.size());
+		assert(result.mShaders.size() == result.mShaderStageCreateInfos.size());
+#if defined(_DEBUG)
+		// Perform a sanity check:
+		for (size_t i = 0; i < orderedUniqueShaderInfos.size(); ++i) {
+			assert(orderedUniqueShaderInfos[i] == result.mShaders[i].info());
+		}
+#endif
+
+		// 3. Create the shader table (with references to the shaders from step 2.)
+		// Iterate over the shader table... AGAIN! ...But this time, build the shader groups for Vulkan's Ray Tracing Pipeline:
+		result.mShaderGroupCreateInfos.reserve(aConfig.mShaderTableConfig.mShaderTableEntries.size());
+
+		// During iterating, also compile the data for the shader binding table groups information:
+		result.mShaderBindingTableGroupsInfo = {};
+		enum struct group_type { none, raygen, miss, hit, callable };
+		group_type prevType = group_type::none;
+		vk::DeviceSize groupOffset = 0;
+		vk::DeviceSize byteOffset = 0;
+		shader_group_info* curEdited = nullptr;
+
+		for (auto& tableEntry : aConfig.mShaderTableConfig.mShaderTableEntries) {
+			group_type curType = group_type::none;
+
+			if (std::holds_alternative<shader_info>(tableEntry)) {
+				const auto& shaderInfo = std::get<shader_info>(tableEntry);
+				switch (shaderInfo.mShaderType) {
+					case shader_type::ray_generation: curType = group_type::raygen;   break;
+					case shader_type::miss:           curType = group_type::miss;     break;
+					case shader_type::callable:       curType = group_type::callable; break;
+					default: throw avk::runtime_error("Invalid shader type passed to create_ray_tracing_pipeline, recognized during gathering of SBT infos");
+				}
+
+				// The shader indices are actually indices into `result.mShaders` not into
+				// `orderedUniqueShaderInfos`. However, both vectors are aligned perfectly,
+				// so we are just using `orderedUniqueShaderInfos` for convenience.
+				const uint32_t generalShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, shaderInfo));
+				result.mShaderGroupCreateInfos.emplace_back()
+					.setType(vk::RayTracingShaderGroupTypeKHR::eGeneral)
+					.setGeneralShader(generalShaderIndex)
+					.setIntersectionShader(VK_SHADER_UNUSED_KHR)
+					.setAnyHitShader(VK_SHADER_UNUSED_KHR)
+					.setClosestHitShader(VK_SHADER_UNUSED_KHR);
+			}
+			else if (std::holds_alternative<triangles_hit_group>(tableEntry)) {
+				curType = group_type::hit;
+
+				const auto& hitGroup = std::get<triangles_hit_group>(tableEntry);
+				uint32_t rahitShaderIndex = VK_SHADER_UNUSED_KHR;
+				if (hitGroup.mAnyHitShader.has_value()) {
+					rahitShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mAnyHitShader.value()));
+				}
+				uint32_t rchitShaderIndex = VK_SHADER_UNUSED_KHR;
+				if (hitGroup.mClosestHitShader.has_value()) {
+					rchitShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mClosestHitShader.value()));
+				}
+				result.mShaderGroupCreateInfos.emplace_back()
+					.setType(vk::RayTracingShaderGroupTypeKHR::eTrianglesHitGroup)
+					.setGeneralShader(VK_SHADER_UNUSED_KHR)
+					.setIntersectionShader(VK_SHADER_UNUSED_KHR)
+					.setAnyHitShader(rahitShaderIndex)
+					.setClosestHitShader(rchitShaderIndex);
+			}
+			else if (std::holds_alternative<procedural_hit_group>(tableEntry)) {
+				curType = group_type::hit;
+
+				const auto& hitGroup = std::get<procedural_hit_group>(tableEntry);
+				uint32_t rintShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mIntersectionShader));
+				uint32_t rahitShaderIndex = VK_SHADER_UNUSED_KHR;
+				if (hitGroup.mAnyHitShader.has_value()) {
+					rahitShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mAnyHitShader.value()));
+				}
+				uint32_t rchitShaderIndex = VK_SHADER_UNUSED_KHR;
+				if (hitGroup.mClosestHitShader.has_value()) {
+					rchitShaderIndex = static_cast<uint32_t>(index_of(orderedUniqueShaderInfos, hitGroup.mClosestHitShader.value()));
+				}
+				result.mShaderGroupCreateInfos.emplace_back()
+					.setType(vk::RayTracingShaderGroupTypeKHR::eProceduralHitGroup)
+					.setGeneralShader(VK_SHADER_UNUSED_KHR)
+					.setIntersectionShader(rintShaderIndex)
+					.setAnyHitShader(rahitShaderIndex)
+					.setClosestHitShader(rchitShaderIndex);
+			}
+			else {
+				throw avk::runtime_error("tableEntry holds an unknown alternative. That's mysterious.");
+			}
+
+			// Set that shader binding table groups information:
+			assert (group_type::none != curType);
+			if (curType == prevType) {
+				// same same is easy
+				assert (nullptr != curEdited);
+				curEdited->mNumEntries += 1;
+
+				// A new handle group must start at a multiple of result.mShaderGroupHandleAlignment
+				byteOffset += result.mShaderGroupHandleSize;
+			}
+			else {
+				// different => create new entry
+				switch (curType) {
+				case group_type::raygen:
+					curEdited = &result.mShaderBindingTableGroupsInfo.mRaygenGroupsInfo.emplace_back();
+					break;
+				case group_type::miss:
+					curEdited = &result.mShaderBindingTableGroupsInfo.mMissGroupsInfo.emplace_back();
+					break;
+				case group_type::hit:
+					curEdited = &result.mShaderBindingTableGroupsInfo.mHitGroupsInfo.emplace_back();
+					break;
+				case group_type::callable:
+					curEdited = &result.mShaderBindingTableGroupsInfo.mCallableGroupsInfo.emplace_back();
+					break;
+				default: throw avk::runtime_error("Can't be!");
+				}
+				assert (nullptr != curEdited);
+				curEdited->mOffset = groupOffset;
+				curEdited->mNumEntries = 1;
+
+				// A new shader group must start at a multiple of result.mShaderGroupBaseAlignment
+				byteOffset = align_to(byteOffset, static_cast<vk::DeviceAddress>(result.mShaderGroupBaseAlignment));
+				curEdited->mByteOffset = byteOffset;
+				byteOffset += result.mShaderGroupHandleSize;
+			}
+			prevType = curType;
+			++groupOffset;
+		}
+		result.mShaderBindingTableGroupsInfo.mEndOffset = groupOffset;
+		result.mShaderBindingTableGroupsInfo.mTotalSize = byteOffset;
+
+		// 4. Maximum recursion depth:
+		result.mMaxRecursionDepth = aConfig.mMaxRecursionDepth.mMaxRecursionDepth;
+
+		// 5. Pipeline layout
+		result.mAllDescriptorSetLayouts = set_of_descriptor_set_layouts::prepare(std::move(aConfig.mResourceBindings));
+		allocate_set_of_descriptor_set_layouts(result.mAllDescriptorSetLayouts);
+
+		// Gather the push constant data
+		result.mPushConstantRanges.reserve(aConfig.mPushConstantsBindings.size()); // Important! Otherwise the vector might realloc and .data() will become invalid!
+		for (const auto& pcBinding : aConfig.mPushConstantsBindings) {
+			result.mPushConstantRanges.push_back(vk::PushConstantRange{}
+				.setStageFlags(to_vk_shader_stages(pcBinding.mShaderStages))
+				.setOffset(static_cast<uint32_t>(pcBinding.mOffset))
+				.setSize(static_cast<uint32_t>(pcBinding.mSize))
+			);
+			// TODO: Push Constants need a prettier interface
+		}
+
+		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
+		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
+			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
+			.setPSetLayouts(descriptorSetLayoutHandles.data())
+			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
+			.setPPushConstantRanges(result.mPushConstantRanges.data());
+
+		// 6. Maybe alter the config?
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		// 8. Create the pipeline's layout
+		// 9. Build the Ray Tracing Pipeline
+		rewire_config_and_create_ray_tracing_pipeline(result);
+
+		// 10. Build the shader binding table
+		build_shader_binding_table(result);
+		return result;
+	}
+
+	ray_tracing_pipeline root::create_ray_tracing_pipeline_from_template(const ray_tracing_pipeline_t& aTemplate, std::function<void(ray_tracing_pipeline_t&)> aAlterConfigBeforeCreation)
+	{
+		ray_tracing_pipeline_t result;
+
+		result.mPipelineCreateFlags						= aTemplate.mPipelineCreateFlags;
+		for (const auto& shdr : aTemplate.mShaders) {
+			result.mShaders.push_back(create_shader_from_template(shdr));
+		}
+		result.mShaderStageCreateInfos					= aTemplate.mShaderStageCreateInfos;
+		result.mSpecializationInfos						= aTemplate.mSpecializationInfos;
+		result.mShaderGroupCreateInfos					= aTemplate.mShaderGroupCreateInfos;
+		result.mShaderBindingTableGroupsInfo			= aTemplate.mShaderBindingTableGroupsInfo;
+		result.mMaxRecursionDepth						= aTemplate.mMaxRecursionDepth;
+		result.mBasePipelineIndex						= aTemplate.mBasePipelineIndex;
+		result.mAllDescriptorSetLayouts = create_set_of_descriptor_set_layouts_from_template(aTemplate.mAllDescriptorSetLayouts);
+		result.mPushConstantRanges						= aTemplate.mPushConstantRanges;
+
+		auto descriptorSetLayoutHandles = result.mAllDescriptorSetLayouts.layout_handles();
+		result.mPipelineLayoutCreateInfo = vk::PipelineLayoutCreateInfo{}
+			.setSetLayoutCount(static_cast<uint32_t>(descriptorSetLayoutHandles.size()))
+			.setPSetLayouts(descriptorSetLayoutHandles.data())
+			.setPushConstantRangeCount(static_cast<uint32_t>(result.mPushConstantRanges.size()))
+			.setPPushConstantRanges(result.mPushConstantRanges.data());
+
+		result.mShaderGroupBaseAlignment				= aTemplate.mShaderGroupBaseAlignment;
+		result.mShaderGroupHandleSize					= aTemplate.mShaderGroupHandleSize;
+
+		result.mRoot = this;
+
+		// 15. Maybe alter the config?!
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		rewire_config_and_create_ray_tracing_pipeline(result);
+		build_shader_binding_table(result);
+		return result;
+	}
+
+	size_t ray_tracing_pipeline_t::num_raygen_groups_in_shader_binding_table() const
+	{
+		return shader_binding_table_groups().mRaygenGroupsInfo.size();
+	}
+
+	size_t ray_tracing_pipeline_t::num_miss_groups_in_shader_binding_table() const
+	{
+		return shader_binding_table_groups().mMissGroupsInfo.size();
+	}
+
+	size_t ray_tracing_pipeline_t::num_hit_groups_in_shader_binding_table() const
+	{
+		return shader_binding_table_groups().mHitGroupsInfo.size();
+	}
+
+	size_t ray_tracing_pipeline_t::num_callable_groups_in_shader_binding_table() const
+	{
+		return shader_binding_table_groups().mCallableGroupsInfo.size();
+	}
+
+	void ray_tracing_pipeline_t::print_shader_binding_table_groups() const
+	{
+		vk::DeviceSize off = 0;
+		size_t iRaygen = 0;
+		size_t iMiss = 0;
+		size_t iHit = 0;
+		size_t iCallable = 0;
+		auto printRow = [](std::string aOffset, std::string aShaders, std::string aRaygen, std::string aMiss, std::string aHit, std::string aCallable){
+			static const std::string offsetStr	 = "      ";
+			static const std::string shadersStr	 = "                                               ";
+			static const std::string raygenStr	 = "          ";
+			static const std::string missStr	 = "          ";
+			static const std::string hitStr		 = "         ";
+			static const std::string callableStr = "          ";
+			if (aOffset.empty())	{ aOffset = offsetStr; }
+			if (aShaders.empty())	{ aShaders = shadersStr; }
+			if (aRaygen.empty())	{ aRaygen = raygenStr; }
+			if (aMiss.empty())		{ aMiss = missStr; }
+			if (aHit.empty())		{ aHit = hitStr; }
+			if (aCallable.empty())	{ aCallable = callableStr; }
+			if (aOffset.length() < offsetStr.length())		{ aOffset = offsetStr		+ aOffset; }
+			if (aShaders.length() < shadersStr.length())	{ aShaders = shadersStr		+ aShaders; }
+			if (aRaygen.length() < raygenStr.length())		{ aRaygen = raygenStr		+ aRaygen; }
+			if (aMiss.length() < missStr.length())			{ aMiss = missStr			+ aMiss; }
+			if (aHit.length() < hitStr.length())			{ aHit = hitStr				+ aHit; }
+			if (aCallable.length() < callableStr.length())	{ aCallable = callableStr	+ aCallable; }
+			if (aOffset.length() > offsetStr.length())		{ aOffset = aOffset.substr(aOffset.length() - offsetStr.length()); }
+			if (aShaders.length() > shadersStr.length())	{ aShaders = aShaders.substr(aShaders.length() - shadersStr.length()); }
+			if (aRaygen.length() > raygenStr.length())		{ aRaygen = aRaygen.substr(aRaygen.length() - raygenStr.length()); }
+			if (aMiss.length() > missStr.length())			{ aMiss =   aMiss.substr(aMiss.length()   - missStr.length()); }
+			if (aHit.length() > hitStr.length())			{ aHit =    aHit.substr(aHit.length()    - hitStr.length()); }
+			if (aCallable.length() > callableStr.length())	{ aCallable = aCallable.substr(aCallable.length() - callableStr.length()); }
+			AVK_LOG_INFO("| " + aOffset + " | " + aShaders + " | " + aRaygen + " | " + aMiss + " | " + aHit + " | " + aCallable + " |");
+		};
+		auto getShaderName = [this](uint32_t aIndex, bool aPrintFileExt = true){
+			auto filename = avk::extract_file_name(mShaders[aIndex].info().mPath);
+			const auto spvPos = filename.find(".spv");
+			if (spvPos != std::string::npos) {
+				filename = filename.substr(0, spvPos);
+			}
+			if (!aPrintFileExt) {
+				const auto dotPos = filename.find_first_of('.');
+				if (dotPos != std::string::npos) {
+					return filename.substr(0, dotPos);
+				}
+			}
+			return filename;
+		};
+		AVK_LOG_INFO("+=============================================================================================================+");
+		AVK_LOG_INFO("|                          +++++++++++++ SHADER BINDING TABLE +++++++++++++                                   |");
+		AVK_LOG_INFO("|                          BYTE-OFFSETS, SHADERS, and GROUP-INDICES (G.IDX)                                   |");
+		AVK_LOG_INFO("+=============================================================================================================+");
+		AVK_LOG_INFO("| OFFSET | SHADERS: GENERAL or INTERS.|ANY-HIT|CLOSEST-HIT | RGEN G.IDX | MISS G.IDX | HIT G.IDX | CALL G.IDX |");
+		while (off < mShaderBindingTableGroupsInfo.mEndOffset) {
+			AVK_LOG_INFO("+-------------------------------------------------------------------------------------------------------------+");
+			if (iRaygen   < mShaderBindingTableGroupsInfo.mRaygenGroupsInfo.size() && mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mOffset == off) {
+				std::string byteOff = std::to_string(mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mByteOffset);
+				std::string grpIdx = "[" + std::to_string(iRaygen) + "]";
+				for (size_t i = 0; i < mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mNumEntries; ++i) {
+					printRow(byteOff, getShaderName(mShaderGroupCreateInfos[off + i].generalShader) + ": " + std::to_string(i), grpIdx, "", "", "");
+					byteOff = ""; grpIdx = "";
+				}
+				off      += mShaderBindingTableGroupsInfo.mRaygenGroupsInfo[iRaygen].mNumEntries;
+				++iRaygen;
+			}
+			else if (iMiss < mShaderBindingTableGroupsInfo.mMissGroupsInfo.size() && mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mOffset == off) {
+				std::string byteOff = std::to_string(mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mByteOffset);
+				std::string grpIdx = "[" + std::to_string(iMiss) + "]";
+				for (size_t i = 0; i < mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mNumEntries; ++i) {
+					printRow(byteOff, getShaderName(mShaderGroupCreateInfos[off + i].generalShader) + ": " + std::to_string(i), "", grpIdx, "", "");
+					byteOff = ""; grpIdx = "";
+				}
+				off       += mShaderBindingTableGroupsInfo.mMissGroupsInfo[iMiss].mNumEntries;
+				++iMiss;
+			}
+			else if (iHit < mShaderBindingTableGroupsInfo.mHitGroupsInfo.size() && mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mOffset == off) {
+				std::string byteOff = std::to_string(mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mByteOffset);
+				std::string grpIdx = "[" + std::to_string(iHit) + "]";
+				for (size_t i = 0; i < mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mNumEntries; ++i) {
+					assert(vk::RayTracingShaderGroupTypeKHR::eGeneral != mShaderGroupCreateInfos[off + iHit].type);
+					std::string hitInfo;
+					hitInfo += mShaderGroupCreateInfos[off + i].intersectionShader != VK_SHADER_UNUSED_KHR ? getShaderName(mShaderGroupCreateInfos[off + i].intersectionShader, false) : "--";
+					hitInfo += "|";
+					hitInfo += mShaderGroupCreateInfos[off + i].anyHitShader != VK_SHADER_UNUSED_KHR ? getShaderName(mShaderGroupCreateInfos[off + i].anyHitShader, false) : "--";
+					hitInfo += "|";
+					hitInfo += mShaderGroupCreateInfos[off + i].closestHitShader != VK_SHADER_UNUSED_KHR ? getShaderName(mShaderGroupCreateInfos[off + i].closestHitShader, false) : "--";
+					printRow(byteOff, hitInfo + ": " + std::to_string(i), "", "", grpIdx, "");
+					byteOff = ""; grpIdx = "";
+				}
+				off      += mShaderBindingTableGroupsInfo.mHitGroupsInfo[iHit].mNumEntries;
+				++iHit;
+			}
+			else if (iCallable < mShaderBindingTableGroupsInfo.mCallableGroupsInfo.size() && mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mOffset == off) {
+				std::string byteOff = std::to_string(mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mByteOffset);
+				std::string grpIdx = "[" + std::to_string(iCallable) + "]";
+				for (size_t i = 0; i < mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mNumEntries; ++i) {
+					printRow(byteOff, getShaderName(mShaderGroupCreateInfos[off + i].generalShader) + ": " + std::to_string(i), "", "", "", grpIdx);
+					byteOff = ""; grpIdx = "";
+				}
+				off      += mShaderBindingTableGroupsInfo.mCallableGroupsInfo[iCallable].mNumEntries;
+				++iCallable;
+			}
+			else {
+				throw avk::runtime_error("Can't be");
+			}
+		}
+		AVK_LOG_INFO("+-------------------------------------------------------------------------------------------------------------+");
+	}
+#endif
+#pragma endregion
+
+#pragma region renderpass definitions
+
+	struct subpass_desc_helper
+	{
+		size_t mSubpassId;
+		std::map<uint32_t, vk::AttachmentReference2KHR> mSpecificInputLocations;
+		std::queue<vk::AttachmentReference2KHR> mUnspecifiedInputLocations;
+		int mInputMaxLoc;
+		std::map<uint32_t, vk::AttachmentReference2KHR> mSpecificColorLocations;
+		std::queue<vk::AttachmentReference2KHR> mUnspecifiedColorLocations;
+		int mColorMaxLoc;
+		std::queue<vk::AttachmentReference2KHR> mUnspecifiedDepthStencilLocations;
+		int mDepthStencilMaxLoc;
+		std::map<uint32_t, vk::AttachmentReference2KHR> mSpecificColorResolveLocations;
+		std::queue<vk::AttachmentReference2KHR> mUnspecifiedColorResolveLocations;
+		std::queue<vk::SubpassDescriptionDepthStencilResolve> mUnspecifiedDepthStencilResolveData;
+		std::queue<vk::AttachmentReference2KHR> mUnspecifiedDepthStencilResolveRefs;
+		std::vector<uint32_t> mPreserveAttachments;
+	};
+
+	void root::rewire_subpass_descriptions(renderpass_t& aRenderpass)
+	{
+		const auto nSubpasses = aRenderpass.mSubpassData.size();
+
+		aRenderpass.mSubpasses.clear(); // Start with a clean state
+		aRenderpass.mSubpasses.reserve(nSubpasses);
+
+		for (size_t i = 0; i < nSubpasses; ++i) {
+			auto& b = aRenderpass.mSubpassData[i];
+
+			assert(b.mOrderedDepthStencilResolveAttachmentRefs.size() == b.mOrderedDepthStencilResolveAttachmentData.size());
+			const auto nDepthStencilResolve = b.mOrderedDepthStencilResolveAttachmentRefs.size();
+			for (size_t ids = 0; ids < nDepthStencilResolve; ++ids) {
+				b.mOrderedDepthStencilResolveAttachmentData[ids].setPDepthStencilResolveAttachment(
+					&b.mOrderedDepthStencilResolveAttachmentRefs[ids]
+				);
+			}
+
+			aRenderpass.mSubpasses.push_back(vk::SubpassDescription2KHR{}
+				// pipelineBindPoint must be VK_PIPELINE_BIND_POINT_GRAPHICS [1] because subpasses are only relevant for graphics at the moment
+				.setPipelineBindPoint(vk::PipelineBindPoint::eGraphics)
+				.setColorAttachmentCount(static_cast<uint32_t>(b.mOrderedColorAttachmentRefs.size()))
+				.setPColorAttachments(b.mOrderedColorAttachmentRefs.data())
+				// If pResolveAttachments is not NULL, each of its elements corresponds to a color attachment
+				//  (the element in pColorAttachments at the same index), and a multisample resolve operation
+				//  is defined for each attachment. [1]
+				.setPResolveAttachments(b.mOrderedColorResolveAttachmentRefs.empty() ? nullptr : b.mOrderedColorResolveAttachmentRefs.data())
+				// If pDepthStencilAttachment is NULL, or if its attachment index is VK_ATTACHMENT_UNUSED, it
+				//  indicates that no depth/stencil attachment will be used in the subpass. [1]
+				.setPDepthStencilAttachment(b.mOrderedDepthStencilAttachmentRefs.empty() ? nullptr : &b.mOrderedDepthStencilAttachmentRefs[0])
+				// The following two attachment types are probably totally irrelevant if we only have one subpass
+				.setInputAttachmentCount(static_cast<uint32_t>(b.mOrderedInputAttachmentRefs.size()))
+				.setPInputAttachments(b.mOrderedInputAttachmentRefs.data())
+				.setPreserveAttachmentCount(static_cast<uint32_t>(b.mPreserveAttachments.size()))
+				.setPPreserveAttachments(b.mPreserveAttachments.data())
+				// Add depth/stencil resolve attachment:
+				.setPNext(b.mOrderedDepthStencilResolveAttachmentData.empty() ? nullptr : b.mOrderedDepthStencilResolveAttachmentData.data())
+			);				
+		}
+	}
+
+
+	/**	Creates memory barrier data which is appropriate for the given subpass dependency.
+	 *	@param	aSubpassDependency	Subpass dependency to create memory barrier data for.
+	 *	@return	Memory barrier data including stage and access masks.
+	 */
+	static inline vk::MemoryBarrier2KHR get_memory_barrier_for_subpass_dependency(const subpass_dependency& aSubpassDependency)
+	{
+		const bool srcStageIsAuto = std::holds_alternative<avk::stage::auto_stage_t>(aSubpassDependency.mStages.mSrc);
+		const bool dstStageIsAuto = std::holds_alternative<avk::stage::auto_stage_t>(aSubpassDependency.mStages.mDst);
+		const bool srcAccessIsAuto = std::holds_alternative<avk::access::auto_access_t>(aSubpassDependency.mAccesses.mSrc);
+		const bool dstAccessIsAuto = std::holds_alternative<avk::access::auto_access_t>(aSubpassDependency.mAccesses.mDst);
+
+		return vk::MemoryBarrier2KHR{}
+			.setSrcStageMask(srcStageIsAuto
+				? vk::PipelineStageFlags2KHR{
+					VK_SUBPASS_EXTERNAL == aSubpassDependency.mIndices.mSrc
+					? vk::PipelineStageFlagBits2KHR::eAllCommands // TODO: Try to determine tighter stage mask; needs more information about external commands, though
+					: vk::PipelineStageFlagBits2KHR::eAllGraphics
+				}
+				: std::get<vk::PipelineStageFlags2KHR>(aSubpassDependency.mStages.mSrc)
+			)
+			.setDstStageMask(dstStageIsAuto
+				? vk::PipelineStageFlags2KHR{
+					VK_SUBPASS_EXTERNAL == aSubpassDependency.mIndices.mDst
+					? vk::PipelineStageFlagBits2KHR::eAllCommands // TODO: Try to determine tighter stage mask; needs more information about external commands, though
+					: vk::PipelineStageFlagBits2KHR::eAllGraphics
+				}
+				: std::get<vk::PipelineStageFlags2KHR>(aSubpassDependency.mStages.mDst)
+			)
+			.setSrcAccessMask(srcAccessIsAuto
+				? vk::AccessFlags2KHR{ vk::AccessFlagBits2KHR::eMemoryWrite }  // TODO: Try to determine tighter access mask; needs more information about external commands, though
+				: std::get<vk::AccessFlags2KHR>(aSubpassDependency.mAccesses.mSrc)
+			)
+			.setDstAccessMask(dstAccessIsAuto
+				? vk::AccessFlags2KHR{ vk::AccessFlagBits2KHR::eMemoryWrite }  // TODO: Try to determine tighter access mask; needs more information about external commands, though
+				: std::get<vk::AccessFlags2KHR>(aSubpassDependency.mAccesses.mDst)
+			);
+	}
+
+	std::tuple<std::vector<vk::SubpassDependency2KHR>, std::vector<vk::MemoryBarrier2KHR>> root::compile_subpass_dependencies(const renderpass_t& aRenderpass)
+	{
+		const auto numSubpassesFirst = aRenderpass.mSubpassData.size();
+		assert(numSubpassesFirst > 0);
+
+		// And construct the actual dependency-info from it:
+		std::vector<vk::SubpassDependency2KHR> subpassDependencies2;
+		std::vector<vk::MemoryBarrier2KHR> memoryBarriers2;
+
+		// Just turn them all into subpass dependencies:
+		for (auto& subDep : aRenderpass.mSubpassDependencies) {
+			subpassDependencies2.push_back(vk::SubpassDependency2KHR{}
+				.setSrcSubpass(subDep.mIndices.mSrc).setDstSubpass(subDep.mIndices.mDst) // If a VkMemoryBarrier2 is included in the pNext chain, srcStageMask, dstStageMask, srcAccessMask, and dstAccessMask parameters are ignored.
+				.setPNext(nullptr) // !!! ATTENTION: This will have to be set by the user of this function to point to the appropriate vk::MemoryBarrier2KHR{} !!!
+			);
+			memoryBarriers2.push_back(get_memory_barrier_for_subpass_dependency(subDep));
+		}
+
+		assert(subpassDependencies2.size() == memoryBarriers2.size());
+
+		return std::make_tuple(std::move(subpassDependencies2), std::move(memoryBarriers2));
+	}
+
+	void root::rewire_subpass_dependencies(std::vector<vk::SubpassDependency2KHR>& aAlignedSubpassDependencies, std::vector<vk::MemoryBarrier2KHR>& aAlignedMemoryBarriers)
+	{
+		// Set pNext pointers in every vk::SubpassDependency2KHR
+		for (size_t i = 0; i < aAlignedSubpassDependencies.size(); ++i) {
+			aAlignedSubpassDependencies[i].setPNext(&aAlignedMemoryBarriers[i]);
+			//aAlignedSubpassDependencies[i]
+			//	.setPNext(nullptr)
+			//	.setSrcStageMask(aAlignedMemoryBarriers[i].srcStageMask == vk::PipelineStageFlagBits2KHR::eNone ? (vk::PipelineStageFlags)vk::PipelineStageFlagBits::eTopOfPipe : (vk::PipelineStageFlags)(VkPipelineStageFlags)(VkPipelineStageFlags2KHR)aAlignedMemoryBarriers[i].srcStageMask)
+			//	.setSrcAccessMask((vk::AccessFlags)(VkAccessFlags)(VkAccessFlags2KHR)aAlignedMemoryBarriers[i].srcAccessMask)
+			//	.setDstStageMask(aAlignedMemoryBarriers[i].dstStageMask == vk::PipelineStageFlagBits2KHR::eNone ? (vk::PipelineStageFlags)vk::PipelineStageFlagBits::eBottomOfPipe : (vk::PipelineStageFlags)(VkPipelineStageFlags)(VkPipelineStageFlags2KHR)aAlignedMemoryBarriers[i].dstStageMask)
+			//	.setDstAccessMask((vk::AccessFlags)(VkAccessFlags)(VkAccessFlags2KHR)aAlignedMemoryBarriers[i].dstAccessMask);
+		}
+	}
+
+	renderpass root::create_renderpass(std::vector<avk::attachment> aAttachments, subpass_dependencies aSubpassDependencies, std::function<void(renderpass_t&)> aAlterConfigBeforeCreation)
+	{
+		renderpass_t result;
+		result.mRoot = this;
+
+		std::vector<subpass_desc_helper> subpasses;
+
+		if (aAttachments.empty()) {
+			throw avk::runtime_error("No attachments have been passed to the creation of a renderpass.");
+		}
+		const auto numSubpassesFirst = aAttachments.front().mSubpassUsages.num_subpasses();
+		if (0 == numSubpassesFirst) {
+			throw avk::runtime_error("The first subpass has no usages specified. Subpass usages are not optional.");
+		}
+		// All further attachments must have the same number of subpasses! It will be checked.
+		subpasses.reserve(numSubpassesFirst);
+		for (size_t i = 0; i < numSubpassesFirst; ++i) {
+			auto& a = subpasses.emplace_back();
+			a.mSubpassId = i;
+			a.mInputMaxLoc = -1;
+			a.mColorMaxLoc = -1;
+			a.mDepthStencilMaxLoc = -1;
+		}
+
+		result.mAttachmentDescriptions.reserve(aAttachments.size());
+		for (const auto& a : aAttachments) {
+			//// Try to infer initial and final image layouts (If this isn't cool => user must use aAlterConfigBeforeCreation)
+			//vk::ImageLayout initialLayout = vk::ImageLayout::eUndefined;
+			//vk::ImageLayout finalLayout = vk::ImageLayout::eUndefined;
+
+			const auto isLoad = avk::on_load_behavior::load == a.mLoadOperation.mLoadBehavior;
+			const auto isClear = avk::on_load_behavior::clear == a.mLoadOperation.mLoadBehavior;
+			const auto isStore  = avk::on_store_behavior::store == a.mStoreOperation.mStoreBehavior;
+
+			const auto hasSeparateStencilLoad = a.mStencilLoadOperation.has_value();
+			const auto hasSeparateStencilStore = a.mStencilStoreOperation.has_value();
+			const auto isStencilLoad = avk::on_load_behavior::load == a.get_stencil_load_op().mLoadBehavior;
+			const auto isStencilClear = avk::on_load_behavior::clear == a.get_stencil_load_op().mLoadBehavior;
+			const auto isStencilStore  = avk::on_store_behavior::store == a.get_stencil_store_op().mStoreBehavior;
+			const auto hasStencilComponent = has_stencil_component(a.format());
+
+			const auto attachmentAspect = is_depth_format(a.format())
+				? vk::ImageAspectFlagBits::eDepth
+				: vk::ImageAspectFlagBits::eColor;
+
+			//bool initialLayoutFixed = false;
+			//auto firstUsage = a.get_first_color_depth_input();
+			//if (firstUsage.as_input()) {
+			//	if (isLoad) {
+			//		initialLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+			//		initialLayoutFixed = true;
+			//	}
+			//	if (isClear) {
+			//		initialLayoutFixed = true;
+			//	}
+			//}
+			//if (firstUsage.as_color()) { // this potentially overwrites the above
+			//	if (isLoad) {
+			//		initialLayout = vk::ImageLayout::eColorAttachmentOptimal;
+			//		initialLayoutFixed = true;
+			//	}
+			//	if (isClear) {
+			//		initialLayoutFixed = true;
+			//	}
+			//}
+			//if (firstUsage.as_depth_stencil()) {
+			//	if (isLoad) {
+			//		initialLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+			//		{
+			//			// TODO: Set other depth/stencil-specific formats
+			//			//       - vk::ImageLayout::eDepthReadOnlyStencilAttachmentOptimal
+			//			//       - vk::ImageLayout::eDepthStencilReadOnlyOptimal
+			//			//       - vk::ImageLayout::eDepthReadOnlyOptimal
+			//			//       - vk::ImageLayout::eStencilAttachmentOptimal
+			//			//       - vk::ImageLayout::eStencilReadOnlyOptimal
+			//		}
+			//		initialLayoutFixed = true;
+			//	}
+			//	if (isClear) {
+			//		initialLayoutFixed = true;
+			//	}
+			//}
+
+			//auto lastUsage = a.get_last_color_depth_input();
+			//if (lastUsage.as_input()) {
+			//	finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+			//}
+			//if (lastUsage.as_color()) { // This potentially overwrites the above
+			//	finalLayout = vk::ImageLayout::eColorAttachmentOptimal;
+			//}
+			//if (lastUsage.as_depth_stencil()) {
+			//	finalLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+			//	{
+			//		// TODO: Set other depth/stencil-specific formats
+			//		//       - vk::ImageLayout::eDepthReadOnlyStencilAttachmentOptimal
+			//		//       - vk::ImageLayout::eDepthStencilReadOnlyOptimal
+			//		//       - vk::ImageLayout::eDepthReadOnlyOptimal
+			//		//       - vk::ImageLayout::eStencilAttachmentOptimal
+			//		//       - vk::ImageLayout::eStencilReadOnlyOptimal
+			//	}
+			//}
+			//if (isStore && vk::ImageLayout::eUndefined == finalLayout) {
+			//	if (a.is_used_as_color_attachment()) {
+			//		finalLayout = vk::ImageLayout::eColorAttachmentOptimal;
+			//	}
+			//	else if (a.is_used_as_depth_stencil_attachment()) {
+			//		finalLayout = vk::ImageLayout::eDepthReadOnlyStencilAttachmentOptimal;
+			//	}
+			//	else if (a.is_used_as_input_attachment()) {
+			//		finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+			//	}
+			//}
+			//if (vk::ImageLayout::eUndefined == finalLayout) {
+			//	// We can just guess:
+			//	finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+			//}
+
+			//if (a.shall_be_presentable()) {
+			//	finalLayout = vk::ImageLayout::ePresentSrcKHR;
+			//}
+
+			//if (!initialLayoutFixed && isLoad) {
+			//	initialLayout = finalLayout;
+			//}
+			//// ^^^ I have no idea what I'm assuming ^^^
+
+			// 1. Create the attachment descriptions
+			auto& newAttachmentDesc = result.mAttachmentDescriptions.emplace_back(vk::AttachmentDescription2KHR{}
+				.setFormat(a.format())
+				.setSamples(a.sample_count())
+				.setLoadOp(to_vk_load_op(a.mLoadOperation.mLoadBehavior))
+				.setStoreOp(to_vk_store_op(a.mStoreOperation.mStoreBehavior))
+				.setStencilLoadOp(to_vk_load_op(a.get_stencil_load_op().mLoadBehavior))
+				.setStencilStoreOp(to_vk_store_op(a.get_stencil_store_op().mStoreBehavior))
+			);
+
+			const auto attachmentIndex = static_cast<uint32_t>(result.mAttachmentDescriptions.size() - 1); // Index of this attachment as used in the further subpasses
+
+			// 2. Go throught the subpasses and gather data for subpass config
+			const auto nSubpasses = a.mSubpassUsages.num_subpasses();
+			if (nSubpasses != numSubpassesFirst) {
+				throw avk::runtime_error("All attachments must have the exact same number of subpasses!");
+			}
+
+			// Determine and fill clear values:
+			assert(result.mAttachmentDescriptions.size() == result.mClearValues.size() + 1);
+			size_t spId = 0;
+			while (result.mAttachmentDescriptions.size() != result.mClearValues.size() && spId < nSubpasses) {
+				auto subpassUsage = a.mSubpassUsages.get_subpass_usage(spId);
+				if (subpassUsage.as_color()) {
+					result.mClearValues.emplace_back(vk::ClearColorValue{ a.clear_color() });
+				}
+				if (subpassUsage.as_depth_stencil()) {
+					result.mClearValues.emplace_back(vk::ClearDepthStencilValue{ a.depth_clear_value(), a.stencil_clear_value() });
+				}
+				++spId;
+			}
+			if (result.mAttachmentDescriptions.size() != result.mClearValues.size() ) {
+				result.mClearValues.emplace_back(); // just an empty clear value
+			}
+			assert(result.mAttachmentDescriptions.size() == result.mClearValues.size());
+
+			// Now go over all the sub passes and remember initial and final layouts along the way
+			std::optional<vk::ImageLayout> initialLayout{};
+			std::optional<vk::ImageLayout> finalLayout{};
+			auto useLayout = [&initialLayout, &finalLayout](vk::ImageLayout aLayout) {
+				if (!initialLayout.has_value()) {
+					initialLayout = aLayout;
+				}
+				finalLayout = aLayout;
+				return aLayout;
+			};
+
+			for (size_t i = 0; i < nSubpasses; ++i) {
+				auto& sp = subpasses[i];
+				auto subpassUsage = a.mSubpassUsages.get_subpass_usage(i);
+				auto subpassAspect = static_cast<bool>(subpassUsage.mAspectToBeUsed) ? subpassUsage.mAspectToBeUsed : vk::ImageAspectFlags{ attachmentAspect };
+				if (subpassUsage.as_input()) {
+					assert(!subpassUsage.has_resolve() || subpassUsage.as_color()); // Can not resolve input attachments, it's fine if it's also used as color attachment
+					if (subpassUsage.has_input_location()) {
+						auto loc = subpassUsage.input_location();
+						if (sp.mSpecificInputLocations.count(loc) != 0) {
+							throw avk::runtime_error("Layout location " + std::to_string(loc) + " is used multiple times for an input attachments in subpass " + std::to_string(i) + ". This is not allowed.");
+						}
+						sp.mSpecificInputLocations[loc] = vk::AttachmentReference2KHR{}
+							.setAttachment(attachmentIndex)
+							.setLayout(useLayout(vk::ImageLayout::eShaderReadOnlyOptimal))
+							.setAspectMask(subpassAspect);
+						sp.mInputMaxLoc = std::max(sp.mInputMaxLoc, loc);
+					}
+					else {
+						AVK_LOG_WARNING("No layout location is specified for an input attachment in subpass " + std::to_string(i) + ". This might be problematic. Consider declaring it 'unused'.");
+						sp.mUnspecifiedInputLocations.push(vk::AttachmentReference2KHR{}
+							.setAttachment(attachmentIndex)
+							.setLayout(useLayout(vk::ImageLayout::eShaderReadOnlyOptimal))
+							.setAspectMask(subpassAspect)
+						);
+					}
+				}
+				if (subpassUsage.as_color()) {
+					auto resolve = subpassUsage.has_resolve();
+					if (subpassUsage.has_color_location()) {
+						auto loc = subpassUsage.color_location();
+						if (sp.mSpecificColorLocations.count(loc) != 0) {
+							throw avk::runtime_error("Layout location " + std::to_string(loc) + " is used multiple times for a color attachments in subpass " + std::to_string(i) + ". This is not allowed.");
+						}
+						sp.mSpecificColorLocations[loc] =	vk::AttachmentReference2KHR{}
+							.setAttachment(attachmentIndex)
+							.setLayout(useLayout(vk::ImageLayout::eColorAttachmentOptimal))
+							.setAspectMask(subpassAspect);
+						sp.mSpecificColorResolveLocations[loc] =	vk::AttachmentReference2KHR{}
+							.setAttachment(resolve ? subpassUsage.resolve_target_index() : VK_ATTACHMENT_UNUSED)
+							.setLayout(useLayout(vk::ImageLayout::eColorAttachmentOptimal))
+							.setAspectMask(subpassAspect);
+						sp.mColorMaxLoc = std::max(sp.mColorMaxLoc, loc);
+					}
+					else {
+						AVK_LOG_WARNING("No layout location is specified for a color attachment in subpass " + std::to_string(i) + ". This might be problematic. Consider declaring it 'unused'.");
+						sp.mUnspecifiedColorLocations.push(vk::AttachmentReference2KHR{}
+							.setAttachment(attachmentIndex)
+							.setLayout(useLayout(vk::ImageLayout::eColorAttachmentOptimal))
+							.setAspectMask(subpassAspect)
+						);
+						sp.mUnspecifiedColorResolveLocations.push(vk::AttachmentReference2KHR{}
+							.setAttachment(resolve ? subpassUsage.resolve_target_index() : VK_ATTACHMENT_UNUSED)
+							.setLayout(useLayout(vk::ImageLayout::eColorAttachmentOptimal))
+							.setAspectMask(subpassAspect)
+						);
+					}
+				}
+				if (subpassUsage.as_depth_stencil()) {
+					auto resolve = subpassUsage.has_resolve();
+					sp.mUnspecifiedDepthStencilLocations.push(vk::AttachmentReference2KHR{}
+						.setAttachment(attachmentIndex)
+						.setLayout(useLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal))
+						.setAspectMask(subpassAspect)
+					);
+					if (resolve) {
+						sp.mUnspecifiedDepthStencilResolveData.push(vk::SubpassDescriptionDepthStencilResolve{}
+							.setDepthResolveMode(  static_cast<bool>(subpassUsage.mResolveModeDepth)   ? static_cast<vk::ResolveModeFlagBits>(static_cast<vk::ResolveModeFlags::MaskType>(subpassUsage.mResolveModeDepth)  ) : vk::ResolveModeFlagBits::eSampleZero)
+							.setStencilResolveMode(static_cast<bool>(subpassUsage.mResolveModeStencil) ? static_cast<vk::ResolveModeFlagBits>(static_cast<vk::ResolveModeFlags::MaskType>(subpassUsage.mResolveModeStencil)) : vk::ResolveModeFlagBits::eSampleZero)
+							// pDepthStencilResolveAttachment to be set later to aligned vector   vvv   never forgetti!
+						);
+						sp.mUnspecifiedDepthStencilResolveRefs.push(vk::AttachmentReference2KHR{}
+							.setAttachment(resolve ? subpassUsage.resolve_target_index() : VK_ATTACHMENT_UNUSED)
+							.setLayout(useLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal))
+							.setAspectMask(subpassAspect)
+						);
+					}
+				}
+				if (subpassUsage.as_preserve()) {
+					assert(!subpassUsage.has_resolve() || subpassUsage.as_color()); // Can not resolve input attachments, it's fine if it's also used as color attachment
+					assert(!subpassUsage.as_input() && !subpassUsage.as_color() && !subpassUsage.as_depth_stencil()); // Makes no sense to preserve and use as something else
+					sp.mPreserveAttachments.push_back(attachmentIndex);
+				}
+				if (subpassUsage.as_unused()) {
+					for (const auto& aaaarr : aAttachments) {
+						if (aaaarr.mSubpassUsages.get_subpass_usage(i).resolve_target_index() == attachmentIndex) { // Talkin 'bout me, bro?
+							if (aaaarr.mSubpassUsages.get_subpass_usage(i).as_color()) {
+								useLayout(vk::ImageLayout::eColorAttachmentOptimal);
+							}
+							else if (aaaarr.mSubpassUsages.get_subpass_usage(i).as_depth_stencil()) {
+								useLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
+							}
+						}
+					}
+				}
+			}
+
+			// Now that we have found all the subpass data => set initial and final layouts
+			newAttachmentDesc
+				.setInitialLayout(a.mLoadOperation.mPreviousLayout.has_value() ? a.mLoadOperation.mPreviousLayout.value().mLayout : initialLayout.value_or(vk::ImageLayout::eUndefined))
+				.setFinalLayout(  a.mStoreOperation.mTargetLayout.has_value()  ? a.mStoreOperation.mTargetLayout.value().mLayout  : finalLayout.value_or(  vk::ImageLayout::eUndefined));
+		}
+
+		// 3. Fill all the vectors in the right order:
+		const auto unusedAttachmentRef = vk::AttachmentReference2KHR{}.setAttachment(VK_ATTACHMENT_UNUSED);
+		result.mSubpassData.reserve(numSubpassesFirst);
+		for (size_t i = 0; i < numSubpassesFirst; ++i) {
+			auto& a = subpasses[i];
+			auto& b = result.mSubpassData.emplace_back();
+			assert(result.mSubpassData.size() == i + 1);
+			// INPUT ATTACHMENTS
+			for (int loc = 0; loc <= a.mInputMaxLoc || !a.mUnspecifiedInputLocations.empty(); ++loc) {
+				if (a.mSpecificInputLocations.count(loc) > 0) {
+					assert (a.mSpecificInputLocations.count(loc) == 1);
+					b.mOrderedInputAttachmentRefs.push_back(a.mSpecificInputLocations[loc]);
+				}
+				else {
+					if (!a.mUnspecifiedInputLocations.empty()) {
+						b.mOrderedInputAttachmentRefs.push_back(a.mUnspecifiedInputLocations.front());
+						a.mUnspecifiedInputLocations.pop();
+					}
+					else {
+						b.mOrderedInputAttachmentRefs.push_back(unusedAttachmentRef);
+					}
+				}
+			}
+			// COLOR ATTACHMENTS
+			for (int loc = 0; loc <= a.mColorMaxLoc || !a.mUnspecifiedColorLocations.empty(); ++loc) {
+				if (a.mSpecificColorLocations.count(loc) > 0) {
+					assert (a.mSpecificColorLocations.count(loc) == 1);
+					assert (a.mSpecificColorResolveLocations.count(loc) == 1);
+					b.mOrderedColorAttachmentRefs.push_back(a.mSpecificColorLocations[loc]);
+					b.mOrderedColorResolveAttachmentRefs.push_back(a.mSpecificColorResolveLocations[loc]);
+				}
+				else {
+					if (!a.mUnspecifiedColorLocations.empty()) {
+						assert(a.mUnspecifiedColorLocations.size() == a.mUnspecifiedColorResolveLocations.size());
+						b.mOrderedColorAttachmentRefs.push_back(a.mUnspecifiedColorLocations.front());
+						a.mUnspecifiedColorLocations.pop();
+						b.mOrderedColorResolveAttachmentRefs.push_back(a.mUnspecifiedColorResolveLocations.front());
+						a.mUnspecifiedColorResolveLocations.pop();
+					}
+					else {
+						b.mOrderedColorAttachmentRefs.push_back(unusedAttachmentRef);
+						b.mOrderedColorResolveAttachmentRefs.push_back(unusedAttachmentRef);
+					}
+				}
+			}
+			// DEPTH/STENCIL ATTACHMENTS
+			for (int loc = 0; loc <= a.mDepthStencilMaxLoc || !a.mUnspecifiedDepthStencilLocations.empty(); ++loc) {
+				if (!a.mUnspecifiedDepthStencilLocations.empty()) {
+					b.mOrderedDepthStencilAttachmentRefs.push_back(a.mUnspecifiedDepthStencilLocations.front());
+					a.mUnspecifiedDepthStencilLocations.pop();
+					if (!a.mUnspecifiedDepthStencilResolveRefs.empty()) {
+						assert(a.mUnspecifiedDepthStencilResolveRefs.size() == a.mUnspecifiedDepthStencilResolveData.size());
+						b.mOrderedDepthStencilResolveAttachmentRefs.push_back(a.mUnspecifiedDepthStencilResolveRefs.front());
+						a.mUnspecifiedDepthStencilResolveRefs.pop();
+						b.mOrderedDepthStencilResolveAttachmentData.push_back(a.mUnspecifiedDepthStencilResolveData.front());
+						a.mUnspecifiedDepthStencilResolveData.pop();
+					}
+				}
+				else {
+					b.mOrderedDepthStencilAttachmentRefs.push_back(unusedAttachmentRef);
+				}
+			}
+			b.mPreserveAttachments = std::move(a.mPreserveAttachments);
+
+			// SOME SANITY CHECKS:
+			// - The color resolve attachments must either be empty or there must be a entry for each color attachment
+			assert(b.mOrderedColorResolveAttachmentRefs.empty() || b.mOrderedColorResolveAttachmentRefs.size() == b.mOrderedColorAttachmentRefs.size());
+			// - The depth/stencil resolve attachments must either be empty or there must be a entry for each depth/stencil attachment
+			assert(b.mOrderedDepthStencilResolveAttachmentRefs.empty() || b.mOrderedDepthStencilResolveAttachmentRefs.size() == b.mOrderedDepthStencilAttachmentRefs.size());
+			// - There must not be more than 1 depth/stencil attachements
+			assert(b.mOrderedDepthStencilAttachmentRefs.size() <= 1);
+		}
+
+		// Done with the helper structure:
+		subpasses.clear();
+
+		// 4. Now we can fill the subpass description
+		rewire_subpass_descriptions(result);
+
+		// ======== Subpass Dependencies ==========
+		// Store whatever the user has passed to not lose any data:
+		result.mSubpassDependencies = std::move(aSubpassDependencies);
+		auto [subpassDependencies, memoryBarriers] = compile_subpass_dependencies(result);
+		rewire_subpass_dependencies(subpassDependencies, memoryBarriers);
+
+		// Finally, create the render pass
+		result.mCreateInfo = vk::RenderPassCreateInfo2KHR{}
+			.setAttachmentCount(static_cast<uint32_t>(result.mAttachmentDescriptions.size()))
+			.setPAttachments(result.mAttachmentDescriptions.data())
+			.setSubpassCount(static_cast<uint32_t>(result.mSubpasses.size()))
+			.setPSubpasses(result.mSubpasses.data())
+			.setDependencyCount(static_cast<uint32_t>(subpassDependencies.size()))
+			.setPDependencies(subpassDependencies.data());
+
+		// Maybe alter the config?!
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		result.mRenderPass = device().createRenderPass2KHRUnique(result.mCreateInfo, nullptr, dispatch_loader_ext());
+		return result;
+
+		// TODO: Support VkSubpassDescriptionDepthStencilResolveKHR in order to enable resolve-settings for the depth attachment (see [1] and [2] for more details)
+
+		// References:
+		// [1] https://www.khronos.org/registry/vulkan/specs/1.1-extensions/man/html/VkSubpassDescription.html
+		// [2] https://www.khronos.org/registry/vulkan/specs/1.1-extensions/man/html/VkSubpassDescriptionDepthStencilResolveKHR.html
+		// [3] https://www.khronos.org/registry/vulkan/specs/1.1-extensions/man/html/VkPipelineStageFlagBits.html
+	}
+
+	renderpass root::create_renderpass_from_template(const renderpass_t& aTemplate, std::function<void(renderpass_t&)> aAlterConfigBeforeCreation)
+	{
+		renderpass_t result;
+		result.mRoot                   = aTemplate.mRoot;
+		result.mAttachmentDescriptions = aTemplate.mAttachmentDescriptions;
+		result.mClearValues			   = aTemplate.mClearValues			  ;
+		result.mSubpassData			   = aTemplate.mSubpassData			  ;
+		rewire_subpass_descriptions(result); // this will set result.mSubpasses
+		result.mSubpassDependencies	   = aTemplate.mSubpassDependencies	  ;
+
+		// Maybe alter the config?!
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		auto [subpassDependencies, memoryBarriers] = compile_subpass_dependencies(result);
+		rewire_subpass_dependencies(subpassDependencies, memoryBarriers);
+
+		// Finally, create the render pass
+		auto createInfo = vk::RenderPassCreateInfo2KHR{}
+			.setAttachmentCount(static_cast<uint32_t>(result.mAttachmentDescriptions.size()))
+			.setPAttachments(result.mAttachmentDescriptions.data())
+			.setSubpassCount(static_cast<uint32_t>(result.mSubpasses.size()))
+			.setPSubpasses(result.mSubpasses.data())
+			.setDependencyCount(static_cast<uint32_t>(subpassDependencies.size()))
+			.setPDependencies(subpassDependencies.data());
+		
+		result.mRenderPass = device().createRenderPass2KHRUnique(createInfo, nullptr, dispatch_loader_ext());
+		return result;
+	}
+
+	bool renderpass_t::is_input_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		assert(aAttachmentIndex < mAttachmentDescriptions.size());
+		return b.mOrderedInputAttachmentRefs.end() != std::find_if(std::begin(b.mOrderedInputAttachmentRefs), std::end(b.mOrderedInputAttachmentRefs),
+			[aAttachmentIndex](const vk::AttachmentReference2KHR& ref) { return ref.attachment == aAttachmentIndex; });
+	}
+
+	bool renderpass_t::is_color_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		assert(aAttachmentIndex < mAttachmentDescriptions.size());
+		return b.mOrderedColorAttachmentRefs.end() != std::find_if(std::begin(b.mOrderedColorAttachmentRefs), std::end(b.mOrderedColorAttachmentRefs),
+			[aAttachmentIndex](const vk::AttachmentReference2KHR& ref) { return ref.attachment == aAttachmentIndex; });
+	}
+
+	bool renderpass_t::is_depth_stencil_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		assert(aAttachmentIndex < mAttachmentDescriptions.size());
+		return b.mOrderedDepthStencilAttachmentRefs.end() != std::find_if(std::begin(b.mOrderedDepthStencilAttachmentRefs), std::end(b.mOrderedDepthStencilAttachmentRefs),
+			[aAttachmentIndex](const vk::AttachmentReference2KHR& ref) { return ref.attachment == aAttachmentIndex; });
+	}
+
+	bool renderpass_t::is_resolve_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		assert(aAttachmentIndex < mAttachmentDescriptions.size());
+		return b.mOrderedColorResolveAttachmentRefs.end() != std::find_if(std::begin(b.mOrderedColorResolveAttachmentRefs), std::end(b.mOrderedColorResolveAttachmentRefs),
+			[aAttachmentIndex](const vk::AttachmentReference2KHR& ref) { return ref.attachment == aAttachmentIndex; });
+	}
+
+	bool renderpass_t::is_preserve_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		assert(aAttachmentIndex < mAttachmentDescriptions.size());
+		return b.mPreserveAttachments.end() != std::find_if(std::begin(b.mPreserveAttachments), std::end(b.mPreserveAttachments),
+			[aAttachmentIndex](uint32_t idx) { return idx == aAttachmentIndex; });
+	}
+
+	const std::vector<vk::AttachmentReference2KHR>& renderpass_t::input_attachments_for_subpass(uint32_t aSubpassId) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		return b.mOrderedInputAttachmentRefs;
+	}
+
+	const std::vector<vk::AttachmentReference2KHR>& renderpass_t::color_attachments_for_subpass(uint32_t aSubpassId) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		return b.mOrderedColorAttachmentRefs;
+	}
+
+	const std::vector<vk::AttachmentReference2KHR>& renderpass_t::depth_stencil_attachments_for_subpass(uint32_t aSubpassId) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		return b.mOrderedDepthStencilAttachmentRefs;
+	}
+
+	const std::vector<vk::AttachmentReference2KHR>& renderpass_t::resolve_attachments_for_subpass(uint32_t aSubpassId) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		return b.mOrderedColorResolveAttachmentRefs;
+	}
+
+	const std::vector<uint32_t>& renderpass_t::preserve_attachments_for_subpass(uint32_t aSubpassId) const
+	{
+		assert(aSubpassId < mSubpassData.size());
+		auto& b = mSubpassData[aSubpassId];
+		return b.mPreserveAttachments;
+	}
+
+	vk::SampleCountFlagBits renderpass_t::num_samples_for_subpass(uint32_t aSubpassId) const
+	{
+		vk::SampleCountFlagBits numSamples = vk::SampleCountFlagBits::e1;
+
+		// See what is configured in the render pass
+#if defined(_MSC_VER) && _MSC_VER < 1930
+		auto colorAttConfigs = color_attachments_for_subpass(aSubpassId)
+			| std::views::filter([](const vk::AttachmentReference2KHR& colorAttachment) { return colorAttachment.attachment != VK_ATTACHMENT_UNUSED; })
+			| std::views::transform([this](const vk::AttachmentReference2KHR& colorAttachment) { return mAttachmentDescriptions[colorAttachment.attachment]; });
+#else 
+		std::vector<vk::AttachmentDescription2KHR> colorAttConfigs;
+		for (const auto& colorAttachment : color_attachments_for_subpass(aSubpassId)) {
+			if (colorAttachment.attachment != VK_ATTACHMENT_UNUSED) {
+				colorAttConfigs.push_back(mAttachmentDescriptions[colorAttachment.attachment]);
+			}
+		}
+#endif
+
+
+		for (const vk::AttachmentDescription2KHR& config : colorAttConfigs) {
+			typedef std::underlying_type<vk::SampleCountFlagBits>::type EnumType;
+			numSamples = static_cast<vk::SampleCountFlagBits>(std::max(static_cast<EnumType>(config.samples), static_cast<EnumType>(numSamples)));
+		}
+
+#if defined(_DEBUG)
+		for (const vk::AttachmentDescription2KHR& config : colorAttConfigs) {
+			if (config.samples != numSamples) {
+				AVK_LOG_DEBUG("Not all of the color target attachments have the same number of samples configured, fyi. This might be fine, though.");
+			}
+		}
+#endif
+
+		if (vk::SampleCountFlagBits::e1 == numSamples) {
+
+#if defined(_MSC_VER) && _MSC_VER < 1930
+			auto depthAttConfigs = depth_stencil_attachments_for_subpass(aSubpassId)
+				| std::views::filter([](const vk::AttachmentReference2KHR& depthStencilAttachment) { return depthStencilAttachment.attachment != VK_ATTACHMENT_UNUSED; })
+				| std::views::transform([this](const vk::AttachmentReference2KHR& depthStencilAttachment) { return mAttachmentDescriptions[depthStencilAttachment.attachment]; });
+#else 
+			std::vector<vk::AttachmentDescription2KHR> depthAttConfigs;
+			for (const auto& depthStencilAttachment : depth_stencil_attachments_for_subpass(aSubpassId)) {
+				if (depthStencilAttachment.attachment != VK_ATTACHMENT_UNUSED) {
+					depthAttConfigs.push_back(mAttachmentDescriptions[depthStencilAttachment.attachment]);
+				}
+			}
+#endif
+			for (const vk::AttachmentDescription2KHR& config : depthAttConfigs) {
+				typedef std::underlying_type<vk::SampleCountFlagBits>::type EnumType;
+				numSamples = static_cast<vk::SampleCountFlagBits>(std::max(static_cast<EnumType>(config.samples), static_cast<EnumType>(numSamples)));
+			}
+
+#if defined(_DEBUG)
+			for (const vk::AttachmentDescription2KHR& config : depthAttConfigs) {
+				if (config.samples != numSamples) {
+					AVK_LOG_DEBUG("Not all of the depth/stencil target attachments have the same number of samples configured, fyi. This might be fine, though.");
+				}
+			}
+#endif
+
+#if defined(_DEBUG)
+			for (const vk::AttachmentDescription2KHR& config : colorAttConfigs) {
+				if (config.samples != numSamples) {
+					AVK_LOG_DEBUG("Some of the color target attachments have different numbers of samples configured as the depth/stencil attachments, fyi. This might be fine, though.");
+				}
+			}
+#endif
+		}
+
+		return numSamples;
+	}
+#pragma endregion
+
+#pragma region resource state tracker definitions
+	// All access flags which represent writes:
+	static vk::AccessFlags2KHR write_accesses()
+	{
+		static const auto sWriteAccesses = std::get<vk::AccessFlags2KHR>((
+			  access::shader_write
+			| access::color_attachment_write
+			| access::depth_stencil_attachment_write
+			| access::transfer_write
+			| access::host_write
+			| access::memory_write
+			| access::shader_storage_write
+			| access::transform_feedback_write
+			| access::transform_feedback_counter_write
+			| access::acceleration_structure_write
+		).mFlags);
+		return sWriteAccesses;
+	}
+
+	// Collects the resource-specific sync hints of the given action_type_command and of all its nested action_type_commands:
+	static void gather_resource_specific_sync_hints(const command::action_type_command& aActionCmd, std::vector<std::tuple<std::variant<vk::Image, vk::Buffer>, sync::sync_hint>>& aResult)
+	{
+		aResult.insert(std::end(aResult), std::begin(aActionCmd.mResourceSpecificSyncHints), std::end(aActionCmd.mResourceSpecificSyncHints));
+		for (const auto& nested : aActionCmd.mNestedCommandsAndSyncInstructions) {
+			if (std::holds_alternative<command::action_type_command>(nested)) {
+				gather_resource_specific_sync_hints(std::get<command::action_type_command>(nested), aResult);
+			}
+		}
+	}
+
+	// Returns true if the given stage mask includes all of the given stages:
+	static bool stages_cover(vk::PipelineStageFlags2KHR aScope, vk::PipelineStageFlags2KHR aStages)
+	{
+		return (aScope & vk::PipelineStageFlagBits2KHR::eAllCommands) || !(aStages & ~aScope);
+	}
+
+	// Returns true if the given access mask includes all of the given accesses:
+	static bool accesses_cover(vk::AccessFlags2KHR aScope, vk::AccessFlags2KHR aAccess)
+	{
+		auto remaining = aAccess & ~aScope;
+		if (aScope & vk::AccessFlagBits2KHR::eMemoryWrite) {
+			remaining &= ~write_accesses();
+		}
+		if (aScope & vk::AccessFlagBits2KHR::eMemoryRead) {
+			remaining &= write_accesses();
+		}
+		return !remaining;
+	}
+
+	// Returns the flags of a sync command's stage or access variant, or no value if they are to be inferred automatically:
+	template <typename T, typename V>
+	static std::optional<T> fixed_flags_of(const V& aStageOrAccess)
+	{
+		if (std::holds_alternative<T>(aStageOrAccess)) {
+			return std::get<T>(aStageOrAccess);
+		}
+		if (std::holds_alternative<std::monostate>(aStageOrAccess)) {
+			return T{};
+		}
+		return {};
+	}
+
+	std::optional<std::tuple<stage_and_access_precisely, stage_and_access_precisely>> resource_state_tracker::register_access(access_state& aState, vk::PipelineStageFlags2KHR aStages, vk::AccessFlags2KHR aAccess)
+	{
+		const auto writeAccess = aAccess & write_accesses();
+		const auto isWrite = static_cast<bool>(writeAccess);
+
+		stage_and_access_precisely src{};
+		stage_and_access_precisely dst{ aStages, vk::AccessFlagBits2KHR::eNone };
+		if (aState.mWriteStages) {
+			// Read-after-write and write-after-write hazards require a memory dependency, unless the write has already been made visible:
+			const auto alreadyVisible = stages_cover(aState.mVisibleStages, aStages) && accesses_cover(aState.mVisibleAccess, aAccess);
+			if (!alreadyVisible) {
+				src.mStage  |= aState.mWriteStages;
+				src.mAccess |= aState.mWriteAccess;
+				dst.mAccess  = aAccess;
+			}
+		}
+		if (isWrite) {
+			// Write-after-read hazards only require an execution dependency, unless a barrier has established it already:
+			src.mStage |= aState.mReadStages;
+			if (!stages_cover(aState.mReadsOrderedBeforeStages, aStages)) {
+				src.mStage |= aState.mOrderedReadStages;
+			}
+		}
+
+		if (isWrite) {
+			aState.mWriteStages   = aStages;
+			aState.mWriteAccess   = writeAccess;
+			aState.mVisibleStages = vk::PipelineStageFlagBits2KHR::eNone;
+			aState.mVisibleAccess = vk::AccessFlagBits2KHR::eNone;
+			aState.mReadStages    = (aAccess & ~write_accesses()) ? aStages : vk::PipelineStageFlagBits2KHR::eNone;
+			aState.mOrderedReadStages        = vk::PipelineStageFlagBits2KHR::eNone;
+			aState.mReadsOrderedBeforeStages = vk::PipelineStageFlagBits2KHR::eNone;
+		}
+		else {
+			if (dst.mAccess) {
+				aState.mVisibleStages |= aStages;
+				aState.mVisibleAccess |= aAccess;
+			}
+			aState.mReadStages |= aStages;
+		}
+
+		if (!src.mStage) {
+			return {};
+		}
+		return std::make_tuple(src, dst);
+	}
+
+	void resource_state_tracker::register_barrier(access_state& aState, const stage_and_access_precisely& aSrc, const stage_and_access_precisely& aDst, bool aHasLayoutTransition)
+	{
+		if (aHasLayoutTransition) {
+			// A layout transition is a write which is available automatically and has been made visible to the destination scope:
+			aState = access_state{};
+			aState.mWriteStages   = aDst.mStage ? aDst.mStage : vk::PipelineStageFlags2KHR{ vk::PipelineStageFlagBits2KHR::eAllCommands };
+			aState.mVisibleStages = aDst.mStage;
+			aState.mVisibleAccess = aDst.mAccess;
+			return;
+		}
+
+		// The barrier makes the last write visible, if its source scope includes it:
+		if (stages_cover(aSrc.mStage, aState.mWriteStages) && accesses_cover(aSrc.mAccess, aState.mWriteAccess)) {
+			aState.mVisibleStages |= aDst.mStage;
+			aState.mVisibleAccess |= aDst.mAccess;
+		}
+		// The barrier orders the reads before its destination scope, if its source scope includes all of them:
+		if (stages_cover(aSrc.mStage, aState.mReadStages | aState.mOrderedReadStages)) {
+			aState.mReadsOrderedBeforeStages = aState.mReadStages ? aDst.mStage : aState.mReadsOrderedBeforeStages | aDst.mStage;
+			aState.mOrderedReadStages |= aState.mReadStages;
+			aState.mReadStages = vk::PipelineStageFlagBits2KHR::eNone;
+		}
+	}
+
+	void resource_state_tracker::register_sync_command(const sync::sync_type_command& aSyncCmd)
+	{
+		const auto srcStage  = fixed_flags_of<vk::PipelineStageFlags2KHR>(aSyncCmd.src_stage());
+		const auto dstStage  = fixed_flags_of<vk::PipelineStageFlags2KHR>(aSyncCmd.dst_stage());
+		const auto srcAccess = fixed_flags_of<vk::AccessFlags2KHR>(aSyncCmd.src_access());
+		const auto dstAccess = fixed_flags_of<vk::AccessFlags2KHR>(aSyncCmd.dst_access());
+		if (!srcStage.has_value() || !dstStage.has_value() || !srcAccess.has_value() || !dstAccess.has_value() || aSyncCmd.queue_family_ownership_transfer().has_value()) {
+			return;
+		}
+		const auto src = stage_and_access_precisely{ srcStage.value(), srcAccess.value() };
+		const auto dst = stage_and_access_precisely{ dstStage.value(), dstAccess.value() };
+
+		if (aSyncCmd.is_global_execution_barrier() || aSyncCmd.is_global_memory_barrier()) {
+			for (auto& [buffer, state] : mBufferStates) {
+				register_barrier(state, src, dst, false);
+			}
+			for (auto& [image, state] : mImageStates) {
+				register_barrier(state, src, dst, false);
+			}
+		}
+		else if (aSyncCmd.is_buffer_memory_barrier()) {
+			const auto data = aSyncCmd.buffer_memory_barrier_data();
+			auto it = mBufferStates.find(static_cast<VkBuffer>(data.mBuffer));
+			if (std::end(mBufferStates) != it && 0 == data.mOffset && VK_WHOLE_SIZE == data.mSize) {
+				register_barrier(it->second, src, dst, false);
+			}
+		}
+		else if (aSyncCmd.is_image_memory_barrier()) {
+			const auto data = aSyncCmd.image_memory_barrier_data();
+			auto it = mImageStates.find(static_cast<VkImage>(data.mImage));
+			if (std::end(mImageStates) == it) {
+				return;
+			}
+			const auto hasLayoutTransition = data.mLayoutTransition.has_value() && data.mLayoutTransition->mOld.mLayout != data.mLayoutTransition->mNew.mLayout;
+			auto registered = mRegisteredImages.find(static_cast<VkImage>(data.mImage));
+			const auto* image = std::end(mRegisteredImages) == registered ? nullptr : registered->second;
+			const auto& range = data.mSubresourceRange;
+			const auto coversAll = 0 == range.baseMipLevel && 0 == range.baseArrayLayer
+				&& (VK_REMAINING_MIP_LEVELS   == range.levelCount || (nullptr != image && range.levelCount >= image->create_info().mipLevels))
+				&& (VK_REMAINING_ARRAY_LAYERS == range.layerCount || (nullptr != image && range.layerCount >= image->create_info().arrayLayers));
+			if (coversAll) {
+				register_barrier(it->second, src, dst, hasLayoutTransition);
+			}
+			else if (hasLayoutTransition) {
+				// A transition of some subresources is one more write, which subsequent accesses must wait for:
+				it->second.mWriteStages  |= dst.mStage ? dst.mStage : vk::PipelineStageFlags2KHR{ vk::PipelineStageFlagBits2KHR::eAllCommands };
+				it->second.mVisibleStages = vk::PipelineStageFlagBits2KHR::eNone;
+				it->second.mVisibleAccess = vk::AccessFlagBits2KHR::eNone;
+			}
+		}
+	}
+
+	void resource_state_tracker::register_image(const image_t& aImage)
+	{
+		mRegisteredImages[static_cast<VkImage>(aImage.handle())] = &aImage;
+	}
+
+	std::vector<recorded_commands_t> resource_state_tracker::insert_barriers(std::vector<recorded_commands_t> aRecordedCommandsAndSyncInstructions)
+	{
+		std::vector<recorded_commands_t> result;
+		result.reserve(aRecordedCommandsAndSyncInstructions.size());
+
+		std::vector<std::tuple<std::variant<vk::Image, vk::Buffer>, sync::sync_hint>> syncHints;
+		// All accesses of one command to the same resource, accumulated:
+		std::vector<std::tuple<std::variant<vk::Image, vk::Buffer>, vk::PipelineStageFlags2KHR, vk::AccessFlags2KHR>> accesses;
+
+		for (auto& recordee : aRecordedCommandsAndSyncInstructions) {
+			if (!std::holds_alternative<command::action_type_command>(recordee)) {
+				if (std::holds_alternative<sync::sync_type_command>(recordee)) {
+					register_sync_command(std::get<sync::sync_type_command>(recordee));
+				}
+				result.push_back(std::move(recordee));
+				continue;
+			}
+
+			syncHints.clear();
+			gather_resource_specific_sync_hints(std::get<command::action_type_command>(recordee), syncHints);
+			accesses.clear();
+			for (const auto& [res, syncHint] : syncHints) {
+				// If the command does not tell, assume the worst:
+				const auto first = syncHint.mDstForPreviousCmds.value_or(stage_and_access_precisely{ vk::PipelineStageFlagBits2KHR::eAllCommands, vk::AccessFlagBits2KHR::eMemoryRead | vk::AccessFlagBits2KHR::eMemoryWrite });
+				const auto last  = syncHint.mSrcForSubsequentCmds.value_or(stage_and_access_precisely{ vk::PipelineStageFlagBits2KHR::eAllCommands, vk::AccessFlagBits2KHR::eMemoryWrite });
+				auto it = std::find_if(std::begin(accesses), std::end(accesses), [&res](const auto& tpl) { return std::get<0>(tpl) == res; });
+				if (std::end(accesses) == it) {
+					accesses.emplace_back(res, first.mStage | last.mStage, first.mAccess | last.mAccess);
+				}
+				else {
+					std::get<1>(*it) |= first.mStage | last.mStage;
+					std::get<2>(*it) |= first.mAccess | last.mAccess;
+				}
+			}
+
+			// Buffers and registered images are synchronized with one buffer or image memory barrier each, other images with one global memory barrier per command:
+			stage_and_access_precisely imagesSrc{}, imagesDst{};
+			for (const auto& [res, stages, accessFlags] : accesses) {
+				if (std::holds_alternative<vk::Buffer>(res)) {
+					const auto buffer = std::get<vk::Buffer>(res);
+					const auto barrier = register_access(mBufferStates[static_cast<VkBuffer>(buffer)], stages, accessFlags);
+					if (barrier.has_value()) {
+						const auto& [src, dst] = barrier.value();
+						result.emplace_back(sync::sync_type_command{
+							stage::execution_dependency{ src.mStage, dst.mStage },
+							access::memory_dependency{ src.mAccess, dst.mAccess },
+							buffer, 0, VK_WHOLE_SIZE
+						});
+						++mNumInsertedBarriers;
+					}
+				}
+				else {
+					const auto image = std::get<vk::Image>(res);
+					const auto barrier = register_access(mImageStates[static_cast<VkImage>(image)], stages, accessFlags);
+					auto registered = mRegisteredImages.find(static_cast<VkImage>(image));
+					if (barrier.has_value() && std::end(mRegisteredImages) != registered) {
+						const auto& [src, dst] = barrier.value();
+						// Without a layout transition, the barrier keeps the image's layouts. If they are tracked, it updates their last accesses:
+						result.emplace_back(sync::sync_type_command{
+							stage::execution_dependency{ src.mStage, dst.mStage },
+							access::memory_dependency{ src.mAccess, dst.mAccess },
+							image, vk::ImageSubresourceRange{ registered->second->aspect_flags(), 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS },
+							registered->second->layout_state()
+						});
+						++mNumInsertedBarriers;
+					}
+					else if (barrier.has_value()) {
+						const auto& [src, dst] = barrier.value();
+						imagesSrc.mStage  |= src.mStage;
+						imagesSrc.mAccess |= src.mAccess;
+						imagesDst.mStage  |= dst.mStage;
+						imagesDst.mAccess |= dst.mAccess;
+					}
+				}
+			}
+			if (imagesSrc.mStage) {
+				result.emplace_back(sync::sync_type_command{
+					stage::execution_dependency{ imagesSrc.mStage, imagesDst.mStage },
+					access::memory_dependency{ imagesSrc.mAccess, imagesDst.mAccess }
+				});
+				++mNumInsertedBarriers;
+			}
+
+			result.push_back(std::move(recordee));
+		}
+		return result;
+	}
+#pragma endregion
+
+#pragma region scatter upload definitions
+	scatter_upload_pipeline root::create_scatter_upload_pipeline()
+	{
+		// SPIR-V 1.5 of the following compute shader, which copies one patch per workgroup:
+		//
+		//	#version 460
+		//	#extension GL_EXT_buffer_reference : require
+		//	#extension GL_EXT_buffer_reference_uvec2 : require
+		//	layout(local_size_x = 64) in;
+		//	layout(buffer_reference, std430, buffer_reference_align = 4) buffer words { uint w[]; };
+		//	layout(push_constant) uniform push_constants { uvec2 staging; uvec2 target; uint numPatches; };
+		//	void main() {
+		//		words s = words(staging);
+		//		words d = words(target);
+		//		for (uint p = gl_WorkGroupID.x; p < numPatches; p += gl_NumWorkGroups.x) {
+		//			// Header of each patch in words: { source offset in the staging buffer, offset in the target buffer, size }
+		//			uint srcOffset = s.w[4 * p];
+		//			uint dstOffset = s.w[4 * p + 1];
+		//			uint count = s.w[4 * p + 2];
+		//			for (uint i = gl_LocalInvocationID.x; i < count; i += 64) {
+		//				d.w[dstOffset + i] = s.w[srcOffset + i];
+		//			}
+		//		}
+		//	}
+		static const uint32_t spirv[] = {
+			0x07230203, 0x00010500, 0x00000000, 0x00000047, 0x00000000, 0x00020011, 0x00000001, 0x00020011,
+			0x000014e3, 0x0009000a, 0x5f565053, 0x5f52484b, 0x73796870, 0x6c616369, 0x6f74735f, 0x65676172,
+			0x6675625f, 0x00726566, 0x0003000e, 0x000014e4, 0x00000001, 0x0009000f, 0x00000005, 0x00000001,
+			0x6e69616d, 0x00000000, 0x00000002, 0x00000003, 0x00000004, 0x00000005, 0x00060010, 0x00000001,
+			0x00000011, 0x00000040, 0x00000001, 0x00000001, 0x00040047, 0x00000003, 0x0000000b, 0x0000001a,
+			0x00040047, 0x00000004, 0x0000000b, 0x00000018, 0x00040047, 0x00000005, 0x0000000b, 0x0000001b,
+			0x00040047, 0x00000006, 0x00000006, 0x00000004, 0x00030047, 0x00000007, 0x00000002, 0x00050048,
+			0x00000007, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000008, 0x00000002, 0x00050048,
+			0x00000008, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000008, 0x00000001, 0x00000023,
+			0x00000008, 0x00050048, 0x00000008, 0x00000002, 0x00000023, 0x00000010, 0x00020013, 0x00000009,
+			0x00030021, 0x0000000a, 0x00000009, 0x00040015, 0x0000000b, 0x00000020, 0x00000000, 0x00020014,
+			0x0000000c, 0x00040017, 0x0000000d, 0x0000000b, 0x00000002, 0x00040017, 0x0000000e, 0x0000000b,
+			0x00000003, 0x0003001d, 0x00000006, 0x0000000b, 0x0003001e, 0x00000007, 0x00000006, 0x00040020,
+			0x0000000f, 0x000014e5, 0x00000007, 0x00040020, 0x00000010, 0x000014e5, 0x0000000b, 0x0005001e,
+			0x00000008, 0x0000000d, 0x0000000d, 0x0000000b, 0x00040020, 0x00000011, 0x00000009, 0x00000008,
+			0x00040020, 0x00000012, 0x00000009, 0x0000000d, 0x00040020, 0x00000013, 0x00000009, 0x0000000b,
+			0x00040020, 0x00000014, 0x00000001, 0x0000000e, 0x0004002b, 0x0000000b, 0x00000015, 0x00000000,
+			0x0004002b, 0x0000000b, 0x00000016, 0x00000001, 0x0004002b, 0x0000000b, 0x00000017, 0x00000002,
+			0x0004002b, 0x0000000b, 0x00000018, 0x00000004, 0x0004002b, 0x0000000b, 0x00000019, 0x00000040,
+			0x0004003b, 0x00000011, 0x00000002, 0x00000009, 0x0004003b, 0x00000014, 0x00000003, 0x00000001,
+			0x0004003b, 0x00000014, 0x00000004, 0x00000001, 0x0004003b, 0x00000014, 0x00000005, 0x00000001,
+			0x00050036, 0x00000009, 0x00000001, 0x00000000, 0x0000000a, 0x000200f8, 0x0000001a, 0x00050041,
+			0x00000012, 0x0000001b, 0x00000002, 0x00000015, 0x0004003d, 0x0000000d, 0x0000001c, 0x0000001b,
+			0x00050041, 0x00000012, 0x0000001d, 0x00000002, 0x00000016, 0x0004003d, 0x0000000d, 0x0000001e,
+			0x0000001d, 0x00050041, 0x00000013, 0x0000001f, 0x00000002, 0x00000017, 0x0004003d, 0x0000000b,
+			0x00000020, 0x0000001f, 0x0004007c, 0x0000000f, 0x00000021, 0x0000001c, 0x0004007c, 0x0000000f,
+			0x00000022, 0x0000001e, 0x0004003d, 0x0000000e, 0x00000023, 0x00000003, 0x00050051, 0x0000000b,
+			0x00000024, 0x00000023, 0x00000000, 0x0004003d, 0x0000000e, 0x00000025, 0x00000004, 0x00050051,
+			0x0000000b, 0x00000026, 0x00000025, 0x00000000, 0x0004003d, 0x0000000e, 0x00000027, 0x00000005,
+			0x00050051, 0x0000000b, 0x00000028, 0x00000027, 0x00000000, 0x000200f9, 0x00000029, 0x000200f8,
+			0x00000029, 0x000700f5, 0x0000000b, 0x0000002a, 0x00000024, 0x0000001a, 0x0000002b, 0x0000002c,
+			0x000400f6, 0x0000002d, 0x0000002c, 0x00000000, 0x000200f9, 0x0000002e, 0x000200f8, 0x0000002e,
+			0x000500b0, 0x0000000c, 0x0000002f, 0x0000002a, 0x00000020, 0x000400fa, 0x0000002f, 0x00000030,
+			0x0000002d, 0x000200f8, 0x00000030, 0x00050084, 0x0000000b, 0x00000031, 0x0000002a, 0x00000018,
+			0x00060041, 0x00000010, 0x00000032, 0x00000021, 0x00000015, 0x00000031, 0x0006003d, 0x0000000b,
+			0x00000033, 0x00000032, 0x00000002, 0x00000004, 0x00050080, 0x0000000b, 0x00000034, 0x00000031,
+			0x00000016, 0x00060041, 0x00000010, 0x00000035, 0x00000021, 0x00000015, 0x00000034, 0x0006003d,
+			0x0000000b, 0x00000036, 0x00000035, 0x00000002, 0x00000004, 0x00050080, 0x0000000b, 0x00000037,
+			0x00000031, 0x00000017, 0x00060041, 0x00000010, 0x00000038, 0x00000021, 0x00000015, 0x00000037,
+			0x0006003d, 0x0000000b, 0x00000039, 0x00000038, 0x00000002, 0x00000004, 0x000200f9, 0x0000003a,
+			0x000200f8, 0x0000003a, 0x000700f5, 0x0000000b, 0x0000003b, 0x00000028, 0x00000030, 0x0000003c,
+			0x0000003d, 0x000400f6, 0x0000003e, 0x0000003d, 0x00000000, 0x000200f9, 0x0000003f, 0x000200f8,
+			0x0000003f, 0x000500b0, 0x0000000c, 0x00000040, 0x0000003b, 0x00000039, 0x000400fa, 0x00000040,
+			0x00000041, 0x0000003e, 0x000200f8, 0x00000041, 0x00050080, 0x0000000b, 0x00000042, 0x00000033,
+			0x0000003b, 0x00060041, 0x00000010, 0x00000043, 0x00000021, 0x00000015, 0x00000042, 0x0006003d,
+			0x0000000b, 0x00000044, 0x00000043, 0x00000002, 0x00000004, 0x00050080, 0x0000000b, 0x00000045,
+			0x00000036, 0x0000003b, 0x00060041, 0x00000010, 0x00000046, 0x00000022, 0x00000015, 0x00000045,
+			0x0005003e, 0x00000046, 0x00000044, 0x00000002, 0x00000004, 0x000200f9, 0x0000003d, 0x000200f8,
+			0x0000003d, 0x00050080, 0x0000000b, 0x0000003c, 0x0000003b, 0x00000019, 0x000200f9, 0x0000003a,
+			0x000200f8, 0x0000003e, 0x000200f9, 0x0000002c, 0x000200f8, 0x0000002c, 0x00050080, 0x0000000b,
+			0x0000002b, 0x0000002a, 0x00000026, 0x000200f9, 0x00000029, 0x000200f8, 0x0000002d, 0x000100fd,
+			0x00010038,
+		};
+
+		scatter_upload_pipeline_t result;
+
+		const auto shaderModule = device().createShaderModuleUnique(
+			vk::ShaderModuleCreateInfo{}
+				.setCodeSize(sizeof(spirv))
+				.setPCode(spirv),
+			nullptr, dispatch_loader_core()
+		);
+
+		const auto pushConstantRange = vk::PushConstantRange{ vk::ShaderStageFlagBits::eCompute, 0u, static_cast<uint32_t>(5 * sizeof(uint32_t)) };
+		result.mPipelineLayout = device().createPipelineLayoutUnique(
+			vk::PipelineLayoutCreateInfo{}
+				.setPushConstantRangeCount(1u)
+				.setPPushConstantRanges(&pushConstantRange),
+			nullptr, dispatch_loader_core()
+		);
+
+		auto pipelineInfo = vk::ComputePipelineCreateInfo{}
+			.setStage(vk::PipelineShaderStageCreateInfo{}
+				.setStage(vk::ShaderStageFlagBits::eCompute)
+				.setModule(shaderModule.get())
+				.setPName("main"))
+			.setLayout(result.layout_handle())
+			.setBasePipelineHandle(nullptr)
+			.setBasePipelineIndex(-1);
+#if VK_HEADER_VERSION >= 141
+		auto pipeline = device().createComputePipelineUnique(nullptr, pipelineInfo, nullptr, dispatch_loader_core());
+		result.mPipeline = std::move(pipeline.value);
+#else
+		result.mPipeline = device().createComputePipelineUnique(nullptr, pipelineInfo);
+#endif
+
+		return result;
+	}
+
+	namespace command
+	{
+		action_type_command scatter_upload(const buffer_t& aTargetBuffer, const std::vector<scatter_patch>& aPatches)
+		{
+			auto actionTypeCommand = action_type_command{
+				{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+				{
+					std::make_tuple(aTargetBuffer.handle(), avk::sync::sync_hint{ stage::copy + (access::transfer_read | access::transfer_write), stage::copy + access::transfer_write })
+				}
+			};
+			actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+			// Pack the data tightly, and merge patches which are adjacent in the target buffer into one region:
+			std::vector<vk::BufferCopy> copyRegions;
+			vk::DeviceSize stagingSize = 0;
+			for (const auto& patch : aPatches) {
+				assert(patch.mOffset + patch.mSize <= aTargetBuffer.create_info().size);
+				if (0 == patch.mSize) {
+					continue;
+				}
+				if (!copyRegions.empty() && copyRegions.back().dstOffset + copyRegions.back().size == patch.mOffset) {
+					copyRegions.back().size += patch.mSize;
+				}
+				else {
+					copyRegions.emplace_back(stagingSize, patch.mOffset, patch.mSize);
+				}
+				stagingSize += patch.mSize;
+			}
+			if (copyRegions.empty()) {
+				// Nothing to do here
+				return actionTypeCommand;
+			}
+
+			auto stagingBuffer = root::create_buffer(
+				*aTargetBuffer.root_ptr(),
+				AVK_STAGING_BUFFER_MEMORY_USAGE,
+				vk::BufferUsageFlagBits::eTransferSrc,
+				generic_buffer_meta::create_from_size(stagingSize)
+			);
+			stagingBuffer.enable_shared_ownership(); // Required for storing it in mBeginFun (see buffer_t::fill)
+			{
+				auto mapped = stagingBuffer->map_memory(mapping_access::write);
+				auto* dst = static_cast<uint8_t*>(mapped.get());
+				for (const auto& patch : aPatches) {
+					if (0 == patch.mSize) {
+						continue;
+					}
+					copy_to_mapped_memory(dst, patch.mData, static_cast<size_t>(patch.mSize));
+					dst += patch.mSize;
+				}
+			}
+
+			actionTypeCommand.mBeginFun = [
+				lOwnedStagingBuffer = std::move(stagingBuffer),
+				lDstBufferHandle = aTargetBuffer.handle(),
+				lCopyRegions = std::move(copyRegions)
+			](avk::command_buffer_t& cb) mutable {
+				cb.handle().copyBuffer(lOwnedStagingBuffer->handle(), lDstBufferHandle, static_cast<uint32_t>(lCopyRegions.size()), lCopyRegions.data(), cb.root_ptr()->dispatch_loader_core());
+				cb.handle_lifetime_of(std::move(lOwnedStagingBuffer));
+			};
+
+			return actionTypeCommand;
+		}
+
+		action_type_command scatter_upload(const scatter_upload_pipeline_t& aPipeline, const buffer_t& aTargetBuffer, const std::vector<scatter_patch>& aPatches)
+		{
+			// The compute shader writes whole 32-bit words via the target buffer's device address, and addresses words with 32-bit indices:
+			bool useCompute = aTargetBuffer.has_device_address()
+				&& aPatches.size() >= AVK_SCATTER_UPLOAD_MIN_PATCHES_FOR_COMPUTE
+				&& aTargetBuffer.create_info().size / sizeof(uint32_t) <= std::numeric_limits<uint32_t>::max();
+			vk::DeviceSize dataSize = 0;
+			for (const auto& patch : aPatches) {
+				assert(patch.mOffset + patch.mSize <= aTargetBuffer.create_info().size);
+				useCompute = useCompute && 0 == patch.mOffset % sizeof(uint32_t) && 0 == patch.mSize % sizeof(uint32_t);
+				dataSize += patch.mSize;
+			}
+			const auto headerSize = static_cast<vk::DeviceSize>(4 * sizeof(uint32_t) * aPatches.size());
+			useCompute = useCompute
+				&& dataSize <= static_cast<vk::DeviceSize>(AVK_SCATTER_UPLOAD_MAX_AVERAGE_PATCH_SIZE_FOR_COMPUTE) * aPatches.size()
+				&& (headerSize + dataSize) / sizeof(uint32_t) <= std::numeric_limits<uint32_t>::max();
+			if (!useCompute) {
+				return scatter_upload(aTargetBuffer, aPatches);
+			}
+
+			auto actionTypeCommand = action_type_command{
+				{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+				{
+					std::make_tuple(aTargetBuffer.handle(), avk::sync::sync_hint{ stage::compute_shader + (access::shader_storage_read | access::shader_storage_write), stage::compute_shader + access::shader_storage_write })
+				}
+			};
+			actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+			// Staging memory layout: One header of four words per patch, followed by the patches' data:
+			auto stagingBuffer = root::create_buffer(
+				*aTargetBuffer.root_ptr(),
+				AVK_STAGING_BUFFER_MEMORY_USAGE,
+				vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress,
+				generic_buffer_meta::create_from_size(headerSize + dataSize)
+			);
+			stagingBuffer.enable_shared_ownership(); // Required for storing it in mBeginFun (see buffer_t::fill)
+			{
+				auto mapped = stagingBuffer->map_memory(mapping_access::write);
+				auto* headers = static_cast<uint32_t*>(mapped.get());
+				auto* data = static_cast<uint8_t*>(mapped.get()) + headerSize;
+				auto srcWordOffset = static_cast<uint32_t>(headerSize / sizeof(uint32_t));
+				for (const auto& patch : aPatches) {
+					const uint32_t header[4] = { srcWordOffset, static_cast<uint32_t>(patch.mOffset / sizeof(uint32_t)), static_cast<uint32_t>(patch.mSize / sizeof(uint32_t)), 0u };
+					memcpy(headers, header, sizeof(header));
+					headers += 4;
+					if (patch.mSize > 0) {
+						copy_to_mapped_memory(data, patch.mData, static_cast<size_t>(patch.mSize));
+						data += patch.mSize;
+					}
+					srcWordOffset += static_cast<uint32_t>(patch.mSize / sizeof(uint32_t));
+				}
+			}
+
+			const auto stagingAddress = stagingBuffer->device_address();
+			const auto targetAddress = aTargetBuffer.device_address();
+			// Matches the push constants block of the shader, where each address is stored as uvec2 (low bits first):
+			const std::array<uint32_t, 5> pushConstants = {
+				static_cast<uint32_t>(stagingAddress), static_cast<uint32_t>(stagingAddress >> 32),
+				static_cast<uint32_t>(targetAddress),  static_cast<uint32_t>(targetAddress >> 32),
+				static_cast<uint32_t>(aPatches.size())
+			};
+			// The shader loops over the patches, so the workgroup count may stay within the guaranteed limit:
+			const auto groupCount = static_cast<uint32_t>(std::min(aPatches.size(), size_t{ 65535 }));
+
+			actionTypeCommand.mBeginFun = [
+				lPipelineHandle = aPipeline.handle(),
+				lLayoutHandle = aPipeline.layout_handle(),
+				lOwnedStagingBuffer = std::move(stagingBuffer),
+				pushConstants, groupCount
+			](avk::command_buffer_t& cb) mutable {
+				cb.bind_pipeline(vk::PipelineBindPoint::eCompute, lPipelineHandle);
+				cb.push_constants(lLayoutHandle, vk::ShaderStageFlagBits::eCompute, 0u, static_cast<uint32_t>(sizeof(pushConstants)), pushConstants.data());
+				cb.handle().dispatch(groupCount, 1u, 1u, cb.root_ptr()->dispatch_loader_core());
+				cb.handle_lifetime_of(std::move(lOwnedStagingBuffer));
+			};
+
+			return actionTypeCommand;
+		}
+	}
+#pragma endregion
+
+#pragma region semaphore definitions
+	semaphore_t::semaphore_t()
+		: mCreateInfo{}
+		, mSemaphore{}
+		, mCustomDeleter{}
+	{
+	}
+
+	semaphore_t::~semaphore_t()
+	{
+		if (mCustomDeleter.has_value() && *mCustomDeleter) {
+			// If there is a custom deleter => call it now
+			(*mCustomDeleter)();
+			mCustomDeleter.reset();
+		}
+		// Destroy the dependant instance before destroying myself
+		// ^ This is ensured by the order of the members
+		//   See: https://isocpp.org/wiki/faq/dtors#calling-member-dtors
+	}
+
+	semaphore root::create_semaphore(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation)
+	{
+		semaphore_t result;
+		result.mCreateInfo = vk::SemaphoreCreateInfo{};
+
+		// Maybe alter the config?
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		result.mSemaphore = aDevice.createSemaphoreUnique(result.mCreateInfo, nullptr, aDispatchLoader);
+		return result;
+	}
+
+	semaphore root::create_semaphore(std::function<void(semaphore_t&)> aAlterConfigBeforeCreation)
+	{
+		return create_semaphore(device(), dispatch_loader_core(), std::move(aAlterConfigBeforeCreation));
+	}
+
+	semaphore_t& semaphore_t::handle_lifetime_of(any_owning_resource_t aResource)
+	{
+		mLifetimeHandledResources.push_back(std::move(aResource));
+		return *this;
+	}
+#pragma endregion
+
+#pragma region shader definitions
+	shader shader::prepare(shader_info pInfo)
+	{
+		shader result;
+		result.mInfo = std::move(pInfo);
+		return result;
+	}
+
+	vk::UniqueHandle<vk::ShaderModule, DISPATCH_LOADER_CORE_TYPE> root::build_shader_module_from_binary_code(const std::vector<char>& aCode)
+	{
+		auto createInfo = vk::ShaderModuleCreateInfo()
+			.setCodeSize(aCode.size())
+			.setPCode(reinterpret_cast<const uint32_t*>(aCode.data()));
+
+		return device().createShaderModuleUnique(createInfo, nullptr, dispatch_loader_core());
+	}
+
+	vk::UniqueHandle<vk::ShaderModule, DISPATCH_LOADER_CORE_TYPE> root::build_shader_module_from_file(const std::string& aPath)
+	{
+		auto binFileContents = avk::load_binary_file(aPath);
+		return build_shader_module_from_binary_code(binFileContents);
+	}
+
+	shader root::create_shader(shader_info aInfo)
+	{
+		auto shdr = shader::prepare(std::move(aInfo));
+
+		if (std::filesystem::exists(shdr.info().mPath)) {
+			try {
+				shdr.mShaderModule = build_shader_module_from_file(shdr.info().mPath);
+				shdr.mActualShaderLoadPath = shdr.info().mPath;
+				return shdr;
+			}
+			catch (avk::runtime_error&) {
+			}
+		}
+
+		const std::string secondTry = shdr.info().mPath + ".spv";
+		shdr.mShaderModule = build_shader_module_from_file(secondTry);
+		AVK_LOG_INFO("Couldn't load '" + shdr.info().mPath + "' but loading '" + secondTry + "' was successful => going to use the latter, fyi!");
+		shdr.mActualShaderLoadPath = secondTry;
+
+		return shdr;
+	}
+
+	shader root::create_shader_from_template(const shader& aTemplate)
+	{
+		return create_shader(aTemplate.info());
+	}
+
+	bool shader::has_been_built() const
+	{
+		return static_cast<bool>(mShaderModule);
+	}
+
+	shader_info shader_info::describe(std::string pPath, std::string pEntryPoint, bool pDontMonitorFile, std::optional<shader_type> pShaderType)
+	{
+		pPath = trim_spaces(pPath);
+		if (!pShaderType.has_value()) {
+			// "classical" shaders
+			if (pPath.ends_with(".vert"))	{ pShaderType = shader_type::vertex; }
+			else if (pPath.ends_with(".tesc"))	{ pShaderType = shader_type::tessellation_control; }
+			else if (pPath.ends_with(".tese"))	{ pShaderType = shader_type::tessellation_evaluation; }
+			else if (pPath.ends_with(".geom"))	{ pShaderType = shader_type::geometry; }
+			else if (pPath.ends_with(".frag"))	{ pShaderType = shader_type::fragment; }
+			else if (pPath.ends_with(".comp"))	{ pShaderType = shader_type::compute; }
+			// ray tracing shaders
+			else if (pPath.ends_with(".rgen"))	{ pShaderType = shader_type::ray_generation; }
+			else if (pPath.ends_with(".rahit"))	{ pShaderType = shader_type::any_hit; }
+			else if (pPath.ends_with(".rchit"))	{ pShaderType = shader_type::closest_hit; }
+			else if (pPath.ends_with(".rmiss"))	{ pShaderType = shader_type::miss; }
+			else if (pPath.ends_with(".rint"))	{ pShaderType = shader_type::intersection; }
+			// callable shader
+			else if (pPath.ends_with(".call"))	{ pShaderType = shader_type::callable; }
+			// mesh shaders
+			else if (pPath.ends_with(".task"))	{ pShaderType = shader_type::task; }
+			else if (pPath.ends_with(".mesh"))	{ pShaderType = shader_type::mesh; }
+		}
+
+		if (!pShaderType.has_value()) {
+			throw avk::runtime_error("No shader type set and could not infer it from the file ending.");
+		}
+
+		return shader_info
+		{
+			std::move(pPath),
+			pShaderType.value(),
+			std::move(pEntryPoint),
+			pDontMonitorFile
+		};
+	}
+#pragma endregion
+
+#pragma region vk_utils2 definitions
+	avk::command::action_type_command copy_image_to_another(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, avk::resource_argument<image_t> aDstImage, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags)
+	{
+		auto actionTypeCommand = avk::command::action_type_command {
+			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+			{
+				std::make_tuple(aSrcImage->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read,  stage::copy + access::none           }),
+				std::make_tuple(aDstImage->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
+			},
+			[
+				lRoot = aSrcImage->root_ptr(),
+				lSrcHandle = aSrcImage->handle(),
+				lDstHandle = aDstImage->handle(),
+				aSrcImageLayout, aDstImageLayout, aImageAspectFlags,
+				lExtent = vk::Extent3D{ aSrcImage->width(), aSrcImage->height(), 1u }
+			](avk::command_buffer_t& cb) {
+				const vk::ImageCopy region {
+					vk::ImageSubresourceLayers{ aImageAspectFlags, 0u, 0u, 1u}, vk::Offset3D{ 0, 0, 0 },
+					vk::ImageSubresourceLayers{ aImageAspectFlags, 0u, 0u, 1u }, vk::Offset3D{ 0, 0, 0 }, lExtent
+				};
+
+				cb.handle().copyImage(
+					lSrcHandle, aSrcImageLayout.mLayout,
+					lDstHandle, aDstImageLayout.mLayout,
+					1u, &region,
+					lRoot->dispatch_loader_core()
+				);
+			}
+		};
+
+		if (aSrcImage.is_ownership() || aDstImage.is_ownership()) {
+			actionTypeCommand.mEndFun = [
+				lSrcImage = aSrcImage.move_ownership_or_get_empty(),
+				lDstImage = aDstImage.move_ownership_or_get_empty()
+			](avk::command_buffer_t& cb) mutable {
+				let_it_handle_lifetime_of(cb, lSrcImage);
+				let_it_handle_lifetime_of(cb, lDstImage);
+			};
+		};
+
+		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+		return actionTypeCommand;
+	}
+
+	avk::command::action_type_command blit_image(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, avk::resource_argument<image_t> aDstImage, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags, vk::Filter aFilter)
+	{
+		auto actionTypeCommand = avk::command::action_type_command{
+			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+			{
+				std::make_tuple(aSrcImage->handle(), avk::sync::sync_hint{ stage::blit + access::transfer_read,  stage::blit + access::none           }),
+				std::make_tuple(aDstImage->handle(), avk::sync::sync_hint{ stage::blit + access::transfer_write, stage::blit + access::transfer_write })
+			},
+			[
+				lRoot = aSrcImage->root_ptr(),
+				lSrcHandle = aSrcImage->handle(),
+				lDstHandle = aDstImage->handle(),
+				aSrcImageLayout, aDstImageLayout, aImageAspectFlags, aFilter,
+				lSrcExtent = vk::Extent3D{ aSrcImage->width(), aSrcImage->height(), 1u },
+				lDstExtent = vk::Extent3D{ aDstImage->width(), aDstImage->height(), 1u }
+
+			](avk::command_buffer_t& cb) {
+				const std::array srcOffsets{ vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ static_cast<int32_t>(lSrcExtent.width), static_cast<int32_t>(lSrcExtent.height), 1 }};
+				const std::array dstOffsets{ vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ static_cast<int32_t>(lDstExtent.width), static_cast<int32_t>(lDstExtent.height), 1 }};
+				const vk::ImageBlit region {
+					vk::ImageSubresourceLayers{ aImageAspectFlags, 0u, 0u, 1u }, srcOffsets,
+					vk::ImageSubresourceLayers{ aImageAspectFlags, 0u, 0u, 1u }, dstOffsets
+				};
+
+				cb.handle().blitImage(
+					lSrcHandle, aSrcImageLayout.mLayout,
+					lDstHandle, aDstImageLayout.mLayout,
+					1u, &region,
+					aFilter,
+					lRoot->dispatch_loader_core()
+				);
+			}
+		};
+
+		if (aSrcImage.is_ownership() || aDstImage.is_ownership()) {
+			actionTypeCommand.mEndFun = [
+				lSrcImage = aSrcImage.move_ownership_or_get_empty(),
+				lDstImage = aDstImage.move_ownership_or_get_empty()
+			](avk::command_buffer_t& cb) mutable {
+				let_it_handle_lifetime_of(cb, lSrcImage);
+				let_it_handle_lifetime_of(cb, lDstImage);
+			};
+		};
+
+		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+		return actionTypeCommand;
+	}
+
+	avk::command::action_type_command copy_buffer_to_image_layer_mip_level(avk::resource_argument<buffer_t> aSrcBuffer, avk::resource_argument<image_t> aDstImage, uint32_t aDstLayer, uint32_t aDstLevel, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags)
+	{
+		auto extent = aDstImage->create_info().extent;
+		extent.width  = extent.width  > 1u ? extent.width  >> aDstLevel : 1u;
+		extent.height = extent.height > 1u ? extent.height >> aDstLevel : 1u;
+		extent.depth  = extent.depth  > 1u ? extent.depth  >> aDstLevel : 1u;
+
+		auto actionTypeCommand = avk::command::action_type_command{
+			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+			{
+				std::make_tuple(aSrcBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read,  stage::copy + access::none           }),
+				std::make_tuple(aDstImage->handle(),  avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
+			},
+			[
+				lRoot = aSrcBuffer->root_ptr(),
+				lSrcHandle = aSrcBuffer->handle(),
+				lDstHandle = aDstImage->handle(),
+				aDstLayer, aDstLevel, aDstImageLayout, aImageAspectFlags,
+				extent
+			](avk::command_buffer_t& cb) {
+				// The bufferRowLength and bufferImageHeight fields specify how the pixels are laid out in memory. For example, you could have some padding 
+				// bytes between rows of the image. Specifying 0 for both indicates that the pixels are simply tightly packed like they are in our case. [3]
+				const vk::BufferImageCopy region {
+					0, 0u, 0u,
+					vk::ImageSubresourceLayers{ aImageAspectFlags, aDstLevel, aDstLayer, 1u },
+					vk::Offset3D{ 0, 0, 0 }, extent
+				};
+				cb.handle().copyBufferToImage(
+					lSrcHandle, 
+					lDstHandle, aDstImageLayout.mLayout,
+					1u, &region,
+					lRoot->dispatch_loader_core()
+				);
+			}
+		};
+
+		if (aSrcBuffer.is_ownership() || aDstImage.is_ownership()) {
+			actionTypeCommand.mEndFun = [
+				lSrcBuffer = aSrcBuffer.move_ownership_or_get_empty(),
+				lDstImage = aDstImage.move_ownership_or_get_empty()
+			](avk::command_buffer_t& cb) mutable {
+				let_it_handle_lifetime_of(cb, lSrcBuffer);
+				let_it_handle_lifetime_of(cb, lDstImage);
+			};
+		};
+
+		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
 
-		// 4. Now we can fill the subpass description
-		rewire_subpass_descriptions(result);
+		return actionTypeCommand;
+	}
 
-		// ======== Subpass Dependencies ==========
-		// Store whatever the user has passed to not lose any data:
-		result.mSubpassDependencies = std::move(aSubpassDependencies);
-		auto [subpassDependencies, memoryBarriers] = compile_subpass_dependencies(result);
-		rewire_subpass_dependencies(subpassDependencies, memoryBarriers);
+	avk::command::action_type_command copy_buffer_to_image_mip_level(avk::resource_argument<buffer_t> aSrcBuffer, avk::resource_argument<image_t> aDstImage, uint32_t aDstLevel, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags)
+	{
+		return copy_buffer_to_image_layer_mip_level(std::move(aSrcBuffer), std::move(aDstImage), 0u, aDstLevel, aDstImageLayout, aImageAspectFlags);
+	}
 
-		// Finally, create the render pass
-		result.mCreateInfo = vk::RenderPassCreateInfo2KHR{}
-			.setAttachmentCount(static_cast<uint32_t>(result.mAttachmentDescriptions.size()))
-			.setPAttachments(result.mAttachmentDescriptions.data())
-			.setSubpassCount(static_cast<uint32_t>(result.mSubpasses.size()))
-			.setPSubpasses(result.mSubpasses.data())
-			.setDependencyCount(static_cast<uint32_t>(subpassDependencies.size()))
-			.setPDependencies(subpassDependencies.data());
+	avk::command::action_type_command copy_buffer_to_image(avk::resource_argument<buffer_t> aSrcBuffer, avk::resource_argument<image_t> aDstImage, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags)
+	{
+		return copy_buffer_to_image_mip_level(std::move(aSrcBuffer), std::move(aDstImage), 0u, aDstImageLayout, aImageAspectFlags);
+	}
 
-		// Maybe alter the config?!
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(result);
+	avk::command::action_type_command copy_buffer_to_another(avk::resource_argument<buffer_t> aSrcBuffer, avk::resource_argument<buffer_t> aDstBuffer, std::optional<vk::DeviceSize> aSrcOffset, std::optional<vk::DeviceSize> aDstOffset, std::optional<vk::DeviceSize> aDataSize)
+	{
+		vk::DeviceSize dataSize{ 0 };
+		if (aDataSize.has_value()) {
+			dataSize = aDataSize.value();
+		}
+		else {
+			dataSize = aSrcBuffer->meta_at_index<buffer_meta>().total_size();
 		}
 
-		result.mRenderPass = device().createRenderPass2KHRUnique(result.mCreateInfo, nullptr, dispatch_loader_ext());
-		return result;
+#ifdef _DEBUG
+		{
+			const auto& metaDataSrc = aSrcBuffer->meta_at_index<buffer_meta>();
+			const auto& metaDataDst = aDstBuffer->meta_at_index<buffer_meta>();
+			assert(aSrcOffset.value_or(0) + dataSize <= metaDataSrc.total_size());
+			assert(aDstOffset.value_or(0) + dataSize <= metaDataDst.total_size());
+			assert(aSrcOffset.value_or(0) + dataSize <= metaDataDst.total_size());
+		}
+#endif
 
-		// TODO: Support VkSubpassDescriptionDepthStencilResolveKHR in order to enable resolve-settings for the depth attachment (see [1] and [2] for more details)
+		auto actionTypeCommand = avk::command::action_type_command{
+			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+			{
+				std::make_tuple(aSrcBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read , stage::copy + access::none           }),
+				std::make_tuple(aDstBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
+			},
+			[
+				lRoot = aSrcBuffer->root_ptr(),
+				lSrcHandle = aSrcBuffer->handle(),
+				lDstHandle = aDstBuffer->handle(),
+				lSrcOffset = aSrcOffset.value_or(0),
+				lDstOffset = aDstOffset.value_or(0),
+				dataSize
+			](avk::command_buffer_t& cb) {
+				const vk::BufferCopy region {
+					lSrcOffset, lDstOffset, dataSize
+				};
+				cb.handle().copyBuffer(
+					lSrcHandle, 
+					lDstHandle,
+					1u, &region, 
+					lRoot->dispatch_loader_core()
+				);
+			}
+		};
 
-		// References:
-		// [1] https://www.khronos.org/registry/vulkan/specs/1.1-extensions/man/html/VkSubpassDescription.html
-		// [2] https://www.khronos.org/registry/vulkan/specs/1.1-extensions/man/html/VkSubpassDescriptionDepthStencilResolveKHR.html
-		// [3] https://www.khronos.org/registry/vulkan/specs/1.1-extensions/man/html/VkPipelineStageFlagBits.html
+		if (aSrcBuffer.is_ownership() || aDstBuffer.is_ownership()) {
+			actionTypeCommand.mEndFun = [
+				lSrcBuffer = aSrcBuffer.move_ownership_or_get_empty(),
+				lDstBuffer = aDstBuffer.move_ownership_or_get_empty()
+			](avk::command_buffer_t& cb) mutable {
+				let_it_handle_lifetime_of(cb, lSrcBuffer);
+				let_it_handle_lifetime_of(cb, lDstBuffer);
+			};
+		};
+
+		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+		return actionTypeCommand;
 	}
 
-	renderpass root::create_renderpass_from_template(const renderpass_t& aTemplate, std::function<void(renderpass_t&)> aAlterConfigBeforeCreation)
+	avk::command::action_type_command copy_buffer_to_another(const buffer_slice& aSrcSlice, const buffer_slice& aDstSlice)
 	{
-		renderpass_t result;
-		result.mRoot                   = aTemplate.mRoot;
-		result.mAttachmentDescriptions = aTemplate.mAttachmentDescriptions;
-		result.mClearValues			   = aTemplate.mClearValues			  ;
-		result.mSubpassData			   = aTemplate.mSubpassData			  ;
-		rewire_subpass_descriptions(result); // this will set result.mSubpasses
-		result.mSubpassDependencies	   = aTemplate.mSubpassDependencies	  ;
+		assert(aSrcSlice.size() == aDstSlice.size()); // Source and destination ranges must have the same size
+		return copy_buffer_to_another(aSrcSlice.get_buffer(), aDstSlice.get_buffer(), aSrcSlice.offset(), aDstSlice.offset(), std::min(aSrcSlice.size(), aDstSlice.size()));
+	}
 
-		// Maybe alter the config?!
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(result);
-		}
+	avk::command::action_type_command copy_image_layer_mip_level_to_buffer(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, uint32_t aSrcLayer, uint32_t aSrcLevel, vk::ImageAspectFlags aImageAspectFlags, avk::resource_argument<buffer_t> aDstBuffer, std::optional<vk::DeviceSize> aDstOffset)
+	{
+		auto extent = aSrcImage->create_info().extent;
+		extent.width = extent.width > 1u ? extent.width >> aSrcLevel : 1u;
+		extent.height = extent.height > 1u ? extent.height >> aSrcLevel : 1u;
+		extent.depth = extent.depth > 1u ? extent.depth >> aSrcLevel : 1u;
 
-		auto [subpassDependencies, memoryBarriers] = compile_subpass_dependencies(result);
-		rewire_subpass_dependencies(subpassDependencies, memoryBarriers);
+		auto actionTypeCommand = avk::command::action_type_command{
+			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+			{
+				std::make_tuple(aSrcImage->handle() , avk::sync::sync_hint{ stage::copy + access::transfer_read , stage::copy + access::none           }),
+				std::make_tuple(aDstBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
+			},
+			[
+				lRoot = aSrcImage->root_ptr(),
+				lSrcHandle = aSrcImage->handle(), aSrcImageLayout,
+				lDstHandle = aDstBuffer->handle(),
+				lDstOffset = aDstOffset.value_or(0),
+				aSrcLayer, aSrcLevel, aImageAspectFlags,
+				extent
+			](avk::command_buffer_t& cb) {
+				// The bufferRowLength and bufferImageHeight fields specify how the pixels are laid out in memory. For example, you could have some padding 
+				// bytes between rows of the image. Specifying 0 for both indicates that the pixels are simply tightly packed like they are in our case. [3]
+				const vk::BufferImageCopy region {
+					lDstOffset, 0u, 0u,
+					vk::ImageSubresourceLayers{ aImageAspectFlags, aSrcLevel, aSrcLayer, 1u },
+					vk::Offset3D{ 0, 0, 0 }, extent
+				};
+				cb.handle().copyImageToBuffer(
+					lSrcHandle, aSrcImageLayout.mLayout,
+					lDstHandle,
+					1u, &region, 
+					lRoot->dispatch_loader_ext()
+				);
+			}
+		};
 
-		// Finally, create the render pass
-		auto createInfo = vk::RenderPassCreateInfo2KHR{}
-			.setAttachmentCount(static_cast<uint32_t>(result.mAttachmentDescriptions.size()))
-			.setPAttachments(result.mAttachmentDescriptions.data())
-			.setSubpassCount(static_cast<uint32_t>(result.mSubpasses.size()))
-			.setPSubpasses(result.mSubpasses.data())
-			.setDependencyCount(static_cast<uint32_t>(subpassDependencies.size()))
-			.setPDependencies(subpassDependencies.data());
-		
-		result.mRenderPass = device().createRenderPass2KHRUnique(createInfo, nullptr, dispatch_loader_ext());
-		return result;
+		if (aSrcImage.is_ownership() || aDstBuffer.is_ownership()) {
+			actionTypeCommand.mEndFun = [
+				lSrcImage = aSrcImage.move_ownership_or_get_empty(),
+				lDstBuffer = aDstBuffer.move_ownership_or_get_empty()
+			](avk::command_buffer_t& cb) mutable {
+				let_it_handle_lifetime_of(cb, lSrcImage);
+				let_it_handle_lifetime_of(cb, lDstBuffer);
+			};
+		};
+
+		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+		return actionTypeCommand;
 	}
 
-	bool renderpass_t::is_input_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+	avk::command::action_type_command copy_image_mip_level_to_buffer(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, uint32_t aSrcLevel, vk::ImageAspectFlags aImageAspectFlags, avk::resource_argument<buffer_t> aDstBuffer, std::optional<vk::DeviceSize> aDstOffset)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		assert(aAttachmentIndex < mAttachmentDescriptions.size());
-		return b.mOrderedInputAttachmentRefs.end() != std::find_if(std::begin(b.mOrderedInputAttachmentRefs), std::end(b.mOrderedInputAttachmentRefs),
-			[aAttachmentIndex](const vk::AttachmentReference2KHR& ref) { return ref.attachment == aAttachmentIndex; });
+		return copy_image_layer_mip_level_to_buffer(std::move(aSrcImage), aSrcImageLayout, 0u, aSrcLevel, aImageAspectFlags, std::move(aDstBuffer), aDstOffset);
 	}
 
-	bool renderpass_t::is_color_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+	avk::command::action_type_command copy_image_to_buffer(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, vk::ImageAspectFlags aImageAspectFlags, avk::resource_argument<buffer_t> aDstBuffer, std::optional<vk::DeviceSize> aDstOffset)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		assert(aAttachmentIndex < mAttachmentDescriptions.size());
-		return b.mOrderedColorAttachmentRefs.end() != std::find_if(std::begin(b.mOrderedColorAttachmentRefs), std::end(b.mOrderedColorAttachmentRefs),
-			[aAttachmentIndex](const vk::AttachmentReference2KHR& ref) { return ref.attachment == aAttachmentIndex; });
+		return copy_image_mip_level_to_buffer(std::move(aSrcImage), aSrcImageLayout, 0u, aImageAspectFlags, std::move(aDstBuffer), aDstOffset);
 	}
+#pragma endregion
 
-	bool renderpass_t::is_depth_stencil_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+#pragma region query pool and query definitions
+	query_pool root::create_query_pool(vk::QueryType aQueryType, uint32_t aQueryCount, vk::QueryPipelineStatisticFlags aPipelineStatistics)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		assert(aAttachmentIndex < mAttachmentDescriptions.size());
-		return b.mOrderedDepthStencilAttachmentRefs.end() != std::find_if(std::begin(b.mOrderedDepthStencilAttachmentRefs), std::end(b.mOrderedDepthStencilAttachmentRefs),
-			[aAttachmentIndex](const vk::AttachmentReference2KHR& ref) { return ref.attachment == aAttachmentIndex; });
+		query_pool_t result;
+
+		result.mCreateInfo = vk::QueryPoolCreateInfo{}
+			.setQueryType( aQueryType )
+			.setQueryCount( aQueryCount )
+			.setPipelineStatistics( aPipelineStatistics );
+		result.mQueryPool = device().createQueryPoolUnique(result.mCreateInfo, nullptr, dispatch_loader_core());
+
+		return result;
 	}
 
-	bool renderpass_t::is_resolve_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+	query_pool root::create_query_pool_for_occlusion_queries(uint32_t aNumOcclusionQueries)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		assert(aAttachmentIndex < mAttachmentDescriptions.size());
-		return b.mOrderedColorResolveAttachmentRefs.end() != std::find_if(std::begin(b.mOrderedColorResolveAttachmentRefs), std::end(b.mOrderedColorResolveAttachmentRefs),
-			[aAttachmentIndex](const vk::AttachmentReference2KHR& ref) { return ref.attachment == aAttachmentIndex; });
+		return create_query_pool(vk::QueryType::eOcclusion, aNumOcclusionQueries);
 	}
 
-	bool renderpass_t::is_preserve_attachment(uint32_t aSubpassId, size_t aAttachmentIndex) const
+	query_pool root::create_query_pool_for_timestamp_queries(uint32_t aNumTimestampQueries)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		assert(aAttachmentIndex < mAttachmentDescriptions.size());
-		return b.mPreserveAttachments.end() != std::find_if(std::begin(b.mPreserveAttachments), std::end(b.mPreserveAttachments),
-			[aAttachmentIndex](uint32_t idx) { return idx == aAttachmentIndex; });
+		return create_query_pool(vk::QueryType::eTimestamp, aNumTimestampQueries);
+	}
+	
+	query_pool root::create_query_pool_for_pipeline_statistics_queries(vk::QueryPipelineStatisticFlags aPipelineStatistics, uint32_t aQueryCountMultiplier)
+	{
+		const auto valueAsSomeKindOfInt = static_cast<vk::QueryPipelineStatisticFlags::MaskType>(aPipelineStatistics);
+		const auto count = avk::bit_count(valueAsSomeKindOfInt);
+		return create_query_pool(vk::QueryType::ePipelineStatistics, count * aQueryCountMultiplier, aPipelineStatistics);
 	}
 
-	const std::vector<vk::AttachmentReference2KHR>& renderpass_t::input_attachments_for_subpass(uint32_t aSubpassId) const
+	void query_pool_t::host_reset(uint32_t aFirstQueryIndex, std::optional<uint32_t> aNumQueries)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		return b.mOrderedInputAttachmentRefs;
+		mQueryPool.getOwner().resetQueryPool(handle(), aFirstQueryIndex, aNumQueries.value_or(create_info().queryCount - aFirstQueryIndex));
 	}
 
-	const std::vector<vk::AttachmentReference2KHR>& renderpass_t::color_attachments_for_subpass(uint32_t aSubpassId) const
+	avk::command::action_type_command query_pool_t::reset(uint32_t aFirstQueryIndex, std::optional<uint32_t> aNumQueries)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		return b.mOrderedColorAttachmentRefs;
+		return avk::command::action_type_command{
+			{}, {}, // Sync not applicable here, I guess
+			[
+				lHandle = handle(),
+				aFirstQueryIndex,
+				lNumQueries = aNumQueries.value_or(create_info().queryCount - aFirstQueryIndex)
+			](avk::command_buffer_t& cb) {
+				cb.handle().resetQueryPool(lHandle, aFirstQueryIndex, lNumQueries, cb.root_ptr()->dispatch_loader_core());
+			}
+		};
 	}
 
-	const std::vector<vk::AttachmentReference2KHR>& renderpass_t::depth_stencil_attachments_for_subpass(uint32_t aSubpassId) const
+	avk::command::action_type_command query_pool_t::write_timestamp(uint32_t aQueryIndex, stage::pipeline_stage_flags_precisely aTimestampStage)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		return b.mOrderedDepthStencilAttachmentRefs;
+		return avk::command::action_type_command{
+			{ aTimestampStage + access::none, aTimestampStage + access::none }, // <-- Guess, that's fine. // TODO: Is it?
+			{}, 
+			[
+				lTimestampStage = aTimestampStage.mStage,
+				lHandle = handle(),
+				aQueryIndex
+			](avk::command_buffer_t& cb) {
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				cb.handle().writeTimestamp2KHR(lTimestampStage, lHandle, aQueryIndex, cb.root_ptr()->dispatch_loader_ext());
+#else
+				cb.handle().writeTimestamp2(lTimestampStage, lHandle, aQueryIndex, cb.root_ptr()->dispatch_loader_core());
+#endif
+			}
+		};
 	}
 
-	const std::vector<vk::AttachmentReference2KHR>& renderpass_t::resolve_attachments_for_subpass(uint32_t aSubpassId) const
+	avk::command::action_type_command query_pool_t::begin_query(uint32_t aQueryIndex, vk::QueryControlFlags aFlags)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		return b.mOrderedColorResolveAttachmentRefs;
+		return avk::command::action_type_command{
+			{}, {}, // Sync not applicable here, I guess
+			[
+				lHandle = handle(),
+				aQueryIndex,
+				aFlags
+			](avk::command_buffer_t& cb) {
+				cb.handle().beginQuery(lHandle, aQueryIndex, aFlags, cb.root_ptr()->dispatch_loader_core());
+			}
+		};
 	}
 
-	const std::vector<uint32_t>& renderpass_t::preserve_attachments_for_subpass(uint32_t aSubpassId) const
+	avk::command::action_type_command query_pool_t::end_query(uint32_t aQueryIndex)
 	{
-		assert(aSubpassId < mSubpassData.size());
-		auto& b = mSubpassData[aSubpassId];
-		return b.mPreserveAttachments;
+		return avk::command::action_type_command{
+			{}, {}, // Sync not applicable here, I guess
+			[
+				lHandle = handle(),
+				aQueryIndex
+			](avk::command_buffer_t& cb) {
+				cb.handle().endQuery(lHandle, aQueryIndex, cb.root_ptr()->dispatch_loader_core());
+			}
+		};
 	}
 
-	vk::SampleCountFlagBits renderpass_t::num_samples_for_subpass(uint32_t aSubpassId) const
+	avk::command::action_type_command query_pool_t::copy_results(uint32_t aFirstQueryIndex, uint32_t aNumQueries, const buffer_t& aBuffer, size_t aBufferMetaSkip, vk::QueryResultFlags aFlags)
 	{
-		vk::SampleCountFlagBits numSamples = vk::SampleCountFlagBits::e1;
-
-		// See what is configured in the render pass
-#if defined(_MSC_VER) && _MSC_VER < 1930
-		auto colorAttConfigs = color_attachments_for_subpass(aSubpassId)
-			| std::views::filter([](const vk::AttachmentReference2KHR& colorAttachment) { return colorAttachment.attachment != VK_ATTACHMENT_UNUSED; })
-			| std::views::transform([this](const vk::AttachmentReference2KHR& colorAttachment) { return mAttachmentDescriptions[colorAttachment.attachment]; });
-#else 
-		std::vector<vk::AttachmentDescription2KHR> colorAttConfigs;
-		for (const auto& colorAttachment : color_attachments_for_subpass(aSubpassId)) {
-			if (colorAttachment.attachment != VK_ATTACHMENT_UNUSED) {
-				colorAttConfigs.push_back(mAttachmentDescriptions[colorAttachment.attachment]);
+		auto actionTypeCommand = avk::command::action_type_command{
+			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+			{
+				// As per the specification:
+				//   vkCmdCopyQueryPoolResults is considered to be a transfer operation, and its writes to buffer memory must be
+				//   synchronized using VK_PIPELINE_STAGE_TRANSFER_BIT and VK_ACCESS_TRANSFER_WRITE_BIT before using the results.
+				std::make_tuple(aBuffer.handle(), avk::sync::sync_hint{
+					stage::transfer + access::transfer_write,
+					stage::transfer + access::transfer_write
+				})
+			},
+			[
+				lHandle = handle(),
+				aFirstQueryIndex, aNumQueries, aFlags,
+				lBufferHandle = aBuffer.handle(),
+				lMeta = aBuffer.meta<query_results_buffer_meta>(aBufferMetaSkip)
+			](avk::command_buffer_t& cb) {
+				cb.handle().copyQueryPoolResults(lHandle, aFirstQueryIndex, aNumQueries, lBufferHandle, lMeta.member_description(content_description::query_result).mOffset, lMeta.sizeof_one_element(), aFlags, cb.root_ptr()->dispatch_loader_core());
 			}
-		}
-#endif
-
+		};
 
-		for (const vk::AttachmentDescription2KHR& config : colorAttConfigs) {
-			typedef std::underlying_type<vk::SampleCountFlagBits>::type EnumType;
-			numSamples = static_cast<vk::SampleCountFlagBits>(std::max(static_cast<EnumType>(config.samples), static_cast<EnumType>(numSamples)));
-		}
+		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
 
-#if defined(_DEBUG)
-		for (const vk::AttachmentDescription2KHR& config : colorAttConfigs) {
-			if (config.samples != numSamples) {
-				AVK_LOG_DEBUG("Not all of the color target attachments have the same number of samples configured, fyi. This might be fine, though.");
-			}
-		}
-#endif
+		return actionTypeCommand;
+	}
 
-		if (vk::SampleCountFlagBits::e1 == numSamples) {
+	avk::command::action_type_command query_pool_t::copy_result(uint32_t aOnlyQueryIndex, const buffer_t& aBuffer, size_t aBufferMetaSkip, vk::QueryResultFlags aFlags)
+	{
+		return copy_results(aOnlyQueryIndex, 1u, aBuffer, aBufferMetaSkip, aFlags);
+	}
+#pragma endregion
 
-#if defined(_MSC_VER) && _MSC_VER < 1930
-			auto depthAttConfigs = depth_stencil_attachments_for_subpass(aSubpassId)
-				| std::views::filter([](const vk::AttachmentReference2KHR& depthStencilAttachment) { return depthStencilAttachment.attachment != VK_ATTACHMENT_UNUSED; })
-				| std::views::transform([this](const vk::AttachmentReference2KHR& depthStencilAttachment) { return mAttachmentDescriptions[depthStencilAttachment.attachment]; });
-#else 
-			std::vector<vk::AttachmentDescription2KHR> depthAttConfigs;
-			for (const auto& depthStencilAttachment : depth_stencil_attachments_for_subpass(aSubpassId)) {
-				if (depthStencilAttachment.attachment != VK_ATTACHMENT_UNUSED) {
-					depthAttConfigs.push_back(mAttachmentDescriptions[depthStencilAttachment.attachment]);
-				}
-			}
+#pragma region commands and sync
+	inline static void record_into_command_buffer(
+		command_buffer_t& aCommandBuffer, 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
+#else
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
 #endif
-			for (const vk::AttachmentDescription2KHR& config : depthAttConfigs) {
-				typedef std::underlying_type<vk::SampleCountFlagBits>::type EnumType;
-				numSamples = static_cast<vk::SampleCountFlagBits>(std::max(static_cast<EnumType>(config.samples), static_cast<EnumType>(numSamples)));
-			}
+		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions);
 
-#if defined(_DEBUG)
-			for (const vk::AttachmentDescription2KHR& config : depthAttConfigs) {
-				if (config.samples != numSamples) {
-					AVK_LOG_DEBUG("Not all of the depth/stencil target attachments have the same number of samples configured, fyi. This might be fine, though.");
-				}
-			}
+	inline static void record_range_into_command_buffer(
+		command_buffer_t& aCommandBuffer, 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
+#else
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
 #endif
+		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
+		int aBegin, int aEnd,
+		const barrier_plan* aBarrierPlan);
 
-#if defined(_DEBUG)
-			for (const vk::AttachmentDescription2KHR& config : colorAttConfigs) {
-				if (config.samples != numSamples) {
-					AVK_LOG_DEBUG("Some of the color target attachments have different numbers of samples configured as the depth/stencil attachments, fyi. This might be fine, though.");
-				}
-			}
-#endif
-		}
+	template <typename T>
+	inline static T accumulate_sync_details(
+		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
+		const int aStartIndex,
+		uint32_t aNumSteps,
+		const int aStepDirection,
+		T aDefaultValue,
+		// If the following parameter is provided, it means that we are looking for sync-dependencies w.r.t. this resource only.
+		// If it is not, we are looking for ANY sync-dependencies (e.g., relevant for semaphore signals)
+		std::optional<std::variant<vk::Image, vk::Buffer>> aWrtResource 
+	) {
+		assert(aStartIndex >= 0);
+		assert(aStartIndex < static_cast<int>(aRecordedCommandsAndSyncInstructions.size()));
+		assert(aNumSteps >= 0);
+		assert(aStepDirection == -1 || aStepDirection == 1);
+		
+		T result{};
 
-		return numSamples;
-	}
-#pragma endregion
+		const int ub = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
 
-#pragma region semaphore definitions
-	semaphore_t::semaphore_t()
-		: mCreateInfo{}
-		, mSemaphore{}
-		, mCustomDeleter{}
-	{
-	}
+		// Doesn't make sense if aNumSteps is less than 1, but the user could pass it (e.g., thorugh stage::auto_stages(0)) => just max it:
+		aNumSteps = std::max(aNumSteps, 1u);
+		uint32_t accSoFar = 0; // This must become equal to aNumSteps, then we're done
 
-	semaphore_t::~semaphore_t()
-	{
-		if (mCustomDeleter.has_value() && *mCustomDeleter) {
-			// If there is a custom deleter => call it now
-			(*mCustomDeleter)();
-			mCustomDeleter.reset();
-		}
-		// Destroy the dependant instance before destroying myself
-		// ^ This is ensured by the order of the members
-		//   See: https://isocpp.org/wiki/faq/dtors#calling-member-dtors
-	}
+		for (int i = aStartIndex; i >= 0 && i < ub && accSoFar < aNumSteps; i += aStepDirection) {
+			if (std::holds_alternative<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i])) { // Only regard action_type_commands here!
+																											     // TODO: Do we also have to regard image layout transitions here????!?!?!?!
+				// We used the general sync hint, except if we are looking for a specific resource:
+				auto* syncHint = &std::get<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i]).mSyncHint;
+				if (aWrtResource.has_value()) {
+					// See if we can find a resource-specific one (otherwise do not regard this action_type_command):
+					syncHint = nullptr;
+					for (const auto& [res, resSyncHint] : std::get<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i]).mResourceSpecificSyncHints) {
+						if (res == aWrtResource.value()) {
+							syncHint = &resSyncHint;
+							break;
+						}
+					}
+				}
 
-	semaphore root::create_semaphore(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation)
-	{
-		semaphore_t result;
-		result.mCreateInfo = vk::SemaphoreCreateInfo{};
+				if (nullptr == syncHint) {
+					continue;
+				}
 
-		// Maybe alter the config?
-		if (aAlterConfigBeforeCreation) {
-			aAlterConfigBeforeCreation(result);
+				switch (aStepDirection) {
+				case -1:
+					// Moving backwards, i.e. the previous command(s) "AFTER" values are relevant:
+					if constexpr (std::is_same_v<T, vk::PipelineStageFlags2KHR>) {
+						if (syncHint->mSrcForSubsequentCmds.has_value()) {
+							result |= syncHint->mSrcForSubsequentCmds.value().mStage;
+						}
+						else {
+							result |= aDefaultValue;
+						}
+						accSoFar += 1;
+					}
+					else if constexpr (std::is_same_v<T, vk::AccessFlags2KHR>) {
+						if (syncHint->mSrcForSubsequentCmds.has_value()) {
+							result |= syncHint->mSrcForSubsequentCmds.value().mAccess;
+						}
+						else {
+							result |= aDefaultValue;
+						}
+						accSoFar += 1;
+					}
+					else {
+						throw avk::logic_error("Unsupported T in function accumulate_sync_details.");
+					}
+					break;
+				case  1:
+					// Moving forwards, i.e. the subsequent command(s) "BEFORE" values are relevant:
+					if constexpr (std::is_same_v<T, vk::PipelineStageFlags2KHR>) {
+						if (syncHint->mDstForPreviousCmds.has_value()) {
+							result |= syncHint->mDstForPreviousCmds.value().mStage;
+						}
+						else {
+							result |= aDefaultValue;
+						}
+						accSoFar += 1;
+					}
+					else if constexpr (std::is_same_v<T, vk::AccessFlags2KHR>) {
+						if (syncHint->mDstForPreviousCmds.has_value()) {
+							result |= syncHint->mDstForPreviousCmds.value().mAccess;
+						}
+						else {
+							result |= aDefaultValue;
+						}
+						accSoFar += 1;
+					}
+					else {
+						throw avk::logic_error("Unsupported T in function accumulate_sync_details.");
+					}
+					break;
+				default:
+					throw avk::logic_error("Invalid value for aStepDirection.");
+				}
+			}
 		}
 
-		result.mSemaphore = aDevice.createSemaphoreUnique(result.mCreateInfo, nullptr, aDispatchLoader);
-		return result;
-	}
-
-	semaphore root::create_semaphore(std::function<void(semaphore_t&)> aAlterConfigBeforeCreation)
-	{
-		return create_semaphore(device(), dispatch_loader_core(), std::move(aAlterConfigBeforeCreation));
-	}
-
-	semaphore_t& semaphore_t::handle_lifetime_of(any_owning_resource_t aResource)
-	{
-		mLifetimeHandledResources.push_back(std::move(aResource));
-		return *this;
-	}
-#pragma endregion
-
-#pragma region shader definitions
-	shader shader::prepare(shader_info pInfo)
-	{
-		shader result;
-		result.mInfo = std::move(pInfo);
+		// If we were unable to find anything to sync with, just return the default:
+		if (0 == accSoFar) {
+			result = aDefaultValue;
+		}
 		return result;
 	}
 
-	vk::UniqueHandle<vk::ShaderModule, DISPATCH_LOADER_CORE_TYPE> root::build_shader_module_from_binary_code(const std::vector<char>& aCode)
+	// Precomputes in one forward pass over a list of recorded commands which action_type_commands are relevant for sync
+	// inference: all of them for global barriers, and those with a matching resource-specific sync hint for image and buffer
+	// barriers. The N relevant commands before or after a given position are contiguous in these lists, s.t. accumulate()
+	// yields the same results as accumulate_sync_details in O(N) instead of walking the list of recorded commands.
+	class sync_inference_index
 	{
-		auto createInfo = vk::ShaderModuleCreateInfo()
-			.setCodeSize(aCode.size())
-			.setPCode(reinterpret_cast<const uint32_t*>(aCode.data()));
+		struct relevant_command
+		{
+			int mIndex;
+			const sync::sync_hint* mSyncHint;
+		};
 
-		return device().createShaderModuleUnique(createInfo, nullptr, dispatch_loader_core());
-	}
+		// The stages and accesses of a run of sync hints OR-ed together, and whether any of them has not specified them:
+		struct accumulated_hints
+		{
+			vk::PipelineStageFlags2KHR mStage;
+			vk::AccessFlags2KHR mAccess;
+			bool mAnyUnspecified = false;
+		};
 
-	vk::UniqueHandle<vk::ShaderModule, DISPATCH_LOADER_CORE_TYPE> root::build_shader_module_from_file(const std::string& aPath)
-	{
-		auto binFileContents = avk::load_binary_file(aPath);
-		return build_shader_module_from_binary_code(binFileContents);
-	}
+		struct relevant_commands
+		{
+			std::vector<relevant_command> mCommands;
+			// mSrcPrefix[k]: the accumulated mSrcForSubsequentCmds of mCommands[0..k]
+			std::vector<accumulated_hints> mSrcPrefix;
+			// mDstSuffix[k]: the accumulated mDstForPreviousCmds of mCommands[k..end)
+			std::vector<accumulated_hints> mDstSuffix;
+
+			// Precomputes mSrcPrefix and mDstSuffix, s.t. accumulating from the first or up to the last command takes constant time:
+			void summarize()
+			{
+				const auto add = [](accumulated_hints lSum, const std::optional<stage_and_access_precisely>& lHint) {
+					if (lHint.has_value()) {
+						lSum.mStage |= lHint->mStage;
+						lSum.mAccess |= lHint->mAccess;
+					}
+					else {
+						lSum.mAnyUnspecified = true;
+					}
+					return lSum;
+				};
+				const auto n = mCommands.size();
+				mSrcPrefix.resize(n);
+				mDstSuffix.resize(n);
+				for (size_t k = 0; k < n; ++k) {
+					mSrcPrefix[k] = add(0 == k ? accumulated_hints{} : mSrcPrefix[k - 1], mCommands[k].mSyncHint->mSrcForSubsequentCmds);
+					mDstSuffix[n - 1 - k] = add(0 == k ? accumulated_hints{} : mDstSuffix[n - k], mCommands[n - 1 - k].mSyncHint->mDstForPreviousCmds);
+				}
+			}
+		};
 
-	shader root::create_shader(shader_info aInfo)
-	{
-		auto shdr = shader::prepare(std::move(aInfo));
+	public:
+		explicit sync_inference_index(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions)
+			: mRecordedCommandsAndSyncInstructions{ aRecordedCommandsAndSyncInstructions }
+		{
+			const auto n = aRecordedCommandsAndSyncInstructions.size();
+			mNumActionCommandsBefore.resize(n + 1);
+			mNumResourceCommandsBefore.resize(n);
+			for (size_t i = 0; i < n; ++i) {
+				mNumActionCommandsBefore[i] = static_cast<uint32_t>(mActionCommands.mCommands.size());
+				const auto& recordee = aRecordedCommandsAndSyncInstructions[i];
+				if (std::holds_alternative<command::action_type_command>(recordee)) {
+					const auto& actionCmd = std::get<command::action_type_command>(recordee);
+					mActionCommands.mCommands.push_back(relevant_command{ static_cast<int>(i), &actionCmd.mSyncHint });
+					for (const auto& [res, resSyncHint] : actionCmd.mResourceSpecificSyncHints) {
+						auto& relevant = relevant_commands_of(res).mCommands;
+						// Like accumulate_sync_details, only regard the first sync hint of a command for a given resource:
+						if (relevant.empty() || relevant.back().mIndex != static_cast<int>(i)) {
+							relevant.push_back(relevant_command{ static_cast<int>(i), &resSyncHint });
+						}
+					}
+				}
+				else if (std::holds_alternative<sync::sync_type_command>(recordee)) {
+					const auto& syncCmd = std::get<sync::sync_type_command>(recordee);
+					if (syncCmd.is_image_memory_barrier()) {
+						mNumResourceCommandsBefore[i] = static_cast<uint32_t>(relevant_commands_of(syncCmd.image_memory_barrier_data().mImage).mCommands.size());
+					}
+					else if (syncCmd.is_buffer_memory_barrier()) {
+						mNumResourceCommandsBefore[i] = static_cast<uint32_t>(relevant_commands_of(syncCmd.buffer_memory_barrier_data().mBuffer).mCommands.size());
+					}
+				}
+			}
+			mNumActionCommandsBefore[n] = static_cast<uint32_t>(mActionCommands.mCommands.size());
 
-		if (std::filesystem::exists(shdr.info().mPath)) {
-			try {
-				shdr.mShaderModule = build_shader_module_from_file(shdr.info().mPath);
-				shdr.mActualShaderLoadPath = shdr.info().mPath;
-				return shdr;
+			mActionCommands.summarize();
+			for (auto& [image, relevant] : mImageCommands) {
+				relevant.summarize();
 			}
-			catch (avk::runtime_error&) {
+			for (auto& [buffer, relevant] : mBufferCommands) {
+				relevant.summarize();
 			}
 		}
 
-		const std::string secondTry = shdr.info().mPath + ".spv";
-		shdr.mShaderModule = build_shader_module_from_file(secondTry);
-		AVK_LOG_INFO("Couldn't load '" + shdr.info().mPath + "' but loading '" + secondTry + "' was successful => going to use the latter, fyi!");
-		shdr.mActualShaderLoadPath = secondTry;
+		const std::vector<recorded_commands_t>& recorded_commands_and_sync_instructions() const { return mRecordedCommandsAndSyncInstructions; }
 
-		return shdr;
-	}
+		// Returns true if any action_type_command precedes the element at aIndex:
+		bool has_action_commands_before(int aIndex) const { return mNumActionCommandsBefore[aIndex] > 0; }
 
-	shader root::create_shader_from_template(const shader& aTemplate)
-	{
-		return create_shader(aTemplate.info());
-	}
+		// Same semantics as accumulate_sync_details (see there), but aStartIndex must be the index of a sync_type_command
+		// if aWrtResource is set, and it must refer to the same resource as that sync_type_command.
+		template <typename T>
+		T accumulate(const int aStartIndex, uint32_t aNumSteps, const int aStepDirection, T aDefaultValue, const std::optional<std::variant<vk::Image, vk::Buffer>>& aWrtResource) const
+		{
+			assert(aStartIndex >= 0);
+			assert(aStartIndex < static_cast<int>(mRecordedCommandsAndSyncInstructions.size()));
+			assert(aStepDirection == -1 || aStepDirection == 1);
+			aNumSteps = std::max(aNumSteps, 1u);
+
+			const relevant_commands* relevant = &mActionCommands;
+			// Number of relevant commands before aStartIndex, and whether aStartIndex itself is one of them:
+			size_t numBefore = mNumActionCommandsBefore[aStartIndex];
+			size_t numUpToStart = mNumActionCommandsBefore[aStartIndex + 1];
+			if (aWrtResource.has_value()) {
+				relevant = find_relevant_commands_of(aWrtResource.value());
+				if (nullptr == relevant) {
+					return aDefaultValue;
+				}
+				// aStartIndex is a sync_type_command, i.e., not a relevant command itself:
+				numBefore = numUpToStart = mNumResourceCommandsBefore[aStartIndex];
+			}
 
-	bool shader::has_been_built() const
-	{
-		return static_cast<bool>(mShaderModule);
-	}
+			size_t first, last;
+			if (-1 == aStepDirection) {
+				last  = numUpToStart;
+				first = last - std::min(last, static_cast<size_t>(aNumSteps));
+			}
+			else {
+				first = numBefore;
+				last  = std::min(relevant->mCommands.size(), first + static_cast<size_t>(aNumSteps));
+			}
+			// If we were unable to find anything to sync with, just return the default:
+			if (first == last) {
+				return aDefaultValue;
+			}
 
-	shader_info shader_info::describe(std::string pPath, std::string pEntryPoint, bool pDontMonitorFile, std::optional<shader_type> pShaderType)
-	{
-		pPath = trim_spaces(pPath);
-		if (!pShaderType.has_value()) {
-			// "classical" shaders
-			if (pPath.ends_with(".vert"))	{ pShaderType = shader_type::vertex; }
-			else if (pPath.ends_with(".tesc"))	{ pShaderType = shader_type::tessellation_control; }
-			else if (pPath.ends_with(".tese"))	{ pShaderType = shader_type::tessellation_evaluation; }
-			else if (pPath.ends_with(".geom"))	{ pShaderType = shader_type::geometry; }
-			else if (pPath.ends_with(".frag"))	{ pShaderType = shader_type::fragment; }
-			else if (pPath.ends_with(".comp"))	{ pShaderType = shader_type::compute; }
-			// ray tracing shaders
-			else if (pPath.ends_with(".rgen"))	{ pShaderType = shader_type::ray_generation; }
-			else if (pPath.ends_with(".rahit"))	{ pShaderType = shader_type::any_hit; }
-			else if (pPath.ends_with(".rchit"))	{ pShaderType = shader_type::closest_hit; }
-			else if (pPath.ends_with(".rmiss"))	{ pShaderType = shader_type::miss; }
-			else if (pPath.ends_with(".rint"))	{ pShaderType = shader_type::intersection; }
-			// callable shader
-			else if (pPath.ends_with(".call"))	{ pShaderType = shader_type::callable; }
-			// mesh shaders
-			else if (pPath.ends_with(".task"))	{ pShaderType = shader_type::task; }
-			else if (pPath.ends_with(".mesh"))	{ pShaderType = shader_type::mesh; }
+			// Ranges which extend to the first or to the last relevant command (e.g., auto_stage(N) with N larger than
+			// the number of relevant commands) are looked up from the precomputed summaries in constant time:
+			const accumulated_hints* summary = nullptr;
+			if (-1 == aStepDirection && 0 == first) {
+				summary = &relevant->mSrcPrefix[last - 1];
+			}
+			else if (1 == aStepDirection && relevant->mCommands.size() == last) {
+				summary = &relevant->mDstSuffix[first];
+			}
+			if (nullptr != summary) {
+				T result{};
+				if constexpr (std::is_same_v<T, vk::PipelineStageFlags2KHR>) {
+					result = summary->mStage;
+				}
+				else {
+					result = summary->mAccess;
+				}
+				return summary->mAnyUnspecified ? result | aDefaultValue : result;
+			}
+
+			T result{};
+			for (size_t k = first; k < last; ++k) {
+				// Moving backwards, the previous commands' "AFTER" values are relevant, moving forwards, the subsequent commands' "BEFORE" values:
+				const auto& stageAndAccess = -1 == aStepDirection ? relevant->mCommands[k].mSyncHint->mSrcForSubsequentCmds : relevant->mCommands[k].mSyncHint->mDstForPreviousCmds;
+				if (!stageAndAccess.has_value()) {
+					result |= aDefaultValue;
+				}
+				else if constexpr (std::is_same_v<T, vk::PipelineStageFlags2KHR>) {
+					result |= stageAndAccess.value().mStage;
+				}
+				else {
+					static_assert(std::is_same_v<T, vk::AccessFlags2KHR>, "Unsupported T in sync_inference_index::accumulate.");
+					result |= stageAndAccess.value().mAccess;
+				}
+			}
+			return result;
 		}
 
-		if (!pShaderType.has_value()) {
-			throw avk::runtime_error("No shader type set and could not infer it from the file ending.");
+	private:
+		relevant_commands& relevant_commands_of(const std::variant<vk::Image, vk::Buffer>& aResource)
+		{
+			if (std::holds_alternative<vk::Image>(aResource)) {
+				return mImageCommands[static_cast<VkImage>(std::get<vk::Image>(aResource))];
+			}
+			return mBufferCommands[static_cast<VkBuffer>(std::get<vk::Buffer>(aResource))];
 		}
 
-		return shader_info
+		const relevant_commands* find_relevant_commands_of(const std::variant<vk::Image, vk::Buffer>& aResource) const
 		{
-			std::move(pPath),
-			pShaderType.value(),
-			std::move(pEntryPoint),
-			pDontMonitorFile
-		};
-	}
-#pragma endregion
+			if (std::holds_alternative<vk::Image>(aResource)) {
+				auto it = mImageCommands.find(static_cast<VkImage>(std::get<vk::Image>(aResource)));
+				return std::end(mImageCommands) == it ? nullptr : &it->second;
+			}
+			auto it = mBufferCommands.find(static_cast<VkBuffer>(std::get<vk::Buffer>(aResource)));
+			return std::end(mBufferCommands) == it ? nullptr : &it->second;
+		}
+
+		const std::vector<recorded_commands_t>& mRecordedCommandsAndSyncInstructions;
+		relevant_commands mActionCommands;
+		std::unordered_map<VkImage, relevant_commands> mImageCommands;
+		std::unordered_map<VkBuffer, relevant_commands> mBufferCommands;
+		// Per element: the number of action_type_commands before it
+		std::vector<uint32_t> mNumActionCommandsBefore;
+		// Per image or buffer memory barrier: the number of relevant commands of its resource before it
+		std::vector<uint32_t> mNumResourceCommandsBefore;
+	};
 
-#pragma region vk_utils2 definitions
-	avk::command::action_type_command copy_image_to_another(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, avk::resource_argument<image_t> aDstImage, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags)
-	{
-		auto actionTypeCommand = avk::command::action_type_command {
-			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
-			{
-				std::make_tuple(aSrcImage->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read,  stage::copy + access::none           }),
-				std::make_tuple(aDstImage->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
+	// Internal helper function to resolve the stages and accesses of a barrier, based on:
+	//  - A given sync_type_command (aBarrierData)
+	//  - All the sync_hints of action_type_commands of the recorded commands which aSyncIndex has been built for
+	inline static barrier_plan::sync_scope resolve_sync_scope(
+		const sync::sync_type_command& aBarrierData, 
+		const sync_inference_index& aSyncIndex,
+		int aRecordedStuffIndex
+	) {
+		const auto& recordedCommandsAndSyncInstructions = aSyncIndex.recorded_commands_and_sync_instructions();
+		if (!recordedCommandsAndSyncInstructions.empty()) {
+			assert(std::holds_alternative<sync::sync_type_command>(recordedCommandsAndSyncInstructions[aRecordedStuffIndex]));
+			if (!std::holds_alternative<sync::sync_type_command>(recordedCommandsAndSyncInstructions[aRecordedStuffIndex])) {
+				throw avk::logic_error("The element at aRecordedStuffIndex[" + std::to_string(aRecordedStuffIndex) + "] is not of type sync_type_command.");
+			}
+		}
+
+		auto scope = barrier_plan::sync_scope{};
+
+		// The barrier can be restricted to a specific resource only, in which case, we should only accumulate
+		// sync data from relevant sync hints (i.e., relevant means: restricted to the same resource):
+		std::optional<std::variant<vk::Image, vk::Buffer>> restrictedToSpecificResource;
+		if (aBarrierData.is_image_memory_barrier()) {
+			restrictedToSpecificResource = aBarrierData.image_memory_barrier_data().mImage;
+		}
+		if (aBarrierData.is_buffer_memory_barrier()) {
+			restrictedToSpecificResource = aBarrierData.buffer_memory_barrier_data().mBuffer;
+		}
+		
+		// Handle source stage:
+		std::visit(lambda_overload{
+			[&scope                                                              ](const std::monostate&){
+				scope.mSrcStage = vk::PipelineStageFlagBits2KHR::eNone;
 			},
-			[
-				lRoot = aSrcImage->root_ptr(),
-				lSrcHandle = aSrcImage->handle(),
-				lDstHandle = aDstImage->handle(),
-				aSrcImageLayout, aDstImageLayout, aImageAspectFlags,
-				lExtent = vk::Extent3D{ aSrcImage->width(), aSrcImage->height(), 1u }
-			](avk::command_buffer_t& cb) {
-				const vk::ImageCopy region {
-					vk::ImageSubresourceLayers{ aImageAspectFlags, 0u, 0u, 1u}, vk::Offset3D{ 0, 0, 0 },
-					vk::ImageSubresourceLayers{ aImageAspectFlags, 0u, 0u, 1u }, vk::Offset3D{ 0, 0, 0 }, lExtent
-				};
+			[&scope                                                              ](const vk::PipelineStageFlags2KHR& bFixedStage){
+				scope.mSrcStage = bFixedStage;
+			},
+			[&scope, &aSyncIndex, &recordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::stage::auto_stage_t& bAutoStage){
+				if (recordedCommandsAndSyncInstructions.empty()) {
+					scope.mSrcStage = vk::PipelineStageFlagBits2KHR::eAllCommands;
+				}
+				else {
+					// Gotta determine which stage:
+					scope.mSrcStage = aSyncIndex.accumulate<vk::PipelineStageFlags2KHR>(
+						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
+						/* How many steps to accumulate: */ static_cast<int>(bAutoStage),
+						/* before-wards: */ -1,
+						/* If we can't determine something specific, employ a heavy barrier to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
+						restrictedToSpecificResource
+					);
+				}
+			},
+		}, aBarrierData.src_stage());
 
-				cb.handle().copyImage(
-					lSrcHandle, aSrcImageLayout.mLayout,
-					lDstHandle, aDstImageLayout.mLayout,
-					1u, &region,
-					lRoot->dispatch_loader_core()
-				);
-			}
-		};
+		// Handle destination stage:
+		std::visit(lambda_overload{
+			[&scope                                                              ](const std::monostate&){
+				scope.mDstStage = vk::PipelineStageFlagBits2KHR::eNone;
+			},
+			[&scope                                                              ](const vk::PipelineStageFlags2KHR& bFixedStage){
+				scope.mDstStage = bFixedStage;
+			},
+			[&scope, &aSyncIndex, &recordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::stage::auto_stage_t& bAutoStage){
+				if (recordedCommandsAndSyncInstructions.empty()) {
+					scope.mDstStage = vk::PipelineStageFlagBits2KHR::eAllCommands;
+				}
+				else {
+					// Gotta determine which stage:
+					scope.mDstStage = aSyncIndex.accumulate<vk::PipelineStageFlags2KHR>(
+						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
+						/* How many steps to accumulate: */ static_cast<int>(bAutoStage),
+						/* after-wards: */  1,
+						/* If we can't determine something specific, employ a heavy barrier to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
+						restrictedToSpecificResource
+					);
+				}
+			},
+		}, aBarrierData.dst_stage());
 
-		if (aSrcImage.is_ownership() || aDstImage.is_ownership()) {
-			actionTypeCommand.mEndFun = [
-				lSrcImage = aSrcImage.move_ownership_or_get_empty(),
-				lDstImage = aDstImage.move_ownership_or_get_empty()
-			](avk::command_buffer_t& cb) mutable {
-				let_it_handle_lifetime_of(cb, lSrcImage);
-				let_it_handle_lifetime_of(cb, lDstImage);
-			};
-		};
+		// Handle source access:
+		std::visit(lambda_overload{
+			[&scope                                                              ](const std::monostate&){
+				scope.mSrcAccess = vk::AccessFlagBits2KHR::eNone;
+			},
+			[&scope                                                              ](const vk::AccessFlags2KHR& bFixedAccess){
+				scope.mSrcAccess = bFixedAccess;
+			},
+			[&scope, &aSyncIndex, &recordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::access::auto_access_t& bAutoAccess){
+				if (recordedCommandsAndSyncInstructions.empty()) {
+					scope.mSrcAccess = vk::AccessFlagBits2KHR::eMemoryWrite;
+				}
+				else {
+					// Gotta determine which access:
+					scope.mSrcAccess = aSyncIndex.accumulate<vk::AccessFlags2KHR>(
+						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
+						/* How many steps to accumulate: */ static_cast<int>(bAutoAccess),
+						/* before-wards: */ -1,
+						/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::AccessFlagBits2KHR::eMemoryWrite,
+						restrictedToSpecificResource
+					);
+				}
+			},
+		}, aBarrierData.src_access());
+
+		// Handle destination access:
+		std::visit(lambda_overload{
+			[&scope                                                              ](const std::monostate&){
+				scope.mDstAccess = vk::AccessFlagBits2KHR::eNone;
+			},
+			[&scope                                                              ](const vk::AccessFlags2KHR& bFixedAccess){
+				scope.mDstAccess = bFixedAccess;
+			},
+			[&scope, &aSyncIndex, &recordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::access::auto_access_t& bAutoAccess){
+				if (recordedCommandsAndSyncInstructions.empty()) {
+					scope.mDstAccess = vk::AccessFlagBits2KHR::eMemoryWrite | vk::AccessFlagBits2KHR::eMemoryRead;
+				}
+				else {
+					// Gotta determine which access:
+					scope.mDstAccess = aSyncIndex.accumulate<vk::AccessFlags2KHR>(
+						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
+						/* How many steps to accumulate: */ static_cast<uint32_t>(bAutoAccess),
+						/* after-wards: */  1,
+						/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::AccessFlagBits2KHR::eMemoryWrite | vk::AccessFlagBits2KHR::eMemoryRead,
+						restrictedToSpecificResource
+					);
+				}
+			},
+		}, aBarrierData.dst_access());
 
-		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+		// Without any preceding command, an automatically inferred source scope is a full dependency. Barriers of images with
+		// tracked layouts replace it with the tracked last access of each subresource (see barrier_batch::add_with_tracked_layouts):
+		scope.mSrcUndetermined = std::holds_alternative<avk::stage::auto_stage_t>(aBarrierData.src_stage())
+			&& std::holds_alternative<avk::access::auto_access_t>(aBarrierData.src_access())
+			&& (recordedCommandsAndSyncInstructions.empty() || !aSyncIndex.has_action_commands_before(aRecordedStuffIndex));
 
-		return actionTypeCommand;
+		return scope;
 	}
 
-	avk::command::action_type_command blit_image(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, avk::resource_argument<image_t> aDstImage, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags, vk::Filter aFilter)
+	// Internal helper function to assemble all the data for a barrier, based on:
+	//  - A given sync_type_command (aBarrierData)
+	//  - Its resolved stages and accesses (aScope), see resolve_sync_scope
+	template <typename T>
+	inline static T assemble_barrier_data(const sync::sync_type_command& aBarrierData, const barrier_plan::sync_scope& aScope)
 	{
-		auto actionTypeCommand = avk::command::action_type_command{
-			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
-			{
-				std::make_tuple(aSrcImage->handle(), avk::sync::sync_hint{ stage::blit + access::transfer_read,  stage::blit + access::none           }),
-				std::make_tuple(aDstImage->handle(), avk::sync::sync_hint{ stage::blit + access::transfer_write, stage::blit + access::transfer_write })
-			},
-			[
-				lRoot = aSrcImage->root_ptr(),
-				lSrcHandle = aSrcImage->handle(),
-				lDstHandle = aDstImage->handle(),
-				aSrcImageLayout, aDstImageLayout, aImageAspectFlags, aFilter,
-				lSrcExtent = vk::Extent3D{ aSrcImage->width(), aSrcImage->height(), 1u },
-				lDstExtent = vk::Extent3D{ aDstImage->width(), aDstImage->height(), 1u }
+		// Sanity check: Does T and aBarrierData fit together?
+		assert(
+			   (std::is_same_v<T, vk::MemoryBarrier2KHR>       && (aBarrierData.is_global_execution_barrier() || aBarrierData.is_global_memory_barrier()))
+			|| (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>  && (aBarrierData.is_image_memory_barrier()                                               ))
+			|| (std::is_same_v<T, vk::BufferMemoryBarrier2KHR> && (aBarrierData.is_buffer_memory_barrier()                                              ))
+		);
 
-			](avk::command_buffer_t& cb) {
-				const std::array srcOffsets{ vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ static_cast<int32_t>(lSrcExtent.width), static_cast<int32_t>(lSrcExtent.height), 1 }};
-				const std::array dstOffsets{ vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ static_cast<int32_t>(lDstExtent.width), static_cast<int32_t>(lDstExtent.height), 1 }};
-				const vk::ImageBlit region {
-					vk::ImageSubresourceLayers{ aImageAspectFlags, 0u, 0u, 1u }, srcOffsets,
-					vk::ImageSubresourceLayers{ aImageAspectFlags, 0u, 0u, 1u }, dstOffsets
-				};
+		auto barrier = T{}
+			.setSrcStageMask(aScope.mSrcStage)
+			.setDstStageMask(aScope.mDstStage)
+			.setSrcAccessMask(aScope.mSrcAccess)
+			.setDstAccessMask(aScope.mDstAccess);
 
-				cb.handle().blitImage(
-					lSrcHandle, aSrcImageLayout.mLayout,
-					lDstHandle, aDstImageLayout.mLayout,
-					1u, &region,
-					aFilter,
-					lRoot->dispatch_loader_core()
-				);
+		// For T = vk::MemoryBarrier2KHR, we are done.
+		// But for image memory barriers or buffer memory barriers, there could be more sync data to be filled-in:
+		
+		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>) {
+			auto imageSyncData = aBarrierData.image_memory_barrier_data();
+
+			barrier.setImage(imageSyncData.mImage);
+			barrier.setSubresourceRange(imageSyncData.mSubresourceRange);
+
+			// Specification goes like this:
+			// > When the old and new layout are equal, the layout values are ignored - data is preserved
+			// > no matter what values are specified, or what layout the image is currently in.
+			if (imageSyncData.mLayoutTransition.has_value()) {
+				barrier.setOldLayout(imageSyncData.mLayoutTransition.value().mOld.mLayout);
+				barrier.setNewLayout(imageSyncData.mLayoutTransition.value().mNew.mLayout);
 			}
-		};
+			// else leave both set to 0 which corresponds to eUndefined -> eUndefined, a.k.a. no layout transition
+		}
 
-		if (aSrcImage.is_ownership() || aDstImage.is_ownership()) {
-			actionTypeCommand.mEndFun = [
-				lSrcImage = aSrcImage.move_ownership_or_get_empty(),
-				lDstImage = aDstImage.move_ownership_or_get_empty()
-			](avk::command_buffer_t& cb) mutable {
-				let_it_handle_lifetime_of(cb, lSrcImage);
-				let_it_handle_lifetime_of(cb, lDstImage);
-			};
-		};
+		if constexpr (std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
+			auto bufferSyncData = aBarrierData.buffer_memory_barrier_data();
+			barrier.setBuffer(bufferSyncData.mBuffer);
+			barrier.setOffset(bufferSyncData.mOffset);
+			barrier.setSize(bufferSyncData.mSize);
+		}
 
-		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+		// For both, buffer memory barriers and image memory barriers, queue family o	wnership transfers are relevant:
+		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR> || std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
+			auto qfot = aBarrierData.queue_family_ownership_transfer();
+			barrier.setSrcQueueFamilyIndex(qfot.has_value() ? qfot.value().mSrcQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED);
+			barrier.setDstQueueFamilyIndex(qfot.has_value() ? qfot.value().mDstQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED);
+		}
 
-		return actionTypeCommand;
+		return barrier;
 	}
 
-	avk::command::action_type_command copy_buffer_to_image_layer_mip_level(avk::resource_argument<buffer_t> aSrcBuffer, avk::resource_argument<image_t> aDstImage, uint32_t aDstLayer, uint32_t aDstLevel, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags)
+	// Appends a flat representation of everything which resolve_sync_scope depends on for the given sync hint to aStructure:
+	inline static void append_to_barrier_plan_structure(std::vector<uint64_t>& aStructure, const std::optional<stage_and_access_precisely>& aStageAndAccess)
 	{
-		auto extent = aDstImage->create_info().extent;
-		extent.width  = extent.width  > 1u ? extent.width  >> aDstLevel : 1u;
-		extent.height = extent.height > 1u ? extent.height >> aDstLevel : 1u;
-		extent.depth  = extent.depth  > 1u ? extent.depth  >> aDstLevel : 1u;
-
-		auto actionTypeCommand = avk::command::action_type_command{
-			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
-			{
-				std::make_tuple(aSrcBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read,  stage::copy + access::none           }),
-				std::make_tuple(aDstImage->handle(),  avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
-			},
-			[
-				lRoot = aSrcBuffer->root_ptr(),
-				lSrcHandle = aSrcBuffer->handle(),
-				lDstHandle = aDstImage->handle(),
-				aDstLayer, aDstLevel, aDstImageLayout, aImageAspectFlags,
-				extent
-			](avk::command_buffer_t& cb) {
-				// The bufferRowLength and bufferImageHeight fields specify how the pixels are laid out in memory. For example, you could have some padding 
-				// bytes between rows of the image. Specifying 0 for both indicates that the pixels are simply tightly packed like they are in our case. [3]
-				const vk::BufferImageCopy region {
-					0, 0u, 0u,
-					vk::ImageSubresourceLayers{ aImageAspectFlags, aDstLevel, aDstLayer, 1u },
-					vk::Offset3D{ 0, 0, 0 }, extent
-				};
-				cb.handle().copyBufferToImage(
-					lSrcHandle, 
-					lDstHandle, aDstImageLayout.mLayout,
-					1u, &region,
-					lRoot->dispatch_loader_core()
-				);
-			}
-		};
-
-		if (aSrcBuffer.is_ownership() || aDstImage.is_ownership()) {
-			actionTypeCommand.mEndFun = [
-				lSrcBuffer = aSrcBuffer.move_ownership_or_get_empty(),
-				lDstImage = aDstImage.move_ownership_or_get_empty()
-			](avk::command_buffer_t& cb) mutable {
-				let_it_handle_lifetime_of(cb, lSrcBuffer);
-				let_it_handle_lifetime_of(cb, lDstImage);
-			};
-		};
-
-		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
-
-		return actionTypeCommand;
+		aStructure.push_back(aStageAndAccess.has_value() ? 1 : 0);
+		if (aStageAndAccess.has_value()) {
+			aStructure.push_back(static_cast<VkFlags64>(aStageAndAccess->mStage));
+			aStructure.push_back(static_cast<VkFlags64>(aStageAndAccess->mAccess));
+		}
 	}
 
-	avk::command::action_type_command copy_buffer_to_image_mip_level(avk::resource_argument<buffer_t> aSrcBuffer, avk::resource_argument<image_t> aDstImage, uint32_t aDstLevel, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags)
+	inline static void append_to_barrier_plan_structure(std::vector<uint64_t>& aStructure, const sync::sync_hint& aSyncHint)
 	{
-		return copy_buffer_to_image_layer_mip_level(std::move(aSrcBuffer), std::move(aDstImage), 0u, aDstLevel, aDstImageLayout, aImageAspectFlags);
+		append_to_barrier_plan_structure(aStructure, aSyncHint.mDstForPreviousCmds);
+		append_to_barrier_plan_structure(aStructure, aSyncHint.mSrcForSubsequentCmds);
 	}
 
-	avk::command::action_type_command copy_buffer_to_image(avk::resource_argument<buffer_t> aSrcBuffer, avk::resource_argument<image_t> aDstImage, avk::layout::image_layout aDstImageLayout, vk::ImageAspectFlags aImageAspectFlags)
+	inline static void append_to_barrier_plan_structure(std::vector<uint64_t>& aStructure, const std::variant<vk::Image, vk::Buffer>& aResource)
 	{
-		return copy_buffer_to_image_mip_level(std::move(aSrcBuffer), std::move(aDstImage), 0u, aDstImageLayout, aImageAspectFlags);
+		aStructure.push_back(aResource.index());
+		aStructure.push_back(std::holds_alternative<vk::Image>(aResource)
+			? reinterpret_cast<uint64_t>(static_cast<VkImage>(std::get<vk::Image>(aResource)))
+			: reinterpret_cast<uint64_t>(static_cast<VkBuffer>(std::get<vk::Buffer>(aResource))));
 	}
 
-	avk::command::action_type_command copy_buffer_to_another(avk::resource_argument<buffer_t> aSrcBuffer, avk::resource_argument<buffer_t> aDstBuffer, std::optional<vk::DeviceSize> aSrcOffset, std::optional<vk::DeviceSize> aDstOffset, std::optional<vk::DeviceSize> aDataSize)
+	template <typename F>
+	inline static void append_to_barrier_plan_structure(std::vector<uint64_t>& aStructure, const std::variant<std::monostate, F, uint8_t>& aStageOrAccess)
 	{
-		vk::DeviceSize dataSize{ 0 };
-		if (aDataSize.has_value()) {
-			dataSize = aDataSize.value();
-		}
-		else {
-			dataSize = aSrcBuffer->meta_at_index<buffer_meta>().total_size();
+		aStructure.push_back(aStageOrAccess.index());
+		if (std::holds_alternative<F>(aStageOrAccess)) {
+			aStructure.push_back(static_cast<VkFlags64>(std::get<F>(aStageOrAccess)));
 		}
-
-#ifdef _DEBUG
-		{
-			const auto& metaDataSrc = aSrcBuffer->meta_at_index<buffer_meta>();
-			const auto& metaDataDst = aDstBuffer->meta_at_index<buffer_meta>();
-			assert(aSrcOffset.value_or(0) + dataSize <= metaDataSrc.total_size());
-			assert(aDstOffset.value_or(0) + dataSize <= metaDataDst.total_size());
-			assert(aSrcOffset.value_or(0) + dataSize <= metaDataDst.total_size());
+		else if (std::holds_alternative<uint8_t>(aStageOrAccess)) {
+			aStructure.push_back(std::get<uint8_t>(aStageOrAccess));
 		}
-#endif
-
-		auto actionTypeCommand = avk::command::action_type_command{
-			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
-			{
-				std::make_tuple(aSrcBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read , stage::copy + access::none           }),
-				std::make_tuple(aDstBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
-			},
-			[
-				lRoot = aSrcBuffer->root_ptr(),
-				lSrcHandle = aSrcBuffer->handle(),
-				lDstHandle = aDstBuffer->handle(),
-				lSrcOffset = aSrcOffset.value_or(0),
-				lDstOffset = aDstOffset.value_or(0),
-				dataSize
-			](avk::command_buffer_t& cb) {
-				const vk::BufferCopy region {
-					lSrcOffset, lDstOffset, dataSize
-				};
-				cb.handle().copyBuffer(
-					lSrcHandle, 
-					lDstHandle,
-					1u, &region, 
-					lRoot->dispatch_loader_core()
-				);
-			}
-		};
-
-		if (aSrcBuffer.is_ownership() || aDstBuffer.is_ownership()) {
-			actionTypeCommand.mEndFun = [
-				lSrcBuffer = aSrcBuffer.move_ownership_or_get_empty(),
-				lDstBuffer = aDstBuffer.move_ownership_or_get_empty()
-			](avk::command_buffer_t& cb) mutable {
-				let_it_handle_lifetime_of(cb, lSrcBuffer);
-				let_it_handle_lifetime_of(cb, lDstBuffer);
-			};
-		};
-
-		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
-
-		return actionTypeCommand;
 	}
 
-	avk::command::action_type_command copy_image_layer_mip_level_to_buffer(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, uint32_t aSrcLayer, uint32_t aSrcLevel, vk::ImageAspectFlags aImageAspectFlags, avk::resource_argument<buffer_t> aDstBuffer, std::optional<vk::DeviceSize> aDstOffset)
+	// Gets a flat representation of everything which the stages and accesses of the given commands' sync commands depend on.
+	// State commands are not considered by sync inference, and the nested commands of action commands are resolved separately.
+	inline static std::vector<uint64_t> barrier_plan_structure_of(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions)
 	{
-		auto extent = aSrcImage->create_info().extent;
-		extent.width = extent.width > 1u ? extent.width >> aSrcLevel : 1u;
-		extent.height = extent.height > 1u ? extent.height >> aSrcLevel : 1u;
-		extent.depth = extent.depth > 1u ? extent.depth >> aSrcLevel : 1u;
-
-		auto actionTypeCommand = avk::command::action_type_command{
-			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
-			{
-				std::make_tuple(aSrcImage->handle() , avk::sync::sync_hint{ stage::copy + access::transfer_read , stage::copy + access::none           }),
-				std::make_tuple(aDstBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
-			},
-			[
-				lRoot = aSrcImage->root_ptr(),
-				lSrcHandle = aSrcImage->handle(), aSrcImageLayout,
-				lDstHandle = aDstBuffer->handle(),
-				lDstOffset = aDstOffset.value_or(0),
-				aSrcLayer, aSrcLevel, aImageAspectFlags,
-				extent
-			](avk::command_buffer_t& cb) {
-				// The bufferRowLength and bufferImageHeight fields specify how the pixels are laid out in memory. For example, you could have some padding 
-				// bytes between rows of the image. Specifying 0 for both indicates that the pixels are simply tightly packed like they are in our case. [3]
-				const vk::BufferImageCopy region {
-					lDstOffset, 0u, 0u,
-					vk::ImageSubresourceLayers{ aImageAspectFlags, aSrcLevel, aSrcLayer, 1u },
-					vk::Offset3D{ 0, 0, 0 }, extent
-				};
-				cb.handle().copyImageToBuffer(
-					lSrcHandle, aSrcImageLayout.mLayout,
-					lDstHandle,
-					1u, &region, 
-					lRoot->dispatch_loader_ext()
-				);
+		std::vector<uint64_t> structure;
+		structure.reserve(aRecordedCommandsAndSyncInstructions.size() * 8);
+		for (const auto& recordee : aRecordedCommandsAndSyncInstructions) {
+			if (std::holds_alternative<command::action_type_command>(recordee)) {
+				const auto& actionCmd = std::get<command::action_type_command>(recordee);
+				structure.push_back(1);
+				append_to_barrier_plan_structure(structure, actionCmd.mSyncHint);
+				structure.push_back(actionCmd.mResourceSpecificSyncHints.size());
+				for (const auto& [res, resSyncHint] : actionCmd.mResourceSpecificSyncHints) {
+					append_to_barrier_plan_structure(structure, res);
+					append_to_barrier_plan_structure(structure, resSyncHint);
+				}
 			}
-		};
-
-		if (aSrcImage.is_ownership() || aDstBuffer.is_ownership()) {
-			actionTypeCommand.mEndFun = [
-				lSrcImage = aSrcImage.move_ownership_or_get_empty(),
-				lDstBuffer = aDstBuffer.move_ownership_or_get_empty()
-			](avk::command_buffer_t& cb) mutable {
-				let_it_handle_lifetime_of(cb, lSrcImage);
-				let_it_handle_lifetime_of(cb, lDstBuffer);
-			};
-		};
-
-		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
-
-		return actionTypeCommand;
-	}
-
-	avk::command::action_type_command copy_image_mip_level_to_buffer(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, uint32_t aSrcLevel, vk::ImageAspectFlags aImageAspectFlags, avk::resource_argument<buffer_t> aDstBuffer, std::optional<vk::DeviceSize> aDstOffset)
-	{
-		return copy_image_layer_mip_level_to_buffer(std::move(aSrcImage), aSrcImageLayout, 0u, aSrcLevel, aImageAspectFlags, std::move(aDstBuffer), aDstOffset);
-	}
-
-	avk::command::action_type_command copy_image_to_buffer(avk::resource_argument<image_t> aSrcImage, avk::layout::image_layout aSrcImageLayout, vk::ImageAspectFlags aImageAspectFlags, avk::resource_argument<buffer_t> aDstBuffer, std::optional<vk::DeviceSize> aDstOffset)
-	{
-		return copy_image_mip_level_to_buffer(std::move(aSrcImage), aSrcImageLayout, 0u, aImageAspectFlags, std::move(aDstBuffer), aDstOffset);
+			else if (std::holds_alternative<sync::sync_type_command>(recordee)) {
+				const auto& syncCmd = std::get<sync::sync_type_command>(recordee);
+				structure.push_back(2);
+				if (syncCmd.is_image_memory_barrier()) {
+					append_to_barrier_plan_structure(structure, std::variant<vk::Image, vk::Buffer>{ syncCmd.image_memory_barrier_data().mImage });
+				}
+				else if (syncCmd.is_buffer_memory_barrier()) {
+					append_to_barrier_plan_structure(structure, std::variant<vk::Image, vk::Buffer>{ syncCmd.buffer_memory_barrier_data().mBuffer });
+				}
+				else {
+					structure.push_back(2); // i.e., neither of the variant's indices
+				}
+				append_to_barrier_plan_structure(structure, syncCmd.src_stage());
+				append_to_barrier_plan_structure(structure, syncCmd.dst_stage());
+				append_to_barrier_plan_structure(structure, syncCmd.src_access());
+				append_to_barrier_plan_structure(structure, syncCmd.dst_access());
+			}
+		}
+		return structure;
 	}
-#pragma endregion
 
-#pragma region query pool and query definitions
-	query_pool root::create_query_pool(vk::QueryType aQueryType, uint32_t aQueryCount, vk::QueryPipelineStatisticFlags aPipelineStatistics)
+	// Gets the barrier plan of the given commands from aRoot's barrier_plan_cache, or resolves all of their sync commands and caches the result.
+	// Returns nullptr if the given commands do not contain any sync commands, or if the cache is disabled.
+	inline static std::shared_ptr<const barrier_plan> get_barrier_plan(const root* aRoot, const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions)
 	{
-		query_pool_t result;
+#if AVK_BARRIER_PLAN_CACHE_MAX_ENTRIES > 0
+		const auto isSyncCmd = [](const recorded_commands_t& bRecordee) { return std::holds_alternative<sync::sync_type_command>(bRecordee); };
+		if (nullptr == aRoot || std::none_of(std::begin(aRecordedCommandsAndSyncInstructions), std::end(aRecordedCommandsAndSyncInstructions), isSyncCmd)) {
+			return {};
+		}
 
-		result.mCreateInfo = vk::QueryPoolCreateInfo{}
-			.setQueryType( aQueryType )
-			.setQueryCount( aQueryCount )
-			.setPipelineStatistics( aPipelineStatistics );
-		result.mQueryPool = device().createQueryPoolUnique(result.mCreateInfo, nullptr, dispatch_loader_core());
+		auto structure = barrier_plan_structure_of(aRecordedCommandsAndSyncInstructions);
+		size_t hash = structure.size();
+		for (auto value : structure) {
+			hash_combine(hash, value);
+		}
+		// The cache is internally synchronized and not part of the root's observable state => modified through a const root:
+		auto& cache = aRoot->mutable_barrier_plans();
+		if (auto cachedPlan = cache.find(hash, structure)) {
+			return cachedPlan;
+		}
 
-		return result;
+		auto plan = std::make_shared<barrier_plan>();
+		const auto syncIndex = sync_inference_index{ aRecordedCommandsAndSyncInstructions };
+		for (int i = 0; i < static_cast<int>(aRecordedCommandsAndSyncInstructions.size()); ++i) {
+			if (isSyncCmd(aRecordedCommandsAndSyncInstructions[i])) {
+				plan->mSyncScopes.push_back(resolve_sync_scope(std::get<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[i]), syncIndex, i));
+			}
+		}
+		plan->mStructure = std::move(structure);
+		cache.insert(hash, plan);
+		return plan;
+#else
+		return {};
+#endif
 	}
 
-	query_pool root::create_query_pool_for_occlusion_queries(uint32_t aNumOcclusionQueries)
+	// Half-open index ranges [begin, end) of mip levels, array layers, and buffer bytes, where the VK_REMAINING_*/VK_WHOLE_SIZE values extend to the maximum:
+	inline static std::tuple<uint64_t, uint64_t> mip_level_range_of(const vk::ImageSubresourceRange& aRange)
 	{
-		return create_query_pool(vk::QueryType::eOcclusion, aNumOcclusionQueries);
+		return { aRange.baseMipLevel, VK_REMAINING_MIP_LEVELS == aRange.levelCount ? std::numeric_limits<uint64_t>::max() : uint64_t{ aRange.baseMipLevel } + aRange.levelCount };
 	}
 
-	query_pool root::create_query_pool_for_timestamp_queries(uint32_t aNumTimestampQueries)
+	inline static std::tuple<uint64_t, uint64_t> array_layer_range_of(const vk::ImageSubresourceRange& aRange)
 	{
-		return create_query_pool(vk::QueryType::eTimestamp, aNumTimestampQueries);
+		return { aRange.baseArrayLayer, VK_REMAINING_ARRAY_LAYERS == aRange.layerCount ? std::numeric_limits<uint64_t>::max() : uint64_t{ aRange.baseArrayLayer } + aRange.layerCount };
 	}
-	
-	query_pool root::create_query_pool_for_pipeline_statistics_queries(vk::QueryPipelineStatisticFlags aPipelineStatistics, uint32_t aQueryCountMultiplier)
+
+	inline static std::tuple<uint64_t, uint64_t> byte_range_of(const vk::BufferMemoryBarrier2KHR& aBarrier)
 	{
-		const auto valueAsSomeKindOfInt = static_cast<vk::QueryPipelineStatisticFlags::MaskType>(aPipelineStatistics);
-		const auto count = avk::bit_count(valueAsSomeKindOfInt);
-		return create_query_pool(vk::QueryType::ePipelineStatistics, count * aQueryCountMultiplier, aPipelineStatistics);
+		return { aBarrier.offset, VK_WHOLE_SIZE == aBarrier.size ? std::numeric_limits<uint64_t>::max() : aBarrier.offset + aBarrier.size };
 	}
 
-	void query_pool_t::host_reset(uint32_t aFirstQueryIndex, std::optional<uint32_t> aNumQueries)
+	inline static bool ranges_intersect(const std::tuple<uint64_t, uint64_t>& aFirst, const std::tuple<uint64_t, uint64_t>& aSecond)
 	{
-		mQueryPool.getOwner().resetQueryPool(handle(), aFirstQueryIndex, aNumQueries.value_or(create_info().queryCount - aFirstQueryIndex));
+		return std::get<0>(aFirst) < std::get<1>(aSecond) && std::get<0>(aSecond) < std::get<1>(aFirst);
 	}
 
-	avk::command::action_type_command query_pool_t::reset(uint32_t aFirstQueryIndex, std::optional<uint32_t> aNumQueries)
+	inline static bool range_contains(const std::tuple<uint64_t, uint64_t>& aOuter, const std::tuple<uint64_t, uint64_t>& aInner)
 	{
-		return avk::command::action_type_command{
-			{}, {}, // Sync not applicable here, I guess
-			[
-				lHandle = handle(),
-				aFirstQueryIndex,
-				lNumQueries = aNumQueries.value_or(create_info().queryCount - aFirstQueryIndex)
-			](avk::command_buffer_t& cb) {
-				cb.handle().resetQueryPool(lHandle, aFirstQueryIndex, lNumQueries, cb.root_ptr()->dispatch_loader_core());
-			}
-		};
+		return std::get<0>(aOuter) <= std::get<0>(aInner) && std::get<1>(aInner) <= std::get<1>(aOuter);
 	}
 
-	avk::command::action_type_command query_pool_t::write_timestamp(uint32_t aQueryIndex, stage::pipeline_stage_flags_precisely aTimestampStage)
+	inline static bool ranges_adjacent(const std::tuple<uint64_t, uint64_t>& aFirst, const std::tuple<uint64_t, uint64_t>& aSecond)
 	{
-		return avk::command::action_type_command{
-			{ aTimestampStage + access::none, aTimestampStage + access::none }, // <-- Guess, that's fine. // TODO: Is it?
-			{}, 
-			[
-				lTimestampStage = aTimestampStage.mStage,
-				lHandle = handle(),
-				aQueryIndex
-			](avk::command_buffer_t& cb) {
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-				cb.handle().writeTimestamp2KHR(lTimestampStage, lHandle, aQueryIndex, cb.root_ptr()->dispatch_loader_ext());
-#else
-				cb.handle().writeTimestamp2(lTimestampStage, lHandle, aQueryIndex, cb.root_ptr()->dispatch_loader_core());
-#endif
-			}
-		};
+		return std::get<1>(aFirst) == std::get<0>(aSecond) || std::get<1>(aSecond) == std::get<0>(aFirst);
 	}
 
-	avk::command::action_type_command query_pool_t::begin_query(uint32_t aQueryIndex, vk::QueryControlFlags aFlags)
+	// Conservatively determines if the operations in the given stage masks might overlap:
+	inline static bool stage_masks_might_intersect(vk::PipelineStageFlags2KHR aFirst, vk::PipelineStageFlags2KHR aSecond)
 	{
-		return avk::command::action_type_command{
-			{}, {}, // Sync not applicable here, I guess
-			[
-				lHandle = handle(),
-				aQueryIndex,
-				aFlags
-			](avk::command_buffer_t& cb) {
-				cb.handle().beginQuery(lHandle, aQueryIndex, aFlags, cb.root_ptr()->dispatch_loader_core());
-			}
-		};
+		if (!aFirst || !aSecond) {
+			return false;
+		}
+		constexpr auto anyStage = vk::PipelineStageFlagBits2KHR::eAllCommands | vk::PipelineStageFlagBits2KHR::eAllGraphics | vk::PipelineStageFlagBits2KHR::eTopOfPipe | vk::PipelineStageFlagBits2KHR::eBottomOfPipe;
+		return static_cast<bool>(aFirst & aSecond) || static_cast<bool>((aFirst | aSecond) & anyStage);
 	}
 
-	avk::command::action_type_command query_pool_t::end_query(uint32_t aQueryIndex)
+	inline static bool stage_mask_covers(vk::PipelineStageFlags2KHR aOuter, vk::PipelineStageFlags2KHR aInner)
 	{
-		return avk::command::action_type_command{
-			{}, {}, // Sync not applicable here, I guess
-			[
-				lHandle = handle(),
-				aQueryIndex
-			](avk::command_buffer_t& cb) {
-				cb.handle().endQuery(lHandle, aQueryIndex, cb.root_ptr()->dispatch_loader_core());
-			}
-		};
+		return (aOuter & aInner) == aInner || static_cast<bool>(aOuter & vk::PipelineStageFlagBits2KHR::eAllCommands);
 	}
 
-	avk::command::action_type_command query_pool_t::copy_results(uint32_t aFirstQueryIndex, uint32_t aNumQueries, const buffer_t& aBuffer, size_t aBufferMetaSkip, vk::QueryResultFlags aFlags)
+	template <typename A, typename B>
+	inline static bool sync_scopes_cover(const A& aOuter, const B& aInner)
 	{
-		auto actionTypeCommand = avk::command::action_type_command{
-			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
-			{
-				// As per the specification:
-				//   vkCmdCopyQueryPoolResults is considered to be a transfer operation, and its writes to buffer memory must be
-				//   synchronized using VK_PIPELINE_STAGE_TRANSFER_BIT and VK_ACCESS_TRANSFER_WRITE_BIT before using the results.
-				std::make_tuple(aBuffer.handle(), avk::sync::sync_hint{
-					stage::transfer + access::transfer_write,
-					stage::transfer + access::transfer_write
-				})
-			},
-			[
-				lHandle = handle(),
-				aFirstQueryIndex, aNumQueries, aFlags,
-				lBufferHandle = aBuffer.handle(),
-				lMeta = aBuffer.meta<query_results_buffer_meta>(aBufferMetaSkip)
-			](avk::command_buffer_t& cb) {
-				cb.handle().copyQueryPoolResults(lHandle, aFirstQueryIndex, aNumQueries, lBufferHandle, lMeta.member_description(content_description::query_result).mOffset, lMeta.sizeof_one_element(), aFlags, cb.root_ptr()->dispatch_loader_core());
-			}
-		};
-
-		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
-
-		return actionTypeCommand;
+		return stage_mask_covers(aOuter.srcStageMask, aInner.srcStageMask)
+			&& stage_mask_covers(aOuter.dstStageMask, aInner.dstStageMask)
+			&& (aOuter.srcAccessMask & aInner.srcAccessMask) == aInner.srcAccessMask
+			&& (aOuter.dstAccessMask & aInner.dstAccessMask) == aInner.dstAccessMask;
 	}
 
-	avk::command::action_type_command query_pool_t::copy_result(uint32_t aOnlyQueryIndex, const buffer_t& aBuffer, size_t aBufferMetaSkip, vk::QueryResultFlags aFlags)
+	template <typename A, typename B>
+	inline static bool sync_scopes_equal(const A& aFirst, const B& aSecond)
 	{
-		return copy_results(aOnlyQueryIndex, 1u, aBuffer, aBufferMetaSkip, aFlags);
+		return aFirst.srcStageMask == aSecond.srcStageMask && aFirst.dstStageMask == aSecond.dstStageMask
+			&& aFirst.srcAccessMask == aSecond.srcAccessMask && aFirst.dstAccessMask == aSecond.dstAccessMask;
 	}
-#pragma endregion
-
-#pragma region commands and sync
-	inline static void record_into_command_buffer(
-		command_buffer_t& aCommandBuffer, 
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
-#else
-		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
-#endif
-		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions);
 
 	template <typename T>
-	inline static T accumulate_sync_details(
-		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
-		const int aStartIndex,
-		uint32_t aNumSteps,
-		const int aStepDirection,
-		T aDefaultValue,
-		// If the following parameter is provided, it means that we are looking for sync-dependencies w.r.t. this resource only.
-		// If it is not, we are looking for ANY sync-dependencies (e.g., relevant for semaphore signals)
-		std::optional<std::variant<vk::Image, vk::Buffer>> aWrtResource 
-	) {
-		assert(aStartIndex >= 0);
-		assert(aStartIndex < static_cast<int>(aRecordedCommandsAndSyncInstructions.size()));
-		assert(aNumSteps >= 0);
-		assert(aStepDirection == -1 || aStepDirection == 1);
-		
-		T result{};
-
-		const int ub = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
-
-		// Doesn't make sense if aNumSteps is less than 1, but the user could pass it (e.g., thorugh stage::auto_stages(0)) => just max it:
-		aNumSteps = std::max(aNumSteps, 1u);
-		uint32_t accSoFar = 0; // This must become equal to aNumSteps, then we're done
-
-		for (int i = aStartIndex; i >= 0 && i < ub && accSoFar < aNumSteps; i += aStepDirection) {
-			if (std::holds_alternative<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i])) { // Only regard action_type_commands here!
-																											     // TODO: Do we also have to regard image layout transitions here????!?!?!?!
-				// We used the general sync hint, except if we are looking for a specific resource:
-				auto* syncHint = &std::get<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i]).mSyncHint;
-				if (aWrtResource.has_value()) {
-					// See if we can find a resource-specific one (otherwise do not regard this action_type_command):
-					syncHint = nullptr;
-					for (const auto& [res, resSyncHint] : std::get<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i]).mResourceSpecificSyncHints) {
-						if (res == aWrtResource.value()) {
-							syncHint = &resSyncHint;
-							break;
-						}
-					}
-				}
-
-				if (nullptr == syncHint) {
-					continue;
-				}
-
-				switch (aStepDirection) {
-				case -1:
-					// Moving backwards, i.e. the previous command(s) "AFTER" values are relevant:
-					if constexpr (std::is_same_v<T, vk::PipelineStageFlags2KHR>) {
-						if (syncHint->mSrcForSubsequentCmds.has_value()) {
-							result |= syncHint->mSrcForSubsequentCmds.value().mStage;
-						}
-						else {
-							result |= aDefaultValue;
-						}
-						accSoFar += 1;
-					}
-					else if constexpr (std::is_same_v<T, vk::AccessFlags2KHR>) {
-						if (syncHint->mSrcForSubsequentCmds.has_value()) {
-							result |= syncHint->mSrcForSubsequentCmds.value().mAccess;
-						}
-						else {
-							result |= aDefaultValue;
-						}
-						accSoFar += 1;
-					}
-					else {
-						throw avk::logic_error("Unsupported T in function accumulate_sync_details.");
-					}
-					break;
-				case  1:
-					// Moving forwards, i.e. the subsequent command(s) "BEFORE" values are relevant:
-					if constexpr (std::is_same_v<T, vk::PipelineStageFlags2KHR>) {
-						if (syncHint->mDstForPreviousCmds.has_value()) {
-							result |= syncHint->mDstForPreviousCmds.value().mStage;
-						}
-						else {
-							result |= aDefaultValue;
-						}
-						accSoFar += 1;
-					}
-					else if constexpr (std::is_same_v<T, vk::AccessFlags2KHR>) {
-						if (syncHint->mDstForPreviousCmds.has_value()) {
-							result |= syncHint->mDstForPreviousCmds.value().mAccess;
-						}
-						else {
-							result |= aDefaultValue;
-						}
-						accSoFar += 1;
-					}
-					else {
-						throw avk::logic_error("Unsupported T in function accumulate_sync_details.");
-					}
-					break;
-				default:
-					throw avk::logic_error("Invalid value for aStepDirection.");
-				}
+	inline static bool has_layout_transition_or_ownership_transfer(const T& aBarrier)
+	{
+		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>) {
+			if (aBarrier.oldLayout != aBarrier.newLayout) {
+				return true;
 			}
 		}
+		if constexpr (std::is_same_v<T, vk::MemoryBarrier2KHR>) {
+			return false;
+		}
+		else {
+			return aBarrier.srcQueueFamilyIndex != aBarrier.dstQueueFamilyIndex;
+		}
+	}
 
-		// If we were unable to find anything to sync with, just return the default:
-		if (0 == accSoFar) {
-			result = aDefaultValue;
+	// Determines if two barriers might affect the same memory. Global memory barriers affect all memory.
+	template <typename A, typename B>
+	inline static bool barrier_resources_overlap(const A& aFirst, const B& aSecond)
+	{
+		if constexpr (std::is_same_v<A, vk::MemoryBarrier2KHR> || std::is_same_v<B, vk::MemoryBarrier2KHR>) {
+			return true;
+		}
+		else if constexpr (std::is_same_v<A, vk::ImageMemoryBarrier2KHR> && std::is_same_v<B, vk::ImageMemoryBarrier2KHR>) {
+			return aFirst.image == aSecond.image
+				&& static_cast<bool>(aFirst.subresourceRange.aspectMask & aSecond.subresourceRange.aspectMask)
+				&& ranges_intersect(mip_level_range_of(aFirst.subresourceRange), mip_level_range_of(aSecond.subresourceRange))
+				&& ranges_intersect(array_layer_range_of(aFirst.subresourceRange), array_layer_range_of(aSecond.subresourceRange));
+		}
+		else if constexpr (std::is_same_v<A, vk::BufferMemoryBarrier2KHR> && std::is_same_v<B, vk::BufferMemoryBarrier2KHR>) {
+			return aFirst.buffer == aSecond.buffer && ranges_intersect(byte_range_of(aFirst), byte_range_of(aSecond));
+		}
+		else {
+			return false;
 		}
-		return result;
 	}
 
-	// Internal helper function to assemble all the data for a barrier, based on:
-	//  - A given sync_type_command (aBarrierData)
-	//  - All the sync_hints of action_type_commands aRecordedCommandsAndSyncInstructions
-	template <typename T>
-	inline static T assemble_barrier_data(
-		const sync::sync_type_command& aBarrierData, 
-		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
-		int aRecordedStuffIndex
-	) {
-		// Sanity check: Does T and aBarrierData fit together?
-		assert(
-			   (std::is_same_v<T, vk::MemoryBarrier2KHR>       && (aBarrierData.is_global_execution_barrier() || aBarrierData.is_global_memory_barrier()))
-			|| (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>  && (aBarrierData.is_image_memory_barrier()                                               ))
-			|| (std::is_same_v<T, vk::BufferMemoryBarrier2KHR> && (aBarrierData.is_buffer_memory_barrier()                                              ))
-		);
+	// Barriers which are recorded with the same pipeline barrier command are not ordered w.r.t. each other.
+	// Therefore, aLater must not be batched with aEarlier if it would have formed a dependency chain with it,
+	// or if both transition the layout or the ownership of the same memory.
+	// Execution dependency chains are formed via pipeline stages, regardless of which resources the barriers
+	// refer to (e.g., a transition of one image which is waited on via the stages of another image's barrier).
+	template <typename A, typename B>
+	inline static bool barriers_conflict(const A& aEarlier, const B& aLater)
+	{
+		if (stage_masks_might_intersect(aEarlier.dstStageMask, aLater.srcStageMask)) {
+			return true;
+		}
+		return barrier_resources_overlap(aEarlier, aLater)
+			&& has_layout_transition_or_ownership_transfer(aEarlier) && has_layout_transition_or_ownership_transfer(aLater);
+	}
 
-		if (!aRecordedCommandsAndSyncInstructions.empty()) {
-			assert(std::holds_alternative<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[aRecordedStuffIndex]));
-			if (!std::holds_alternative<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[aRecordedStuffIndex])) {
-				throw avk::logic_error("The element at aRecordedStuffIndex[" + std::to_string(aRecordedStuffIndex) + "] is not of type sync_type_command.");
-			}
+	// Determines if aOuter establishes (at least) all the dependencies which aInner establishes.
+	template <typename A, typename B>
+	inline static bool barrier_covers(const A& aOuter, const B& aInner)
+	{
+		if (!sync_scopes_cover(aOuter, aInner)) {
+			return false;
+		}
+		if constexpr (std::is_same_v<A, vk::MemoryBarrier2KHR>) {
+			return !has_layout_transition_or_ownership_transfer(aInner);
+		}
+		else if constexpr (std::is_same_v<A, vk::ImageMemoryBarrier2KHR> && std::is_same_v<B, vk::ImageMemoryBarrier2KHR>) {
+			return aOuter.image == aInner.image
+				&& aOuter.oldLayout == aInner.oldLayout && aOuter.newLayout == aInner.newLayout
+				&& aOuter.srcQueueFamilyIndex == aInner.srcQueueFamilyIndex && aOuter.dstQueueFamilyIndex == aInner.dstQueueFamilyIndex
+				&& (aOuter.subresourceRange.aspectMask & aInner.subresourceRange.aspectMask) == aInner.subresourceRange.aspectMask
+				&& range_contains(mip_level_range_of(aOuter.subresourceRange), mip_level_range_of(aInner.subresourceRange))
+				&& range_contains(array_layer_range_of(aOuter.subresourceRange), array_layer_range_of(aInner.subresourceRange));
+		}
+		else if constexpr (std::is_same_v<A, vk::BufferMemoryBarrier2KHR> && std::is_same_v<B, vk::BufferMemoryBarrier2KHR>) {
+			return aOuter.buffer == aInner.buffer
+				&& aOuter.srcQueueFamilyIndex == aInner.srcQueueFamilyIndex && aOuter.dstQueueFamilyIndex == aInner.dstQueueFamilyIndex
+				&& range_contains(byte_range_of(aOuter), byte_range_of(aInner));
+		}
+		else {
+			return false;
 		}
+	}
 
-		// We're definitely going to establish a barrier:
-		auto barrier = T{};
+	// Tries to extend aTarget s.t. it also covers the adjacent subresource range of aOther. Everything else must be equal.
+	inline static bool try_merge_barriers(vk::ImageMemoryBarrier2KHR& aTarget, const vk::ImageMemoryBarrier2KHR& aOther)
+	{
+		if (aTarget.image != aOther.image || !sync_scopes_equal(aTarget, aOther)
+			|| aTarget.oldLayout != aOther.oldLayout || aTarget.newLayout != aOther.newLayout
+			|| aTarget.srcQueueFamilyIndex != aOther.srcQueueFamilyIndex || aTarget.dstQueueFamilyIndex != aOther.dstQueueFamilyIndex) {
+			return false;
+		}
+		auto& t = aTarget.subresourceRange;
+		const auto& o = aOther.subresourceRange;
+		const auto sameAspects = t.aspectMask == o.aspectMask;
+		const auto sameMips = mip_level_range_of(t) == mip_level_range_of(o);
+		const auto sameLayers = array_layer_range_of(t) == array_layer_range_of(o);
 
-		// The barrier can be restricted to a specific resource only, in which case, we should only accumulate
-		// sync data from relevant sync hints (i.e., relevant means: restricted to the same resource):
-		std::optional<std::variant<vk::Image, vk::Buffer>> restrictedToSpecificResource;
-		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>) {
-			restrictedToSpecificResource = aBarrierData.image_memory_barrier_data().mImage;
+		if (sameAspects && sameMips && ranges_adjacent(array_layer_range_of(t), array_layer_range_of(o))) {
+			const auto end = std::max(std::get<1>(array_layer_range_of(t)), std::get<1>(array_layer_range_of(o)));
+			t.baseArrayLayer = std::min(t.baseArrayLayer, o.baseArrayLayer);
+			t.layerCount = std::numeric_limits<uint64_t>::max() == end ? VK_REMAINING_ARRAY_LAYERS : static_cast<uint32_t>(end - t.baseArrayLayer);
+			return true;
 		}
-		if constexpr (std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
-			restrictedToSpecificResource = aBarrierData.buffer_memory_barrier_data().mBuffer;
+		if (sameAspects && sameLayers && ranges_adjacent(mip_level_range_of(t), mip_level_range_of(o))) {
+			const auto end = std::max(std::get<1>(mip_level_range_of(t)), std::get<1>(mip_level_range_of(o)));
+			t.baseMipLevel = std::min(t.baseMipLevel, o.baseMipLevel);
+			t.levelCount = std::numeric_limits<uint64_t>::max() == end ? VK_REMAINING_MIP_LEVELS : static_cast<uint32_t>(end - t.baseMipLevel);
+			return true;
 		}
-		
-		// Handle source stage:
-		std::visit(lambda_overload{
-			[&barrier                                                            ](const std::monostate&){
-				barrier.setSrcStageMask(vk::PipelineStageFlagBits2KHR::eNone);
-			},
-			[&barrier                                                            ](const vk::PipelineStageFlags2KHR& bFixedStage){
-				barrier.setSrcStageMask(bFixedStage);
-			},
-			[&barrier, &aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::stage::auto_stage_t& bAutoStage){
-				if (aRecordedCommandsAndSyncInstructions.empty()) {
-					barrier.setSrcStageMask(vk::PipelineStageFlagBits2KHR::eAllCommands);
-				}
-				else {
-					// Gotta determine which stage:
-					barrier.setSrcStageMask(accumulate_sync_details<vk::PipelineStageFlags2KHR>(
-						aRecordedCommandsAndSyncInstructions, 
-						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
-						/* How many steps to accumulate: */ static_cast<int>(bAutoStage),
-						/* before-wards: */ -1,
-						/* If we can't determine something specific, employ a heavy barrier to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
-						restrictedToSpecificResource
-					));
-				}
-			},
-		}, aBarrierData.src_stage());
+		if (sameMips && sameLayers && !(t.aspectMask & o.aspectMask)) {
+			t.aspectMask |= o.aspectMask;
+			return true;
+		}
+		return false;
+	}
 
-		// Handle destination stage:
-		std::visit(lambda_overload{
-			[&barrier                                                            ](const std::monostate&){
-				barrier.setDstStageMask(vk::PipelineStageFlagBits2KHR::eNone);
-			},
-			[&barrier                                                            ](const vk::PipelineStageFlags2KHR& bFixedStage){
-				barrier.setDstStageMask(bFixedStage);
-			},
-			[&barrier, &aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::stage::auto_stage_t& bAutoStage){
-				if (aRecordedCommandsAndSyncInstructions.empty()) {
-					barrier.setDstStageMask(vk::PipelineStageFlagBits2KHR::eAllCommands);
-				}
-				else {
-					// Gotta determine which stage:
-					barrier.setDstStageMask(accumulate_sync_details<vk::PipelineStageFlags2KHR>(
-						aRecordedCommandsAndSyncInstructions, 
-						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
-						/* How many steps to accumulate: */ static_cast<int>(bAutoStage),
-						/* after-wards: */  1,
-						/* If we can't determine something specific, employ a heavy barrier to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
-						restrictedToSpecificResource
-					));
-				}
-			},
-		}, aBarrierData.dst_stage());
+	// Tries to extend aTarget s.t. it also covers the adjacent range of aOther. Everything else must be equal.
+	inline static bool try_merge_barriers(vk::BufferMemoryBarrier2KHR& aTarget, const vk::BufferMemoryBarrier2KHR& aOther)
+	{
+		if (aTarget.buffer != aOther.buffer || !sync_scopes_equal(aTarget, aOther)
+			|| aTarget.srcQueueFamilyIndex != aOther.srcQueueFamilyIndex || aTarget.dstQueueFamilyIndex != aOther.dstQueueFamilyIndex
+			|| !ranges_adjacent(byte_range_of(aTarget), byte_range_of(aOther))) {
+			return false;
+		}
+		const auto end = std::max(std::get<1>(byte_range_of(aTarget)), std::get<1>(byte_range_of(aOther)));
+		aTarget.offset = std::min(aTarget.offset, aOther.offset);
+		aTarget.size = std::numeric_limits<uint64_t>::max() == end ? VK_WHOLE_SIZE : end - aTarget.offset;
+		return true;
+	}
 
-		// Handle source access:
-		std::visit(lambda_overload{
-			[&barrier                                                            ](const std::monostate&){
-				barrier.setSrcAccessMask(vk::AccessFlagBits2KHR::eNone);
-			},
-			[&barrier                                                            ](const vk::AccessFlags2KHR& bFixedAccess){
-				barrier.setSrcAccessMask(bFixedAccess);
-			},
-			[&barrier, &aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::access::auto_access_t& bAutoAccess){
-				if (aRecordedCommandsAndSyncInstructions.empty()) {
-					barrier.setSrcAccessMask(vk::AccessFlagBits2KHR::eMemoryWrite);
-				}
-				else {
-					// Gotta determine which access:
-					barrier.setSrcAccessMask(accumulate_sync_details<vk::AccessFlags2KHR>(
-						aRecordedCommandsAndSyncInstructions, 
-						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
-						/* How many steps to accumulate: */ static_cast<int>(bAutoAccess),
-						/* before-wards: */ -1,
-						/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::AccessFlagBits2KHR::eMemoryWrite,
-						restrictedToSpecificResource
-					));
-				}
-			},
-		}, aBarrierData.src_access());
+	inline static bool try_merge_barriers(vk::MemoryBarrier2KHR&, const vk::MemoryBarrier2KHR&)
+	{
+		return false;
+	}
 
-		// Handle destination access:
-		std::visit(lambda_overload{
-			[&barrier                                                            ](const std::monostate&){
-				barrier.setDstAccessMask(vk::AccessFlagBits2KHR::eNone);
-			},
-			[&barrier                                                            ](const vk::AccessFlags2KHR& bFixedAccess){
-				barrier.setDstAccessMask(bFixedAccess);
-			},
-			[&barrier, &aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::access::auto_access_t& bAutoAccess){
-				if (aRecordedCommandsAndSyncInstructions.empty()) {
-					barrier.setSrcAccessMask(vk::AccessFlagBits2KHR::eMemoryWrite | vk::AccessFlagBits2KHR::eMemoryRead);
+	// Collects the barriers of consecutive sync_type_commands, s.t. they can be recorded with one single pipeline barrier command.
+	// Barriers which are fully covered by a batched barrier are dropped, and image or buffer barriers of adjacent ranges are merged.
+	// If a barrier conflicts with a batched one (see barriers_conflict), the batch is recorded first, and a new batch is started.
+	class barrier_batch
+	{
+	public:
+		barrier_batch(command_buffer_t& aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt
+#else
+			const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore
+#endif
+		)
+			: mCommandBuffer{ aCommandBuffer }
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			, mDispatchLoaderExt{ aDispatchLoaderExt }
+#else
+			, mDispatchLoaderCore{ aDispatchLoaderCore }
+#endif
+		{}
+		barrier_batch(barrier_batch&&) noexcept = delete;
+		barrier_batch(const barrier_batch&) = delete;
+		barrier_batch& operator=(barrier_batch&&) noexcept = delete;
+		barrier_batch& operator=(const barrier_batch&) = delete;
+		~barrier_batch() = default;
+
+		void add(const sync::sync_type_command& aSyncCmd, const barrier_plan::sync_scope& aScope)
+		{
+			if (aSyncCmd.is_global_execution_barrier() || aSyncCmd.is_global_memory_barrier()) {
+				add(assemble_barrier_data<vk::MemoryBarrier2KHR>(aSyncCmd, aScope));
+			}
+			else if (aSyncCmd.is_image_memory_barrier()) {
+				auto barrier = assemble_barrier_data<vk::ImageMemoryBarrier2KHR>(aSyncCmd, aScope);
+				auto* layoutState = aSyncCmd.image_memory_barrier_data().mLayoutState;
+				if (nullptr == layoutState) {
+					add(barrier);
 				}
 				else {
-					// Gotta determine which access:
-					barrier.setDstAccessMask(accumulate_sync_details<vk::AccessFlags2KHR>(
-						aRecordedCommandsAndSyncInstructions, 
-						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
-						/* How many steps to accumulate: */ static_cast<uint32_t>(bAutoAccess),
-						/* after-wards: */  1,
-						/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::AccessFlagBits2KHR::eMemoryWrite | vk::AccessFlagBits2KHR::eMemoryRead,
-						restrictedToSpecificResource
-					));
+					add_with_tracked_layouts(barrier, aSyncCmd.image_memory_barrier_data().mLayoutTransition.has_value(), aScope.mSrcUndetermined, *layoutState);
 				}
-			},
-		}, aBarrierData.dst_access());
+			}
+			else if (aSyncCmd.is_buffer_memory_barrier()) {
+				add(assemble_barrier_data<vk::BufferMemoryBarrier2KHR>(aSyncCmd, aScope));
+			}
+		}
 
-		// For T = vk::MemoryBarrier2KHR, we are done.
-		// But for image memory barriers or buffer memory barriers, there could be more sync data to be filled-in:
-		
-		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>) {
-			auto imageSyncData = aBarrierData.image_memory_barrier_data();
+		// Records all batched barriers with one pipeline barrier command, and clears the batch.
+		void record()
+		{
+			if (mMemoryBarriers.empty() && mImageMemoryBarriers.empty() && mBufferMemoryBarriers.empty()) {
+				return;
+			}
+			auto dependencyInfo = vk::DependencyInfoKHR{}
+				.setMemoryBarrierCount(static_cast<uint32_t>(mMemoryBarriers.size()))
+				.setPMemoryBarriers(mMemoryBarriers.data())
+				.setBufferMemoryBarrierCount(static_cast<uint32_t>(mBufferMemoryBarriers.size()))
+				.setPBufferMemoryBarriers(mBufferMemoryBarriers.data())
+				.setImageMemoryBarrierCount(static_cast<uint32_t>(mImageMemoryBarriers.size()))
+				.setPImageMemoryBarriers(mImageMemoryBarriers.data());
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			mCommandBuffer.handle().pipelineBarrier2KHR(dependencyInfo, mDispatchLoaderExt);
+#else
+			mCommandBuffer.handle().pipelineBarrier2(dependencyInfo, mDispatchLoaderCore);
+#endif
+			mMemoryBarriers.clear();
+			mImageMemoryBarriers.clear();
+			mBufferMemoryBarriers.clear();
+		}
 
-			barrier.setImage(imageSyncData.mImage);
-			barrier.setSubresourceRange(imageSyncData.mSubresourceRange);
+	private:
+		// Splits the given barrier into one barrier per run of subresources in the same tracked state, which use
+		// the exact old layout, and updates the tracked state. Transitions into the current layout are skipped.
+		// If the source scope is undetermined (see barrier_plan::sync_scope), the tracked last access is used instead.
+		void add_with_tracked_layouts(const vk::ImageMemoryBarrier2KHR& aBarrier, bool aHasLayoutTransition, bool aSrcUndetermined, image_layout_state& aLayoutState)
+		{
+			std::vector<std::tuple<vk::ImageMemoryBarrier2KHR, subresource_state>> parts;
+			aLayoutState.for_each_in_range(aBarrier.subresourceRange, [&](uint32_t lMipLevel, uint32_t lBaseArrayLayer, uint32_t lLayerCount, const subresource_state& lState) {
+				auto part = aBarrier;
+				part.subresourceRange.baseMipLevel = lMipLevel;
+				part.subresourceRange.levelCount = 1u;
+				part.subresourceRange.baseArrayLayer = lBaseArrayLayer;
+				part.subresourceRange.layerCount = lLayerCount;
+				if (aHasLayoutTransition && vk::ImageLayout::eUndefined != aBarrier.oldLayout) {
+					// eUndefined is kept, because it expresses that the contents may be discarded:
+					part.oldLayout = lState.mLayout;
+				}
+				if (aSrcUndetermined && lState.mLastAccess.mStage) {
+					part.srcStageMask = lState.mLastAccess.mStage;
+					part.srcAccessMask = lState.mLastAccess.mAccess;
+				}
+				// The destination scope announces the next access. Barriers without one leave the last access unchanged:
+				const auto lastAccess = part.dstStageMask ? stage_and_access_precisely{ part.dstStageMask, part.dstAccessMask } : lState.mLastAccess;
+				parts.emplace_back(part, subresource_state{ aHasLayoutTransition ? aBarrier.newLayout : lState.mLayout, lastAccess });
+			});
 
-			// Specification goes like this:
-			// > When the old and new layout are equal, the layout values are ignored - data is preserved
-			// > no matter what values are specified, or what layout the image is currently in.
-			if (imageSyncData.mLayoutTransition.has_value()) {
-				barrier.setOldLayout(imageSyncData.mLayoutTransition.value().mOld.mLayout);
-				barrier.setNewLayout(imageSyncData.mLayoutTransition.value().mNew.mLayout);
+			for (auto& [part, newState] : parts) {
+				aLayoutState.set(part.subresourceRange, newState);
+				if (part.oldLayout == part.newLayout && !part.srcStageMask && !part.dstStageMask && part.srcQueueFamilyIndex == part.dstQueueFamilyIndex) {
+					// Neither a layout transition nor any dependency => nothing to do:
+					continue;
+				}
+				add(part);
 			}
-			// else leave both set to 0 which corresponds to eUndefined -> eUndefined, a.k.a. no layout transition
 		}
 
-		if constexpr (std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
-			auto bufferSyncData = aBarrierData.buffer_memory_barrier_data();
-			barrier.setBuffer(bufferSyncData.mBuffer);
-			barrier.setOffset(bufferSyncData.mOffset);
-			barrier.setSize(bufferSyncData.mSize);
+		template <typename T>
+		std::vector<T>& barriers_of_type()
+		{
+			if constexpr (std::is_same_v<T, vk::MemoryBarrier2KHR>) { return mMemoryBarriers; }
+			else if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>) { return mImageMemoryBarriers; }
+			else { return mBufferMemoryBarriers; }
 		}
 
-		// For both, buffer memory barriers and image memory barriers, queue family o	wnership transfers are relevant:
-		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR> || std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
-			auto qfot = aBarrierData.queue_family_ownership_transfer();
-			barrier.setSrcQueueFamilyIndex(qfot.has_value() ? qfot.value().mSrcQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED);
-			barrier.setDstQueueFamilyIndex(qfot.has_value() ? qfot.value().mDstQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED);
+		// Invokes aFunction for each batched barrier until it returns true, skipping the barrier at aSkip.
+		template <typename F>
+		bool any_batched_barrier(F&& aFunction, const void* aSkip = nullptr) const
+		{
+			auto test = [&](const auto& aBarriers) {
+				return std::any_of(std::begin(aBarriers), std::end(aBarriers), [&](const auto& lBatched) {
+					return static_cast<const void*>(&lBatched) != aSkip && aFunction(lBatched);
+				});
+			};
+			return test(mMemoryBarriers) || test(mImageMemoryBarriers) || test(mBufferMemoryBarriers);
 		}
 
-		return barrier;
-	}
+		template <typename T>
+		void add(const T& aBarrier)
+		{
+			auto& sameTypeBarriers = barriers_of_type<T>();
+
+			// Is it redundant? It is, if a batched barrier covers it, and if it does not depend on any of the other batched barriers:
+			const void* coveringBarrier = nullptr;
+			any_batched_barrier([&](const auto& lBatched) {
+				if (barrier_covers(lBatched, aBarrier)) {
+					coveringBarrier = &lBatched;
+					return true;
+				}
+				return false;
+			});
+			const auto conflicts = any_batched_barrier([&](const auto& lBatched) {
+				return barriers_conflict(lBatched, aBarrier);
+			}, coveringBarrier);
+
+			if (nullptr != coveringBarrier && !conflicts) {
+				return;
+			}
+			if (conflicts) {
+				// It must be ordered after the batched barriers:
+				record();
+				sameTypeBarriers.push_back(aBarrier);
+				return;
+			}
+
+			for (auto& batched : sameTypeBarriers) {
+				if (try_merge_barriers(batched, aBarrier)) {
+					return;
+				}
+			}
+			sameTypeBarriers.push_back(aBarrier);
+		}
+
+		command_buffer_t& mCommandBuffer;
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& mDispatchLoaderExt;
+#else
+		const DISPATCH_LOADER_CORE_TYPE& mDispatchLoaderCore;
+#endif
+		std::vector<vk::MemoryBarrier2KHR> mMemoryBarriers;
+		std::vector<vk::ImageMemoryBarrier2KHR> mImageMemoryBarriers;
+		std::vector<vk::BufferMemoryBarrier2KHR> mBufferMemoryBarriers;
+	};
 
 	inline static void record_into_command_buffer(command_buffer_t& aCommandBuffer, 
 #ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
@@ -8083,42 +11965,17 @@ namespace avk
 		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
 #endif
 		const sync::sync_type_command& aSyncCmd, 
-		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, 
-		int aRecordedStuffIndex)
+		const barrier_plan::sync_scope& aScope)
 	{
-		if (aSyncCmd.is_global_execution_barrier() || aSyncCmd.is_global_memory_barrier()) {
-			auto barrier = assemble_barrier_data<vk::MemoryBarrier2KHR>(aSyncCmd, aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex);
-			auto dependencyInfo = vk::DependencyInfoKHR{}
-				.setMemoryBarrierCount(1u)
-				.setPMemoryBarriers(&barrier);
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			aCommandBuffer.handle().pipelineBarrier2KHR(dependencyInfo, aDispatchLoaderExt);
-#else
-			aCommandBuffer.handle().pipelineBarrier2(dependencyInfo, aDispatchLoaderCore);
-#endif
-		}
-		else if (aSyncCmd.is_image_memory_barrier()) {
-			auto barrier = assemble_barrier_data<vk::ImageMemoryBarrier2KHR>(aSyncCmd, aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex);
-			auto dependencyInfo = vk::DependencyInfoKHR{}
-				.setImageMemoryBarrierCount(1u)
-				.setPImageMemoryBarriers(&barrier);
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			aCommandBuffer.handle().pipelineBarrier2KHR(dependencyInfo, aDispatchLoaderExt);
-#else
-			aCommandBuffer.handle().pipelineBarrier2(dependencyInfo, aDispatchLoaderCore);
-#endif
-		}
-		else if (aSyncCmd.is_buffer_memory_barrier()) {
-			auto barrier = assemble_barrier_data<vk::BufferMemoryBarrier2KHR>(aSyncCmd, aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex);
-			auto dependencyInfo = vk::DependencyInfoKHR{}
-				.setBufferMemoryBarrierCount(1u)
-				.setPBufferMemoryBarriers(&barrier);
+		barrier_batch batch{ aCommandBuffer,
 #ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			aCommandBuffer.handle().pipelineBarrier2KHR(dependencyInfo, aDispatchLoaderExt);
+			aDispatchLoaderExt
 #else
-			aCommandBuffer.handle().pipelineBarrier2(dependencyInfo, aDispatchLoaderCore);
+			aDispatchLoaderCore
 #endif
-		}
+		};
+		batch.add(aSyncCmd, aScope);
+		batch.record();
 	}
 
 	void command_buffer_t::record(const avk::command::state_type_command& aToBeRecorded)
@@ -8151,7 +12008,7 @@ namespace avk
 #else
 			root_ptr()->dispatch_loader_core(),
 #endif
-			aToBeRecorded, std::vector<recorded_commands_t>{}, 0);
+			aToBeRecorded, resolve_sync_scope(aToBeRecorded, sync_inference_index{ std::vector<recorded_commands_t>{} }, 0));
 	}
 
 	void command_buffer_t::record(std::vector<avk::recorded_commands_t> aRecordedCommandsAndSyncInstructions)
@@ -8160,6 +12017,11 @@ namespace avk
 			.into_command_buffer(*this, false); // Last parameter: do not call begin/end here!
 	}
 
+	void command_buffer_t::record(const avk::command_stream& aToBeRecorded)
+	{
+		aToBeRecorded.record_into(*this);
+	}
+
 	struct recordee_visitors
 	{
 		void operator()(const command::state_type_command& vStateCmd) const {
@@ -8188,7 +12050,7 @@ namespace avk
 #else
 				mDispatchLoaderCore,
 #endif
-				vSyncCmd, mRecordedStuff, mCurrentIndexIntoRecordedStuff);
+				vSyncCmd, mCurrentSyncScope);
 		}
 
 		command_buffer_t& mCommandBuffer;
@@ -8197,8 +12059,7 @@ namespace avk
 #else
 		const DISPATCH_LOADER_CORE_TYPE& mDispatchLoaderCore;
 #endif
-		const std::vector<recorded_commands_t>& mRecordedStuff;
-		int mCurrentIndexIntoRecordedStuff;
+		barrier_plan::sync_scope mCurrentSyncScope;
 	};
 	
 	inline static void record_into_command_buffer(
@@ -8209,6 +12070,29 @@ namespace avk
 		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
 #endif
 		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions)
+	{
+		record_range_into_command_buffer(aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			aDispatchLoaderExt,
+#else
+			aDispatchLoaderCore,
+#endif
+			aRecordedCommandsAndSyncInstructions, 0, static_cast<int>(aRecordedCommandsAndSyncInstructions.size()),
+			get_barrier_plan(aCommandBuffer.root_ptr(), aRecordedCommandsAndSyncInstructions).get());
+	}
+
+	// Records the elements [aBegin, aEnd) of the given commands. Sync commands are resolved against all the given commands, though.
+	// If a barrier plan of the given commands is passed, the stages and accesses of sync commands are taken from it instead.
+	inline static void record_range_into_command_buffer(
+		command_buffer_t& aCommandBuffer, 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
+#else
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
+#endif
+		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
+		int aBegin, int aEnd,
+		const barrier_plan* aBarrierPlan)
 	{
 		recordee_visitors visitState{ aCommandBuffer, 
 #ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
@@ -8216,17 +12100,54 @@ namespace avk
 #else
 			aDispatchLoaderCore,
 #endif
-			aRecordedCommandsAndSyncInstructions, /* Current index: */ 0 };
+			/* Current sync scope: */ {} };
+		// Without a barrier plan, the sync index is built upon the first sync command, s.t. lists without sync commands do not pay for it:
+		std::optional<sync_inference_index> syncIndex;
+		// With a barrier plan, the sync scope of the first sync command in the range is preceded by those of the sync commands before the range:
+		auto nextSyncScope = nullptr == aBarrierPlan ? size_t{ 0 } : static_cast<size_t>(std::count_if(
+			std::begin(aRecordedCommandsAndSyncInstructions), std::begin(aRecordedCommandsAndSyncInstructions) + aBegin,
+			[](const recorded_commands_t& bRecordee) { return std::holds_alternative<sync::sync_type_command>(bRecordee); }
+		));
+#if !defined(AVK_DISABLE_BARRIER_BATCHING)
+		barrier_batch batch{ aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			aDispatchLoaderExt
+#else
+			aDispatchLoaderCore
+#endif
+		};
+#endif
 		
-		const int n = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
-		for (int i = 0; i < n; ++i) {
+		for (int i = aBegin; i < aEnd; ++i) {
 			// Get current element:
 			auto& recordee = aRecordedCommandsAndSyncInstructions[i];
-			// Update current index:
-			visitState.mCurrentIndexIntoRecordedStuff = i;
+			if (std::holds_alternative<sync::sync_type_command>(recordee)) {
+				const auto& syncCmd = std::get<sync::sync_type_command>(recordee);
+				if (nullptr != aBarrierPlan) {
+					assert(nextSyncScope < aBarrierPlan->mSyncScopes.size());
+					visitState.mCurrentSyncScope = aBarrierPlan->mSyncScopes[nextSyncScope++];
+				}
+				else {
+					if (!syncIndex.has_value()) {
+						syncIndex.emplace(aRecordedCommandsAndSyncInstructions);
+					}
+					visitState.mCurrentSyncScope = resolve_sync_scope(syncCmd, syncIndex.value(), i);
+				}
+#if !defined(AVK_DISABLE_BARRIER_BATCHING)
+				// Consecutive sync commands are batched into one pipeline barrier:
+				batch.add(syncCmd, visitState.mCurrentSyncScope);
+				continue;
+#endif
+			}
+#if !defined(AVK_DISABLE_BARRIER_BATCHING)
+			batch.record();
+#endif
 			// Handle current element:
 			std::visit(visitState, recordee);
 		}
+#if !defined(AVK_DISABLE_BARRIER_BATCHING)
+		batch.record();
+#endif
 	}
 	
 	submission_data recorded_command_buffer::then_waiting_for(avk::semaphore_wait_info aWaitInfo)
@@ -8351,7 +12272,8 @@ namespace avk
 			vk::Offset2D aRenderAreaOffset,
 			std::optional<vk::Extent2D> aRenderAreaExtent,
 			uint32_t aLayerCount,
-			uint32_t aViewMask)
+			uint32_t aViewMask,
+			bool aContentsInline)
 		{
 #ifdef _DEBUG
 			if (aAttachments.size() != aImageViews.size()) {
@@ -8364,6 +12286,9 @@ namespace avk
 				if ((is_depth_format(v->get_image().format()) || has_stencil_component(v->get_image().format())) && !a.is_used_as_depth_stencil_attachment()) {
 					AVK_LOG_WARNING("Possibly misconfigured framebuffer: image[" + std::to_string(i) + "] is a depth/stencil format, but it is never indicated to be used as such in the attachment-description[" + std::to_string(i) + "].");
 				}
+				if (avk::has_flag(v->get_image().create_info().usage, vk::ImageUsageFlagBits::eTransientAttachment) && !a.is_transient()) {
+					AVK_LOG_WARNING("Possibly misconfigured framebuffer: image[" + std::to_string(i) + "] is a transient attachment, but its contents are loaded or stored according to attachment-description[" + std::to_string(i) + "].");
+				}
 				if(!a.is_for_dynamic_rendering())
 				{
 					AVK_LOG_WARNING("Provided attachment which was not created compatible with dynamic rendering. Please provide an attachment created with one of the declare_dynamic_* functions");
@@ -8496,9 +12421,11 @@ namespace avk
 					aLayerCount,
 					aViewMask,
 					aRenderAreaOffset,
-					aRenderAreaExtent
+					aRenderAreaExtent,
+					aContentsInline
 				](avk::command_buffer_t& cb) {
 					auto const renderingInfo = vk::RenderingInfoKHR{}
+						.setFlags(aContentsInline ? vk::RenderingFlagsKHR{} : vk::RenderingFlagBitsKHR::eContentsSecondaryCommandBuffers)
 						.setRenderArea(vk::Rect2D(aRenderAreaOffset, aRenderAreaExtent.value()))
 						.setLayerCount(aLayerCount)
 						.setViewMask(aViewMask) 
@@ -8532,9 +12459,133 @@ namespace avk
 			};
 		}
 
+		action_type_command parallel(
+			std::vector<std::reference_wrapper<command_pool_t>> aCommandPools,
+			std::vector<recorded_commands_t> aCommands,
+			secondary_command_buffer_inheritance aInheritance,
+			std::vector<std::tuple<size_t, size_t>> aRanges,
+			worker_pool& aWorkerPool)
+		{
+			if (aCommandPools.empty()) {
+				throw avk::logic_error("Parallel recording requires at least one command pool.");
+			}
+			if (aCommands.empty()) {
+				return action_type_command{};
+			}
+			validate_no_barriers_within_rendering(aInheritance, aCommands);
+			// Partitions are recorded concurrently and finish in any order, but tracked layouts must be updated in execution order:
+			if (contains_tracked_layout_updates(aCommands)) {
+				throw avk::logic_error("Commands which are recorded in parallel must not update tracked image layouts. Record barriers of images with layout tracking enabled, and render passes or mipmap generation of such images, into the primary command buffer.");
+			}
+
+			// Split the commands evenly, unless the partitioning has been specified:
+			if (aRanges.empty()) {
+				const auto numPartitions = std::min(aCommandPools.size(), aCommands.size());
+				for (size_t i = 0; i < numPartitions; ++i) {
+					aRanges.emplace_back(i * aCommands.size() / numPartitions, (i + 1) * aCommands.size() / numPartitions);
+				}
+			}
+			else {
+				size_t expectedBegin = 0;
+				for (const auto& [rangeBegin, rangeEnd] : aRanges) {
+					if (rangeBegin != expectedBegin || rangeEnd < rangeBegin) {
+						throw avk::logic_error("The ranges for parallel recording must be consecutive.");
+					}
+					expectedBegin = rangeEnd;
+				}
+				if (aCommands.size() != expectedBegin) {
+					throw avk::logic_error("The ranges for parallel recording must cover all " + std::to_string(aCommands.size()) + " commands.");
+				}
+			}
+			if (aRanges.size() > aCommandPools.size()) {
+				throw avk::logic_error("Parallel recording of " + std::to_string(aRanges.size()) + " partitions requires as many command pools, but only " + std::to_string(aCommandPools.size()) + " have been passed.");
+			}
+
+			// Assemble the inheritance info, which all secondary command buffers share:
+			auto inheritanceInfo = vk::CommandBufferInheritanceInfo{};
+			auto inheritanceRenderingInfo = vk::CommandBufferInheritanceRenderingInfoKHR{};
+			assemble_inheritance_info(aInheritance, inheritanceInfo, inheritanceRenderingInfo);
+			const auto usageFlags = std::holds_alternative<std::monostate>(aInheritance)
+				? vk::CommandBufferUsageFlags{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit }
+				: vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+
+			std::vector<command_buffer> secondaries;
+			secondaries.reserve(aRanges.size());
+			for (size_t i = 0; i < aRanges.size(); ++i) {
+				secondaries.push_back(aCommandPools[i].get().alloc_command_buffer(usageFlags, vk::CommandBufferLevel::eSecondary));
+			}
+
+			// Every partition is recorded against the complete list of commands, s.t. sync commands at partition boundaries
+			// can see their neighbors in other partitions. The barrier plan of the complete list is shared by all partitions:
+			const auto barrierPlan = get_barrier_plan(secondaries.front()->root_ptr(), aCommands);
+			// The calling thread and the pool's workers record the partitions, and exceptions are rethrown afterwards:
+			aWorkerPool.parallel_for(aRanges.size(), [&](size_t lPartition) {
+				auto& cb = secondaries[lPartition].get();
+				cb.begin_recording(inheritanceInfo);
+				record_range_into_command_buffer(cb,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+					cb.root_ptr()->dispatch_loader_ext(),
+#else
+					cb.root_ptr()->dispatch_loader_core(),
+#endif
+					aCommands, static_cast<int>(std::get<0>(aRanges[lPartition])), static_cast<int>(std::get<1>(aRanges[lPartition])), barrierPlan.get());
+				cb.end_recording();
+			});
+
+			// Let the nested commands determine the sync hint and hand over their lifetime-handled resources:
+			action_type_command inference;
+			inference.mNestedCommandsAndSyncInstructions = std::move(aCommands);
+			inference.infer_sync_hint_from_nested_commands();
+			auto result = execute_secondary_command_buffers(std::move(secondaries), inference.mSyncHint);
+			for (auto& recordee : inference.mNestedCommandsAndSyncInstructions) {
+				if (std::holds_alternative<action_type_command>(recordee)) {
+					for (auto& lifetime : std::get<action_type_command>(recordee).mLifetimeHandledResources) {
+						result.handle_lifetime_of(std::move(lifetime));
+					}
+				}
+			}
+			return result;
+		}
+
+		action_type_command execute_secondary_command_buffers(std::vector<command_buffer> aSecondaryCommandBuffers, avk::sync::sync_hint aSyncHint)
+		{
+			std::vector<vk::CommandBuffer> handles;
+			handles.reserve(aSecondaryCommandBuffers.size());
+			for (const auto& cb : aSecondaryCommandBuffers) {
+				handles.push_back(cb->handle());
+			}
+
+			auto result = action_type_command{
+				aSyncHint,
+				{},
+				[lHandles = std::move(handles)](avk::command_buffer_t& cb) {
+					if (!lHandles.empty()) {
+						cb.handle().executeCommands(static_cast<uint32_t>(lHandles.size()), lHandles.data());
+						// The state of the primary command buffer is undefined after executing secondary command buffers:
+						cb.invalidate_bound_state();
+					}
+				}
+			};
+			for (auto& cb : aSecondaryCommandBuffers) {
+				result.handle_lifetime_of(std::move(cb));
+			}
+			return result;
+		}
+
 		action_type_command begin_render_pass_for_framebuffer(const renderpass_t& aRenderpass, const framebuffer_t& aFramebuffer, vk::Offset2D aRenderAreaOffset, std::optional<vk::Extent2D> aRenderAreaExtent, bool aSubpassesInline)
 		{
-			return action_type_command{
+			// The render pass transitions its attachments into their final layouts => gather the tracked ones:
+			std::vector<std::tuple<image_layout_state*, vk::ImageSubresourceRange, vk::ImageLayout>> trackedAttachmentLayouts;
+			const auto attachmentDescriptions = aRenderpass.attachment_descriptions();
+			for (size_t i = 0; i < attachmentDescriptions.size() && i < aFramebuffer.image_views().size(); ++i) {
+				auto* layoutState = aFramebuffer.image_at(i).layout_state();
+				if (nullptr != layoutState) {
+					trackedAttachmentLayouts.emplace_back(layoutState, aFramebuffer.image_views()[i]->create_info().subresourceRange, attachmentDescriptions[i].finalLayout);
+				}
+			}
+			const auto updatesTrackedLayouts = !trackedAttachmentLayouts.empty();
+
+			auto result = action_type_command{
 				// Define a sync hint that corresponds to the implicit subpass dependencies (see specification chapter 8.1)
 				avk::sync::sync_hint {
 					{{ // What previous commands must synchronize with:
@@ -8553,6 +12604,7 @@ namespace avk
 					lClearValues = aRenderpass.clear_values(),
 					lRenderPassHandle = aRenderpass.handle(),
 					lFramebufferHandle = aFramebuffer.handle(),
+					lTrackedAttachmentLayouts = std::move(trackedAttachmentLayouts),
 					aRenderAreaOffset, aRenderAreaExtent, aSubpassesInline
 				](avk::command_buffer_t& cb) {
 					// TODO: make vk::SubpassContentscontents state explicit
@@ -8584,8 +12636,15 @@ namespace avk
 						lRoot->dispatch_loader_core()
 					);
 #endif
+
+					// Commands are recorded in execution order => subsequent barriers will find the attachments in their final layouts:
+					for (const auto& [layoutState, subresourceRange, finalLayout] : lTrackedAttachmentLayouts) {
+						layoutState->set(subresourceRange, subresource_state{ finalLayout });
+					}
 				}
 			};
+			result.mUpdatesTrackedLayouts = updatesTrackedLayouts;
+			return result;
 		}
 
 		action_type_command begin_render_pass_for_framebuffer(std::optional<std::reference_wrapper<const avk::renderpass_t>> aRenderpass, const framebuffer_t& aFramebuffer, vk::Offset2D aRenderAreaOffset, std::optional<vk::Extent2D> aRenderAreaExtent, bool aSubpassesInline)
@@ -8697,7 +12756,7 @@ namespace avk
 				[
 					lPipelineHandle = aPipeline.handle()
 				] (avk::command_buffer_t& cb) {
-					cb.handle().bindPipeline(vk::PipelineBindPoint::eGraphics, lPipelineHandle);
+					cb.bind_pipeline(vk::PipelineBindPoint::eGraphics, lPipelineHandle);
 				}
 			};
 		}
@@ -8708,7 +12767,7 @@ namespace avk
 				[
 					lPipelineHandle = aPipeline.handle()
 				] (avk::command_buffer_t& cb) {
-					cb.handle().bindPipeline(vk::PipelineBindPoint::eCompute, lPipelineHandle);
+					cb.bind_pipeline(vk::PipelineBindPoint::eCompute, lPipelineHandle);
 				}
 			};
 		}
@@ -8720,7 +12779,7 @@ namespace avk
 				[
 					lPipelineHandle = aPipeline.handle()
 				] (avk::command_buffer_t& cb) {
-					cb.handle().bindPipeline(vk::PipelineBindPoint::eRayTracingKHR, lPipelineHandle);
+					cb.bind_pipeline(vk::PipelineBindPoint::eRayTracingKHR, lPipelineHandle);
 				}
 			};
 		}
@@ -8736,7 +12795,7 @@ namespace avk
 					cb.bind_descriptors(
 						vk::PipelineBindPoint::eGraphics,
 						lLayoutHandle,
-						lDescriptorSets // Attention: Copy! => Potentially expensive?! TODO: What was the reason for bind_descriptors requiring std::vector<descriptor_set> being passed by value?
+						lDescriptorSets
 					);
 				}
 			};
@@ -8752,7 +12811,7 @@ namespace avk
 					cb.bind_descriptors(
 						vk::PipelineBindPoint::eCompute,
 						lLayoutHandle,
-						lDescriptorSets // Attention: Copy! => Potentially expensive?! TODO: What was the reason for bind_descriptors requiring std::vector<descriptor_set> being passed by value?
+						lDescriptorSets
 					);
 				}
 			};
@@ -8769,7 +12828,7 @@ namespace avk
 					cb.bind_descriptors(
 						vk::PipelineBindPoint::eRayTracingKHR,
 						lLayoutHandle,
-						lDescriptorSets // Attention: Copy! => Potentially expensive?! TODO: What was the reason for bind_descriptors requiring std::vector<descriptor_set> being passed by value?
+						lDescriptorSets
 					);
 				}
 			};